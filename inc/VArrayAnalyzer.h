@@ -4,6 +4,7 @@
 
 #include "TMath.h"
 
+#include "VArrayImageData.h"
 #include "VEvndispData.h"
 #include "VGrIsuAnalyzer.h"
 #include "VEffectiveAreaCalculatorMCHistograms.h"
@@ -27,6 +28,9 @@ class VArrayAnalyzer : public VEvndispData, public VGrIsuAnalyzer
         vector< double > fMeanPointingMismatch;   //!< mean pointing mismatch between eventdisplay and vbf (per telescope)
         vector< double > fNMeanPointingMismatch;
 
+        // image and telescope data of current event (filled once for all reconstruction methods)
+        VArrayImageData fImageData;
+
         // temporary variables needed for array reconstruction
         vector< unsigned int > telID;
         vector< float > x;
@@ -34,26 +38,6 @@ class VArrayAnalyzer : public VEvndispData, public VGrIsuAnalyzer
         vector< float > w;
         vector< float > l;
         vector< float > m;
-        vector< float > phi;
-        vector< float > sinphi;
-        vector< float > cosphi;
-        vector< float > width;
-        vector< float > length;
-        vector< float > asym;
-        vector< float > loss;
-        vector< float > dist;
-        vector< float > pedvar;
-        vector< float > tgrad;
-        vector< float > xcore;
-        vector< float > ycore;
-        vector< float > cen_y;
-        vector< float > cen_x;
-        vector< float > Xoff;
-        vector< float > Yoff;
-        vector< float > ltrig;
-        vector< float > az;
-        vector< float > ze;
-        vector<ULong64_t> teltype;
 
         vector< float > xtelnew;
         vector< float > ytelnew;
@@ -63,12 +47,16 @@ class VArrayAnalyzer : public VEvndispData, public VGrIsuAnalyzer
 
         void calcShowerDirection_and_Core();      //!< calculate shower core and direction
         void checkPointing();                     //!< check for mismatching between different pointing values
+        void fillArrayImageData();                //!< fill image and telescope data for all reconstruction methods
+        void fillArrayImageData_pointing( unsigned int iPointing );
         void prepareforCoreReconstruction( unsigned int iMeth, float xs, float ys );
         void prepareforDirectionReconstruction( unsigned int iMethIndex, unsigned int iReconstructionMethod );
         bool fillSimulationEvent();
         bool fillShowerDirection( unsigned int iMeth, float xoff, float yoff, float stds );
         bool fillShowerCore( unsigned int iMeth, float ximp, float yimp ); //!< fill shower core results into VEvndispData
+        float  getDistanceToClosestStar( VImageParameter* iImage );
         double getMeanPointingMismatch( unsigned int iTel );
+        unsigned int getPointingVariant( unsigned int iMeth );
         void initEvent();                         //!< reset vectors, etc. (called for each event)
         int  rcs_method_0( unsigned int );        //!< GrIsu reconstruction method 1(!)
         int  rcs_method_3( unsigned int );
@@ -0,0 +1,114 @@
+//! VArrayImageData  image and telescope data of one event used by all array reconstruction methods (one entry per telescope)
+
+#ifndef VARRAYIMAGEDATA_H
+#define VARRAYIMAGEDATA_H
+
+#include <vector>
+
+#include "VImageParameter.h"
+
+using namespace std;
+
+class VArrayImageData
+{
+    public:
+        // number of pointing variants (0 = eventdisplay pointing, 1 = corrected for pointing errors)
+        static const unsigned int fNPointing = 2;
+
+        unsigned int fNTel;
+
+        vector< VImageParameter* > fImage;        //!< image parameters used for reconstruction (GEO or LL)
+        vector< int >   fTelTypeCounter;          //!< telescope type counter (reconstruction parameters)
+        vector< bool >  fLLFitOK;                 //!< LL fit successful (always true for GEO analysis)
+        vector< float > fSize;
+        vector< float > fWidthLength;             //!< width / length (1 for length = 0)
+        vector< float > fCoreWeight;              //!< weight for core reconstruction: (size * (1 - width/length))^2
+        vector< float > fCen_x;                   //!< image centroid (no pointing corrections) [deg]
+        vector< float > fCen_y;
+        vector< float > fTel_x_SC;                //!< telescope position in shower coordinates
+        vector< float > fTel_y_SC;
+        vector< float > fTel_z_SC;
+        vector< float > fStarDistance_deg;        //!< smallest distance of image/border pixels to a bright star (<0: not calculated)
+
+        // image centroids and axis slopes (per pointing variant)
+        bool            fPointingFilled[fNPointing];
+        vector< float > fX_deg[fNPointing];       //!< image centroid [deg]
+        vector< float > fY_deg[fNPointing];
+        vector< float > fX_mm[fNPointing];        //!< image centroid [mm]
+        vector< float > fY_mm[fNPointing];
+        vector< float > fM[fNPointing];           //!< slope of image axis
+
+        // intersections of image axes of telescope pairs
+        // (index: [pointing variant * 2 + (0=mm, 1=deg)][telescope i * ntel + telescope j])
+        vector< bool >  fPairFilled[2 * fNPointing];
+        vector< float > fPairXs[2 * fNPointing];
+        vector< float > fPairYs[2 * fNPointing];
+        vector< float > fPairStd[2 * fNPointing];
+
+        VArrayImageData()
+        {
+            reset( 0 );
+        }
+        ~VArrayImageData() {}
+
+        bool getPairIntersection( unsigned int iPointing, bool iDeg, unsigned int i, unsigned int j,
+                                  float& xs, float& ys, float& stds )
+        {
+            unsigned int c = iPointing * 2 + ( iDeg ? 1 : 0 );
+            unsigned int p = i * fNTel + j;
+            if( !fPairFilled[c][p] )
+            {
+                return false;
+            }
+            xs = fPairXs[c][p];
+            ys = fPairYs[c][p];
+            stds = fPairStd[c][p];
+            return true;
+        }
+        void setPairIntersection( unsigned int iPointing, bool iDeg, unsigned int i, unsigned int j,
+                                  float xs, float ys, float stds )
+        {
+            unsigned int c = iPointing * 2 + ( iDeg ? 1 : 0 );
+            unsigned int p = i * fNTel + j;
+            fPairFilled[c][p] = true;
+            fPairXs[c][p] = xs;
+            fPairYs[c][p] = ys;
+            fPairStd[c][p] = stds;
+        }
+        /*
+            resize all vectors (memory is kept from event to event)
+        */
+        void reset( unsigned int iNTel )
+        {
+            fNTel = iNTel;
+            fImage.assign( iNTel, 0 );
+            fTelTypeCounter.assign( iNTel, 0 );
+            fLLFitOK.assign( iNTel, true );
+            fSize.assign( iNTel, 0. );
+            fWidthLength.assign( iNTel, 1. );
+            fCoreWeight.assign( iNTel, 0. );
+            fCen_x.assign( iNTel, 0. );
+            fCen_y.assign( iNTel, 0. );
+            fTel_x_SC.assign( iNTel, 0. );
+            fTel_y_SC.assign( iNTel, 0. );
+            fTel_z_SC.assign( iNTel, 0. );
+            fStarDistance_deg.assign( iNTel, -1. );
+            for( unsigned int v = 0; v < fNPointing; v++ )
+            {
+                fPointingFilled[v] = false;
+                fX_deg[v].assign( iNTel, 0. );
+                fY_deg[v].assign( iNTel, 0. );
+                fX_mm[v].assign( iNTel, 0. );
+                fY_mm[v].assign( iNTel, 0. );
+                fM[v].assign( iNTel, 0. );
+            }
+            for( unsigned int c = 0; c < 2 * fNPointing; c++ )
+            {
+                fPairFilled[c].assign( iNTel * iNTel, false );
+                fPairXs[c].resize( iNTel * iNTel, 0. );
+                fPairYs[c].resize( iNTel * iNTel, 0. );
+                fPairStd[c].resize( iNTel * iNTel, 0. );
+            }
+        }
+};
+#endif
@@ -9,12 +9,32 @@
 #include <VPacket.h>
 
 #include <bitset>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace std;
 
+//! decoded event (packet and unpacked array event), read by the read-ahead thread
+struct VBFReadAheadEvent
+{
+    VPacket* fPacket;
+    unsigned int fIndex;                          //!< packet index in file
+    bool fEndOfFile;
+    string fError;                                //!< exception message from reader (empty: no error)
+    string fUnpackError;                          //!< exception message while unpacking the packet
+    vector< bool > fConfigMask;                   //!< configuration mask of bank file reader after reading this packet
+    bool fSimulationHeader;                       //!< packet has a simulation header
+    bool fHasArrayEvent;                          //!< packet has an array event
+    VArrayEvent* fArrayEvent;                     //!< array event (owned by packet)
+    VArrayTrigger* fArrayTrigger;                 //!< array trigger (owned by packet)
+    vector< VEvent* > fEvents;                    //!< telescope events of array event (owned by packet)
+};
+
 class VBFDataReader : public VBaseRawDataReader
 {
     protected:
@@ -22,6 +42,22 @@ class VBFDataReader : public VBaseRawDataReader
         VBankFileReader reader;
         unsigned index;
 
+        // read ahead (packets are read, decompressed and unpacked in a separate thread)
+        unsigned int fReadAheadEvents;            //!< maximum number of decoded events in read-ahead queue (0 = no read ahead)
+        thread fReadAheadThread;
+        mutex fReadAheadMutex;
+        condition_variable fReadAheadCondition;
+        deque< VBFReadAheadEvent > fReadAheadBuffer;
+        bool fReadAheadStop;
+        vector< bool > fConfigMask;               //!< configuration mask (copy from bank file reader while read ahead is active)
+        unsigned int fNReadErrorPrints;           //!< number of printed read errors
+
+        VBFReadAheadEvent getReadAheadEvent();
+        void readAhead( unsigned int iIndex );
+        void readEvent( unsigned int iIndex, VBFReadAheadEvent& iE );
+        void stopReadAhead();
+        void unpackPacket( VBFReadAheadEvent& iE );
+
         VArrayEvent*   ae;
         VArrayTrigger* at;
 
@@ -73,6 +109,7 @@ class VBFDataReader : public VBaseRawDataReader
         uint16_t          getNumSamples();
         bool              hasArrayTrigger();
         bool              hasLocalTrigger( unsigned int iTel );
+        void              setReadAhead( unsigned int iNEvents );
         void              setPerformFADCAnalysis( bool iB )
         {
             iB = false;
@@ -31,8 +31,8 @@ class VBaseRawDataReader : public VVirtualDataReader, public VSimulationDataRead
         string          fDataFormat;
         string          fSourceFileName;
         unsigned int    fNTel;
-        unsigned int    fTelID;
-        uint32_t        fHitID;
+        static thread_local unsigned int fTelID;  //!< current telescope (one per analysis thread)
+        static thread_local uint32_t     fHitID;  //!< current channel (one per analysis thread)
 
         vector< double > fTelElevation;
         vector< double > fTelAzimuth;
@@ -56,10 +56,10 @@ class VBaseRawDataReader : public VVirtualDataReader, public VSimulationDataRead
 
         VMonteCarloRunHeader* fMonteCarloHeader;
 
-        // QADC values
-        std::valarray<double> fSums;
-        std::valarray<double> fTraceMax;
-        std::vector< valarray< double > > fTracePulseTiming;
+        // QADC values (one per telescope; telescopes might be analysed in parallel)
+        std::vector< std::valarray<double> > fSums;
+        std::vector< std::valarray<double> > fTraceMax;
+        std::vector< std::vector< valarray< double > > > fTracePulseTiming;
 
         // placeholders
         std::valarray<double> v;
@@ -236,6 +236,7 @@ class VBaseRawDataReader : public VVirtualDataReader, public VSimulationDataRead
             return 0;
         }
         uint8_t                     getSample( unsigned channel, unsigned sample, bool iNewNoiseTrace = true );
+        const uint8_t*              getSamplePtr( unsigned channel, unsigned int& iNSamples );
         std::vector< uint8_t >      getSamplesVec();
         uint32_t                    getHitID( uint32_t i );
         bool                        getHiLo( uint32_t i );
@@ -0,0 +1,313 @@
+//! VCalibrationCache  binary snapshot of the calibration data of one telescope (keyed by calibration sources and summation windows)
+
+#ifndef VCALIBRATIONCACHE_H
+#define VCALIBRATIONCACHE_H
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <valarray>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+/*
+    file layout (native byte order, all arrays stored contiguous with a length prefix):
+
+        magic number (also used as byte order mark)
+        format version
+        key (string describing all calibration sources)
+        calibration data (see VCalibrationData::writeCalibrationCache)
+
+    a cache file is valid only if magic number, version and key agree
+
+    array lengths are checked against the expected number of channels,
+    summation windows, etc. while reading (see read functions)
+*/
+class VCalibrationCache
+{
+    private:
+        string fKey;
+
+    public:
+        static const unsigned int fMagic = 0x45564443;   //!< "EVDC"
+        static const unsigned int fVersion = 1;           //!< increase after any change of the data layout
+        static const unsigned int fMaxTimeSlices = 100000; //!< maximum number of time slices for pedestals in time slices
+
+        VCalibrationCache() {}
+        ~VCalibrationCache() {}
+
+        /*
+            add a calibration source file to the key
+
+            file size and modification time are part of the key, so that the cache
+            becomes invalid as soon as a source file changes
+            (file name and file name + ".root" are checked, as readers try both)
+        */
+        void addFile( string iName, string iFile )
+        {
+            fKey += iName + "=" + iFile;
+            if( iFile.size() > 0 )
+            {
+                string iF[] = { iFile, iFile + ".root" };
+                for( unsigned int i = 0; i < 2; i++ )
+                {
+                    struct stat iStat;
+                    if( stat( iF[i].c_str(), &iStat ) == 0 )
+                    {
+                        ostringstream i_s;
+                        i_s << "[" << ( long long )iStat.st_size << "," << ( long long )iStat.st_mtime << "]";
+                        fKey += i_s.str();
+                    }
+                    else
+                    {
+                        fKey += "[-]";
+                    }
+                }
+            }
+            fKey += ";";
+        }
+        template< class T > void addParameter( string iName, T iValue )
+        {
+            ostringstream i_s;
+            i_s << setprecision( 10 ) << iName << "=" << iValue << ";";
+            fKey += i_s.str();
+        }
+        string getKey()
+        {
+            return fKey;
+        }
+        /*
+            cache file name: run number and summation windows, followed by a hash of the key
+            (FNV-1a)
+        */
+        string getFileName( string iDirectory, unsigned int iTelID, int iRun, unsigned int iSumWindow, unsigned int iSumWindow_2 )
+        {
+            unsigned long long h = 14695981039346656037ULL;
+            for( unsigned int i = 0; i < fKey.size(); i++ )
+            {
+                h ^= ( unsigned char )fKey[i];
+                h *= 1099511628211ULL;
+            }
+            ostringstream i_s;
+            i_s << iDirectory;
+            if( iDirectory.size() > 0 && iDirectory[iDirectory.size() - 1] != '/' )
+            {
+                i_s << "/";
+            }
+            i_s << "calibcache_T" << iTelID + 1 << "_" << iRun;
+            i_s << "_SW" << iSumWindow << "_" << iSumWindow_2;
+            i_s << "_" << hex << setw( 16 ) << setfill( '0' ) << h << ".bin";
+            return i_s.str();
+        }
+        bool readHeader( istream& is )
+        {
+            unsigned int iMagic = 0;
+            unsigned int iVersion = 0;
+            string iKey;
+            read( is, iMagic );
+            read( is, iVersion );
+            if( !is.good() || iMagic != fMagic || iVersion != fVersion )
+            {
+                return false;
+            }
+            read( is, iKey, fKey.size() );
+            return ( is.good() && iKey == fKey );
+        }
+        void writeHeader( ostream& os )
+        {
+            unsigned int iMagic = fMagic;
+            unsigned int iVersion = fVersion;
+            write( os, iMagic );
+            write( os, iVersion );
+            write( os, fKey );
+        }
+
+        ////////////////////////////////////////////////////////////////////
+        // binary I/O of scalars, strings and (nested) arrays
+
+        template< class T > static void write( ostream& os, const T& x )
+        {
+            os.write( ( const char* )&x, sizeof( T ) );
+        }
+        static void write( ostream& os, const string& x )
+        {
+            unsigned int n = x.size();
+            write( os, n );
+            os.write( x.data(), n );
+        }
+        template< class T > static void write( ostream& os, const valarray< T >& x )
+        {
+            unsigned int n = x.size();
+            write( os, n );
+            if( n > 0 )
+            {
+                os.write( ( const char* )&x[0], n * sizeof( T ) );
+            }
+        }
+        template< class T > static void write( ostream& os, const vector< T >& x )
+        {
+            unsigned int n = x.size();
+            write( os, n );
+            if( n > 0 )
+            {
+                os.write( ( const char* )&x[0], n * sizeof( T ) );
+            }
+        }
+        template< class T > static void write( ostream& os, const valarray< valarray< T > >& x )
+        {
+            unsigned int n = x.size();
+            write( os, n );
+            for( unsigned int i = 0; i < n; i++ )
+            {
+                write( os, x[i] );
+            }
+        }
+        template< class T > static void write( ostream& os, const vector< valarray< T > >& x )
+        {
+            unsigned int n = x.size();
+            write( os, n );
+            for( unsigned int i = 0; i < n; i++ )
+            {
+                write( os, x[i] );
+            }
+        }
+        static void write( ostream& os, const map< pair< int, int >, double >& x )
+        {
+            unsigned int n = x.size();
+            write( os, n );
+            for( map< pair< int, int >, double >::const_iterator it = x.begin(); it != x.end(); ++it )
+            {
+                write( os, it->first.first );
+                write( os, it->first.second );
+                write( os, it->second );
+            }
+        }
+
+        /*
+            read length prefix of an array
+
+            lengths above iMaxN (corrupted or inconsistent files) set the
+            failbit of the stream; all following reads fail
+        */
+        static bool readLength( istream& is, unsigned int& n, unsigned int iMaxN )
+        {
+            n = 0;
+            read( is, n );
+            if( is.good() && n > iMaxN )
+            {
+                n = 0;
+                is.setstate( ios::failbit );
+            }
+            return is.good();
+        }
+        template< class T > static void read( istream& is, T& x )
+        {
+            is.read( ( char* )&x, sizeof( T ) );
+        }
+        static void read( istream& is, string& x, unsigned int iMaxN )
+        {
+            unsigned int n = 0;
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            x.assign( n, ' ' );
+            if( n > 0 )
+            {
+                is.read( &x[0], n );
+            }
+        }
+        template< class T > static void read( istream& is, valarray< T >& x, unsigned int iMaxN )
+        {
+            unsigned int n = 0;
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            x.resize( n );
+            if( n > 0 )
+            {
+                is.read( ( char* )&x[0], n * sizeof( T ) );
+            }
+        }
+        template< class T > static void read( istream& is, vector< T >& x, unsigned int iMaxN )
+        {
+            unsigned int n = 0;
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            x.resize( n );
+            if( n > 0 )
+            {
+                is.read( ( char* )&x[0], n * sizeof( T ) );
+            }
+        }
+        template< class T > static void read( istream& is, valarray< valarray< T > >& x, unsigned int iMaxN, unsigned int iMaxN_2 )
+        {
+            unsigned int n = 0;
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            x.resize( n );
+            for( unsigned int i = 0; i < n && is.good(); i++ )
+            {
+                read( is, x[i], iMaxN_2 );
+            }
+        }
+        template< class T > static void read( istream& is, valarray< valarray< valarray< T > > >& x,
+                                              unsigned int iMaxN, unsigned int iMaxN_2, unsigned int iMaxN_3 )
+        {
+            unsigned int n = 0;
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            x.resize( n );
+            for( unsigned int i = 0; i < n && is.good(); i++ )
+            {
+                read( is, x[i], iMaxN_2, iMaxN_3 );
+            }
+        }
+        template< class T > static void read( istream& is, vector< valarray< T > >& x, unsigned int iMaxN, unsigned int iMaxN_2 )
+        {
+            unsigned int n = 0;
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            x.resize( n );
+            for( unsigned int i = 0; i < n && is.good(); i++ )
+            {
+                read( is, x[i], iMaxN_2 );
+            }
+        }
+        static void read( istream& is, map< pair< int, int >, double >& x, unsigned int iMaxN )
+        {
+            unsigned int n = 0;
+            x.clear();
+            if( !readLength( is, n, iMaxN ) )
+            {
+                return;
+            }
+            for( unsigned int i = 0; i < n && is.good(); i++ )
+            {
+                int a = 0;
+                int b = 0;
+                double v = 0.;
+                read( is, a );
+                read( is, b );
+                read( is, v );
+                x[make_pair( a, b )] = v;
+            }
+        }
+};
+#endif
@@ -12,6 +12,7 @@
 #include "TList.h"
 #include "TTree.h"
 
+#include "VCalibrationCache.h"
 #include "VVirtualDataReader.h"
 
 #include <iomanip>
@@ -48,6 +49,7 @@ class VCalibrationData
 
         TH1F* getHistogram( unsigned int iTel, unsigned int iChannel, unsigned int iWindowSize,  VCalibrationData::E_PEDTYPE, ULong64_t iTelType = 99999 );
         TH1F* getHistoDist( int iType, bool iDist );
+        bool  readCalibrationCacheValues( istream& is );
 
     public:
         bool fPedFromPLine;
@@ -356,6 +358,7 @@ class VCalibrationData
         {
             fSumWindow = isw;
         }
+        bool     readCalibrationCache( istream& is );
         bool     terminate( vector< unsigned int > a, vector< unsigned int > b, unsigned int iTraceIntegrationMethod, bool iDST = false );
         bool     usePedestalsInTimeSlices( bool iB )
         {
@@ -368,6 +371,7 @@ class VCalibrationData
                 return fLowGainUsePedestalsInTimeSlices;
             }
         }
+        void     writeCalibrationCache( ostream& os );
 
 };
 #endif
@@ -3,10 +3,12 @@
 #ifndef VCALIBRATOR_H
 #define VCALIBRATOR_H
 
+#include "VCalibrationCache.h"
 #include "VImageBaseAnalyzer.h"
 #include "VPedestalCalculator.h"
 #include "VDB_CalibrationInfo.h"
 #include "VSQLTextFileReader.h"
+#include "VThreadPool.h"
 
 #include "TClonesArray.h"
 #include "TFile.h"
@@ -14,6 +16,7 @@
 #include "TLeaf.h"
 #include "TMath.h"
 #include "TProfile.h"
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
 
@@ -25,6 +28,29 @@
 
 using namespace std;
 
+// statistics of one calibration histogram
+class VCalibrationHistoStatistics
+{
+    public:
+        double fEntries;
+        double fIntegral;                         //!< integral without under/overflow
+        double fMean;
+        double fRMS;
+        double fQuantile[3];                      //!< 16%, 50%, 84% quantiles
+
+        VCalibrationHistoStatistics()
+        {
+            fEntries = 0.;
+            fIntegral = 0.;
+            fMean = 0.;
+            fRMS = 0.;
+            fQuantile[0] = 0.;
+            fQuantile[1] = 0.;
+            fQuantile[2] = 0.;
+        }
+        ~VCalibrationHistoStatistics() {}
+};
+
 class VCalibrator : public VImageBaseAnalyzer
 {
     private:
@@ -93,11 +119,14 @@ class VCalibrator : public VImageBaseAnalyzer
                                              vector< double > maxSumPerSumWindow );
         void getCalibrationRunNumbers();
         int  getCalibrationRunNumbers_fromCalibFile();
+        vector< VCalibrationHistoStatistics > getHistogramStatistics( const vector< TH1F* >& h );
         unsigned int getNumberOfEventsUsedInCalibration( vector< int > iE, int iTelID );
         unsigned int getNumberOfEventsUsedInCalibration( map< ULong64_t, int > iE, int iTelID );
         TFile* getPedestalRootFile( ULong64_t iTel );
         int  readLowGainCalibrationValues_fromCalibFile( string iVariable = "LOWGAINPED", unsigned int iTel = 9999, int iSumWindow = 9999 );
+        string getCalibrationCacheFileName( VCalibrationCache& iCache );
         string getCalibrationFileName( int iTel, int irun, string iSuffix, string name = "" );
+        bool readCalibrationCache();
         void readCalibrationData();
         bool readCalibrationDatafromDSTFiles( string iSourceFile );
         void readfromVOFFLINE_DBText( int gain_or_toff, vector< unsigned int >& VchannelList, vector< double >& Vmean, vector< double >& Vrms );
@@ -124,6 +153,7 @@ class VCalibrator : public VImageBaseAnalyzer
         void writePeds( bool iLowGain, VPedestalCalculator* iP = 0, bool iWriteAsciiFile = true );
         void writeTOffsets( bool iLowGain = false );
         void writeAverageTZeros( bool iLowGain = false );
+        bool writeCalibrationCache();
         bool writeIPRgraphs( string iFile = "" );
 
 
@@ -32,7 +32,7 @@ class VCameraRead : public VGlobalRunParameter
         bool fDebug;
         unsigned int fGrIsuVersion;               //!< GrIsu Version
         unsigned int fCFGtype;                    //!< cfg file type (0=std, 1 = mirrors and pixels for 1 telelescope only)
-        unsigned int fTelID;                      //!< telescope ID
+        static thread_local unsigned int fTelID;  //!< telescope ID (one per analysis thread)
 
         int          fsourcetype;
         //!< telescope ID for multiple data readers
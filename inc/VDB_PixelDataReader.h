@@ -51,8 +51,6 @@ class VDB_PixelDataReader
 
         vector< unsigned int > fNPixel;
 
-        vector< float > fDummyReturnVector;
-
         vector< string > fPixelDataType;
         vector< vector< vector< VDB_PixelData* > > > fPixelData;   // array [ndatatype][ntel][npixel]
         vector< vector< TH1F* > >  fPixelData_histogram;
@@ -12,6 +12,7 @@
 #include "VImageBaseAnalyzer.h"
 #include "VImageCleaning.h"
 #include "VDSTTree.h"
+#include "VDSTWriter.h"
 
 ///////////////////////////////////////////////////////////////////////////////////
 // MAXIMUM NUMBER OF TELESCOPES AND CHANNELS IS DEFINED IN EVNDISP_definition.h
@@ -25,10 +26,14 @@ class VDST : public VImageBaseAnalyzer, public VDSTTree
         bool fBLaser;
         VImageCleaning* fVImageCleaning;
         TFile* fDSTfile;
+        VDSTTree* fDSTOutput;                     //!< output tree (filled by writer thread)
+        VDSTWriter* fDSTWriter;                   //!< writer thread (optional)
 
         bool fDSTini;
 
+        void fillDSTTree();
         bool writeCalibrationData();
+        void setDSTCompression( TTree* t, bool iFileLevel );
 
     public:
         VDST( bool iMode, bool iMC );
@@ -8,6 +8,7 @@
 #include "VVirtualDataReader.h"
 
 #include "TFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 
 #include <bitset>
@@ -31,10 +32,10 @@ class VDSTReader : public VVirtualDataReader
 
         bool   fPerformFADCAnalysis;              //!< look at FADC traces
 
-        unsigned int fTelID;
+        static thread_local unsigned int fTelID;              //!< current telescope (one per analysis thread)
         unsigned int fNTelescopes;
         vector< uint16_t >     fNumSamples;
-        unsigned int fSelectedHitChannel;
+        static thread_local unsigned int fSelectedHitChannel; //!< selected channel (one per analysis thread)
         vector< unsigned int > fNChannel;
         vector< valarray< double > > fSums;
         vector< valarray< double > > fPe;
@@ -52,13 +53,19 @@ class VDSTReader : public VVirtualDataReader
         vector< vector < bool > > fHiLo;
         vector< int > fNumberofFullTrigger;
 
-        vector< uint8_t > fDummySample;
         vector< uint16_t > fDummySample16Bit;
         vector< vector< vector< uint16_t > > > fFADCTrace;
 
         vector< bool > fDSTvltrig;
         vector< unsigned short int > fDSTl2trig_type;
 
+        // sparse replay: hit channels only
+        bool fSparseReplay;                       //!< fill hit channels only (all other channels are zero)
+        vector< vector< unsigned int > > fHitList;    //!< channel IDs of hit channels
+        vector< vector< int > > fHitIndex;            //!< position of channel in hit list (-1: not hit)
+
+        void fillHitChannel( unsigned int iTel, unsigned int iChannel );
+        void fillSparseHitList();
         bool init();                              //!< open source file and init tree
 
     public:
@@ -133,6 +140,10 @@ class VDSTReader : public VVirtualDataReader
         uint32_t                    getHitID( uint32_t );
         bool                        getHiLo( uint32_t i )
         {
+            if( fSparseReplay )
+            {
+                i = getHitID( i );
+            }
             if( i < fHiLo[fTelID].size() )
             {
                 return fHiLo[fTelID][i];
@@ -185,6 +196,10 @@ class VDSTReader : public VVirtualDataReader
         }
         uint16_t                    getNumChannelsHit()
         {
+            if( fSparseReplay )
+            {
+                return fHitList[fTelID].size();
+            }
             return fNChannel[fTelID];
         }
         uint16_t                    getNumSamples()
@@ -259,6 +274,7 @@ class VDSTReader : public VVirtualDataReader
         }
         vector< uint8_t >             getSamplesVec();
         uint8_t                       getSample( unsigned channel, unsigned sample, bool iNewNoiseTrace = true );
+        const uint16_t*               getSamplePtr16Bit( unsigned channel, unsigned int& iNSamples );
         vector< uint16_t >            getSamplesVec16Bit();
         uint16_t                      getSample16Bit( unsigned channel, unsigned sample, bool iNewNoiseTrace = true );
         valarray< double >&           getSums( unsigned int iNChannel = 99999 )
@@ -327,9 +343,13 @@ class VDSTReader : public VVirtualDataReader
         {
             return fMC;
         }
+        bool      isSparseReplay()
+        {
+            return fSparseReplay;
+        }
         void      selectHitChan( uint32_t hit )
         {
-            fSelectedHitChannel = hit;
+            fSelectedHitChannel = ( fSparseReplay ? getHitID( hit ) : hit );
         }
         void      setNumSamples( unsigned int iTelID, uint16_t iS )
         {
@@ -342,6 +362,8 @@ class VDSTReader : public VVirtualDataReader
         {
             fPerformFADCAnalysis = iB;
         }
+        void      setReadAhead( unsigned int iNEvents );
+        void      setSparseReplay( bool iSparse = true );
         bool      setTelescopeID( unsigned int );
         void      setTrigger( vector<bool> iImage, vector<bool> iBorder );          //!< set trigger values
         bool      wasLossyCompressed()
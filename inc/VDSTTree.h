@@ -3,6 +3,7 @@
 #define VDSTTree_H
 
 #include "TH1F.h"
+#include "TLeaf.h"
 #include "TMath.h"
 #include "TTree.h"
 
@@ -135,6 +136,34 @@ class VDSTTree
         float fDSTTel_xoff;
         float fDSTTel_yoff;
 
+        //////////////////////////////////////////////////////////////////////////////////////
+        // slim DST: list of image/border pixels only
+        // (dense per-channel arrays are filled from this list after reading an event)
+        bool fSlimTree;
+        unsigned int fDSTnpix;
+        vector< unsigned short int > fDSTpix_tel;          //!< telescope index (as in dense arrays)
+        vector< unsigned short int > fDSTpix_chan;
+        vector< float >              fDSTpix_sum;
+        vector< float >              fDSTpix_sum2;
+        vector< unsigned short int > fDSTpix_dead;
+        vector< unsigned short int > fDSTpix_sumwindow;
+        vector< unsigned short int > fDSTpix_sumfirst;
+        vector< float >              fDSTpix_Width;
+        vector< float >              fDSTpix_pulsetiming;  //!< [pixel][timing level]
+        vector< short >              fDSTpix_Max;
+        vector< short >              fDSTpix_RawMax;
+        vector< unsigned short int > fDSTpix_HiLo;
+        vector< unsigned short int > fDSTpix_N255;
+        vector< float >              fDSTpix_Chi2;
+        vector< float >              fDSTpix_RT;
+        vector< float >              fDSTpix_FT;
+        vector< float >              fDSTpix_RTpar;
+        vector< float >              fDSTpix_FTpar;
+        vector< float >              fDSTpix_Norm;
+        vector< unsigned int >       fSlimPixelIndex;      //!< dense array index (tel * VDST_MAXCHANNELS + channel) of pixels filled in last event
+
+        void initSlimPixelList( unsigned int iMaxNPixel );
+
         //////////////////////////////////////////////////////////////////////////////////////
         VDSTTree();
         ~VDSTTree() {}
@@ -158,7 +187,22 @@ class VDSTTree
         {
             return fMC;
         }
-        bool initDSTTree( bool iFullTree = false, bool iPhotoDiode = false, bool iTraceFit = false );
+        bool isSlimTree()
+        {
+            return fSlimTree;
+        }
+        bool hasZeroSuppressionFlags()
+        {
+            return ( fDST_tree && fDST_tree->GetBranch( "zerosuppressed" ) );
+        }
+        vector< unsigned int >& getSlimPixelList()     //!< pixels of current event (slim DSTs)
+        {
+            return fSlimPixelIndex;
+        }
+        void addSlimPixel( unsigned int iTel, unsigned int iChannel );
+        void expandSlimPixelList();
+        int  getDSTEntry( Long64_t iEntry );
+        bool initDSTTree( bool iFullTree = false, bool iPhotoDiode = false, bool iTraceFit = false, bool iSlimTree = false );
         bool initDSTTree( TTree* t, TTree* c );
         bool initMCTree();
         map< unsigned int, float> readArrayConfig( string );
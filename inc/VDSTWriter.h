@@ -0,0 +1,54 @@
+//! VDSTWriter  fills a DST tree in a background thread (events are handed over as compact byte records)
+
+#ifndef VDSTWRITER_H
+#define VDSTWRITER_H
+
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class VDSTWriter
+{
+    private:
+
+        TTree* fTree;                             //!< output tree (filled in writer thread)
+
+        // branch buffers (same branch structure in staging and output tree)
+        vector< char* > fStagingAddress;          //!< branch buffers filled by the event loop
+        vector< char* > fOutputAddress;           //!< branch buffers of output tree
+        vector< unsigned int > fBranchSize;       //!< size of one entry of the array [bytes]
+        vector< unsigned int* > fStagingCounter;  //!< variable length arrays: counter in staging buffers (0 for fixed size)
+        vector< unsigned int* > fOutputCounter;   //!< variable length arrays: counter in output buffers
+
+        unsigned int fMaxQueueSize;
+        deque< vector< char >* > fQueue;          //!< events waiting to be filled
+        vector< vector< char >* > fFreeRecords;   //!< records for reuse
+        mutex fMutex;
+        condition_variable fCondition_fill;       //!< signal new events to writer thread
+        condition_variable fCondition_space;      //!< signal free space in queue to event loop
+        thread fThread;
+        bool fStop;
+        bool fTerminated;
+
+        void work();
+
+    public:
+
+        VDSTWriter( TTree* iStagingTree, TTree* iOutputTree, unsigned int iMaxQueueSize = 100 );
+        ~VDSTWriter();
+        void fill();
+        void terminate();
+};
+#endif
@@ -80,7 +80,7 @@ class VDispAnalyzer
     public:
 
         VDispAnalyzer();
-        ~VDispAnalyzer() {}
+        ~VDispAnalyzer();
 
         void calculateEnergies( unsigned int i_ntel, float iArrayElevation, float iArrayAzimuth,
                                 ULong64_t* iTelType,
@@ -6,6 +6,7 @@
 #include <TApplication.h>
 #include <TGClient.h>
 #include <TQObject.h>
+#include <TROOT.h>
 #include <TSystem.h>
 #include <TTree.h>
 
@@ -22,11 +23,13 @@
 #endif
 #include "VPedestalCalculator.h"
 #include "VEvndispRunParameter.h"
+#include "VThreadPool.h"
 
 #include "VDeadPixelOrganizer.h"
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <algorithm>
@@ -42,6 +45,9 @@ class VEventLoop : public VEvndispData
         VCalibrator* fCalibrator;                 //!< default calibration class
         VPedestalCalculator* fPedestalCalculator; //!< default pedestal calculator
         VImageAnalyzer* fAnalyzer;                     //!< default analyzer class
+        vector< VImageAnalyzer* > fTelAnalyzer;   //!< one analyzer per telescope (multi-threaded image analysis)
+        VThreadPool* fThreadPool;                 //!< thread pool for multi-threaded image analysis
+        VTraceHandler* fTraceHandlerTemplate;     //!< trace handler copied for each analysis thread
         VArrayAnalyzer* fArrayAnalyzer;           //!< default array analyzer
         VDST* fDST;                               //!< data summarizer
 
@@ -74,6 +80,7 @@ class VEventLoop : public VEvndispData
         int  fTimeCut_RunStartSeconds;                 //!< run start in seconds of the day
 
         int      analyzeEvent();                  //!< analyze current event
+        void     analyzeImagesParallel( vector< unsigned int > );  //!< image analysis for several telescopes in parallel
         int      checkArrayCuts();                //!< check cuts (see tab cut option) for current event
         int      checkCuts();                     //!< check cuts (see tab cut option) for current event
         int      checkTimeCuts();                 //!< check time cuts
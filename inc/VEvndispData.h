@@ -13,10 +13,12 @@
 #include "VGrIsuReader.h"
 #include "VMCParameters.h"
 #include "VMultipleGrIsuReader.h"
+#include "VSyntheticDataReader.h"
 #ifndef NOVBF
 #include "VBaseRawDataReader.h"
 #endif
 #include "VDB_PixelDataReader.h"
+#include "VEvndispProfiler.h"
 #include "VEvndispRunParameter.h"
 #include "VFitTraceHandler.h"
 #include "VStarCatalogue.h"
@@ -53,7 +55,7 @@ class VEvndispData
 
         // telescope data
         static unsigned int fNTel;                //!< total number of telescopes
-        static unsigned int fTelID;               //!< telescope number of current telescope
+        static thread_local unsigned int fTelID;  //!< telescope number of current telescope (one per analysis thread)
         static vector< unsigned int > fTeltoAna;  //!< analyze only this subset of telescopes (this is dynamic and can change from event to event)
         // telescope pointing (one per telescope)
         static VArrayPointing* fArrayPointing;
@@ -72,6 +74,7 @@ class VEvndispData
         static VBaseRawDataReader* fRawDataReader;
 #endif
         static VDSTReader* fDSTReader;
+        static VSyntheticDataReader* fSyntheticDataReader;
 
         // DB pixel data
         static VDB_PixelDataReader* fDB_PixelDataReader;
@@ -100,8 +103,11 @@ class VEvndispData
         //!< 0: good event
         static vector< unsigned int > fAnalysisTelescopeEventStatus;
 
-        // global trace handler
-        static VTraceHandler* fTraceHandler;
+        // profiler for analysis stages (optional)
+        static VEvndispProfiler* fProfiler;
+
+        // global trace handler (one per analysis thread)
+        static thread_local VTraceHandler* fTraceHandler;
         static VFitTraceHandler* fFitTraceHandler;
 
         // calibrator and calibration data
@@ -711,6 +717,10 @@ class VEvndispData
         {
             return fNTel;
         }
+        unsigned int        getNumberofGoodEvents()
+        {
+            return fNumberofGoodEvents;
+        }
         TFile*              getOutputFile()
         {
             return fOutputfile;
@@ -1103,6 +1113,10 @@ class VEvndispData
         {
             return fFitTraceHandler;
         }
+        VEvndispProfiler*   getProfiler()
+        {
+            return fProfiler;
+        }
         vector< valarray< double > >& getPulseTiming( bool iCorrected = true );
         valarray<double>&   getPulseTime( bool iCorrected = true );
         valarray<double>&   getTZeros()
@@ -0,0 +1,110 @@
+//! VEvndispProfiler wall/cpu time, call counts, and memory usage of the analysis stages
+
+#ifndef VEVNDISPPROFILER_H
+#define VEVNDISPPROFILER_H
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <time.h>
+
+#include "TTree.h"
+
+using namespace std;
+
+// analysis stages (names are set in VEvndispProfiler::VEvndispProfiler())
+enum E_ProfilerStage
+{
+    E_PROF_READEVENT,
+    E_PROF_EVENTANALYSIS,
+    E_PROF_CALCSUMS,
+    E_PROF_CALCTZEROS,
+    E_PROF_CALCTZEROSSUMS,
+    E_PROF_CALCSECONDTZEROSSUMS,
+    E_PROF_IMAGEPARAMETERS,
+    E_PROF_TIMINGPARAMETERS,
+    E_PROF_LLFIT,
+    E_PROF_MUON,
+    E_PROF_HOUGHMUON,
+    E_PROF_ARRAYANALYSIS,
+    E_PROF_TREEFILLING_IMAGE,
+    E_PROF_TREEFILLING_SHOWER,
+    E_PROF_IMAGECLEANING                          // one stage per cleaning method (see getImageCleaningStageID())
+};
+
+class VEvndispProfiler
+{
+    private:
+        static const unsigned int fNImageCleaningMethods = 6;
+
+        mutex fMutex;
+
+        chrono::steady_clock::time_point fStartTime;
+
+        vector< string > fStageName;
+        vector< unsigned long int > fNCalls;
+        vector< double > fWallTime;               //!< wall time [s]
+        vector< double > fCPUTime;                //!< cpu time [s] (of the thread(s) executing the stage)
+        vector< double > fPeakRSS;                //!< peak resident set size of the process at the end of the stage [MB]
+        vector< double > fPeakRSSIncrease;        //!< increase of the peak resident set size during the stage [MB]
+
+    public:
+        VEvndispProfiler();
+        ~VEvndispProfiler() {}
+
+        unsigned int compareWithBaseline( string iFile, unsigned int iNEvents, double iTolerance = 0.2 );
+        void   fill( unsigned int iStageID, double iWallTime, double iCPUTime, double iPeakRSS_start, double iPeakRSS_stop );
+        static double getCPUTime();
+        static double getPeakRSS();
+        static unsigned int getImageCleaningStageID( unsigned int iMethod )
+        {
+            return E_PROF_IMAGECLEANING + ( iMethod < fNImageCleaningMethods ? iMethod : fNImageCleaningMethods - 1 );
+        }
+        TTree* getTree( string iName = "profile" );
+        void   print( unsigned int iNEvents = 0 );
+        void   setStageName( unsigned int iStageID, string iStageName );
+        bool   writeBaseline( string iFile, unsigned int iNEvents );
+};
+
+/*
+    timing of a stage from construction to destruction
+
+    (nothing is done if profiler is zero)
+*/
+class VEvndispProfilerTimer
+{
+    private:
+        VEvndispProfiler* fProfiler;
+        unsigned int fStageID;
+        chrono::steady_clock::time_point fWallTime_start;
+        double fCPUTime_start;
+        double fPeakRSS_start;
+
+        void   start( VEvndispProfiler* iProfiler, unsigned int iStageID );
+
+    public:
+        VEvndispProfilerTimer( VEvndispProfiler* iProfiler, unsigned int iStageID )
+        {
+            fProfiler = 0;
+            if( iProfiler )
+            {
+                start( iProfiler, iStageID );
+            }
+        }
+        ~VEvndispProfilerTimer()
+        {
+            stop();
+        }
+        void   stop();
+};
+#endif
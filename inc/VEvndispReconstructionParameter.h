@@ -85,7 +85,7 @@ class VEvndispReconstructionParameter : public TNamed
 
         bool   applyArrayAnalysisCuts( unsigned int iMeth, unsigned int iTel, unsigned int iTelType,
                                        VImageParameter* iImageParameter, unsigned short int iLocalTriggerType,
-                                       VStarCatalogue* iStar = 0 );
+                                       float iStarDistance_deg = -1. );
         int    getTelescopeType_counter( ULong64_t t );
         int    getTelescopeType_counter_from_MirrorArea( ULong64_t t );
         int    getTelescopeType_counter_from_MirrorArea_and_PixelSize( ULong64_t t );
@@ -75,6 +75,9 @@ class VEvndispRunParameter : public TNamed, public VGlobalRunParameter
         int    fFirstEvent;                       // skip up till this event
         int    fTimeCutsMin_min;                  // start to analyse run at this min
         int    fTimeCutsMin_max;                  // stop to analyse this run at this min
+        unsigned int fNThreads;                   // number of threads for image analysis (telescope-parallel) or calibration passes
+        unsigned int fReadAheadEvents;            // number of events read ahead by the data reader (0 = no read ahead)
+        bool   fProfile;                          // profile analysis stages (timing and memory usage)
 
         bool fprintdeadpixelinfo ; 		 // DEADCHAN if true, will print list of dead pixels
         // at end of run to evndisp.log
@@ -140,6 +143,7 @@ class VEvndispRunParameter : public TNamed, public VGlobalRunParameter
         bool fWriteExtraCalibTree;		  // write additional tree into .gain.root file with channel charges/monitor charge/nHiLo for each event
         bool fWriteImagePixelList;        // write image pixel list to tpars tree
         string fLowGainCalibrationFile;           // file with file name for low-gain calibration
+        string fCalibrationCacheDirectory;        // directory for binary calibration cache files (empty: no cache)
         int fNCalibrationEvents;                  // events to be used for calibration
         int fNMinimumNumberOfPedestalEvents;      // minimum number of pedestal events required for pedestal calculation
         float faverageTZeroFiducialRadius;        // fiducial radius for average tzero calculation (DST), in fraction of FOV
@@ -216,6 +220,7 @@ class VEvndispRunParameter : public TNamed, public VGlobalRunParameter
 
         // image analysis
         int    fImageLL;                          // loglikelihood image parameterisation 0=off/1=on/2=verbose mode (default: 0=off )
+        int    fImageLLFitter;                    // fitter for loglikelihood image parameterisation 0=minuit/1=gradient
         vector< float > fLogLikelihoodLoss_min;   // do loglikelihood image parameterisation if loss is larger than this value
         vector< int > fLogLikelihood_Ntubes_min; //  do loglikelihood image parameterisation if ntubes is larger than this value
         float  fImageAnalysisFUIFactor;           // FUI factor for image analysis
@@ -250,6 +255,12 @@ class VEvndispRunParameter : public TNamed, public VGlobalRunParameter
         int fMCNdeadboard;                        // number of boards set randomly dead (10 dead pixels in a row)
         double fMCScale;                          // scale factor for MC data
 
+        // synthetic events (source type 8)
+        unsigned int fSynthNPixel;                // number of pixels per camera
+        unsigned int fSynthNSamples;              // number of FADC samples
+        double fSynthImageSize;                   // image size [pe] of showers at threshold
+        double fSynthNSBRate;                     // night sky background rate [pe/ns]
+
         // tree filling
         unsigned int fShortTree;                  // 0: full tree; 1: short tree
         unsigned int fwriteMCtree;                // 0: do not write MC tree
@@ -284,6 +295,10 @@ class VEvndispRunParameter : public TNamed, public VGlobalRunParameter
         string fdstfile;                          // dst output file name (root file)
         int fdstminntubes;                        // write only events with more than fdstminntubes ntubes into dst file
         bool fdstwriteallpixel;                   // write all information of all pixel into dst output files
+        bool fdstslim;                            // write image/border pixel only as sparse pixel list into dst files
+        bool fdstasync;                           // fill dst tree in a separate writer thread
+        string fdstcompression;                   // compression settings for dst file and dst branches (e.g. "505,sum:404")
+        bool fdstsparse;                          // DST source files: copy hit channels only (slim or zero-suppressed DSTs)
 
         TString  fNNGraphsFile;
         TString  fIPRdatabase;                    // file to read IPRs from external database
@@ -333,6 +348,6 @@ class VEvndispRunParameter : public TNamed, public VGlobalRunParameter
             return ( fDBTextDirectory.size() > 0 );
         }
 
-        ClassDef( VEvndispRunParameter, 2008 ); //(increase this number)
+        ClassDef( VEvndispRunParameter, 2016 ); //(increase this number)
 };
 #endif
@@ -18,6 +18,7 @@
 #include "TMinuit.h"
 
 #include "VTraceHandler.h"
+#include "VTracePulseFitter.h"
 #include "VVirtualDataReader.h"
 
 using namespace std;
@@ -32,10 +33,10 @@ class VFitTraceHandler : public VTraceHandler
 
     private:
         string fFitFunction;                      //!< ev or grisu
-        TF1* fF1Trace;                            //!< fit function
+        TF1* fF1Trace;                            //!< fit function (for plotting only)
         TF1* fF1TraceGr;                          //!< fit function (from grisu)
         TH1D* fH1Trace;                           //!< histogram with values from fit function
-        TH1D* fH1TraceData;                       //!< histogram with trace data
+        VTracePulseFitter fPulseFitter;           //!< pulse fitter (result of last fit)
         int fMaxSamples;                          //!< sample maximum (usually 64)
         bool fFitted;                             //!< true after trace fit
         bool fMinuitPrint;                        //!< if true, long printout from minuit
@@ -47,8 +48,6 @@ class VFitTraceHandler : public VTraceHandler
         double fTraceMax;                         //!< maximum of trace
         double fTraceMaxX;                        //!< position of maximum of trace
 
-        unsigned int fMC_FADCTraceStart;          // start of FADC trace (in case the simulated trace is longer than needed)
-
         // analysis histograms
         TH1D* fHfitstat;
         int fnstat;                               //!< fit status ( bad if < 3 )
@@ -59,16 +58,37 @@ class VFitTraceHandler : public VTraceHandler
 
         double fFitThresh;                        //!< threshold above trace is fitted
 
+        // fit results per channel (reused as long as trace and pedestals do not change)
+        vector< VTracePulseFitter > fFitCache;
+        vector< vector< double > > fFitCacheTrace;  //!< trace samples (compared sample by sample)
+        vector< double > fFitCachePed;
+        vector< double > fFitCachePedRMS;
+        vector< bool > fFitCacheValid;
+        vector< bool > fFitCacheFitted;
+
+        // traces to be fitted in batch mode (all samples of all traces)
+        vector< double > fBatchTrace;
+        vector< unsigned int > fBatchTraceStart;
+        vector< unsigned int > fBatchNSamples;
+        vector< unsigned int > fBatchChanID;
+        vector< double > fBatchPed;
+        vector< double > fBatchPedRMS;
+
+        void fillFitHistograms( unsigned int chanID );
         void fitTrace( unsigned int chanID );
+        bool getCachedFit( unsigned int chanID );
+        void setCachedFit( unsigned int chanID, const double* iTrace, unsigned int iNSamples );
+        void setFitResults();
 
     public:
         VFitTraceHandler( string );
         ~VFitTraceHandler();
 
-        TF1*   getFitFun()                        //!< get fit function
-        {
-            return fF1Trace;
-        }
+        //!< fit all traces (fills fit results for each channel)
+        void   fitTraces( VVirtualDataReader* iReader, unsigned int iNSamples,
+                          const vector< unsigned int >& iChanID, const vector< unsigned int >& iHitID,
+                          const vector< double >& iPed, const vector< double >& iPedRMS, const vector< double >& iHiLo );
+        TF1*   getFitFun();                       //!< get fit function
         TH1D*  getFitHis();                       //!< get histogram of fit function
         bool   getFitted()                        //!< status of tracehandler, true after fit
         {
@@ -130,18 +150,14 @@ class VFitTraceHandler : public VTraceHandler
         {
             fMinuitPrint = iPrint;
         }
-        void    setMC_FADCTraceStart( unsigned int iO = 0 )
-        {
-            fMC_FADCTraceStart = iO;
-        }
         //!< set trace, pedestal, pedestal rms
-        void   setTrace( vector< uint8_t >, double, double, unsigned int );
+        void   setTrace( const vector< uint8_t >&, double, double, unsigned int );
         //!< set trace, pedestal, pedestal rms
-        void   setTrace( vector< uint8_t >, double, double, unsigned int, double );
+        void   setTrace( const vector< uint8_t >&, double, double, unsigned int, double );
         //!< set trace, pedestal, pedestal rms
-        void   setTrace( vector< uint16_t >, double, double, unsigned int );
+        void   setTrace( const vector< uint16_t >&, double, double, unsigned int );
         //!< set trace, pedestal, pedestal rms
-        void   setTrace( vector< uint16_t >, double, double, unsigned int, double );
+        void   setTrace( const vector< uint16_t >&, double, double, unsigned int, double );
         //!< set trace, pedestal, pedestal rms
         void   setTrace( VVirtualDataReader* iReader, unsigned int iNSamples, double ped, double pedrms,
                          unsigned int iChanID, unsigned int iHitID, double iHilo = -1. );
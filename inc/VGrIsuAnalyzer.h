@@ -25,8 +25,8 @@ class VGrIsuAnalyzer
     protected:
         int    two_line_intersect( vector<float> x, vector<float> y, vector<float> w, vector<float> mx, vector<float> my, unsigned int num_images, float* sx, float* sy, float* std );
         float rcs_perpendicular_dist( float xs, float ys, float xp, float yp, float m );
-        int    rcs_perpendicular_fit( vector<float> x, vector<float> y, vector<float> w, vector<float> m, unsigned int num_images, float* sx, float* sy, float* std );
-        int    rcs_rotate_delta( vector<float> xtel, vector<float> ytel, vector<float> ztel, vector<float>& xtelnew, vector<float>& ytelnew, vector<float>& ztelnew, float thetax, float thetay, int nbr_tel );
+        int    rcs_perpendicular_fit( const vector<float>& x, const vector<float>& y, const vector<float>& w, const vector<float>& m, unsigned int num_images, float* sx, float* sy, float* std );
+        int    rcs_rotate_delta( const vector<float>& xtel, const vector<float>& ytel, const vector<float>& ztel, vector<float>& xtelnew, vector<float>& ytelnew, vector<float>& ztelnew, float thetax, float thetay, int nbr_tel );
 
     public:
         VGrIsuAnalyzer();
@@ -8,12 +8,7 @@
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
-
-
-//ROOT includes
-
-#include "TH3D.h"
-#include "TTree.h"
+#include <vector>
 
 //Event Display includes
 
@@ -66,13 +61,33 @@ class VHoughTransform
 
         vector <double> fPMTDiameter; //Diameter of a PMT in mm
 
-        vector <TH3D*> fAccumulatorArray; //Hough transform accumulator arrays
+        //Hough transform accumulator arrays (flat integer arrays, binning as for a TH3D including under/overflow bins)
+        //Global bin number: ix + nx * ( iy + ny * ir ), with nx = number of x bins + 2, ny = number of y bins + 2
+
+        vector < vector <unsigned int> > fAccumulatorArray; //Hough transform accumulator arrays
+
+        vector < vector <unsigned int> > fAccumulatorNonZeroBins; //Non-zero bins of the accumulator arrays (for fast reset)
+
+        vector <int> fAccumulatorNBins[3]; //Number of bins in x, y, r
+
+        vector <double> fAccumulatorMin[3]; //Lower edge of the accumulator array in x, y, r
+
+        vector <double> fAccumulatorMax[3]; //Upper edge of the accumulator array in x, y, r
+
+        //Hough transform lookup tables: accumulator bins of all template circles hitting a pixel
+        //(bins for pixel i are fHTLookupTableBins[ fHTLookupTableOffset[i] ] ... fHTLookupTableBins[ fHTLookupTableOffset[i+1] - 1 ])
+
+        vector < vector <unsigned int> > fHTLookupTableOffset; //Index of the first template circle for each pixel
+
+        vector < vector <unsigned int> > fHTLookupTableBins; //Accumulator bins of the template circles
+
+        void initAccumulatorArray( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int fTelID ); //Method for initializing the Hough transform accumulator array
 
-        vector <TTree*> fHTLookupTableTree; //Trees with the Hough transform lookup tables
+        void initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int fTelID ); //Method for initializing the Hough transform lookup table
 
-        TH3D* initAccumulatorArray( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int fTelID ); //Method for initializing the Hough transform accumulator array
+        unsigned int getAccumulatorBin( unsigned int fTelID, double x, double y, double r ); //Global bin of the accumulator array (as TH3D::FindBin)
 
-        TTree* initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int fTelID ); //Method for initializing the Hough transform lookup table
+        void getAccumulatorBinCenter( unsigned int fTelID, unsigned int iBin, double* fCoordinates ); //x, y, r coordinates of the center of an accumulator bin
 
         void readHTParameterFile( unsigned int fTelID );
 
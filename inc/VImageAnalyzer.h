@@ -30,6 +30,7 @@ class VImageAnalyzer : public VImageBaseAnalyzer
         VImageParameterCalculation* fVImageParameterCalculation;    //!< image calculation
 
         bool fInit;
+        bool fResetAfterFill;                     //!< reset image after filling the output tree (events without trigger)
 
         // temporary vectors for dead pixel smoothing
         vector< unsigned int > savedDead;
@@ -43,6 +44,7 @@ class VImageAnalyzer : public VImageBaseAnalyzer
         void muonRingAnalysis();                  //! muon ring analysis
         void houghMuonRingAnalysis();                  //! hough transform muon ring analysis
         void printTrace( int i_channel );         //!< print trace information for one channel (debugging)
+        void resetImage();                        //!< reset sums, timing and image/border flags
         void setAnaDir( unsigned int iTel );      //!< set directories in root output file
         void setNTrigger();
         void smoothDeadTubes();                   //!< reduce the effect of dead tubes
@@ -51,7 +53,8 @@ class VImageAnalyzer : public VImageBaseAnalyzer
         VImageAnalyzer();
         ~VImageAnalyzer();
 
-        void doAnalysis();                        //!< do the actual analysis (called for each event)
+        void doAnalysis( bool iFillOutputTree = true );  //!< do the actual analysis (called for each event)
+        void fillDeferredOutputTree();            //!< fill output tree after doAnalysis( false )
         VImageCleaning*  getImageCleaner()
         {
             return fVImageCleaning;    //! return pointer to image cleaner
@@ -103,6 +103,10 @@ class VImageAnalyzerData
         // special channels
         VSpecialChannel* fSpecialChannel;
 
+        // DST sparse replay: channels copied in the previous event (0: sums, 1: pulse timing, 2: trace maxima)
+        vector< unsigned int > fSparseDSTChannels[3];
+        bool fSparseDSTChannelsValid[3];          //!< false: all channels have to be reset
+
         // FADCstop info
         vector< double > fFADCstopTZero;
         vector< double > fFADCstopSum;
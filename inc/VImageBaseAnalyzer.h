@@ -4,6 +4,7 @@
 #define VIMAGEBASEANALYZER_H
 
 #include "VEvndispData.h"
+#include "VTraceBatchHandler.h"
 
 #include "TTree.h"
 
@@ -19,10 +20,15 @@ class VImageBaseAnalyzer : public VEvndispData
     protected:
         vector<bool> fCalibrated;                 //!  true = calibration is done
         bool fRaw;
+        VTraceBatchHandler* fTraceBatchHandler;   //!< trace analysis for all high-gain channels at once
 
         void calcSecondTZerosSums();
+        void copySparseDSTData( bool iSums, bool iTiming, bool iTraceMax );
         void calcTZeros( int, int );
         void calcTZerosSums( int, int, unsigned int );
+        void calcTraceFits_batch( unsigned int nhits );
+        void calcTZerosSums_batch( int iFirstSum, int iLastSum, unsigned int iTraceIntegrationMethod,
+                                   unsigned int nhits, vector< bool >& iAnalysed );
         unsigned int getDynamicSummationWindow( unsigned int chanID );
         int  getFADCTraceIntegrationPosition( int iPos );
         void FADCStopCorrect();
@@ -34,8 +40,14 @@ class VImageBaseAnalyzer : public VEvndispData
                               unsigned int i, unsigned int iTraceIntegrationMethod );
 
     public:
-        VImageBaseAnalyzer() {}
-        ~VImageBaseAnalyzer() {}
+        VImageBaseAnalyzer()
+        {
+            fTraceBatchHandler = 0;
+        }
+        ~VImageBaseAnalyzer()
+        {
+            delete fTraceBatchHandler;
+        }
 
         void           calcTCorrectedSums( int, int );
         void           calcSums( int iFirst, int iLast, bool iMakingPeds, bool iLowGainOnly = false, unsigned int iTraceIntegrationMethod = 9999 );
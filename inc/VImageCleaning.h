@@ -6,7 +6,11 @@
 #include "VEvndispData.h"
 #include <TGraphErrors.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "VImageCleaningRunParameter.h"
+#include "VPixelBitMask.h"
 
 using namespace std;
 
@@ -17,19 +21,41 @@ class VImageCleaning
         VEvndispData* fData;
         bool fWriteGraphToFileRecreate;
 
+        // neighbour lists in compressed sparse row format (per telescope, filled at first use)
+        vector< vector< unsigned int > > fNeighbourCSROffset;  // [telID][channel]: first entry in neighbour list (nchannel+1 entries)
+        vector< vector< unsigned int > > fNeighbourCSRList;    // [telID][entry]: neighbour channel
+        const unsigned int* fCSROffset;                       // neighbour lists of current telescope
+        const unsigned int* fCSRList;
+        // image state of current telescope as bit masks
+        VPixelBitMask fMaskImage;
+        VPixelBitMask fMaskBorder;
+        VPixelBitMask fMaskBrightNonImage;
+        VPixelBitMask fMaskDead;                               // dead channels (high gain)
+        VPixelBitMask fMaskTemp;
+        vector< double > fPedvarsCurrent;                      // pedvars of current event (for summation window and gain of each channel)
+
         void cleanImageWithTiming( VImageCleaningRunParameter* iImageCleaningParameters, bool isFixed );
+        void fillCurrentPedvars();
         void fillImageBorderNeighbours();
+        void fillImageBorderNeighboursBitMask();
+        void fillNeighbourCSR();
+        int  findMergedCluster( int iClusterID );
         void mergeClusters();
+        void readImageBitMasks();
         void recoverImagePixelNearDeadPixel();
+        void recoverImagePixelNearDeadPixelBitMask();
         void printDataError( string iFunctionName );
         void removeIslandOfImageBorderPair();
         void removeSmallClusters( int );
+        void writeImageBitMasks();
 
         // cluster cleaning
         void addToCluster( unsigned int cID, unsigned int iChan );
-        void removeCluster( unsigned int cID ) ;
+        void removeClusters( const vector< bool >& iKeepCluster );
         vector<int> fNpixCluster;
         vector<double> fSizeCluster;
+        vector< pair< unsigned int, unsigned int > > fClusterStack;   // (channel, neighbour list position)
+        vector< int > fClusterMerge;                           // [cluster ID]: ID of cluster it is merged into
 
         // NN image cleaning
         bool  kInitNNImageCleaning;
@@ -54,11 +80,22 @@ class VImageCleaning
         bool   setExplicitSampleTimeSlice;      // Set the sample time slice and number of ADC bins to read explicitly
         float  sampleTimeSlice;                // Size of time slice in ns (usually 1 or 2 ns)
         unsigned int  nBinsADC;                // Number of ADC bins summed up, each bin the size of sampleTimeSlice
-        float fIPR_save_mincharge;
-        float fIPR_save_dT_from_probCurve;
-        unsigned int fIPR_save_telid;
-        double fIPR_save_ProbCurve_par1;
-        double fIPR_save_ProbCurve_par2;
+        // lookup tables for NN image cleaning (filled once per telescope type)
+        vector< vector< double > > fNNIPRCharge;        // [teltype][point] IPR graph: charge (sorted)
+        vector< vector< double > > fNNIPRRate;          // [teltype][point] IPR graph: rate [Hz]
+        vector< double > fNNIPRChargeStepInv;           // [teltype] inverse charge step (0 for non-equidistant IPR graphs)
+        float fNNPreThresh[VDST_MAXTELTYPES][VDST_MAXNNGROUPTYPES];  // pre-search thresholds (from IPR graph)
+        float fNNCombFactor[VDST_MAXTELTYPES][VDST_MAXNNGROUPTYPES]; // combinatorial factors of rate contours
+        int   fNNNfold[VDST_MAXNNGROUPTYPES];           // multiplicity of NN groups (1 for boundary contour)
+        // neighbour lists for NN image cleaning (per telescope, filled at first use)
+        vector< vector< unsigned int > > fNNNeighbourOffset;   // [telID][channel]: first entry in neighbour list (nchannel+1 entries)
+        vector< vector< unsigned int > > fNNNeighbourList;     // [telID][entry]: neighbour channel
+        const unsigned int* fNNOffset;                         // neighbour lists of current telescope
+        const unsigned int* fNNList;
+        // charge and time cuts of current NN group search
+        vector< unsigned char > fNNPixelValid;          // [channel] pixel passes validity and pre-cut
+        vector< float > fNNPixelDT;                     // [channel] rate contour (max time difference) for charge of this pixel
+        vector< unsigned char > fNNPairPass;            // [entry] neighbour pair passes charge and time cut
 
         float INTENSITY[VDST_MAXCHANNELS];     //
         float TIMES[VDST_MAXCHANNELS];         //
@@ -68,11 +105,18 @@ class VImageCleaning
         void LocMax( int n, float* ptr, float& max );
 
         // main functions
-        bool  BoundarySearch( unsigned int TrigSimTelType, float thresh, TF1* fProbCurve, float refdT, int refvalidity, int idx );
-        unsigned int   NNGroupSearchProbCurve( unsigned int TrigSimTelType, TF1* fProbCurve, float PreCut );
-        unsigned int   NNGroupSearchProbCurveRelaxed( unsigned int TrigSimTelType, TF1* fProbCurve, float PreCut );
-        bool  NNChargeAndTimeCut( TGraph* IPR,  float iIPR_max, TF1* fProbCurve, float charge, float dT,
+        bool  BoundarySearch( unsigned int TrigSimTelType, float thresh, double iContourNorm, int iNfold,
+                              float refdT, int refvalidity, int idx );
+        unsigned int   NNGroupSearchProbCurve( unsigned int TrigSimTelType, unsigned int iGroupType, float PreCut );
+        unsigned int   NNGroupSearchProbCurveRelaxed( unsigned int TrigSimTelType, unsigned int iGroupType, float PreCut );
+        bool  NNChargeAndTimeCut( unsigned int TrigSimTelType, double iContourNorm, int iNfold, float charge, float dT,
                                   float iCoincWinLimit, bool bInvert = false );
+        void  fillNNLookupTables( unsigned int TrigSimTelType, TGraph* iIPR );
+        void  fillNNNeighbourLists();
+        void  fillNNPairCuts( unsigned int TrigSimTelType, double iContourNorm, int iNfold, float PreCut );
+        float getNNIPR( unsigned int TrigSimTelType, float charge );
+        double getNNContourNorm( unsigned int TrigSimTelType, unsigned int iGroupType );
+        float getNNContourDT( float iIPR, double iContourNorm, int iNfold );
         void  ScaleCombFactors( unsigned int TrigSimTelType, float scale );
         void  ResetCombFactors( unsigned int TrigSimTelType );
         int   ImageCleaningCharge( unsigned int TrigSimTelType );
@@ -0,0 +1,83 @@
+//! VImageLLFitter loglikelihood fit of a 2D-Gaussian to camera images (analytic gradient)
+
+#ifndef VIMAGELLFITTER_H
+#define VIMAGELLFITTER_H
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+class VImageLLFitter
+{
+    private:
+        static const unsigned int fNPar = 6;      //!< rho, meanX, sigmaX, meanY, sigmaY, signal
+
+        double fPar[fNPar];                       //!< fit parameters
+        double fParError[fNPar];                  //!< errors of fit parameters
+        double fParMin[fNPar];                    //!< lower parameter limits
+        double fParMax[fNPar];                    //!< upper parameter limits
+        bool   fParLimited[fNPar];                //!< parameter has limits
+
+        double fTolerance;                        //!< convergence criterium (estimated distance to minimum)
+        unsigned int fMaxIterations;
+
+        // fit results
+        double fFmin;
+        double fEDM;
+        int    fStatus;
+        unsigned int fNIterations;
+        unsigned int fNCalls;
+
+        // data (not owned by fitter)
+        const vector< double >* fX;
+        const vector< double >* fY;
+        const vector< double >* fSums;
+
+        void   clampToLimits( double* p );
+        double getFunctionValue( const double* p, double* iGradient, double* iFisher );
+        bool   invert( vector< double >& A, unsigned int n );
+        bool   solve( vector< double > A, vector< double >& b, unsigned int n );
+
+    public:
+        VImageLLFitter();
+        ~VImageLLFitter() {}
+
+        void   defineParameter( unsigned int iPar, double iValue, double iMin = 0., double iMax = 0. );
+        int    fit( const vector< double >& iX, const vector< double >& iY, const vector< double >& iSums );
+        double getEDM()
+        {
+            return fEDM;
+        }
+        double getFmin()
+        {
+            return fFmin;
+        }
+        double getFunctionValue( const double* p )
+        {
+            return getFunctionValue( p, 0, 0 );
+        }
+        unsigned int getNCalls()
+        {
+            return fNCalls;
+        }
+        unsigned int getNIterations()
+        {
+            return fNIterations;
+        }
+        void   getParameter( unsigned int iPar, double& iValue, double& iError );
+        int    getStatus()                       //!< 0 = no fit, 1 = not converged, 2 = converged (singular covariance), 3 = converged
+        {
+            return fStatus;
+        }
+        void   setMaxIterations( unsigned int iN = 200 )
+        {
+            fMaxIterations = iN;
+        }
+        void   setTolerance( double iT = 5.e-5 )
+        {
+            fTolerance = iT;
+        }
+};
+#endif
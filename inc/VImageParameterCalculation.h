@@ -5,12 +5,14 @@
 
 #include <cmath>
 #include <iostream>
+#include <mutex>
 #include <valarray>
 #include <vector>
 
 #include "VDetectorGeometry.h"
 #include "VEvndispData.h"
 #include "VHoughTransform.h"
+#include "VImageLLFitter.h"
 #include "VImageParameter.h"
 
 #include "TError.h"
@@ -54,6 +56,7 @@ class VImageParameterCalculation : public TObject
         vector<double> fll_Sums;                  //!< data vector for minuit function
         vector<double> fll_Pedvars;               //!< data vector for minuit function
         vector<bool> fLLEst;                      //!< true if channel has an estimated sum from the LL fit
+        VImageLLFitter* fLLGradientFitter;        //!< gradient based LL fitter (alternative to global minuit fitter)
 
         double getFractionOfImageBorderPixelUnderImage( double, double, double, double, double, double );
         double redang( double angle, double maxI );  //!< reduce angle to interval [0.,maxI]
@@ -5,11 +5,11 @@
 
 #include "VImageBaseAnalyzer.h"
 #include "VGlobalRunParameter.h"
+#include "VQuantileSketchPool.h"
 #include "VSkyCoordinatesUtilities.h"
 
 #include "TDirectory.h"
 #include "TFile.h"
-#include "TH1.h"
 #include "TMath.h"
 #include "TTree.h"
 
@@ -30,6 +30,7 @@ class VPedestalCalculator : public VImageBaseAnalyzer
         double fLengthofTimeSlice;
         int fSumFirst;
         int fSumWindow;
+        double fMaxSumPerSample;                  //!< maximum trace sum per sample used for pedestal calculation
 
         int runNumber;
         int MJD;
@@ -46,7 +47,8 @@ class VPedestalCalculator : public VImageBaseAnalyzer
         vector< vector< vector< float > > > fpedcal_n;
         vector< vector< vector< float > > > fpedcal_mean;
         vector< vector< vector< float > > > fpedcal_mean2;
-        vector< vector< vector< TH1F* > > > fpedcal_histo;
+        // [telID] (sketch ID: pixelID * fSumWindow + summation window)
+        vector< VQuantileSketchPool > fpedcal_sketch;
 
         vector< vector< float > > v_temp_pedEntries;
         vector< vector< float > > v_temp_ped;
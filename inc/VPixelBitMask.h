@@ -0,0 +1,96 @@
+//! VPixelBitMask  pixel states (image, border, dead, ...) packed into 64-bit words
+
+#ifndef VPIXELBITMASK_H
+#define VPIXELBITMASK_H
+
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+class VPixelBitMask
+{
+    private:
+        vector< uint64_t > fWord;
+        unsigned int fNBits;
+
+    public:
+        VPixelBitMask( unsigned int iNBits = 0 )
+        {
+            resize( iNBits );
+        }
+        ~VPixelBitMask() {}
+
+        /*
+            pack a vector of flags (nonzero entries are set)
+        */
+        template< class T > void fill( const vector< T >& iV, unsigned int iNBits )
+        {
+            resize( iNBits );
+            for( unsigned int i = 0; i < iV.size() && i < iNBits; i++ )
+            {
+                if( iV[i] )
+                {
+                    set( i );
+                }
+            }
+        }
+        /*
+            unpack into a vector of flags (vector is resized to number of bits)
+        */
+        void fillVector( vector< bool >& iV ) const
+        {
+            iV.assign( fNBits, false );
+            for( unsigned int w = 0; w < fWord.size(); w++ )
+            {
+                uint64_t iW = fWord[w];
+                while( iW )
+                {
+                    iV[getFirstBit( iW ) + 64 * w] = true;
+                    iW &= iW - 1;
+                }
+            }
+        }
+        static unsigned int getFirstBit( uint64_t iW )   //!< index of lowest set bit (iW must be nonzero)
+        {
+            return ( unsigned int )__builtin_ctzll( iW );
+        }
+        unsigned int getNWords() const
+        {
+            return fWord.size();
+        }
+        uint64_t& getWord( unsigned int w )
+        {
+            return fWord[w];
+        }
+        uint64_t getWord( unsigned int w ) const
+        {
+            return fWord[w];
+        }
+        void reset()
+        {
+            fWord.assign( fWord.size(), 0 );
+        }
+        void reset( unsigned int i )
+        {
+            fWord[i >> 6] &= ~( ( uint64_t )1 << ( i & 63 ) );
+        }
+        void resize( unsigned int iNBits )
+        {
+            fNBits = iNBits;
+            fWord.assign( ( iNBits + 63 ) / 64, 0 );
+        }
+        void set( unsigned int i )
+        {
+            fWord[i >> 6] |= ( uint64_t )1 << ( i & 63 );
+        }
+        unsigned int size() const
+        {
+            return fNBits;
+        }
+        bool test( unsigned int i ) const
+        {
+            return ( fWord[i >> 6] >> ( i & 63 ) ) & 1;
+        }
+};
+#endif
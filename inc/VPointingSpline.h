@@ -0,0 +1,119 @@
+//! VPointingSpline  natural cubic spline on an equidistant time grid (O(1) evaluation, used for per-run pointing tables)
+
+#ifndef VPOINTINGSPLINE_H
+#define VPOINTINGSPLINE_H
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+class VPointingSpline
+{
+    private:
+        double fX0;                               //!< first grid point
+        double fStep;                             //!< grid step
+        double fPeriod;                           //!< period of the tabulated angle (0 = not periodic)
+        double fWrapMin;                          //!< periodic angles are returned in [fWrapMin, fWrapMin + fPeriod)
+        vector< double > fY;                      //!< values at grid points (unwrapped for periodic angles)
+        vector< double > fY2;                     //!< second derivatives at grid points
+
+    public:
+        VPointingSpline()
+        {
+            reset();
+        }
+        ~VPointingSpline() {}
+
+        /*
+            value at x (x outside the table is clamped to the first/last interval)
+        */
+        double eval( double x ) const
+        {
+            double t = ( x - fX0 ) / fStep;
+            int i = ( int )floor( t );
+            if( i < 0 )
+            {
+                i = 0;
+            }
+            else if( i > ( int )fY.size() - 2 )
+            {
+                i = ( int )fY.size() - 2;
+            }
+            double b = t - ( double )i;
+            double a = 1. - b;
+            double y = a * fY[i] + b * fY[i + 1]
+                       + ( ( a * a * a - a ) * fY2[i] + ( b * b * b - b ) * fY2[i + 1] ) * fStep * fStep / 6.;
+            // wrap periodic angles back into the range of the input values
+            if( fPeriod > 0. )
+            {
+                y -= fPeriod * floor( ( y - fWrapMin ) / fPeriod );
+            }
+            return y;
+        }
+        double getXmax() const
+        {
+            return ( fY.size() > 1 ? fX0 + fStep * ( double )( fY.size() - 1 ) : fX0 );
+        }
+        double getXmin() const
+        {
+            return fX0;
+        }
+        bool isInside( double x ) const
+        {
+            return ( fY.size() > 1 && x >= fX0 && x <= getXmax() );
+        }
+        void reset()
+        {
+            fX0 = 0.;
+            fStep = 1.;
+            fPeriod = 0.;
+            fWrapMin = 0.;
+            fY.clear();
+            fY2.clear();
+        }
+        /*
+            fill spline from values on the grid x_i = iX0 + i * iStep
+
+            for periodic angles (iPeriod > 0), values are unwrapped before
+            interpolation and wrapped back into [iWrapMin, iWrapMin + iPeriod) by eval()
+        */
+        bool set( double iX0, double iStep, const vector< double >& iY, double iPeriod = 0., double iWrapMin = 0. )
+        {
+            reset();
+            if( iY.size() < 2 || iStep <= 0. )
+            {
+                return false;
+            }
+            fX0 = iX0;
+            fStep = iStep;
+            fPeriod = iPeriod;
+            fWrapMin = iWrapMin;
+            fY = iY;
+            if( fPeriod > 0. )
+            {
+                for( unsigned int i = 1; i < fY.size(); i++ )
+                {
+                    fY[i] -= fPeriod * floor( ( fY[i] - fY[i - 1] ) / fPeriod + 0.5 );
+                }
+            }
+            // natural spline: tridiagonal system for second derivatives (equidistant grid)
+            unsigned int n = fY.size();
+            fY2.assign( n, 0. );
+            vector< double > u( n, 0. );
+            for( unsigned int i = 1; i < n - 1; i++ )
+            {
+                double p = 0.5 * fY2[i - 1] + 2.;
+                fY2[i] = -0.5 / p;
+                u[i] = ( fY[i + 1] - 2. * fY[i] + fY[i - 1] ) / fStep;
+                u[i] = ( 3. * u[i] / fStep - 0.5 * u[i - 1] ) / p;
+            }
+            fY2[n - 1] = 0.;
+            for( int i = ( int )n - 2; i >= 0; i-- )
+            {
+                fY2[i] = fY2[i] * fY2[i + 1] + u[i];
+            }
+            return true;
+        }
+};
+#endif
@@ -0,0 +1,186 @@
+//! VQuantileSketchPool  pool of fixed-size, mergeable quantile sketches (equidistant bins, counts in one flat array)
+
+#ifndef VQUANTILESKETCHPOOL_H
+#define VQUANTILESKETCHPOOL_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+class VQuantileSketchPool
+{
+    private:
+        vector< unsigned int > fOffset;           //!< index of first bin of each sketch in fCounts
+        vector< unsigned int > fNBins;
+        vector< double > fXmin;
+        vector< double > fXmax;
+        vector< double > fBinWidth;
+        vector< unsigned int > fEntries;          //!< number of entries (including values outside of the sketch range)
+        vector< unsigned int > fCounts;           //!< bin contents of all sketches
+        mutable vector< double > fIntegral;       //!< normalised cumulative content (as TH1::fIntegral)
+
+    public:
+        VQuantileSketchPool() {}
+        ~VQuantileSketchPool() {}
+
+        /*
+            add a sketch with iNBins equidistant bins in [iXmin, iXmax)
+
+            returns sketch ID
+        */
+        unsigned int addSketch( unsigned int iNBins, double iXmin, double iXmax )
+        {
+            if( iNBins == 0 )
+            {
+                iNBins = 1;
+            }
+            fOffset.push_back( fCounts.size() );
+            fNBins.push_back( iNBins );
+            fXmin.push_back( iXmin );
+            fXmax.push_back( iXmax );
+            fBinWidth.push_back( ( iXmax - iXmin ) / ( double )iNBins );
+            fEntries.push_back( 0 );
+            fCounts.resize( fCounts.size() + iNBins, 0 );
+            return fOffset.size() - 1;
+        }
+        void clear()
+        {
+            fOffset.clear();
+            fNBins.clear();
+            fXmin.clear();
+            fXmax.clear();
+            fBinWidth.clear();
+            fEntries.clear();
+            fCounts.clear();
+        }
+        /*
+            values outside of the sketch range are counted as entries
+            but not used for the quantile calculation (as under/overflow in TH1)
+
+            (bin search as TAxis::FindFixBin)
+        */
+        void fill( unsigned int s, double x )
+        {
+            fEntries[s]++;
+            if( x >= fXmin[s] && x < fXmax[s] )
+            {
+                unsigned int b = ( unsigned int )( fNBins[s] * ( x - fXmin[s] ) / ( fXmax[s] - fXmin[s] ) );
+                if( b < fNBins[s] )
+                {
+                    fCounts[fOffset[s] + b]++;
+                }
+            }
+        }
+        unsigned int getEntries( unsigned int s ) const
+        {
+            return fEntries[s];
+        }
+        unsigned int getMemorySize() const
+        {
+            return fCounts.size() * sizeof( unsigned int )
+                   + fOffset.size() * ( 3 * sizeof( unsigned int ) + 3 * sizeof( double ) );
+        }
+        unsigned int getNSketches() const
+        {
+            return fOffset.size();
+        }
+        /*
+            quantiles for the probabilities iProb[0..n-1]
+
+            same algorithm as TH1::GetQuantiles: binary search in the normalised
+            cumulative content (TMath::BinarySearch), ties resolved towards the
+            upper end of a run of empty bins, linear interpolation inside the bin
+
+            returns false for empty sketches
+        */
+        bool getQuantiles( unsigned int s, unsigned int n, const double* iProb, double* iQ ) const
+        {
+            const unsigned int* c = &fCounts[fOffset[s]];
+            int nbins = ( int )fNBins[s];
+            fIntegral.assign( nbins + 1, 0. );
+            for( int i = 0; i < nbins; i++ )
+            {
+                fIntegral[i + 1] = fIntegral[i] + ( double )c[i];
+            }
+            if( fIntegral[nbins] <= 0. )
+            {
+                for( unsigned int q = 0; q < n; q++ )
+                {
+                    iQ[q] = 0.;
+                }
+                return false;
+            }
+            for( int i = 1; i <= nbins; i++ )
+            {
+                fIntegral[i] /= fIntegral[nbins];
+            }
+            for( unsigned int q = 0; q < n; q++ )
+            {
+                // largest bin with cumulative content <= probability
+                // (first one of several bins with equal content)
+                const double* iLow = lower_bound( &fIntegral[0], &fIntegral[0] + nbins, iProb[q] );
+                int ibin = ( int )( iLow - &fIntegral[0] );
+                if( ibin == nbins || *iLow != iProb[q] )
+                {
+                    ibin--;
+                }
+                while( ibin >= 0 && ibin < nbins - 1 && fIntegral[ibin + 1] == iProb[q] )
+                {
+                    if( fIntegral[ibin + 2] == iProb[q] )
+                    {
+                        ibin++;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                if( ibin < 0 )
+                {
+                    ibin = 0;
+                }
+                iQ[q] = fXmin[s] + ( double )ibin * fBinWidth[s];
+                double dint = fIntegral[ibin + 1] - fIntegral[ibin];
+                if( dint > 0. )
+                {
+                    iQ[q] += fBinWidth[s] * ( iProb[q] - fIntegral[ibin] ) / dint;
+                }
+            }
+            return true;
+        }
+        /*
+            add contents of another pool with identical layout
+        */
+        bool merge( const VQuantileSketchPool& iPool )
+        {
+            if( iPool.fCounts.size() != fCounts.size() || iPool.fOffset.size() != fOffset.size() )
+            {
+                return false;
+            }
+            for( unsigned int i = 0; i < fCounts.size(); i++ )
+            {
+                fCounts[i] += iPool.fCounts[i];
+            }
+            for( unsigned int s = 0; s < fEntries.size(); s++ )
+            {
+                fEntries[s] += iPool.fEntries[s];
+            }
+            return true;
+        }
+        /*
+            reset contents of all sketches (layout is kept)
+        */
+        void reset()
+        {
+            fill_n( fCounts.begin(), fCounts.size(), 0 );
+            fill_n( fEntries.begin(), fEntries.size(), 0 );
+        }
+        void reset( unsigned int s )
+        {
+            fill_n( fCounts.begin() + fOffset[s], fNBins[s], 0 );
+            fEntries[s] = 0;
+        }
+};
+#endif
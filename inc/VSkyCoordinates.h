@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "VAstronometry.h"
+#include "VPointingSpline.h"
 #include "VSkyCoordinatesUtilities.h"
 #include "VStarCatalogue.h"
 
@@ -52,7 +53,24 @@ class VSkyCoordinates
         double fObsLongitude;                     //!< [rad]
         double fSupressStdoutText ;
 
-        void reset();
+        // per-run pointing tables (cubic splines on a fine time grid; time axis in [s] since fPointingTableMJD)
+        bool   fUsePointingTable;
+        double fPointingTableStep;                //!< [s] grid step
+        double fPointingTableLength;              //!< [s] time span covered by one table
+        double fPointingTableMaxElevation;        //!< [deg] direct calculation above this telescope/target elevation
+        int    fPointingTableMJD;                 //!< reference MJD of table time axis
+        double fPointingTableCoord[6];            //!< coordinates used to fill the tables (tel/target ra/dec, observatory)
+        VPointingSpline fTableTelAzimuth;         //!< [deg]
+        VPointingSpline fTableTelElevation;       //!< [deg]
+        VPointingSpline fTableTargetAzimuth;      //!< [deg]
+        VPointingSpline fTableTargetElevation;    //!< [deg]
+        VPointingSpline fTableDerotationAngle;    //!< [rad]
+
+        bool   fillPointingTable( int MJD, double time );
+        double getDerotationAngle_fromTable( double i_UTC );
+        bool   isPointingTableAccurate( double iTableTime );
+        bool   isPointingTableValid( double iTableTime );
+        void   reset();
 
     public:
 
@@ -155,6 +173,7 @@ class VSkyCoordinates
         }
         void   setObservatory( double iLongitude_deg = 0., double iLatitude_deg = 0. );
         bool   setPointingOffset( double i_raOff, double i_decOff );
+        void   setPointingTable( bool iUse = false, double iStep_s = 1., double iLength_s = 3600., double iMaxElevation_deg = 89. );
         bool   setTargetJ2000( double iDec_deg, double iRA_deg );
         void   setTargetName( string iTargetName )
         {
@@ -0,0 +1,290 @@
+//! VSyntheticDataReader  generator of synthetic VERITAS-like events (benchmarking without data files)
+
+#ifndef VSYNTHETICDATAREADER_H
+#define VSYNTHETICDATAREADER_H
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <valarray>
+#include <vector>
+
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+
+#include "VDetectorGeometry.h"
+#include "VMonteCarloRunHeader.h"
+#include "VVirtualDataReader.h"
+
+using namespace std;
+
+class VSyntheticDataReader : public VVirtualDataReader
+{
+    private:
+        bool fDebug;
+
+        static thread_local unsigned int fTelID;              //!< current telescope (one per analysis thread)
+        static thread_local unsigned int fSelectedHitChannel; //!< selected channel (one per analysis thread)
+
+        unsigned int fNTel;
+        unsigned int fNEvents;                    //!< number of events to generate
+        uint32_t     fEventNumber;
+        TRandom3*    fRandomGen;
+
+        // camera and trace parameters
+        vector< unsigned int > fNChannels;
+        unsigned int fNSamples;
+        double       fSampleWidth;                //!< length of a sample [ns]
+        double       fPedestal;                   //!< pedestal level [dc]
+        double       fElectronicNoise;            //!< electronic noise per sample [dc]
+        double       fDCperPE;                    //!< integrated charge of a single photo electron [dc]
+        double       fNSBRate;                    //!< mean NSB rate [pe/ns]
+        vector< vector< double > > fNSBRatePixel; //!< NSB rate per pixel [pe/ns]
+        double       fImageSize;                  //!< minimum image size [pe]
+        double       fPulseTimeBinWidth;          //!< bin width of pulse shape lookup table [ns]
+        vector< double > fPulseShape;             //!< single pe pulse (amplitude, normalised to unit integral)
+        double       fPulseShapeTMin;             //!< start of pulse shape relative to pulse arrival time [ns]
+
+        // pixel coordinates [deg]
+        vector< vector< double > > fPixelX;
+        vector< vector< double > > fPixelY;
+        double       fPixelArea;                  //!< pixel area [deg2]
+
+        // event data
+        vector< vector< uint8_t > > fSamples;     //!< samples [telescope][channel*nsamples + sample]
+        vector< float > fTraceTemp;
+        vector< bool > fLocalTrigger;
+        vector< float > fLocalTriggerTime;
+
+        // pedestals
+        vector< valarray< double > > fPeds;
+        vector< valarray< double > > fPedRMS;
+        vector< vector< valarray< double > > > fVPedvars;
+        vector< int > fSumWindow;
+
+        // MC values
+        float fMC_energy;
+        float fMC_X;
+        float fMC_Y;
+        float fMC_Xoffset;
+        float fMC_Yoffset;
+        vector< double > fTelElevation;
+        vector< double > fTelAzimuth;
+        vector< double > fTelX;
+        vector< double > fTelY;
+
+        void   addPulse( float* iTrace, double iTime, double iCharge );
+        void   fillNoiseTrace( unsigned int iTel, unsigned int iChannel );
+        void   fillPulseShape();
+        void   fillSamples( unsigned int iTel, unsigned int iChannel );
+        void   generatePedestals( unsigned int iNTraces );
+        void   generateShower();
+
+    public:
+        VSyntheticDataReader( VDetectorGeometry* iDetGeo, unsigned int iNTel, unsigned int iNEvents,
+                              double iImageSize, double iNSBRate, vector< int > iSumWindow,
+                              int iSeed = 0, bool iDebug = false );
+        ~VSyntheticDataReader();
+
+        static void                 fillDetectorGeometry( VDetectorGeometry* iDetGeo, unsigned int iNTel,
+                unsigned int iNPixel, unsigned int iNSamples );
+        static bool                 setParameterFiles( string iDirectory );
+
+        std::pair< bool, uint32_t > getChannelHitIndex( uint32_t i )
+        {
+            return std::make_pair( i < getMaxChannels(), i );
+        }
+        string                      getDataFormat()
+        {
+            return "synthetic";
+        }
+        unsigned int                getDataFormatNum()
+        {
+            return 8;
+        }
+        uint32_t                    getEventNumber()
+        {
+            return fEventNumber;
+        }
+        uint8_t                     getEventType()
+        {
+            return 1;
+        }
+        uint8_t                     getATEventType()
+        {
+            return 1;
+        }
+        uint32_t                    getRunNumber()
+        {
+            return 0;
+        }
+        std::vector< bool >         getFullHitVec()          //!< all channels are read out
+        {
+            return std::vector< bool >( getMaxChannels(), true );
+        }
+        std::vector< bool >         getFullTrigVec()
+        {
+            return std::vector< bool >( getMaxChannels(), true );
+        }
+        int                         getNumberofFullTrigger()
+        {
+            return ( int )getMaxChannels();
+        }
+        uint32_t                    getGPS0()     //!< no time for synthetic events -> returns 0
+        {
+            return 0;
+        }
+        uint32_t                    getGPS1()
+        {
+            return 0;
+        }
+        uint32_t                    getGPS2()
+        {
+            return 0;
+        }
+        uint32_t                    getGPS3()
+        {
+            return 0;
+        }
+        uint32_t                    getGPS4()
+        {
+            return 0;
+        }
+        uint16_t                    getGPSYear()
+        {
+            return 0;
+        }
+        uint16_t                    getATGPSYear()
+        {
+            return 0;
+        }
+        uint32_t                    getHitID( uint32_t i )
+        {
+            return i;
+        }
+        bool                        getHiLo( uint32_t i )
+        {
+            return false;
+        }
+        uint16_t                    getMaxChannels()
+        {
+            return ( fTelID < fNChannels.size() ? fNChannels[fTelID] : 0 );
+        }
+        VMonteCarloRunHeader*       getMonteCarloHeader()
+        {
+            return 0;
+        }
+        uint16_t                    getNumChannelsHit()
+        {
+            return getMaxChannels();
+        }
+        uint16_t                    getNumSamples()
+        {
+            return fNSamples;
+        }
+        unsigned int                getNTel()
+        {
+            return fNTel;
+        }
+        unsigned int                getNumTelescopes()
+        {
+            return fNTel;
+        }
+        valarray< double >&         getPeds()
+        {
+            return fPeds[fTelID];
+        }
+        valarray< double >&         getPedvars()
+        {
+            return fVPedvars[fTelID][fSumWindow[fTelID]];
+        }
+        vector< valarray< double > >& getPedvarsAllSumWindows()
+        {
+            return fVPedvars[fTelID];
+        }
+        valarray< double >&         getPedRMS()
+        {
+            return fPedRMS[fTelID];
+        }
+        uint8_t                     getSample( unsigned channel, unsigned sample, bool iNewNoiseTrace = true );
+        const uint8_t*              getSamplePtr( unsigned channel, unsigned int& iNSamples );
+        std::vector< uint8_t >      getSamplesVec();
+        unsigned int                getTelescopeID()
+        {
+            return fTelID;
+        }
+        bool                        getNextEvent();
+        void                        selectHitChan( uint32_t i )
+        {
+            fSelectedHitChannel = i;
+        }
+        void                        setSumWindow( vector< int > iSW );
+        void                        setSumWindow( unsigned int iTelID, int iSW );
+        bool                        setTelescopeID( unsigned int iTel );
+        bool                        wasLossyCompressed()
+        {
+            return false;
+        }
+
+        // trigger
+        std::vector< bool >&        getLocalTrigger()
+        {
+            return fLocalTrigger;
+        }
+        float                       getLocalTriggerTime( unsigned int iTel )
+        {
+            return ( iTel < fLocalTriggerTime.size() ? fLocalTriggerTime[iTel] : -999. );
+        }
+        unsigned int                getNTelLocalTrigger();
+        bool                        hasLocalTrigger( unsigned int iTel )
+        {
+            return ( iTel < fLocalTrigger.size() ? fLocalTrigger[iTel] : false );
+        }
+
+        // MC values
+        bool                        isMC()
+        {
+            return true;
+        }
+        float                       getMC_energy()
+        {
+            return fMC_energy;
+        }
+        float                       getMC_X()
+        {
+            return fMC_X;
+        }
+        float                       getMC_Y()
+        {
+            return fMC_Y;
+        }
+        float                       getMC_Ze()
+        {
+            return 90. - fTelElevation[0];
+        }
+        float                       getMC_Az()
+        {
+            return fTelAzimuth[0];
+        }
+        float                       getMC_Xoffset()
+        {
+            return fMC_Xoffset;
+        }
+        float                       getMC_Yoffset()
+        {
+            return fMC_Yoffset;
+        }
+        std::vector< double >       getTelElevation()
+        {
+            return fTelElevation;
+        }
+        std::vector< double >       getTelAzimuth()
+        {
+            return fTelAzimuth;
+        }
+};
+#endif
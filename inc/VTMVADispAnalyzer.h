@@ -70,7 +70,7 @@ class VTMVADispAnalyzer
     public:
 
         VTMVADispAnalyzer( string iFile, vector< ULong64_t > iTelTypeList, string iDispType = "BDTDisp" );
-        ~VTMVADispAnalyzer() {}
+        ~VTMVADispAnalyzer();
 
         float evaluate( float iWidth, float iLength, float iSize, float iAsymm, float iLoss,
                         float iTGrad, float icen_x, float icen_y, float xoff_4, float yoff_4,
@@ -14,6 +14,7 @@
 #include "VHistogramUtilities.h"
 #include "VMedianCalculator.h"
 #include "VStatistics.h"
+#include "VTableLookupGrid.h"
 
 #include <cmath>
 #include <iostream>
@@ -29,6 +30,8 @@ class VTableCalculator
         // mode can be 'r' or 'w'
         VTableCalculator( int intel = 0, bool iEnergy = false, bool iPE = false );
         VTableCalculator( string fpara, string hname, char m, TDirectory* iDir, bool iEnergy, bool iPE = false, int iUseMedianEnergy = 1 );
+        VTableCalculator( string fpara, string hname, TDirectory* iParentDir, string iDirName, bool iEnergy, bool iPE = false, int iUseMedianEnergy = 1 );
+        VTableCalculator( VTableLookupGrid* iGrid, bool iEnergy, bool iPE = false );
 
         // Destructor
         ~VTableCalculator() {}
@@ -46,7 +49,16 @@ class VTableCalculator
                 return "not defined";
             }
         }
+        VTableLookupGrid* getGrid()
+        {
+            return ( fGrid ? fGrid : fHistoGrid );
+        }
         TH2F* getHistoMedian();
+        unsigned long getMemorySize();
+        bool isBinaryTable()
+        {
+            return ( fGrid != 0 );
+        }
         TDirectory* getOutputDirectory()
         {
             return fOutDir;
@@ -67,7 +79,10 @@ class VTableCalculator
         {
             fMinShowerPerBin = iM;
         }
+        void releaseHistograms();
+        void setVGrids( vector< VTableLookupGrid* >& gM );
         void setVHistograms( vector< TH2F* >& hM );
+        static double interpolate( TH2F* h, float x, float y, bool iError );
         void setInterpolationConstants( int, int );
         void setOutputDirectory( TDirectory* iF )
         {
@@ -110,12 +125,24 @@ class VTableCalculator
         TH2F* hMedian;
         string hMedianName;
         vector< TH2F* > hVMedian;
+        VTableLookupGrid* fGrid;                  //!< table from binary table file (read only)
+        VTableLookupGrid* fHistoGrid;             //!< hMedian as grid (tables read from ROOT files)
+        vector< VTableLookupGrid* > gVMedian;
+
+        // batched table interpolation (all telescopes)
+        vector< const VTableLookupGrid* > fBatchGrid;
+        vector< float > fBatchX;
+        vector< float > fBatchY;
+        vector< float > fBatchMed;
+        vector< float > fBatchSigma;
 
         // histogram interpolation
         int fInterPolWidth;
         int fInterPolIter;
 
         TDirectory* fOutDir;
+        TDirectory* fInputParentDir;              //!< table directory is read on first access (fInputParentDir/fInputDirName)
+        string fInputDirName;
         bool fWrite1DHistograms;
         bool fReadHistogramsFromFile;
 
@@ -126,8 +153,8 @@ class VTableCalculator
         bool   createMedianApprox( int i, int j );
         double getWeightMeanBinContent( TH2F*, int, int, double, double );
         void   fillMPV( TH2F*, int, int, TH1F*, double, double );
-        double interpolate( TH2F* h, float x, float y, bool iError );
         bool   readHistograms();
+        void   setMedianHistogramName( string fpara );
         void   setBinning();
         void   setConstants( bool iPE = false );
 
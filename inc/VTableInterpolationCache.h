@@ -0,0 +1,109 @@
+//! VTableInterpolationCache  lookup tables interpolated in wobble offset and zenith angle (cached per run)
+
+#ifndef VTABLEINTERPOLATIONCACHE_H
+#define VTABLEINTERPOLATIONCACHE_H
+
+#include "TMath.h"
+
+#include "VStatistics.h"
+#include "VTableLookupGrid.h"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+/*
+    corners of the interpolation (same order as in VTableLookup::readLookupTable):
+
+        0: zenith low, wobble offset low
+        1: zenith low, wobble offset up
+        2: zenith up, wobble offset low
+        3: zenith up, wobble offset up
+*/
+struct sTableInterpolationKey
+{
+    int          ze;                         // quantized zenith angle
+    int          woff;                       // quantized wobble offset
+    unsigned int az;                         // azimuth bin
+    ULong64_t    telType;
+    unsigned int noise[4];                   // noise bin for each corner
+
+    bool operator<( const sTableInterpolationKey& k ) const
+    {
+        if( ze != k.ze )
+        {
+            return ze < k.ze;
+        }
+        if( woff != k.woff )
+        {
+            return woff < k.woff;
+        }
+        if( az != k.az )
+        {
+            return az < k.az;
+        }
+        if( telType != k.telType )
+        {
+            return telType < k.telType;
+        }
+        for( unsigned int i = 0; i < 4; i++ )
+        {
+            if( noise[i] != k.noise[i] )
+            {
+                return noise[i] < k.noise[i];
+            }
+        }
+        return false;
+    }
+};
+
+class VTableInterpolationCache
+{
+    private:
+        double fZeStep;                           //!< [deg]
+        double fWoffStep;                         //!< [deg]
+        double fMemoryBudget;                     //!< [bytes] (0 = no limit)
+        double fMemory;                           //!< [bytes]
+        double fMemoryMax;                        //!< [bytes]
+
+        unsigned long fNHits;
+        unsigned long fNMisses;
+        unsigned long fNFailed;                   //!< tables with different binning (not interpolated)
+        unsigned long fNCleared;
+
+        // interpolated tables (0: mscw, 1: mscl, 2: energySR; 0 if tables can't be interpolated)
+        map< sTableInterpolationKey, vector< VTableLookupGrid* > > fTables;
+
+    public:
+        static const unsigned int fNTableTypes = 3;
+
+        VTableInterpolationCache( double iZeStep = 0.1, double iWoffStep = 0.01, double iMemoryBudget_MB = 500. );
+        ~VTableInterpolationCache();
+        vector< VTableLookupGrid* >* add( const sTableInterpolationKey& k, vector< vector< VTableLookupGrid* > >& g,
+                                          double* woff_corner, double ze_low, double ze_up, double woff, double ze );
+        void   clear();
+        vector< VTableLookupGrid* >* get( const sTableInterpolationKey& k );
+        int    getQuantizedZe( double ze )
+        {
+            return TMath::Nint( ze / fZeStep );
+        }
+        int    getQuantizedWoff( double woff )
+        {
+            return TMath::Nint( woff / fWoffStep );
+        }
+        double getZe( int iZe )
+        {
+            return iZe * fZeStep;
+        }
+        double getWoff( int iWoff )
+        {
+            return iWoff * fWoffStep;
+        }
+        void   nextEvent();
+        static VTableLookupGrid* interpolate( vector< VTableLookupGrid* >& g,
+                                              double* woff_corner, double ze_low, double ze_up, double woff, double ze );
+        void   printSummary();
+};
+#endif
@@ -0,0 +1,50 @@
+//! VTableLRUCache  lookup tables in memory (least recently used tables are removed first)
+
+#ifndef VTABLELRUCACHE_H
+#define VTABLELRUCACHE_H
+
+#include "TH2F.h"
+
+#include "VTableCalculator.h"
+
+#include <iostream>
+#include <list>
+#include <map>
+
+using namespace std;
+
+struct sTableLRUCacheEntry
+{
+    list< VTableCalculator* >::iterator fLRUPosition;
+    unsigned int  fLastEvent;                // last event this table has been used in
+    unsigned long fMemorySize;               // [bytes]
+};
+
+class VTableLRUCache
+{
+    private:
+        double fMemoryBudget;                     //!< [bytes] (0 = no limit)
+        double fMemory;                           //!< [bytes]
+        double fMemoryMax;                        //!< [bytes]
+
+        unsigned int  fEvent;
+        unsigned long fNHits;
+        unsigned long fNMisses;
+        unsigned long fNEvicted;
+
+        list< VTableCalculator* > fLRU;           //!< most recently used table first
+        map< VTableCalculator*, sTableLRUCacheEntry > fEntries;
+
+        void evict();
+
+    public:
+        VTableLRUCache( double iMemoryBudget_MB = 0. );
+        ~VTableLRUCache() {}
+        TH2F* getHistoMedian( VTableCalculator* t );
+        void  nextEvent()
+        {
+            fEvent++;
+        }
+        void  printSummary();
+};
+#endif
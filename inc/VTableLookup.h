@@ -7,21 +7,29 @@
 #include "TError.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TROOT.h"
 #include "TSystem.h"
 
 #include "VMeanScaledVariables.h"
 #include "VStatistics.h"
+#include "VTableLookupBinaryFile.h"
+#include "VTableInterpolationCache.h"
 #include "VTableLookupDataHandler.h"
+#include "VTableLookupEventQueue.h"
+#include "VTableLRUCache.h"
 #include "VTableLookupRunParameter.h"
 #include "VTablesToRead.h"
 #include "VTableCalculator.h"
+#include "VThreadPool.h"
 
 #include <fstream>
 #include <iostream>
 #include <math.h>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -51,6 +59,11 @@ class VTableLookup
         TDirectory* fDirMSCW;
         TDirectory* fDirMSCL;
         TDirectory* fDirEnergySR;
+        VTableLookupBinaryFile* fLookupTableBinaryFile;   // flat binary table file (memory mapped)
+        vector< VTableLookupGrid* > fLookupTableGrids;
+        VTableLRUCache* fTableCache;              // tables are read on first use
+        VTableInterpolationCache* fTableInterpolationCache;   // tables interpolated in ze and woff
+        mutex* fTableMutex;                       // serialize table access (multi-threaded event loop only)
 
         bool fWriteNoTriggerEvent;                // fill events with no triggers into the output tree
         bool fWrite1DHistograms;                  // write all 1D-histograms for median determination to disk
@@ -77,28 +90,44 @@ class VTableLookup
         // used for calculations
         VTableCalculator* f_calc_msc;
         VTableCalculator* f_calc_energySR;
+        VTablesToRead* fTables_ZupWup;
+        VTablesToRead* fTables_ZupWlow;
+        VTablesToRead* fTables_Zup;
+        VTablesToRead* fTables_ZlowWup;
+        VTablesToRead* fTables_ZlowWlow;
+        VTablesToRead* fTables_Zlow;
+        VTablesToRead* fTables_N;
 
         double fMeanNoiseLevel;
         vector< double > fNoiseLevel;             // pedestal variances per telescope from source file
         unsigned int fNNoiseLevelWarnings;
+        unsigned int* fNNoiseLevelWarningsCounter;    // counter shared by all copies (see clone())
 
+        bool analyzeEvent();
         void calculateMSFromTables( VTablesToRead* s, double esys );
+        VTableLookup* clone( VTableLookupDataHandler* iData );
         void configureTelescopeVector();
         bool cut( bool bWrite = false );  // apply cuts on successful reconstruction to input data
         void fillLookupTable();
         unsigned int  getAzBin( double az );
         void getIndexBoundary( unsigned int* ib, unsigned int* il, vector< double >& iV, double x );
+        VTableLookupGrid* getGrid( VTableCalculator* t );
+        bool getInterpolatedTables( double ze, double woff, unsigned int iaz, VTablesToRead* s );
         unsigned int  getNoiseBin( unsigned int ize, unsigned int iwoff, unsigned int iaz, unsigned int tel, double noise );
-        vector< string > getSortedListOfDirectories( TDirectory* );
         void getTables( unsigned int inoise, unsigned int ize, unsigned int iwoff, unsigned int iaz, unsigned int tel, VTablesToRead* s );
+        unsigned int getTelTypeIndex( unsigned int ize, unsigned int iwoff, unsigned int iaz, unsigned int tel );
+        void initializeTablesToRead();
         void interpolate( VTablesToRead* s1, double w1, VTablesToRead* s2, double w2, VTablesToRead* s, double w, bool iCos = false );
+        bool prepareEvent( VTableLookupDataHandler* iData, bool& bFirst );
         void readLookupTable();
+        void readLookupTableParallel();
         void readNoiseLevel( bool bWriteToRunPara = true ); // read noise level from pedvar histograms of data files
+        void setMCTableFilesFromBinaryFile( string itablefile );
         bool sanityCheckLookupTableFile( bool iPrint = false );
 
     public:
         VTableLookup( char readwrite, unsigned int iDebug = 0 );
-        ~VTableLookup() {}
+        ~VTableLookup();
         double getMaxTotalTime()
         {
             return fData->getMaxTotalTime();
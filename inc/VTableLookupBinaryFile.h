@@ -0,0 +1,120 @@
+//! VTableLookupBinaryFile  flat binary lookup table file (memory mapped for reading)
+
+#ifndef VTABLELOOKUPBINARYFILE_H
+#define VTABLELOOKUPBINARYFILE_H
+
+#include "TDirectory.h"
+#include "TH2F.h"
+#include "TKey.h"
+#include "TList.h"
+
+#include "VTableLookupGrid.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+/*
+    file layout (native byte order, all blocks 8-byte aligned):
+
+        header (sTableFileHeader)
+        data blocks, one per table:
+            x bin edges (nx+1 doubles, variable binning only)
+            y bin edges (ny+1 doubles, variable binning only)
+            bin contents ((nx+2)*(ny+2) floats, TH2F bin numbering)
+            bin errors ((nx+2)*(ny+2) floats)
+        table index (sTableEntry for each table, in the order of the
+                     directory tree ze/woff/az/tel/noise of the ROOT table file)
+*/
+struct sTableFileHeader
+{
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint64_t fNTables;
+    uint64_t fIndexOffset;                   // [bytes]
+    uint64_t fFileSize;                      // [bytes]
+};
+
+struct sTableEntry
+{
+    uint32_t ize;                            // indices as in VTableLookup (e.g. fmscw[ze][woff][az][tel][noise])
+    uint32_t iwoff;
+    uint32_t iaz;
+    uint32_t itel;
+    uint32_t inoise;
+    uint32_t iType;                          // table type (see VTableLookupBinaryFile)
+    float    ze;                             // zenith angle [deg]
+    float    woff;                           // wobble offset [deg]
+    float    noise;                          // noise level (mean pedvar)
+    uint32_t iPadding;
+    uint64_t telType;                        // telescope type
+    uint32_t nx;
+    uint32_t ny;
+    uint32_t bVariableX;
+    uint32_t bVariableY;
+    double   xmin;
+    double   xmax;
+    double   ymin;
+    double   ymax;
+    uint64_t fDataOffset;                    // [bytes]
+};
+
+class VTableLookupBinaryFile
+{
+    private:
+        string fFileName;
+        int    fFileDescriptor;
+        char*  fMap;                              //!< memory mapped file
+        size_t fMapSize;
+        const sTableFileHeader* fHeader;
+        const sTableEntry* fIndex;
+
+        static uint64_t getAlignedSize( uint64_t n )
+        {
+            return ( n + 7 ) / 8 * 8;
+        }
+        static bool writeTable( ofstream& os, TH2F* h, sTableEntry& iEntry );
+
+    public:
+        static const uint32_t fMagic = 0x45564c54;     //!< "EVLT"
+        static const uint32_t fVersion = 1;            //!< increase after any change of the file layout
+
+        // table types
+        static const uint32_t fType_mscw = 0;          //!< width (median)
+        static const uint32_t fType_mscl = 1;          //!< length (median)
+        static const uint32_t fType_energySR = 2;      //!< energy (median)
+        static const uint32_t fType_energySR_mpv = 3;  //!< energy (most probable value)
+
+        VTableLookupBinaryFile();
+        ~VTableLookupBinaryFile();
+        void   close();
+        static bool convert( TDirectory* iTableDirectory, string iBinaryFile, string iSuffix = "tb" );
+        string getFileName()
+        {
+            return fFileName;
+        }
+        VTableLookupGrid* getGrid( unsigned int iTable );
+        unsigned int getNTables()
+        {
+            return ( fHeader ? ( unsigned int )fHeader->fNTables : 0 );
+        }
+        static vector< string > getSortedListOfDirectories( TDirectory* iDir );
+        const sTableEntry* getTableEntry( unsigned int iTable )
+        {
+            return ( fIndex && iTable < getNTables() ? &fIndex[iTable] : 0 );
+        }
+        static bool isBinaryTableFile( string iFile );
+        bool   open( string iFile );
+};
+#endif
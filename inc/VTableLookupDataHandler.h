@@ -10,6 +10,7 @@
 #include "VDispAnalyzer.h"
 #include "VPointingCorrectionsTreeReader.h"
 #include "VSimpleStereoReconstructor.h"
+#include "VTableLookupEventData.h"
 #include "VTableLookupRunParameter.h"
 #include "VUtilities.h"
 
@@ -39,7 +40,7 @@
 
 using namespace std;
 
-class VTableLookupDataHandler
+class VTableLookupDataHandler : public VTableLookupEventData
 {
     private:
         unsigned int fDebug;
@@ -86,7 +87,6 @@ class VTableLookupDataHandler
         double fSpectralIndex;
 
         vector< double > fNoiseLevel;
-        vector< double > fCurrentNoiseLevel;
 
         // input trees
         int fEventDisplayFileFormat;
@@ -98,8 +98,6 @@ class VTableLookupDataHandler
         vector< Ctpars* > ftpars;
         vector< VPointingCorrectionsTreeReader* > fpointingCorrections;
 
-        double fEventWeight;
-
         // MC energy histograms
         TH1D* hE0mc;
         TH2D* hXYmc;
@@ -122,11 +120,6 @@ class VTableLookupDataHandler
         map<ULong64_t, unsigned int > fList_of_Tel_type;                      // [teltype][number of telescopes for this type]
         map<ULong64_t, unsigned int >::iterator fList_of_Tel_type_iterator;
         vector< unsigned int > fTel_type_counter;
-        // telescope pointing
-        double fTelElevation[VDST_MAXTELESCOPES];
-        double fTelAzimuth[VDST_MAXTELESCOPES];
-        double fTelDec[VDST_MAXTELESCOPES];
-        double fTelRA[VDST_MAXTELESCOPES];
         // target positions
         double fTargetElev;
         double fTargetAz;
@@ -134,17 +127,12 @@ class VTableLookupDataHandler
         double fTargetRA;
         double fWobbleN;
         double fWobbleE;
-        float  fArrayPointing_Elevation;
-        float  fArrayPointing_Azimuth;
-        float  fArrayPointing_RotationAngle;
-        unsigned int fArray_PointingStatus;
 
         // output trees
         TTree* fOTree;
         bool bWriteMCPars;
 
         // cut statistics
-        bool fEventStatus;
         unsigned int fNStats_All;
         unsigned int fNStats_Rec;
         unsigned int fNStats_NImagesCut;
@@ -167,6 +155,7 @@ class VTableLookupDataHandler
         void   copy_telconfig();
         void   doStereoReconstruction( bool bSelectedImagesOnly );
         void   fill_selected_images_before_redo_stereo_reconstruction();
+        void   initializeDispAnalyzers();
         void   initializeTelTypeVector();
         int    fillNextEvent( bool bShort );
         pair<float, float > getArrayPointing();
@@ -174,148 +163,20 @@ class VTableLookupDataHandler
         bool   randomSelected();
         void   resetImageParameters();
         void   resetImageParameters( unsigned int i );
+        void   resetReconstructionParameters();
         void   setEventWeightfromMCSpectrum();
         void   setSelectRandom( double iX, int iS );
         void   writeDeadTimeHistograms();
 
     public:
 
-        int runNumber;
-        int eventNumber;
-        int MJD;
-        double time;
-
-        bool fIsMC;                               //!< data is MC
-        int    fMCPrimary;
-        double fMCEnergy;                         //!< MC energy
-        double fMCxcore;
-        double fMCycore;
-        double fMCxcore_SC;
-        double fMCycore_SC;
-        double fMCxcos;
-        double fMCycos;
-        double fMCaz;
-        double fMCze;
-        double fMCxoff;
-        double fMCyoff;
-
-        unsigned int LTrigS;
-        ULong64_t LTrig;
-        unsigned int fNTrig;
-        int fNImages;
-        int fNImages_intersect;
-        ULong64_t fImgSel;
-        bool fImgSel_list[VDST_MAXTELESCOPES];
-        unsigned int fImgSel_list_short[VDST_MAXTELESCOPES];
-        int fNTelTypes;
-        unsigned int NImages_Ttype[VDST_MAXTELESCOPES];
-        double fimg2_ang;
-        double fZe;
-        double fAz;
-        double fRA;
-        double fDec;
-        double fXoff;
-        double fYoff;
-        double fXoff_derot;
-        double fYoff_derot;
-        double fstdS;
-        float ftheta2;
-        double fXcore;
-        double fYcore;
-        double fXcore_SC;
-        double fYcore_SC;
-        double fstdP;
-        double fchi2;                             //!< chi2 from array reconstruction
-        float  fMCEnergyArray [VDST_MAXTELESCOPES];
-        float  fmeanPedvar_ImageT[VDST_MAXTELESCOPES];
-        float  fmeanPedvar_Image;
-        float  fdist     [VDST_MAXTELESCOPES];
-        float  ffui       [VDST_MAXTELESCOPES];
-        float  fsize     [VDST_MAXTELESCOPES];
-        float  fsizeCorr [VDST_MAXTELESCOPES];
-        float  fsize_telType[VDST_MAXTELESCOPES];
-        float  floss     [VDST_MAXTELESCOPES];
-        float  ffracLow  [VDST_MAXTELESCOPES];
-        float  fmax1     [VDST_MAXTELESCOPES];
-        float  fmax2     [VDST_MAXTELESCOPES];
-        float  fmax3     [VDST_MAXTELESCOPES];
-        int    fmaxindex1     [VDST_MAXTELESCOPES];
-        int    fmaxindex2     [VDST_MAXTELESCOPES];
-        int    fmaxindex3     [VDST_MAXTELESCOPES];
-        float  fwidth    [VDST_MAXTELESCOPES];
-        float  fwidth_telType[VDST_MAXTELESCOPES];
-        float  flength   [VDST_MAXTELESCOPES];
-        float  flength_telType[VDST_MAXTELESCOPES];
-        int    fntubes   [VDST_MAXTELESCOPES];
-        unsigned short int fnsat[VDST_MAXTELESCOPES];
-        unsigned short int fnlowgain[VDST_MAXTELESCOPES];
-        float  falpha    [VDST_MAXTELESCOPES];
-        float  flos      [VDST_MAXTELESCOPES];
-        float  fasym     [VDST_MAXTELESCOPES];
-        float  fcen_x    [VDST_MAXTELESCOPES];
-        float  fcen_y    [VDST_MAXTELESCOPES];
-        float  fcosphi   [VDST_MAXTELESCOPES];
-        float  fsinphi   [VDST_MAXTELESCOPES];
-        float  ftgrad_x  [VDST_MAXTELESCOPES];
-        float  ftchisq_x [VDST_MAXTELESCOPES];
-        double fweight   [VDST_MAXTELESCOPES];    //!< always 1.
-        double fpointing_dx[VDST_MAXTELESCOPES];
-        double fpointing_dy[VDST_MAXTELESCOPES];
-        int    fFitstat  [VDST_MAXTELESCOPES];
-        // {-1}
-        float  fR_core      [VDST_MAXTELESCOPES];    //!< distance from each telescope to reconstructed shower core
-        float  fRTel        [VDST_MAXTELESCOPES];    //!< distance from each telescope to reconstructed shower core
-        float  fR_telType[VDST_MAXTELESCOPES];    //!< distance from each telescope to reconstructed shower core (depending on tel type)
-        float  fE        [VDST_MAXTELESCOPES];    //!< energy assigned to each telescope (method 0)
-        float  fES       [VDST_MAXTELESCOPES];    //!< energy assigned to each telescope (method 1)
-        int    fnenergyT;                         //!< number of images used for the energy calculation
-        int    fenergyQL;                         //!< quality label for energy calculation
-        float  ftmscw    [VDST_MAXTELESCOPES];    //!< mscw assigned to each telescope
-        float  ftmscl    [VDST_MAXTELESCOPES];    //!< mscl assigned to each telescope
-        float  ftmscw_sigma[VDST_MAXTELESCOPES];  //!< mscw  sigma  assigned to each telescope
-        float  ftmscl_sigma[VDST_MAXTELESCOPES];  //!< mscl  sigma  assigned to each telescope
-
-        int    fnmscw;                            //!< number of images used for mscw/mscl/energy calculation
-        float  fmscw;                             //!< mean scaled width
-        float  fmscl;                             //!< mean scaled length
-        float  fmwr;                              //!< mean width ratio
-        float  fmlr;                              //!< mean length ratio
-        float  fenergy;                           //!< reconstructed primary energy
-        float  fechi2;                            //!< chi2 from reconstructed primary energy
-        float  fdE;                               //!< dE from reconstructed primary energy
-        float  fenergyS;                          //!< reconstructed primary energy
-        float  fechi2S;                           //!< chi2 from reconstructed primary energy
-        float  fdES;                              //!< dE from reconstructed primary energy
-
-        // emission height
-        unsigned int fNTelPairs;
-        float  fEmissionHeightMean;
-        float  fEmissionHeightChi2;
-        //!< (note that maximum array length should be larger than MaxNbrTel
-        float  fEmissionHeightT[VDST_MAXTELESCOPES];
-
-        double fSizeSecondMax;
-
-        // disp related variables
-        float fXoff_edisp;
-        float fYoff_edisp;
-        float fChi2_edisp;
-        float fXoff_intersect;                  //! keep direction from intersection method
-        float fYoff_intersect;                  //! keep direction from intersection method
-        float fXoff_T[VDST_MAXTELESCOPES];      //! direction reconstructed for each telescope
-        float fYoff_T[VDST_MAXTELESCOPES];      //! direction reconstructed for each telescope
-        float fWoff_T[VDST_MAXTELESCOPES];      //! direction reconstructed for each telescope (weight)
-        float fDoff_T[VDST_MAXTELESCOPES];      //! (disp value)
-        float fDispAbsSumWeigth;                //! sum of absolute values of disp weights
-        unsigned int fToff_T[VDST_MAXTELESCOPES]; //! list of telescope participating in disp
-        unsigned int fnxyoff;                   //! number of images used for disp direction reconstruction
-        // difference in disp event direction between telescopes
-        double fDispDiff;
-
         /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
         VTableLookupDataHandler( bool iWrite, VTableLookupRunParameter* iT = 0 );
-        ~VTableLookupDataHandler() {}
+        ~VTableLookupDataHandler();
+
+        void addCutStatistics( VTableLookupDataHandler* iData );
+        VTableLookupDataHandler* clone( bool iReconstruction = true );
 
         bool cut()                                //!< apply cuts on successful reconstruction to input data
         {
@@ -448,6 +309,10 @@ class VTableLookupDataHandler
         }
         bool getNextEvent();                      //!< get next event from evndisp tree
         bool getNextEvent( bool bShort );         //!< get next event from evndisp tree
+        const VTableLookupEventData& getEventData()
+        {
+            return *this;
+        }
         double getMeanNoiseLevel( bool bCurrentNoiseLevel = false )
         {
             if( !bCurrentNoiseLevel )
@@ -517,6 +382,8 @@ class VTableLookupDataHandler
             return sqrt( fXoff * fXoff + fYoff * fYoff );
         }
         bool isReconstructed();
+        int  readNextEvent( bool bShort );        //!< read next event from evndisp tree (no reconstruction)
+        void reconstructEvent();                  //!< stereo reconstruction, disp energy and distances for current event
         bool readRunParameter();
         void reset();                             //!< reset a few output variables
         void resetAll();
@@ -564,6 +431,10 @@ class VTableLookupDataHandler
                 fE[i] = iET;
             }
         }
+        void setEventData( const VTableLookupEventData& iEventData )
+        {
+            VTableLookupEventData::operator=( iEventData );
+        }
         bool setInputFile( vector< string > );              //!< set input file
         void setMCMinEnergy( double iB )
         {
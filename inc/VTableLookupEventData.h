@@ -0,0 +1,165 @@
+//! VTableLookupEventData event data for mscw and energy reconstruction (values read from evndisp trees and reconstruction results)
+
+#ifndef VTableLookupEventData_H
+#define VTableLookupEventData_H
+
+#include "VGlobalRunParameter.h"
+
+#include <vector>
+
+using namespace std;
+
+class VTableLookupEventData
+{
+    public:
+
+        bool   fEventStatus;
+        double fEventWeight;
+        vector< double > fCurrentNoiseLevel;
+
+        // telescope pointing
+        double fTelElevation[VDST_MAXTELESCOPES];
+        double fTelAzimuth[VDST_MAXTELESCOPES];
+        double fTelDec[VDST_MAXTELESCOPES];
+        double fTelRA[VDST_MAXTELESCOPES];
+        float  fArrayPointing_Elevation;
+        float  fArrayPointing_Azimuth;
+        float  fArrayPointing_RotationAngle;
+        unsigned int fArray_PointingStatus;
+
+        int runNumber;
+        int eventNumber;
+        int MJD;
+        double time;
+
+        bool fIsMC;                               //!< data is MC
+        int    fMCPrimary;
+        double fMCEnergy;                         //!< MC energy
+        double fMCxcore;
+        double fMCycore;
+        double fMCxcore_SC;
+        double fMCycore_SC;
+        double fMCxcos;
+        double fMCycos;
+        double fMCaz;
+        double fMCze;
+        double fMCxoff;
+        double fMCyoff;
+
+        unsigned int LTrigS;
+        ULong64_t LTrig;
+        unsigned int fNTrig;
+        int fNImages;
+        int fNImages_intersect;
+        ULong64_t fImgSel;
+        bool fImgSel_list[VDST_MAXTELESCOPES];
+        unsigned int fImgSel_list_short[VDST_MAXTELESCOPES];
+        int fNTelTypes;
+        unsigned int NImages_Ttype[VDST_MAXTELESCOPES];
+        double fimg2_ang;
+        double fZe;
+        double fAz;
+        double fRA;
+        double fDec;
+        double fXoff;
+        double fYoff;
+        double fXoff_derot;
+        double fYoff_derot;
+        double fstdS;
+        float ftheta2;
+        double fXcore;
+        double fYcore;
+        double fXcore_SC;
+        double fYcore_SC;
+        double fstdP;
+        double fchi2;                             //!< chi2 from array reconstruction
+        float  fMCEnergyArray [VDST_MAXTELESCOPES];
+        float  fmeanPedvar_ImageT[VDST_MAXTELESCOPES];
+        float  fmeanPedvar_Image;
+        float  fdist     [VDST_MAXTELESCOPES];
+        float  ffui       [VDST_MAXTELESCOPES];
+        float  fsize     [VDST_MAXTELESCOPES];
+        float  fsizeCorr [VDST_MAXTELESCOPES];
+        float  fsize_telType[VDST_MAXTELESCOPES];
+        float  floss     [VDST_MAXTELESCOPES];
+        float  ffracLow  [VDST_MAXTELESCOPES];
+        float  fmax1     [VDST_MAXTELESCOPES];
+        float  fmax2     [VDST_MAXTELESCOPES];
+        float  fmax3     [VDST_MAXTELESCOPES];
+        int    fmaxindex1     [VDST_MAXTELESCOPES];
+        int    fmaxindex2     [VDST_MAXTELESCOPES];
+        int    fmaxindex3     [VDST_MAXTELESCOPES];
+        float  fwidth    [VDST_MAXTELESCOPES];
+        float  fwidth_telType[VDST_MAXTELESCOPES];
+        float  flength   [VDST_MAXTELESCOPES];
+        float  flength_telType[VDST_MAXTELESCOPES];
+        int    fntubes   [VDST_MAXTELESCOPES];
+        unsigned short int fnsat[VDST_MAXTELESCOPES];
+        unsigned short int fnlowgain[VDST_MAXTELESCOPES];
+        float  falpha    [VDST_MAXTELESCOPES];
+        float  flos      [VDST_MAXTELESCOPES];
+        float  fasym     [VDST_MAXTELESCOPES];
+        float  fcen_x    [VDST_MAXTELESCOPES];
+        float  fcen_y    [VDST_MAXTELESCOPES];
+        float  fcosphi   [VDST_MAXTELESCOPES];
+        float  fsinphi   [VDST_MAXTELESCOPES];
+        float  ftgrad_x  [VDST_MAXTELESCOPES];
+        float  ftchisq_x [VDST_MAXTELESCOPES];
+        double fweight   [VDST_MAXTELESCOPES];    //!< always 1.
+        double fpointing_dx[VDST_MAXTELESCOPES];
+        double fpointing_dy[VDST_MAXTELESCOPES];
+        int    fFitstat  [VDST_MAXTELESCOPES];
+        // {-1}
+        float  fR_core      [VDST_MAXTELESCOPES];    //!< distance from each telescope to reconstructed shower core
+        float  fRTel        [VDST_MAXTELESCOPES];    //!< distance from each telescope to reconstructed shower core
+        float  fR_telType[VDST_MAXTELESCOPES];    //!< distance from each telescope to reconstructed shower core (depending on tel type)
+        float  fE        [VDST_MAXTELESCOPES];    //!< energy assigned to each telescope (method 0)
+        float  fES       [VDST_MAXTELESCOPES];    //!< energy assigned to each telescope (method 1)
+        int    fnenergyT;                         //!< number of images used for the energy calculation
+        int    fenergyQL;                         //!< quality label for energy calculation
+        float  ftmscw    [VDST_MAXTELESCOPES];    //!< mscw assigned to each telescope
+        float  ftmscl    [VDST_MAXTELESCOPES];    //!< mscl assigned to each telescope
+        float  ftmscw_sigma[VDST_MAXTELESCOPES];  //!< mscw  sigma  assigned to each telescope
+        float  ftmscl_sigma[VDST_MAXTELESCOPES];  //!< mscl  sigma  assigned to each telescope
+
+        int    fnmscw;                            //!< number of images used for mscw/mscl/energy calculation
+        float  fmscw;                             //!< mean scaled width
+        float  fmscl;                             //!< mean scaled length
+        float  fmwr;                              //!< mean width ratio
+        float  fmlr;                              //!< mean length ratio
+        float  fenergy;                           //!< reconstructed primary energy
+        float  fechi2;                            //!< chi2 from reconstructed primary energy
+        float  fdE;                               //!< dE from reconstructed primary energy
+        float  fenergyS;                          //!< reconstructed primary energy
+        float  fechi2S;                           //!< chi2 from reconstructed primary energy
+        float  fdES;                              //!< dE from reconstructed primary energy
+
+        // emission height
+        unsigned int fNTelPairs;
+        float  fEmissionHeightMean;
+        float  fEmissionHeightChi2;
+        //!< (note that maximum array length should be larger than MaxNbrTel
+        float  fEmissionHeightT[VDST_MAXTELESCOPES];
+
+        double fSizeSecondMax;
+
+        // disp related variables
+        float fXoff_edisp;
+        float fYoff_edisp;
+        float fChi2_edisp;
+        float fXoff_intersect;                  //! keep direction from intersection method
+        float fYoff_intersect;                  //! keep direction from intersection method
+        float fXoff_T[VDST_MAXTELESCOPES];      //! direction reconstructed for each telescope
+        float fYoff_T[VDST_MAXTELESCOPES];      //! direction reconstructed for each telescope
+        float fWoff_T[VDST_MAXTELESCOPES];      //! direction reconstructed for each telescope (weight)
+        float fDoff_T[VDST_MAXTELESCOPES];      //! (disp value)
+        float fDispAbsSumWeigth;                //! sum of absolute values of disp weights
+        unsigned int fToff_T[VDST_MAXTELESCOPES]; //! list of telescope participating in disp
+        unsigned int fnxyoff;                   //! number of images used for disp direction reconstruction
+        // difference in disp event direction between telescopes
+        double fDispDiff;
+
+        VTableLookupEventData() {}
+        ~VTableLookupEventData() {}
+};
+#endif
@@ -0,0 +1,43 @@
+//! VTableLookupEventQueue  queue of event chunks handed over between threads of the mscw_energy event loop
+
+#ifndef VTABLELOOKUPEVENTQUEUE_H
+#define VTABLELOOKUPEVENTQUEUE_H
+
+#include "VTableLookupEventData.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/*
+    chunk of consecutive events (in order of the input tree)
+*/
+struct sTableLookupEventChunk
+{
+    unsigned int fN;                          // number of events in chunk
+    vector< VTableLookupEventData > fEvent;
+    vector< int > fReadStatus;                // see VTableLookupDataHandler::readNextEvent()
+    vector< int > fFill;                      // fill event into output tree
+};
+
+class VTableLookupEventQueue
+{
+    private:
+
+        deque< sTableLookupEventChunk* > fQueue;
+        mutex fMutex;
+        condition_variable fCondition;
+        bool fClosed;
+
+    public:
+
+        VTableLookupEventQueue();
+        ~VTableLookupEventQueue() {}
+        void close();
+        sTableLookupEventChunk* pop();
+        void push( sTableLookupEventChunk* iChunk );
+};
+#endif
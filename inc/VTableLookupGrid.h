@@ -0,0 +1,347 @@
+//! VTableLookupGrid  lookup table (2D median/sigma grid) stored as plain arrays
+
+#ifndef VTABLELOOKUPGRID_H
+#define VTABLELOOKUPGRID_H
+
+#include "TH2F.h"
+
+#include "VStatistics.h"
+
+#include <vector>
+
+using namespace std;
+
+/*
+    grid with the same bin numbering as TH2F:
+
+        bins 1..n on each axis, 0 = underflow, n+1 = overflow
+        global bin = ix + ( nx + 2 ) * iy
+
+    content and errors are either owned by the grid (copied from a TH2F)
+    or point into external memory (e.g. a memory mapped table file)
+*/
+class VTableLookupGrid
+{
+    private:
+        vector< float > fContentData;             //!< owned content (if copied)
+        vector< float > fErrorData;               //!< owned errors (if copied)
+        vector< double > fXbinsData;              //!< owned variable bin edges (if copied)
+        vector< double > fYbinsData;
+        vector< double > fXCenter;                //!< bin centers (bins 0..n+2; see initAxes())
+        vector< double > fYCenter;
+
+        static bool fAVX2;                        //!< use AVX2 kernel for batched interpolation
+
+        unsigned int findBin( double x, unsigned int n, double xmin, double xmax, const double* xbins ) const
+        {
+            if( x < xmin )
+            {
+                return 0;
+            }
+            if( !( x < xmax ) )
+            {
+                return n + 1;
+            }
+            if( !xbins )
+            {
+                return 1 + ( unsigned int )( n * ( x - xmin ) / ( xmax - xmin ) );
+            }
+            // binary search (as TMath::BinarySearch)
+            unsigned int iLow = 0;
+            unsigned int iUp = n;
+            while( iUp - iLow > 1 )
+            {
+                unsigned int iMid = ( iLow + iUp ) / 2;
+                if( x >= xbins[iMid] )
+                {
+                    iLow = iMid;
+                }
+                else
+                {
+                    iUp = iMid;
+                }
+            }
+            return iLow + 1;
+        }
+        // (as TAxis::GetBinCenter)
+        double getBinCenter( unsigned int i, unsigned int n, double xmin, double xmax, const double* xbins ) const
+        {
+            if( !xbins || i < 1 || i > n )
+            {
+                double iBinWidth = ( xmax - xmin ) / double( n );
+                return xmin + ( double( i ) - 1. ) * iBinWidth + 0.5 * iBinWidth;
+            }
+            return 0.5 * ( xbins[i - 1] + xbins[i] );
+        }
+
+    public:
+        unsigned int fNBinsX;
+        unsigned int fNBinsY;
+        double fXmin;
+        double fXmax;
+        double fYmin;
+        double fYmax;
+        const double* fXbins;                     //!< variable bin edges (nx+1; 0 for fixed bins)
+        const double* fYbins;
+        const float* fContent;                    //!< (nx+2)*(ny+2) bin contents
+        const float* fError;                      //!< (nx+2)*(ny+2) bin errors
+
+        VTableLookupGrid()
+        {
+            fNBinsX = 0;
+            fNBinsY = 0;
+            fXmin = 0.;
+            fXmax = 0.;
+            fYmin = 0.;
+            fYmax = 0.;
+            fXbins = 0;
+            fYbins = 0;
+            fContent = 0;
+            fError = 0;
+        }
+        /*
+            copy contents and errors of a TH2F
+        */
+        VTableLookupGrid( TH2F* h )
+        {
+            fNBinsX = 0;
+            fNBinsY = 0;
+            fXmin = 0.;
+            fXmax = 0.;
+            fYmin = 0.;
+            fYmax = 0.;
+            fXbins = 0;
+            fYbins = 0;
+            fContent = 0;
+            fError = 0;
+            if( !h )
+            {
+                return;
+            }
+            fNBinsX = h->GetNbinsX();
+            fNBinsY = h->GetNbinsY();
+            fXmin = h->GetXaxis()->GetXmin();
+            fXmax = h->GetXaxis()->GetXmax();
+            fYmin = h->GetYaxis()->GetXmin();
+            fYmax = h->GetYaxis()->GetXmax();
+            if( h->GetXaxis()->GetXbins()->GetSize() > 0 )
+            {
+                fXbinsData.assign( h->GetXaxis()->GetXbins()->GetArray(), h->GetXaxis()->GetXbins()->GetArray() + fNBinsX + 1 );
+                fXbins = &fXbinsData[0];
+            }
+            if( h->GetYaxis()->GetXbins()->GetSize() > 0 )
+            {
+                fYbinsData.assign( h->GetYaxis()->GetXbins()->GetArray(), h->GetYaxis()->GetXbins()->GetArray() + fNBinsY + 1 );
+                fYbins = &fYbinsData[0];
+            }
+            fContentData.assign( ( fNBinsX + 2 ) * ( fNBinsY + 2 ), 0. );
+            fErrorData.assign( ( fNBinsX + 2 ) * ( fNBinsY + 2 ), 0. );
+            for( unsigned int j = 0; j < fNBinsY + 2; j++ )
+            {
+                for( unsigned int i = 0; i < fNBinsX + 2; i++ )
+                {
+                    fContentData[i + ( fNBinsX + 2 ) * j] = h->GetBinContent( i, j );
+                    fErrorData[i + ( fNBinsX + 2 ) * j] = h->GetBinError( i, j );
+                }
+            }
+            fContent = &fContentData[0];
+            fError = &fErrorData[0];
+            initAxes();
+        }
+        /*
+            same binning as iTemplate, with the given contents and errors
+        */
+        VTableLookupGrid( const VTableLookupGrid* iTemplate, const vector< float >& iContent, const vector< float >& iError )
+        {
+            fNBinsX = iTemplate->fNBinsX;
+            fNBinsY = iTemplate->fNBinsY;
+            fXmin = iTemplate->fXmin;
+            fXmax = iTemplate->fXmax;
+            fYmin = iTemplate->fYmin;
+            fYmax = iTemplate->fYmax;
+            fXbins = 0;
+            fYbins = 0;
+            if( iTemplate->fXbins )
+            {
+                fXbinsData.assign( iTemplate->fXbins, iTemplate->fXbins + fNBinsX + 1 );
+                fXbins = &fXbinsData[0];
+            }
+            if( iTemplate->fYbins )
+            {
+                fYbinsData.assign( iTemplate->fYbins, iTemplate->fYbins + fNBinsY + 1 );
+                fYbins = &fYbinsData[0];
+            }
+            fContentData = iContent;
+            fErrorData = iError;
+            fContent = &fContentData[0];
+            fError = &fErrorData[0];
+            initAxes();
+        }
+        ~VTableLookupGrid() {}
+        // no copies (pointers might point to owned data)
+        VTableLookupGrid( const VTableLookupGrid& ) = delete;
+        VTableLookupGrid& operator=( const VTableLookupGrid& ) = delete;
+
+        unsigned int findBinX( double x ) const
+        {
+            return findBin( x, fNBinsX, fXmin, fXmax, fXbins );
+        }
+        unsigned int findBinY( double y ) const
+        {
+            return findBin( y, fNBinsY, fYmin, fYmax, fYbins );
+        }
+        double getBinCenterX( unsigned int i ) const
+        {
+            if( i < fXCenter.size() )
+            {
+                return fXCenter[i];
+            }
+            return getBinCenter( i, fNBinsX, fXmin, fXmax, fXbins );
+        }
+        double getBinCenterY( unsigned int i ) const
+        {
+            if( i < fYCenter.size() )
+            {
+                return fYCenter[i];
+            }
+            return getBinCenter( i, fNBinsY, fYmin, fYmax, fYbins );
+        }
+        float getBinCenterXf( unsigned int i ) const
+        {
+            return static_cast<float>( getBinCenterX( i ) );
+        }
+        float getBinCenterYf( unsigned int i ) const
+        {
+            return static_cast<float>( getBinCenterY( i ) );
+        }
+        /*
+            precalculate bin centers
+            (to be called after the axes are set)
+        */
+        void initAxes()
+        {
+            fXCenter.resize( fNBinsX + 3 );
+            for( unsigned int i = 0; i < fXCenter.size(); i++ )
+            {
+                fXCenter[i] = getBinCenter( i, fNBinsX, fXmin, fXmax, fXbins );
+            }
+            fYCenter.resize( fNBinsY + 3 );
+            for( unsigned int i = 0; i < fYCenter.size(); i++ )
+            {
+                fYCenter[i] = getBinCenter( i, fNBinsY, fYmin, fYmax, fYbins );
+            }
+        }
+        /*
+            memory used by the grid (owned data only) [bytes]
+        */
+        unsigned long getMemorySize() const
+        {
+            return sizeof( VTableLookupGrid ) + ( fContentData.size() + fErrorData.size() ) * sizeof( float )
+                   + ( fXbinsData.size() + fYbinsData.size() + fXCenter.size() + fYCenter.size() ) * sizeof( double );
+        }
+        float getBinContent( unsigned int i, unsigned int j ) const
+        {
+            return fContent[i + ( fNBinsX + 2 ) * j];
+        }
+        float getBinError( unsigned int i, unsigned int j ) const
+        {
+            return fError[i + ( fNBinsX + 2 ) * j];
+        }
+        unsigned int getSize() const
+        {
+            return ( fNBinsX + 2 ) * ( fNBinsY + 2 );
+        }
+        bool hasSameBinning( const VTableLookupGrid* g ) const
+        {
+            if( !g || g->fNBinsX != fNBinsX || g->fNBinsY != fNBinsY
+                    || g->fXmin != fXmin || g->fXmax != fXmax || g->fYmin != fYmin || g->fYmax != fYmax
+                    || ( g->fXbins == 0 ) != ( fXbins == 0 ) || ( g->fYbins == 0 ) != ( fYbins == 0 ) )
+            {
+                return false;
+            }
+            for( unsigned int i = 0; fXbins && i < fNBinsX + 1; i++ )
+            {
+                if( g->fXbins[i] != fXbins[i] )
+                {
+                    return false;
+                }
+            }
+            for( unsigned int i = 0; fYbins && i < fNBinsY + 1; i++ )
+            {
+                if( g->fYbins[i] != fYbins[i] )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        bool isValid() const
+        {
+            return ( fContent && fError && fNBinsX > 0 && fNBinsY > 0 );
+        }
+        /*
+            bilinear interpolation of bin content (iError = false) or bin error (iError = true)
+            (same as VTableCalculator::interpolate( TH2F*, ... ))
+        */
+        double interpolate( float x, float y, bool iError ) const
+        {
+            if( !isValid() )
+            {
+                return 0.;
+            }
+            const float* iV = ( iError ? fError : fContent );
+            unsigned int i_x = findBinX( x );
+            unsigned int i_y = findBinY( y );
+            // handle under and overflows ( bin nBinsX+1 is needed)
+            if( i_x == 0 || i_y == 0 || i_x == fNBinsX || i_y == fNBinsY )
+            {
+                return iV[i_x + ( fNBinsX + 2 ) * i_y];
+            }
+            if( x < getBinCenterX( i_x ) )
+            {
+                i_x--;
+            }
+            if( y < getBinCenterY( i_y ) )
+            {
+                i_y--;
+            }
+            // bins beyond the overflow bin are clamped (as in TH1::GetBin)
+            unsigned int n = fNBinsX + 2;
+            unsigned int i_x1 = ( i_x < fNBinsX + 1 ? i_x : fNBinsX + 1 );
+            unsigned int i_x2 = ( i_x + 1 < fNBinsX + 1 ? i_x + 1 : fNBinsX + 1 );
+            unsigned int i_y1 = ( i_y < fNBinsY + 1 ? i_y : fNBinsY + 1 );
+            unsigned int i_y2 = ( i_y + 1 < fNBinsY + 1 ? i_y + 1 : fNBinsY + 1 );
+            float y1 = getBinCenterYf( i_y );
+            float y2 = getBinCenterYf( i_y + 1 );
+            // first interpolate on distance axis, then on size axis
+            float e1 = VStatistics::interpolate( iV[i_x1 + n * i_y1], y1, iV[i_x1 + n * i_y2], y2, y, false );
+            float e2 = VStatistics::interpolate( iV[i_x2 + n * i_y1], y1, iV[i_x2 + n * i_y2], y2, y, false );
+            float v = VStatistics::interpolate( e1, getBinCenterXf( i_x ), e2, getBinCenterXf( i_x + 1 ), x, false );
+            // final check on consistency of results
+            // (don't expect to reconstruct anything below 1 GeV)
+            if( e1 > 1.e-3 && e2 < 1.e-3 )
+            {
+                return e1;
+            }
+            if( e1 < 1.e-3 && e2 > 1.e-3 )
+            {
+                return e2;
+            }
+            return v;
+        }
+        /*
+            batched interpolation of bin contents (med) and errors (sigma)
+            for n points, each with its own table g[i] (0: med = sigma = 0)
+
+            (used for the telescopes of one event, see VTableCalculator::calc;
+             ./bin/testTableLookupGrid prints the run time of the scalar and AVX2 kernels)
+        */
+        static void interpolate( unsigned int n, const VTableLookupGrid* const* g, const float* x, const float* y,
+                                 float* med, float* sigma );
+        static bool isAVX2()
+        {
+            return fAVX2;
+        }
+        static void setAVX2( bool iAVX2 = true );
+};
+#endif
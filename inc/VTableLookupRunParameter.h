@@ -51,6 +51,10 @@ class VTableLookupRunParameter : public TNamed, public VGlobalRunParameter
         bool  fLimitEnergyReconstruction;
 
         float fMinRequiredShowerPerBin;
+        double fTableCacheSize;            // memory budget for tables read from file [MB] (0 = no limit)
+        bool fUseTableInterpolationCache;  // interpolate tables in ze and woff once per run (see VTableInterpolationCache)
+        double fTableInterpolationCacheSize; // memory budget for interpolated tables [MB] (0 = no limit)
+        unsigned int fNThreads;            // number of threads for event loop (table reading only)
 
         bool  fUseEvndispSelectedImagesOnly;
 
@@ -108,6 +112,6 @@ class VTableLookupRunParameter : public TNamed, public VGlobalRunParameter
         void print( int iB = 0 );
         void printHelp();
 
-        ClassDef( VTableLookupRunParameter, 33 );
+        ClassDef( VTableLookupRunParameter, 37 );
 };
 #endif
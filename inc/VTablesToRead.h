@@ -6,6 +6,8 @@
 #include "TH2F.h"
 #include "TH2D.h"
 
+#include "VTableLookupGrid.h"
+
 #include <iostream>
 #include <vector>
 
@@ -24,6 +26,10 @@ class VTablesToRead
         vector< TH2F* > henergyERSigma;
         vector< TH2F* > henergySRMedian;
         vector< TH2F* > henergySRSigma;
+        // tables from binary table files
+        vector< VTableLookupGrid* > gmscwMedian;
+        vector< VTableLookupGrid* > gmsclMedian;
+        vector< VTableLookupGrid* > genergySRMedian;
 
         double mscw;
         double mscl;
@@ -0,0 +1,45 @@
+//! VThreadPool simple fork-join thread pool (e.g. for telescope-parallel image analysis)
+
+#ifndef VTHREADPOOL_H
+#define VTHREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class VThreadPool
+{
+    private:
+
+        vector< thread > fWorkers;                //!< worker threads (number of threads - 1)
+
+        mutex fMutex;
+        condition_variable fCondition_start;      //!< signal new tasks to workers
+        condition_variable fCondition_done;       //!< signal end of all tasks to main thread
+
+        function< void( unsigned int ) > fTask;  //!< task to execute (argument is task index)
+        unsigned int fNTasks;                     //!< number of tasks in current batch
+        unsigned int fNextTask;                   //!< index of next task to be taken
+        unsigned int fNTasksDone;                 //!< number of finished tasks in current batch
+        unsigned long int fGeneration;            //!< batch counter
+        bool fStop;
+
+        bool nextTask( unsigned int& iTask );
+        void work();
+
+    public:
+
+        VThreadPool( unsigned int iNThreads = 1 );
+        ~VThreadPool();
+        unsigned int getNThreads()
+        {
+            return fWorkers.size() + 1;
+        }
+        void run( unsigned int iNTasks, function< void( unsigned int ) > iTask );
+};
+#endif
@@ -0,0 +1,95 @@
+//! VTraceBatchHandler trace integration and timing for all channels of a camera (SIMD)
+
+#ifndef VTRACEBATCHHANDLER_H
+#define VTRACEBATCHHANDLER_H
+
+#include <iostream>
+#include <stdint.h>
+#include <vector>
+
+#include "VVirtualDataReader.h"
+
+using namespace std;
+
+class VTraceBatchHandler
+{
+    private:
+        bool fAVX2;                               //!< use AVX2 kernels
+
+        unsigned int fNSamples;
+        unsigned int fNChannels;                  //!< number of channels in batch
+        unsigned int fNLanes;                     //!< number of channels in batch (padded to SIMD width)
+
+        vector< int32_t > fSample;                //!< FADC samples [sample][channel]
+        vector< float > fFADC;                    //!< pedestal subtracted FADC samples [sample][channel]
+        vector< double > fPed;
+        vector< unsigned int > fChannelID;
+        vector< unsigned int > fHitID;
+
+        // results of last trace integration
+        vector< double > fTraceSum;
+        vector< double > fTraceAverageTime;
+        vector< unsigned int > fSumWindowFirst;
+        vector< unsigned int > fSumWindowLast;
+
+        vector< float > fpulsetiminglevels;       //!< levels in fraction of maximum for pulse timing calculation
+        vector< float > fpulsetiming;             //!< pulse timing vector (refilled for each call)
+        unsigned int fpulsetiming_maxPV;
+
+    public:
+        VTraceBatchHandler();
+        ~VTraceBatchHandler() {}
+
+        bool   addChannel( VVirtualDataReader* iReader, unsigned int iChannelID, unsigned int iHitID, double iPed,
+                           unsigned int iTraceStart = 0 );
+        void   calculateMaximum( vector< int >& iFirst, vector< int >& iLast, vector< int >& iMaxPos );
+        void   calculateTraceSum_fixedWindow( vector< int >& iFirst, vector< int >& iLast, bool iRaw );
+        void   calculateTraceSum_slidingWindow( vector< int >& iIntegrationWindow );
+        unsigned int getChannelID( unsigned int i )
+        {
+            return fChannelID[i];
+        }
+        unsigned int getHitID( unsigned int i )
+        {
+            return fHitID[i];
+        }
+        unsigned int getNChannels()
+        {
+            return fNChannels;
+        }
+        unsigned int getNLanes()
+        {
+            return fNLanes;
+        }
+        vector< float >& getPulseTiming( unsigned int i, int iMaxPos, int fTFirst, int fTLast );
+        double getSample( unsigned int i, unsigned int iSample )
+        {
+            return ( double )fSample[iSample * fNLanes + i];
+        }
+        vector< double > getTrace( unsigned int i );
+        double getTraceAverageTime( unsigned int i )
+        {
+            return fTraceAverageTime[i];
+        }
+        unsigned int getTraceIntegrationFirst( unsigned int i )
+        {
+            return fSumWindowFirst[i];
+        }
+        unsigned int getTraceIntegrationLast( unsigned int i )
+        {
+            return fSumWindowLast[i];
+        }
+        double getTraceMax( unsigned int i, int iMaxPos );
+        double getTraceSum( unsigned int i )
+        {
+            return fTraceSum[i];
+        }
+        bool   isAVX2()
+        {
+            return fAVX2;
+        }
+        void   reset( unsigned int iNSamples, unsigned int iMaxChannels );
+        void   setAVX2( bool iAVX2 = true );
+        void   setPulseTimingLevels( vector< float > iP );
+};
+#endif
@@ -14,13 +14,12 @@ using namespace std;
 
 class VTraceHandler
 {
-    private:
-        //!< linear interpolation
-        double getLinInterpol( double y5, int x1, double y1, int x2, double y2 );
-
     protected:
         unsigned int    fTraceIntegrationMethod;  //   set trace integration method (see setter in source file for definition)
         vector< double >  fpTrace;                //!< the FADC trace
+        const uint8_t*  fpTraceView8;             //!< FADC trace in reader buffer (8 bit; 0 if not available)
+        const uint16_t* fpTraceView16;            //!< FADC trace in reader buffer (16 bit; 0 if not available)
+        bool            fpTraceFilled;            //!< false if fpTrace has not yet been filled from the reader buffer
         unsigned int fpulsetiming_maxPV;
         unsigned int fpulsetiminglevels_size;
         vector< float > fpulsetiminglevels;       //!< levels in fraction of maximum for pulse timing calculation
@@ -43,14 +42,20 @@ class VTraceHandler
 
         double   calculateTraceSum_slidingWindow( unsigned int iSearchStart, unsigned int iSearchEnd, int iIntegrationWindow, bool fRaw );
 
+        void     fillTrace( VVirtualDataReader* iReader, unsigned int iNSamples, unsigned int iHitID );
+        void     fillTrace( const uint8_t* iTrace, unsigned int iNSamples );
+        void     fillTrace( const uint16_t* iTrace, unsigned int iNSamples );
+        void     fillTraceFromView();
         void     reset();
 
     public:
         VTraceHandler();
         virtual ~VTraceHandler() {};
 
-        virtual void setTrace( vector< uint8_t >, double, double, unsigned int, double iHiLo = -1. ); //!< pass the trace values (with hilo)
-        virtual void setTrace( vector< uint16_t >, double, double, unsigned int, double iHilo = -1. ); //!< pass the trace values (with hilo)
+        static double getLinInterpol( double y5, int x1, double y1, int x2, double y2 ); //!< linear interpolation
+
+        virtual void setTrace( const vector< uint8_t >&, double, double, unsigned int, double iHiLo = -1. ); //!< pass the trace values (with hilo)
+        virtual void setTrace( const vector< uint16_t >&, double, double, unsigned int, double iHilo = -1. ); //!< pass the trace values (with hilo)
         virtual void setTrace( VVirtualDataReader* iReader, unsigned int iNSamples, double ped, double pedrms,
                                unsigned int iChanID, unsigned int iHitID, double iHilo = -1. );
         // methods for getting quick trace parameters between specified limits
@@ -67,6 +72,7 @@ class VTraceHandler
         }
         vector< double >& getTrace()
         {
+            fillTraceFromView();
             return fpTrace;
         }
         double getTraceAverageTime()
@@ -109,6 +115,18 @@ class VTraceHandler
         {
             return fTraceIntegrationMethod;
         }
+        bool    getIPRmeasure()
+        {
+            return kIPRmeasure;
+        }
+        unsigned int getMC_FADCTraceStart()
+        {
+            return fMC_FADCTraceStart;
+        }
+        vector< float >& getPulseTimingLevels()
+        {
+            return fpulsetiminglevels;
+        }
         virtual double getTraceMax();
         virtual double getTraceMax( unsigned int& n255, double iHiLo = 6. ); // get maximum value in trace
         virtual void   getTraceMax( double&, double& );
@@ -0,0 +1,96 @@
+//! VTracePulseFitter  fixed-function pulse fit to FADC samples (analytic Jacobian, no heap allocation)
+
+#ifndef VTRACEPULSEFITTER_H
+#define VTRACEPULSEFITTER_H
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+class VTracePulseFitter
+{
+    public:
+        static const unsigned int fMaxPar = 6;
+
+    private:
+        unsigned int fFunction;                   //!< 0 = ev, 1 = grisu
+        unsigned int fNPar;
+        unsigned int fNMaxIterations;             //!< maximum number of Gauss-Newton iterations
+
+        double fPar[fMaxPar];                     //!< fit parameters (same order as the TF1 trace functions)
+        bool   fFixed[fMaxPar];
+        double fParMin[fMaxPar];
+        double fParMax[fMaxPar];
+
+        double fChi2;                             //!< chi2 (not normalised)
+        int    fNDF;
+        int    fStatus;                           //!< 0 = failed, 1 = not converged, 3 = converged
+        unsigned int fNIterations;
+
+        double fPeakX;                            //!< position of pulse maximum
+
+        double getChi2( const double* iTrace, const double* iWeight, unsigned int iNSamples, const double* p,
+                        double* iJTJ, double* iJTr, const unsigned int* iFree, unsigned int iNFree );
+        void   getDerivatives( double x, const double* p, double* iDf );
+        void   setInitialParameters( const double* iTrace, unsigned int iNSamples, double iPed );
+        void   setPeakPosition();
+        static bool solve( double* iA, double* b, unsigned int n );
+
+    public:
+        VTracePulseFitter( string iFunction = "ev" );
+        ~VTracePulseFitter() {}
+
+        static double evalEV( double x, const double* p );
+        static double evalGrisu( double x, const double* p );
+
+        double eval( double x ) const
+        {
+            return ( fFunction == 0 ? evalEV( x, fPar ) : evalGrisu( x, fPar ) );
+        }
+        bool   fit( const double* iTrace, unsigned int iNSamples, double iPed, double iPedRMS );
+        double getChi2()
+        {
+            return fChi2;
+        }
+        double getIntegral( double a, double b ) const;
+        double getMinimum( double xmin, double xmax ) const
+        {
+            return eval( getMinimumX( xmin, xmax ) );
+        }
+        double getMinimumX( double xmin, double xmax ) const;
+        int    getNDF()
+        {
+            return fNDF;
+        }
+        unsigned int getNIterations()
+        {
+            return fNIterations;
+        }
+        unsigned int getNPar()
+        {
+            return fNPar;
+        }
+        int    getNumberFreeParameters();
+        double getParameter( unsigned int i )
+        {
+            return ( i < fMaxPar ? fPar[i] : 0. );
+        }
+        const double* getParameters() const
+        {
+            return fPar;
+        }
+        int    getStatus()
+        {
+            return fStatus;
+        }
+        double getX( double y, double xmin, double xmax ) const;
+        void   print();
+        bool   setFunction( string iFunction );
+        void   setMaxIterations( unsigned int iN = 20 )
+        {
+            fNMaxIterations = iN;
+        }
+};
+#endif
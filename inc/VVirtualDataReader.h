@@ -155,6 +155,18 @@ class VVirtualDataReader
             return 3;
         }
         double                              getSample_double( unsigned channel, unsigned sample, bool iNewNoiseTrace = true );
+        //!< pointer to samples of this channel in the reader buffer (0 if samples are modified while reading)
+        virtual const uint8_t*              getSamplePtr( unsigned channel, unsigned int& iNSamples )
+        {
+            iNSamples = 0;
+            return 0;
+        }
+        //!< pointer to samples of this channel in the reader buffer (0 if samples are modified while reading)
+        virtual const uint16_t*             getSamplePtr16Bit( unsigned channel, unsigned int& iNSamples )
+        {
+            iNSamples = 0;
+            return 0;
+        }
         virtual std::vector< uint16_t >     getSamplesVec16Bit()
         {
             return iSampleVec16bit;
@@ -309,6 +321,11 @@ class VVirtualDataReader
         {
             return false;
         }
+        //!< hit list contains only channels with data (all other channels are zero)
+        virtual bool isSparseReplay()
+        {
+            return false;
+        }
         virtual bool has16Bit()
         {
             return false;
@@ -50,6 +50,7 @@ void VArrayAnalyzer::doAnalysis()
     {
         cout << "void VArrayAnalyzer::doAnalysis()" << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_ARRAYANALYSIS );
 
     // only at first call in the analysis run: initialize data class, set trees
     if( !fInitialized )
@@ -184,6 +185,7 @@ void VArrayAnalyzer::doAnalysis()
 
     //////////////////////////////////////////////////////////////////////////////////////////////
     // fill shower parameter tree with results
+    VEvndispProfilerTimer iProfilerTimer_fill( getProfiler(), E_PROF_TREEFILLING_SHOWER );
     getShowerParameters()->getTree()->Fill();
 
 }
@@ -667,6 +669,134 @@ void VArrayAnalyzer::transformTelescopePosition( int iTel, float i_ze, float i_a
 }
 
 
+/*!
+     fill image and telescope data used by all reconstruction methods
+
+     (called once per event before the loop over the reconstruction methods)
+*/
+void VArrayAnalyzer::fillArrayImageData()
+{
+    fImageData.reset( getNTel() );
+
+    for( unsigned int t = 0; t < getNTel(); t++ )
+    {
+        setTelID( t );
+
+        // get telescope type for this telescope
+        int iTelType = fEvndispReconstructionParameter->getTelescopeType_counter( getDetectorGeometry()->getTelType()[t] );
+        if( iTelType < 0 )
+        {
+            cout << "VArrayAnalyzer::fillArrayImageData error: invalid telescope counter: " << t << "\t" << iTelType << endl;
+            exit( -1 );
+        }
+        fImageData.fTelTypeCounter[t] = iTelType;
+
+        VImageParameter* iImage = getImageParameters( getRunParameter()->fImageLL );
+        fImageData.fImage[t] = iImage;
+        // check if fit was successful
+        if( getRunParameter()->fImageLL && getImageParametersLogL()->Fitstat < 3 )
+        {
+            fImageData.fLLFitOK[t] = false;
+        }
+        fImageData.fSize[t] = iImage->size;
+        if( iImage->length > 0. )
+        {
+            fImageData.fWidthLength[t] = iImage->width / iImage->length;
+        }
+        float i_weight = iImage->size;
+        i_weight *= ( 1. - iImage->width / iImage->length );
+        fImageData.fCoreWeight[t] = i_weight * i_weight;
+        fImageData.fCen_x[t] = iImage->cen_x;
+        fImageData.fCen_y[t] = iImage->cen_y;
+        fImageData.fTel_x_SC[t] = iImage->Tel_x_SC;
+        fImageData.fTel_y_SC[t] = iImage->Tel_y_SC;
+        fImageData.fTel_z_SC[t] = iImage->Tel_z_SC;
+
+        // distance to closest bright star (used in image selection)
+        // (star catalogue holds the pointing of one telescope only)
+        if( getStarCatalogue() && getRunParameter()->fMinStarPixelDistance_deg > 0.
+                && iImage->ntubes < getRunParameter()->fMinStarNTubes
+                && updatePointingToStarCatalogue( t ) )
+        {
+            fImageData.fStarDistance_deg[t] = getDistanceToClosestStar( iImage );
+        }
+    }
+    // image centroids and axes for all pointing variants used
+    for( unsigned int i = 0; i < getShowerParameters()->fNMethods; i++ )
+    {
+        fillArrayImageData_pointing( getPointingVariant( i ) );
+    }
+}
+
+/*
+    pointing variant used by reconstruction method iMeth
+
+    0: eventdisplay pointing
+    1: pointing corrected for pointing errors (command line, tracking program or pointing monitors)
+*/
+unsigned int VArrayAnalyzer::getPointingVariant( unsigned int iMeth )
+{
+    if( iMeth < fEvndispReconstructionParameter->fUseEventdisplayPointing.size()
+            && !fEvndispReconstructionParameter->fUseEventdisplayPointing[iMeth] )
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/*
+    image centroids (in [deg] and [mm]) and image axis slopes for one pointing variant
+*/
+void VArrayAnalyzer::fillArrayImageData_pointing( unsigned int iPointing )
+{
+    if( iPointing >= VArrayImageData::fNPointing || fImageData.fPointingFilled[iPointing] )
+    {
+        return;
+    }
+    double iPointingErrorX = 0.;
+    double iPointingErrorY = 0.;
+    float i_cen_x = 0.;
+    float i_cen_y = 0.;
+    float i_phi = 0.;
+    for( unsigned int tel = 0; tel < getNTel(); tel++ )
+    {
+        setTelID( tel );
+        // get pointing difference between expected pointing towards source and measured pointing
+        if( iPointing == 1 && tel < getPointing().size() && getPointing()[tel] )
+        {
+            iPointingErrorX = getPointing()[tel]->getPointingErrorX();
+            iPointingErrorY = getPointing()[tel]->getPointingErrorY();
+        }
+        // do not use pointing corrections
+        else
+        {
+            iPointingErrorX = 0.;
+            iPointingErrorY = 0.;
+        }
+        // get image centroids corrected for pointing errors
+        i_cen_x = fImageData.fImage[tel]->cen_x + iPointingErrorX;
+        i_cen_y = fImageData.fImage[tel]->cen_y + iPointingErrorY;
+        // centroid locations in getImageParameters( getRunParameter()->fImageLL ) are in [deg]
+        // (in contrary to centroids in GrIsu ([mm]))
+        fImageData.fX_deg[iPointing][tel] = i_cen_x;
+        fImageData.fY_deg[iPointing][tel] = i_cen_y;
+        fImageData.fX_mm[iPointing][tel] = tan( i_cen_x * TMath::DegToRad() ) * getDetectorGeo()->getFocalLength()[tel] * 1000.;
+        fImageData.fY_mm[iPointing][tel] = tan( i_cen_y * TMath::DegToRad() ) * getDetectorGeo()->getFocalLength()[tel] * 1000.;
+        // calculate new 'phi' with pointing errors taken into account
+        i_phi = recalculateImagePhi( iPointingErrorX, iPointingErrorY );
+        if( cos( i_phi ) != 0. )
+        {
+            fImageData.fM[iPointing][tel] = sin( i_phi ) / cos( i_phi );
+        }
+        else
+        {
+            fImageData.fM[iPointing][tel] = 1.e9;
+        }
+    }
+    fImageData.fPointingFilled[iPointing] = true;
+}
+
+
 /*!
      select images used in shower reconstruction
 
@@ -679,8 +809,6 @@ void VArrayAnalyzer::transformTelescopePosition( int iTel, float i_ze, float i_a
 */
 void VArrayAnalyzer::selectShowerImages( unsigned int iMeth )
 {
-    bool fSelectDebug = false;
-
     getShowerParameters()->fTelIDImageSelected[iMeth].clear();
     getShowerParameters()->fTelIDImageSelected_bitcode[iMeth] = 0;
     getShowerParameters()->fShowerNumImages[iMeth] = 0;
@@ -689,76 +817,40 @@ void VArrayAnalyzer::selectShowerImages( unsigned int iMeth )
     // loop over all telescopes and check which image is suitable for reconstruction
     for( unsigned int t = 0; t < getNTel(); t++ )
     {
-        setTelID( t );
-
         // reset list with selected images
         getShowerParameters()->fTelIDImageSelected_list[iMeth][t] = 0;
-        getShowerParameters()->fTelIDImageSelected[iMeth].push_back( true );
-
-        if( fSelectDebug )
-        {
-            cout << "VArrayAnalyzer::selectShowerImages " << getTelID() + 1 << "\t" << getEventNumber() << "\t" << iMeth << endl;
-        }
-        if( fSelectDebug )
-        {
-            cout << "VArrayAnalyzer::selectShowerImages eventstatus " << getImageParameters( getRunParameter()->fImageLL )->eventStatus << endl;
-        }
-
-        // get telescope type for this telescope
-        int iTelType = fEvndispReconstructionParameter->getTelescopeType_counter( getDetectorGeometry()->getTelType()[t] );
-        if( iTelType < 0 )
-        {
-            cout << "VArrayAnalyzer::selectShowerImages error: invalid telescope counter: " << t << "\t" << iTelType << endl;
-            exit( -1 );
-            continue;
-        }
 
         // apply array analysis cuts
-        updatePointingToStarCatalogue( t );
-        getShowerParameters()->fTelIDImageSelected[iMeth].back() = fEvndispReconstructionParameter->applyArrayAnalysisCuts( iMeth, t, iTelType,
-                getImageParameters( getRunParameter()->fImageLL ),
-                getReader()->getLocalTriggerType( t ),
-                getStarCatalogue() );
-        // apply cut on image distance to stars
-
-        ///////////////////////////
-
+        bool i_selected = fEvndispReconstructionParameter->applyArrayAnalysisCuts( iMeth, t, fImageData.fTelTypeCounter[t],
+                          fImageData.fImage[t],
+                          getReader()->getLocalTriggerType( t ),
+                          fImageData.fStarDistance_deg[t] );
         // check if fit was successful
-        if( getRunParameter()->fImageLL && getImageParametersLogL()->Fitstat < 3 )
+        if( !fImageData.fLLFitOK[t] )
         {
-            getShowerParameters()->fTelIDImageSelected[iMeth].back() = false;
+            i_selected = false;
         }
+        getShowerParameters()->fTelIDImageSelected[iMeth].push_back( i_selected );
 
         // list of selected images
-        if( getShowerParameters()->fTelIDImageSelected[iMeth].back() )
+        if( i_selected )
         {
-            getShowerParameters()->fTelIDImageSelected_list[iMeth][getTelID()] = 1;
+            getShowerParameters()->fTelIDImageSelected_list[iMeth][t] = 1;
             getShowerParameters()->fShowerNumImages[iMeth]++;
         }
+    }
 
-        bitset<8 * sizeof( unsigned long )> i_nimage;
-        if( fNTel < i_nimage.size() )
+    bitset<8 * sizeof( unsigned long )> i_nimage;
+    if( fNTel < i_nimage.size() )
+    {
+        for( unsigned int i = 0; i < getNTel(); i++ )
         {
-            for( unsigned int i = 0; i < getNTel(); i++ )
+            if( getShowerParameters()->fTelIDImageSelected[iMeth][i] )
             {
-                if( i < i_nimage.size() )
-                {
-                    if( getShowerParameters()->fTelIDImageSelected[iMeth][i] )
-                    {
-                        i_nimage.set( i, 1 );
-                    }
-                    else
-                    {
-                        i_nimage.set( i, 0 );
-                    }
-                }
+                i_nimage.set( i, 1 );
             }
-            getShowerParameters()->fTelIDImageSelected_bitcode[iMeth] = i_nimage.to_ulong();
-        }
-        else
-        {
-            getShowerParameters()->fTelIDImageSelected_bitcode[iMeth] = 0;
         }
+        getShowerParameters()->fTelIDImageSelected_bitcode[iMeth] = i_nimage.to_ulong();
     }
 }
 
@@ -770,6 +862,9 @@ void VArrayAnalyzer::calcShowerDirection_and_Core()
         cout << "VArrayAnalyzer::calcShowerDirection_and_Core()" << endl;
     }
 
+    // image and telescope data for all methods
+    fillArrayImageData();
+
     // loop over all methods
     for( unsigned int i = 0; i < getShowerParameters()->fNMethods; i++ )
     {
@@ -1221,29 +1316,31 @@ int VArrayAnalyzer::rcs_method_3( unsigned int iMethod )
     float ixs = 0.;
     float iys = 0.;
     float iangdiff = 0.;
+    unsigned int v = getPointingVariant( iMethod );
     for( unsigned int ii = 0; ii < m.size(); ii++ )
     {
-        for( unsigned int jj = 1; jj < m.size(); jj++ )
+        for( unsigned int jj = ii + 1; jj < m.size(); jj++ )
         {
-            if( ii == jj || ii > jj )
+            // intersection of image axes (shared between methods)
+            if( !fImageData.getPairIntersection( v, false, telID[ii], telID[jj], xs, ys, stds ) )
             {
-                continue;
+                xx[0] = x[ii];
+                yy[0] = y[ii];
+                ww[0] = 1.;
+                mm[0] = m[ii];
+                xx[1] = x[jj];
+                yy[1] = y[jj];
+                ww[1] = 1.;
+                mm[1] = m[jj];
+
+                rcs_perpendicular_fit( xx, yy, ww, mm, 2, &xs, &ys, &stds );
+                fImageData.setPairIntersection( v, false, telID[ii], telID[jj], xs, ys, stds );
             }
-            xx[0] = x[ii];
-            yy[0] = y[ii];
-            ww[0] = 1.;
-            mm[0] = m[ii];
-            xx[1] = x[jj];
-            yy[1] = y[jj];
-            ww[1] = 1.;
-            mm[1] = m[jj];
-
-            rcs_perpendicular_fit( xx, yy, ww, mm, 2, &xs, &ys, &stds );
 
             iangdiff = sin( fabs( atan( m[jj] ) - atan( m[ii] ) ) );
 
             // discard all pairs with almost parallel lines
-            float i_diff =  fabs( atan( mm[0] ) - atan( mm[1] ) );
+            float i_diff =  fabs( atan( m[ii] ) - atan( m[jj] ) );
             if( i_diff < fEvndispReconstructionParameter->fAxesAngles_min[iMethod] / TMath::RadToDeg() ||
                     fabs( 180. / TMath::RadToDeg() - i_diff ) < fEvndispReconstructionParameter->fAxesAngles_min[iMethod] / TMath::RadToDeg() )
             {
@@ -1376,15 +1473,13 @@ int VArrayAnalyzer::rcs_method_4( unsigned int iMethod )
     float b2 = 0.;
 
     double i_weight_max = 0.;
+    float i_std = 0.;
 
+    unsigned int v = getPointingVariant( iMethod );
     for( unsigned int ii = 0; ii < m.size(); ii++ )
     {
-        for( unsigned int jj = 1; jj < m.size(); jj++ )
+        for( unsigned int jj = ii + 1; jj < m.size(); jj++ )
         {
-            if( ii == jj || ii > jj )
-            {
-                continue;
-            }
 
             // check minimum angle between image lines; ignore if too small
             iangdiff = fabs( atan( m[jj] ) - atan( m[ii] ) );
@@ -1396,19 +1491,23 @@ int VArrayAnalyzer::rcs_method_4( unsigned int iMethod )
             // weight is sin of angle between image lines
             iangdiff = fabs( sin( fabs( atan( m[jj] ) - atan( m[ii] ) ) ) );
 
-            b1 = y[ii] - m[ii] * x[ii];
-            b2 = y[jj] - m[jj] * x[jj];
-
-            // line intersection
-            if( m[ii] != m[jj] )
+            // line intersection (shared between methods)
+            if( !fImageData.getPairIntersection( v, true, telID[ii], telID[jj], xs, ys, i_std ) )
             {
-                xs = ( b2 - b1 )  / ( m[ii] - m[jj] );
-            }
-            else
-            {
-                xs = 0.;
+                b1 = y[ii] - m[ii] * x[ii];
+                b2 = y[jj] - m[jj] * x[jj];
+
+                if( m[ii] != m[jj] )
+                {
+                    xs = ( b2 - b1 )  / ( m[ii] - m[jj] );
+                }
+                else
+                {
+                    xs = 0.;
+                }
+                ys = m[ii] * xs + b1;
+                fImageData.setPairIntersection( v, true, telID[ii], telID[jj], xs, ys, 0. );
             }
-            ys = m[ii] * xs + b1;
 
 
             iweight  = 1. / ( 1. / w[ii] + 1. / w[jj] ); // weight 1: size of images
@@ -1552,12 +1651,8 @@ void VArrayAnalyzer::prepareforDirectionReconstruction( unsigned int iMethodInde
     {
         cout << "VArrayAnalyzer::prepareforDirectionReconstruction; preparing method " << iMethodIndex << endl;
     }
-
-    double iPointingErrorX = 0.;
-    double iPointingErrorY = 0.;
-    float i_cen_x = 0.;
-    float i_cen_y = 0.;
-    float i_phi = 0.;
+    unsigned int v = getPointingVariant( iMethodIndex );
+    fillArrayImageData_pointing( v );
 
     // reset data vectors
     telID.clear();
@@ -1565,106 +1660,31 @@ void VArrayAnalyzer::prepareforDirectionReconstruction( unsigned int iMethodInde
     y.clear();
     l.clear();
     m.clear();
-    phi.clear();
-    sinphi.clear();
-    cosphi.clear();
     w.clear();
-    length.clear();
-    width.clear();
-    asym.clear();
-    loss.clear();
-    dist.clear();
-    pedvar.clear();
-    teltype.clear();
-    tgrad.clear();
-    xcore.clear();
-    ycore.clear();
-    Xoff.clear();
-    Yoff.clear();
-    cen_x.clear();
-    cen_y.clear();
-    ltrig.clear();
-    ze.clear();
-    az.clear();
 
     ///////////////////////////////////////////////
     // fill the x, y, w, and m arrays for the fit
+    // (centroids in [deg] for methods 4 and 5, otherwise in [mm])
+    bool bDeg = ( iReconstructionMethod == 4 || iReconstructionMethod == 5 );
     for( unsigned int tel = 0; tel < getNTel(); tel++ )
     {
-        setTelID( tel );
         if( getShowerParameters()->fTelIDImageSelected[iMethodIndex][tel] )
         {
             telID.push_back( tel );
-            // get pointing difference between expected pointing towards source and measured pointing
-            // (by command line, tracking program or pointing monitors)
-            if( !fEvndispReconstructionParameter->fUseEventdisplayPointing[iMethodIndex] && tel < getPointing().size() && getPointing()[tel] )
-            {
-                iPointingErrorX = getPointing()[tel]->getPointingErrorX();
-                iPointingErrorY = getPointing()[tel]->getPointingErrorY();
-            }
-            // do not use pointing corrections
-            else
-            {
-                iPointingErrorX = 0.;
-                iPointingErrorY = 0.;
-            }
-            // get image centroids corrected for pointing errors
-            i_cen_x = getImageParameters( getRunParameter()->fImageLL )->cen_x + iPointingErrorX;
-            i_cen_y = getImageParameters( getRunParameter()->fImageLL )->cen_y + iPointingErrorY;
-            // centroid locations in getImageParameters( getRunParameter()->fImageLL ) are in [deg]
-            // (in contrary to centroids in GrIsu ([mm]))
-            if( iReconstructionMethod == 4 || iReconstructionMethod == 5 )
+            if( bDeg )
             {
-                x.push_back( i_cen_x );
-                y.push_back( i_cen_y );
+                x.push_back( fImageData.fX_deg[v][tel] );
+                y.push_back( fImageData.fY_deg[v][tel] );
             }
             else
             {
-                x.push_back( tan( i_cen_x * TMath::DegToRad() )*getDetectorGeo()->getFocalLength()[tel] * 1000. );
-                y.push_back( tan( i_cen_y * TMath::DegToRad() )*getDetectorGeo()->getFocalLength()[tel] * 1000. );
+                x.push_back( fImageData.fX_mm[v][tel] );
+                y.push_back( fImageData.fY_mm[v][tel] );
             }
             // weight is size
-            w.push_back( getImageParameters( getRunParameter()->fImageLL )->size );
-            // calculate new 'phi' with pointing errors taken into account
-            i_phi = recalculateImagePhi( iPointingErrorX, iPointingErrorY );
-            if( cos( i_phi ) != 0. )
-            {
-                m.push_back( sin( i_phi ) / cos( i_phi ) );
-            }
-            else
-            {
-                m.push_back( 1.e9 );
-            }
-
-            phi.push_back( i_phi );
-            sinphi.push_back( sin( i_phi ) );
-            cosphi.push_back( cos( i_phi ) );
-            if( getImageParameters( getRunParameter()->fImageLL )->length > 0. )
-            {
-                l.push_back( getImageParameters( getRunParameter()->fImageLL )->width /
-                             getImageParameters( getRunParameter()->fImageLL )->length );
-            }
-            else
-            {
-                l.push_back( 1. );
-            }
-            length.push_back( getImageParameters( getRunParameter()->fImageLL )->length );
-            width.push_back( getImageParameters( getRunParameter()->fImageLL )->width );
-            loss.push_back( getImageParameters( getRunParameter()->fImageLL )->loss );
-            asym.push_back( getImageParameters( getRunParameter()->fImageLL )->asymmetry );
-            dist.push_back( getImageParameters( getRunParameter()->fImageLL )->dist );
-            pedvar.push_back( getImageParameters( getRunParameter()->fImageLL )->fmeanPedvar_Image );
-            tgrad.push_back( getImageParameters( getRunParameter()->fImageLL )->tgrad_x );
-            cen_x.push_back( getImageParameters( getRunParameter()->fImageLL )->cen_x );
-            cen_y.push_back( getImageParameters( getRunParameter()->fImageLL )->cen_y );
-            xcore.push_back( getShowerParameters()->fShowerXcore[0] );
-            ycore.push_back( getShowerParameters()->fShowerYcore[0] );
-            Xoff.push_back( getShowerParameters()->fShower_Xoffset[0] );
-            Yoff.push_back( getShowerParameters()->fShower_Xoffset[0] );
-            ltrig.push_back( getShowerParameters()->fLTrig );
-            ze.push_back( 90. - getShowerParameters()->fTelElevation[tel] );
-            az.push_back( getShowerParameters()->fTelAzimuth[tel] );
-            teltype.push_back( getDetectorGeometry()->getTelType()[tel] );
+            w.push_back( fImageData.fSize[tel] );
+            m.push_back( fImageData.fM[v][tel] );
+            l.push_back( fImageData.fWidthLength[tel] );
         }
     }
 }
@@ -1672,23 +1692,18 @@ void VArrayAnalyzer::prepareforDirectionReconstruction( unsigned int iMethodInde
 
 void VArrayAnalyzer::prepareforCoreReconstruction( unsigned int iMethodIndex, float xs, float ys )
 {
-    vector< float > xtel;                         /* arrays for telescope locations */
-    vector< float > ytel;
-    vector< float > ztel;
-    xtelnew.clear();
-    ytelnew.clear();
-    ztelnew.clear();
-    for( unsigned int tel = 0; tel < getNTel(); tel++ )
-    {
-        setTelID( tel );
-        xtel.push_back( getImageParameters( getRunParameter()->fImageLL )->Tel_x_SC );
-        xtelnew.push_back( 0. );
-        ytel.push_back( getImageParameters( getRunParameter()->fImageLL )->Tel_y_SC );
-        ytelnew.push_back( 0. );
-        ztel.push_back( getImageParameters( getRunParameter()->fImageLL )->Tel_z_SC );
-        ztelnew.push_back( 0. );
-    }
-    rcs_rotate_delta( xtel, ytel, ztel, xtelnew, ytelnew, ztelnew, xs / TMath::RadToDeg(), ys / TMath::RadToDeg(), getNTel() );
+    // rotate telescope positions
+    xtelnew.assign( getNTel(), 0. );
+    ytelnew.assign( getNTel(), 0. );
+    ztelnew.assign( getNTel(), 0. );
+    rcs_rotate_delta( fImageData.fTel_x_SC, fImageData.fTel_y_SC, fImageData.fTel_z_SC, xtelnew, ytelnew, ztelnew,
+                      xs / TMath::RadToDeg(), ys / TMath::RadToDeg(), getNTel() );
+
+    ///////////////////////////////
+    // account for differences in coordinate systems between grisudet and real data
+    // y coordinate is flipped in grisudet (pointing into the ground and not into the sky for stored position)
+    // this is fixed in grisudet from version 4.12 on
+    bool bFlipY = ( fReader->isGrisuMC() && getDetectorGeo()->getGrIsuVersion() < 412 );
 
     /* fill the x, y, w, and m arrays  */
     x.clear();
@@ -1697,29 +1712,19 @@ void VArrayAnalyzer::prepareforCoreReconstruction( unsigned int iMethodIndex, fl
     w.clear();
     float i_cen_x = 0.;
     float i_cen_y = 0.;
-    float i_weight = 0.;
     for( unsigned int tel = 0; tel < getNTel(); tel++ )
     {
-        setTelID( tel );
         if( getShowerParameters()->fTelIDImageSelected[iMethodIndex][tel] )
         {
             x.push_back( xtelnew[tel] );          /* telescope locations */
             y.push_back( ytelnew[tel] );
-            i_weight  = getImageParameters( getRunParameter()->fImageLL )->size;
-            i_weight *= ( 1. - getImageParameters( getRunParameter()->fImageLL )->width /
-                          getImageParameters( getRunParameter()->fImageLL )->length );
-            w.push_back( i_weight * i_weight );
-            i_cen_x = getImageParameters( getRunParameter()->fImageLL )->cen_x - xs;
-            i_cen_y = getImageParameters( getRunParameter()->fImageLL )->cen_y - ys;
-            ///////////////////////////////
-            // account for differences in coordinate systems between grisudet and real data
-            // y coordinate is flipped in grisudet (pointing into the ground and not into the sky for stored position)
-            // this is fixed in grisudet from version 4.12 on
-            if( ( fReader->isGrisuMC() ) && getDetectorGeo()->getGrIsuVersion() < 412 )
+            w.push_back( fImageData.fCoreWeight[tel] );
+            i_cen_x = fImageData.fCen_x[tel] - xs;
+            i_cen_y = fImageData.fCen_y[tel] - ys;
+            if( bFlipY )
             {
                 i_cen_y *= -1.;
             }
-            ///////////////////////////////
             m.push_back( -1.*i_cen_y / i_cen_x );
         }
     }
@@ -1761,6 +1766,35 @@ bool VArrayAnalyzer::fillSimulationEvent()
     return true;
 }
 
+/*
+
+   smallest distance of image and border pixels to a bright star [deg]
+
+   (star catalogue pointing must be set for this telescope)
+
+*/
+float VArrayAnalyzer::getDistanceToClosestStar( VImageParameter* iImage )
+{
+    float iDistance = 1.e10;
+    if( !iImage )
+    {
+        return iDistance;
+    }
+    for( unsigned int i = 0; i < iImage->fImageBorderPixelPosition_x.size(); i++ )
+    {
+        if( i < iImage->fImageBorderPixelPosition_y.size() )
+        {
+            float d = getStarCatalogue()->getDistanceToClosestStar( iImage->fImageBorderPixelPosition_x[i],
+                      iImage->fImageBorderPixelPosition_y[i] );
+            if( d < iDistance )
+            {
+                iDistance = d;
+            }
+        }
+    }
+    return iDistance;
+}
+
 /*
 
    pass telescope pointing to star catalogue for calculation of
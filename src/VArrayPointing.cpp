@@ -14,6 +14,8 @@ VArrayPointing::VArrayPointing( bool bInitTree )
 {
     setObservatory();
     reset();
+    // per-run pointing tables (fixed target and telescope coordinates)
+    setPointingTable( true );
 
     if( bInitTree )
     {
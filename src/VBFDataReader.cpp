@@ -19,6 +19,9 @@ VBFDataReader::VBFDataReader( string sourcefile, int isourcetype, unsigned int i
     fNIncompleteEvent.assign( iNTel, 0 );
     setDebug( iDebug );
     fPrintDetectorConfig = iPrintDetectorConfig;
+    fReadAheadEvents = 0;
+    fReadAheadStop = false;
+    fNReadErrorPrints = 0;
 }
 
 
@@ -28,6 +31,7 @@ VBFDataReader::~VBFDataReader()
     {
         cout << "VBFDataReader::~VBFDataReader()" << endl;
     }
+    stopReadAhead();
     if( pack != NULL )
     {
         delete pack;
@@ -35,6 +39,173 @@ VBFDataReader::~VBFDataReader()
 }
 
 
+/*
+ * read, decompress and unpack the next iNEvents packets in a separate thread
+ *
+ * (must be called before the first call of getNextEvent();
+ *  iNEvents = 0: no read ahead)
+ */
+void VBFDataReader::setReadAhead( unsigned int iNEvents )
+{
+    stopReadAhead();
+    fReadAheadEvents = iNEvents;
+    if( fReadAheadEvents > 0 )
+    {
+        fReadAheadStop = false;
+        fConfigMask = reader.getConfigMask();
+        fReadAheadThread = thread( &VBFDataReader::readAhead, this, index );
+    }
+}
+
+
+void VBFDataReader::stopReadAhead()
+{
+    if( fReadAheadThread.joinable() )
+    {
+        {
+            unique_lock< mutex > iLock( fReadAheadMutex );
+            fReadAheadStop = true;
+        }
+        fReadAheadCondition.notify_all();
+        fReadAheadThread.join();
+    }
+    for( unsigned int i = 0; i < fReadAheadBuffer.size(); i++ )
+    {
+        delete fReadAheadBuffer[i].fPacket;
+    }
+    fReadAheadBuffer.clear();
+}
+
+
+/*
+ * read packet iIndex and unpack array event and telescope events
+ *
+ * (called from read-ahead thread or, without read ahead, from getNextEvent())
+ */
+void VBFDataReader::readEvent( unsigned int iIndex, VBFReadAheadEvent& iE )
+{
+    iE.fPacket = 0;
+    iE.fIndex = iIndex;
+    iE.fEndOfFile = false;
+    iE.fSimulationHeader = false;
+    iE.fHasArrayEvent = false;
+    iE.fArrayEvent = 0;
+    iE.fArrayTrigger = 0;
+    if( !reader.hasPacket( iIndex ) )
+    {
+        iE.fEndOfFile = true;
+        return;
+    }
+    try
+    {
+        iE.fPacket = reader.readPacket( iIndex );
+        if( fReadAheadEvents > 0 )
+        {
+            iE.fConfigMask = reader.getConfigMask();
+        }
+    }
+    catch( const std::exception& e )
+    {
+        iE.fError = e.what();
+        return;
+    }
+    try
+    {
+        unpackPacket( iE );
+    }
+    catch( const std::exception& e )
+    {
+        iE.fUnpackError = e.what();
+    }
+}
+
+
+/*
+ * unpack array event, array trigger and telescope events from packet
+ * (does not change the state of the data reader)
+ */
+void VBFDataReader::unpackPacket( VBFReadAheadEvent& iE )
+{
+    iE.fSimulationHeader = iE.fPacket->hasSimulationHeader();
+    iE.fHasArrayEvent = iE.fPacket->hasArrayEvent();
+    if( iE.fHasArrayEvent )
+    {
+        iE.fArrayEvent = iE.fPacket->getArrayEvent();
+        if( iE.fArrayEvent )
+        {
+            for( unsigned int i = 0; i < iE.fArrayEvent->getNumEvents(); ++i )
+            {
+                iE.fEvents.push_back( iE.fArrayEvent->getEvent( i ) );
+            }
+            if( iE.fArrayEvent->hasTrigger() )
+            {
+                iE.fArrayTrigger = iE.fArrayEvent->getTrigger();
+            }
+        }
+    }
+}
+
+
+/*
+ * read-ahead thread: fill queue with decoded events
+ *
+ * this is the only place where the bank file reader is used
+ * while read ahead is active
+ */
+void VBFDataReader::readAhead( unsigned int iIndex )
+{
+    for( ;; )
+    {
+        VBFReadAheadEvent iE;
+        readEvent( iIndex, iE );
+
+        unique_lock< mutex > iLock( fReadAheadMutex );
+        while( !fReadAheadStop && fReadAheadBuffer.size() >= fReadAheadEvents )
+        {
+            fReadAheadCondition.wait( iLock );
+        }
+        if( fReadAheadStop )
+        {
+            delete iE.fPacket;
+            return;
+        }
+        fReadAheadBuffer.push_back( iE );
+        fReadAheadCondition.notify_all();
+        // end of file or read error: stop reading
+        if( iE.fEndOfFile || iE.fError.size() > 0 )
+        {
+            return;
+        }
+        iIndex++;
+    }
+}
+
+
+/*
+ * get next decoded event from read-ahead queue (wait if queue is empty)
+ */
+VBFReadAheadEvent VBFDataReader::getReadAheadEvent()
+{
+    unique_lock< mutex > iLock( fReadAheadMutex );
+    while( fReadAheadBuffer.size() == 0 )
+    {
+        fReadAheadCondition.wait( iLock );
+    }
+    VBFReadAheadEvent iE = fReadAheadBuffer.front();
+    // keep end of file / error marker for following calls
+    if( !iE.fEndOfFile && iE.fError.size() == 0 )
+    {
+        fReadAheadBuffer.pop_front();
+        fReadAheadCondition.notify_all();
+    }
+    else
+    {
+        fReadAheadBuffer.front().fPacket = 0;
+    }
+    return iE;
+}
+
+
 bool VBFDataReader::getNextEvent()
 {
     if( fDebug )
@@ -43,8 +214,6 @@ bool VBFDataReader::getNextEvent()
     }
     bool bSimulations = false;
 
-    unsigned int n_error_prints = 0;
-
     try
     {
         if( fDebug )
@@ -53,30 +222,46 @@ bool VBFDataReader::getNextEvent()
         }
         for( ;; )
         {
-            if( !reader.hasPacket( index ) )
+            // decoded event from read-ahead thread or from this thread
+            VBFReadAheadEvent iE;
+            if( fReadAheadEvents > 0 )
             {
-                setEventStatus( 999 );
-                return false;
+                iE = getReadAheadEvent();
             }
-            VPacket* old_pack = pack;
-            try
+            else
             {
-                pack = reader.readPacket( index );
+                readEvent( index, iE );
             }
-            catch( const std::exception& e )
+            if( iE.fEndOfFile )
+            {
+                setEventStatus( 999 );
+                return false;
+            }
+            if( iE.fError.size() > 0 )
             {
                 // corrupt files otherwise generated 100s of GB of log files
-                if( n_error_prints < 5000 )
+                if( fNReadErrorPrints < 5000 )
                 {
                     std::cout << "VBFDataReader::getNextEvent: exception while reading file: "
-                              << e.what() << std::endl;
+                              << iE.fError << std::endl;
                 }
-                pack = old_pack;
                 setEventStatus( 0 );
-                n_error_prints++;
+                fNReadErrorPrints++;
+                return false;
+            }
+            delete pack;
+            pack = iE.fPacket;
+            index = iE.fIndex;
+            if( fReadAheadEvents > 0 )
+            {
+                fConfigMask = iE.fConfigMask;
+            }
+            if( iE.fUnpackError.size() > 0 )
+            {
+                std::cout << "unexpected exception: " << iE.fUnpackError << std::endl;
+                setEventStatus( 999 );
                 return false;
             }
-            delete old_pack;
             if( fDebug )
             {
                 cout << "\t VBFRawDataReader::getNextEvent(): index " << index << endl;
@@ -85,7 +270,7 @@ bool VBFDataReader::getNextEvent()
             index++;
 
             // check if this is a simulation header
-            if( pack->hasSimulationHeader() )
+            if( iE.fSimulationHeader )
             {
                 printSimulationHeader( pack, fPrintDetectorConfig );
                 fMonteCarloHeader = fillSimulationHeader( pack );
@@ -109,9 +294,9 @@ bool VBFDataReader::getNextEvent()
             bool gotOneEv = false;
             fArrayTrigger = false;
 
-            if( pack->hasArrayEvent() )
+            if( iE.fHasArrayEvent )
             {
-                ae = pack->getArrayEvent();
+                ae = iE.fArrayEvent;
                 if( fDebug )
                 {
                     cout << "\t VBFRawDataReader::getNextEvent(): hasArrayEvent ";
@@ -170,9 +355,9 @@ bool VBFDataReader::getNextEvent()
                 }
                 if( ae )
                 {
-                    for( unsigned int i = 0; i < ae->getNumEvents(); ++i )
+                    for( unsigned int i = 0; i < iE.fEvents.size(); ++i )
                     {
-                        VEvent* ev = ae->getEvent( i );
+                        VEvent* ev = iE.fEvents[i];
                         fEvent[ev->getNodeNumber()] = ev;
                         gotOneEv = true;
                     }
@@ -186,14 +371,14 @@ bool VBFDataReader::getNextEvent()
                     return false;
                 }
 
-                if( ae->hasTrigger() )
+                if( iE.fArrayTrigger )
                 {
                     fArrayTrigger = true;
                     if( fDebug )
                     {
                         cout << "\t VBFRawDataReader::getNextEvent(): hasTrigger" << endl;
                     }
-                    at = ae->getTrigger();
+                    at = iE.fArrayTrigger;
                 }
                 else
                 {
@@ -245,11 +430,12 @@ bool VBFDataReader::getNextEvent()
 
 unsigned int VBFDataReader::getNTel()
 {
+    // read ahead: bank file reader is in use by the read-ahead thread
+    const vector< bool >& iConfigMask = ( fReadAheadEvents > 0 ? fConfigMask : reader.getConfigMask() );
     unsigned int z = 0;
-    unsigned int t = reader.getConfigMask().size();
-    for( unsigned int i = 0; i < t; i++ )
+    for( unsigned int i = 0; i < iConfigMask.size(); i++ )
     {
-        if( reader.getConfigMask()[i] )
+        if( iConfigMask[i] )
         {
             z++;
         }
@@ -8,6 +8,9 @@
 
 #include <VRawDataReader.h>
 
+thread_local unsigned int VBaseRawDataReader::fTelID = 0;
+thread_local uint32_t VBaseRawDataReader::fHitID = 0;
+
 VBaseRawDataReader::VBaseRawDataReader( string sourcefile, int isourcetype, unsigned int iNTel, bool iDebug )
 {
     fDebug = iDebug;
@@ -50,6 +53,9 @@ VBaseRawDataReader::VBaseRawDataReader( string sourcefile, int isourcetype, unsi
     {
         fEvent.push_back( 0 );
     }
+    fSums.resize( fNTel );
+    fTraceMax.resize( fNTel );
+    fTracePulseTiming.resize( fNTel );
 }
 
 
@@ -447,6 +453,38 @@ uint8_t VBaseRawDataReader::getSample( unsigned channel, unsigned sample, bool i
 }
 
 
+/*
+ * pointer to the FADC samples of this channel in the event buffer
+ *
+ * samples modified while reading (noise from noise library,
+ * gaussian noise, throughput correction) are not available
+ * (return 0, use getSample())
+ */
+const uint8_t* VBaseRawDataReader::getSamplePtr( unsigned channel, unsigned int& iNSamples )
+{
+    iNSamples = 0;
+    if( fNoiseFileReader || ( finjectGaussianNoise > 0. && fRandomInjectGaussianNoise )
+            || fTraceAmplitudeCorrectionS.size() > 0 )
+    {
+        return 0;
+    }
+    try
+    {
+        if( fEvent[fTelID] && fEvent[fTelID]->getNumSamples() > 0 )
+        {
+            const uint8_t* iPtr = fEvent[fTelID]->getSamplePtr( channel, 0 );
+            iNSamples = fEvent[fTelID]->getNumSamples();
+            return iPtr;
+        }
+    }
+    catch( ... )
+    {
+        iNSamples = 0;
+    }
+    return 0;
+}
+
+
 std::vector< uint8_t > VBaseRawDataReader::getSamplesVec()
 {
     // standard way
@@ -567,57 +605,67 @@ bool VBaseRawDataReader::hasFADCTrace()
 
 valarray< double >& VBaseRawDataReader::getSums( unsigned int iNChannel )
 {
-    if( iNChannel != 99999 && fSums.size() != iNChannel )
+    if( fTelID >= fSums.size() )
+    {
+        return v;
+    }
+    valarray< double >& iSums = fSums[fTelID];
+    if( iNChannel != 99999 && iSums.size() != iNChannel )
     {
-        fSums.resize( iNChannel );
+        iSums.resize( iNChannel );
     }
 
+    iSums = 0.;
     if( fTelID < fEvent.size() && fEvent[fTelID] )
     {
-        fSums = 0.;
         for( unsigned int i = 0; i < fEvent[fTelID]->getNumChannelsHit(); i++ )
         {
             unsigned int i_channelHitID = getHitID( i );
-            if( i_channelHitID < fSums.size() )
+            if( i_channelHitID < iSums.size() )
             {
-                fSums[i_channelHitID] = fEvent[fTelID]->getCharge( i );
+                iSums[i_channelHitID] = fEvent[fTelID]->getCharge( i );
             }
         }
     }
-    else
-    {
-        fSums = 0.;
-    }
-    return fSums;
+    return iSums;
 }
 
 valarray< double >& VBaseRawDataReader::getTraceMax( unsigned int iNChannel )
 {
-    if( iNChannel != 99999 && fTraceMax.size() != iNChannel )
+    if( fTelID >= fTraceMax.size() )
     {
-        fTraceMax.resize( iNChannel );
+        return v;
     }
-    fTraceMax = 0.;
+    if( iNChannel != 99999 && fTraceMax[fTelID].size() != iNChannel )
+    {
+        fTraceMax[fTelID].resize( iNChannel );
+    }
+    fTraceMax[fTelID] = 0.;
 
-    return fTraceMax;
+    return fTraceMax[fTelID];
 }
 
 vector< valarray< double > >& VBaseRawDataReader::getTracePulseTiming( unsigned int iNChannel )
 {
+    if( fTelID >= fTracePulseTiming.size() )
+    {
+        return vv;
+    }
+    vector< valarray< double > >& iTiming = fTracePulseTiming[fTelID];
     if( fTelID < fEvent.size() && fEvent[fTelID] )
     {
         // check only first entry (anyway a dummy vector)
-        if( fTracePulseTiming.size() == VDST_MAXTIMINGLEVELS && fTracePulseTiming[0].size() == iNChannel )
+        if( iTiming.size() == VDST_MAXTIMINGLEVELS && iTiming[0].size() == iNChannel )
         {
-            return fTracePulseTiming;
+            return iTiming;
         }
         valarray< double > iTemp( 0., iNChannel );
-        fTracePulseTiming.clear();
+        iTiming.clear();
         for( unsigned int t = 0; t < VDST_MAXTIMINGLEVELS; t++ )
         {
-            fTracePulseTiming.push_back( iTemp );
+            iTiming.push_back( iTemp );
         }
     }
-    return fTracePulseTiming;
+    return iTiming;
 
 }
@@ -1071,3 +1071,203 @@ double VCalibrationData::getTelescopeAverageFADCtoPhe( bool iLowGain )
     }
     return 0.;
 }
+
+/*
+ *  write all calibration values (and distributions of calibration values)
+ *  into a binary cache file
+ *
+ *  (layout has to agree with readCalibrationCache; increase
+ *   VCalibrationCache::fVersion after any change)
+ */
+void VCalibrationData::writeCalibrationCache( ostream& os )
+{
+    VCalibrationCache::write( os, fChannelStatus );
+    // pedestals
+    VCalibrationCache::write( os, fTS_MJD );
+    VCalibrationCache::write( os, fTS_time );
+    VCalibrationCache::write( os, fPeds );
+    VCalibrationCache::write( os, fTS_Peds );
+    VCalibrationCache::write( os, fVPedvars );
+    VCalibrationCache::write( os, fTS_fVPedvars );
+    VCalibrationCache::write( os, fTS_fVmeanPedvars );
+    VCalibrationCache::write( os, fTS_fVmeanRMSPedvars );
+    VCalibrationCache::write( os, fPedrms );
+    VCalibrationCache::write( os, fVmeanPedvars );
+    VCalibrationCache::write( os, fVmeanRMSPedvars );
+    VCalibrationCache::write( os, fLowGainPeds );
+    VCalibrationCache::write( os, fLowGainTS_Peds );
+    VCalibrationCache::write( os, fVLowGainPedvars );
+    VCalibrationCache::write( os, fLowGainTS_fVPedvars );
+    VCalibrationCache::write( os, fLowGainTS_fVmeanPedvars );
+    VCalibrationCache::write( os, fLowGainTS_fVmeanRMSPedvars );
+    VCalibrationCache::write( os, fBoolLowGainPedestals );
+    VCalibrationCache::write( os, fLowGainPedestalFile );
+    VCalibrationCache::write( os, fLowGainPedsrms );
+    VCalibrationCache::write( os, fmeanLowGainPedvars );
+    VCalibrationCache::write( os, fmeanRMSLowGainPedvars );
+    VCalibrationCache::write( os, fVmeanLowGainPedvars );
+    VCalibrationCache::write( os, fVmeanRMSLowGainPedvars );
+    // gains, time offsets, average tzeros
+    VCalibrationCache::write( os, fFADCStopOffsets );
+    VCalibrationCache::write( os, fTOffsets );
+    VCalibrationCache::write( os, fTOffsetvars );
+    VCalibrationCache::write( os, fGains );
+    VCalibrationCache::write( os, fGains_DefaultSetting );
+    VCalibrationCache::write( os, fGainvars );
+    VCalibrationCache::write( os, fAverageTzero );
+    VCalibrationCache::write( os, fAverageTzerovars );
+    VCalibrationCache::write( os, fAverageTZero_highgain );
+    VCalibrationCache::write( os, fAverageTZero_lowgain );
+    VCalibrationCache::write( os, fBoolLowGainTOff );
+    VCalibrationCache::write( os, fLowGainTOffsets );
+    VCalibrationCache::write( os, fLowGainTOffsetvars );
+    VCalibrationCache::write( os, fLowGainAverageTzero );
+    VCalibrationCache::write( os, fLowGainAverageTzerovars );
+    VCalibrationCache::write( os, fBoolLowGainGains );
+    VCalibrationCache::write( os, fLowGainGains );
+    VCalibrationCache::write( os, fLowGainGains_DefaultSetting );
+    VCalibrationCache::write( os, fLowGainGainvars );
+    VCalibrationCache::write( os, fFADCtoPhe );
+    VCalibrationCache::write( os, fLowGainFADCtoPhe );
+    // low gain multipliers
+    VCalibrationCache::write( os, fLowGainMultiplier_Trace );
+    VCalibrationCache::write( os, fLowGainMultiplier_Sum );
+    VCalibrationCache::write( os, fLowGainMultiplier_Camera );
+    VCalibrationCache::write( os, fLowGainDefaultSumWindows );
+    // distributions of calibration values (bin contents incl. under/overflow)
+    vector< TH1F* > iH( fHisto_mean );
+    iH.insert( iH.end(), fHisto_variance.begin(), fHisto_variance.end() );
+    unsigned int n = iH.size();
+    VCalibrationCache::write( os, n );
+    for( unsigned int i = 0; i < iH.size(); i++ )
+    {
+        vector< float > iC;
+        double iEntries = 0.;
+        if( iH[i] )
+        {
+            iC.assign( iH[i]->GetArray(), iH[i]->GetArray() + iH[i]->GetNcells() );
+            iEntries = iH[i]->GetEntries();
+        }
+        VCalibrationCache::write( os, iC );
+        VCalibrationCache::write( os, iEntries );
+    }
+}
+
+/*
+ *  read calibration values from a binary cache file
+ *  (see writeCalibrationCache)
+ *
+ *  returns false for incomplete or inconsistent cache files;
+ *  calibration values are unchanged in this case
+ */
+bool VCalibrationData::readCalibrationCache( istream& is )
+{
+    // read into a copy (histograms are filled only after all values are read)
+    VCalibrationData iCalData( *this );
+    if( !iCalData.readCalibrationCacheValues( is ) )
+    {
+        return false;
+    }
+    *this = iCalData;
+    return true;
+}
+
+bool VCalibrationData::readCalibrationCacheValues( istream& is )
+{
+    // expected array lengths (set in initialize())
+    const unsigned int nc = fPeds.size();                   // channels
+    const unsigned int nw = fVPedvars.size();               // summation windows
+    const unsigned int nt = VCalibrationCache::fMaxTimeSlices;
+
+    VCalibrationCache::read( is, fChannelStatus, nc );
+    // pedestals
+    VCalibrationCache::read( is, fTS_MJD, nt );
+    VCalibrationCache::read( is, fTS_time, nt );
+    VCalibrationCache::read( is, fPeds, nc );
+    VCalibrationCache::read( is, fTS_Peds, nt, nc );
+    VCalibrationCache::read( is, fVPedvars, nw, nc );
+    VCalibrationCache::read( is, fTS_fVPedvars, nt, nw, nc );
+    VCalibrationCache::read( is, fTS_fVmeanPedvars, nt, nw );
+    VCalibrationCache::read( is, fTS_fVmeanRMSPedvars, nt, nw );
+    VCalibrationCache::read( is, fPedrms, nc );
+    VCalibrationCache::read( is, fVmeanPedvars, nw );
+    VCalibrationCache::read( is, fVmeanRMSPedvars, nw );
+    VCalibrationCache::read( is, fLowGainPeds, nc );
+    VCalibrationCache::read( is, fLowGainTS_Peds, nt, nc );
+    VCalibrationCache::read( is, fVLowGainPedvars, nw, nc );
+    VCalibrationCache::read( is, fLowGainTS_fVPedvars, nt, nw, nc );
+    VCalibrationCache::read( is, fLowGainTS_fVmeanPedvars, nt, nw );
+    VCalibrationCache::read( is, fLowGainTS_fVmeanRMSPedvars, nt, nw );
+    VCalibrationCache::read( is, fBoolLowGainPedestals );
+    VCalibrationCache::read( is, fLowGainPedestalFile, 10000 );
+    VCalibrationCache::read( is, fLowGainPedsrms, nc );
+    VCalibrationCache::read( is, fmeanLowGainPedvars );
+    VCalibrationCache::read( is, fmeanRMSLowGainPedvars );
+    VCalibrationCache::read( is, fVmeanLowGainPedvars, nw );
+    VCalibrationCache::read( is, fVmeanRMSLowGainPedvars, nw );
+    // gains, time offsets, average tzeros
+    VCalibrationCache::read( is, fFADCStopOffsets, nc );
+    VCalibrationCache::read( is, fTOffsets, nc );
+    VCalibrationCache::read( is, fTOffsetvars, nc );
+    VCalibrationCache::read( is, fGains, nc );
+    VCalibrationCache::read( is, fGains_DefaultSetting, nc );
+    VCalibrationCache::read( is, fGainvars, nc );
+    VCalibrationCache::read( is, fAverageTzero, nc );
+    VCalibrationCache::read( is, fAverageTzerovars, nc );
+    VCalibrationCache::read( is, fAverageTZero_highgain );
+    VCalibrationCache::read( is, fAverageTZero_lowgain );
+    VCalibrationCache::read( is, fBoolLowGainTOff );
+    VCalibrationCache::read( is, fLowGainTOffsets, nc );
+    VCalibrationCache::read( is, fLowGainTOffsetvars, nc );
+    VCalibrationCache::read( is, fLowGainAverageTzero, nc );
+    VCalibrationCache::read( is, fLowGainAverageTzerovars, nc );
+    VCalibrationCache::read( is, fBoolLowGainGains );
+    VCalibrationCache::read( is, fLowGainGains, nc );
+    VCalibrationCache::read( is, fLowGainGains_DefaultSetting, nc );
+    VCalibrationCache::read( is, fLowGainGainvars, nc );
+    VCalibrationCache::read( is, fFADCtoPhe, nc );
+    VCalibrationCache::read( is, fLowGainFADCtoPhe, nc );
+    // low gain multipliers
+    VCalibrationCache::read( is, fLowGainMultiplier_Trace );
+    VCalibrationCache::read( is, fLowGainMultiplier_Sum, 2 * nw * nw );
+    VCalibrationCache::read( is, fLowGainMultiplier_Camera, nc );
+    VCalibrationCache::read( is, fLowGainDefaultSumWindows, nw );
+    // distributions of calibration values
+    vector< TH1F* > iH( fHisto_mean );
+    iH.insert( iH.end(), fHisto_variance.begin(), fHisto_variance.end() );
+    unsigned int n = 0;
+    VCalibrationCache::read( is, n );
+    if( !is.good() || n != iH.size() )
+    {
+        return false;
+    }
+    vector< vector< float > > iC( iH.size() );
+    vector< double > iEntries( iH.size(), 0. );
+    for( unsigned int i = 0; i < iH.size(); i++ )
+    {
+        VCalibrationCache::read( is, iC[i], ( iH[i] ? iH[i]->GetNcells() : 0 ) );
+        VCalibrationCache::read( is, iEntries[i] );
+        if( !is.good() )
+        {
+            return false;
+        }
+    }
+    for( unsigned int i = 0; i < iH.size(); i++ )
+    {
+        if( iH[i] && ( int )iC[i].size() == iH[i]->GetNcells() )
+        {
+            iH[i]->Reset();
+            for( unsigned int b = 0; b < iC[i].size(); b++ )
+            {
+                iH[i]->SetBinContent( b, iC[i][b] );
+            }
+            iH[i]->SetEntries( iEntries[i] );
+        }
+    }
+    // reset buffers for time dependent pedestals
+    fTS_ped_temp_time = 0.;
+    fTS_pedvar_temp.clear();
+    fTS_pedvar_temp_time.clear();
+
+    return true;
+}
@@ -720,14 +720,20 @@ bool VCalibrator::fillPedestalTree( unsigned int tel, VPedestalCalculator* iPede
     }
 
     ////////////////////////////////////////////////////////////////////////////////
-    // tree filling
+    // mean, rms, median pedestal and 68% containment for all summation windows and channels
+    // (calculated in parallel)
+    vector< TH1F* > iH;
+    vector< unsigned int > iH_offset;
+    for( unsigned int j = 0; j < hped_vec[iTelType].size(); j++ )
+    {
+        iH_offset.push_back( iH.size() );
+        iH.insert( iH.end(), hped_vec[iTelType][j].begin(), hped_vec[iTelType][j].end() );
+    }
+    vector< VCalibrationHistoStatistics > iStat = getHistogramStatistics( iH );
+    unsigned int iSW_cal = ( fRunPar->fCalibrationSumWindow > 0 ? fRunPar->fCalibrationSumWindow - 1 : 0 );
 
-    // median pedestal and 68% containment
-    Double_t xq[3];
-    Double_t yq[3];
-    xq[0] = 0.16;
-    xq[1] = 0.5;
-    xq[2] = 0.84;
+    ////////////////////////////////////////////////////////////////////////////////
+    // tree filling
 
     // loop over all channels
     for( unsigned int i = 0; i < hped_vec[iTelType][0].size(); i++ )
@@ -735,33 +741,29 @@ bool VCalibrator::fillPedestalTree( unsigned int tel, VPedestalCalculator* iPede
         ichannel = ( Int_t )i;
 
         // get pedestal and pedestal variances from pedestal histograms
-        if( fRunPar->fCalibrationSumWindow > 0
-                && hped_vec[iTelType][fRunPar->fCalibrationSumWindow - 1][i]->GetEntries() > 10
-                && hped_vec[iTelType][fRunPar->fCalibrationSumWindow - 1][i]->Integral(
-                    1, hped_vec[iTelType][fRunPar->fCalibrationSumWindow - 1][i]->GetNbinsX() ) > 0. )
+        const VCalibrationHistoStatistics& iS = iStat[iH_offset[iSW_cal] + i];
+        if( fRunPar->fCalibrationSumWindow > 0 && iS.fEntries > 10 && iS.fIntegral > 0. )
         {
-            iped = hped_vec[iTelType][fRunPar->fCalibrationSumWindow - 1][i]->GetMean() / ( double )fRunPar->fCalibrationSumWindow;
-            hped_vec[iTelType][fRunPar->fCalibrationSumWindow - 1][i]->GetQuantiles( 3, yq, xq );
-            ipedmedian = yq[1] / ( double )fRunPar->fCalibrationSumWindow;
+            iped = iS.fMean / ( double )fRunPar->fCalibrationSumWindow;
+            ipedmedian = iS.fQuantile[1] / ( double )fRunPar->fCalibrationSumWindow;
         }
         else
         {
             iped = 0.;
             ipedmedian = 0.;
         }
-        inevents = ( Int_t )hped_vec[iTelType][fRunPar->fCalibrationSumWindow - 1][i]->GetEntries();
+        inevents = ( Int_t )iS.fEntries;
 
         // loop over all summation window sizes
         insumw = ( UInt_t )hped_vec[iTelType].size();
         for( unsigned int j = 0; j < hped_vec[iTelType].size(); j++ )
         {
             isumw[j] = ( Float_t )j + 1;
-            if( hped_vec[iTelType][j][i]->GetEntries() > 10
-                    && hped_vec[iTelType][j][i]->Integral( 1, hped_vec[iTelType][j][i]->GetNbinsX() ) > 0. )
+            const VCalibrationHistoStatistics& iSW = iStat[iH_offset[j] + i];
+            if( iSW.fEntries > 10 && iSW.fIntegral > 0. )
             {
-                ipedv[j] = hped_vec[iTelType][j][i]->GetRMS();
-                hped_vec[iTelType][j][i]->GetQuantiles( 3, yq, xq );
-                ipedv68[j] = ( yq[2] - yq[0] ) / 2.;
+                ipedv[j] = iSW.fRMS;
+                ipedv68[j] = ( iSW.fQuantile[2] - iSW.fQuantile[0] ) / 2.;
             }
             else
             {
@@ -1512,17 +1514,16 @@ TTree* VCalibrator::fillCalibrationSummaryTree( unsigned int itel, string iName,
     sprintf( ititle, "%svar/F", iName.c_str() );
     t->Branch( iname, &i_rms, ititle );
 
-    double i_a[] = { 0.5 };
-    double i_b[] = { 0.0 };
+    // histogram statistics (calculated in parallel)
+    vector< VCalibrationHistoStatistics > iStat = getHistogramStatistics( h );
     for( unsigned int i = 0; i < getNChannels(); i++ )
     {
         ichannel = ( int )i;
-        if( i < h.size() && h[i] && h[i]->GetEntries() > 0 )
+        if( i < iStat.size() && iStat[i].fEntries > 0 )
         {
-            i_mean = h[i]->GetMean();
-            i_rms  = h[i]->GetRMS();
-            h[i]->GetQuantiles( 1, i_b, i_a );
-            i_median = i_b[0];
+            i_mean = iStat[i].fMean;
+            i_rms  = iStat[i].fRMS;
+            i_median = iStat[i].fQuantile[1];
         }
         else
         {
@@ -1536,6 +1537,48 @@ TTree* VCalibrator::fillCalibrationSummaryTree( unsigned int itel, string iName,
     return t;
 }
 
+/*
+
+   entries, mean, rms, median and 68% containment of a list of histograms
+
+   histograms are processed in parallel (number of threads given by -nthreads);
+   results are returned in the order of the input histograms
+
+*/
+vector< VCalibrationHistoStatistics > VCalibrator::getHistogramStatistics( const vector< TH1F* >& h )
+{
+    vector< VCalibrationHistoStatistics > iStat( h.size() );
+
+    if( fRunPar->fNThreads > 1 )
+    {
+        ROOT::EnableThreadSafety();
+    }
+    VThreadPool iPool( fRunPar->fNThreads );
+    // blocks of histograms per task
+    const unsigned int iBlock = 64;
+    iPool.run( ( h.size() + iBlock - 1 ) / iBlock, [&h, &iStat, iBlock]( unsigned int b )
+    {
+        double xq[] = { 0.16, 0.5, 0.84 };
+        for( unsigned int i = b * iBlock; i < h.size() && i < ( b + 1 ) * iBlock; i++ )
+        {
+            if( !h[i] )
+            {
+                continue;
+            }
+            iStat[i].fEntries = h[i]->GetEntries();
+            iStat[i].fIntegral = h[i]->Integral( 1, h[i]->GetNbinsX() );
+            iStat[i].fMean = h[i]->GetMean();
+            iStat[i].fRMS = h[i]->GetRMS();
+            if( iStat[i].fEntries > 0. && iStat[i].fIntegral > 0. )
+            {
+                h[i]->GetQuantiles( 3, iStat[i].fQuantile, xq );
+            }
+        }
+    } );
+
+    return iStat;
+}
+
 
 void VCalibrator::writeTOffsets( bool iLowGain )
 {
@@ -1626,6 +1669,13 @@ void VCalibrator::readCalibrationData()
     {
         setTelID( getTeltoAna()[i] );
 
+        // calibration data unchanged since last run: read binary snapshot
+        if( readCalibrationCache() )
+        {
+            setCalibrated();
+            continue;
+        }
+
         // read high gain gains
         if( getRunParameter()->frunmode != 2 && getRunParameter()->frunmode != 5 )
         {
@@ -1755,6 +1805,8 @@ void VCalibrator::readCalibrationData()
             getCalibrationData()->recoverLowGainPedestals();
         }
         setCalibrated();
+
+        writeCalibrationCache();
     }                                             // end loop over all telescopes
 
 }
@@ -2424,7 +2476,8 @@ bool VCalibrator::readPeds( string i_pedfile, bool iLowGain, unsigned int i_SumW
     // getting pedestals directly from MC (grisu) file
     ////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////
-    else if( fReader->getDataFormat() == "grisu" || ( getRunParameter()->fsourcetype == 2 && getRunParameter()->fsimu_pedestalfile.size() > 0 ) )
+    else if( fReader->getDataFormat() == "grisu" || fReader->getDataFormat() == "synthetic"
+             || ( getRunParameter()->fsourcetype == 2 && getRunParameter()->fsimu_pedestalfile.size() > 0 ) )
     {
         readPeds_from_grisufile( iLowGain, i_SumWindow );
     }
@@ -3123,7 +3176,7 @@ void VCalibrator::initialize()
         fNumberTZeroEvents.push_back( 0 );
 
         fCalData.back()->initialize( getNChannels(), getNSamples(), usePedestalsInTimeSlices( false ), usePedestalsInTimeSlices( true ),
-                                     ( fReader->getDataFormat() == "grisu"
+                                     ( fReader->getDataFormat() == "grisu" || fReader->getDataFormat() == "synthetic"
                                        ||  getRunParameter()->frunmode == 1 || getRunParameter()->frunmode == 6
                                        || ( getRunParameter()->fsourcetype == 2 && getRunParameter()->fsimu_pedestalfile.size() > 0 ) ),
                                      getRunParameter()->freadCalibfromDB,
@@ -3394,8 +3447,9 @@ void VCalibrator::getCalibrationRunNumbers()
         }
     }
 
-    // take pedestals from grisu output file ('P'-lines), gains=1, and toff = 0.
-    if( iCaliLines == 0 && ( fReader->getDataFormat() == "grisu" || getRunParameter()->fsimu_pedestalfile.size() > 0 ) )
+    // take pedestals from grisu output file ('P'-lines) or from the synthetic event generator, gains=1, and toff = 0.
+    if( iCaliLines == 0 && ( fReader->getDataFormat() == "grisu" || fReader->getDataFormat() == "synthetic"
+                             || getRunParameter()->fsimu_pedestalfile.size() > 0 ) )
     {
         cout << "VCalibrator::getCalibrationRunNumbers() info: taking calibration from grisu files" << endl;
         return;
@@ -4782,12 +4836,18 @@ bool VCalibrator::calculateIPRGraphs( string iPedFileName, unsigned int iSummati
                       * getRunParameter()->fImageCleaningParameters[i_tel]->fNNOpt_nBinsADC );
     }
 
+    // counts above threshold (cumulative sum from the last bin)
+    vector< double > iIntegralAbove( hIPR->GetNbinsX() + 2, 0. );
+    for( int i = hIPR->GetNbinsX(); i >= 1; i-- )
+    {
+        iIntegralAbove[i] = iIntegralAbove[i + 1] + hIPR->GetBinContent( i );
+    }
     for( int i = 1; i <= hIPR->GetNbinsX(); i++ )
     {
         if( hIPR->GetBinContent( i ) > 5 )
         {
-            double val = convToHz * hIPR->Integral( i, hIPR->GetNbinsX() ) / norm;
-            double valerr = convToHz * sqrt( hIPR->Integral( i, hIPR->GetNbinsX() ) ) / norm;
+            double val = convToHz * iIntegralAbove[i] / norm;
+            double valerr = convToHz * sqrt( iIntegralAbove[i] ) / norm;
             double charge_pe = hIPR->GetXaxis()->GetBinCenter( i ) * getTelescopeAverageFADCtoPhe();
             double charge_pe_bin_width = 0.5 * hIPR->GetXaxis()->GetBinWidth( i ) * getTelescopeAverageFADCtoPhe();
 
@@ -5061,3 +5121,150 @@ bool VCalibrator::readIPRGraph_from_DSTFile( string iDSTFile, unsigned int iSumm
 
     return true;
 }
+
+/*
+ * key and file name of the binary calibration cache for the current telescope
+ *
+ * the key contains all calibration file names (with size and modification time)
+ * and all parameters which change the calibration values read by readCalibrationData()
+ *
+ * returns an empty string if no cache should be used
+ */
+string VCalibrator::getCalibrationCacheFileName( VCalibrationCache& iCache )
+{
+    if( getRunParameter()->fCalibrationCacheDirectory.size() == 0
+            || getTelID() >= fPedFileNameC.size()
+            || fPedFileNameC[getTelID()].size() == 0
+            || getRunParameter()->fsimu_pedestalfile.size() > 0 )
+    {
+        return "";
+    }
+    unsigned int t = getTelID();
+
+    iCache.addParameter( "tel", t );
+    // run number: FADC module swap, closest runs and run ranges
+    // (see readPeds_from_combinedfile() and readLowGainCalibrationValues_fromCalibFile())
+    iCache.addParameter( "run", getRunParameter()->frunnumber );
+    iCache.addParameter( "isMC", getRunParameter()->fIsMC );
+    if( t < getRunParameter()->fGainCorrection.size() )
+    {
+        iCache.addParameter( "gainCorrection", getRunParameter()->fGainCorrection[t] );
+    }
+    iCache.addParameter( "nchannels", getNChannels() );
+    iCache.addParameter( "nsamples", getNSamples() );
+    iCache.addParameter( "runmode", getRunParameter()->frunmode );
+    iCache.addParameter( "sumwindow", getSumWindow() );
+    iCache.addParameter( "sumwindow2", getSumWindow_2() );
+    iCache.addParameter( "tzeromethod", getSumWindowStart_T_method() );
+    iCache.addParameter( "tzeroradius", getRunParameter()->faverageTZeroFiducialRadius );
+    iCache.addParameter( "pedsTS", getRunParameter()->fUsePedestalsInTimeSlices );
+    iCache.addParameter( "pedsTSLow", getRunParameter()->fLowGainUsePedestalsInTimeSlices );
+    iCache.addParameter( "simuLowGainPed", getRunParameter()->fsimu_lowgain_pedestal_DefaultPed );
+    iCache.addParameter( "combineChannels", getRunParameter()->fCombineChannelsForPedestalCalculation );
+    iCache.addParameter( "useDB", getRunParameter()->fuseDB );
+    iCache.addParameter( "calibDB", getRunParameter()->freadCalibfromDB );
+    iCache.addParameter( "calibDBversion", getRunParameter()->freadCalibfromDB_versionquery );
+    iCache.addParameter( "DBRunType", getRunParameter()->fDBRunType );
+    iCache.addParameter( "noCalibNoPb", getRunParameter()->fNoCalibNoPb );
+    iCache.addParameter( "nextDayGainHack", getRunParameter()->fNextDayGainHack );
+    if( getDetectorGeometry()->isLowGainSet() && t < getDetectorGeometry()->getLowGainMultiplier_Trace().size() )
+    {
+        iCache.addParameter( "lowGainMultCfg", getDetectorGeometry()->getLowGainMultiplier_Trace()[t] );
+    }
+
+    iCache.addFile( "ped", fPedFileNameC[t] );
+    iCache.addFile( "gain", t < fGainFileNameC.size() ? fGainFileNameC[t] : "" );
+    iCache.addFile( "toff", t < fToffFileNameC.size() ? fToffFileNameC[t] : "" );
+    iCache.addFile( "pix", t < fPixFileNameC.size() ? fPixFileNameC[t] : "" );
+    iCache.addFile( "tzero", t < fTZeroFileNameC.size() ? fTZeroFileNameC[t] : "" );
+    iCache.addFile( "pedLow", t < fLowGainPedFileNameC.size() ? fLowGainPedFileNameC[t] : "" );
+    iCache.addFile( "pedLowNew", t < fNewLowGainPedFileNameC.size() ? fNewLowGainPedFileNameC[t] : "" );
+    iCache.addFile( "gainLow", t < fLowGainGainFileNameC.size() ? fLowGainGainFileNameC[t] : "" );
+    iCache.addFile( "toffLow", t < fLowGainToffFileNameC.size() ? fLowGainToffFileNameC[t] : "" );
+    iCache.addFile( "tzeroLow", t < fLowGainTZeroFileNameC.size() ? fLowGainTZeroFileNameC[t] : "" );
+    if( getRunParameter()->fLowGainCalibrationFile.size() > 0 )
+    {
+        // same search path as in readLowGainCalibrationValues_fromCalibFile()
+        iCache.addFile( "lowGainCalib", fRunPar->getDirectory_EVNDISPCalibrationData() + getRunParameter()->fLowGainCalibrationFile );
+        iCache.addFile( "lowGainCalibAux", fRunPar->getDirectory_EVNDISPAnaData() + "/Calibration/" + getRunParameter()->fLowGainCalibrationFile );
+    }
+
+    int iRun = ( t < getRunParameter()->fPedFileNumber.size() ? getRunParameter()->fPedFileNumber[t] : 0 );
+    return iCache.getFileName( getRunParameter()->fCalibrationCacheDirectory, t, iRun, getSumWindow(), getSumWindow_2() );
+}
+
+/*
+ * read calibration data of the current telescope from the binary calibration cache
+ *
+ * returns false if no valid cache file exists (calibration data has to be
+ * read from the original sources)
+ */
+bool VCalibrator::readCalibrationCache()
+{
+    VCalibrationCache iCache;
+    string iFile = getCalibrationCacheFileName( iCache );
+    if( iFile.size() == 0 )
+    {
+        return false;
+    }
+    ifstream is( iFile.c_str(), ios::in | ios::binary );
+    if( !is || !iCache.readHeader( is ) )
+    {
+        return false;
+    }
+    if( !getCalData()->readCalibrationCache( is ) )
+    {
+        // (cache files are written into temporary files first; this should never happen)
+        cout << "VCalibrator::readCalibrationCache warning: incomplete or inconsistent calibration cache file " << iFile << endl;
+        cout << "\t reading calibration data from original files (cache file is rewritten)" << endl;
+        return false;
+    }
+    cout << "Telescope " << getTelID() + 1 << ": ";
+    cout << "reading calibration data from cache " << iFile << endl;
+
+    // low gain multiplier from calibration file is also used by the detector geometry
+    // (see readLowGainMultiplier())
+    if( getRunParameter()->fLowGainCalibrationFile.size() > 0 && getRunParameter()->frunmode != 6 )
+    {
+        getDetectorGeometry()->setLowGainMultiplier_Trace( getTelID(), getCalData()->getLowGainMultiplier_Trace() );
+    }
+    return true;
+}
+
+/*
+ * write calibration data of the current telescope into the binary calibration cache
+ *
+ * (written into a temporary file first, so that parallel jobs never read
+ *  incomplete cache files)
+ */
+bool VCalibrator::writeCalibrationCache()
+{
+    VCalibrationCache iCache;
+    string iFile = getCalibrationCacheFileName( iCache );
+    if( iFile.size() == 0 )
+    {
+        return false;
+    }
+    ostringstream iTempFile;
+    iTempFile << iFile << ".tmp" << getpid();
+    ofstream os( iTempFile.str().c_str(), ios::out | ios::binary );
+    if( !os )
+    {
+        cout << "VCalibrator::writeCalibrationCache warning: cannot write calibration cache file ";
+        cout << iTempFile.str() << endl;
+        return false;
+    }
+    iCache.writeHeader( os );
+    getCalData()->writeCalibrationCache( os );
+    os.close();
+    if( os.fail() || rename( iTempFile.str().c_str(), iFile.c_str() ) != 0 )
+    {
+        cout << "VCalibrator::writeCalibrationCache warning: error writing calibration cache file ";
+        cout << iFile << endl;
+        remove( iTempFile.str().c_str() );
+        return false;
+    }
+    cout << "Telescope " << getTelID() + 1 << ": ";
+    cout << "calibration data written to cache " << iFile << endl;
+    return true;
+}
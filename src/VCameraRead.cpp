@@ -10,6 +10,8 @@
 
 #include "VCameraRead.h"
 
+thread_local unsigned int VCameraRead::fTelID = 0;
+
 VCameraRead::VCameraRead()
 {
     fDebug = false;
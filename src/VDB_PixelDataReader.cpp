@@ -405,16 +405,15 @@ bool VDB_PixelDataReader::writeDataTree( unsigned int iTel )
  */
 TH1F* VDB_PixelDataReader::getDataHistogram( unsigned int iDataType, unsigned int iTel, int iMJD, float iTime )
 {
-    // fills fDummyReturnVector with data
-    getDataVector( iDataType, iTel, iMJD, iTime );
-    if( fDummyReturnVector.size() == 0 )
+    vector< float > i_dataVector = getDataVector( iDataType, iTel, iMJD, iTime );
+    if( i_dataVector.size() == 0 )
     {
         return 0;
     }
 
     // get min/maximum
-    float v_min = *std::min_element( fDummyReturnVector.begin(), fDummyReturnVector.end() );
-    float v_max = *std::max_element( fDummyReturnVector.begin(), fDummyReturnVector.end() );
+    float v_min = *std::min_element( i_dataVector.begin(), i_dataVector.end() );
+    float v_max = *std::max_element( i_dataVector.begin(), i_dataVector.end() );
     // make sure that min/max give a valid histogram
     if( v_min < 0. )
     {
@@ -428,9 +427,9 @@ TH1F* VDB_PixelDataReader::getDataHistogram( unsigned int iDataType, unsigned in
     {
         fPixelData_histogram[iDataType][iTel]->Reset();
         fPixelData_histogram[iDataType][iTel]->SetBins( fPixelData_histogram[iDataType][iTel]->GetNbinsX(), 0., v_max );
-        for( unsigned int i = 0; i < fDummyReturnVector.size(); i++ )
+        for( unsigned int i = 0; i < i_dataVector.size(); i++ )
         {
-            fPixelData_histogram[iDataType][iTel]->Fill( fDummyReturnVector[i] );
+            fPixelData_histogram[iDataType][iTel]->Fill( i_dataVector[i] );
         }
         return fPixelData_histogram[iDataType][iTel];
     }
@@ -445,16 +444,15 @@ TH1F* VDB_PixelDataReader::getDataHistogram( unsigned int iDataType, unsigned in
  */
 float VDB_PixelDataReader::getValue( unsigned int iDataType, unsigned int iTel, unsigned int iChannel, int iMJD, float iTime )
 {
-    // fills fDummyReturnVector with data
-    getDataVector( iDataType, iTel, iMJD, iTime );
-    if( fDummyReturnVector.size() == 0 )
+    vector< float > i_dataVector = getDataVector( iDataType, iTel, iMJD, iTime );
+    if( i_dataVector.size() == 0 )
     {
         return 0;
     }
 
-    if( iChannel < fDummyReturnVector.size() )
+    if( iChannel < i_dataVector.size() )
     {
-        return fDummyReturnVector[iChannel];
+        return i_dataVector[iChannel];
     }
 
     return 0.;
@@ -472,7 +470,7 @@ float VDB_PixelDataReader::getValue( unsigned int iDataType, unsigned int iTel,
  */
 vector< float > VDB_PixelDataReader::getDataVector( unsigned int iDataType, unsigned int iTel, int iMJD, float iTime )
 {
-    fDummyReturnVector.clear();
+    vector< float > i_dataVector;
     // is this a good data type ID?
     if( iDataType < fPixelData.size() )
     {
@@ -480,7 +478,7 @@ vector< float > VDB_PixelDataReader::getDataVector( unsigned int iDataType, unsi
         if( iTel < fPixelData[iDataType].size() )
         {
             // reset return vector
-            fDummyReturnVector.assign( fPixelData[iDataType][iTel].size(), 0. );
+            i_dataVector.assign( fPixelData[iDataType][iTel].size(), 0. );
             // loop over all pixel
             for( unsigned int i = 0; i < fPixelData[iDataType][iTel].size(); i++ )
             {
@@ -504,26 +502,26 @@ vector< float > VDB_PixelDataReader::getDataVector( unsigned int iDataType, unsi
                         if( iTime >= fPixelData[iDataType][iTel][i]->fsec_of_day[t] - iTimeBinWidth
                                 && iTime < fPixelData[iDataType][iTel][i]->fsec_of_day[t] )
                         {
-                            fDummyReturnVector[i] = fPixelData[iDataType][iTel][i]->fData[t];
+                            i_dataVector[i] = fPixelData[iDataType][iTel][i]->fData[t];
                             // first two and/or last time bin is sometimes not filled (run start/end and L1 rate interval star mismatch)
                             // use in this case the L1 rates from second bin
                             // (note: only for L1 rates)
-                            if( iDataType == 0 && fDummyReturnVector[i] < 1.e-2 && fPixelData[iDataType][iTel][i]->fData.size() > 1 )
+                            if( iDataType == 0 && i_dataVector[i] < 1.e-2 && fPixelData[iDataType][iTel][i]->fData.size() > 1 )
                             {
                                 if( t == 0 || t == 1 )
                                 {
                                     if( fPixelData[iDataType][iTel][i]->fData.size() > t + 1 )
                                     {
-                                        fDummyReturnVector[i] = fPixelData[iDataType][iTel][i]->fData[t + 1];
+                                        i_dataVector[i] = fPixelData[iDataType][iTel][i]->fData[t + 1];
                                     }
-                                    if( fDummyReturnVector[i] < 1.e-2 && fPixelData[iDataType][iTel][i]->fData.size() > 3 )
+                                    if( i_dataVector[i] < 1.e-2 && fPixelData[iDataType][iTel][i]->fData.size() > 3 )
                                     {
-                                        fDummyReturnVector[i] = fPixelData[iDataType][iTel][i]->fData[t + 2];
+                                        i_dataVector[i] = fPixelData[iDataType][iTel][i]->fData[t + 2];
                                     }
                                 }
                                 else if( t == fPixelData[iDataType][iTel][i]->fMJD.size() - 1 )
                                 {
-                                    fDummyReturnVector[i] = fPixelData[iDataType][iTel][i]->fData[t - 1];
+                                    i_dataVector[i] = fPixelData[iDataType][iTel][i]->fData[t - 1];
                                 }
                             }
                             break;
@@ -532,13 +530,13 @@ vector< float > VDB_PixelDataReader::getDataVector( unsigned int iDataType, unsi
                 }
                 else if( fPixelData[iDataType][iTel][i]->fMJD.size() == 1 )
                 {
-                    fDummyReturnVector[i] = fPixelData[iDataType][iTel][i]->fData[0];
+                    i_dataVector[i] = fPixelData[iDataType][iTel][i]->fData[0];
 
                 }
             }
         }
     }
-    return fDummyReturnVector;
+    return i_dataVector;
 }
 
 /*
@@ -549,9 +547,8 @@ vector< unsigned int > VDB_PixelDataReader::getDeadChannelList( unsigned int iDa
         float iTime, float i_min, float i_max, bool bRMS )
 {
     vector< unsigned int > i_channelList;
-    // fills fDummyReturnVector with data
-    getDataVector( iDataType, iTel, iMJD, iTime );
-    if( fDummyReturnVector.size() == 0 )
+    vector< float > i_dataVector = getDataVector( iDataType, iTel, iMJD, iTime );
+    if( i_dataVector.size() == 0 )
     {
         return i_channelList;
     }
@@ -563,12 +560,12 @@ vector< unsigned int > VDB_PixelDataReader::getDeadChannelList( unsigned int iDa
     {
         double i_mean2 = 0.;
         double i_n = 0.;
-        for( unsigned int i = 0; i < fDummyReturnVector.size(); i++ )
+        for( unsigned int i = 0; i < i_dataVector.size(); i++ )
         {
-            if( fDummyReturnVector[i] > 0. )
+            if( i_dataVector[i] > 0. )
             {
-                i_mean  += fDummyReturnVector[i];
-                i_mean2 += fDummyReturnVector[i] * fDummyReturnVector[i];
+                i_mean  += i_dataVector[i];
+                i_mean2 += i_dataVector[i] * i_dataVector[i];
                 i_n++;
             }
         }
@@ -582,13 +579,13 @@ vector< unsigned int > VDB_PixelDataReader::getDeadChannelList( unsigned int iDa
         i_max = i_mean + TMath::Abs( i_max ) * i_rms;
     }
 
-    for( unsigned int i = 0; i < fDummyReturnVector.size(); i++ )
+    for( unsigned int i = 0; i < i_dataVector.size(); i++ )
     {
-        if( fDummyReturnVector[i] < i_min )
+        if( i_dataVector[i] < i_min )
         {
             i_channelList.push_back( i );
         }
-        else if( fDummyReturnVector[i] > i_max )
+        else if( i_dataVector[i] > i_max )
         {
             i_channelList.push_back( i );
         }
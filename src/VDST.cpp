@@ -21,6 +21,9 @@ VDST::VDST( bool iMode, bool iMC )
     // initialize flag (true after first event)
     fDSTini = false;
     fDSTfile = 0;
+    fDSTOutput = 0;
+    fDSTWriter = 0;
+    fVImageCleaning = 0;
     // no dst output, don't do anything
     if( !iMode )
     {
@@ -33,19 +36,52 @@ VDST::VDST( bool iMode, bool iMC )
         cout << "VDST::VDST error while create dst file" << endl;
         exit( -1 );
     }
+    // file compression has to be set before creating the trees
+    setDSTCompression( 0, true );
 
-    initDSTTree( true, false, getTraceFit() > -1 );
+    initDSTTree( true, false, getTraceFit() > -1, getRunParameter()->fdstslim );
     setMC( iMC );
+    // fill dst tree in writer thread:
+    // event loop fills the (not written) branch buffers of this tree,
+    // writer thread fills a second tree with identical structure
+    if( getRunParameter()->fdstasync )
+    {
+        fDSTOutput = new VDSTTree();
+        fDSTOutput->initDSTTree( true, false, getTraceFit() > -1, getRunParameter()->fdstslim );
+        fDSTOutput->setMC( iMC );
+        fDST_tree->SetDirectory( 0 );
+        fDSTWriter = new VDSTWriter( fDST_tree, fDSTOutput->getDSTTree() );
+        setDSTCompression( fDSTOutput->getDSTTree(), false );
+    }
+    else
+    {
+        setDSTCompression( fDST_tree, false );
+    }
 
     fVImageCleaning = new VImageCleaning( getData() );
 }
 
 VDST::~VDST()
 {
+    if( fDSTWriter )
+    {
+        delete fDSTWriter;
+    }
+    // writer thread: staging tree is not attached to the output file
+    if( fDSTOutput && fDST_tree )
+    {
+        delete fDST_tree;
+        fDST_tree = 0;
+    }
     if( fDSTfile && !fDSTfile->IsZombie() )
     {
         fDSTfile->Close();
     }
+    // (output tree is deleted when closing the file)
+    if( fDSTOutput )
+    {
+        delete fDSTOutput;
+    }
     if( fVImageCleaning )
     {
         delete fVImageCleaning;
@@ -90,6 +126,8 @@ void VDST::fill()
     }
     // get geometry
     fDSTntel = getNTel();
+    // sparse pixel list is filled pixel by pixel
+    fDSTnpix = 0;
     // test geometry
     if( fDSTntel > VDST_MAXTELESCOPES || ( int )getNChannels() > VDST_MAXCHANNELS )
     {
@@ -179,7 +217,7 @@ void VDST::fill()
     if( fReader->isMC() && fDSTLTrig == 0 )
     {
         resetDataVectors();
-        fDST_tree->Fill();
+        fillDSTTree();
         return;
     }
 
@@ -264,7 +302,8 @@ void VDST::fill()
             //   ii) fRunPar->fdstwriteallpixel is set to true
             //           or
             //  iii) this is a border or image pixel
-            if( isTeltoAna( i ) && ( ( !fBLaser || ( i_total > fRunPar->fLaserSumMin ) ) && ( fRunPar->fdstwriteallpixel || getBorder()[j] || getImage()[j] ) ) )
+            //  (slim dst trees: image or border pixels only)
+            if( isTeltoAna( i ) && ( ( !fBLaser || ( i_total > fRunPar->fLaserSumMin ) ) && ( ( fRunPar->fdstwriteallpixel && !isSlimTree() ) || getBorder()[j] || getImage()[j] ) ) )
             {
                 intubes++;
                 // for laser only
@@ -323,6 +362,10 @@ void VDST::fill()
                     fDSTFTpar[i][j] = ( float )getTraceFitFallTimeParameter()[j];
                     fDSTTraceNorm[i][j] = ( float )getTraceFitNorm()[j];
                 }
+                if( isSlimTree() )
+                {
+                    addSlimPixel( i, j );
+                }
             }
             else
             {
@@ -361,7 +404,60 @@ void VDST::fill()
     {
         return;
     }
-    fDST_tree->Fill();
+    fillDSTTree();
+}
+
+
+/*
+ * fill current event into dst tree (directly or through writer thread)
+*/
+void VDST::fillDSTTree()
+{
+    if( fDSTWriter )
+    {
+        fDSTWriter->fill();
+    }
+    else
+    {
+        fDST_tree->Fill();
+    }
+}
+
+
+/*
+ * apply compression settings (fRunPar->fdstcompression)
+ *
+ * comma separated list of settings (ROOT convention: 100*algorithm+level):
+ *   SETTING         file level (applied to all trees created afterwards)
+ *   BRANCH:SETTING  setting for an individual branch of the dst tree
+*/
+void VDST::setDSTCompression( TTree* t, bool iFileLevel )
+{
+    string iList = getRunParameter()->fdstcompression;
+    while( iList.size() > 0 )
+    {
+        string iToken = iList.substr( 0, iList.find( "," ) );
+        iList = ( iList.find( "," ) < iList.size() ? iList.substr( iList.find( "," ) + 1 ) : "" );
+        if( iToken.size() == 0 )
+        {
+            continue;
+        }
+        if( iFileLevel && iToken.find( ":" ) == string::npos && fDSTfile )
+        {
+            fDSTfile->SetCompressionSettings( atoi( iToken.c_str() ) );
+        }
+        else if( !iFileLevel && iToken.find( ":" ) != string::npos && t )
+        {
+            string iBranch = iToken.substr( 0, iToken.find( ":" ) );
+            TBranch* b = t->GetBranch( iBranch.c_str() );
+            if( !b )
+            {
+                cout << "VDST::setDSTCompression warning: branch " << iBranch << " not found in dst tree" << endl;
+                continue;
+            }
+            b->SetCompressionSettings( atoi( iToken.substr( iToken.find( ":" ) + 1 ).c_str() ) );
+        }
+    }
 }
 
 
@@ -371,14 +467,20 @@ void VDST::terminate()
     {
         cout << "VDST::terminate()" << endl;
     }
+    // wait for writer thread to fill all events
+    if( fDSTWriter )
+    {
+        fDSTWriter->terminate();
+    }
     // now write everything to disk
     if( fDSTfile )
     {
         if( fDSTfile->cd() )
         {
+            TTree* iDSTTree = ( fDSTOutput ? fDSTOutput->getDSTTree() : fDST_tree );
             cout << "writing data summary tree to " << fDSTfile->GetName() << endl;
-            cout << "\t total number of events in dst tree: " << fDST_tree->GetEntries() << endl;
-            fDST_tree->Write();
+            cout << "\t total number of events in dst tree: " << iDSTTree->GetEntries() << endl;
+            iDSTTree->Write();
             getRunParameter()->Write();
             // write detector tree
             if( getDetectorTree() )
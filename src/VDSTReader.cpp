@@ -6,6 +6,9 @@
 
 #include <VDSTReader.h>
 
+thread_local unsigned int VDSTReader::fTelID = 0;
+thread_local unsigned int VDSTReader::fSelectedHitChannel = 0;
+
 VDSTReader::VDSTReader( string isourcefile, bool iMC, int iNTel, bool iDebug )
 {
     fDebug = iDebug;
@@ -22,6 +25,7 @@ VDSTReader::VDSTReader( string isourcefile, bool iMC, int iNTel, bool iDebug )
     fDSTtreeEvent = 0;
 
     fMC = iMC;
+    fSparseReplay = false;
 
     fDSTTree = new VDSTTree();
 
@@ -121,8 +125,9 @@ bool VDSTReader::init()
             i_trace_sample_VV.push_back( i_trace_sample );
         }
         fFADCTrace.push_back( i_trace_sample_VV );
+        fHitList.push_back( vector< unsigned int >() );
+        fHitIndex.push_back( vector< int >( fNChannel[i], -1 ) );
     }
-    fDummySample.assign( VDST_MAXSUMWINDOW, 0 );
 
     return fDSTTree->isMC();
 }
@@ -143,6 +148,50 @@ bool VDSTReader::setTelescopeID( unsigned int iTelID )
 }
 
 
+/*
+ * read ahead: prefetch baskets of the next iNEvents events
+ * (using a tree cache for all branches)
+ *
+ * baskets in the cache are decompressed in background tasks
+ * (TTreeCacheUnzip, requires implicit multi-threading); filling
+ * of the event data from the branches stays in the calling thread
+ */
+void VDSTReader::setReadAhead( unsigned int iNEvents )
+{
+    if( iNEvents == 0 || !fDSTTree || !fDSTTree->getDSTTree() )
+    {
+        return;
+    }
+    TTree* t = fDSTTree->getDSTTree();
+    if( t->GetEntries() <= 0 )
+    {
+        return;
+    }
+    // cache size: average compressed event size times number of events (minimum 10 MB)
+    Long64_t i_cacheSize = ( Long64_t )( ( double )t->GetZipBytes() / ( double )t->GetEntries() * iNEvents );
+    if( i_cacheSize < 10000000 )
+    {
+        i_cacheSize = 10000000;
+    }
+    // unzip tasks run in the implicit multi-threading pool
+    if( !ROOT::IsImplicitMTEnabled() )
+    {
+        ROOT::EnableImplicitMT( 2 );
+    }
+    // (parallel unzipping must be set before the cache is created)
+    t->SetCacheSize( 0 );
+    t->SetParallelUnzip( true );
+    t->SetCacheSize( i_cacheSize );
+    t->AddBranchToCache( "*", true );
+    t->StopCacheLearningPhase();
+    if( fDebug )
+    {
+        cout << "VDSTReader::setReadAhead: tree cache size " << i_cacheSize << " bytes";
+        cout << " (parallel unzipping: " << ROOT::IsImplicitMTEnabled() << ")" << endl;
+    }
+}
+
+
 bool VDSTReader::getNextEvent()
 {
     if( fDebug )
@@ -156,7 +205,7 @@ bool VDSTReader::getNextEvent()
     }
 
     int i_succ = 0;
-    i_succ = fDSTTree->getDSTTree()->GetEntry( fDSTtreeEvent );
+    i_succ = fDSTTree->getDSTEntry( fDSTtreeEvent );
 
     // no next event
     if( i_succ <= 0 )
@@ -172,6 +221,10 @@ bool VDSTReader::getNextEvent()
     }
 
     // fill data vectors
+    if( fSparseReplay )
+    {
+        fillSparseHitList();
+    }
     for( unsigned int i = 0; i < fNTelescopes; i++ )
     {
         fTelAzimuth[i] = fDSTTree->getDSTTelAzimuth( i );
@@ -179,19 +232,19 @@ bool VDSTReader::getNextEvent()
 
         fDSTTree->setTelCounter( i );
 
-        for( unsigned int j = 0; j < fNChannel[i]; j++ )
+        if( fSparseReplay )
+        {
+            for( unsigned int h = 0; h < fHitList[i].size(); h++ )
+            {
+                fillHitChannel( i, fHitList[i][h] );
+            }
+        }
+        else
         {
-            fSums[i][j] = fDSTTree->getDSTSums( j );
-            fPe[i][j] = fDSTTree->getDSTPe( j );
-            for( unsigned int t = 0; t < fDSTTree->getDSTpulsetiminglevelsN(); t++ )
+            for( unsigned int j = 0; j < fNChannel[i]; j++ )
             {
-                fTracePulseTiming[i][t][j] = fDSTTree->getDSTpulsetiming( j, t );
+                fillHitChannel( i, j );
             }
-            fHiLo[i][j] = fDSTTree->getDSTHiLo( j );
-            fTraceMax[i][j] = fDSTTree->getDSTMax( j );
-            fRawTraceMax[i][j] = fDSTTree->getDSTRawMax( j );
-            fDead[i][j] = fDSTTree->getDSTDead( j );
-            fFullTrigVec[i][j] = fDSTTree->getTrigL1( j );
         }
         fNumberofFullTrigger[i] = fDSTTree->getNTrigL1( i );
     }
@@ -239,8 +292,150 @@ bool VDSTReader::getNextEvent()
 }
 
 
+/*
+    copy values of one channel from the DST tree
+    (telescope counter of the DST tree has to be set)
+*/
+void VDSTReader::fillHitChannel( unsigned int i, unsigned int j )
+{
+    fSums[i][j] = fDSTTree->getDSTSums( j );
+    fPe[i][j] = fDSTTree->getDSTPe( j );
+    for( unsigned int t = 0; t < fDSTTree->getDSTpulsetiminglevelsN(); t++ )
+    {
+        fTracePulseTiming[i][t][j] = fDSTTree->getDSTpulsetiming( j, t );
+    }
+    fHiLo[i][j] = fDSTTree->getDSTHiLo( j );
+    fTraceMax[i][j] = fDSTTree->getDSTMax( j );
+    fRawTraceMax[i][j] = fDSTTree->getDSTRawMax( j );
+    fDead[i][j] = fDSTTree->getDSTDead( j );
+    fFullTrigVec[i][j] = fDSTTree->getTrigL1( j );
+}
+
+
+/*
+    sparse replay: reset channels hit in the previous event and
+    get list of hit channels for the current event
+
+    - slim DSTs: pixel list as stored in the DST
+    - zero-suppressed DSTs: channels which are not zero suppressed
+      (and dead or L1-triggered channels, to keep these flags; all other
+      values of zero-suppressed channels are expected to be zero)
+*/
+void VDSTReader::fillSparseHitList()
+{
+    for( unsigned int i = 0; i < fNTelescopes; i++ )
+    {
+        for( unsigned int h = 0; h < fHitList[i].size(); h++ )
+        {
+            unsigned int j = fHitList[i][h];
+            fSums[i][j] = 0.;
+            fPe[i][j] = 0.;
+            for( unsigned int t = 0; t < fTracePulseTiming[i].size(); t++ )
+            {
+                fTracePulseTiming[i][t][j] = 0.;
+            }
+            fHiLo[i][j] = false;
+            fTraceMax[i][j] = 0.;
+            fRawTraceMax[i][j] = 0.;
+            fDead[i][j] = 0;
+            fFullTrigVec[i][j] = false;
+            fHitIndex[i][j] = -1;
+        }
+        fHitList[i].clear();
+    }
+
+    // zero-suppressed DSTs
+    if( !fDSTTree->isSlimTree() )
+    {
+        for( unsigned int i = 0; i < fNTelescopes; i++ )
+        {
+            if( fDSTTree->setTelCounter( i ) < 0 )
+            {
+                continue;
+            }
+            for( unsigned int j = 0; j < fNChannel[i]; j++ )
+            {
+                if( fDSTTree->getZeroSupppressed( j ) == 0 || fDSTTree->getDSTDead( j ) != 0 || fDSTTree->getTrigL1( j ) != 0 )
+                {
+                    fHitIndex[i][j] = fHitList[i].size();
+                    fHitList[i].push_back( j );
+                }
+            }
+        }
+        return;
+    }
+
+    // slim DSTs: telescope for each telescope index in DST tree
+    vector< int > iTelIndex( VDST_MAXTELESCOPES, -1 );
+    for( unsigned int i = 0; i < fNTelescopes; i++ )
+    {
+        int iT = fDSTTree->setTelCounter( i );
+        if( iT >= 0 && iT < VDST_MAXTELESCOPES )
+        {
+            iTelIndex[iT] = i;
+        }
+    }
+    vector< unsigned int >& iPixelList = fDSTTree->getSlimPixelList();
+    for( unsigned int p = 0; p < iPixelList.size(); p++ )
+    {
+        int i = iTelIndex[iPixelList[p] / VDST_MAXCHANNELS];
+        unsigned int j = iPixelList[p] % VDST_MAXCHANNELS;
+        if( i >= 0 && j < fNChannel[i] && fHitIndex[i][j] < 0 )
+        {
+            fHitIndex[i][j] = fHitList[i].size();
+            fHitList[i].push_back( j );
+        }
+    }
+}
+
+
+/*
+    sparse replay: fill only hit channels
+
+    hit IDs / hit indices are mapped to the channels in the hit list,
+    so that analysis loops over getNumChannelsHit() run over hit channels
+    only (as for zero-suppressed raw data)
+*/
+void VDSTReader::setSparseReplay( bool iSparse )
+{
+    // hit channels are known for slim DSTs (pixel list) and for DSTs
+    // with zero-suppression flags
+    if( iSparse && !fDSTTree->isSlimTree() && !fDSTTree->hasZeroSuppressionFlags() )
+    {
+        cout << "VDSTReader::setSparseReplay: DST source file is neither a slim DST nor has zero-suppression flags; ";
+        cout << "ignoring sparse replay" << endl;
+        iSparse = false;
+    }
+    fSparseReplay = iSparse;
+    for( unsigned int i = 0; i < fNTelescopes; i++ )
+    {
+        fSums[i] = 0.;
+        fPe[i] = 0.;
+        for( unsigned int t = 0; t < fTracePulseTiming[i].size(); t++ )
+        {
+            fTracePulseTiming[i][t] = 0.;
+        }
+        fTraceMax[i] = 0.;
+        fRawTraceMax[i] = 0.;
+        fHiLo[i].assign( fNChannel[i], false );
+        fDead[i].assign( fNChannel[i], 0 );
+        fFullTrigVec[i].assign( fNChannel[i], !fSparseReplay );
+        fHitList[i].clear();
+        fHitIndex[i].assign( fNChannel[i], -1 );
+    }
+}
+
+
 std::pair<bool, uint32_t> VDSTReader::getChannelHitIndex( uint32_t hit )
 {
+    if( fSparseReplay )
+    {
+        if( hit < fHitIndex[fTelID].size() && fHitIndex[fTelID][hit] >= 0 )
+        {
+            return std::make_pair( true, ( uint32_t )fHitIndex[fTelID][hit] );
+        }
+        return std::make_pair( false, ( uint32_t ) 0 );
+    }
     if( hit < fSums[fTelID].size() )
     {
         return std::make_pair( true, hit );
@@ -251,6 +446,14 @@ std::pair<bool, uint32_t> VDSTReader::getChannelHitIndex( uint32_t hit )
 
 uint32_t VDSTReader::getHitID( uint32_t i )
 {
+    if( fSparseReplay )
+    {
+        if( i < fHitList[fTelID].size() )
+        {
+            return fHitList[fTelID][i];
+        }
+        return 0;
+    }
     if( i < fSums[fTelID].size() )
     {
         return i;
@@ -285,6 +488,20 @@ VMonteCarloRunHeader* VDSTReader::getMonteCarloHeader()
     return 0;
 }
 
+const uint16_t* VDSTReader::getSamplePtr16Bit( unsigned channel, unsigned int& iNSamples )
+{
+    iNSamples = 0;
+    if( fPerformFADCAnalysis && fTelID < fFADCTrace.size() )
+    {
+        if( channel < fFADCTrace[fTelID].size() && fFADCTrace[fTelID][channel].size() > 0 )
+        {
+            iNSamples = fFADCTrace[fTelID][channel].size();
+            return &fFADCTrace[fTelID][channel][0];
+        }
+    }
+    return 0;
+}
+
 vector< uint16_t > VDSTReader::getSamplesVec16Bit()
 {
     if( fTelID < fFADCTrace.size() )
@@ -300,20 +517,20 @@ vector< uint16_t > VDSTReader::getSamplesVec16Bit()
 
 vector< uint8_t > VDSTReader::getSamplesVec()
 {
+    // local sample vector (this function might be called from several threads)
+    vector< uint8_t > i_sample( VDST_MAXSUMWINDOW, 0 );
     if( fPerformFADCAnalysis && fTelID < fFADCTrace.size() )
     {
         if( fSelectedHitChannel < fFADCTrace[fTelID].size() )
         {
             for( unsigned int i = 0; i < getNumSamples(); i++ )
             {
-                fDummySample[i] = ( uint8_t )fFADCTrace[fTelID][fSelectedHitChannel][i];
+                i_sample[i] = ( uint8_t )fFADCTrace[fTelID][fSelectedHitChannel][i];
             }
-            return fDummySample;
         }
     }
-    fDummySample.assign( VDST_MAXSUMWINDOW, 0 );
 
-    return fDummySample;
+    return i_sample;
 }
 
 uint8_t  VDSTReader::getSample( unsigned channel, unsigned sample, bool iNewNoiseTrace )
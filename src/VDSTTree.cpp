@@ -21,6 +21,9 @@ VDSTTree::VDSTTree()
     fMCtree = 0;
     fDST_tree = 0;
 
+    fSlimTree = false;
+    fDSTnpix = 0;
+
     // initialize
     fTelescopeCounter_temp = -1;
     fDSTLTrig = 0;
@@ -81,9 +84,16 @@ bool VDSTTree::initMCTree()
 /*
    init DST tree for writing
 */
-bool VDSTTree::initDSTTree( bool iFullTree, bool iPhotoDiode, bool iTraceFit )
+/*
+     init DST tree for writing
+
+     iSlimTree: write image/border pixels only (sparse pixel list instead of
+                per-channel arrays)
+*/
+bool VDSTTree::initDSTTree( bool iFullTree, bool iPhotoDiode, bool iTraceFit, bool iSlimTree )
 {
     char tname[1000];
+    fSlimTree = iSlimTree;
 
     // DST tree definition
     fDST_tree = new TTree( "dst", "data summary tree" );
@@ -122,47 +132,108 @@ bool VDSTTree::initDSTTree( bool iFullTree, bool iPhotoDiode, bool iTraceFit )
     fDST_tree->Branch( "ntel_data", &fDSTntel_data, "ntel_data/i" );
     fDST_tree->Branch( "tel_data", fDSTtel_data, "tel_data[ntel_data]/i" );
     fDST_tree->Branch( "tel_zero_suppression", fDSTTelescopeZeroSupression, "tel_zero_suppression[ntel_data]/s" );
-    sprintf( tname, "chan[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "chan", fDSTChan, tname );
-    sprintf( tname, "recorded[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "recorded", fDSTRecord, tname );
     fDST_tree->Branch( "nL1trig", fDSTnL1trig, "nL1trig[ntel_data]/s" );
-    sprintf( tname, "L1trig[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "L1trig", fDSTL1trig, tname );
-    sprintf( tname, "sum[ntel_data][%d]/F", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "sum", fDSTsums, tname );
-    sprintf( tname, "sum2[ntel_data][%d]/F", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "sum2", fDSTsums2, tname );
-    sprintf( tname, "dead[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "dead", fDSTdead, tname );
-    sprintf( tname, "zerosuppressed[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "zerosuppressed", fDSTZeroSuppressed, tname );
-    sprintf( tname, "sumwindow[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "sumwindow", fDSTsumwindow, tname );
-    sprintf( tname, "sumfirst[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "sumfirst", fDSTsumfirst, tname );
-    sprintf( tname, "tzero[ntel_data][%d]/F", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "tzero", fDSTt0, tname );
-    sprintf( tname, "Width[ntel_data][%d]/F", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "Width", fDSTTraceWidth, tname );
     // timing levels
     sprintf( tname, "pulsetiminglevel[ntel_data][%d]/F", VDST_MAXTIMINGLEVELS );
     fDST_tree->Branch( "pulsetiminglevel", fDSTpulsetiminglevels, tname );
-    sprintf( tname, "pulsetiming[ntel_data][%d][%d]/F", VDST_MAXTIMINGLEVELS, VDST_MAXCHANNELS );
-    fDST_tree->Branch( "pulsetiming", fDSTpulsetiming, tname );
-    sprintf( tname, "Max[ntel_data][%d]/S", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "Max", fDSTMax, tname );
-    if( iFullTree )
-    {
-        sprintf( tname, "RawMax[ntel_data][%d]/S", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "RawMax", fDSTRawMax, tname );
+    // slim tree: image/border pixels only
+    if( fSlimTree )
+    {
+        initSlimPixelList( VDST_MAXTELESCOPES * VDST_MAXCHANNELS );
+        fDST_tree->Branch( "npix", &fDSTnpix, "npix/i" );
+        fDST_tree->Branch( "pix_tel", &fDSTpix_tel[0], "pix_tel[npix]/s" );
+        fDST_tree->Branch( "pix_chan", &fDSTpix_chan[0], "pix_chan[npix]/s" );
+        fDST_tree->Branch( "pix_sum", &fDSTpix_sum[0], "pix_sum[npix]/F" );
+        fDST_tree->Branch( "pix_sum2", &fDSTpix_sum2[0], "pix_sum2[npix]/F" );
+        fDST_tree->Branch( "pix_dead", &fDSTpix_dead[0], "pix_dead[npix]/s" );
+        fDST_tree->Branch( "pix_sumwindow", &fDSTpix_sumwindow[0], "pix_sumwindow[npix]/s" );
+        fDST_tree->Branch( "pix_sumfirst", &fDSTpix_sumfirst[0], "pix_sumfirst[npix]/s" );
+        fDST_tree->Branch( "pix_Width", &fDSTpix_Width[0], "pix_Width[npix]/F" );
+        sprintf( tname, "pix_pulsetiming[npix][%d]/F", VDST_MAXTIMINGLEVELS );
+        fDST_tree->Branch( "pix_pulsetiming", &fDSTpix_pulsetiming[0], tname );
+        fDST_tree->Branch( "pix_Max", &fDSTpix_Max[0], "pix_Max[npix]/S" );
+        if( iFullTree )
+        {
+            fDST_tree->Branch( "pix_RawMax", &fDSTpix_RawMax[0], "pix_RawMax[npix]/S" );
+        }
+        fDST_tree->Branch( "pix_HiLo", &fDSTpix_HiLo[0], "pix_HiLo[npix]/s" );
+        if( iFullTree )
+        {
+            fDST_tree->Branch( "pix_N255", &fDSTpix_N255[0], "pix_N255[npix]/s" );
+        }
+        if( iTraceFit )
+        {
+            fDST_tree->Branch( "pix_Chi2", &fDSTpix_Chi2[0], "pix_Chi2[npix]/F" );
+            fDST_tree->Branch( "pix_RT", &fDSTpix_RT[0], "pix_RT[npix]/F" );
+            fDST_tree->Branch( "pix_FT", &fDSTpix_FT[0], "pix_FT[npix]/F" );
+            fDST_tree->Branch( "pix_RTpar", &fDSTpix_RTpar[0], "pix_RTpar[npix]/F" );
+            fDST_tree->Branch( "pix_FTpar", &fDSTpix_FTpar[0], "pix_FTpar[npix]/F" );
+            fDST_tree->Branch( "pix_Norm", &fDSTpix_Norm[0], "pix_Norm[npix]/F" );
+        }
     }
-    sprintf( tname, "HiLo[ntel_data][%d]/s", VDST_MAXCHANNELS );
-    fDST_tree->Branch( "HiLo", fDSTHiLo, tname );
-    if( iFullTree )
+    // per-channel arrays
+    else
     {
-        sprintf( tname, "N255[ntel_data][%d]/s", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "N255", fDSTN255, tname );
+        sprintf( tname, "chan[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "chan", fDSTChan, tname );
+        sprintf( tname, "recorded[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "recorded", fDSTRecord, tname );
+        sprintf( tname, "L1trig[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "L1trig", fDSTL1trig, tname );
+        sprintf( tname, "sum[ntel_data][%d]/F", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "sum", fDSTsums, tname );
+        sprintf( tname, "sum2[ntel_data][%d]/F", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "sum2", fDSTsums2, tname );
+        sprintf( tname, "dead[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "dead", fDSTdead, tname );
+        sprintf( tname, "zerosuppressed[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "zerosuppressed", fDSTZeroSuppressed, tname );
+        sprintf( tname, "sumwindow[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "sumwindow", fDSTsumwindow, tname );
+        sprintf( tname, "sumfirst[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "sumfirst", fDSTsumfirst, tname );
+        sprintf( tname, "tzero[ntel_data][%d]/F", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "tzero", fDSTt0, tname );
+        sprintf( tname, "Width[ntel_data][%d]/F", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "Width", fDSTTraceWidth, tname );
+        sprintf( tname, "pulsetiming[ntel_data][%d][%d]/F", VDST_MAXTIMINGLEVELS, VDST_MAXCHANNELS );
+        fDST_tree->Branch( "pulsetiming", fDSTpulsetiming, tname );
+        sprintf( tname, "Max[ntel_data][%d]/S", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "Max", fDSTMax, tname );
+        if( iFullTree )
+        {
+            sprintf( tname, "RawMax[ntel_data][%d]/S", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "RawMax", fDSTRawMax, tname );
+        }
+        sprintf( tname, "HiLo[ntel_data][%d]/s", VDST_MAXCHANNELS );
+        fDST_tree->Branch( "HiLo", fDSTHiLo, tname );
+        if( iFullTree )
+        {
+            sprintf( tname, "N255[ntel_data][%d]/s", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "N255", fDSTN255, tname );
+        }
+        //PhotoElectrons
+        if( fMC )//to be changed to something like fReadPE...
+        {
+            sprintf( tname, "Pe[ntel_data][%d]/i", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "Pe", fDSTPe, tname );
+        }
+        // trace fit part might be out of date
+        if( iTraceFit )
+        {
+            sprintf( tname, "Chi2[ntel_data][%d]/F", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "Chi2", fDSTChi2, tname );
+            sprintf( tname, "RT[ntel_data][%d]/F", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "RT", fDSTRT, tname );
+            sprintf( tname, "FT[ntel_data][%d]/F", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "FT", fDSTFT, tname );
+            sprintf( tname, "RTpar[ntel_data][%d]/F", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "RTpar", fDSTRTpar, tname );
+            sprintf( tname, "FTpar[ntel_data][%d]/F", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "FTpar", fDSTFTpar, tname );
+            sprintf( tname, "Norm[ntel_data][%d]/F", VDST_MAXCHANNELS );
+            fDST_tree->Branch( "Norm", fDSTTraceNorm, tname );
+        }
     }
     // FADC trace
     fDST_tree->Branch( "numSamples", fDSTnumSamples, "numSamples[ntel_data]/s" );
@@ -171,13 +242,6 @@ bool VDSTTree::initDSTTree( bool iFullTree, bool iPhotoDiode, bool iTraceFit )
         sprintf( tname, "FADC[ntel_data][%d][%d]/s", VDST_MAXSUMWINDOW, VDST_MAXCHANNELS );
         fDST_tree->Branch( "Trace", fDSTtrace, tname );
     }
-
-    //PhotoElectrons
-    if( fMC )//to be changed to something like fReadPE...
-    {
-        sprintf( tname, "Pe[ntel_data][%d]/i", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "Pe", fDSTPe, tname );
-    }
     // photo diode data
     if( iPhotoDiode )
     {
@@ -185,23 +249,6 @@ bool VDSTTree::initDSTTree( bool iFullTree, bool iPhotoDiode, bool iTraceFit )
         fDST_tree->Branch( "PDSum", fDSTPDSum, "PDSum[ntel_data]/F" );
     }
 
-    // trace fit part might be out of date
-    if( iTraceFit )
-    {
-        sprintf( tname, "Chi2[ntel_data][%d]/F", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "Chi2", fDSTChi2, tname );
-        sprintf( tname, "RT[ntel_data][%d]/F", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "RT", fDSTRT, tname );
-        sprintf( tname, "FT[ntel_data][%d]/F", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "FT", fDSTFT, tname );
-        sprintf( tname, "RTpar[ntel_data][%d]/F", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "RTpar", fDSTRTpar, tname );
-        sprintf( tname, "FTpar[ntel_data][%d]/F", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "FTpar", fDSTFTpar, tname );
-        sprintf( tname, "Norm[ntel_data][%d]/F", VDST_MAXCHANNELS );
-        fDST_tree->Branch( "Norm", fDSTTraceNorm, tname );
-    }
-
     // MC block
     if( fMC )
     {
@@ -260,6 +307,7 @@ void VDSTTree::resetDataVectors( unsigned int iCH, unsigned int iMaxNTel, unsign
     {
         return;
     }
+    fDSTnpix = 0;
 
     // loop over telescopes
     for( unsigned int i = 0; i < iMaxNTel; i++ )
@@ -344,6 +392,149 @@ void VDSTTree::resetDataVectors( unsigned int iCH, unsigned int iMaxNTel, unsign
 
 }
 
+/*
+    allocate sparse pixel list for slim DSTs
+    (buffers are never reallocated, as their addresses are used by the tree)
+*/
+void VDSTTree::initSlimPixelList( unsigned int iMaxNPixel )
+{
+    if( iMaxNPixel == 0 )
+    {
+        iMaxNPixel = 1;
+    }
+    fDSTnpix = 0;
+    fDSTpix_tel.assign( iMaxNPixel, 0 );
+    fDSTpix_chan.assign( iMaxNPixel, 0 );
+    fDSTpix_sum.assign( iMaxNPixel, 0. );
+    fDSTpix_sum2.assign( iMaxNPixel, 0. );
+    fDSTpix_dead.assign( iMaxNPixel, 0 );
+    fDSTpix_sumwindow.assign( iMaxNPixel, 0 );
+    fDSTpix_sumfirst.assign( iMaxNPixel, 0 );
+    fDSTpix_Width.assign( iMaxNPixel, 0. );
+    fDSTpix_pulsetiming.assign( iMaxNPixel * VDST_MAXTIMINGLEVELS, 0. );
+    fDSTpix_Max.assign( iMaxNPixel, 0 );
+    fDSTpix_RawMax.assign( iMaxNPixel, 0 );
+    fDSTpix_HiLo.assign( iMaxNPixel, 0 );
+    fDSTpix_N255.assign( iMaxNPixel, 0 );
+    fDSTpix_Chi2.assign( iMaxNPixel, 0. );
+    fDSTpix_RT.assign( iMaxNPixel, 0. );
+    fDSTpix_FT.assign( iMaxNPixel, 0. );
+    fDSTpix_RTpar.assign( iMaxNPixel, 0. );
+    fDSTpix_FTpar.assign( iMaxNPixel, 0. );
+    fDSTpix_Norm.assign( iMaxNPixel, 0. );
+    fSlimPixelIndex.clear();
+    fSlimPixelIndex.reserve( iMaxNPixel );
+}
+
+/*
+    add a pixel to the sparse pixel list (slim DSTs)
+
+    values are taken from the per-channel arrays
+*/
+void VDSTTree::addSlimPixel( unsigned int iTel, unsigned int iChannel )
+{
+    if( fDSTnpix >= fDSTpix_tel.size() || iTel >= VDST_MAXTELESCOPES || iChannel >= VDST_MAXCHANNELS )
+    {
+        return;
+    }
+    unsigned int p = fDSTnpix;
+    fDSTpix_tel[p] = iTel;
+    fDSTpix_chan[p] = iChannel;
+    fDSTpix_sum[p] = fDSTsums[iTel][iChannel];
+    fDSTpix_sum2[p] = fDSTsums2[iTel][iChannel];
+    fDSTpix_dead[p] = fDSTdead[iTel][iChannel];
+    fDSTpix_sumwindow[p] = fDSTsumwindow[iTel][iChannel];
+    fDSTpix_sumfirst[p] = fDSTsumfirst[iTel][iChannel];
+    fDSTpix_Width[p] = fDSTTraceWidth[iTel][iChannel];
+    for( unsigned int t = 0; t < VDST_MAXTIMINGLEVELS; t++ )
+    {
+        fDSTpix_pulsetiming[p * VDST_MAXTIMINGLEVELS + t] = fDSTpulsetiming[iTel][t][iChannel];
+    }
+    fDSTpix_Max[p] = fDSTMax[iTel][iChannel];
+    fDSTpix_RawMax[p] = fDSTRawMax[iTel][iChannel];
+    fDSTpix_HiLo[p] = fDSTHiLo[iTel][iChannel];
+    fDSTpix_N255[p] = fDSTN255[iTel][iChannel];
+    fDSTpix_Chi2[p] = fDSTChi2[iTel][iChannel];
+    fDSTpix_RT[p] = fDSTRT[iTel][iChannel];
+    fDSTpix_FT[p] = fDSTFT[iTel][iChannel];
+    fDSTpix_RTpar[p] = fDSTRTpar[iTel][iChannel];
+    fDSTpix_FTpar[p] = fDSTFTpar[iTel][iChannel];
+    fDSTpix_Norm[p] = fDSTTraceNorm[iTel][iChannel];
+    fDSTnpix++;
+}
+
+/*
+    copy sparse pixel list of the current event into the per-channel arrays
+    (slim DSTs; all pixels not in the list are zero)
+*/
+void VDSTTree::expandSlimPixelList()
+{
+    // reset pixels of the previous event
+    for( unsigned int k = 0; k < fSlimPixelIndex.size(); k++ )
+    {
+        unsigned int i = fSlimPixelIndex[k] / VDST_MAXCHANNELS;
+        unsigned int j = fSlimPixelIndex[k] % VDST_MAXCHANNELS;
+        fDSTsums[i][j] = 0.;
+        fDSTsums2[i][j] = 0.;
+        fDSTdead[i][j] = 0;
+        fDSTsumwindow[i][j] = 0;
+        fDSTsumfirst[i][j] = 0;
+        fDSTTraceWidth[i][j] = 0.;
+        for( unsigned int t = 0; t < VDST_MAXTIMINGLEVELS; t++ )
+        {
+            fDSTpulsetiming[i][t][j] = 0.;
+        }
+        fDSTMax[i][j] = 0;
+        fDSTRawMax[i][j] = 0;
+        fDSTHiLo[i][j] = 0;
+        fDSTN255[i][j] = 0;
+    }
+    fSlimPixelIndex.clear();
+
+    for( unsigned int p = 0; p < fDSTnpix && p < fDSTpix_tel.size(); p++ )
+    {
+        unsigned int i = fDSTpix_tel[p];
+        unsigned int j = fDSTpix_chan[p];
+        if( i >= VDST_MAXTELESCOPES || j >= VDST_MAXCHANNELS )
+        {
+            continue;
+        }
+        fDSTsums[i][j] = fDSTpix_sum[p];
+        fDSTsums2[i][j] = fDSTpix_sum2[p];
+        fDSTdead[i][j] = fDSTpix_dead[p];
+        fDSTsumwindow[i][j] = fDSTpix_sumwindow[p];
+        fDSTsumfirst[i][j] = fDSTpix_sumfirst[p];
+        fDSTTraceWidth[i][j] = fDSTpix_Width[p];
+        for( unsigned int t = 0; t < VDST_MAXTIMINGLEVELS; t++ )
+        {
+            fDSTpulsetiming[i][t][j] = fDSTpix_pulsetiming[p * VDST_MAXTIMINGLEVELS + t];
+        }
+        fDSTMax[i][j] = fDSTpix_Max[p];
+        fDSTRawMax[i][j] = fDSTpix_RawMax[p];
+        fDSTHiLo[i][j] = fDSTpix_HiLo[p];
+        fDSTN255[i][j] = fDSTpix_N255[p];
+        fSlimPixelIndex.push_back( i * VDST_MAXCHANNELS + j );
+    }
+}
+
+/*
+    read an event from the DST tree
+    (fills per-channel arrays for slim DSTs)
+*/
+int VDSTTree::getDSTEntry( Long64_t iEntry )
+{
+    if( !fDST_tree )
+    {
+        return 0;
+    }
+    int i_succ = fDST_tree->GetEntry( iEntry );
+    if( i_succ > 0 && fSlimTree )
+    {
+        expandSlimPixelList();
+    }
+    return i_succ;
+}
+
 /*
      init DST tree for reading
 */
@@ -417,23 +608,80 @@ bool VDSTTree::initDSTTree( TTree* t, TTree* c )
         fDST_tree->SetBranchAddress( "recorded", fDSTRecord );
     }
     fDST_tree->SetBranchAddress( "nL1trig", fDSTnL1trig );
-    fDST_tree->SetBranchAddress( "L1trig", fDSTL1trig );
-    fDST_tree->SetBranchAddress( "sum", fDSTsums );
-    if( fDST_tree->GetBranchStatus( "sum2" ) )
+    if( fDST_tree->GetBranchStatus( "L1trig" ) )
     {
-        fDST_tree->SetBranchAddress( "sum2", fDSTsums2 );
+        fDST_tree->SetBranchAddress( "L1trig", fDSTL1trig );
     }
-    else
+    // slim tree: list of image/border pixels
+    // (copied to per-channel arrays in expandSlimPixelList())
+    fSlimTree = ( fDST_tree->GetBranch( "npix" ) != 0 );
+    if( fSlimTree )
     {
-        fDST_tree->SetBranchAddress( "sum", fDSTsums );
+        unsigned int iMaxNChannels = 0;
+        for( unsigned int i = 0; i < fDSTntel; i++ )
+        {
+            iMaxNChannels = TMath::Max( iMaxNChannels, fDSTnchannel[i] );
+        }
+        if( iMaxNChannels == 0 || iMaxNChannels > VDST_MAXCHANNELS )
+        {
+            iMaxNChannels = VDST_MAXCHANNELS;
+        }
+        unsigned int iMaxNPixel = TMath::Max( fDSTntel, ( unsigned int )1 ) * iMaxNChannels;
+        // (maximum number of pixels per event is stored with the npix leaf)
+        if( fDST_tree->GetLeaf( "npix" ) && fDST_tree->GetLeaf( "npix" )->GetMaximum() > ( int )iMaxNPixel )
+        {
+            iMaxNPixel = fDST_tree->GetLeaf( "npix" )->GetMaximum();
+        }
+        initSlimPixelList( iMaxNPixel );
+        fDST_tree->SetBranchAddress( "npix", &fDSTnpix );
+        fDST_tree->SetBranchAddress( "pix_tel", &fDSTpix_tel[0] );
+        fDST_tree->SetBranchAddress( "pix_chan", &fDSTpix_chan[0] );
+        fDST_tree->SetBranchAddress( "pix_sum", &fDSTpix_sum[0] );
+        fDST_tree->SetBranchAddress( "pix_sum2", &fDSTpix_sum2[0] );
+        fDST_tree->SetBranchAddress( "pix_dead", &fDSTpix_dead[0] );
+        fDST_tree->SetBranchAddress( "pix_sumwindow", &fDSTpix_sumwindow[0] );
+        fDST_tree->SetBranchAddress( "pix_sumfirst", &fDSTpix_sumfirst[0] );
+        fDST_tree->SetBranchAddress( "pix_Width", &fDSTpix_Width[0] );
+        fDST_tree->SetBranchAddress( "pix_pulsetiming", &fDSTpix_pulsetiming[0] );
+        fDST_tree->SetBranchAddress( "pix_Max", &fDSTpix_Max[0] );
+        if( fDST_tree->GetBranchStatus( "pix_RawMax" ) )
+        {
+            fDST_tree->SetBranchAddress( "pix_RawMax", &fDSTpix_RawMax[0] );
+        }
+        fDST_tree->SetBranchAddress( "pix_HiLo", &fDSTpix_HiLo[0] );
+        if( fDST_tree->GetBranchStatus( "pix_N255" ) )
+        {
+            fDST_tree->SetBranchAddress( "pix_N255", &fDSTpix_N255[0] );
+        }
+        fDST_tree->SetBranchAddress( "pulsetiminglevel", fDSTpulsetiminglevels );
     }
-    fDST_tree->SetBranchAddress( "dead", fDSTdead );
-    if( fDST_tree->GetBranchStatus( "zerosuppressed" ) )
+    else
     {
-        fDST_tree->SetBranchAddress( "zerosuppressed", fDSTZeroSuppressed );
+        fDST_tree->SetBranchAddress( "sum", fDSTsums );
+        if( fDST_tree->GetBranchStatus( "sum2" ) )
+        {
+            fDST_tree->SetBranchAddress( "sum2", fDSTsums2 );
+        }
+        else
+        {
+            fDST_tree->SetBranchAddress( "sum", fDSTsums );
+        }
+        fDST_tree->SetBranchAddress( "dead", fDSTdead );
+        if( fDST_tree->GetBranchStatus( "zerosuppressed" ) )
+        {
+            fDST_tree->SetBranchAddress( "zerosuppressed", fDSTZeroSuppressed );
+        }
+        fDST_tree->SetBranchAddress( "tzero", fDSTt0 );
+        fDST_tree->SetBranchAddress( "Width", fDSTTraceWidth );
+        fDST_tree->SetBranchAddress( "pulsetiminglevel", fDSTpulsetiminglevels );
+        fDST_tree->SetBranchAddress( "pulsetiming", fDSTpulsetiming );
+        fDST_tree->SetBranchAddress( "Max", fDSTMax );
+        if( fFullTree )
+        {
+            fDST_tree->SetBranchAddress( "RawMax", fDSTRawMax );
+        }
+        fDST_tree->SetBranchAddress( "HiLo", fDSTHiLo );
     }
-    fDST_tree->SetBranchAddress( "tzero", fDSTt0 );
-    fDST_tree->SetBranchAddress( "Width", fDSTTraceWidth );
     if( fDST_tree->GetBranchStatus( "Trace" ) )
     {
         fDST_tree->SetBranchAddress( "Trace", fDSTtrace );
@@ -448,14 +696,6 @@ bool VDSTTree::initDSTTree( TTree* t, TTree* c )
     {
         fDST_tree->SetBranchAddress( "numSamples", fDSTnumSamples );
     }
-    fDST_tree->SetBranchAddress( "pulsetiminglevel", fDSTpulsetiminglevels );
-    fDST_tree->SetBranchAddress( "pulsetiming", fDSTpulsetiming );
-    fDST_tree->SetBranchAddress( "Max", fDSTMax );
-    if( fFullTree )
-    {
-        fDST_tree->SetBranchAddress( "RawMax", fDSTRawMax );
-    }
-    fDST_tree->SetBranchAddress( "HiLo", fDSTHiLo );
     if( fMC )
     {
         fDST_tree->SetBranchAddress( "MCprim", &fDSTprimary );
@@ -0,0 +1,186 @@
+/*! \class VDSTWriter
+    \brief fills a DST tree in a background thread
+
+    The event loop fills the branch buffers of a staging tree (never filled
+    or written) as before. fill() copies the content of all branches of the
+    current event into a compact byte record (variable length arrays are copied
+    up to their counter only) and queues it. The writer thread copies the record
+    into the branch buffers of the output tree and calls TTree::Fill(), so that
+    serialisation and compression of the baskets are done in parallel to the
+    event loop.
+
+    Staging and output tree must have the same branch structure (e.g. both
+    created with VDSTTree::initDSTTree() with the same arguments).
+
+*/
+
+#include "VDSTWriter.h"
+
+VDSTWriter::VDSTWriter( TTree* iStagingTree, TTree* iOutputTree, unsigned int iMaxQueueSize )
+{
+    fTree = iOutputTree;
+    fMaxQueueSize = ( iMaxQueueSize > 0 ? iMaxQueueSize : 1 );
+    fStop = false;
+    fTerminated = false;
+
+    if( !iStagingTree || !iOutputTree
+            || iStagingTree->GetListOfBranches()->GetEntries() != iOutputTree->GetListOfBranches()->GetEntries() )
+    {
+        cout << "VDSTWriter::VDSTWriter error: staging and output tree differ" << endl;
+        exit( EXIT_FAILURE );
+    }
+    TObjArray* iSB = iStagingTree->GetListOfBranches();
+    TObjArray* iOB = iOutputTree->GetListOfBranches();
+    for( int b = 0; b < iOB->GetEntries(); b++ )
+    {
+        TBranch* iS = ( TBranch* )iSB->At( b );
+        TBranch* iO = ( TBranch* )iOB->At( b );
+        TLeaf* iL = ( TLeaf* )iO->GetListOfLeaves()->At( 0 );
+        if( !iS || !iO || !iL || string( iS->GetName() ) != iO->GetName()
+                || iO->GetListOfLeaves()->GetEntries() != 1 )
+        {
+            cout << "VDSTWriter::VDSTWriter error: unsupported branch structure (branch " << b << ")" << endl;
+            exit( EXIT_FAILURE );
+        }
+        fStagingAddress.push_back( iS->GetAddress() );
+        fOutputAddress.push_back( iO->GetAddress() );
+        fBranchSize.push_back( iL->GetLenType() * iL->GetLenStatic() );
+        fStagingCounter.push_back( 0 );
+        fOutputCounter.push_back( 0 );
+        // variable length array: counter has to be an unsigned int branch filled before this branch
+        if( iL->GetLeafCount() )
+        {
+            TLeaf* iC = iL->GetLeafCount();
+            int c = iOB->IndexOf( iC->GetBranch() );
+            if( c < 0 || c >= b || string( iC->GetTypeName() ) != "UInt_t" )
+            {
+                cout << "VDSTWriter::VDSTWriter error: unsupported array counter for branch " << iO->GetName() << endl;
+                exit( EXIT_FAILURE );
+            }
+            fStagingCounter.back() = ( unsigned int* )fStagingAddress[c];
+            fOutputCounter.back() = ( unsigned int* )fOutputAddress[c];
+        }
+    }
+    ROOT::EnableThreadSafety();
+
+    fThread = thread( &VDSTWriter::work, this );
+}
+
+
+VDSTWriter::~VDSTWriter()
+{
+    terminate();
+    for( unsigned int i = 0; i < fFreeRecords.size(); i++ )
+    {
+        delete fFreeRecords[i];
+    }
+}
+
+
+/*
+ * copy current event from the staging buffers and queue it
+ * (waits if the writer thread is too far behind)
+*/
+void VDSTWriter::fill()
+{
+    vector< char >* iRecord = 0;
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fCondition_space.wait( iLock, [this] { return fQueue.size() < fMaxQueueSize; } );
+        if( fFreeRecords.size() > 0 )
+        {
+            iRecord = fFreeRecords.back();
+            fFreeRecords.pop_back();
+        }
+    }
+    if( !iRecord )
+    {
+        iRecord = new vector< char >();
+    }
+    // record size
+    size_t n = 0;
+    for( unsigned int b = 0; b < fStagingAddress.size(); b++ )
+    {
+        n += ( size_t )fBranchSize[b] * ( fStagingCounter[b] ? *fStagingCounter[b] : 1 );
+    }
+    iRecord->resize( n );
+    // copy branch buffers
+    n = 0;
+    for( unsigned int b = 0; b < fStagingAddress.size(); b++ )
+    {
+        size_t s = ( size_t )fBranchSize[b] * ( fStagingCounter[b] ? *fStagingCounter[b] : 1 );
+        if( s > 0 )
+        {
+            memcpy( &( *iRecord )[n], fStagingAddress[b], s );
+        }
+        n += s;
+    }
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fQueue.push_back( iRecord );
+    }
+    fCondition_fill.notify_one();
+}
+
+
+/*
+ * wait until all queued events are filled and stop writer thread
+*/
+void VDSTWriter::terminate()
+{
+    if( fTerminated )
+    {
+        return;
+    }
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fStop = true;
+    }
+    fCondition_fill.notify_one();
+    if( fThread.joinable() )
+    {
+        fThread.join();
+    }
+    fTerminated = true;
+}
+
+
+/*
+ * writer thread: copy records into output buffers and fill tree
+ *
+ * (counters are copied before the arrays depending on them, so
+ *  that the array length can be taken from the output buffers)
+*/
+void VDSTWriter::work()
+{
+    for( ;; )
+    {
+        vector< char >* iRecord = 0;
+        {
+            unique_lock< mutex > iLock( fMutex );
+            fCondition_fill.wait( iLock, [this] { return fStop || fQueue.size() > 0; } );
+            if( fQueue.size() == 0 )
+            {
+                return;
+            }
+            iRecord = fQueue.front();
+            fQueue.pop_front();
+        }
+        fCondition_space.notify_one();
+
+        size_t n = 0;
+        for( unsigned int b = 0; b < fOutputAddress.size(); b++ )
+        {
+            size_t s = ( size_t )fBranchSize[b] * ( fOutputCounter[b] ? *fOutputCounter[b] : 1 );
+            if( s > 0 && n + s <= iRecord->size() )
+            {
+                memcpy( fOutputAddress[b], &( *iRecord )[n], s );
+            }
+            n += s;
+        }
+        fTree->Fill();
+
+        unique_lock< mutex > iLock( fMutex );
+        fFreeRecords.push_back( iRecord );
+    }
+}
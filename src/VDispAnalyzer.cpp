@@ -36,6 +36,14 @@ VDispAnalyzer::VDispAnalyzer()
     setDispErrorWeighting();
     setDebug( false );
 }
+
+VDispAnalyzer::~VDispAnalyzer()
+{
+    if( fTMVADispAnalyzer )
+    {
+        delete fTMVADispAnalyzer;
+    }
+}
 void VDispAnalyzer::setTelescopeTypeList( vector<ULong64_t> iTelescopeTypeList )
 {
     fTelescopeTypeList = iTelescopeTypeList;
@@ -5,6 +5,10 @@
 
 #include "VEventLoop.h"
 
+// trace handlers of the worker threads of the thread pool
+// (copies of fTraceHandlerTemplate, freed when the worker threads end)
+static thread_local unique_ptr< VTraceHandler > fWorkerTraceHandler;
+
 //! standard constructor
 /*!
     \param irunparameter Pointer to run parameters (from command line or config file)
@@ -106,11 +110,46 @@ VEventLoop::VEventLoop( VEvndispRunParameter* irunparameter )
     fDST = 0;
     if( fRunMode == R_DST )
     {
-        fDST = new VDST( ( fRunMode == R_DST ), ( fRunPar->fsourcetype == 1 || fRunPar->fsourcetype == 2 || fRunPar->fsourcetype == 6 ) );
+        fDST = new VDST( ( fRunMode == R_DST ), ( fRunPar->fsourcetype == 1 || fRunPar->fsourcetype == 2 || fRunPar->fsourcetype == 6 || fRunPar->fsourcetype == 8 ) );
+    }
+
+    // profiler for analysis stages
+    if( fRunPar->fProfile && !fProfiler )
+    {
+        fProfiler = new VEvndispProfiler();
+        for( unsigned int i = 0; i < fRunPar->fImageCleaningParameters.size(); i++ )
+        {
+            if( fRunPar->fImageCleaningParameters[i] )
+            {
+                unsigned int iMethod = fRunPar->fImageCleaningParameters[i]->getImageCleaningMethodIndex();
+                fProfiler->setStageName( VEvndispProfiler::getImageCleaningStageID( iMethod ),
+                                         "image cleaning (" + fRunPar->fImageCleaningParameters[i]->getImageCleaningMethod() + ")" );
+            }
+        }
     }
 
     // create analyzer (one for all telescopes)
     fAnalyzer = new VImageAnalyzer();
+    // multi-threaded image analysis: one analyzer per telescope
+    fThreadPool = 0;
+    fTraceHandlerTemplate = 0;
+    if( fRunPar->fNThreads > 1 && fRunPar->frunmode == R_ANA )
+    {
+        ROOT::EnableThreadSafety();
+        for( unsigned int i = 0; i < fNTel; i++ )
+        {
+            if( i == 0 )
+            {
+                fTelAnalyzer.push_back( fAnalyzer );
+            }
+            else
+            {
+                fTelAnalyzer.push_back( new VImageAnalyzer() );
+            }
+        }
+        fTraceHandlerTemplate = new VTraceHandler( *fTraceHandler );
+        fThreadPool = new VThreadPool( fRunPar->fNThreads );
+    }
     // create new pedestal calculator
     fPedestalCalculator = new VPedestalCalculator();
 
@@ -240,7 +279,7 @@ bool VEventLoop::initEventLoop( string iFileName )
     fEventNumber = 0;
 
     // check if file exists (bizarre return value)
-    if( gSystem->AccessPathName( iFileName.c_str() ) && fRunPar->fsourcetype != 5 )
+    if( gSystem->AccessPathName( iFileName.c_str() ) && fRunPar->fsourcetype != 5 && fRunPar->fsourcetype != 8 )
     {
         cout << endl;
         cout << "VEventLoop::initEventLoop error; sourcefile not found: |" << iFileName << "|" << endl;
@@ -266,7 +305,9 @@ bool VEventLoop::initEventLoop( string iFileName )
             }
             else
             {
-                fRawDataReader = new VBFDataReader( fRunPar->fsourcefile, fRunPar->fsourcetype, fRunPar->fNTelescopes, fDebug, fRunPar->fPrintGrisuHeader );
+                VBFDataReader* i_vbfReader = new VBFDataReader( fRunPar->fsourcefile, fRunPar->fsourcetype, fRunPar->fNTelescopes, fDebug, fRunPar->fPrintGrisuHeader );
+                i_vbfReader->setReadAhead( fRunPar->fReadAheadEvents );
+                fRawDataReader = i_vbfReader;
                 /////////////////////////////////////////////////////////////////////
                 // open temporary file (do make sure that event numbering is correct)
                 // get number of samples
@@ -422,6 +463,11 @@ bool VEventLoop::initEventLoop( string iFileName )
             delete fDSTReader;
         }
         fDSTReader = new VDSTReader( fRunPar->fsourcefile, fRunPar->fIsMC, fRunPar->fNTelescopes, fDebug );
+        fDSTReader->setReadAhead( fRunPar->fReadAheadEvents );
+        if( fRunPar->fdstsparse )
+        {
+            fDSTReader->setSparseReplay();
+        }
         if( fDSTReader->isMC() && fRunPar->fIsMC == 0 )
         {
             fRunPar->fIsMC = 1;
@@ -432,6 +478,19 @@ bool VEventLoop::initEventLoop( string iFileName )
         }
     }
     // ============================
+    // synthetic events
+    else if( fRunPar->fsourcetype == 8 )
+    {
+        if( fSyntheticDataReader != 0 )
+        {
+            delete fSyntheticDataReader;
+        }
+        fSyntheticDataReader = new VSyntheticDataReader( getDetectorGeo(), getDetectorGeo()->getNumTelescopes(),
+                ( fRunPar->fnevents > 0 ? ( unsigned int )fRunPar->fnevents : 1000 ),
+                fRunPar->fSynthImageSize, fRunPar->fSynthNSBRate, fRunPar->fsumwindow_1,
+                fRunPar->fgrisuseed, fDebug );
+    }
+    // ============================
     // set the data readers for all inherent class
     initializeDataReader();
 
@@ -598,6 +657,13 @@ void VEventLoop::initializeAnalyzers()
     {
         fAnalyzer->initializeDataReader();
         fAnalyzer->initOutput();
+        for( unsigned int i = 0; i < fTelAnalyzer.size(); i++ )
+        {
+            if( fTelAnalyzer[i] != fAnalyzer )
+            {
+                fTelAnalyzer[i]->initializeDataReader();
+            }
+        }
     }
     if( fArrayAnalyzer && fRunMode != R_PED && fRunMode != R_PEDLOW && fRunMode != R_GTO && fRunMode != R_GTOLOW
             && fRunMode != R_TZERO && fRunMode != R_TZEROLOW )
@@ -693,6 +759,12 @@ void VEventLoop::shutdown()
     endOfRunInfo();
     cout << endl << "-----------------------------------------------" << endl;
 
+    // print profile of analysis stages
+    if( fProfiler )
+    {
+        fProfiler->print( fNumberofGoodEvents );
+    }
+
     // if we have the proper settings,
     // print the dead pixel information
     if( ( fRunPar->frunmode == R_ANA || fRunPar->frunmode == R_GTO ) && fRunPar->fprintdeadpixelinfo ) // DEADCHAN
@@ -810,6 +882,16 @@ void VEventLoop::shutdown()
                 fAnalyzer->terminate( fDebug_writing );
             }
         }
+        // write profile of analysis stages to output file
+        if( fProfiler && fOutputfile )
+        {
+            fOutputfile->cd();
+            TTree* iProfileTree = fProfiler->getTree();
+            if( iProfileTree )
+            {
+                iProfileTree->Write();
+            }
+        }
         // close output file here (!! CLOSE OUTPUT FILE FOREVER !!)
         fAnalyzer->shutdown();
     }
@@ -838,6 +920,22 @@ void VEventLoop::shutdown()
     {
         delete fGrIsuReader;
     }
+    if( fSyntheticDataReader )
+    {
+        delete fSyntheticDataReader;
+        fSyntheticDataReader = 0;
+    }
+    // stop worker threads (frees the trace handlers of the worker threads)
+    if( fThreadPool )
+    {
+        delete fThreadPool;
+        fThreadPool = 0;
+    }
+    if( fTraceHandlerTemplate )
+    {
+        delete fTraceHandlerTemplate;
+        fTraceHandlerTemplate = 0;
+    }
     if( fDebug )
     {
         cout << "VEventLoop::shutdown() ... finished" << endl;
@@ -1008,7 +1106,10 @@ bool VEventLoop::nextEvent()
     {
         // get next event from data reader and check
         // if there is a next event (or EOF) ??
-        if( !fReader->getNextEvent() )
+        VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_READEVENT );
+        bool bNextEvent = fReader->getNextEvent();
+        iProfilerTimer.stop();
+        if( !bNextEvent )
         {
             // check if this getNextEvent() failed due to an invalid event
             if( fReader->getEventStatus() < 999 )
@@ -1115,6 +1216,42 @@ bool VEventLoop::nextEvent()
 }
 
 
+/*!
+     image analysis for a list of telescopes using the thread pool
+
+     - telescopes analyzed for the first time are initialized and
+       analyzed sequentially (booking of trees, reading of calibration data)
+     - output trees are not filled (call VImageAnalyzer::fillDeferredOutputTree())
+*/
+void VEventLoop::analyzeImagesParallel( vector< unsigned int > iTelList )
+{
+    vector< unsigned int > i_tel;
+    for( unsigned int i = 0; i < iTelList.size(); i++ )
+    {
+        setTelID( iTelList[i] );
+        if( !getImageParameters()->getTree() )
+        {
+            fTelAnalyzer[iTelList[i]]->doAnalysis( false );
+        }
+        else
+        {
+            i_tel.push_back( iTelList[i] );
+        }
+    }
+    fThreadPool->run( i_tel.size(), [this, &i_tel]( unsigned int t )
+    {
+        // each thread has its own trace handler
+        if( !fTraceHandler )
+        {
+            fWorkerTraceHandler.reset( new VTraceHandler( *fTraceHandlerTemplate ) );
+            fTraceHandler = fWorkerTraceHandler.get();
+        }
+        fTelAnalyzer[i_tel[t]]->setTelID( i_tel[t] );
+        fTelAnalyzer[i_tel[t]]->doAnalysis( false );
+    } );
+}
+
+
 /*!
      check run mode and call the analyzers
 */
@@ -1126,10 +1263,14 @@ int VEventLoop::analyzeEvent()
         cout << "\t now at event " << getEventNumber() << endl;
         cout << "----------------------------------------" << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_EVENTANALYSIS );
     // analysis is running
     fAnalyzeMode = true;
     int i_cut = 0;
     int i_cutTemp = 0;
+    // telescopes for multi-threaded image analysis
+    vector< unsigned int > i_parallelTel;
+    vector< bool > i_parallelAnalysis;
 
     // short cut for dst writing
     if( fRunMode == R_DST && fDST )
@@ -1300,6 +1441,14 @@ int VEventLoop::analyzeEvent()
                 if( fReader->getATEventType() != VEventType::PED_TRIGGER )
 #endif
                 {
+                    // multi-threaded image analysis: analyze
+                    // and check cuts after looping over all telescopes
+                    if( fThreadPool )
+                    {
+                        i_parallelTel.push_back( fRunPar->fTelToAnalyze[i] );
+                        i_parallelAnalysis.push_back( !fRunPar->fWriteTriggerOnly || fReader->hasArrayTrigger() );
+                        break;
+                    }
                     if( !fRunPar->fWriteTriggerOnly || fReader->hasArrayTrigger() )
                     {
                         fAnalyzer->doAnalysis();
@@ -1411,6 +1560,39 @@ int VEventLoop::analyzeEvent()
         }
     }
     /////////////////////////////////////////////////////////////////////////
+    // multi-threaded image analysis
+    // (filling of trees and cuts in the same order as for the single-threaded analysis)
+    if( i_parallelTel.size() > 0 )
+    {
+        vector< unsigned int > i_analysisTel;
+        for( unsigned int i = 0; i < i_parallelTel.size(); i++ )
+        {
+            if( i_parallelAnalysis[i] )
+            {
+                i_analysisTel.push_back( i_parallelTel[i] );
+            }
+        }
+        analyzeImagesParallel( i_analysisTel );
+
+        for( unsigned int i = 0; i < i_parallelTel.size(); i++ )
+        {
+            setTelID( i_parallelTel[i] );
+            if( i_parallelAnalysis[i] )
+            {
+                fTelAnalyzer[i_parallelTel[i]]->fillDeferredOutputTree();
+            }
+            i_cutTemp = checkCuts();
+            if( i_cut > 0 && !fCutTelescope )
+            {
+                i_cut = 1;
+            }
+            else
+            {
+                i_cut = i_cutTemp;
+            }
+        }
+    }
+    /////////////////////////////////////////////////////////////////////////
     // ARRAY ANALYSIS
     if( fRunMode != R_PED && fRunMode != R_GTO && fRunMode != R_GTOLOW && fRunMode != R_PEDLOW && fRunMode != R_TZERO && fRunMode != R_TZEROLOW )
     {
@@ -129,6 +129,10 @@ bool VEvndispData::initializeDataReader()
     {
         fReader = ( VVirtualDataReader* )fMultipleGrIsuReader;
     }
+    else if( fSyntheticDataReader != 0 )
+    {
+        fReader = ( VVirtualDataReader* )fSyntheticDataReader;
+    }
 
     if( !fReader )
     {
@@ -178,6 +182,10 @@ void VEvndispData::testDataReader()
         {
             fReader = ( VVirtualDataReader* )fDSTReader;
         }
+        else if( fRunPar->fsourcetype == 8  && fSyntheticDataReader != 0 )
+        {
+            fReader = ( VVirtualDataReader* )fSyntheticDataReader;
+        }
         else
         {
             cout << "VEvndispData::testDataReader() error: no reader found" << endl;
@@ -222,8 +230,9 @@ void VEvndispData::setDetectorGeometry( unsigned int iNTel, vector< string > iCa
         }
     }
     // read detector geometry from a configuration file and/or DB
-    // (all cases but DSTs)
-    if( getRunParameter()->fsourcetype != 7 && getRunParameter()->fsourcetype != 4 )
+    // (all cases but DSTs and synthetic events)
+    if( getRunParameter()->fsourcetype != 7 && getRunParameter()->fsourcetype != 4
+            && getRunParameter()->fsourcetype != 8 )
     {
         fDetectorGeo = new VDetectorGeometry( iNTel, iCamera, iDir, fDebug,
                                               getRunParameter()->fCameraCoordinateTransformX, getRunParameter()->fCameraCoordinateTransformY,
@@ -238,6 +247,14 @@ void VEvndispData::setDetectorGeometry( unsigned int iNTel, vector< string > iCa
                 getRunParameter()->fDBCameraRotationMeasurements );
         }
     }
+    // synthetic events: hexagonal camera
+    else if( getRunParameter()->fsourcetype == 8 )
+    {
+        fDetectorGeo = new VDetectorGeometry( iNTel, fDebug );
+        fDetectorGeo->setSourceType( getRunParameter()->fsourcetype );
+        VSyntheticDataReader::fillDetectorGeometry( fDetectorGeo, iNTel,
+                getRunParameter()->fSynthNPixel, getRunParameter()->fSynthNSamples );
+    }
     // for DST files: read detector geometry from DST file
     // (telconfig tree)
     else
@@ -1146,7 +1163,7 @@ VEvndispRunParameter* VEvndispData::fRunPar = 0;
 
 // telescope data
 unsigned int VEvndispData::fNTel = 1;
-unsigned int VEvndispData::fTelID = 0;
+thread_local unsigned int VEvndispData::fTelID = 0;
 vector< unsigned int > VEvndispData::fTeltoAna;
 VDetectorGeometry* VEvndispData::fDetectorGeo = 0;
 VDetectorTree* VEvndispData::fDetectorTree = 0;
@@ -1163,6 +1180,7 @@ VMultipleGrIsuReader* VEvndispData::fMultipleGrIsuReader = 0;
 VBaseRawDataReader* VEvndispData::fRawDataReader = 0;
 #endif
 VDSTReader* VEvndispData::fDSTReader = 0;
+VSyntheticDataReader* VEvndispData::fSyntheticDataReader = 0;
 
 // event data
 unsigned int VEvndispData::fEventNumber = 0;
@@ -1183,7 +1201,8 @@ vector< int > VEvndispData::fEventMJD;
 vector< double > VEvndispData::fEventTime;
 
 // trace handler
-VTraceHandler* VEvndispData::fTraceHandler = 0;
+VEvndispProfiler* VEvndispData::fProfiler = 0;
+thread_local VTraceHandler* VEvndispData::fTraceHandler = 0;
 VFitTraceHandler* VEvndispData::fFitTraceHandler = 0;
 
 //calibration data
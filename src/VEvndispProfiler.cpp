@@ -0,0 +1,373 @@
+/*! \class VEvndispProfiler
+    \brief wall/cpu time, call counts, and memory usage of the analysis stages
+
+    Stages are identified by a fixed ID (see E_ProfilerStage) and timed
+    with VEvndispProfilerTimer:
+
+    {
+        VEvndispProfilerTimer iTimer( getProfiler(), E_PROF_IMAGEPARAMETERS );
+        ...
+    }
+
+    Stages without calls are not printed.
+
+    Stages can be nested (e.g. tree filling is part of the array analysis).
+    CPU times are measured per thread, i.e. stages executed in parallel
+    (multi-threaded image analysis) sum up the cpu time of all threads.
+
+    Peak RSS is the maximum resident set size of the process (as reported
+    by getrusage()) at the end of the stage. The increase of the peak RSS
+    during a stage indicates which stage drives the memory usage.
+
+    Switched on with the command line option -profile.
+
+    Timings per event can be written to and compared with a baseline
+    text file (see bench_evndisp).
+
+*/
+
+#include "VEvndispProfiler.h"
+
+VEvndispProfiler::VEvndispProfiler()
+{
+    fStartTime = chrono::steady_clock::now();
+
+    fStageName.push_back( "read event (getNextEvent)" );
+    fStageName.push_back( "event analysis (total)" );
+    fStageName.push_back( "trace integration (calcSums)" );
+    fStageName.push_back( "trace timing (calcTZeros)" );
+    fStageName.push_back( "trace integration (calcTZerosSums)" );
+    fStageName.push_back( "trace integration (calcSecondTZerosSums)" );
+    fStageName.push_back( "image parameters (calcParameters)" );
+    fStageName.push_back( "image timing parameters (calcTimingParameters)" );
+    fStageName.push_back( "LL image fit (calcLL)" );
+    fStageName.push_back( "muon ring analysis" );
+    fStageName.push_back( "Hough transform muon analysis" );
+    fStageName.push_back( "array analysis" );
+    fStageName.push_back( "tree filling (image parameters)" );
+    fStageName.push_back( "tree filling (shower parameters)" );
+    for( unsigned int i = 0; i < fNImageCleaningMethods; i++ )
+    {
+        ostringstream iName;
+        iName << "image cleaning (method " << i << ")";
+        fStageName.push_back( iName.str() );
+    }
+    fNCalls.assign( fStageName.size(), 0 );
+    fWallTime.assign( fStageName.size(), 0. );
+    fCPUTime.assign( fStageName.size(), 0. );
+    fPeakRSS.assign( fStageName.size(), 0. );
+    fPeakRSSIncrease.assign( fStageName.size(), 0. );
+}
+
+
+/*
+    set name of a stage (e.g. image cleaning method)
+
+    (call before the event loop)
+*/
+void VEvndispProfiler::setStageName( unsigned int iStageID, string iStageName )
+{
+    unique_lock< mutex > iLock( fMutex );
+    if( iStageID < fStageName.size() )
+    {
+        fStageName[iStageID] = iStageName;
+    }
+}
+
+
+void VEvndispProfiler::fill( unsigned int iStageID, double iWallTime, double iCPUTime, double iPeakRSS_start, double iPeakRSS_stop )
+{
+    unique_lock< mutex > iLock( fMutex );
+    if( iStageID >= fStageName.size() )
+    {
+        return;
+    }
+    fNCalls[iStageID]++;
+    fWallTime[iStageID] += iWallTime;
+    fCPUTime[iStageID] += iCPUTime;
+    if( iPeakRSS_stop > fPeakRSS[iStageID] )
+    {
+        fPeakRSS[iStageID] = iPeakRSS_stop;
+    }
+    if( iPeakRSS_stop > iPeakRSS_start )
+    {
+        fPeakRSSIncrease[iStageID] += iPeakRSS_stop - iPeakRSS_start;
+    }
+}
+
+
+/*
+    cpu time of the calling thread [s]
+*/
+double VEvndispProfiler::getCPUTime()
+{
+    struct timespec iT;
+    if( clock_gettime( CLOCK_THREAD_CPUTIME_ID, &iT ) != 0 )
+    {
+        return 0.;
+    }
+    return ( double )iT.tv_sec + 1.e-9 * ( double )iT.tv_nsec;
+}
+
+
+/*
+    peak resident set size of the process [MB]
+*/
+double VEvndispProfiler::getPeakRSS()
+{
+    struct rusage iUsage;
+    if( getrusage( RUSAGE_SELF, &iUsage ) != 0 )
+    {
+        return 0.;
+    }
+#ifdef __APPLE__
+    // bytes
+    return ( double )iUsage.ru_maxrss / 1024. / 1024.;
+#else
+    // kilobytes
+    return ( double )iUsage.ru_maxrss / 1024.;
+#endif
+}
+
+
+/*
+    print table with timing results for all stages
+
+    iNEvents: number of events analysed (for throughput calculation)
+*/
+void VEvndispProfiler::print( unsigned int iNEvents )
+{
+    unique_lock< mutex > iLock( fMutex );
+
+    double iTotalTime = chrono::duration< double >( chrono::steady_clock::now() - fStartTime ).count();
+
+    cout << endl;
+    cout << "Profile of analysis stages (stages can be nested)" << endl;
+    cout << "=================================================" << endl;
+    cout << setw( 45 ) << left << "stage" << right;
+    cout << setw( 12 ) << "calls";
+    cout << setw( 12 ) << "wall [s]";
+    cout << setw( 12 ) << "cpu [s]";
+    cout << setw( 14 ) << "wall/call[us]";
+    cout << setw( 10 ) << "wall [%]";
+    cout << setw( 14 ) << "peak RSS[MB]";
+    cout << setw( 14 ) << "d(RSS) [MB]" << endl;
+    for( unsigned int i = 0; i < fStageName.size(); i++ )
+    {
+        if( fNCalls[i] == 0 )
+        {
+            continue;
+        }
+        cout << setw( 45 ) << left << fStageName[i] << right;
+        cout << setw( 12 ) << fNCalls[i];
+        cout << fixed << setprecision( 3 );
+        cout << setw( 12 ) << fWallTime[i];
+        cout << setw( 12 ) << fCPUTime[i];
+        cout << setprecision( 2 );
+        cout << setw( 14 ) << ( fNCalls[i] > 0 ? 1.e6 * fWallTime[i] / ( double )fNCalls[i] : 0. );
+        cout << setprecision( 1 );
+        cout << setw( 10 ) << ( iTotalTime > 0. ? 100. * fWallTime[i] / iTotalTime : 0. );
+        cout << setw( 14 ) << fPeakRSS[i];
+        cout << setw( 14 ) << fPeakRSSIncrease[i];
+        cout << endl;
+        cout.unsetf( ios::fixed );
+        cout << setprecision( 6 );
+    }
+    cout << "total wall time: " << iTotalTime << " s";
+    if( iNEvents > 0 && iTotalTime > 0. )
+    {
+        cout << ", " << iNEvents << " events (" << ( double )iNEvents / iTotalTime << " events/s)";
+    }
+    cout << ", peak RSS: " << getPeakRSS() << " MB" << endl;
+    cout << endl;
+}
+
+
+/*
+    write wall time per event for all stages to a text file
+
+    format: one line per stage, <wall time per event [us]> <stage name>
+*/
+bool VEvndispProfiler::writeBaseline( string iFile, unsigned int iNEvents )
+{
+    unique_lock< mutex > iLock( fMutex );
+
+    ofstream os( iFile.c_str() );
+    if( !os )
+    {
+        cout << "VEvndispProfiler::writeBaseline error: cannot open " << iFile << endl;
+        return false;
+    }
+    if( iNEvents == 0 )
+    {
+        iNEvents = 1;
+    }
+    os << "# evndisp profile baseline: wall time per event [us] and stage (" << iNEvents << " events)" << endl;
+    os << fixed << setprecision( 3 );
+    for( unsigned int i = 0; i < fStageName.size(); i++ )
+    {
+        if( fNCalls[i] == 0 )
+        {
+            continue;
+        }
+        os << 1.e6 * fWallTime[i] / ( double )iNEvents << "\t" << fStageName[i] << endl;
+    }
+    os.close();
+    cout << "profile baseline written to " << iFile << endl;
+    return true;
+}
+
+
+/*
+    compare wall time per event for all stages with a baseline file (see writeBaseline())
+
+    stages slower than the baseline by more than the fractional tolerance are
+    reported as regressions (stages with less than 1 us per event are ignored)
+
+    returns number of regressions
+*/
+unsigned int VEvndispProfiler::compareWithBaseline( string iFile, unsigned int iNEvents, double iTolerance )
+{
+    unique_lock< mutex > iLock( fMutex );
+
+    ifstream is( iFile.c_str() );
+    if( !is )
+    {
+        cout << "VEvndispProfiler::compareWithBaseline error: cannot open baseline file " << iFile << endl;
+        return 1;
+    }
+    map< string, double > iBaseline;
+    string iLine;
+    while( getline( is, iLine ) )
+    {
+        if( iLine.size() == 0 || iLine[0] == '#' )
+        {
+            continue;
+        }
+        size_t iTab = iLine.find( '\t' );
+        if( iTab == string::npos )
+        {
+            continue;
+        }
+        iBaseline[iLine.substr( iTab + 1 )] = atof( iLine.substr( 0, iTab ).c_str() );
+    }
+    if( iNEvents == 0 )
+    {
+        iNEvents = 1;
+    }
+
+    unsigned int iNRegressions = 0;
+    cout << endl;
+    cout << "Comparison with baseline " << iFile << " (tolerance " << 100. * iTolerance << "%)" << endl;
+    cout << "======================================================================" << endl;
+    cout << setw( 45 ) << left << "stage" << right;
+    cout << setw( 14 ) << "base[us/evt]";
+    cout << setw( 14 ) << "now[us/evt]";
+    cout << setw( 14 ) << "events/s";
+    cout << setw( 10 ) << "diff[%]" << endl;
+    for( unsigned int i = 0; i < fStageName.size(); i++ )
+    {
+        if( fNCalls[i] == 0 )
+        {
+            continue;
+        }
+        double iNow = 1.e6 * fWallTime[i] / ( double )iNEvents;
+        cout << setw( 45 ) << left << fStageName[i] << right;
+        cout << fixed << setprecision( 2 );
+        map< string, double >::iterator iB = iBaseline.find( fStageName[i] );
+        if( iB == iBaseline.end() )
+        {
+            cout << setw( 14 ) << "-";
+        }
+        else
+        {
+            cout << setw( 14 ) << iB->second;
+        }
+        cout << setw( 14 ) << iNow;
+        cout << setprecision( 1 );
+        cout << setw( 14 ) << ( iNow > 0. ? 1.e6 / iNow : 0. );
+        if( iB != iBaseline.end() && iB->second > 0. )
+        {
+            double iDiff = iNow / iB->second - 1.;
+            cout << setw( 10 ) << 100. * iDiff;
+            if( iDiff > iTolerance && iNow > 1. )
+            {
+                cout << "  <-- REGRESSION";
+                iNRegressions++;
+            }
+        }
+        cout << endl;
+        cout.unsetf( ios::fixed );
+        cout << setprecision( 6 );
+    }
+    cout << "number of stages slower than baseline: " << iNRegressions << endl;
+    cout << endl;
+
+    return iNRegressions;
+}
+
+
+/*
+    tree with timing results (one entry per stage)
+*/
+TTree* VEvndispProfiler::getTree( string iName )
+{
+    unique_lock< mutex > iLock( fMutex );
+
+    char iStage[300];
+    Long64_t iNCalls = 0;
+    double iWallTime = 0.;
+    double iCPUTime = 0.;
+    double iPeakRSS = 0.;
+    double iPeakRSSIncrease = 0.;
+    TTree* iTree = new TTree( iName.c_str(), "evndisp profile of analysis stages" );
+    iTree->Branch( "stage", iStage, "stage/C" );
+    iTree->Branch( "ncalls", &iNCalls, "ncalls/L" );
+    iTree->Branch( "walltime", &iWallTime, "walltime/D" );
+    iTree->Branch( "cputime", &iCPUTime, "cputime/D" );
+    iTree->Branch( "peakRSS", &iPeakRSS, "peakRSS/D" );
+    iTree->Branch( "peakRSSIncrease", &iPeakRSSIncrease, "peakRSSIncrease/D" );
+    for( unsigned int i = 0; i < fStageName.size(); i++ )
+    {
+        if( fNCalls[i] == 0 )
+        {
+            continue;
+        }
+        snprintf( iStage, 300, "%s", fStageName[i].c_str() );
+        iNCalls = ( Long64_t )fNCalls[i];
+        iWallTime = fWallTime[i];
+        iCPUTime = fCPUTime[i];
+        iPeakRSS = fPeakRSS[i];
+        iPeakRSSIncrease = fPeakRSSIncrease[i];
+        iTree->Fill();
+    }
+    // branch addresses are local variables
+    iTree->ResetBranchAddresses();
+    return iTree;
+}
+
+
+void VEvndispProfilerTimer::start( VEvndispProfiler* iProfiler, unsigned int iStageID )
+{
+    fProfiler = iProfiler;
+    fStageID = iStageID;
+    fPeakRSS_start = VEvndispProfiler::getPeakRSS();
+    fCPUTime_start = VEvndispProfiler::getCPUTime();
+    fWallTime_start = chrono::steady_clock::now();
+}
+
+
+/*
+    stop timer (called by destructor; can be called earlier)
+*/
+void VEvndispProfilerTimer::stop()
+{
+    if( !fProfiler )
+    {
+        return;
+    }
+    double iWallTime = chrono::duration< double >( chrono::steady_clock::now() - fWallTime_start ).count();
+    double iCPUTime = VEvndispProfiler::getCPUTime() - fCPUTime_start;
+    fProfiler->fill( fStageID, iWallTime, iCPUTime, fPeakRSS_start, VEvndispProfiler::getPeakRSS() );
+    fProfiler = 0;
+}
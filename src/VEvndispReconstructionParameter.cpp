@@ -58,7 +58,7 @@ void VEvndispReconstructionParameter::reset()
 */
 bool VEvndispReconstructionParameter::applyArrayAnalysisCuts( unsigned int iMeth, unsigned int iTel, unsigned int iTelType,
         VImageParameter* iImageParameter, unsigned short int iLocalTriggerType,
-        VStarCatalogue* iStarCatalogue )
+        float iStarDistance_deg )
 {
     // sanity checks
     if( iMeth >= fNMethods )
@@ -313,31 +313,19 @@ bool VEvndispReconstructionParameter::applyArrayAnalysisCuts( unsigned int iMeth
 
     ////////////////////////////////////////////
     // remove image which is too close to a bright star
-    // (use list of image and border pixels)
+    // (smallest distance of image and border pixels to a bright star,
+    //  calculated per telescope by the caller; negative if not calculated)
     // __this cut is disabled__
-    if( iStarCatalogue && fRunPara && iImageParameter->ntubes < fRunPara->fMinStarNTubes )
+    if( fRunPara && iStarDistance_deg >= 0. && iImageParameter->ntubes < fRunPara->fMinStarNTubes
+            && iStarDistance_deg < fRunPara->fMinStarPixelDistance_deg )
     {
-        for( unsigned int i = 0; i < iImageParameter->fImageBorderPixelPosition_x.size(); i++ )
+        iArrayCut = false;
+        if( fDebug )
         {
-            if( i < iImageParameter->fImageBorderPixelPosition_y.size() )
-            {
-                if( iStarCatalogue->getDistanceToClosestStar( iImageParameter->fImageBorderPixelPosition_x[i],
-                        iImageParameter->fImageBorderPixelPosition_y[i] ) < fRunPara->fMinStarPixelDistance_deg )
-                {
-                    iArrayCut = false;
-                    if( fDebug )
-                    {
-                        cout << "Telescope " << iTel + 1 << endl;
-                        cout << "VEvndispReconstructionParameter::applyArrayAnalysisCut: bright star cut: ";
-                        cout << iStarCatalogue->getDistanceToClosestStar( iImageParameter->cen_x, iImageParameter->cen_y );
-                        cout << " (" << fRunPara->fMinStarPixelDistance_deg << " deg )" << endl;
-                    }
-                    if( !iArrayCut )
-                    {
-                        break;
-                    }
-                }
-            }
+            cout << "Telescope " << iTel + 1 << endl;
+            cout << "VEvndispReconstructionParameter::applyArrayAnalysisCut: bright star cut: ";
+            cout << iStarDistance_deg;
+            cout << " (" << fRunPara->fMinStarPixelDistance_deg << " deg )" << endl;
         }
     }
 
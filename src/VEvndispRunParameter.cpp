@@ -44,7 +44,7 @@ VEvndispRunParameter::VEvndispRunParameter( bool bSetGlobalParameter ) : VGlobal
     fRunTitle  = "";
     fsourcetype = 3;           // 0 = rawdata, 1 = GrIsu simulation, 2 = MC in VBF format,
     // 3 = rawdata in VBF, 4 = DST (data), 5 = multiple GrIsu file,
-    // 6 = PE file, 7 = DST (MC)
+    // 6 = PE file, 7 = DST (MC), 8 = synthetic events
     fsourcefile = "";
 
     fDBRunType = "";
@@ -65,6 +65,9 @@ VEvndispRunParameter::VEvndispRunParameter( bool bSetGlobalParameter ) : VGlobal
     fFirstEvent = -10000;
     fTimeCutsMin_min = -99;
     fTimeCutsMin_max = -99;
+    fNThreads = 1;
+    fReadAheadEvents = 0;
+    fProfile = false;
     fIsMC = 0;
     fIgnoreCFGversions = false;
     fPrintAnalysisProgress = 25000;
@@ -83,6 +86,7 @@ VEvndispRunParameter::VEvndispRunParameter( bool bSetGlobalParameter ) : VGlobal
     fCalibrationDataType = 1;  // should be 0 for e.g. DSTs
     fcalibrationfile = "";
     fLowGainCalibrationFile = "calibrationlist.LowGain.dat";
+    fCalibrationCacheDirectory = "";
     fcalibrationrun = false;
     fNCalibrationEvents = -1;
     fNMinimumNumberOfPedestalEvents = 50;
@@ -162,6 +166,7 @@ VEvndispRunParameter::VEvndispRunParameter( bool bSetGlobalParameter ) : VGlobal
     fsumwindow_2.push_back( 12 );
     fsumwindow_pass1.push_back( 18 );
     fImageLL = 0;
+    fImageLLFitter = 0;
     fLogLikelihoodLoss_min.push_back( 1.e3 );
     fLogLikelihood_Ntubes_min.push_back( 0 );
     fForceLLImageFit = false;
@@ -246,6 +251,10 @@ VEvndispRunParameter::VEvndispRunParameter( bool bSetGlobalParameter ) : VGlobal
     fMCNdeadSeed = 0;
     fMCNdeadboard = 0;
     fMCScale = 1.;
+    fSynthNPixel = 499;
+    fSynthNSamples = 16;
+    fSynthImageSize = 100.;
+    fSynthNSBRate = 0.15;
 
     // display parameters
     fdisplaymode = false;
@@ -266,6 +275,10 @@ VEvndispRunParameter::VEvndispRunParameter( bool bSetGlobalParameter ) : VGlobal
     fdstfile = "";
     fdstminntubes = -1;
     fdstwriteallpixel = true;
+    fdstslim = false;
+    fdstasync = false;
+    fdstcompression = "";
+    fdstsparse = false;
 
     // NN cleaning parameters
     ifWriteGraphsToFile = false;
@@ -444,6 +457,29 @@ void VEvndispRunParameter::print( int iEv )
     {
         cout << "SGE TASK ID " << fSGE_TASK_ID << endl;
     }
+    if( fNThreads > 1 )
+    {
+        if( frunmode == 0 )
+        {
+            cout << "Image analysis with " << fNThreads << " threads" << endl;
+        }
+        else
+        {
+            cout << "Calibration calculations with " << fNThreads << " threads" << endl;
+        }
+    }
+    if( fReadAheadEvents > 0 )
+    {
+        cout << "Read ahead " << fReadAheadEvents << " events" << endl;
+    }
+    if( fdstsparse )
+    {
+        cout << "DST source file: sparse replay (copy hit channels only)" << endl;
+    }
+    if( fProfile )
+    {
+        cout << "Profiling of analysis stages" << endl;
+    }
 
     cout << endl;
     if( fTargetName.size() > 0 )
@@ -535,6 +571,11 @@ void VEvndispRunParameter::print( int iEv )
     if( frunmode == 4 )
     {
         cout << "dstfile: " << fdstfile << " (mintubes: " << fdstminntubes << ")" << endl;
+        if( fdstslim || fdstasync || fdstcompression.size() > 0 )
+        {
+            cout << "\t slim dst: " << fdstslim << ", writer thread: " << fdstasync;
+            cout << ", compression: " << ( fdstcompression.size() > 0 ? fdstcompression : "default" ) << endl;
+        }
     }
     cout << endl;
     if( fcalibrationfile.size() > 0 )
@@ -549,6 +590,10 @@ void VEvndispRunParameter::print( int iEv )
     {
         cout << "reading laser/flasher run numbers from database" << endl;
     }
+    if( fCalibrationCacheDirectory.size() > 0 )
+    {
+        cout << "calibration cache directory: " << fCalibrationCacheDirectory << endl;
+    }
     if( frunmode == 2 )
     {
         cout << "Minimum size required for laser events (lasermin): " << fLaserSumMin << " [dc]" << endl;
@@ -709,6 +754,10 @@ void VEvndispRunParameter::print( int iEv )
             cout << "loglikelihood fitting of images: " << fImageLL;
             cout << " (using these images for the array reconstruction)";
             cout << endl;
+            if( fImageLLFitter == 1 )
+            {
+                cout << "\t gradient based loglikelihood fitter" << endl;
+            }
         }
         cout << "Fraction of image/border pixel under image ellipse fact (FUI-factor): " << fImageAnalysisFUIFactor << endl;
     }
@@ -724,6 +773,12 @@ void VEvndispRunParameter::print( int iEv )
     {
         cout << "telescope numbering offset: " << ftelescopeNOffset << endl;
     }
+    if( fsourcetype == 8 )
+    {
+        cout << "synthetic events: " << fSynthNPixel << " pixels, " << fSynthNSamples << " samples, ";
+        cout << "image size " << fSynthImageSize << " pe, NSB rate " << fSynthNSBRate << " pe/ns";
+        cout << " (seed " << fgrisuseed << ")" << endl;
+    }
     if( fMCNdead > 0 )
     {
         cout << "Random dead channels: " << fMCNdead << " (seed " <<  fMCNdeadSeed << "), " << fMCNdeadboard << endl;
@@ -3,8 +3,9 @@
 
      Fit function is VFitTraceHandler_tracefunction()
 
-     Some work should be invested to make it faster:
-     (just now, it's a factor 90 slower than simple trace summing)
+     Fits are done with VTracePulseFitter on the FADC samples
+     (TF1 is used for plotting only). Fit results are kept per channel and
+     reused for repeated calls with the same trace (e.g. tzero and sum calculation).
 */
 
 #include "VFitTraceHandler.h"
@@ -27,23 +28,7 @@ f = A * \exp(-0.5*x^2/(\sigma^2+\alpha \cdot (x-\bar x) ) + pedestal
 */
 double VFitTraceHandler_tracefunction( double* x, double* p )
 {
-    double A = p[0];
-    double xbar = p[1];
-    double sig = p[2];
-    double alp = p[3];
-    double ped = p[4];
-    double xd = x[0] - xbar;
-    double f = 0.;
-
-    if( x[0] < xbar )
-    {
-        f = A * exp( -0.5 * xd * xd / sig / sig ) + ped;
-    }
-    else
-    {
-        f = A * exp( -0.5 * xd * xd / ( sig * sig + ( alp * xd ) ) ) + ped;
-    }
-    return f;
+    return VTracePulseFitter::evalEV( x[0], p );
 }
 
 
@@ -122,7 +107,6 @@ VFitTraceHandler::VFitTraceHandler( string iFit )
         cout << "VFitTraceHandler::VFitTraceHandler: failed defining fit functions, exiting..." << endl;
         exit( -1 );
     }
-    fH1TraceData = new TH1D( "fH1TraceHandlerData", "", ( int )fMaxSamples, 0., fMaxSamples );
     // plotting histogram
     fH1Trace = new TH1D( "fH1TraceHandler", "", fF1Trace->GetNpx(), 0., fMaxSamples );
     // diagnostic histograms (chi2, fitstat)
@@ -144,8 +128,10 @@ VFitTraceHandler::VFitTraceHandler( string iFit )
     fRT = 0.;
     fFT = 0.;
     fTraceNorm = 0.;
-
-    fMC_FADCTraceStart = 0;
+    fTraceMax = 0.;
+    fTraceMaxX = 0.;
+    fnstat = 0;
+    fFitted = false;
 }
 
 
@@ -154,7 +140,6 @@ VFitTraceHandler::~VFitTraceHandler()
     delete fF1Trace;
     delete fF1TraceGr;
     delete fH1Trace;
-    delete fH1TraceData;
     delete fHxbar;
     delete fHsigma;
     delete fHalpha;
@@ -173,32 +158,19 @@ void VFitTraceHandler::setTrace( VVirtualDataReader* iReader, unsigned int iNSam
     }
 
     // copy trace
-    if( iNSamples != fpTrace.size() )
-    {
-        fpTrace.clear();
-        for( unsigned int i = 0; i < iNSamples; i++ )
-        {
-            fpTrace.push_back( iReader->getSample_double( iHitID, i + fMC_FADCTraceStart, ( i == 0 ) ) );
-        }
-    }
-    else for( unsigned int i = 0; i < iNSamples; i++ )
-        {
-            fpTrace[i] = iReader->getSample_double( iHitID, i + fMC_FADCTraceStart, ( i == 0 ) );
-        }
-
-    fpTrazeSize = int( fpTrace.size() );
+    fillTrace( iReader, iNSamples, iHitID );
     apply_lowgain( iHiLo );
 
     fitTrace( iChanID );
 }
 
 
-void VFitTraceHandler::setTrace( vector<uint8_t> pTrace, double ped, double pedrms, unsigned int chanID )
+void VFitTraceHandler::setTrace( const vector<uint8_t>& pTrace, double ped, double pedrms, unsigned int chanID )
 {
     setTrace( pTrace, ped, pedrms, chanID, false );
 }
 
-void VFitTraceHandler::setTrace( vector<uint16_t> pTrace, double ped, double pedrms, unsigned int chanID )
+void VFitTraceHandler::setTrace( const vector<uint16_t>& pTrace, double ped, double pedrms, unsigned int chanID )
 {
     setTrace( pTrace, ped, pedrms, chanID, false );
 }
@@ -207,27 +179,15 @@ void VFitTraceHandler::setTrace( vector<uint16_t> pTrace, double ped, double ped
      set the trace values and fit the peak
 
 */
-void VFitTraceHandler::setTrace( vector<uint16_t> pTrace, double ped, double pedrms, unsigned int chanID, double iHiLo )
+void VFitTraceHandler::setTrace( const vector<uint16_t>& pTrace, double ped, double pedrms, unsigned int chanID, double iHiLo )
 {
     fPed = ped;
     fPedrms = pedrms;
 
     // copy trace
-    unsigned int i_tsize = pTrace.size();
-    if( i_tsize != fpTrace.size() )
-    {
-        fpTrace.clear();
-        for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace.push_back( ( double )pTrace[i] );
-        }
-    }
-    else for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace[i] = ( double )pTrace[i];
-        }
-
-    fpTrazeSize = int( fpTrace.size() );
+    fpTraceView8 = 0;
+    fpTraceView16 = 0;
+    fillTrace( pTrace.size() > 0 ? &pTrace[0] : 0, pTrace.size() );
     apply_lowgain( iHiLo );
 
     fitTrace( chanID );
@@ -237,27 +197,15 @@ void VFitTraceHandler::setTrace( vector<uint16_t> pTrace, double ped, double ped
      set the trace values and fit the peak
 
 */
-void VFitTraceHandler::setTrace( vector<uint8_t> pTrace, double ped, double pedrms, unsigned int chanID, double iHiLo )
+void VFitTraceHandler::setTrace( const vector<uint8_t>& pTrace, double ped, double pedrms, unsigned int chanID, double iHiLo )
 {
     fPed = ped;
     fPedrms = pedrms;
 
     // copy trace
-    unsigned int i_tsize = pTrace.size();
-    if( i_tsize != fpTrace.size() )
-    {
-        fpTrace.clear();
-        for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace.push_back( ( double )pTrace[i] );
-        }
-    }
-    else for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace[i] = ( double )pTrace[i];
-        }
-
-    fpTrazeSize = int( fpTrace.size() );
+    fpTraceView8 = 0;
+    fpTraceView16 = 0;
+    fillTrace( pTrace.size() > 0 ? &pTrace[0] : 0, pTrace.size() );
     apply_lowgain( iHiLo );
 
     fitTrace( chanID );
@@ -266,26 +214,15 @@ void VFitTraceHandler::setTrace( vector<uint8_t> pTrace, double ped, double pedr
 
 void VFitTraceHandler::fitTrace( unsigned int chanID )
 {
-
+    fillTraceFromView();
     fFitted = false;
-    fChi2 = 0.;
-    fRT = 0.;
-    fFT = 0.;
-    fTraceNorm = 0.;
+    fnstat = 0;
 
-    fH1TraceData->Reset();
-    fH1Trace->SetLineStyle( 1 );
-    // check if histogram size is still correct
-    if( ( int )fpTrace.size() != ( int )fH1TraceData->GetNbinsX() )
+    // trace has been fitted before
+    if( getCachedFit( chanID ) )
     {
-        fH1TraceData->SetBins( ( int )fpTrace.size(), 0., ( double )fpTrace.size() );
-    }
-    // fill histogram
-    for( unsigned int i = 0; i < fpTrace.size(); i++ )
-    {
-        fH1TraceData->SetBinContent( i + 1, -1. * fpTrace[i] );
-        // errors are signal+rms of pedestal
-        fH1TraceData->SetBinError( i + 1, sqrt( fabs( fpTrace[i] - fPed ) + fPedrms * fPedrms ) / 2. );
+        setFitResults();
+        return;
     }
 
     // find start parameters
@@ -296,90 +233,203 @@ void VFitTraceHandler::fitTrace( unsigned int chanID )
     // fit only if peak value of trace is above threshold
     if( ipeak > fFitThresh * fPedrms )
     {
-        if( fFitFunction == "ev" )
+        fPulseFitter.fit( fpTrace.size() > 0 ? &fpTrace[0] : 0, fpTrace.size(), fPed, fPedrms );
+        if( fMinuitPrint )
         {
-            // fit in samples
-            fF1Trace->SetParameters( -1.*ipeak, ipeakpos, 0.6, 1.6, -1.*fPed );
-            // fit in ns
-            //	 fF1Trace->SetParameters( -1.*ipeak, ipeakpos*2, 1.2, 3.0, -1.*fPed );
-            fF1Trace->SetParNames( "Constant", "Mean", "Sigma", "Alpha", "Pedestal" );
-            fF1Trace->FixParameter( 4, -1.*fPed );
-            // constant always negative
-            fF1Trace->SetParLimits( 0, -5.e5, 0. );
-            // fit in samples
-            fF1Trace->SetParLimits( 2, 0.01, 20. );
-            // fit in ns
-            //	 fF1Trace->SetParLimits( 2, 0.1, 20. );
-            fF1Trace->SetParLimits( 3, 0., 20. );
+            fPulseFitter.print();
         }
-        else if( fFitFunction == "grisu" )
+        fFitted = true;
+        setFitResults();
+        fillFitHistograms( chanID );
+    }
+    else
+    {
+        setFitResults();
+    }
+
+    // keep fit results for this channel
+    setCachedFit( chanID, fpTrace.size() > 0 ? &fpTrace[0] : 0, fpTrace.size() );
+}
+
+
+/*!
+    fit all traces of an event
+
+    traces of all channels are copied first, traces not fitted before
+    and with peak values above threshold are then fitted in one go.
+    Fit results are kept per channel and are used in subsequent calls
+    of setTrace() for the same channels (and traces)
+*/
+void VFitTraceHandler::fitTraces( VVirtualDataReader* iReader, unsigned int iNSamples,
+                                  const vector< unsigned int >& iChanID, const vector< unsigned int >& iHitID,
+                                  const vector< double >& iPed, const vector< double >& iPedRMS, const vector< double >& iHiLo )
+{
+    if( !iReader )
+    {
+        return;
+    }
+    fBatchTrace.clear();
+    fBatchTraceStart.clear();
+    fBatchNSamples.clear();
+    fBatchChanID.clear();
+    fBatchPed.clear();
+    fBatchPedRMS.clear();
+
+    ///////////////////////////////////////////
+    // copy traces to be fitted
+    double ipeak = 0.;
+    int ipeakpos = 0;
+    for( unsigned int i = 0; i < iChanID.size(); i++ )
+    {
+        if( i >= iHitID.size() || i >= iPed.size() || i >= iPedRMS.size() || i >= iHiLo.size() )
         {
-            // fit in samples
-            fF1Trace->SetParameters( 2.4, 8.0, 0., ipeakpos, -1.*ipeak, -1.*fPed );
-            // fit in ns
-            //         fF1Trace->SetParameters( 2.4, 8.0, 0., 2.*ipeakpos, -1.*ipeak,  -1.*fPed );
-            fF1Trace->SetParNames( "RT", "FT", "RC", "T0", "Constant", "Pedestal" );
-            fF1Trace->FixParameter( 2, 0. );
-            fF1Trace->SetParLimits( 0, 0., 20. );
-            fF1Trace->SetParLimits( 1, 0., 2000. );
+            break;
         }
+        fPed = iPed[i];
+        fPedrms = iPedRMS[i];
+        fillTrace( iReader, iNSamples, iHitID[i] );
+        apply_lowgain( iHiLo[i] );
+        fillTraceFromView();
+        fFitted = false;
 
-        // now fit everything
-        if( !fMinuitPrint )
+        if( getCachedFit( iChanID[i] ) )
         {
-            //         fH1TraceData->Fit( fF1Trace, "0Q" );
-            fH1TraceData->Fit( fF1Trace, "E" );
+            continue;
         }
-        else
+        getQuickMax( 0, fpTrace.size(), ipeak, ipeakpos );
+        if( ipeak > fFitThresh * fPedrms )
         {
-            fH1TraceData->Fit( fF1Trace, "E" );
+            fBatchTraceStart.push_back( fBatchTrace.size() );
+            fBatchNSamples.push_back( fpTrace.size() );
+            fBatchTrace.insert( fBatchTrace.end(), fpTrace.begin(), fpTrace.end() );
+            fBatchChanID.push_back( iChanID[i] );
+            fBatchPed.push_back( fPed );
+            fBatchPedRMS.push_back( fPedrms );
         }
-        // pulse maximum
-        fTraceMax =  fF1Trace->GetMinimum( ( double )0., ( double )fMaxSamples );
-        fTraceMaxX = fF1Trace->GetMinimumX( ( double )0., ( double )fMaxSamples );
-        // status of the error matrix
-        double edm = 0.;
-        double amin = 0.;
-        double errdef = 0.;
-        int nvpar = 0;
-        int nparx = 0;
-        gMinuit->mnstat( amin, edm, errdef, nvpar, nparx, fnstat );
-        if( fnstat < 3 )
+        // trace below threshold (not fitted)
+        else
         {
-            fH1Trace->SetLineStyle( 2 );
+            setCachedFit( iChanID[i], fpTrace.size() > 0 ? &fpTrace[0] : 0, fpTrace.size() );
         }
-        fHfitstat->Fill( fnstat );
-        // chi2
-        fChi2 = fF1Trace->GetChisquare() / ( fH1TraceData->GetNbinsX() - fF1Trace->GetNumberFreeParameters() );
-        fHchi2->Fill( fChi2 );
-        // parameters
-        if( fnstat > 0 )
+    }
+
+    ///////////////////////////////////////////
+    // fit all traces
+    for( unsigned int i = 0; i < fBatchChanID.size(); i++ )
+    {
+        const double* iTrace = ( fBatchNSamples[i] > 0 ? &fBatchTrace[fBatchTraceStart[i]] : 0 );
+        fPed = fBatchPed[i];
+        fPedrms = fBatchPedRMS[i];
+        fPulseFitter.fit( iTrace, fBatchNSamples[i], fPed, fPedrms );
+        if( fMinuitPrint )
         {
-            fHxbar->Fill( ( double )chanID, fF1Trace->GetParameter( 1 ) );
-            fHsigma->Fill( ( double )chanID, fF1Trace->GetParameter( 2 ) );
-            fHalpha->Fill( ( double )chanID, fF1Trace->GetParameter( 3 ) );
-            if( fFitFunction == "ev" )
-            {
-                fRT = fF1Trace->GetParameter( 2 );
-                fFT = fF1Trace->GetParameter( 3 );
-                fTraceNorm = fF1Trace->GetParameter( 0 );
-            }
-            else if( fFitFunction == "grisu" )
-            {
-                fRT = fF1Trace->GetParameter( 0 );
-                fFT = fF1Trace->GetParameter( 1 ) ;
-                fTraceNorm = fF1Trace->GetParameter( 4 );
-            }
+            fPulseFitter.print();
         }
         fFitted = true;
+        setFitResults();
+        fillFitHistograms( fBatchChanID[i] );
+        setCachedFit( fBatchChanID[i], iTrace, fBatchNSamples[i] );
     }
-    else
+}
+
+
+/*
+    diagnostic histograms (filled once per fitted trace)
+*/
+void VFitTraceHandler::fillFitHistograms( unsigned int chanID )
+{
+    fHfitstat->Fill( fnstat );
+    fHchi2->Fill( fChi2 );
+    if( fnstat > 0 )
     {
-        fFitted = false;
-        fChi2 = 0.;
-        fFT = 0.;
-        fRT = 0.;
-        fTraceNorm = 0.;
+        fHxbar->Fill( ( double )chanID, fPulseFitter.getParameter( 1 ) );
+        fHsigma->Fill( ( double )chanID, fPulseFitter.getParameter( 2 ) );
+        fHalpha->Fill( ( double )chanID, fPulseFitter.getParameter( 3 ) );
+    }
+}
+
+
+/*
+    check if this trace (same samples and pedestals) has been fitted before
+*/
+bool VFitTraceHandler::getCachedFit( unsigned int chanID )
+{
+    if( chanID >= fFitCacheValid.size() || !fFitCacheValid[chanID] )
+    {
+        return false;
+    }
+    if( fFitCachePed[chanID] != fPed || fFitCachePedRMS[chanID] != fPedrms || fFitCacheTrace[chanID] != fpTrace )
+    {
+        return false;
+    }
+    fPulseFitter = fFitCache[chanID];
+    fFitted = fFitCacheFitted[chanID];
+    return true;
+}
+
+
+/*
+    keep fit results, trace samples and pedestals for this channel
+*/
+void VFitTraceHandler::setCachedFit( unsigned int chanID, const double* iTrace, unsigned int iNSamples )
+{
+    if( chanID >= fFitCache.size() )
+    {
+        fFitCache.resize( chanID + 1, fPulseFitter );
+        fFitCacheTrace.resize( chanID + 1 );
+        fFitCachePed.resize( chanID + 1, 0. );
+        fFitCachePedRMS.resize( chanID + 1, 0. );
+        fFitCacheValid.resize( chanID + 1, false );
+        fFitCacheFitted.resize( chanID + 1, false );
+    }
+    fFitCache[chanID] = fPulseFitter;
+    fFitCacheTrace[chanID].assign( iTrace, iTrace + iNSamples );
+    fFitCachePed[chanID] = fPed;
+    fFitCachePedRMS[chanID] = fPedrms;
+    fFitCacheValid[chanID] = true;
+    fFitCacheFitted[chanID] = fFitted;
+}
+
+
+/*
+    fill trace parameters from fit results
+*/
+void VFitTraceHandler::setFitResults()
+{
+    fChi2 = 0.;
+    fRT = 0.;
+    fFT = 0.;
+    fTraceNorm = 0.;
+    if( !fFitted )
+    {
+        fnstat = 0;
+        return;
+    }
+    // pulse maximum
+    fTraceMax =  fPulseFitter.getMinimum( 0., ( double )fMaxSamples );
+    fTraceMaxX = fPulseFitter.getMinimumX( 0., ( double )fMaxSamples );
+    // fit status (emulates the status of the TMinuit error matrix)
+    fnstat = fPulseFitter.getStatus();
+    // chi2
+    if( fPulseFitter.getNDF() > 0 )
+    {
+        fChi2 = fPulseFitter.getChi2() / fPulseFitter.getNDF();
+    }
+    // parameters
+    if( fnstat > 0 )
+    {
+        if( fFitFunction == "ev" )
+        {
+            fRT = fPulseFitter.getParameter( 2 );
+            fFT = fPulseFitter.getParameter( 3 );
+            fTraceNorm = fPulseFitter.getParameter( 0 );
+        }
+        else if( fFitFunction == "grisu" )
+        {
+            fRT = fPulseFitter.getParameter( 0 );
+            fFT = fPulseFitter.getParameter( 1 ) ;
+            fTraceNorm = fPulseFitter.getParameter( 4 );
+        }
     }
 }
 
@@ -393,7 +443,7 @@ double VFitTraceHandler::getTraceSum( int iFirst, int iLast, bool iRaw )
     double isum = 0.;
     if( fnstat > 0 && fFitted )
     {
-        isum = -1. * fF1Trace->Integral( iFirst, iLast );
+        isum = -1. * fPulseFitter.getIntegral( iFirst, iLast );
         if( !iRaw )
         {
             isum -= fPed * ( iLast - iFirst );
@@ -412,8 +462,8 @@ void VFitTraceHandler::getTraceMax( int iFirst, int iLast, double& max, int& max
 {
     if( fFitted )
     {
-        max = -1.*fF1Trace->GetMinimum( ( double )iFirst, ( double )iLast ) - fPed;
-        maxpos = ( int )fF1Trace->GetMinimumX( ( double )iFirst, ( double )iLast );
+        max = -1.*fPulseFitter.getMinimum( ( double )iFirst, ( double )iLast ) - fPed;
+        maxpos = ( int )fPulseFitter.getMinimumX( ( double )iFirst, ( double )iLast );
     }
     else
     {
@@ -439,7 +489,14 @@ double VFitTraceHandler::getTraceTZero( int iFirst, int iLast )
         return getQuickTZero( iFirst, iLast );
     }
     getTraceMax( iFirst, iLast, imax, maxpos );
-    return fF1Trace->GetX( -1.* ( imax / 2 + fPed ), 0., ( double )maxpos );
+    return fPulseFitter.getX( -1.* ( imax / 2 + fPed ), 0., ( double )maxpos );
+}
+
+
+TF1* VFitTraceHandler::getFitFun()
+{
+    fF1Trace->SetParameters( fPulseFitter.getParameters() );
+    return fF1Trace;
 }
 
 
@@ -452,16 +509,15 @@ TH1D* VFitTraceHandler::getFitHis()
     double ieval;
     for( int i = 1; i <= fH1Trace->GetNbinsX(); i++ )
     {
-        ieval = fF1Trace->Eval( fH1Trace->GetBinCenter( i ) );
+        ieval = fPulseFitter.eval( fH1Trace->GetBinCenter( i ) );
         if( !TMath::Finite( ( double )ieval ) )
         {
-            ieval = fF1Trace->Eval( fH1Trace->GetBinCenter( i - 1 ) );
+            ieval = fPulseFitter.eval( fH1Trace->GetBinCenter( i - 1 ) );
         }
         fH1Trace->SetBinContent( i, ieval );
     }
+    fH1Trace->SetLineStyle( fnstat < 3 ? 2 : 1 );
     return fH1Trace;
-    // preli! Want to see the error bars
-    //   return fH1TraceData;
 }
 
 
@@ -489,13 +545,17 @@ bool VFitTraceHandler::setFitFunction( string iFunc )
     {
         fF1Trace = new TF1( "fF1tracehandler", VFitTraceHandler_tracefunction, 0., fMaxSamples, 5 );
         fF1Trace->SetLineColor( 1 );
+        fF1Trace->SetParNames( "Constant", "Mean", "Sigma", "Alpha", "Pedestal" );
     }
     else if( iFunc == "grisu" )
     {
         fF1Trace = new TF1( "fF1tracehandler", VFitTraceHandler_tracefunction_Grisu, 0., fMaxSamples, 6 );
         fF1Trace->SetLineColor( 2 );
+        fF1Trace->SetParNames( "RT", "FT", "RC", "T0", "Constant", "Pedestal" );
     }
     fF1Trace->SetTitle( iFunc.c_str() );
+    fPulseFitter.setFunction( iFunc );
+    fFitCacheValid.assign( fFitCacheValid.size(), false );
     fF1Trace->SetLineWidth( 2 );
     fF1Trace->SetNpx( 500 );
     return true;
@@ -517,7 +577,7 @@ double VFitTraceHandler::getTraceWidth( int fFirst, int fLast, double fPed )
     fFirst = 0;
     fLast  = 0;
 
-    return ( fF1Trace->GetX( iMax, fTraceMaxX, ( double )fMaxSamples ) - fF1Trace->GetX( iMax, 0., fTraceMaxX ) );
+    return ( fPulseFitter.getX( iMax, fTraceMaxX, ( double )fMaxSamples ) - fPulseFitter.getX( iMax, 0., fTraceMaxX ) );
 }
 
 
@@ -539,8 +599,8 @@ double VFitTraceHandler::getTraceRiseTime( double fPed, double ystart, double ys
     double t2 = 0.;
 
     double iMax = fTraceMax;
-    t1 = fF1Trace->GetX( -1.*( fPed + ystart * ( -1.*iMax - fPed ) ), 0., fTraceMaxX );
-    t2 = fF1Trace->GetX( -1.*( fPed + ystop * ( -1.*iMax - fPed ) ), 0., fTraceMaxX );
+    t1 = fPulseFitter.getX( -1.*( fPed + ystart * ( -1.*iMax - fPed ) ), 0., fTraceMaxX );
+    t2 = fPulseFitter.getX( -1.*( fPed + ystop * ( -1.*iMax - fPed ) ), 0., fTraceMaxX );
 
     return t2 - t1;
 }
@@ -564,8 +624,8 @@ double VFitTraceHandler::getTraceFallTime( double fPed, double ystart, double ys
     double t2 = 0.;
 
     double iMax = fTraceMax;
-    t1 = fF1Trace->GetX( -1.*( fPed + ystart * ( -1.*iMax - fPed ) ), fTraceMaxX, ( double )fMaxSamples );
-    t2 = fF1Trace->GetX( -1.*( fPed + ystop * ( -1.*iMax - fPed ) ), fTraceMaxX, ( double )fMaxSamples );
+    t1 = fPulseFitter.getX( -1.*( fPed + ystart * ( -1.*iMax - fPed ) ), fTraceMaxX, ( double )fMaxSamples );
+    t2 = fPulseFitter.getX( -1.*( fPed + ystop * ( -1.*iMax - fPed ) ), fTraceMaxX, ( double )fMaxSamples );
 
     return t2 - t1;
 }
@@ -224,7 +224,7 @@ void VGrIsuAnalyzer::mtxmlt( float a[3][3], float b[3], float c[3] )
 /**/
 //:Reconst:rcs_perpendicular_fit
 /***************** rcs_perpendicular_fit *********************************/
-int VGrIsuAnalyzer::rcs_perpendicular_fit( vector<float> x, vector<float> y, vector<float> w, vector<float> m,
+int VGrIsuAnalyzer::rcs_perpendicular_fit( const vector<float>& x, const vector<float>& y, const vector<float>& w, const vector<float>& m,
         unsigned int num_images, float* sx, float* sy, float* std )
 /*
 RETURN= 0 if no faults
@@ -327,7 +327,7 @@ passes through the point (x[i],y[i]) and has slope m[i].
 /**/
 //:Reconst:rcs_rotate_delta
 /* ==================rcs_rotate_delta===============================*/
-int VGrIsuAnalyzer::rcs_rotate_delta( vector<float> xtel, vector<float> ytel, vector<float> ztel, vector<float>& xtelnew, vector<float>& ytelnew, vector<float>& ztelnew, float thetax, float thetay, int nbr_tel )
+int VGrIsuAnalyzer::rcs_rotate_delta( const vector<float>& xtel, const vector<float>& ytel, const vector<float>& ztel, vector<float>& xtelnew, vector<float>& ytelnew, vector<float>& ztelnew, float thetax, float thetay, int nbr_tel )
 /*
 RETURN=    ?
 ARGUMENT=  xtel   = original x positions of telescopes
@@ -61,8 +61,8 @@ VHoughTransform::VHoughTransform( VDetectorGeometry* fDetectorGeo )
         //cout << "Initializing the accumulator array for telescope " << iTelescopeIndex + 1 << "..." << endl;
 
         //Set up the accumulator array for a given telescope
-        fAccumulatorArray.push_back( initAccumulatorArray( fRMinDpmt[iTelescopeIndex], fRMaxDpmt[iTelescopeIndex],
-                                     fStepsPerPMTDiameter[iTelescopeIndex], iTelescopeIndex ) );
+        initAccumulatorArray( fRMinDpmt[iTelescopeIndex], fRMaxDpmt[iTelescopeIndex],
+                              fStepsPerPMTDiameter[iTelescopeIndex], iTelescopeIndex );
 
         //Print this when the accumulator array is initialized.
         //cout << "Accumulator array for telescope " << iTelescopeIndex + 1 << " initialized." << endl;
@@ -71,8 +71,8 @@ VHoughTransform::VHoughTransform( VDetectorGeometry* fDetectorGeo )
         //cout << "Initializing the lookup table for telescope " << iTelescopeIndex + 1 << "..." << endl;
 
         //Set up the lookup table for a given telescope
-        fHTLookupTableTree.push_back( initLookupTable( fRMinDpmt[iTelescopeIndex], fRMaxDpmt[iTelescopeIndex],
-                                      fStepsPerPMTDiameter[iTelescopeIndex], iTelescopeIndex ) );
+        initLookupTable( fRMinDpmt[iTelescopeIndex], fRMaxDpmt[iTelescopeIndex],
+                         fStepsPerPMTDiameter[iTelescopeIndex], iTelescopeIndex );
 
         //Print this when the lookup table is initialized
         //cout << "Lookup table for telescope " << iTelescopeIndex + 1 << " initialized." << endl;
@@ -104,17 +104,10 @@ void VHoughTransform::analysis( VEvndispData* fData, VImageParameter* fParGeo )
     double fPixelXCoordinate = 0; //The X coordinate of a pixel
     double fPixelYCoordinate = 0; //The Y coordinate of a pixel
 
-    char fBranchName[100]; //Name of the branch in the lookup table tree
-
     double fSumOfAllBins = 0; //Sum of all the bins in the accumulator array
 
     int fNumberOfNonZeroBins = 0; //Number of non-zero bins in the accumulator array
 
-    double fCircleCoordinates[3]; 	//Coordinates of a template circle associated with a particular pixel
-    fCircleCoordinates[0] = 0; 		//x coordinate
-    fCircleCoordinates[1] = 0; 		//y coordinate
-    fCircleCoordinates[2] = 0; 		//r coordinate.
-
     //Best parameterized circles
 
     double fBestParametrization[3];  		//Best parametrization
@@ -132,13 +125,13 @@ void VHoughTransform::analysis( VEvndispData* fData, VImageParameter* fParGeo )
     fThirdBestParametrization[1] = 0;		//y coordinate
     fThirdBestParametrization[2] = 0;		//r coordinate
 
-    int fAccumulatorBins[3]; //Bins of the accumulator array
+    //Three highest bins of the accumulator array (updated while filling the accumulator array)
+    //Sorted by bin content; for equal bin content, the lower bin number comes first (as TH3D::GetMaximumBin())
+    unsigned int fMaxBins[3] = { 0, 0, 0 }; //Bin numbers
+    unsigned int fMaxBinValues[3] = { 0, 0, 0 }; //Bin contents
+    unsigned int fNMaxBins = 0; //Number of non-zero bins in the list of highest bins
 
     double fMaxBinValue = 0; //Value of the bin of the accumulator array with the highest value
-    double fSecondMaxBinValue = 0; //Value of the bin of the accumulator array with the second highest value
-
-    int fMaxBin = 0; //Bin number of the max bin of the accumulator array
-    int fSecondMaxBin = 0; //Bin number of the second max bin of the accumulator array
 
     double fDistance1 = 0; //Hyper-distance between the best and second best parametrizations
     double fDistance2 = 0; //Hyper-distance between the best and third best parametrizations
@@ -159,11 +152,24 @@ void VHoughTransform::analysis( VEvndispData* fData, VImageParameter* fParGeo )
 
     double fContained = 0; // Distance from the center of the ring to the center of the camera plus the ring radius in mm
 
-    //Reset the accumulator array
-    fAccumulatorArray[ fData->getTelID() ]->Reset();
+    unsigned int fTelID = fData->getTelID();
 
+    vector <unsigned int>& iAccumulator = fAccumulatorArray[ fTelID ];
+    vector <unsigned int>& iNonZeroBins = fAccumulatorNonZeroBins[ fTelID ];
 
-    for( int iChannelIndex = 0 ; iChannelIndex < fNumberOfChannels[ fData->getTelID() ] ; iChannelIndex++ ) // Loop over all the pixels
+    //Reset the accumulator array (only the bins filled in the previous event)
+    for( unsigned int iBinIndex = 0 ; iBinIndex < iNonZeroBins.size() ; iBinIndex++ )
+    {
+        iAccumulator[ iNonZeroBins[iBinIndex] ] = 0;
+    }
+    iNonZeroBins.clear();
+
+    //Bins which are not under/overflow bins (only these are considered for the best parametrizations)
+    const unsigned int nx = fAccumulatorNBins[0][ fTelID ] + 2;
+    const unsigned int ny = fAccumulatorNBins[1][ fTelID ] + 2;
+    const unsigned int nr = fAccumulatorNBins[2][ fTelID ] + 2;
+
+    for( int iChannelIndex = 0 ; iChannelIndex < fNumberOfChannels[ fTelID ] ; iChannelIndex++ ) // Loop over all the pixels
     {
 
 
@@ -174,41 +180,72 @@ void VHoughTransform::analysis( VEvndispData* fData, VImageParameter* fParGeo )
 
             //Fill the Accumulator array here.
 
-            sprintf( fBranchName, "Pixel %d", iChannelIndex ); //Set the branch name for ith channel
+            //Loop over all circle parametrizations for that pixel and fill the appropriate bins of the accumulator array
+            for( unsigned int iCircleParametrizationIndex = fHTLookupTableOffset[ fTelID ][iChannelIndex] ;
+                    iCircleParametrizationIndex < fHTLookupTableOffset[ fTelID ][iChannelIndex + 1] ; iCircleParametrizationIndex++ )
+            {
 
-            TBranch* fBranch = fHTLookupTableTree[ fData->getTelID() ]->GetBranch( fBranchName ); //Grab the branch for the ith channel
+                unsigned int iBin = fHTLookupTableBins[ fTelID ][iCircleParametrizationIndex];
 
-            fBranch->SetAddress( &fCircleCoordinates ); //Map the arrays in the branch to circle coordinates array
+                //If bin content is zero and is filled, increment the number of non zero bins variable
+                if( iAccumulator[iBin] == 0 )
+                {
 
+                    fNumberOfNonZeroBins++;
 
-            //Loop over all circle coordinates for that pixel and fill the appropriate bins of the accumulator array
+                    iNonZeroBins.push_back( iBin );
 
-            //Set fCircleCoordinates[2] to a non-zero value to get into for the loop. The last entries in the lookup table are ( 0, 0, 0)
-            fCircleCoordinates[2] = 99;
+                }
 
-            for( int iCircleParametrizationIndex = 0 ; fCircleCoordinates[2] != 0 ; iCircleParametrizationIndex++ ) //Loop over circle parametrizations until the r coordinate is zero (Last entries are 0,0,0)
-            {
+                //Fill the appropriate bin of accumulator array with 1 (Binary image).
+                iAccumulator[iBin]++;
 
-                fBranch->GetEntry( iCircleParametrizationIndex ); // Get the jth circle parametrization for that pixel. Sets the values of fCircleCoordinates
+                //Add 1.0 to the sum of all bins variable.
+                fSumOfAllBins = fSumOfAllBins + 1.0;
 
-                if( fCircleCoordinates[2] != 0 )// If the r coordinate is not zero (end of list), do this
+                //Update the list of highest bins (under/overflow bins are ignored)
+                unsigned int ix = iBin % nx;
+                unsigned int iy = ( iBin / nx ) % ny;
+                unsigned int ir = iBin / nx / ny;
+                if( ix == 0 || ix == nx - 1 || iy == 0 || iy == ny - 1 || ir == 0 || ir == nr - 1 )
                 {
+                    continue;
+                }
 
-                    //If bin content is zero and is filled, increment the number of non zero bins variable
-                    if( ( fAccumulatorArray[ fData->getTelID() ]->GetBinContent( fAccumulatorArray[ fData->getTelID() ]->FindBin( fCircleCoordinates[0], fCircleCoordinates[1], fCircleCoordinates[2] ) ) ) == 0 )
+                //Bin is already in the list of highest bins
+                unsigned int iListIndex = 0;
+                for( iListIndex = 0 ; iListIndex < fNMaxBins ; iListIndex++ )
+                {
+                    if( fMaxBins[iListIndex] == iBin )
                     {
-
-                        fNumberOfNonZeroBins++;
-
+                        break;
                     }
+                }
 
-                    //Fill the appropriate bin of accumulator array with 1.0 (Binary image). For images with charge values, add the charge instead of 1.0.
-                    fAccumulatorArray[ fData->getTelID() ]->Fill( fCircleCoordinates[0], fCircleCoordinates[1], fCircleCoordinates[2], 1.0 );
-
-                    //Add 1.0 to the sum of all bins variable.
-                    fSumOfAllBins = fSumOfAllBins + 1.0;
+                if( iListIndex == fNMaxBins )
+                {
+                    //Add bin to the list of highest bins, replace the lowest bin if the list is full
+                    if( fNMaxBins < 3 )
+                    {
+                        fNMaxBins++;
+                    }
+                    else if( iAccumulator[iBin] < fMaxBinValues[2] || ( iAccumulator[iBin] == fMaxBinValues[2] && iBin > fMaxBins[2] ) )
+                    {
+                        continue;
+                    }
+                    iListIndex = fNMaxBins - 1;
+                    fMaxBins[iListIndex] = iBin;
+                }
+                fMaxBinValues[iListIndex] = iAccumulator[iBin];
 
-                }//End of (if r coordinate is non zero) statement
+                //Move the updated bin up in the list
+                while( iListIndex > 0 && ( fMaxBinValues[iListIndex] > fMaxBinValues[iListIndex - 1]
+                                           || ( fMaxBinValues[iListIndex] == fMaxBinValues[iListIndex - 1] && fMaxBins[iListIndex] < fMaxBins[iListIndex - 1] ) ) )
+                {
+                    swap( fMaxBins[iListIndex], fMaxBins[iListIndex - 1] );
+                    swap( fMaxBinValues[iListIndex], fMaxBinValues[iListIndex - 1] );
+                    iListIndex--;
+                }
 
             }//End of loop over circle parametrizations
 
@@ -220,41 +257,29 @@ void VHoughTransform::analysis( VEvndispData* fData, VImageParameter* fParGeo )
     //End of accumulator array filling.
 
 
-    //Get the best circle parametrizations from the accumulator array
+    //Get the best circle parametrizations from the list of highest bins of the accumulator array
+    //(empty accumulator array: first bin, as TH3D::GetMaximumBin())
 
-    //Get best parameterized circle
+    for( unsigned int iListIndex = fNMaxBins ; iListIndex < 3 ; iListIndex++ )
+    {
+        fMaxBins[iListIndex] = 1 + nx * ( 1 + ny );
+        fMaxBinValues[iListIndex] = 0;
+    }
 
-    fMaxBin = fAccumulatorArray[ fData->getTelID() ]->GetMaximumBin( fAccumulatorBins[0], fAccumulatorBins[1], fAccumulatorBins[2] ); //Get the max bin of the accumulator array
-    fBestParametrization[0] = fAccumulatorArray[ fData->getTelID() ]->GetXaxis()->GetBinCenter( fAccumulatorBins[0] ); //Get the x coordinate of the max bin
-    fBestParametrization[1] = fAccumulatorArray[ fData->getTelID() ]->GetYaxis()->GetBinCenter( fAccumulatorBins[1] ); //Get the y coordinate of the max bin
-    fBestParametrization[2] = fAccumulatorArray[ fData->getTelID() ]->GetZaxis()->GetBinCenter( fAccumulatorBins[2] ); //Get the r coordinate of the max bin
-    fMaxBinValue = fAccumulatorArray[ fData->getTelID() ]->GetBinContent( fAccumulatorBins[0], fAccumulatorBins[1], fAccumulatorBins[2] ); //Get the value of the max bin
+    //Get best parameterized circle
 
+    getAccumulatorBinCenter( fTelID, fMaxBins[0], fBestParametrization );
+    fMaxBinValue = fMaxBinValues[0];
 
     //Get second best parametrized circle
 
-    //Set the value of the max bin of the accumulator array to zero. Do this to use the GetMaximumBin() method.
-    fAccumulatorArray[ fData->getTelID() ]->SetBinContent( fAccumulatorBins[0], fAccumulatorBins[1], fAccumulatorBins[2], 0 );
-
-    fSecondMaxBin = fAccumulatorArray[ fData->getTelID() ]->GetMaximumBin( fAccumulatorBins[0], fAccumulatorBins[1], fAccumulatorBins[2] ); //Get the second max bin of the accumulator array
-    fSecondBestParametrization[0] = fAccumulatorArray[ fData->getTelID() ]->GetXaxis()->GetBinCenter( fAccumulatorBins[0] ); //Get the x coordinate of the second max bin
-    fSecondBestParametrization[1] = fAccumulatorArray[ fData->getTelID() ]->GetYaxis()->GetBinCenter( fAccumulatorBins[1] ); //Get the y coordinate of the second max bin
-    fSecondBestParametrization[2] = fAccumulatorArray[ fData->getTelID() ]->GetZaxis()->GetBinCenter( fAccumulatorBins[2] ); //Get the r coordinate of the second max bin
-    fSecondMaxBinValue = fAccumulatorArray[ fData->getTelID() ]->GetBinContent( fAccumulatorBins[0], fAccumulatorBins[1], fAccumulatorBins[2] ); //Get the value of the second max bin
-
+    getAccumulatorBinCenter( fTelID, fMaxBins[1], fSecondBestParametrization );
 
     //Get the third best parametrized circle
 
-    //Set the value of the second max bin of the accumulator array to zero. Do this to use the GetMaximumBin() method.
-    fAccumulatorArray[ fData->getTelID() ]->SetBinContent( fAccumulatorBins[0], fAccumulatorBins[1], fAccumulatorBins[2], 0 );
-
-    fThirdBestParametrization[0] = fAccumulatorArray[ fData->getTelID() ]->GetXaxis()->GetBinCenter( fAccumulatorBins[0] ); //Get the x coordinate of the third max bin
-    fThirdBestParametrization[1] = fAccumulatorArray[ fData->getTelID() ]->GetYaxis()->GetBinCenter( fAccumulatorBins[1] ); //Get the x coordinate of the third max bin
-    fThirdBestParametrization[2] = fAccumulatorArray[ fData->getTelID() ]->GetZaxis()->GetBinCenter( fAccumulatorBins[2] ); //Get the x coordinate of the third max bin
-
-    //Refill the bins of the accumulator that were set to zero.
-    fAccumulatorArray[ fData->getTelID() ]->SetBinContent( fMaxBin, fMaxBinValue ); //Replace the bin content of the max bin
-    fAccumulatorArray[ fData->getTelID() ]->SetBinContent( fSecondMaxBin, fSecondMaxBinValue ); //Replace the bin content of the second max bin
+    //Note: the third best parametrization is taken from the same bin as the second best parametrization
+    //(the TD cut values in the Hough transform parameter files are derived with this definition)
+    getAccumulatorBinCenter( fTelID, fMaxBins[1], fThirdBestParametrization );
 
 
     //Calculate discriminating variables
@@ -517,12 +542,9 @@ void VHoughTransform::analysis( VEvndispData* fData, VImageParameter* fParGeo )
 
 
 //Method for initializing the accumulator array
-TH3D* VHoughTransform::initAccumulatorArray( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int iTelescopeIndex )
+void VHoughTransform::initAccumulatorArray( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int iTelescopeIndex )
 {
 
-    //The name of the accumulator array
-    char fAccumulatorArrayName[100];
-
     //Maximum x value of the template circles
     double fXMax = 0;
 
@@ -616,31 +638,84 @@ TH3D* VHoughTransform::initAccumulatorArray( int fRMinDpmt, int fRMaxDpmt, int f
     double fAccumulatorRMax = ( fRMax + ( fStepSizeR / 2.0 ) );
 
 
-    //Set the name of the accumulator array
-    sprintf( fAccumulatorArrayName, "Accumulator Array Tel%d", iTelescopeIndex );
+    //Accumulator array binning
+    fAccumulatorNBins[0].push_back( fNumberOfXBins );
+    fAccumulatorNBins[1].push_back( fNumberOfYBins );
+    fAccumulatorNBins[2].push_back( fNumberOfRBins );
+    fAccumulatorMin[0].push_back( fAccumulatorXMin );
+    fAccumulatorMax[0].push_back( fAccumulatorXMax );
+    fAccumulatorMin[1].push_back( fAccumulatorYMin );
+    fAccumulatorMax[1].push_back( fAccumulatorYMax );
+    fAccumulatorMin[2].push_back( fAccumulatorRMin );
+    fAccumulatorMax[2].push_back( fAccumulatorRMax );
 
+    //Accumulator array instantiation (including under/overflow bins)
+    fAccumulatorArray.push_back( vector <unsigned int>( ( fNumberOfXBins + 2 ) * ( fNumberOfYBins + 2 ) * ( fNumberOfRBins + 2 ), 0 ) );
+    fAccumulatorNonZeroBins.push_back( vector <unsigned int>() );
 
-    //Accumulator array instantiation
-    TH3D* iAccumulatorArray = new TH3D( fAccumulatorArrayName, fAccumulatorArrayName,
-                                        fNumberOfXBins, fAccumulatorXMin, fAccumulatorXMax,
-                                        fNumberOfYBins, fAccumulatorYMin, fAccumulatorYMax,
-                                        fNumberOfRBins, fAccumulatorRMin, fAccumulatorRMax );
 
+}//End of method for initializing the accumulator array
 
-    //Return the accumulator array
-    return iAccumulatorArray;
 
 
-}//End of method for initializing the accumulator array
+//Global bin of the accumulator array (same binning as TH3D::FindBin())
+unsigned int VHoughTransform::getAccumulatorBin( unsigned int fTelID, double x, double y, double r )
+{
 
+    double fCoordinates[3] = { x, y, r };
 
+    int fBins[3] = { 0, 0, 0 };
 
-//Method for initializing the Hough transform lookup table
-TTree* VHoughTransform::initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int iTelescopeIndex )
+    for( unsigned int iAxis = 0 ; iAxis < 3 ; iAxis++ )
+    {
+
+        if( fCoordinates[iAxis] < fAccumulatorMin[iAxis][fTelID] )
+        {
+            fBins[iAxis] = 0;  //Underflow bin
+        }
+        else if( !( fCoordinates[iAxis] < fAccumulatorMax[iAxis][fTelID] ) )
+        {
+            fBins[iAxis] = fAccumulatorNBins[iAxis][fTelID] + 1;  //Overflow bin
+        }
+        else
+        {
+            fBins[iAxis] = 1 + ( int )( fAccumulatorNBins[iAxis][fTelID] * ( fCoordinates[iAxis] - fAccumulatorMin[iAxis][fTelID] )
+                                        / ( fAccumulatorMax[iAxis][fTelID] - fAccumulatorMin[iAxis][fTelID] ) );
+        }
+
+    }
+
+    return fBins[0] + ( fAccumulatorNBins[0][fTelID] + 2 ) * ( fBins[1] + ( fAccumulatorNBins[1][fTelID] + 2 ) * fBins[2] );
+
+}//End of method for getting the global bin of the accumulator array
+
+
+
+//x, y, r coordinates of the center of an accumulator bin (same as TAxis::GetBinCenter())
+void VHoughTransform::getAccumulatorBinCenter( unsigned int fTelID, unsigned int iBin, double* fCoordinates )
 {
 
-    //Lookup table name
-    char fLookupTableName[100];
+    int fBins[3];
+    fBins[0] = iBin % ( fAccumulatorNBins[0][fTelID] + 2 );
+    fBins[1] = ( iBin / ( fAccumulatorNBins[0][fTelID] + 2 ) ) % ( fAccumulatorNBins[1][fTelID] + 2 );
+    fBins[2] = iBin / ( fAccumulatorNBins[0][fTelID] + 2 ) / ( fAccumulatorNBins[1][fTelID] + 2 );
+
+    for( unsigned int iAxis = 0 ; iAxis < 3 ; iAxis++ )
+    {
+
+        double fBinWidth = ( fAccumulatorMax[iAxis][fTelID] - fAccumulatorMin[iAxis][fTelID] ) / ( double ) fAccumulatorNBins[iAxis][fTelID];
+
+        fCoordinates[iAxis] = fAccumulatorMin[iAxis][fTelID] + ( ( double ) fBins[iAxis] - 0.5 ) * fBinWidth;
+
+    }
+
+}//End of method for getting the coordinates of an accumulator bin
+
+
+
+//Method for initializing the Hough transform lookup table
+void VHoughTransform::initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStepsPerPMTDiameter, unsigned int iTelescopeIndex )
+{
 
     //The number of circle templates used in the lookup table
     int fNumberOfCircleTemplates = 0;
@@ -655,10 +730,6 @@ TTree* VHoughTransform::initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStep
         fTemplateCircle[iChannelIndex] = 0;
     }
 
-    char fHTBranchName[100]; //Names of the branches in the HT lookup table tree
-
-    char fHTLeafName[100]; //Leaf names
-
     double fTemplateCircleCoordinates[3]; //Template circle parametrization coordinates
     fTemplateCircleCoordinates[0] = 0; //x coordinate
     fTemplateCircleCoordinates[1] = 0; //y coordinate
@@ -669,27 +740,8 @@ TTree* VHoughTransform::initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStep
     fTestPixel[1] = 0; //Y coordinate
 
 
-    //Set the tbale of the lookup table tree
-    sprintf( fLookupTableName, "Templates Tel%d", iTelescopeIndex );
-
-    //Instantiate Hough transform lookup table tree.
-    TTree* iHTLookupTableTree = new TTree( fLookupTableName, fLookupTableName );
-
-
-    //Set up the branches in the tree. One branch for each pixel. Each branch will have circle parametrizations that hit that pixel.
-    for( int iChannelIndex = 0 ; iChannelIndex < fNumberOfChannels[ iTelescopeIndex ] ; iChannelIndex++ )
-    {
-
-        //Sets the branch name
-        sprintf( fHTBranchName, "Pixel %d", iChannelIndex );
-
-        //Sets the leaf name
-        sprintf( fHTLeafName, "Pixel %d Circle Coordinates[3]/D", iChannelIndex );
-
-        //Setup the branch for that pixel
-        iHTLookupTableTree->Branch( fHTBranchName, &fTemplateCircleCoordinates, fHTLeafName );
-
-    }// End of setting up the pixel branches in the HT lookup table tree
+    //Accumulator bins of the template circles hitting each pixel
+    vector < vector <unsigned int> > iPixelTemplateBins( fNumberOfChannels[ iTelescopeIndex ] );
 
 
     //Loop over the pixels for template generation. (The center of the circle templates is the center of the pixels)
@@ -790,18 +842,13 @@ TTree* VHoughTransform::initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStep
 
                 {
 
-                    //If the charge is non zero, fill the appropriate branch with the circle coordinates.
+                    //If the charge is non zero, add the accumulator bin of the circle coordinates to the list of this pixel.
                     if( fTemplateCircle[iChannelIndex] != 0 )
 
                     {
 
-                        //Fill the tree
-
-                        //Set the branch name
-                        sprintf( fHTBranchName, "Pixel %d", iChannelIndex );
-
-                        //Fill the branch
-                        iHTLookupTableTree->GetBranch( fHTBranchName )->Fill();
+                        iPixelTemplateBins[iChannelIndex].push_back( getAccumulatorBin( iTelescopeIndex, fTemplateCircleCoordinates[0],
+                                fTemplateCircleCoordinates[1], fTemplateCircleCoordinates[2] ) );
 
                     }//End of checking if chargeval is non zero
 
@@ -821,28 +868,26 @@ TTree* VHoughTransform::initLookupTable( int fRMinDpmt, int fRMaxDpmt, int fStep
     }//End of loop over the centers of the pixels for template generation.
 
 
-    //Write an array of zeros at the end of the branches of the lookup table
-
-    //Set the template circle coordinates to zero.
-    fTemplateCircleCoordinates[0] = 0.0;
-    fTemplateCircleCoordinates[1] = 0.0;
-    fTemplateCircleCoordinates[2] = 0.0;
+    //Copy the lists of all pixels into one flat array
 
+    fHTLookupTableOffset.push_back( vector <unsigned int>( fNumberOfChannels[ iTelescopeIndex ] + 1, 0 ) );
+    fHTLookupTableBins.push_back( vector <unsigned int>() );
 
-    //For each pixel, write (0,0,0) at the end of the branch)
     for( int iChannelIndex = 0 ; iChannelIndex < fNumberOfChannels[ iTelescopeIndex ] ; iChannelIndex++ )
     {
 
-        //Set the branch name
-        sprintf( fHTBranchName, "Pixel %d", iChannelIndex );
+        fHTLookupTableOffset.back()[iChannelIndex + 1] = fHTLookupTableOffset.back()[iChannelIndex] + iPixelTemplateBins[iChannelIndex].size();
 
-        //Fill the branch with zeros
-        iHTLookupTableTree->GetBranch( fHTBranchName )->Fill();
+    }
 
-    } //End of writing zeros.
+    fHTLookupTableBins.back().reserve( fHTLookupTableOffset.back().back() );
 
+    for( int iChannelIndex = 0 ; iChannelIndex < fNumberOfChannels[ iTelescopeIndex ] ; iChannelIndex++ )
+    {
 
-    return iHTLookupTableTree;
+        fHTLookupTableBins.back().insert( fHTLookupTableBins.back().end(), iPixelTemplateBins[iChannelIndex].begin(), iPixelTemplateBins[iChannelIndex].end() );
+
+    }
 
 
 }//End of method for initializing the Hough transform lookup table
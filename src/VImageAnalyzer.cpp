@@ -21,6 +21,7 @@ VImageAnalyzer::VImageAnalyzer()
     fRaw = false;
     fOutputfile = 0;
     fInit = false;
+    fResetAfterFill = false;
 
     // image cleaning
     fVImageCleaning = new VImageCleaning( getData() );
@@ -42,12 +43,13 @@ VImageAnalyzer::VImageAnalyzer()
     }
 
     // initialize root directories
-    for( unsigned int i = 0; i < fNTel; i++ )
+    // (shared by all analyzers, several analyzers in multi-threaded mode)
+    for( unsigned int i = fAnaDir.size(); i < fNTel; i++ )
     {
         fAnaDir.push_back( 0 );
     }
     // initialize tgraphs (used for double pass method)
-    for( unsigned int i = 0; i < fNTel; i++ )
+    for( unsigned int i = fXGraph.size(); i < fNTel; i++ )
     {
         fXGraph.push_back( new TGraphErrors( 1 ) );
         fYGraph.push_back( new TGraphErrors( 1 ) );
@@ -84,8 +86,12 @@ VImageAnalyzer::~VImageAnalyzer()
  *
  *  this is the main loop
  *
+ *  iFillOutputTree = false: output tree is not filled, call fillDeferredOutputTree()
+ *                           afterwards (used for multi-threaded analysis, as tree filling
+ *                           is not thread safe)
+ *
  */
-void VImageAnalyzer::doAnalysis()
+void VImageAnalyzer::doAnalysis( bool iFillOutputTree )
 {
     if( fDebug )
     {
@@ -128,15 +134,15 @@ void VImageAnalyzer::doAnalysis()
     }
     if( !bTrigger )
     {
-        fillOutputTree();
-        setSums( 0. );
-        setPulseTiming( 0., true );
-        setPulseTiming( 0., false );
-        setImage( false );
-        setBorder( false );
-        setImageBorderNeighbour( false );
-        setHiLo( false );
-        setZeroSuppressed( false );
+        if( iFillOutputTree )
+        {
+            fillOutputTree();
+            resetImage();
+        }
+        else
+        {
+            fResetAfterFill = true;
+        }
         return;
     }
     if( getDebugFlag() )
@@ -311,7 +317,39 @@ void VImageAnalyzer::doAnalysis()
 
     ///////////////////////////////////////////////////////////////////////////////////////////
     // fill results into output tree
+    if( iFillOutputTree )
+    {
+        fillOutputTree();
+    }
+}
+
+
+/*
+ * fill output tree for events analysed with doAnalysis( false )
+ *
+ * (expect correct telescope ID to be set)
+ */
+void VImageAnalyzer::fillDeferredOutputTree()
+{
     fillOutputTree();
+    if( fResetAfterFill )
+    {
+        resetImage();
+        fResetAfterFill = false;
+    }
+}
+
+
+void VImageAnalyzer::resetImage()
+{
+    setSums( 0. );
+    setPulseTiming( 0., true );
+    setPulseTiming( 0., false );
+    setImage( false );
+    setBorder( false );
+    setImageBorderNeighbour( false );
+    setHiLo( false );
+    setZeroSuppressed( false );
 }
 
 
@@ -321,6 +359,7 @@ void VImageAnalyzer::fillOutputTree()
     {
         cout << "VImageAnalyzer::fillOutputTree()" << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_TREEFILLING_IMAGE );
 
     // fill some run quality histograms
     if( !fReader->isMC() )
@@ -583,9 +622,13 @@ bool VImageAnalyzer::initEvent()
     {
         cout << "VImageAnalyzer::initEvent" << endl;
     }
-    setSums( 0. );
-    setPulseTiming( 0., true );
-    setPulseTiming( 0., false );
+    // DST sparse replay: channels of the previous event are reset in copySparseDSTData()
+    if( !fReader->isSparseReplay() )
+    {
+        setSums( 0. );
+        setPulseTiming( 0., true );
+        setPulseTiming( 0., false );
+    }
     setTCorrectedSumFirst( getSumFirst() );
     setTCorrectedSumLast( getSumFirst() + getSumWindow() );
     setCurrentSummationWindow( getSumWindow(), false );
@@ -785,6 +828,11 @@ void VImageAnalyzer::smoothDeadTubes()
 
             // this does not work when dead channel list is time dependent
             getSums()[i] = ave_sum;
+            // (reset with the hit channels of the next event)
+            if( fReader->isSparseReplay() )
+            {
+                getAnaData()->fSparseDSTChannels[0].push_back( i );
+            }
             getPedvars()[i] = ave_pedvar;
             getGains()[i] = ave_gain;
             getTZeros()[i] = ave_tzero;
@@ -958,6 +1006,7 @@ void VImageAnalyzer::imageCleaning()
     {
         return;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), VEvndispProfiler::getImageCleaningStageID( getImageCleaningParameter()->getImageCleaningMethodIndex() ) );
 
     /////////////////////////////
     // fixed threshold cleaning
@@ -1025,6 +1074,7 @@ void VImageAnalyzer::imageCleaning()
 
 void VImageAnalyzer::muonRingAnalysis()
 {
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_MUON );
     fVImageParameterCalculation->muonRingFinder();
     fVImageParameterCalculation->muonPixelDistribution();
     fVImageParameterCalculation->sizeInMuonRing();
@@ -1032,6 +1082,7 @@ void VImageAnalyzer::muonRingAnalysis()
 
 void VImageAnalyzer::houghMuonRingAnalysis()
 {
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_HOUGHMUON );
 
     // Iterative fit muon analysis
     fVImageParameterCalculation->muonRingFinder();
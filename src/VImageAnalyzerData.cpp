@@ -40,6 +40,11 @@ VImageAnalyzerData::VImageAnalyzerData( unsigned int iTelID, unsigned int iShort
 
     fSpecialChannel = 0;
 
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        fSparseDSTChannelsValid[i] = false;
+    }
+
     fpulsetiming_tzero_index = 9999;
     fpulsetiming_width_index = 9999;
 
@@ -57,6 +62,11 @@ void VImageAnalyzerData::initialize( unsigned int iChannels, unsigned int iMaxCh
     }
     fNChannels = iChannels;
     fMaxChannels = iMaxChannel;
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        fSparseDSTChannels[i].clear();
+        fSparseDSTChannelsValid[i] = false;
+    }
     fNSamples = iSamples;
     fNDead = 0;
     fpulsetiming_tzero_index = ipulsetiming_tzero_index;
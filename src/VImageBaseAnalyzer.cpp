@@ -85,12 +85,20 @@ void VImageBaseAnalyzer::calcSums( int iFirst, int iLast, bool iMakingPeds, bool
     {
         cout << "VImageBaseAnalyzer::calcSums() " << iFirst << "\t" << iLast << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_CALCSUMS );
     int sw_original = iLast - iFirst;
 
     // for DST source file, ignore everything and just get the sums
     if( getRunParameter()->frunmode != 1 && ( fReader->getDataFormatNum() == 4 || fReader->getDataFormatNum() == 6 ) )
     {
-        setSums( fReader->getSums() );
+        if( fReader->isSparseReplay() )
+        {
+            copySparseDSTData( true, false, false );
+        }
+        else
+        {
+            setSums( fReader->getSums() );
+        }
         return;
     }
 
@@ -181,11 +189,19 @@ void VImageBaseAnalyzer::calcTZeros( int fFirst, int fLast )
     {
         cout << "VImageBaseAnalyzer::calcTZeros() " << fFirst << "\t" << fLast << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_CALCTZEROS );
     // for DST source file, ignore everything and just get the sums and tzeros
     if( fReader->getDataFormatNum() == 4 || fReader->getDataFormatNum() == 6 )
     {
-        setPulseTiming( fReader->getTracePulseTiming(), true );
-        setPulseTiming( fReader->getTracePulseTiming(), false );
+        if( fReader->isSparseReplay() )
+        {
+            copySparseDSTData( false, true, false );
+        }
+        else
+        {
+            setPulseTiming( fReader->getTracePulseTiming(), true );
+            setPulseTiming( fReader->getTracePulseTiming(), false );
+        }
         return;
     }
     // check integration range
@@ -423,6 +439,11 @@ void VImageBaseAnalyzer::calcTCorrectedSums( int iFirst, int iLast )
     // for DST source file, ignore everything and just get the sums and tzeros
     if( fReader->getDataFormatNum() == 4 || fReader->getDataFormatNum() == 6 )
     {
+        if( fReader->isSparseReplay() )
+        {
+            copySparseDSTData( true, true, true );
+            return;
+        }
         setSums( fReader->getSums() );
         setPulseTiming( fReader->getTracePulseTiming(), true );
         setPulseTiming( fReader->getTracePulseTiming(), false );
@@ -520,6 +541,7 @@ void VImageBaseAnalyzer::calcTZerosSums( int iFirstSum, int iLastSum, unsigned i
     {
         cout << "VImageBaseAnalyzer::calcTZerosSums() \t" << iFirstSum << "\t" << iLastSum << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_CALCTZEROSSUMS );
 
     /////////////////////////////////////////////////////////////////////////////////
     // DST source file,
@@ -575,11 +597,28 @@ void VImageBaseAnalyzer::calcTZerosSums( int iFirstSum, int iLastSum, unsigned i
     int corrlast = 0;
     int corrlast_sw2 = 0;
 
+    //////////////////////////////////////////////////////////////////
+    // high-gain channels: analyse all channels at once
+    //////////////////////////////////////////////////////////////////
+    vector< bool > i_batchAnalysed;
+    calcTZerosSums_batch( iFirstSum, iLastSum, iTraceIntegrationMethod, nhits, i_batchAnalysed );
+
+    // trace fitting: fit all channels at once
+    // (fit results are reused by the trace handler in the loop below)
+    if( getTraceFit() > -1 )
+    {
+        calcTraceFits_batch( nhits );
+    }
+
     //////////////////////////////////////////////////////////////////
     // loop over all channels (hits)
     //////////////////////////////////////////////////////////////////
     for( unsigned int i = 0; i < nhits; i++ )
     {
+        if( i < i_batchAnalysed.size() && i_batchAnalysed[i] )
+        {
+            continue;
+        }
         unsigned int i_channelHitID = 0;
         try
         {
@@ -732,6 +771,236 @@ void VImageBaseAnalyzer::calcTZerosSums( int iFirstSum, int iLastSum, unsigned i
     setPulseTiming( getPulseTiming( true ), false );
 }
 
+/*
+ * fit traces of all good channels (see VFitTraceHandler::fitTraces)
+ */
+void VImageBaseAnalyzer::calcTraceFits_batch( unsigned int nhits )
+{
+    if( !getFitTraceHandler() || fTraceHandler != ( VTraceHandler* )getFitTraceHandler() )
+    {
+        return;
+    }
+    unsigned int ndead_size = getDead().size();
+    vector< unsigned int > i_chanID;
+    vector< unsigned int > i_hitID;
+    vector< double > i_ped;
+    vector< double > i_pedrms;
+    vector< double > i_hilo;
+    for( unsigned int i = 0; i < nhits; i++ )
+    {
+        unsigned int i_channelHitID = 0;
+        try
+        {
+            i_channelHitID = fReader->getHitID( i );
+        }
+        catch( ... )
+        {
+            continue;
+        }
+        if( i_channelHitID < ndead_size && !getDead( i_channelHitID, getHiLo()[i_channelHitID] ) )
+        {
+            i_chanID.push_back( i_channelHitID );
+            i_hitID.push_back( i );
+            i_ped.push_back( getPeds( getHiLo()[i_channelHitID] )[i_channelHitID] );
+            i_pedrms.push_back( getPedrms( getHiLo()[i_channelHitID] )[i_channelHitID] );
+            i_hilo.push_back( getLowGainMultiplier_Trace()*getHiLo()[i_channelHitID] );
+        }
+    }
+    getFitTraceHandler()->fitTraces( fReader, getNSamples(), i_chanID, i_hitID, i_ped, i_pedrms, i_hilo );
+}
+
+/*
+ * trace timing and integration for all high-gain channels at once
+ * (see VTraceBatchHandler)
+ *
+ * same results as the per-channel analysis in calcTZerosSums();
+ * iAnalysed[i] is true for all hits analysed here
+ *
+ * not used for trace fitting, IPR measurements, or raw sums with sliding windows
+ */
+void VImageBaseAnalyzer::calcTZerosSums_batch( int iFirstSum, int iLastSum, unsigned int iTraceIntegrationMethod,
+        unsigned int nhits, vector< bool >& iAnalysed )
+{
+    iAnalysed.assign( nhits, false );
+    if( getTraceFit() > -1 || fTraceHandler->getIPRmeasure()
+            || ( iTraceIntegrationMethod != 1 && iTraceIntegrationMethod != 2 )
+            || ( iTraceIntegrationMethod == 2 && fRaw )
+            || iLastSum < iFirstSum
+            || getNSamples() < 2 || getNSamples() > 128 )
+    {
+        return;
+    }
+    if( !fTraceBatchHandler )
+    {
+        fTraceBatchHandler = new VTraceBatchHandler();
+    }
+    fTraceBatchHandler->reset( getNSamples(), nhits );
+    fTraceBatchHandler->setPulseTimingLevels( fTraceHandler->getPulseTimingLevels() );
+
+    ///////////////////////////////////////////
+    // fill traces of good high-gain channels
+    unsigned int ndead_size = getDead().size();
+    vector< unsigned int > i_hit;
+    for( unsigned int i = 0; i < nhits; i++ )
+    {
+        unsigned int i_channelHitID = 0;
+        try
+        {
+            i_channelHitID = fReader->getHitID( i );
+        }
+        catch( ... )
+        {
+            continue;
+        }
+        if( i_channelHitID < ndead_size && !getHiLo()[i_channelHitID] && !getDead( i_channelHitID, false ) )
+        {
+            if( fTraceBatchHandler->addChannel( fReader, i_channelHitID, i, getPeds( false )[i_channelHitID],
+                                                fTraceHandler->getMC_FADCTraceStart() ) )
+            {
+                i_hit.push_back( i );
+            }
+        }
+    }
+    unsigned int nc = fTraceBatchHandler->getNChannels();
+    if( nc == 0 )
+    {
+        return;
+    }
+    fTraceHandler->setTraceIntegrationmethod( iTraceIntegrationMethod );
+    unsigned int nl = fTraceBatchHandler->getNLanes();
+    int nsamples = ( int )getNSamples();
+
+    ///////////////////////////////////////////
+    // pulse timing and summation windows
+    vector< int > corrfirst( nl, 0 );
+    vector< int > corrlast( nl, 0 );
+    vector< int > i_maxFirst( nl, 0 );
+    vector< int > i_maxLast( nl, 0 );
+    vector< int > i_maxPos;
+    for( unsigned int c = 0; c < nc; c++ )
+    {
+        unsigned int i_channelHitID = fTraceBatchHandler->getChannelID( c );
+        // time offsets (from laser/flasher calibration)
+        int offset = 0;
+        if( !getRunParameter()->fFixWindowStart )
+        {
+            if( getTOffsets()[i_channelHitID] > 0 )
+            {
+                offset = ( int )getTOffsets()[i_channelHitID];
+            }
+            if( getTOffsets()[i_channelHitID] < 0 )
+            {
+                offset = ( int )getTOffsets()[i_channelHitID] - 1;
+            }
+        }
+        corrfirst[c] = getFADCTraceIntegrationPosition( iFirstSum + offset );
+        corrlast[c]  = getFADCTraceIntegrationPosition( iLastSum + offset );
+        if( getSumWindowStart_at_T0() )
+        {
+            i_maxLast[c] = nsamples;
+        }
+        else
+        {
+            i_maxFirst[c] = corrfirst[c];
+            i_maxLast[c] = corrlast[c];
+        }
+    }
+    fTraceBatchHandler->calculateMaximum( i_maxFirst, i_maxLast, i_maxPos );
+    for( unsigned int c = 0; c < nc; c++ )
+    {
+        unsigned int i_channelHitID = fTraceBatchHandler->getChannelID( c );
+        setPulseTiming( i_channelHitID, fTraceBatchHandler->getPulseTiming( c, i_maxPos[c], 0, nsamples ), true );
+        // shift the summation window if necessary
+        if( getSumWindowShift() != 0 && !getRunParameter()->fFixWindowStart )
+        {
+            corrfirst[c] = getFADCTraceIntegrationPosition( iFirstSum + ( int )getTOffsets()[i_channelHitID] + getSumWindowShift() );
+            corrlast[c]  = getFADCTraceIntegrationPosition( corrfirst[c] + ( iLastSum - iFirstSum ) );
+        }
+        // use T0 as start of integraction window:
+        if( getSumWindowStart_at_T0() )
+        {
+            corrfirst[c] = getFADCTraceIntegrationPosition( getPulseTiming()[getRunParameter()->fpulsetiming_tzero_index][i_channelHitID] + getSumWindowShift() );
+            corrlast[c]  = getFADCTraceIntegrationPosition( corrfirst[c] + ( iLastSum - iFirstSum ) );
+        }
+        setCurrentSummationWindow( i_channelHitID, corrfirst[c], corrlast[c], false );
+    }
+
+    ///////////////////////////////////////////
+    // integrate traces
+    vector< int > i_window( nl, 0 );
+    if( iTraceIntegrationMethod == 1 )
+    {
+        fTraceBatchHandler->calculateTraceSum_fixedWindow( corrfirst, corrlast, fRaw );
+    }
+    else
+    {
+        for( unsigned int c = 0; c < nc; c++ )
+        {
+            i_window[c] = corrlast[c] - corrfirst[c];
+        }
+        fTraceBatchHandler->calculateTraceSum_slidingWindow( i_window );
+    }
+    // maximum of full trace
+    vector< int > i_traceFirst( nl, 0 );
+    vector< int > i_traceLast( nl, nsamples );
+    fTraceBatchHandler->calculateMaximum( i_traceFirst, i_traceLast, i_maxPos );
+
+    for( unsigned int c = 0; c < nc; c++ )
+    {
+        unsigned int i_channelHitID = fTraceBatchHandler->getChannelID( c );
+        setSums( i_channelHitID, fTraceBatchHandler->getTraceSum( c ) * getLowGainSumCorrection( iLastSum - iFirstSum, corrlast[c] - corrfirst[c], false ) );
+        setTCorrectedSumFirst( i_channelHitID, fTraceBatchHandler->getTraceIntegrationFirst( c ) );
+        setTCorrectedSumLast( i_channelHitID, fTraceBatchHandler->getTraceIntegrationLast( c ) );
+        setTraceAverageTime( i_channelHitID, fTraceBatchHandler->getTraceAverageTime( c ) );
+        double i_tempTraceMax = fTraceBatchHandler->getTraceMax( c, i_maxPos[c] );
+        setTraceMax( i_channelHitID, i_tempTraceMax );
+        setTraceRawMax( i_channelHitID, i_tempTraceMax + getPeds( false )[i_channelHitID] );
+        setTraceN255( i_channelHitID, 0 );
+        if( getFillMeanTraces() )
+        {
+            setTrace( i_channelHitID, fTraceBatchHandler->getTrace( c ), false, getPeds( false )[i_channelHitID] );
+        }
+        if( !getRunParameter()->fDoublePass && getFillPulseSum() )
+        {
+            getAnaData()->fillPulseSum( i_channelHitID, getSums()[i_channelHitID], false );
+        }
+        iAnalysed[i_hit[c]] = true;
+    }
+
+    ///////////////////////////////////////////
+    // no doublepass: pass2 sum
+    if( !getRunParameter()->fDoublePass )
+    {
+        vector< int > corrlast_sw2( nl, 0 );
+        for( unsigned int c = 0; c < nc; c++ )
+        {
+            corrlast_sw2[c] = getFADCTraceIntegrationPosition( corrfirst[c] + ( int )getSumWindow_2() );
+            i_window[c] = corrlast_sw2[c] - corrfirst[c];
+        }
+        if( iTraceIntegrationMethod == 1 )
+        {
+            fTraceBatchHandler->calculateTraceSum_fixedWindow( corrfirst, corrlast_sw2, fRaw );
+        }
+        else
+        {
+            fTraceBatchHandler->calculateTraceSum_slidingWindow( i_window );
+        }
+        for( unsigned int c = 0; c < nc; c++ )
+        {
+            unsigned int i_channelHitID = fTraceBatchHandler->getChannelID( c );
+            if( corrlast_sw2[c] != corrlast[c] )
+            {
+                setSums2( i_channelHitID, fTraceBatchHandler->getTraceSum( c ) * getLowGainSumCorrection( fRunPar->fsumwindow_2[getTelID()], corrlast[c] - corrfirst[c], false ) );
+            }
+            else
+            {
+                setSums2( i_channelHitID, getSums()[i_channelHitID] );
+            }
+            setCurrentSummationWindow( i_channelHitID, corrfirst[c], corrlast[c], true );
+        }
+    }
+}
+
 /*!
 
     apply relative gain correction
@@ -1108,11 +1377,19 @@ void VImageBaseAnalyzer::findDeadChans( bool iLowGain, bool iFirst )
 void VImageBaseAnalyzer::timingCorrect()
 {
     // apply timing correction to all pulse timing parameters
+    // (DST sparse replay: hit channels only, all other channels are not reset between events)
     const unsigned int nc = getTZeros().size();
     if( nc == getTOffsets().size() )
     {
-        for( unsigned int i = 0; i < nc; i++ )
+        const bool bSparse = fReader->isSparseReplay();
+        const unsigned int nhits = ( bSparse ? fReader->getNumChannelsHit() : nc );
+        for( unsigned int h = 0; h < nhits; h++ )
         {
+            unsigned int i = ( bSparse ? fReader->getHitID( h ) : h );
+            if( i >= nc )
+            {
+                continue;
+            }
             if( !getDead()[i] )
             {
                 setPulseTimingCorrection( i, -1. * getTOffsets()[i] );
@@ -1245,6 +1522,7 @@ void VImageBaseAnalyzer::calcSecondTZerosSums()
     {
         cout << "VImageBaseAnalyzer::calcSecondTZerosSums()" << endl;
     }
+    VEvndispProfilerTimer iProfilerTimer( getProfiler(), E_PROF_CALCSECONDTZEROSSUMS );
     // print lots of output for trace debugging
     bool fDebugTrace = false;
 
@@ -1574,3 +1852,107 @@ void VImageBaseAnalyzer::initializeTrace( bool iMakingPeds, unsigned int i_chann
     }
 
 }
+
+/*
+ * DST source files with sparse replay: copy values of hit channels only
+ * (all other channels are set to zero; only channels copied in the
+ *  previous event are reset)
+ *
+ */
+void VImageBaseAnalyzer::copySparseDSTData( bool iSums, bool iTiming, bool iTraceMax )
+{
+    VImageAnalyzerData* iData = getAnaData();
+    // pulse timing vectors are replaced when number of timing levels differ
+    // (reader vectors are zero for all channels not hit)
+    if( iTiming && fReader->getTracePulseTiming().size() != getPulseTiming( true ).size() )
+    {
+        setPulseTiming( fReader->getTracePulseTiming(), true );
+        setPulseTiming( fReader->getTracePulseTiming(), false );
+        iData->fSparseDSTChannelsValid[1] = false;
+        iTiming = false;
+    }
+    // reset channels copied in the previous event (all channels for the first event)
+    if( iSums )
+    {
+        if( !iData->fSparseDSTChannelsValid[0] )
+        {
+            setSums( 0. );
+        }
+        for( unsigned int i = 0; iData->fSparseDSTChannelsValid[0] && i < iData->fSparseDSTChannels[0].size(); i++ )
+        {
+            setSums( iData->fSparseDSTChannels[0][i], 0. );
+        }
+        iData->fSparseDSTChannels[0].clear();
+        iData->fSparseDSTChannelsValid[0] = true;
+    }
+    if( iTiming )
+    {
+        if( !iData->fSparseDSTChannelsValid[1] )
+        {
+            setPulseTiming( 0., true );
+            setPulseTiming( 0., false );
+        }
+        for( unsigned int i = 0; iData->fSparseDSTChannelsValid[1] && i < iData->fSparseDSTChannels[1].size(); i++ )
+        {
+            unsigned int j = iData->fSparseDSTChannels[1][i];
+            for( unsigned int t = 0; t < getPulseTiming( true ).size(); t++ )
+            {
+                if( j < getPulseTiming( true )[t].size() && j < getPulseTiming( false )[t].size() )
+                {
+                    getPulseTiming( true )[t][j] = 0.;
+                    getPulseTiming( false )[t][j] = 0.;
+                }
+            }
+        }
+        iData->fSparseDSTChannels[1].clear();
+        iData->fSparseDSTChannelsValid[1] = true;
+    }
+    if( iTraceMax )
+    {
+        if( !iData->fSparseDSTChannelsValid[2] )
+        {
+            setTraceMax( 0. );
+            setTraceRawMax( 0. );
+        }
+        for( unsigned int i = 0; iData->fSparseDSTChannelsValid[2] && i < iData->fSparseDSTChannels[2].size(); i++ )
+        {
+            setTraceMax( iData->fSparseDSTChannels[2][i], 0. );
+            setTraceRawMax( iData->fSparseDSTChannels[2][i], 0. );
+        }
+        iData->fSparseDSTChannels[2].clear();
+        iData->fSparseDSTChannelsValid[2] = true;
+    }
+    unsigned int nhits = fReader->getNumChannelsHit();
+    for( unsigned int i = 0; i < nhits; i++ )
+    {
+        unsigned int i_channelHitID = fReader->getHitID( i );
+        if( i_channelHitID >= getNChannels() )
+        {
+            continue;
+        }
+        if( iSums )
+        {
+            setSums( i_channelHitID, fReader->getSums()[i_channelHitID] );
+            iData->fSparseDSTChannels[0].push_back( i_channelHitID );
+        }
+        if( iTiming )
+        {
+            iData->fSparseDSTChannels[1].push_back( i_channelHitID );
+            for( unsigned int t = 0; t < getPulseTiming( true ).size(); t++ )
+            {
+                if( i_channelHitID >= getPulseTiming( true )[t].size() || i_channelHitID >= getPulseTiming( false )[t].size() )
+                {
+                    continue;
+                }
+                getPulseTiming( true )[t][i_channelHitID] = fReader->getTracePulseTiming()[t][i_channelHitID];
+                getPulseTiming( false )[t][i_channelHitID] = fReader->getTracePulseTiming()[t][i_channelHitID];
+            }
+        }
+        if( iTraceMax )
+        {
+            setTraceMax( i_channelHitID, fReader->getTraceMax()[i_channelHitID] );
+            setTraceRawMax( i_channelHitID, fReader->getTraceRawMax()[i_channelHitID] );
+            iData->fSparseDSTChannels[2].push_back( i_channelHitID );
+        }
+    }
+}
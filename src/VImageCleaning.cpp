@@ -10,6 +10,11 @@ VImageCleaning::VImageCleaning( VEvndispData* iData )
 {
     fData = iData;
 
+    fCSROffset = 0;
+    fCSRList = 0;
+    fNNOffset = 0;
+    fNNList = 0;
+
     fProb4nnCurves = 0;
     fProb3nnrelCurves = 0;
     fProb2plus1Curves = 0;
@@ -34,13 +39,19 @@ VImageCleaning::VImageCleaning( VEvndispData* iData )
         kInitNNImgClnPerTelType[i] = false;
         fMinRate[i] = 0.;
         fifActiveNN.push_back( i_tempB );
+        for( unsigned int j = 0; j < VDST_MAXNNGROUPTYPES; j++ )
+        {
+            fNNPreThresh[i][j] = 0.;
+            fNNCombFactor[i][j] = 0.;
+        }
+    }
+    // multiplicity of NN groups (order as in fifActiveNN)
+    //                                4nn 2+1 3nn 2nn bound
+    int i_Nfold[VDST_MAXNNGROUPTYPES] = { 4,  3,  3,  2,  1, 0 };
+    for( unsigned int j = 0; j < VDST_MAXNNGROUPTYPES; j++ )
+    {
+        fNNNfold[j] = i_Nfold[j];
     }
-    fIPR_save_mincharge = -99.;
-    fIPR_save_dT_from_probCurve = -99.;
-    fIPR_save_telid = 99;
-    fIPR_save_ProbCurve_par1 = -99.;
-    fIPR_save_ProbCurve_par2 = -99.;
-
 }
 
 /*
@@ -166,45 +177,70 @@ void VImageCleaning::cleanImagePedvars( VImageCleaningRunParameter* iImageCleani
         cout << "VImageCleaning::cleanImagePedvars " << fData->getTelID() << endl;
     }
 
-    fData->setImage( false );
-    fData->setBorder( false );
-    fData->setBrightNonImage( false );
-    fData->setImageBorderNeighbour( false );
     unsigned int i_nchannel = fData->getNChannels();
-    double i_pedvars_i = 0.;
-    double i_pedvars_k = 0.;
-    unsigned int k = 0;
+    fillNeighbourCSR();
+    fillCurrentPedvars();
+    fMaskImage.resize( i_nchannel );
+    fMaskBorder.resize( i_nchannel );
+    fMaskBrightNonImage.resize( i_nchannel );
+    fMaskDead.fill( fData->getDead(), i_nchannel );
+    fMaskTemp.resize( i_nchannel );
 
-    for( unsigned int i = 0; i < i_nchannel; i++ )
+    const double* i_sums = &fData->getSums()[0];
+    const double* i_pedvars = fPedvarsCurrent.size() > 0 ? &fPedvarsCurrent[0] : 0;
+    vector< int >& i_anapixel = fData->getDetectorGeo()->getAnaPixel();
+    vector< bool >& i_hilo = fData->getHiLo();
+    vector< unsigned int >& i_dead = fData->getDead( false );
+    vector< unsigned int >& i_deadLowGain = fData->getDead( true );
+
+    // threshold passes (64 channels per word)
+    for( unsigned int w = 0; w < fMaskImage.getNWords(); w++ )
     {
-        if( fData->getDetectorGeo()->getAnaPixel()[i] < 1 || fData->getDead( i, fData->getHiLo()[i] ) )
+        unsigned int i_start = 64 * w;
+        unsigned int i_n = ( i_nchannel - i_start < 64 ? i_nchannel - i_start : 64 );
+        uint64_t i_image = 0;
+        uint64_t i_border = 0;
+        uint64_t i_bright = 0;
+        uint64_t i_valid = 0;
+        for( unsigned int b = 0; b < i_n; b++ )
         {
-            continue;
+            i_image  |= ( uint64_t )( i_sums[i_start + b] > hithresh * i_pedvars[i_start + b] ) << b;
+            i_border |= ( uint64_t )( i_sums[i_start + b] > lothresh * i_pedvars[i_start + b] ) << b;
+            i_bright |= ( uint64_t )( i_sums[i_start + b] > brightthresh * i_pedvars[i_start + b] ) << b;
         }
-        i_pedvars_i = fData->getPedvars( fData->getCurrentSumWindow()[i], fData->getHiLo()[i] )[i];
-
-        if( fData->getSums()[i] > hithresh * i_pedvars_i )
+        // analysis pixels which are not dead (in the gain used for this event)
+        for( unsigned int b = 0; b < i_n; b++ )
         {
-            fData->setImage( i, true );
-            fData->setBorder( i, false );
-            for( unsigned int j = 0; j < fData->getDetectorGeo()->getNNeighbours()[i]; j++ )
+            unsigned int i = i_start + b;
+            if( i_anapixel[i] > 0 && !i_dead[i] && !( i_hilo[i] && i_deadLowGain[i] ) )
             {
-                k = fData->getDetectorGeo()->getNeighbours()[i][j];
-                if( k < i_nchannel )
-                {
-                    i_pedvars_k = fData->getPedvars( fData->getCurrentSumWindow()[k], fData->getHiLo()[k] )[k];
-                    if( !fData->getImage()[k] && fData->getSums()[k] > lothresh * i_pedvars_k )
-                    {
-                        fData->setBorder( k, true );
-                    }
-                }
+                i_valid |= ( uint64_t )1 << b;
             }
         }
-        if( fData->getSums()[i] > brightthresh  * i_pedvars_i )
+        fMaskImage.getWord( w ) = i_image & i_valid;
+        fMaskBrightNonImage.getWord( w ) = i_bright & i_valid;
+        // border candidates (border threshold only)
+        fMaskBorder.getWord( w ) = i_border;
+    }
+    // border pixels: neighbours of image pixels above border threshold
+    for( unsigned int w = 0; w < fMaskImage.getNWords(); w++ )
+    {
+        uint64_t i_w = fMaskImage.getWord( w );
+        while( i_w )
         {
-            fData->setBrightNonImage( i, true );
+            unsigned int i = 64 * w + VPixelBitMask::getFirstBit( i_w );
+            i_w &= i_w - 1;
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
+            {
+                fMaskTemp.set( fCSRList[j] );
+            }
         }
     }
+    for( unsigned int w = 0; w < fMaskBorder.getNWords(); w++ )
+    {
+        fMaskBorder.getWord( w ) &= fMaskTemp.getWord( w ) & ~fMaskImage.getWord( w );
+    }
+    writeImageBitMasks();
 
     // (preli) set the trigger vector in MC case (preli)
     // trigger vector are image/border tubes
@@ -218,12 +254,13 @@ void VImageCleaning::cleanImagePedvars( VImageCleaningRunParameter* iImageCleani
     }
     // (end of preli)
 
-    recoverImagePixelNearDeadPixel();
+    recoverImagePixelNearDeadPixelBitMask();
     if( iImageCleaningParameters->fremoveIslandOfImageBorderPair )
     {
         removeIslandOfImageBorderPair();
     }
-    fillImageBorderNeighbours();
+    writeImageBitMasks();
+    fillImageBorderNeighboursBitMask();
 }
 
 /*!
@@ -511,22 +548,30 @@ bool VImageCleaning::InitNNImgClnPerTelType( unsigned int teltype )
         // fadc_sum_bins = nBinsADC = 25 % Number of ADC time intervals actually summed up.
         SimTime = sampleTimeSlice * nBinsADC;
     }
-    float fMinRate = fFakeImageProb / ( SimTime * 1E-9 * float( NgroupTypes ) ); //ns
+    fMinRate[teltype] = fFakeImageProb / ( SimTime * 1E-9 * float( NgroupTypes ) ); //ns
 
     // number of combinations
     // (this number is scaled to the size of the camera later)
     float CombFactor[5] = {60000.*20., 950000., 130000., 12000., 2.}; //for 2400 pixels
     float ChargeMax = fIPRgraphs_xmax[teltype];
+    for( unsigned int i = 0; i < 5; i++ )
+    {
+        fNNCombFactor[teltype][i] = CombFactor[i];
+    }
 
     // define rate contour functions
-    fProb4nnCurves->AddAt( defineRateContourFunction( teltype, "ProbCurve4nn", fMinRate, 4, CombFactor[0], 0, ChargeMax ), ( int )teltype );
-    fProb3nnrelCurves->AddAt( defineRateContourFunction( teltype, "ProbCurve3nnrel", fMinRate, 3, CombFactor[2], 0, ChargeMax ), ( int )teltype );
-    fProb2plus1Curves->AddAt( defineRateContourFunction( teltype, "ProbCurve2plus1", fMinRate, 3, CombFactor[1], 0, ChargeMax ), ( int )teltype );
-    fProb2nnCurves->AddAt( defineRateContourFunction( teltype, "ProbCurve2nn", fMinRate, 2, CombFactor[3], 0, ChargeMax ), ( int )teltype );
-    fProbBoundCurves->AddAt( defineRateContourBoundFunction( teltype, "ProbCurveBound", fMinRate, 4.0, CombFactor[4], 0, ChargeMax ), ( int )teltype );
+    // (used for the output file only; contours are calculated in getNNContourDT() during the analysis)
+    fProb4nnCurves->AddAt( defineRateContourFunction( teltype, "ProbCurve4nn", fMinRate[teltype], 4, CombFactor[0], 0, ChargeMax ), ( int )teltype );
+    fProb3nnrelCurves->AddAt( defineRateContourFunction( teltype, "ProbCurve3nnrel", fMinRate[teltype], 3, CombFactor[2], 0, ChargeMax ), ( int )teltype );
+    fProb2plus1Curves->AddAt( defineRateContourFunction( teltype, "ProbCurve2plus1", fMinRate[teltype], 3, CombFactor[1], 0, ChargeMax ), ( int )teltype );
+    fProb2nnCurves->AddAt( defineRateContourFunction( teltype, "ProbCurve2nn", fMinRate[teltype], 2, CombFactor[3], 0, ChargeMax ), ( int )teltype );
+    fProbBoundCurves->AddAt( defineRateContourBoundFunction( teltype, "ProbCurveBound", fMinRate[teltype], 4.0, CombFactor[4], 0, ChargeMax ), ( int )teltype );
+
+    // tabulate IPR graph and pre-search thresholds
+    fillNNLookupTables( teltype, IPRgraph );
 
     cout << "Fake image probability: " << fFakeImageProb << " NgroupTypes: " << NgroupTypes;
-    cout << " teltype " << teltype << " ChargeMax:" << ChargeMax << " Min rate: " << fMinRate;
+    cout << " teltype " << teltype << " ChargeMax:" << ChargeMax << " Min rate: " << fMinRate[teltype];
     cout << std::endl;
 
     /////////////////////////////////////////////////////////////////////////
@@ -560,10 +605,10 @@ bool VImageCleaning::InitNNImgClnPerTelType( unsigned int teltype )
         fWriteGraphToFileRecreate = false;
 
         // probability curves
-        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb4nnCurves->At( teltype ), fMinRate );
-        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb3nnrelCurves->At( teltype ), fMinRate );
-        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb2plus1Curves->At( teltype ), fMinRate );
-        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb2nnCurves->At( teltype ), fMinRate );
+        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb4nnCurves->At( teltype ), fMinRate[teltype] );
+        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb3nnrelCurves->At( teltype ), fMinRate[teltype] );
+        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb2plus1Curves->At( teltype ), fMinRate[teltype] );
+        writeProbabilityCurve( ( TGraph* )fIPRgraphs->At( teltype ), ( TF1* )fProb2nnCurves->At( teltype ), fMinRate[teltype] );
 
         // close output file
         fgraphs->Close();
@@ -615,15 +660,12 @@ void VImageCleaning::writeProbabilityCurve( TGraph* iIPR, TF1* iProb, double iRa
 */
 void VImageCleaning::ScaleCombFactors( unsigned int type, float scale )
 {
+    //                    4nn          2+1      3nn      2nn    bound
     float CombFactor[5] = {60000.*20., 950000., 130000., 6000., 2.}; //for 2400 pixels
-    TF1* f4nn   = ( TF1* )fProb4nnCurves->At( type );
-    TF1* f3nnrel = ( TF1* )fProb3nnrelCurves->At( type );
-    TF1* f2plus1 = ( TF1* )fProb2plus1Curves->At( type );
-    TF1* f2nn   = ( TF1* )fProb2nnCurves->At( type );
-    f4nn->SetParameter( 2, CombFactor[0]*scale );
-    f3nnrel->SetParameter( 2, CombFactor[2]*scale );
-    f2plus1->SetParameter( 2, CombFactor[1]*scale );
-    f2nn->SetParameter( 2, CombFactor[3]*scale );
+    for( unsigned int i = 0; i < 4; i++ )
+    {
+        fNNCombFactor[type][i] = CombFactor[i] * scale;
+    }
 }
 
 /*
@@ -635,29 +677,20 @@ void VImageCleaning::ResetCombFactors( unsigned int type )
     ScaleCombFactors( type, fData->getNChannels() / 2400. ); // for this amount of pixels
 }
 
-bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, TF1* fProbCurve, float refdT, int refvalidity, int idx )
+bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, double iContourNorm, int iNfold,
+                                     float refdT, int refvalidity, int idx )
 {
-    //idx - should be next neighbour of core!!!
-    //skip core pix
-    if( ( VALIDITYBUF[idx] > 1.9 && VALIDITYBUF[idx] < 6.1 ) )
-    {
-        return false;
-    }
-
     // check for valid pixel number
-    if( idx >= ( int )fData->getDetectorGeo()->getNeighbours().size() )
+    if( idx < 0 || idx >= ( int )fData->getDetectorGeo()->getNeighbours().size() )
     {
         return false;
     }
-
-    // get IPR graph
-    TGraph* iIPR = ( TGraph* )fIPRgraphs->At( teltype );
-    if( !iIPR )
+    //idx - should be next neighbour of core!!!
+    //skip core pix
+    if( ( VALIDITYBUF[idx] > 1.9 && VALIDITYBUF[idx] < 6.1 ) )
     {
-        cout << "VImageCleaning::BoundarySearch error, no IPR graph for telescope type " << teltype << endl;
-        return 0;
+        return false;
     }
-    float iIPR_max = fIPRgraphs_xmax[teltype];
 
     //    float TimeForReSearch = 0.;
     bool iffound = false;
@@ -665,9 +698,9 @@ bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, TF1* fP
     float time = 0.;
 
     // reftime from core pixels
-    for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[idx].size(); j++ )
+    for( unsigned int j = fNNOffset[idx]; j < fNNOffset[idx + 1]; j++ )
     {
-        const Int_t idx2 = fData->getDetectorGeo()->getNeighbours()[idx][j];
+        const Int_t idx2 = fNNList[j];
         Float_t t = TIMES[idx2];
         if( t > 0. && VALIDITYBUF[idx2] > 1.9 && VALIDITYBUF[idx2] < 5.1 )
         {
@@ -687,7 +720,7 @@ bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, TF1* fP
         float mincharge = 0;
         LocMin( 2, charges, mincharge );
 
-        if( NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, maxtime, CoincWinLimit, true )
+        if( NNChargeAndTimeCut( teltype, iContourNorm, iNfold, mincharge, maxtime, CoincWinLimit, true )
                 && VALIDITY[idx] > 0.5 )
         {
             if( VALIDITYBOUND[idx] != refvalidity )
@@ -697,9 +730,9 @@ bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, TF1* fP
             iffound = true;
         }
 
-        for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[idx].size(); j++ )
+        for( unsigned int j = fNNOffset[idx]; j < fNNOffset[idx + 1]; j++ )
         {
-            const Int_t idx2 = fData->getDetectorGeo()->getNeighbours()[idx][j];
+            const Int_t idx2 = fNNList[j];
             if( ( TIMES[idx2] > 0. && VALIDITYBUF[idx2] > 1.9 && VALIDITYBUF[idx2] < 5.1 ) || VALIDITYBOUND[idx2] == refvalidity )
             {
                 continue;
@@ -711,7 +744,7 @@ bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, TF1* fP
             charges[1] = INTENSITY[idx2];
             LocMin( 2, charges, mincharge );
 
-            if( NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, maxtime, CoincWinLimit, true )
+            if( NNChargeAndTimeCut( teltype, iContourNorm, iNfold, mincharge, maxtime, CoincWinLimit, true )
                     && VALIDITY[idx2] > 0.5 )
             {
                 VALIDITYBOUND[idx2] = refvalidity;
@@ -728,27 +761,23 @@ bool VImageCleaning::BoundarySearch( unsigned int teltype, float thresh, TF1* fP
  * if Nfold = 3 it will search for 2nn+1, including sparse groups (with the empty pix in between)
  *
 */
-unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fProbCurve, float PreCut )
+unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, unsigned int iGroupType, float PreCut )
 {
-    if( !fProbCurve )
+    if( iGroupType >= VDST_MAXNNGROUPTYPES )
     {
         return 0;
     }
 
     // Nfold (e.g. 2 or 3)
-    int NN = ( int )fProbCurve->GetParameter( 1 );
-
-    TGraph* iIPR = ( TGraph* )fIPRgraphs->At( type );
-    if( !iIPR )
-    {
-        cout << "VImageCleaning::NNGroupSearchProbCurve error, no IPR graph for telescope type " << type << endl;
-        return 0;
-    }
-    float iIPR_max = fIPRgraphs_xmax[type];
+    int NN = fNNNfold[iGroupType];
+    double i_norm = getNNContourNorm( type, iGroupType );
 
     // (GM) unclear why this is hardwired here
     int NSBpix = 5;
 
+    // charge and time cuts for all pixel pairs
+    fillNNPairCuts( type, i_norm, NN, PreCut );
+
     //////////////////////////////
     // loop over all pixels
     int numpix = fData->getDetectorGeo()->getNumChannels();
@@ -756,28 +785,20 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
     {
         // check validity of a pixel and apply pre cut on charge
         // if not: skip
-        if( VALIDITY[PixNum] < 0.5 || INTENSITY[PixNum] < PreCut )
+        if( !fNNPixelValid[PixNum] )
         {
             continue;
         }
 
-        // access neighbour list and loop over all neighbours
-        if( PixNum >= ( int )fData->getDetectorGeo()->getNeighbours().size() )
-        {
-            continue;
-        }
-        for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[PixNum].size(); j++ )
+        // loop over all neighbours
+        for( unsigned int j = fNNOffset[PixNum]; j < fNNOffset[PixNum + 1]; j++ )
         {
-            const Int_t PixNum2 = fData->getDetectorGeo()->getNeighbours()[PixNum][j];
-            if( PixNum2 < 0 )
-            {
-                continue;
-            }
-            // apply validity and pre-cut to neighbour pixel
-            if( VALIDITY[PixNum2] < 0.5 || INTENSITY[PixNum2] < PreCut )
+            // apply validity, pre-cut, charge and time cut to pixel pair
+            if( !fNNPairPass[j] )
             {
                 continue;
             }
+            const Int_t PixNum2 = fNNList[j];
 
             // time difference between pixel and its neighbour
             Double_t dT = fabs( TIMES[PixNum] - TIMES[PixNum2] );
@@ -787,12 +808,6 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
             float mincharge = 0;
             LocMin( 2, charges, mincharge );
 
-            // apply charge and time cut
-            if( !NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, dT, CoincWinLimit ) )
-            {
-                continue;
-            }
-
             // validity of pixel and neighbour to 2
             if( VALIDITYBUF[PixNum] < 2.9 )
             {
@@ -814,9 +829,9 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
             if( VALIDITYBUF[PixNum2] == 2 && NN == 3 )
             {
                 bool iffound = false;
-                for( unsigned int k = 0; k < fData->getDetectorGeo()->getNeighbours()[PixNum].size(); k++ )
+                for( unsigned int k = fNNOffset[PixNum]; k < fNNOffset[PixNum + 1]; k++ )
                 {
-                    if( BoundarySearch( type, mincharge, fProbCurve, dT, 3, fData->getDetectorGeo()->getNeighbours()[PixNum][k] ) )
+                    if( BoundarySearch( type, mincharge, i_norm, NN, dT, 3, fNNList[k] ) )
                     {
                         iffound = true;
                     }
@@ -825,9 +840,9 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
                 {
                     continue;
                 }
-                for( unsigned int k = 0; k < fData->getDetectorGeo()->getNeighbours()[PixNum2].size(); k++ )
+                for( unsigned int k = fNNOffset[PixNum2]; k < fNNOffset[PixNum2 + 1]; k++ )
                 {
-                    if( BoundarySearch( type, mincharge, fProbCurve, dT, 3, fData->getDetectorGeo()->getNeighbours()[PixNum2][k] ) )
+                    if( BoundarySearch( type, mincharge, i_norm, NN, dT, 3, fNNList[k] ) )
                     {
                         iffound = true;
                     }
@@ -860,13 +875,9 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
                 Int_t idxm = -1;
                 Int_t idxp = -1;
                 Int_t nn = 0;
-                for( unsigned int kk = 0; kk < fData->getDetectorGeo()->getNeighbours()[PixNum].size(); kk++ )
+                for( unsigned int kk = fNNOffset[PixNum]; kk < fNNOffset[PixNum + 1]; kk++ )
                 {
-                    const Int_t k = fData->getDetectorGeo()->getNeighbours()[PixNum][kk];
-                    if( k < 0 )
-                    {
-                        continue;
-                    }
+                    const Int_t k = fNNList[kk];
                     Double_t xx = x - fData->getDetectorGeo()->getX()[k];
                     Double_t yy = y - fData->getDetectorGeo()->getY()[k];
 
@@ -903,7 +914,7 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
                 float maxtime = 1E6;
                 LocMax( 2, times2, maxtime );
                 // apply charge and time cut
-                if( !NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, maxtime, CoincWinLimit ) )
+                if( !NNChargeAndTimeCut( type, i_norm, NN, mincharge, maxtime, CoincWinLimit ) )
                 {
                     continue;
                 }
@@ -944,7 +955,7 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
                     LocMax( 4, times3, maxtime );
 
                     // apply charge and time cut
-                    if( !NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, maxtime, CoincWinLimit ) )
+                    if( !NNChargeAndTimeCut( type, i_norm, NN, mincharge, maxtime, CoincWinLimit ) )
                     {
                         continue;
                     }
@@ -1008,41 +1019,13 @@ unsigned int VImageCleaning::NNGroupSearchProbCurve( unsigned int type, TF1* fPr
  *
  */
 bool VImageCleaning::NNChargeAndTimeCut(
-    TGraph* iIPR, float iIPR_max, TF1* fProbCurve,
+    unsigned int teltype, double iContourNorm, int iNfold,
     float mincharge, float dT,
     float iCoincWinLimit,
     bool bInvert )
 {
-    if( !iIPR || !fProbCurve )
-    {
-        return false;
-    }
-    float valDT = 0.;
-    // use previous result if charge and all other
-    // parameter are the same
-    if( fIPR_save_mincharge > -90.
-            && fIPR_save_telid == fData->getTelID()
-            && TMath::Abs( fIPR_save_ProbCurve_par1 - fProbCurve->GetParameter( 1 ) ) < 1.e-3
-            && TMath::Abs( fIPR_save_ProbCurve_par2 - fProbCurve->GetParameter( 2 ) ) < 1.e-3
-            && TMath::Abs( fIPR_save_mincharge - mincharge ) < 1.e-3 )
-    {
-        valDT = fIPR_save_dT_from_probCurve;
-    }
-    else
-    {
-        // get expected NSB frequency for this charge
-        float valIPR = iIPR->Eval( mincharge, 0, "" );
-        if( valIPR < 100. || mincharge > iIPR_max )
-        {
-            valIPR = 100.;   // Hz
-        }
-        valDT = fProbCurve->Eval( valIPR );
-        fIPR_save_dT_from_probCurve = valDT;
-        fIPR_save_mincharge = mincharge;
-        fIPR_save_telid = fData->getTelID();
-        fIPR_save_ProbCurve_par1 = fProbCurve->GetParameter( 1 );
-        fIPR_save_ProbCurve_par2 = fProbCurve->GetParameter( 2 );
-    }
+    // maximum time difference for expected NSB frequency at this charge
+    float valDT = getNNContourDT( getNNIPR( teltype, mincharge ), iContourNorm, iNfold );
 
     // apply cut in deltaT
     // (note cut on maximum coincidence limit (given in the cleaning parameter file))
@@ -1070,25 +1053,19 @@ bool VImageCleaning::NNChargeAndTimeCut(
  *
  * used for NN 3 and 4
  */
-unsigned int VImageCleaning::NNGroupSearchProbCurveRelaxed( unsigned int teltype, TF1* fProbCurve, float PreCut )
+unsigned int VImageCleaning::NNGroupSearchProbCurveRelaxed( unsigned int teltype, unsigned int iGroupType, float PreCut )
 {
-    if( !fProbCurve )
+    if( iGroupType >= VDST_MAXNNGROUPTYPES )
     {
         return 0;
     }
 
     // Nfold (e.g. 2 or 3)
-    int NN = ( int )fProbCurve->GetParameter( 1 );
+    int NN = fNNNfold[iGroupType];
+    double i_norm = getNNContourNorm( teltype, iGroupType );
 
-    TGraph* iIPR = ( TGraph* )fIPRgraphs->At( teltype );
-    if( !iIPR )
-    {
-        cout << "VImageCleaning::NNGroupSearchProbCurveRelaxed error, no IPR graph for telescope type " << teltype << endl;
-        return 0;
-    }
-    float iIPR_max = fIPRgraphs_xmax[teltype];
-    fIPR_save_mincharge = -99.;
-    fIPR_save_dT_from_probCurve = -99.;
+    // charge and time cuts for all pixel pairs
+    fillNNPairCuts( teltype, i_norm, NN, PreCut );
 
     int NNcnt = 1;
     float dT = 0.;
@@ -1102,41 +1079,28 @@ unsigned int VImageCleaning::NNGroupSearchProbCurveRelaxed( unsigned int teltype
     {
         int nng3[3];
 
-        if( VALIDITY[PixNum] < 0.5 || INTENSITY[PixNum] < PreCut )
+        if( !fNNPixelValid[PixNum] )
         {
             continue;
         }
         NNcnt = 1;
         int pix1 = 0, pix2 = 0, pix3 = 0, pix4 = 0;
-        if( PixNum >= ( int )fData->getDetectorGeo()->getNeighbours().size() )
-        {
-            continue;
-        }
-        for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[PixNum].size(); j++ )
+        for( unsigned int j = fNNOffset[PixNum]; j < fNNOffset[PixNum + 1]; j++ )
         {
-            Int_t PixNum2 = fData->getDetectorGeo()->getNeighbours()[PixNum][j];
-            if( PixNum2 < 0 )
-            {
-                continue;
-            }
-            if( VALIDITY[PixNum2] < 0.5 || INTENSITY[PixNum2] < PreCut )
+            // apply validity, pre-cut, charge and time cut to pixel pair
+            if( !fNNPairPass[j] )
             {
                 continue;
             }
+            Int_t PixNum2 = fNNList[j];
             dT = fabs( TIMES[PixNum] - TIMES[PixNum2] );
             float charges[2] = {INTENSITY[PixNum], INTENSITY[PixNum2]};
             float mincharge = 0;
             LocMin( 2, charges, mincharge );
 
-            // apply charge and time cut
-            if( !NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, dT, CoincWinLimit ) )
-            {
-                continue;
-            }
-
             //////////////////////////////////////////
             float maxtime = 1E6;
-            if( NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, dT, 1.e6, true )
+            if( NNChargeAndTimeCut( teltype, i_norm, NN, mincharge, dT, 1.e6, true )
                     && VALIDITY[PixNum2] > 0.5 && INTENSITY[PixNum2] > PreCut )
             {
                 pix1 = PixNum;
@@ -1155,7 +1119,7 @@ unsigned int VImageCleaning::NNGroupSearchProbCurveRelaxed( unsigned int teltype
                 float times2[3] = { dT, dt2, dt3};
                 LocMax( 3, times2, maxtime );
 
-                if( NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, mincharge, maxtime, 1.e6, true ) )
+                if( NNChargeAndTimeCut( teltype, i_norm, NN, mincharge, maxtime, 1.e6, true ) )
                 {
                     NNcnt++;
                 }
@@ -1191,14 +1155,10 @@ unsigned int VImageCleaning::NNGroupSearchProbCurveRelaxed( unsigned int teltype
                 //4 connected pixels
                 for( int n = 0; n < 3; n++ )
                 {
-                    if( nng3[n] >= ( int )fData->getDetectorGeo()->getNeighbours().size() )
+                    for( unsigned int jj = fNNOffset[nng3[n]]; jj < fNNOffset[nng3[n] + 1]; jj++ )
                     {
-                        continue;
-                    }
-                    for( unsigned int jj = 0; jj < fData->getDetectorGeo()->getNeighbours()[nng3[n]].size(); jj++ )
-                    {
-                        const Int_t testpixnum = fData->getDetectorGeo()->getNeighbours()[nng3[n]][jj];
-                        if( testpixnum < 0 || VALIDITYLOCAL[testpixnum] == 10 )
+                        const Int_t testpixnum = fNNList[jj];
+                        if( VALIDITYLOCAL[testpixnum] == 10 )
                         {
                             continue;
                         }
@@ -1218,7 +1178,7 @@ unsigned int VImageCleaning::NNGroupSearchProbCurveRelaxed( unsigned int teltype
                                           };
                         LocMax( 4, times3, maxtimeloc );
 
-                        if( NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurve, minchargeloc, maxtimeloc, CoincWinLimit, true ) )
+                        if( NNChargeAndTimeCut( teltype, i_norm, NN, minchargeloc, maxtimeloc, CoincWinLimit, true ) )
                         {
                             NNcnt++;
                             pix4 = testpixnum;
@@ -1321,6 +1281,9 @@ void VImageCleaning::DiscardLocalTimeOutlayers( float NNthresh[6] )
     unsigned int numpix = fData->getDetectorGeo()->getNumChannels();
     unsigned int nimagepix = 0;
     DiscardIsolatedPixels();
+    // list of image pixels
+    // (pixels are only removed from the image below, validity is checked again in all loops)
+    vector< unsigned int > i_imagepix;
     for( unsigned int pixnum = 0; pixnum < numpix; pixnum++ )
     {
         if( VALIDITY[pixnum] < 1.9 )
@@ -1328,6 +1291,7 @@ void VImageCleaning::DiscardLocalTimeOutlayers( float NNthresh[6] )
             continue;
         }
         nimagepix++;
+        i_imagepix.push_back( pixnum );
     }
     // don't do anything for small images
     if( nimagepix <= 4 )
@@ -1348,8 +1312,9 @@ void VImageCleaning::DiscardLocalTimeOutlayers( float NNthresh[6] )
     unsigned int pixzerocnt = 0;
     //******************************************************************
     // discard groups with no neighbouring group in the vicinity of 6pixels
-    for( unsigned int pixnum = 0; pixnum < numpix; pixnum++ )
+    for( unsigned int ii = 0; ii < i_imagepix.size(); ii++ )
     {
+        unsigned int pixnum = i_imagepix[ii];
         if( VALIDITY[pixnum] < 1.9 )
         {
             continue;
@@ -1360,8 +1325,9 @@ void VImageCleaning::DiscardLocalTimeOutlayers( float NNthresh[6] )
         pixcnt = 0;
         pixzerocnt = 0;
         // loop over vicinity of 2 rings around pixnum
-        for( unsigned int pp = 0; pp < numpix; pp++ )
+        for( unsigned int jj = 0; jj < i_imagepix.size(); jj++ )
         {
+            unsigned int pp = i_imagepix[jj];
             if( VALIDITY[pp] < 1.9 || pp == pixnum )
             {
                 continue;
@@ -1395,8 +1361,9 @@ void VImageCleaning::DiscardLocalTimeOutlayers( float NNthresh[6] )
     unsigned int Tcnt = 0;
     float sigmaT = 0.;
     float meanT = 0.;
-    for( unsigned int pixnum = 0; pixnum < numpix; pixnum++ )
+    for( unsigned int ii = 0; ii < i_imagepix.size(); ii++ )
     {
+        unsigned int pixnum = i_imagepix[ii];
         if( VALIDITY[pixnum] < 1.9 )
         {
             continue;
@@ -1409,8 +1376,9 @@ void VImageCleaning::DiscardLocalTimeOutlayers( float NNthresh[6] )
         y = fData->getDetectorGeo()->getY()[pixnum] / diam; // coord in pixels units
 
         // loop over vicinity of 2 rings around pixnum
-        for( unsigned int pp = 0; pp < numpix; pp++ )
+        for( unsigned int jj = 0; jj < i_imagepix.size(); jj++ )
         {
+            unsigned int pp = i_imagepix[jj];
             if( VALIDITY[pp] < 1.9 || pp == pixnum )
             {
                 continue;
@@ -1495,14 +1463,10 @@ void  VImageCleaning::SetNeighborRings( unsigned short* VALIDITYBOUNDBUF, float*
             float time = 0.;
             float refthresh = 0.;
             int n = 0;
-            if( idx >= fData->getDetectorGeo()->getNeighbours().size() )
-            {
-                continue;
-            }
-            for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[idx].size(); j++ )
+            for( unsigned int j = fNNOffset[idx]; j < fNNOffset[idx + 1]; j++ )
             {
-                int idx2 = fData->getDetectorGeo()->getNeighbours()[idx][j];
-                if( idx2 < 0 || VALIDITYBOUNDBUF[idx2] < 1.9 )
+                int idx2 = fNNList[j];
+                if( VALIDITYBOUNDBUF[idx2] < 1.9 )
                 {
                     continue;
                 }
@@ -1572,15 +1536,12 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
     //                 [p.e.]
     // (NOTE: replaced by FillPreThresholds() in the next line
     //  (unit then changed to d.c.)
-    float PreThresh[6] = { 2.0,   // 4nn
-                           3.0,   // 2+1
-                           2.8,   // 3nn
-                           5.2,   // 2nn
-                           1.8,   // Bound.
-                           4.0
-                         }; // Bound RefCharge
-
-    FillPreThresholds( ( TGraph* )fIPRgraphs->At( teltype ), PreThresh );
+    // (pre thresholds are filled once per telescope type in fillNNLookupTables() )
+    float PreThresh[6];
+    for( unsigned int i = 0; i < 6; i++ )
+    {
+        PreThresh[i] = fNNPreThresh[teltype][i];
+    }
 
     memset( VALIDITYBOUND, 0, sizeof( VALIDITYBOUND ) );
     memset( VALIDITY, 0, sizeof( VALIDITY ) );
@@ -1610,7 +1571,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
     // 2NN
     if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][3] )
     {
-        ngroups = NNGroupSearchProbCurve( teltype, ( TF1* )fProb2nnCurves->At( teltype ), PreThresh[3] );
+        ngroups = NNGroupSearchProbCurve( teltype, 3, PreThresh[3] );
         for( unsigned int p = 0; p < numpix; p++ )
         {
             if( VALIDITYBUF[p] == 2 )
@@ -1623,7 +1584,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
     // 2NNplus1
     if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][1] )
     {
-        ngroups += NNGroupSearchProbCurve( teltype, ( TF1* )fProb2plus1Curves->At( teltype ), PreThresh[1] );
+        ngroups += NNGroupSearchProbCurve( teltype, 1, PreThresh[1] );
         for( unsigned int p = 0; p < numpix; p++ )
         {
             if( VALIDITYBUF[p] == 3 || VALIDITYBOUND[p] == 3 )
@@ -1636,7 +1597,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
     // 3NN (note: relaxed search)
     if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][2] )
     {
-        ngroups += NNGroupSearchProbCurveRelaxed( teltype, ( TF1* )fProb3nnrelCurves->At( teltype ), PreThresh[2] );
+        ngroups += NNGroupSearchProbCurveRelaxed( teltype, 2, PreThresh[2] );
         for( unsigned int p = 0; p < numpix; p++ )
         {
             if( VALIDITYBUF[p] == 5 )
@@ -1649,7 +1610,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
     // 4NN (note: relaxed search)
     if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][0] )
     {
-        ngroups += NNGroupSearchProbCurveRelaxed( teltype, ( TF1* )fProb4nnCurves->At( teltype ), PreThresh[0] );
+        ngroups += NNGroupSearchProbCurveRelaxed( teltype, 0, PreThresh[0] );
         for( unsigned int p = 0; p < numpix; p++ )
         {
             if( VALIDITYBUF[p] == 6 )
@@ -1699,7 +1660,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
         ScaleCombFactors( teltype, float( nboundsearchpix ) / ( numpix * 1.5 ) );
         if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][3] )
         {
-            NNGroupSearchProbCurve( teltype, ( TF1* )fProb2nnCurves->At( teltype ), 0.8 * PreThresh[3] );
+            NNGroupSearchProbCurve( teltype, 3, 0.8 * PreThresh[3] );
             for( unsigned int p = 0; p < numpix; p++ )
             {
                 if( VALIDITY[p] > 1.9 )
@@ -1715,7 +1676,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
 
         if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][1] )
         {
-            NNGroupSearchProbCurve( teltype, ( TF1* )fProb2plus1Curves->At( teltype ), 0.8 * PreThresh[1] );
+            NNGroupSearchProbCurve( teltype, 1, 0.8 * PreThresh[1] );
             for( unsigned int p = 0; p < numpix; p++ )
             {
                 if( VALIDITY[p] > 1.9 )
@@ -1731,7 +1692,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
 
         if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][2] )
         {
-            NNGroupSearchProbCurveRelaxed( teltype, ( TF1* )fProb3nnrelCurves->At( teltype ), 0.8 * PreThresh[2] );
+            NNGroupSearchProbCurveRelaxed( teltype, 2, 0.8 * PreThresh[2] );
             for( unsigned int p = 0; p < numpix; p++ )
             {
                 if( VALIDITY[p] > 1.9 )
@@ -1747,7 +1708,7 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
 
         if( teltype < fifActiveNN.size() &&  fifActiveNN[teltype][0] )
         {
-            NNGroupSearchProbCurveRelaxed( teltype, ( TF1* )fProb4nnCurves->At( teltype ), 0.9 * PreThresh[0] );
+            NNGroupSearchProbCurveRelaxed( teltype, 0, 0.9 * PreThresh[0] );
             for( unsigned int p = 0; p < numpix; p++ )
             {
                 if( VALIDITY[p] > 1.9 )
@@ -1785,13 +1746,6 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
 
     // BOUNDARY pixel search (usually very few pixels are found)
     // only first ring
-    TF1* fProbCurveBound = ( TF1* )fProbBoundCurves->At( teltype );
-    TGraph* iIPR = ( TGraph* )fIPRgraphs->At( teltype );
-    if( !iIPR )
-    {
-        cout << "VImageCleaning::ImageCleaningCharge error, no IPR graph for telescope type " << teltype << endl;
-        return 0;
-    }
     float iIPR_max = fIPRgraphs_xmax[teltype];
 
     for( Int_t iRing = 0; iRing < 1; iRing++ )
@@ -1810,14 +1764,10 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
             float time = 0.;
             float charge = 0.;
 
-            if( idx >= fData->getDetectorGeo()->getNeighbours().size() )
-            {
-                continue;
-            }
-            for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[idx].size(); j++ )
+            for( unsigned int j = fNNOffset[idx]; j < fNNOffset[idx + 1]; j++ )
             {
-                const Int_t idx2 = fData->getDetectorGeo()->getNeighbours()[idx][j];
-                if( idx2 < 0 || VALIDITYBOUNDBUF[idx2] < 1.9 )
+                const Int_t idx2 = fNNList[j];
+                if( VALIDITYBOUNDBUF[idx2] < 1.9 )
                 {
                     continue;
                 }
@@ -1888,16 +1838,15 @@ int VImageCleaning::ImageCleaningCharge( unsigned int teltype )
                 float charges[2] = {INTENSITY[idx], ( float )charge };
                 float refth = 0.;
                 LocMin( 2, charges, refth );
-                fProbCurveBound->SetParameter( 2, 2.*nfirstringpix );
-
-                Double_t valIPRref = iIPR->Eval( charge, 0, "" );
-                if( valIPRref < 100. || charge >= iIPR_max )
+                Double_t valIPRref = 100.;
+                if( charge < iIPR_max )
                 {
-                    valIPRref = 100.;
+                    valIPRref = getNNIPR( teltype, charge );
                 }
-                fProbCurveBound->SetParameter( 1, valIPRref );
+                // boundary rate contour (see defineRateContourBoundFunction(); combinatorial factor is 2 x number of pixels in first ring)
+                double i_normBound = 1.e9 * fMinRate[teltype] / ( 2.*nfirstringpix * valIPRref );
 
-                if( NNChargeAndTimeCut( iIPR, iIPR_max, fProbCurveBound, refth, dT, 0.6 * CoincWinLimit, true ) )
+                if( NNChargeAndTimeCut( teltype, i_normBound, 1, refth, dT, 0.6 * CoincWinLimit, true ) )
                 {
                     VALIDITY[idx] = iRing + 7;
                 }
@@ -2038,6 +1987,7 @@ void VImageCleaning::cleanNNImageFixed( VImageCleaningRunParameter* iImageCleani
 
     ///////////////////////////////////////////////////////////////////////////////
     // optimized NN image cleaning
+    fillNNNeighbourLists();
     int ngroups = ImageCleaningCharge( teltype );
 
     ///////////////////////////////////////////////////////////////////////////////////
@@ -2143,6 +2093,254 @@ void VImageCleaning::FillPreThresholds( TGraph* gipr, float NNthresh[6] )
     }
 }
 
+/*
+ * tabulate IPR graph and pre-search thresholds for NN image cleaning
+ * (once per telescope type)
+ *
+ * IPR graph points are sorted in charge; equidistant graphs (standard case)
+ * are accessed directly by index
+ */
+void VImageCleaning::fillNNLookupTables( unsigned int teltype, TGraph* iIPR )
+{
+    if( !iIPR || teltype >= VDST_MAXTELTYPES )
+    {
+        return;
+    }
+    if( fNNIPRCharge.size() < VDST_MAXTELTYPES )
+    {
+        fNNIPRCharge.resize( VDST_MAXTELTYPES );
+        fNNIPRRate.resize( VDST_MAXTELTYPES );
+        fNNIPRChargeStepInv.resize( VDST_MAXTELTYPES, 0. );
+    }
+    // sort IPR graph points in charge
+    vector< pair< double, double > > i_points( iIPR->GetN() );
+    for( int i = 0; i < iIPR->GetN(); i++ )
+    {
+        i_points[i].first = iIPR->GetX()[i];
+        i_points[i].second = iIPR->GetY()[i];
+    }
+    sort( i_points.begin(), i_points.end() );
+    fNNIPRCharge[teltype].resize( i_points.size() );
+    fNNIPRRate[teltype].resize( i_points.size() );
+    for( unsigned int i = 0; i < i_points.size(); i++ )
+    {
+        fNNIPRCharge[teltype][i] = i_points[i].first;
+        fNNIPRRate[teltype][i] = i_points[i].second;
+    }
+    // check for equidistant charges
+    fNNIPRChargeStepInv[teltype] = 0.;
+    if( i_points.size() > 1 )
+    {
+        double i_step = ( i_points.back().first - i_points[0].first ) / ( double )( i_points.size() - 1 );
+        bool bEquidistant = ( i_step > 0. );
+        for( unsigned int i = 1; i < i_points.size() && bEquidistant; i++ )
+        {
+            if( fabs( i_points[i].first - i_points[0].first - i * i_step ) > 1.e-6 * i_step )
+            {
+                bEquidistant = false;
+            }
+        }
+        if( bEquidistant )
+        {
+            fNNIPRChargeStepInv[teltype] = 1. / i_step;
+        }
+    }
+
+    // pre-search thresholds (length must match VDST_MAXNNGROUPTYPES)
+    //                 [p.e.]
+    // (NOTE: replaced by FillPreThresholds() in the next line
+    //  (unit then changed to d.c.)
+    float PreThresh[6] = { 2.0,   // 4nn
+                           3.0,   // 2+1
+                           2.8,   // 3nn
+                           5.2,   // 2nn
+                           1.8,   // Bound.
+                           4.0
+                         }; // Bound RefCharge
+    FillPreThresholds( iIPR, PreThresh );
+    for( unsigned int i = 0; i < 6; i++ )
+    {
+        fNNPreThresh[teltype][i] = PreThresh[i];
+    }
+}
+
+/*
+ * IPR (rate in Hz) for the given charge from tabulated IPR graph
+ *
+ * linear interpolation (extrapolation) as in TGraph::Eval();
+ * rate is set to 100 Hz for small rates or charges above the IPR graph range
+ */
+float VImageCleaning::getNNIPR( unsigned int teltype, float charge )
+{
+    if( charge > fIPRgraphs_xmax[teltype] )
+    {
+        return 100.;
+    }
+    const vector< double >& x = fNNIPRCharge[teltype];
+    const vector< double >& y = fNNIPRRate[teltype];
+    float valIPR = 0.;
+    if( x.size() == 1 )
+    {
+        valIPR = y[0];
+    }
+    else if( x.size() > 1 )
+    {
+        int low = 0;
+        if( charge > x[0] )
+        {
+            if( fNNIPRChargeStepInv[teltype] > 0. )
+            {
+                low = ( int )( ( charge - x[0] ) * fNNIPRChargeStepInv[teltype] );
+            }
+            else
+            {
+                low = ( int )( upper_bound( x.begin(), x.end(), ( double )charge ) - x.begin() ) - 1;
+            }
+        }
+        if( low > ( int )x.size() - 2 )
+        {
+            low = ( int )x.size() - 2;
+        }
+        if( x[low] == x[low + 1] )
+        {
+            valIPR = y[low];
+        }
+        else
+        {
+            valIPR = y[low + 1] + ( charge - x[low + 1] ) * ( y[low] - y[low + 1] ) / ( x[low] - x[low + 1] );
+        }
+    }
+    if( valIPR < 100. )
+    {
+        valIPR = 100.;   // Hz
+    }
+    return valIPR;
+}
+
+/*
+ * normalisation of rate contour for NN group type
+ * (depends on rate and combinatorial factor; see getNNContourDT())
+ */
+double VImageCleaning::getNNContourNorm( unsigned int teltype, unsigned int iGroupType )
+{
+    int iNfold = fNNNfold[iGroupType];
+    if( iNfold < 2 || fNNCombFactor[teltype][iGroupType] <= 0. )
+    {
+        return 0.;
+    }
+    return 1.e9 * pow( ( double )fMinRate[teltype] / ( double )fNNCombFactor[teltype][iGroupType], 1. / ( iNfold - 1. ) );
+}
+
+/*
+ * rate contour: maximum time difference [ns] for a NN group with the given IPR
+ *
+ * closed form of the functions in defineRateContourFunction() (iNfold > 1)
+ * and defineRateContourBoundFunction() (iNfold = 1):
+ *
+ *    dT = iContourNorm * IPR^( -Nfold / ( Nfold - 1 ) )
+ */
+float VImageCleaning::getNNContourDT( float iIPR, double iContourNorm, int iNfold )
+{
+    double i_ipr = iIPR;
+    if( iNfold == 1 )
+    {
+        return iContourNorm / i_ipr;
+    }
+    else if( iNfold == 2 )
+    {
+        return iContourNorm / ( i_ipr * i_ipr );
+    }
+    else if( iNfold == 3 )
+    {
+        return iContourNorm / ( i_ipr * sqrt( i_ipr ) );
+    }
+    else if( iNfold == 4 )
+    {
+        return iContourNorm / ( i_ipr * cbrt( i_ipr ) );
+    }
+    return iContourNorm * pow( i_ipr, -iNfold / ( iNfold - 1. ) );
+}
+
+/*
+ * neighbour lists for NN image cleaning
+ * (flat arrays per telescope; invalid neighbours are removed)
+ */
+void VImageCleaning::fillNNNeighbourLists()
+{
+    unsigned int iTelID = fData->getTelID();
+    if( iTelID >= fNNNeighbourOffset.size() )
+    {
+        fNNNeighbourOffset.resize( iTelID + 1 );
+        fNNNeighbourList.resize( iTelID + 1 );
+    }
+    unsigned int numpix = fData->getDetectorGeo()->getNumChannels();
+    vector< unsigned int >& i_offset = fNNNeighbourOffset[iTelID];
+    vector< unsigned int >& i_list = fNNNeighbourList[iTelID];
+    if( i_offset.size() != numpix + 1 )
+    {
+        i_offset.assign( numpix + 1, 0 );
+        i_list.clear();
+        for( unsigned int i = 0; i < numpix; i++ )
+        {
+            if( i < fData->getDetectorGeo()->getNeighbours().size() )
+            {
+                for( unsigned int j = 0; j < fData->getDetectorGeo()->getNeighbours()[i].size(); j++ )
+                {
+                    int k = fData->getDetectorGeo()->getNeighbours()[i][j];
+                    if( k >= 0 && k < ( int )numpix )
+                    {
+                        i_list.push_back( ( unsigned int )k );
+                    }
+                }
+            }
+            i_offset[i + 1] = i_list.size();
+        }
+        // avoid zero pointer for cameras without neighbours
+        if( i_list.size() == 0 )
+        {
+            i_list.push_back( 0 );
+        }
+    }
+    fNNOffset = &i_offset[0];
+    fNNList = &i_list[0];
+
+    fNNPixelValid.resize( numpix );
+    fNNPixelDT.resize( numpix );
+    fNNPairPass.resize( i_list.size() );
+}
+
+/*
+ * charge and time cut for all pairs of neighbouring pixels
+ *
+ * the rate contour is evaluated once per pixel; the contour of a pair is the one
+ * of the pixel with the smaller charge
+ */
+void VImageCleaning::fillNNPairCuts( unsigned int teltype, double iContourNorm, int iNfold, float PreCut )
+{
+    unsigned int numpix = fData->getDetectorGeo()->getNumChannels();
+    for( unsigned int p = 0; p < numpix; p++ )
+    {
+        fNNPixelValid[p] = !( VALIDITY[p] < 0.5 || INTENSITY[p] < PreCut );
+        fNNPixelDT[p] = 0.;
+        if( fNNPixelValid[p] )
+        {
+            fNNPixelDT[p] = getNNContourDT( getNNIPR( teltype, INTENSITY[p] ), iContourNorm, iNfold );
+        }
+    }
+    const float* i_dTContour = &fNNPixelDT[0];
+    const unsigned char* i_valid = &fNNPixelValid[0];
+    for( unsigned int p = 0; p < numpix; p++ )
+    {
+        for( unsigned int j = fNNOffset[p]; j < fNNOffset[p + 1]; j++ )
+        {
+            const unsigned int q = fNNList[j];
+            float dT = fabs( TIMES[p] - TIMES[q] );
+            float valDT = ( INTENSITY[p] > INTENSITY[q] ? i_dTContour[q] : i_dTContour[p] );
+            fNNPairPass[j] = i_valid[p] & i_valid[q] & ( dT <= CoincWinLimit ) & ( dT <= valDT );
+        }
+    }
+}
+
 void VImageCleaning::FillIPR( unsigned int teltype ) //tel type
 {
     float  gIPRUp = 1500.; //charge in FADC counts
@@ -2186,10 +2384,18 @@ void VImageCleaning::FillIPR( unsigned int teltype ) //tel type
 //*****************************************************************************************************
 
 /*
-   simple cluster cleaning.
-   get image pixels (above threshold)
-   find clusters of touching pixels
-   keep N biggest clusters; cut on cluster size and number of pixels
+ * sort clusters by size (largest first)
+ */
+static bool compareClusterSize( const pair< double, int >& a, const pair< double, int >& b )
+{
+    return a.first > b.first;
+}
+
+/*
+   simple cluster cleaning.
+   get image pixels (above threshold)
+   find clusters of touching pixels
+   keep N biggest clusters; cut on cluster size and number of pixels
    add border pixels
    in part derived from time cluster cleaning
 */
@@ -2243,9 +2449,11 @@ void VImageCleaning::cleanImageWithClusters( VImageCleaningRunParameter* iImageC
 
     // STEP 2: Make clusters
     // - group touching core pixels to clusters
+    unsigned int i_nchannel = fData->getNChannels();
+    fillNeighbourCSR();
 
     //in case there is still something in the memory, reset all channels to cluster id 0
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    for( unsigned int i = 0; i < i_nchannel; i++ )
     {
         fData->setClusterID( i, 0 );
     }
@@ -2258,71 +2466,52 @@ void VImageCleaning::cleanImageWithClusters( VImageCleaningRunParameter* iImageC
     fSizeCluster.push_back( 0 );
     fNpixCluster.push_back( 0 );
 
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    for( unsigned int i = 0; i < i_nchannel; i++ )
     {
         if( fData->getImage()[i] && fData->getClusterID()[i] == 0 ) //new cluster
         {
             fNCluster++;
             fSizeCluster.push_back( 0 );
             fNpixCluster.push_back( 0 );
-            //recursively add channel & its neighbors to the cluster.
+            // add channel & its neighbors to the cluster.
             addToCluster( fNCluster, i );
         }
     }
 
     // find clusters passing the size cuts
-    vector<int> good_clusters;
+    vector< bool > i_keepCluster( fNCluster + 1, false );
+    vector< pair< double, int > > good_clusters;
     for( unsigned int i = 1; i <= fNCluster; i++ )
     {
         if( fSizeCluster.at( i ) >= minSizeCluster && fNpixCluster.at( i ) >= minNumPixel )
         {
-            good_clusters.push_back( i );
-        }
-        else
-        {
-            removeCluster( i );
+            good_clusters.push_back( make_pair( fSizeCluster.at( i ), ( int )i ) );
         }
     }
 
-    //sort clusters by size. Bubblesort algorithm from wikipedia.
-    unsigned int n = good_clusters.size();
-    do
-    {
-        int newn = 0;
-        for( unsigned int i = 1; i < n; i++ )
-        {
-            if( fSizeCluster.at( good_clusters.at( i - 1 ) ) < fSizeCluster.at( good_clusters.at( i ) ) )
-            {
-                unsigned int temp = good_clusters.at( i );
-                good_clusters.at( i ) = good_clusters.at( i - 1 );
-                good_clusters.at( i - 1 ) = temp;
-                newn = i;
-            }
-        }
-        n = newn;
-    }
-    while( n > 0 );
+    //sort clusters by size (largest first; clusters of equal size keep their order)
+    stable_sort( good_clusters.begin(), good_clusters.end(), compareClusterSize );
 
     //only keep the nmax largest clusters
-    if( maxNumCluster > 0 )
+    if( maxNumCluster > 0 && good_clusters.size() > ( unsigned int )maxNumCluster )
     {
-        for( unsigned int i = maxNumCluster; i < good_clusters.size() ; i++ )
-        {
-            removeCluster( good_clusters.at( i ) );
-            good_clusters.erase( good_clusters.begin() + i );
-            i--;
-        }
+        good_clusters.resize( maxNumCluster );
+    }
+    for( unsigned int i = 0; i < good_clusters.size(); i++ )
+    {
+        i_keepCluster[good_clusters[i].second] = true;
     }
+    removeClusters( i_keepCluster );
 
     //add border pixels
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    for( unsigned int i = 0; i < i_nchannel; i++ )
     {
         int i_ID = fData->getClusterID()[i];
         if( fData->getImage()[i] && fData->getClusterID()[i] > 0 )
         {
-            for( unsigned int j = 0; j < fData->getDetectorGeo()->getNNeighbours()[i]; j++ )
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
+                unsigned int k = fCSRList[j];
                 if( fData->getImage()[k] || fData->getBorder()[k] )
                 {
                     continue;
@@ -2354,49 +2543,62 @@ void VImageCleaning::cleanImageWithClusters( VImageCleaningRunParameter* iImageC
 
 }
 
-//recursively add a pixel and its neighboring image pixels to a cluster.
+/*
+ * add channel and all touching image pixels to cluster cID
+ *
+ * depth-first search with an explicit stack (same pixel order as a recursive
+ * search; avoids deep recursion for large images)
+ */
 void VImageCleaning::addToCluster( unsigned int cID, unsigned int iChan )
 {
-    fData->setClusterID( iChan, cID );
-    if( fSizeCluster.size() > ( unsigned int ) cID )
+    if( fSizeCluster.size() <= cID || fNpixCluster.size() <= cID )
     {
-        fSizeCluster.at( cID ) += fData->getSums()[iChan];
-    }
-    else
-    {
-        cout << "VImageCleaning::addToCluster warning: ClusterID " << cID << " not available in fSizeCluster vector (size " <<  fSizeCluster.size() << ")" << endl;
-    }
-    if( fNpixCluster.size() > ( unsigned int ) cID )
-    {
-        fNpixCluster.at( cID )++;
-    }
-    else
-    {
-        cout << "VImageCleaning::addToCluster warning: ClusterID " << cID << " not available in fNpixCluster vector (size " <<  fNpixCluster.size() << ")" << endl;
+        cout << "VImageCleaning::addToCluster warning: ClusterID " << cID << " not available in cluster vectors (size ";
+        cout <<  fSizeCluster.size() << ", " << fNpixCluster.size() << ")" << endl;
+        return;
     }
-
-    for( unsigned int j = 0; j < fData->getDetectorGeo()->getNNeighbours()[iChan]; j++ )
+    // stack of (channel, next position in neighbour list)
+    fClusterStack.clear();
+    fData->setClusterID( iChan, cID );
+    fSizeCluster[cID] += fData->getSums()[iChan];
+    fNpixCluster[cID]++;
+    fClusterStack.push_back( make_pair( iChan, fCSROffset[iChan] ) );
+    while( fClusterStack.size() > 0 )
     {
-        unsigned int k = fData->getDetectorGeo()->getNeighbours()[iChan][j];
+        unsigned int i = fClusterStack.back().first;
+        unsigned int& j = fClusterStack.back().second;
+        if( j >= fCSROffset[i + 1] )
+        {
+            fClusterStack.pop_back();
+            continue;
+        }
+        unsigned int k = fCSRList[j];
+        j++;
         if( fData->getImage()[k] && fData->getClusterID()[k] == 0 )
         {
-            addToCluster( cID, k ) ;
+            fData->setClusterID( k, cID );
+            fSizeCluster[cID] += fData->getSums()[k];
+            fNpixCluster[cID]++;
+            fClusterStack.push_back( make_pair( k, fCSROffset[k] ) );
         }
     }
-    return;
 }
 
-//remove a cluster (ie. set all its pixels to non-image status)
-void VImageCleaning::removeCluster( unsigned int cID )
+/*
+ * remove clusters (ie. set all its pixels to non-image status)
+ *
+ * iKeepCluster: flag for each cluster ID (clusters not in this list are kept)
+ */
+void VImageCleaning::removeClusters( const vector< bool >& iKeepCluster )
 {
     for( unsigned int i = 0; i < fData->getNChannels(); i++ )
     {
-        if( fData->getClusterID()[i] == ( int )cID )
+        int i_ID = fData->getClusterID()[i];
+        if( i_ID > 0 && i_ID < ( int )iKeepCluster.size() && !iKeepCluster[i_ID] )
         {
             fData->setImage( i, false );
         }
     }
-    return;
 }
 
 
@@ -2508,6 +2710,7 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
 
     // REALLY NEEDED: in case there is still something in the memory, reset all channels to cluster id 0
     //                needs to be checked for memory leaks!!!
+    fillNeighbourCSR();
     for( unsigned int i = 0; i < i_nchannel; i++ )
     {
         fData->setClusterID( i, 0 );
@@ -2535,13 +2738,9 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
 
             fData->setClusterID( i, c_id );
 
-            if( i >= fData->getDetectorGeo()->getNeighbours().size() )
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                continue;
-            }
-            for( unsigned int j = 0; j < fData->getDetectorGeo()->getNNeighbours()[i]; j++ )
-            {
-                unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
+                unsigned int k = fCSRList[j];
                 if( fData->getImage()[k] && fData->getClusterID()[k] == 0 )
                 {
                     if( fabs( fData->getTZeros()[i] - fData->getTZeros()[k] ) < timeCutPixel )
@@ -2571,34 +2770,41 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
 
     double i_mainclustersize = 0; // size of the "main cluster"
 
-    int cluster = 0;
-    while( cluster <= i_cluster )
+    // sums for all clusters (one loop over all channels)
+    vector< int > i_sumNpix( i_cluster + 1, 0 );
+    vector< double > i_sumSize( i_cluster + 1, 0. );
+    vector< double > i_sumTime( i_cluster + 1, 0. );
+    vector< double > i_sumX( i_cluster + 1, 0. );
+    vector< double > i_sumY( i_cluster + 1, 0. );
+    for( unsigned int i = 0; i < i_nchannel; i++ )
     {
-
-        i_clusterNpix = 0;
-        i_clustersize = 0.;
-        i_clustertime = 0.;
-        i_clustercenx = 0.;
-        i_cenx = 0.;
-        i_clusterceny = 0.;
-        i_ceny = 0.;
-
-        for( unsigned int i = 0; i < i_nchannel; i++ )
+        int i_ID = fData->getClusterID()[i];
+        if( i_ID >= 0 && i_ID <= i_cluster && fData->getImage()[i] )
         {
-            if( fData->getClusterID()[i] == cluster && fData->getImage()[i] )
-            {
-                i_clusterNpix++;
+            i_sumNpix[i_ID]++;
 
-                i_clustersize += fData->getSums()[i];
-                i_clustertime += ( fData->getSums()[i] * fData->getTZeros()[i] );
+            i_sumSize[i_ID] += fData->getSums()[i];
+            i_sumTime[i_ID] += ( fData->getSums()[i] * fData->getTZeros()[i] );
 
-                double xi = fData->getDetectorGeo()->getX()[i];
-                double yi = fData->getDetectorGeo()->getY()[i];
+            double xi = fData->getDetectorGeo()->getX()[i];
+            double yi = fData->getDetectorGeo()->getY()[i];
 
-                i_cenx += ( fData->getSums()[i] * xi );
-                i_ceny += ( fData->getSums()[i] * yi );
-            }
+            i_sumX[i_ID] += ( fData->getSums()[i] * xi );
+            i_sumY[i_ID] += ( fData->getSums()[i] * yi );
         }
+    }
+
+    int cluster = 0;
+    while( cluster <= i_cluster )
+    {
+        i_clusterNpix = i_sumNpix[cluster];
+        i_clustersize = i_sumSize[cluster];
+        i_clustertime = i_sumTime[cluster];
+        i_cenx = i_sumX[cluster];
+        i_ceny = i_sumY[cluster];
+        i_clustercenx = 0.;
+        i_clusterceny = 0.;
+
         if( i_clustersize != 0 )
         {
             i_clustertime = i_clustertime / i_clustersize;
@@ -2660,6 +2866,8 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
         i_clusterXpos = 0.;
         i_clusterXtime = 0.;
 
+        // clusters to be removed
+        vector< bool > i_removeCluster( i_cluster + 1, false );
         cluster = 1;
         while( cluster <= i_cluster )
         {
@@ -2668,25 +2876,26 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
             i_clusterXpos = i_clusterX * fData->getImageParameters()->cosphi + i_clusterY * fData->getImageParameters()->sinphi;
             i_clusterXtime = fData->getImageParameters()->tgrad_x * i_clusterXpos;
 
-            for( unsigned int i = 0; i < i_nchannel; i++ )
+            if( fabs( ( fData->getClusterTime()[cluster] - fData->getClusterTime()[fData->getMainClusterID()] ) - ( i_clusterXtime - i_mainXtime ) ) > timeCutCluster )
             {
-                i_ID = fData->getClusterID()[i];
-                if( i_ID == 0 || i_ID == fData->getMainClusterID() )
-                {
-                    continue;
-                }
-
-                if( i_ID == cluster && fData->getImage()[i] )
-                {
-                    if( fabs( ( fData->getClusterTime()[i_ID] - fData->getClusterTime()[fData->getMainClusterID()] ) - ( i_clusterXtime - i_mainXtime ) ) > timeCutCluster )
-                    {
-                        fData->setImage( i, false );
-                        fData->setClusterID( i, -99 );
-                    }
-                }
+                i_removeCluster[cluster] = true;
             }
             cluster++;
         }
+        for( unsigned int i = 0; i < i_nchannel; i++ )
+        {
+            i_ID = fData->getClusterID()[i];
+            if( i_ID <= 0 || i_ID > i_cluster || i_ID == fData->getMainClusterID() )
+            {
+                continue;
+            }
+
+            if( i_removeCluster[i_ID] && fData->getImage()[i] )
+            {
+                fData->setImage( i, false );
+                fData->setClusterID( i, -99 );
+            }
+        }
     }
     else
     {
@@ -2733,9 +2942,9 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
             i_ID = fData->getClusterID()[i];
             if( fData->getImage()[i] || fData->getBorder()[i] )
             {
-                for( unsigned int j = 0; j < fData->getDetectorGeo()->getNNeighbours()[i]; j++ )
+                for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
                 {
-                    unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
+                    unsigned int k = fCSRList[j];
 
                     if( isFixed )
                     {
@@ -2785,32 +2994,37 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
         fData->setClusterTime( x, 0 );
     }
 
+    // sums for all clusters (one loop over all channels)
+    i_sumNpix.assign( i_cluster + 1, 0 );
+    i_sumSize.assign( i_cluster + 1, 0. );
+    i_sumTime.assign( i_cluster + 1, 0. );
+    for( unsigned int i = 0; i < i_nchannel; i++ )
+    {
+        i_ID = fData->getClusterID()[i];
+        if( i_ID >= 1 && i_ID <= i_cluster )
+        {
+            if( fData->getImage()[i] || fData->getBorder()[i] )
+            {
+                i_sumNpix[i_ID]++;
+                i_sumSize[i_ID] += fData->getSums()[i];
+                i_sumTime[i_ID] += fData->getSums()[i] * fData->getTZeros()[i];
+            }
+            else
+            {
+                fData->setClusterID( i, -99 );
+            }
+        }
+    }
+
     i_mainclustersize = 0;
     cluster = 1;
 
     while( cluster <= i_cluster )
     {
+        i_clusterNpix = i_sumNpix[cluster];
+        i_clustersize = i_sumSize[cluster];
+        i_clustertime = i_sumTime[cluster];
 
-        i_clusterNpix = 0;
-        i_clustersize = 0.;
-        i_clustertime = 0.;
-
-        for( unsigned int i = 0; i < i_nchannel; i++ )
-        {
-            if( fData->getClusterID()[i] == cluster )
-            {
-                if( fData->getImage()[i] || fData->getBorder()[i] )
-                {
-                    i_clusterNpix++;
-                    i_clustersize += fData->getSums()[i];
-                    i_clustertime += fData->getSums()[i] * fData->getTZeros()[i];
-                }
-                else
-                {
-                    fData->setClusterID( i, -99 );
-                }
-            }
-        }
         if( i_clustersize != 0 )
         {
             i_clustertime = i_clustertime / i_clustersize;
@@ -2888,44 +3102,97 @@ void VImageCleaning::cleanImageWithTiming( VImageCleaningRunParameter* iImageCle
 }
 
 
+/*
+ * merge touching clusters (image and border pixels)
+ *
+ * clusters are merged completely (union-find over cluster IDs); a merged
+ * cluster keeps the ID of the cluster of the pixel currently processed
+ * (channels in ascending order)
+ */
 void VImageCleaning::mergeClusters()
 {
+    unsigned int i_nchannel = fData->getNChannels();
+    fillNeighbourCSR();
+
+    // (all image and border pixels have positive cluster IDs)
+    int i_maxID = 0;
+    for( unsigned int i = 0; i < i_nchannel; i++ )
+    {
+        if( ( fData->getImage()[i] || fData->getBorder()[i] ) && fData->getClusterID()[i] > i_maxID )
+        {
+            i_maxID = fData->getClusterID()[i];
+        }
+    }
+    fClusterMerge.resize( i_maxID + 1 );
+    for( int c = 0; c <= i_maxID; c++ )
+    {
+        fClusterMerge[c] = c;
+    }
+
     int i_clusterID;
     int k_clusterID;
-
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    for( unsigned int i = 0; i < i_nchannel; i++ )
     {
-        if( fData->getImage()[i] || fData->getBorder()[i] )
+        if( ( fData->getImage()[i] || fData->getBorder()[i] ) && fData->getClusterID()[i] > 0 )
         {
-            i_clusterID = fData->getClusterID()[i];
-            unsigned int i_neighbour_size = fData->getDetectorGeo()->getNNeighbours()[i];
+            i_clusterID = findMergedCluster( fData->getClusterID()[i] );
 
-            for( unsigned int j = 0; j < i_neighbour_size; j++ )
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
-                k_clusterID = fData->getClusterID()[k];
-
-                if( ( fData->getImage()[k] || fData->getBorder()[k] ) && k_clusterID != 0 && k_clusterID != fData->getClusterID()[i] )
+                unsigned int k = fCSRList[j];
+                if( !( fData->getImage()[k] || fData->getBorder()[k] ) || fData->getClusterID()[k] <= 0 )
                 {
-                    for( unsigned int n = 0; n < fData->getNChannels(); n++ )
-                    {
-                        if( ( fData->getImage()[n] || fData->getBorder()[n] ) && fData->getClusterID()[n] == fData->getClusterID()[k] )
-                        {
-                            fData->setClusterID( n, i_clusterID );
-                        }
-                    }
+                    continue;
+                }
+                k_clusterID = findMergedCluster( fData->getClusterID()[k] );
+                if( k_clusterID != i_clusterID )
+                {
+                    fClusterMerge[k_clusterID] = i_clusterID;
                 }
             }
         }
     }
+    for( unsigned int i = 0; i < i_nchannel; i++ )
+    {
+        if( ( fData->getImage()[i] || fData->getBorder()[i] ) && fData->getClusterID()[i] > 0 )
+        {
+            fData->setClusterID( i, findMergedCluster( fData->getClusterID()[i] ) );
+        }
+    }
+}
+
+/*
+ * ID of the cluster a cluster has been merged into (path halving)
+ */
+int VImageCleaning::findMergedCluster( int iClusterID )
+{
+    while( fClusterMerge[iClusterID] != iClusterID )
+    {
+        fClusterMerge[iClusterID] = fClusterMerge[fClusterMerge[iClusterID]];
+        iClusterID = fClusterMerge[iClusterID];
+    }
+    return iClusterID;
 }
 
 
 void VImageCleaning::removeSmallClusters( int minPix )
 {
     int i_cluster = 0;
+    unsigned int i_nchannel = fData->getNChannels();
 
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    fillNeighbourCSR();
+    readImageBitMasks();
+    // dead channels (in the gain used for this event)
+    fMaskTemp.resize( i_nchannel );
+    for( unsigned int i = 0; i < i_nchannel && i < fData->getDead().size(); i++ )
+    {
+        if( fData->getDead( fData->getHiLo()[i] )[i] )
+        {
+            fMaskTemp.set( i );
+        }
+    }
+
+    for( unsigned int i = 0; i < i_nchannel; i++ )
     {
         i_cluster = fData->getClusterID()[i];
         if( i_cluster == 0 || i_cluster == -99 )
@@ -2936,14 +3203,14 @@ void VImageCleaning::removeSmallClusters( int minPix )
         // remove clusters with less then minPix
         if( fData->getClusterNpix()[i_cluster] < minPix )
         {
-            if( fData->getImage()[i] )
+            if( fMaskImage.test( i ) )
             {
-                fData->setImage( i, false );
+                fMaskImage.reset( i );
                 fData->setClusterID( i, -99 );
             }
-            else if( fData->getBorder()[i] )
+            else if( fMaskBorder.test( i ) )
             {
-                fData->setBorder( i, false );
+                fMaskBorder.reset( i );
                 fData->setClusterID( i, -99 );
             }
         }
@@ -2954,26 +3221,25 @@ void VImageCleaning::removeSmallClusters( int minPix )
 
         bool dont_remove = false;
 
-        if( fData->getImage()[i] )
+        if( fMaskImage.test( i ) )
         {
-            unsigned int i_neighbour_size = fData->getDetectorGeo()->getNNeighbours()[i];
-            for( unsigned int j = 0; j < i_neighbour_size; j++ )
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
-                if( fData->getImage()[k] )
+                unsigned int k = fCSRList[j];
+                if( fMaskImage.test( k ) )
                 {
                     dont_remove = true;
                 }
-                else if( fData->getBorder()[k] )
+                else if( fMaskBorder.test( k ) )
                 {
                     c1++;
                 }
-                else if( k < fData->getDead().size() && fData->getDead( fData->getHiLo()[k] )[k] )
+                else if( fMaskTemp.test( k ) )
                 {
-                    for( unsigned l = 0; l < i_neighbour_size; l++ )
+                    for( unsigned int l = fCSROffset[i]; l < fCSROffset[i + 1]; l++ )
                     {
-                        unsigned int m = fData->getDetectorGeo()->getNeighbours()[i][l];
-                        if( m != i && m < fData->getBorder().size() && ( fData->getBorder()[m] || fData->getImage()[m] ) )
+                        unsigned int m = fCSRList[l];
+                        if( m != i && ( fMaskBorder.test( m ) || fMaskImage.test( m ) ) )
                         {
                             c2++;
                         }
@@ -2986,35 +3252,30 @@ void VImageCleaning::removeSmallClusters( int minPix )
             }
         }
 
-        if( c1 + c2 < 2 && fData->getImage()[i] )
+        if( c1 + c2 < 2 && fMaskImage.test( i ) )
         {
-            fData->setImage( i, false );
-            fData->setBorder( i, false );
-            fData->setBrightNonImage( i, true );
+            fMaskImage.reset( i );
+            fMaskBorder.reset( i );
+            fMaskBrightNonImage.set( i );
             fData->setClusterID( i, -99 );
 
             // remove the rest of the single core cluster (if it exists)
-            unsigned int i_neighbour_size = fData->getDetectorGeo()->getNNeighbours()[i];
-            for( unsigned int j = 0; j < i_neighbour_size; j++ )
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
-                if( fData->getBorder()[k] )
+                unsigned int k = fCSRList[j];
+                if( fMaskBorder.test( k ) )
                 {
-                    fData->setBorder( k, false );
+                    fMaskBorder.reset( k );
 
-                    for( unsigned l = 0; l < fData->getDetectorGeo()->getNNeighbours()[k]; l++ )
+                    for( unsigned int l = fCSROffset[k]; l < fCSROffset[k + 1]; l++ )
                     {
-                        unsigned int m = fData->getDetectorGeo()->getNeighbours()[k][l];
-                        if( fData->getBorder()[m] )
-                        {
-                            fData->setBorder( m, false );
-                        }
+                        fMaskBorder.reset( fCSRList[l] );
                     }
                 }
             }
         }
     }
-
+    writeImageBitMasks();
 }
 
 /*
@@ -3023,76 +3284,86 @@ void VImageCleaning::removeSmallClusters( int minPix )
  */
 void VImageCleaning::fillImageBorderNeighbours()
 {
-    fData->setImageBorderNeighbour( false );
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    fillNeighbourCSR();
+    readImageBitMasks();
+    fillImageBorderNeighboursBitMask();
+}
+
+void VImageCleaning::fillImageBorderNeighboursBitMask()
+{
+    fMaskTemp.resize( fMaskImage.size() );
+    for( unsigned int w = 0; w < fMaskImage.getNWords(); w++ )
     {
-        if( fData->getImage()[i] || fData->getBorder()[i] )
+        uint64_t i_w = fMaskImage.getWord( w ) | fMaskBorder.getWord( w );
+        // a pixel is its own neighbour :-)
+        fMaskTemp.getWord( w ) |= i_w;
+        // loop over all neighbours
+        while( i_w )
         {
-            // a pixel is its own neighbour :-)
-            fData->getImageBorderNeighbour()[i] = true;
-            // loop over all neighbours
-            unsigned int i_neighbour_size = fData->getDetectorGeo()->getNNeighbours()[i];
-            for( unsigned int j = 0; j < i_neighbour_size; j++ )
+            unsigned int i = 64 * w + VPixelBitMask::getFirstBit( i_w );
+            i_w &= i_w - 1;
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                unsigned int k = fData->getDetectorGeo()->getNeighbours()[i][j];
-                if( k < fData->getImageBorderNeighbour().size() && !fData->getDead()[k] )
+                if( !fMaskDead.test( fCSRList[j] ) )
                 {
-                    fData->getImageBorderNeighbour()[k] = true;
+                    fMaskTemp.set( fCSRList[j] );
                 }
             }
         }
     }
+    fMaskTemp.fillVector( fData->getImageBorderNeighbour() );
 }
 
 /*
  * remove any island of a single image and a single border pixel only
  * (introduced in discussions about NN cleaning)
  *
+ * (operates on image/border bit masks)
 */
 void VImageCleaning::removeIslandOfImageBorderPair()
 {
     unsigned int num_neigh_image = 0;
     unsigned int num_neigh_border = 0;
-    unsigned int i_neighbour_size = 0;
     unsigned int k = 0;
     unsigned int single_neighbour = 0;
     // count number of neighbour pixels to an image pixel which are image or border
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    for( unsigned int w = 0; w < fMaskImage.getNWords(); w++ )
     {
-        if( !fData->getImage()[i] )
-        {
-            continue;
-        }
-        num_neigh_image = 0;
-        num_neigh_border = 0;
-        i_neighbour_size = fData->getDetectorGeo()->getNNeighbours()[i];
-        for( unsigned int j = 0; j < i_neighbour_size; j++ )
+        uint64_t i_w = fMaskImage.getWord( w );
+        while( i_w )
         {
-            k = fData->getDetectorGeo()->getNeighbours()[i][j];
-            if( fData->getImage()[k] )
+            unsigned int i = 64 * w + VPixelBitMask::getFirstBit( i_w );
+            i_w &= i_w - 1;
+            num_neigh_image = 0;
+            num_neigh_border = 0;
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                num_neigh_image++;
+                k = fCSRList[j];
+                if( fMaskImage.test( k ) )
+                {
+                    num_neigh_image++;
+                }
+                else if( fMaskBorder.test( k ) )
+                {
+                    num_neigh_border++;
+                    single_neighbour = k;
+                }
+                if( num_neigh_image > 1 || num_neigh_border > 1 )
+                {
+                    break;
+                }
             }
-            else if( fData->getBorder()[k] )
+            if( num_neigh_image == 0 && num_neigh_border == 0 )
             {
-                num_neigh_border++;
-                single_neighbour = k;
+                fMaskImage.reset( i );
             }
-            if( num_neigh_image > 1 || num_neigh_border > 1 )
+            // remove image pixels with single neighbour
+            if( num_neigh_image == 0 && num_neigh_border == 1 )
             {
-                break;
+                fMaskImage.reset( i );
+                fMaskBorder.reset( single_neighbour );
             }
         }
-        if( num_neigh_image == 0 && num_neigh_border == 0 )
-        {
-            fData->setImage( i, false );
-        }
-        // remove image pixels with single neighbour
-        if( num_neigh_image == 0 && num_neigh_border == 1 )
-        {
-            fData->setImage( i, false );
-            fData->setBorder( single_neighbour, false );
-        }
     }
 }
 
@@ -3102,59 +3373,152 @@ void VImageCleaning::removeIslandOfImageBorderPair()
  * if neighbour is dead, check neighbours of this dead channel (see e.g. run 329 event 709)
  */
 void VImageCleaning::recoverImagePixelNearDeadPixel()
+{
+    fillNeighbourCSR();
+    readImageBitMasks();
+    recoverImagePixelNearDeadPixelBitMask();
+    writeImageBitMasks();
+}
+
+/*
+ * image pixels without image or border neighbours are removed
+ *
+ * (the neighbours of a dead neighbour are neighbours of the image pixel
+ *  itself, and are therefore covered by the same test)
+ */
+void VImageCleaning::recoverImagePixelNearDeadPixelBitMask()
 {
     bool i_neigh = false;
-    unsigned int i_neighbour_size = 0;
-    unsigned int k = 0;
 
-    for( unsigned int i = 0; i < fData->getNChannels(); i++ )
+    for( unsigned int w = 0; w < fMaskImage.getNWords(); w++ )
     {
-        if( fData->getImage()[i] )
+        uint64_t i_w = fMaskImage.getWord( w );
+        while( i_w )
         {
+            unsigned int i = 64 * w + VPixelBitMask::getFirstBit( i_w );
+            i_w &= i_w - 1;
+            if( fCSROffset[i] == fCSROffset[i + 1] )
+            {
+                continue;
+            }
             i_neigh = false;
-            i_neighbour_size = fData->getDetectorGeo()->getNNeighbours()[i];
-            for( unsigned int j = 0; j < i_neighbour_size; j++ )
+            for( unsigned int j = fCSROffset[i]; j < fCSROffset[i + 1]; j++ )
             {
-                k = fData->getDetectorGeo()->getNeighbours()[i][j];
-                if( k < fData->getBorder().size() && ( fData->getBorder()[k] || fData->getImage()[k] ) )
+                if( fMaskImage.test( fCSRList[j] ) || fMaskBorder.test( fCSRList[j] ) )
                 {
-                    fData->setImage( i, true );
                     i_neigh = true;
                     break;
                 }
-                else if( k < fData->getDead().size() && fData->getDead( k, fData->getHiLo()[k] ) )
+            }
+            if( !i_neigh )
+            {
+                fMaskImage.reset( i );
+            }
+        }
+    }
+    // image or border pixels are not bright non-image pixels
+    for( unsigned int w = 0; w < fMaskBrightNonImage.getNWords(); w++ )
+    {
+        fMaskBrightNonImage.getWord( w ) &= ~( fMaskImage.getWord( w ) | fMaskBorder.getWord( w ) );
+    }
+}
+
+/*
+ * neighbour lists of the current telescope in compressed sparse row format
+ *
+ * neighbours of channel i are fCSRList[fCSROffset[i]] ... fCSRList[fCSROffset[i+1]-1]
+ * (channel IDs outside of the camera are not stored)
+ */
+void VImageCleaning::fillNeighbourCSR()
+{
+    unsigned int iTelID = fData->getTelID();
+    if( iTelID >= fNeighbourCSROffset.size() )
+    {
+        fNeighbourCSROffset.resize( iTelID + 1 );
+        fNeighbourCSRList.resize( iTelID + 1 );
+    }
+    unsigned int i_nchannel = fData->getNChannels();
+    vector< unsigned int >& i_offset = fNeighbourCSROffset[iTelID];
+    vector< unsigned int >& i_list = fNeighbourCSRList[iTelID];
+    if( i_offset.size() != i_nchannel + 1 )
+    {
+        i_offset.assign( i_nchannel + 1, 0 );
+        i_list.clear();
+        for( unsigned int i = 0; i < i_nchannel; i++ )
+        {
+            if( i < fData->getDetectorGeo()->getNeighbours().size() && i < fData->getDetectorGeo()->getNNeighbours().size() )
+            {
+                for( unsigned int j = 0; j < fData->getDetectorGeo()->getNNeighbours()[i]
+                        && j < fData->getDetectorGeo()->getNeighbours()[i].size(); j++ )
                 {
-                    for( unsigned l = 0; l < i_neighbour_size; l++ )
+                    unsigned int k = ( unsigned int )fData->getDetectorGeo()->getNeighbours()[i][j];
+                    if( k < i_nchannel )
                     {
-                        unsigned int m = fData->getDetectorGeo()->getNeighbours()[i][l];
-                        if( m != i && m < fData->getBorder().size() && ( fData->getBorder()[m] || fData->getImage()[m] ) )
-                        {
-                            fData->setImage( i, true );
-                            i_neigh = true;
-                            break;
-                        }
+                        i_list.push_back( k );
                     }
                 }
-                if( !i_neigh )
-                {
-                    fData->setImage( i, false );
-                }
             }
+            i_offset[i + 1] = i_list.size();
         }
-        if( fData->getBrightNonImage()[i] )
+        // avoid zero pointer for cameras without neighbours
+        if( i_list.size() == 0 )
         {
-            if( fData->getImage()[i] )
-            {
-                fData->setBrightNonImage( i, false );
-            }
-            else if( fData->getBorder()[i] )
-            {
-                fData->setBrightNonImage( i, false );
-            }
+            i_list.push_back( 0 );
+        }
+    }
+    fCSROffset = &i_offset[0];
+    fCSRList = &i_list[0];
+}
+
+/*
+ * pedvars of the current event for all channels
+ * (for the summation window and gain of each channel)
+ */
+void VImageCleaning::fillCurrentPedvars()
+{
+    unsigned int i_nchannel = fData->getNChannels();
+    fPedvarsCurrent.assign( i_nchannel, 0. );
+
+    valarray< double >* i_pedvars = 0;
+    unsigned int i_sw = 0;
+    bool i_hilo = false;
+    for( unsigned int i = 0; i < i_nchannel; i++ )
+    {
+        if( !i_pedvars || fData->getCurrentSumWindow()[i] != i_sw || fData->getHiLo()[i] != i_hilo )
+        {
+            i_sw = fData->getCurrentSumWindow()[i];
+            i_hilo = fData->getHiLo()[i];
+            i_pedvars = &fData->getPedvars( i_sw, i_hilo );
+        }
+        if( i < i_pedvars->size() )
+        {
+            fPedvarsCurrent[i] = ( *i_pedvars )[i];
         }
     }
 }
 
+/*
+ * read image, border, bright non-image and dead pixel flags into bit masks
+ */
+void VImageCleaning::readImageBitMasks()
+{
+    unsigned int i_nchannel = fData->getNChannels();
+    fMaskImage.fill( fData->getImage(), i_nchannel );
+    fMaskBorder.fill( fData->getBorder(), i_nchannel );
+    fMaskBrightNonImage.fill( fData->getBrightNonImage(), i_nchannel );
+    fMaskDead.fill( fData->getDead(), i_nchannel );
+}
+
+/*
+ * write image, border, and bright non-image bit masks to data class
+ */
+void VImageCleaning::writeImageBitMasks()
+{
+    fMaskImage.fillVector( fData->getImage() );
+    fMaskBorder.fillVector( fData->getBorder() );
+    fMaskBrightNonImage.fillVector( fData->getBrightNonImage() );
+}
+
 void VImageCleaning::addImageChannel( unsigned int i_channel )
 {
     if( fData->getDebugFlag() )
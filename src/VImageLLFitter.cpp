@@ -0,0 +1,475 @@
+/*! \class VImageLLFitter
+    \brief loglikelihood fit of a 2D-Gaussian to camera images
+
+    Same likelihood function as used for the TMinuit fit in
+    VImageParameterCalculation::calcLL() (Poisson statistics,
+    background noise is neglected):
+
+    LL = sum_i ( n_i * log( S_i ) - S_i - n_i * log( n_i ) + n_i )
+
+    with S_i the 2D-Gaussian with the parameters
+    rho, meanX, sigmaX, meanY, sigmaY, signal.
+
+    The minimization of -LL is a Levenberg-Marquardt iteration using the
+    analytic gradient and the Fisher information matrix of the likelihood
+    (Fisher scoring). Parameter limits are treated by projection of each step
+    onto the allowed parameter region. Parameter errors are calculated from
+    the inverse of the Fisher information matrix at the minimum
+    (corresponds to UP = 0.5 in Minuit).
+
+    Each fitter has its own state and can be used by several image analyzers
+    running in parallel.
+
+*/
+
+#include "VImageLLFitter.h"
+
+VImageLLFitter::VImageLLFitter()
+{
+    for( unsigned int i = 0; i < fNPar; i++ )
+    {
+        fPar[i] = 0.;
+        fParError[i] = 0.;
+        fParMin[i] = 0.;
+        fParMax[i] = 0.;
+        fParLimited[i] = false;
+    }
+    setTolerance();
+    setMaxIterations();
+
+    fFmin = 0.;
+    fEDM = 0.;
+    fStatus = 0;
+    fNIterations = 0;
+    fNCalls = 0;
+
+    fX = 0;
+    fY = 0;
+    fSums = 0;
+}
+
+
+/*
+    define start value and limits of a fit parameter
+
+    iMin == iMax: no limits (as for TMinuit::DefineParameter)
+*/
+void VImageLLFitter::defineParameter( unsigned int iPar, double iValue, double iMin, double iMax )
+{
+    if( iPar >= fNPar )
+    {
+        cout << "VImageLLFitter::defineParameter error: invalid parameter index " << iPar << endl;
+        return;
+    }
+    fPar[iPar] = iValue;
+    fParError[iPar] = 0.;
+    fParLimited[iPar] = ( iMin != iMax );
+    fParMin[iPar] = iMin;
+    fParMax[iPar] = iMax;
+}
+
+
+void VImageLLFitter::getParameter( unsigned int iPar, double& iValue, double& iError )
+{
+    if( iPar >= fNPar )
+    {
+        iValue = 0.;
+        iError = 0.;
+        return;
+    }
+    iValue = fPar[iPar];
+    iError = fParError[iPar];
+}
+
+
+void VImageLLFitter::clampToLimits( double* p )
+{
+    for( unsigned int i = 0; i < fNPar; i++ )
+    {
+        if( fParLimited[i] )
+        {
+            if( p[i] < fParMin[i] )
+            {
+                p[i] = fParMin[i];
+            }
+            else if( p[i] > fParMax[i] )
+            {
+                p[i] = fParMax[i];
+            }
+        }
+    }
+}
+
+
+/*
+    -LL and (optional) its gradient and the Fisher information matrix
+    (fNPar x fNPar, row major)
+
+    returns 0 for parameters outside of the physical region
+    (|rho| >= 1, sigma <= 0; as in get_LL_imageParameter_2DGauss() )
+*/
+double VImageLLFitter::getFunctionValue( const double* p, double* iGradient, double* iFisher )
+{
+    fNCalls++;
+    if( iGradient )
+    {
+        for( unsigned int j = 0; j < fNPar; j++ )
+        {
+            iGradient[j] = 0.;
+        }
+    }
+    if( iFisher )
+    {
+        for( unsigned int j = 0; j < fNPar * fNPar; j++ )
+        {
+            iFisher[j] = 0.;
+        }
+    }
+    if( !fX || !fY || !fSums || p[0] * p[0] >= 1. || p[2] <= 0. || p[4] <= 0. )
+    {
+        return 0.;
+    }
+
+    const double rho = p[0];
+    const double omr = 1. - rho * rho;
+    const double rho_1 = -1. / 2. / omr;
+    // 2D-Gaussian normalised to one
+    const double norm = 1. / 2. / M_PI / p[2] / p[4] / sqrt( omr );
+
+    double LL = 0.;
+    double dS[fNPar];
+    for( unsigned int i = 0; i < fSums->size(); i++ )
+    {
+        double n = ( *fSums )[i];
+        if( n <= -999. )
+        {
+            continue;
+        }
+        double u = ( ( *fX )[i] - p[1] ) / p[2];
+        double v = ( ( *fY )[i] - p[3] ) / p[4];
+        double q = u * u + v * v - 2. * rho * u * v;
+        double g0 = norm * exp( q * rho_1 );
+        double S = g0 * p[5];
+
+        // assume Poisson fluctuations (neglecting background noise)
+        double w = -1.;
+        if( n > 0. && S > 0. )
+        {
+            LL += n * log( S ) - S - n * log( n ) + n;
+            w = n / S - 1.;
+        }
+        else
+        {
+            LL += -1. * S;
+        }
+        if( !iGradient && !iFisher )
+        {
+            continue;
+        }
+        // derivatives of S
+        dS[0] = S * ( rho / omr - rho * q / omr / omr + u * v / omr );
+        dS[1] = S * ( u - rho * v ) / p[2] / omr;
+        dS[2] = S * ( -1. + ( u * u - rho * u * v ) / omr ) / p[2];
+        dS[3] = S * ( v - rho * u ) / p[4] / omr;
+        dS[4] = S * ( -1. + ( v * v - rho * u * v ) / omr ) / p[4];
+        dS[5] = g0;
+        if( iGradient )
+        {
+            for( unsigned int j = 0; j < fNPar; j++ )
+            {
+                iGradient[j] -= w * dS[j];
+            }
+        }
+        if( iFisher && S > 0. )
+        {
+            for( unsigned int j = 0; j < fNPar; j++ )
+            {
+                for( unsigned int k = j; k < fNPar; k++ )
+                {
+                    iFisher[j * fNPar + k] += dS[j] * dS[k] / S;
+                }
+            }
+        }
+    }
+    if( iFisher )
+    {
+        for( unsigned int j = 0; j < fNPar; j++ )
+        {
+            for( unsigned int k = 0; k < j; k++ )
+            {
+                iFisher[j * fNPar + k] = iFisher[k * fNPar + j];
+            }
+        }
+    }
+    return -1. * LL;
+}
+
+
+/*
+    solve A x = b for symmetric positive definite A (n x n, Cholesky decomposition)
+
+    solution is returned in b
+*/
+bool VImageLLFitter::solve( vector< double > A, vector< double >& b, unsigned int n )
+{
+    for( unsigned int j = 0; j < n; j++ )
+    {
+        double d = A[j * n + j];
+        for( unsigned int k = 0; k < j; k++ )
+        {
+            d -= A[j * n + k] * A[j * n + k];
+        }
+        if( !( d > 0. ) )
+        {
+            return false;
+        }
+        d = sqrt( d );
+        A[j * n + j] = d;
+        for( unsigned int i = j + 1; i < n; i++ )
+        {
+            double s = A[i * n + j];
+            for( unsigned int k = 0; k < j; k++ )
+            {
+                s -= A[i * n + k] * A[j * n + k];
+            }
+            A[i * n + j] = s / d;
+        }
+    }
+    // forward and backward substitution
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        double s = b[i];
+        for( unsigned int k = 0; k < i; k++ )
+        {
+            s -= A[i * n + k] * b[k];
+        }
+        b[i] = s / A[i * n + i];
+    }
+    for( int i = ( int )n - 1; i >= 0; i-- )
+    {
+        double s = b[i];
+        for( unsigned int k = i + 1; k < n; k++ )
+        {
+            s -= A[k * n + i] * b[k];
+        }
+        b[i] = s / A[i * n + i];
+    }
+    return true;
+}
+
+
+/*
+    invert symmetric positive definite matrix A (n x n)
+*/
+bool VImageLLFitter::invert( vector< double >& A, unsigned int n )
+{
+    vector< double > iInverse( n * n, 0. );
+    vector< double > b( n, 0. );
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        b.assign( n, 0. );
+        b[i] = 1.;
+        if( !solve( A, b, n ) )
+        {
+            return false;
+        }
+        for( unsigned int k = 0; k < n; k++ )
+        {
+            iInverse[k * n + i] = b[k];
+        }
+    }
+    A = iInverse;
+    return true;
+}
+
+
+/*
+    fit 2D-Gaussian to the given pixel positions and sums
+
+    start values and limits are set with defineParameter()
+
+    returns fit status (see getStatus())
+*/
+int VImageLLFitter::fit( const vector< double >& iX, const vector< double >& iY, const vector< double >& iSums )
+{
+    fStatus = 0;
+    fNIterations = 0;
+    fNCalls = 0;
+    fFmin = 0.;
+    fEDM = 0.;
+    for( unsigned int j = 0; j < fNPar; j++ )
+    {
+        fParError[j] = 0.;
+    }
+    if( iSums.size() == 0 || iX.size() != iSums.size() || iY.size() != iSums.size() )
+    {
+        return fStatus;
+    }
+    fX = &iX;
+    fY = &iY;
+    fSums = &iSums;
+
+    // start values inside of parameter limits and of physical region
+    double p[fNPar];
+    for( unsigned int j = 0; j < fNPar; j++ )
+    {
+        p[j] = fPar[j];
+    }
+    clampToLimits( p );
+    if( p[0] * p[0] >= 1. )
+    {
+        p[0] = ( p[0] > 0. ? 0.99 : -0.99 );
+    }
+    if( p[2] <= 0. )
+    {
+        p[2] = ( fParLimited[2] ? 0.5 * fParMax[2] : 0.1 );
+    }
+    if( p[4] <= 0. )
+    {
+        p[4] = ( fParLimited[4] ? 0.5 * fParMax[4] : 0.1 );
+    }
+    if( p[0] * p[0] >= 1. || p[2] <= 0. || p[4] <= 0. )
+    {
+        return fStatus;
+    }
+
+    double g[fNPar];
+    double iFisher[fNPar * fNPar];
+    double f = getFunctionValue( p, g, iFisher );
+
+    vector< unsigned int > iFree;
+    vector< double > A;
+    vector< double > b;
+    double iLambda = 1.e-3;
+    bool bConverged = false;
+    for( fNIterations = 0; fNIterations < fMaxIterations; fNIterations++ )
+    {
+        // parameters at their limits with a gradient pointing outwards are kept fixed
+        iFree.clear();
+        for( unsigned int j = 0; j < fNPar; j++ )
+        {
+            if( fParLimited[j] && ( ( p[j] <= fParMin[j] && g[j] > 0. ) || ( p[j] >= fParMax[j] && g[j] < 0. ) ) )
+            {
+                continue;
+            }
+            iFree.push_back( j );
+        }
+        unsigned int n = iFree.size();
+        if( n == 0 )
+        {
+            fEDM = 0.;
+            bConverged = true;
+            break;
+        }
+        A.assign( n * n, 0. );
+        b.assign( n, 0. );
+        for( unsigned int j = 0; j < n; j++ )
+        {
+            b[j] = -1. * g[iFree[j]];
+            for( unsigned int k = 0; k < n; k++ )
+            {
+                A[j * n + k] = iFisher[iFree[j] * fNPar + iFree[k]];
+            }
+        }
+        // estimated distance to minimum (Newton step with Fisher matrix)
+        if( solve( A, b, n ) )
+        {
+            fEDM = 0.;
+            for( unsigned int j = 0; j < n; j++ )
+            {
+                fEDM -= 0.5 * g[iFree[j]] * b[j];
+            }
+            if( fEDM < fTolerance )
+            {
+                bConverged = true;
+                break;
+            }
+        }
+        // damped steps until -LL decreases
+        bool bAccepted = false;
+        double p_t[fNPar];
+        double f_t = f;
+        vector< double > A_t;
+        while( iLambda < 1.e10 )
+        {
+            A_t = A;
+            b.assign( n, 0. );
+            for( unsigned int j = 0; j < n; j++ )
+            {
+                A_t[j * n + j] *= ( 1. + iLambda );
+                b[j] = -1. * g[iFree[j]];
+            }
+            if( solve( A_t, b, n ) )
+            {
+                for( unsigned int j = 0; j < fNPar; j++ )
+                {
+                    p_t[j] = p[j];
+                }
+                for( unsigned int j = 0; j < n; j++ )
+                {
+                    p_t[iFree[j]] += b[j];
+                }
+                clampToLimits( p_t );
+                // note: -LL is discontinuous at signal = 0 (see getFunctionValue())
+                if( p_t[0] * p_t[0] < 1. && p_t[2] > 0. && p_t[4] > 0. && p_t[5] > 0. )
+                {
+                    f_t = getFunctionValue( p_t, 0, 0 );
+                    if( f_t < f )
+                    {
+                        bAccepted = true;
+                        iLambda = ( iLambda > 1.e-6 ? 0.1 * iLambda : 1.e-7 );
+                        break;
+                    }
+                }
+            }
+            iLambda *= 10.;
+        }
+        // no further improvement possible
+        if( !bAccepted )
+        {
+            break;
+        }
+        for( unsigned int j = 0; j < fNPar; j++ )
+        {
+            p[j] = p_t[j];
+        }
+        f = getFunctionValue( p, g, iFisher );
+    }
+
+    // fit results
+    for( unsigned int j = 0; j < fNPar; j++ )
+    {
+        fPar[j] = p[j];
+    }
+    fFmin = f;
+
+    // parameter errors from covariance matrix (inverse Fisher matrix)
+    A.assign( iFisher, iFisher + fNPar * fNPar );
+    bool bCovariance = invert( A, fNPar );
+    for( unsigned int j = 0; j < fNPar; j++ )
+    {
+        if( bCovariance && A[j * fNPar + j] > 0. )
+        {
+            fParError[j] = sqrt( A[j * fNPar + j] );
+        }
+        // diagonal approximation
+        else if( iFisher[j * fNPar + j] > 0. )
+        {
+            fParError[j] = 1. / sqrt( iFisher[j * fNPar + j] );
+        }
+    }
+    if( !bConverged )
+    {
+        fStatus = 1;
+    }
+    else if( !bCovariance )
+    {
+        fStatus = 2;
+    }
+    else
+    {
+        fStatus = 3;
+    }
+
+    return fStatus;
+}
@@ -7,6 +7,14 @@
 
 #include <VImageParameterCalculation.h>
 
+// serialize fits in multi-threaded mode (telescopes analysed in parallel):
+// - log-likelihood fits use the global TMinuit fLLFitter; the FCN finds
+//   the image via fLLFitter->GetObjectFit(), which would be overwritten
+//   by any other telescope starting a fit
+// - timing fits (TGraphErrors::Fit) go through the global default
+//   fitter (TVirtualFitter), which is shared by all threads
+static mutex fFitterMutex;
+
 VImageParameterCalculation::VImageParameterCalculation( unsigned int iShortTree, VEvndispData* iData )
 {
     fDebug = false;
@@ -22,6 +30,7 @@ VImageParameterCalculation::VImageParameterCalculation( unsigned int iShortTree,
     fboolCalcTiming = false;
     fDetectorGeometry = 0;
     fHoughTransform = 0;
+    fLLGradientFitter = new VImageLLFitter();
 
 }
 
@@ -34,7 +43,7 @@ VImageParameterCalculation::~VImageParameterCalculation()
     }
     delete fParGeo;
     delete fParLL;
-    delete fLLFitter;
+    delete fLLGradientFitter;
 }
 
 
@@ -48,7 +57,11 @@ void VImageParameterCalculation::initMinuit( int iVmode )
     {
         fLLDebug = true;
     }
-    fLLFitter = new TMinuit( 6 );
+    // one fitter for all telescopes
+    if( !fLLFitter )
+    {
+        fLLFitter = new TMinuit( 6 );
+    }
     // no minuit printouts
     if( iVmode == 1 )
     {
@@ -81,6 +94,7 @@ void VImageParameterCalculation::calcTimingParameters()
     {
         return;
     }
+    VEvndispProfilerTimer iProfilerTimer( fData->getProfiler(), E_PROF_TIMINGPARAMETERS );
     if( fData->getTZeros().size() == 0 )
     {
         return;
@@ -196,6 +210,7 @@ void VImageParameterCalculation::calcTimingParameters()
 
         if( nclean > 2 )
         {
+            lock_guard< mutex > iFitterLock( fFitterMutex );
             // Fill the graphs for long (x) short(y) and radial (r) axis
             int z = 0;
             for( unsigned int i = 0; i < xpos.size(); i++ )
@@ -900,6 +915,7 @@ void VImageParameterCalculation::calcParameters()
     {
         return;
     }
+    VEvndispProfilerTimer iProfilerTimer( fData->getProfiler(), E_PROF_IMAGEPARAMETERS );
 
     if( fDebug )
     {
@@ -1383,6 +1399,7 @@ vector<bool> VImageParameterCalculation::calcLL( bool iUseSums2 )
         cout << "VImageParameterCalculation::calcLL error: data vector is zero" << endl;
         return a;
     }
+    VEvndispProfilerTimer iProfilerTimer( fData->getProfiler(), E_PROF_LLFIT );
     if( fLLDebug )
     {
         cout << endl;
@@ -1509,10 +1526,7 @@ vector<bool> VImageParameterCalculation::calcLL( bool iUseSums2 )
     {
         sigmaX = sigmaY = 0.1;
     }
-    fLLFitter->Release( 0 );
-    fLLFitter->Release( 1 );
-    fLLFitter->Release( 3 );
-    fLLFitter->DefineParameter( 0, "rho", rho, step, 0., 0. );
+    // parameter limits
     if( fParGeo->sigmaX > 0. )
     {
         fdistXmin = cen_x - 2.*fParGeo->sigmaX;
@@ -1559,8 +1573,6 @@ vector<bool> VImageParameterCalculation::calcLL( bool iUseSums2 )
             fdistXmax = 5.;
         }
     }
-    fLLFitter->DefineParameter( 1, "meanX", cen_x, step, fdistXmin, fdistXmax );
-    fLLFitter->DefineParameter( 2, "sigmaX", sigmaX, step, 0., 2.*fParGeo->sigmaX + 1. );
     if( fParGeo->sigmaY > 0. )
     {
         fdistYmin = cen_y - 2.*fParGeo->sigmaY;
@@ -1607,28 +1619,88 @@ vector<bool> VImageParameterCalculation::calcLL( bool iUseSums2 )
             fdistYmax = 5.;
         }
     }
-    fLLFitter->DefineParameter( 3, "meanY", cen_y, step, fdistYmin, fdistYmax );
-    fLLFitter->DefineParameter( 4, "sigmaY", sigmaY, step, 0., 2.*fParGeo->sigmaY + 1. );
-    fLLFitter->DefineParameter( 5, "signal", signal, step, 0., 1.e6 );
 
     if( fLLDebug )
     {
         cout << "FLLFITTER START " << rho << "\t" << cen_x << "\t" << sigmaX << "\t" << cen_y << "\t" << sigmaY << "\t" << signal << endl;
     }
 
-    // now do the minimization
-    fLLFitter->Command( "MIGRAD" );
-    // don't call HESS, trouble with migrad in the error calculation means usually to not use the errors and LL results
-    //    fLLFitter->Command( "HESSE" );
-
-    // get fit statistics
+    // fit statistics
     double edm = 0.;
     double amin = 0.;
-    double errdef = 0.;
-    int nvpar = 0;
-    int nparx = 0;
     int nstat = 0;
-    fLLFitter->mnstat( amin, edm, errdef, nvpar, nparx, nstat );
+
+    // gradient based fitter (one fitter per analyzer, no locking needed)
+    // (start values are the geometrical (Hillas) parameters)
+    const int iLLFitterType = fData->getRunParameter()->fImageLLFitter;
+    double iParGrad[6] = { 0., 0., 0., 0., 0., 0. };
+    double iParGradError[6] = { 0., 0., 0., 0., 0., 0. };
+    if( iLLFitterType == 1 )
+    {
+        fLLGradientFitter->defineParameter( 0, rho, 0., 0. );
+        fLLGradientFitter->defineParameter( 1, cen_x, fdistXmin, fdistXmax );
+        fLLGradientFitter->defineParameter( 2, sigmaX, 0., 2.*fParGeo->sigmaX + 1. );
+        fLLGradientFitter->defineParameter( 3, cen_y, fdistYmin, fdistYmax );
+        fLLGradientFitter->defineParameter( 4, sigmaY, 0., 2.*fParGeo->sigmaY + 1. );
+        fLLGradientFitter->defineParameter( 5, signal, 0., 1.e6 );
+        fLLGradientFitter->fit( fll_X, fll_Y, fll_Sums );
+        for( unsigned int i = 0; i < 6; i++ )
+        {
+            fLLGradientFitter->getParameter( i, iParGrad[i], iParGradError[i] );
+        }
+        amin = fLLGradientFitter->getFmin();
+        edm = fLLGradientFitter->getEDM();
+        nstat = fLLGradientFitter->getStatus();
+    }
+    // TMinuit fitter (fitter and fit function are shared by all telescopes)
+    if( iLLFitterType != 1 )
+    {
+        lock_guard< mutex > iFitterLock( fFitterMutex );
+        fLLFitter->SetObjectFit( this );
+        fLLFitter->Release( 0 );
+        fLLFitter->Release( 1 );
+        fLLFitter->Release( 3 );
+        fLLFitter->DefineParameter( 0, "rho", rho, step, 0., 0. );
+        fLLFitter->DefineParameter( 1, "meanX", cen_x, step, fdistXmin, fdistXmax );
+        fLLFitter->DefineParameter( 2, "sigmaX", sigmaX, step, 0., 2.*fParGeo->sigmaX + 1. );
+        fLLFitter->DefineParameter( 3, "meanY", cen_y, step, fdistYmin, fdistYmax );
+        fLLFitter->DefineParameter( 4, "sigmaY", sigmaY, step, 0., 2.*fParGeo->sigmaY + 1. );
+        fLLFitter->DefineParameter( 5, "signal", signal, step, 0., 1.e6 );
+
+        // now do the minimization
+        fLLFitter->Command( "MIGRAD" );
+        // don't call HESS, trouble with migrad in the error calculation means usually to not use the errors and LL results
+        //    fLLFitter->Command( "HESSE" );
+
+        // get fit statistics
+        double errdef = 0.;
+        int nvpar = 0;
+        int nparx = 0;
+        fLLFitter->mnstat( amin, edm, errdef, nvpar, nparx, nstat );
+
+        // get fit results
+        fLLFitter->GetParameter( 0, rho, drho );
+        fLLFitter->GetParameter( 1, cen_x, dcen_x );
+        fLLFitter->GetParameter( 2, sigmaX, dsigmaX );
+        fLLFitter->GetParameter( 3, cen_y, dcen_y );
+        fLLFitter->GetParameter( 4, sigmaY, dsigmaY );
+        fLLFitter->GetParameter( 5, signal, dsignal );
+    }
+    else
+    {
+        rho    = iParGrad[0];
+        drho   = iParGradError[0];
+        cen_x  = iParGrad[1];
+        dcen_x = iParGradError[1];
+        sigmaX = iParGrad[2];
+        dsigmaX = iParGradError[2];
+        cen_y  = iParGrad[3];
+        dcen_y = iParGradError[3];
+        sigmaY = iParGrad[4];
+        dsigmaY = iParGradError[4];
+        signal = iParGrad[5];
+        dsignal = iParGradError[5];
+    }
     fParLL->Fitstat = nstat;
 
     if( fLLDebug )
@@ -1636,14 +1708,6 @@ vector<bool> VImageParameterCalculation::calcLL( bool iUseSums2 )
         cout << "FLLFITTER STAT " << nstat << endl;
     }
 
-    // get fit results
-    fLLFitter->GetParameter( 0, rho, drho );
-    fLLFitter->GetParameter( 1, cen_x, dcen_x );
-    fLLFitter->GetParameter( 2, sigmaX, dsigmaX );
-    fLLFitter->GetParameter( 3, cen_y, dcen_y );
-    fLLFitter->GetParameter( 4, sigmaY, dsigmaY );
-    fLLFitter->GetParameter( 5, signal, dsignal );
-
     if( fLLDebug )
     {
         cout << "FLLFITTER FIT " << rho << "\t" << cen_x << "\t" << sigmaX << "\t" << cen_y << "\t" << sigmaY << "\t" << signal << endl;
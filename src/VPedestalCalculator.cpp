@@ -16,6 +16,7 @@ VPedestalCalculator::VPedestalCalculator()
     fSumWindow = 24;
     fNPixel = 500;
     fSumFirst = 0;
+    fMaxSumPerSample = 50.;
 
     bCalibrationRun = false;
 }
@@ -75,11 +76,6 @@ bool VPedestalCalculator::initialize( bool ibCalibrationRun, unsigned int iNPixe
     // reset all variables
     reset();
 
-    // pedestal histogram binning
-    int i_hist_nbin = 2000.;
-    float i_hist_xmin = 0.;
-    float i_hist_xmax = 2000.;
-
     // set up the trees
     TDirectory* iDir = gDirectory;
 
@@ -88,8 +84,6 @@ bool VPedestalCalculator::initialize( bool ibCalibrationRun, unsigned int iNPixe
 
     vector< float > iped_cal;
     vector< vector< float > > iped_cal2;
-    vector< TH1F* > iped_histo;
-    vector< vector< TH1F* > > iped_histo2;
 
     for( unsigned int p = 0; p < fNPixel; p++ )
     {
@@ -163,27 +157,22 @@ bool VPedestalCalculator::initialize( bool ibCalibrationRun, unsigned int iNPixe
         runNumber = getRunNumber();
 
         // initialise the pedvars variables
+        // (quantile sketches with bins of 1 dc covering the accepted range of trace sums)
         iped_cal2.clear();
-        iped_histo2.clear();
+        fpedcal_sketch.push_back( VQuantileSketchPool() );
         for( unsigned int p = 0; p < fNPixel; p++ )
         {
             iped_cal.clear();
-            iped_histo.clear();
             for( int w = 0; w < fSumWindow; w++ )
             {
                 iped_cal.push_back( 0. );
-                sprintf( hname, "hped_cal_%d_%d_%d", t + 1, p, w );
-                iped_histo.push_back( new TH1F(
-                                          hname, "",
-                                          i_hist_nbin, i_hist_xmin, i_hist_xmax ) );
+                fpedcal_sketch.back().addSketch( ( unsigned int )( fMaxSumPerSample * ( w + 1 ) ), 0., fMaxSumPerSample * ( w + 1 ) );
             }
             iped_cal2.push_back( iped_cal );
-            iped_histo2.push_back( iped_histo );
         }
         fpedcal_n.push_back( iped_cal2 );
         fpedcal_mean.push_back( iped_cal2 );
         fpedcal_mean2.push_back( iped_cal2 );
-        fpedcal_histo.push_back( iped_histo2 );
 
         // define the time vector
         fTimeVec.push_back( 0 );
@@ -207,6 +196,17 @@ void VPedestalCalculator::fillTimeSlice( unsigned int telID )
     xq[0] = 0.16;
     xq[1] = 0.5;
     xq[2] = 0.84;
+    // camera derotation angle (same for all pixels of this time slice)
+    bool bDerotate = false;
+    double i_cos = 1.;
+    double i_sin = 0.;
+    if( getTelID() < getPointing().size() && getPointing()[getTelID()] )
+    {
+        double i_theta = getPointing()[getTelID()]->getDerotationAngle( getEventMJD(), getEventTime() );
+        i_cos = cos( i_theta );
+        i_sin = sin( i_theta );
+        bDerotate = true;
+    }
     // loop over all channels
     for( unsigned int p = 0; p < fpedcal_mean[telID].size(); p++ )
     {
@@ -228,9 +228,9 @@ void VPedestalCalculator::fillTimeSlice( unsigned int telID )
                 v_temp_pedvar[p][w]     = sqrt( 1. / ( fpedcal_n[telID][p][w] )
                                                 * TMath::Abs( fpedcal_mean2[telID][p][w]
                                                         - fpedcal_mean[telID][p][w] * fpedcal_mean[telID][p][w] / fpedcal_n[telID][p][w] ) );
-                if( fpedcal_histo[telID][p][w]->GetEntries() > 0 )
+                if( fpedcal_sketch[telID].getEntries( p * fSumWindow + w ) > 0 )
                 {
-                    fpedcal_histo[telID][p][w]->GetQuantiles( 3, yq, xq );
+                    fpedcal_sketch[telID].getQuantiles( p * fSumWindow + w, 3, xq, yq );
                     v_temp_ped_median[p][w] = yq[1] / ( double )( w + 1 );
                     v_temp_pedvar68[p][w] = 0.5 * ( yq[2] - yq[0] );
                 }
@@ -251,15 +251,17 @@ void VPedestalCalculator::fillTimeSlice( unsigned int telID )
             fpedcal_n[telID][p][w] = 0.;
             fpedcal_mean[telID][p][w] = 0.;
             fpedcal_mean2[telID][p][w] = 0.;
-            fpedcal_histo[telID][p][w]->Reset();
         }
         // deroate the pixel coordinates
-        if( getTelID() < getPointing().size() && getPointing()[getTelID()] )
+        if( bDerotate )
         {
-            getPointing()[getTelID()]->derotateCoords( VSkyCoordinatesUtilities::getUTC( getEventMJD(), getEventTime() ), x[p], y[p], xRot[p], yRot[p] );
+            xRot[p] = x[p] * i_cos + y[p] * i_sin;
+            yRot[p] = y[p] * i_cos - x[p] * i_sin;
         }
     }
 
+    fpedcal_sketch[telID].reset();
+
     // fill the tree
     if( telID < fTree.size() && fTree[telID] )
     {
@@ -345,14 +347,14 @@ void VPedestalCalculator::doAnalysis( bool iLowGain )
                         {
                             // calculate trace sum
                             i_tr_sum = fTraceHandler->getTraceSum( fSumFirst, fSumFirst + ( w + 1 ), true, 1 );
-                            if( i_tr_sum > 0. && i_tr_sum < 50.*( w + 1 ) )
+                            if( i_tr_sum > 0. && i_tr_sum < fMaxSumPerSample * ( w + 1 ) )
                             {
                                 if( chanID < fpedcal_n[telID].size() && w < fpedcal_n[telID][chanID].size() )
                                 {
                                     fpedcal_n[telID][chanID][w]++;
                                     fpedcal_mean[telID][chanID][w] += i_tr_sum;
                                     fpedcal_mean2[telID][chanID][w] += i_tr_sum * i_tr_sum;
-                                    fpedcal_histo[telID][chanID][w]->Fill( i_tr_sum );
+                                    fpedcal_sketch[telID].fill( chanID * fSumWindow + w, i_tr_sum );
                                 }
                                 else
                                 {
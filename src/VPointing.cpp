@@ -28,6 +28,8 @@ VPointing::VPointing( unsigned int iTelID )
 
     reset();
     setObservatory();
+    // per-run pointing tables (fixed target and telescope coordinates)
+    setPointingTable( true );
 
     initializePointingTree();
 }
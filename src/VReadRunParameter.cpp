@@ -272,6 +272,18 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
         {
             fRunPara->fIgnoreDSTGains = true;
         }
+        else if( iTemp.find( "calibrationcache" ) < iTemp.size() )
+        {
+            if( iTemp2.size() > 0 )
+            {
+                fRunPara->fCalibrationCacheDirectory = iTemp2;
+                i++;
+            }
+            else
+            {
+                fRunPara->fCalibrationCacheDirectory = "";
+            }
+        }
         else if( iTemp.find( "lowgaincalibrationfile" ) < iTemp.size() )
         {
             if( iTemp2.size() > 0 )
@@ -328,6 +340,26 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
         {
             fRunPara->fdstwriteallpixel  = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
         }
+        // write image/border pixel only as sparse pixel list to dst file
+        else if( iTemp.find( "dstslim" ) < iTemp.size() )
+        {
+            fRunPara->fdstslim = true;
+        }
+        // fill dst tree in a separate thread
+        else if( iTemp.find( "dstasync" ) < iTemp.size() )
+        {
+            fRunPara->fdstasync = true;
+        }
+        // compression settings for dst file and branches
+        else if( iTemp.find( "dstcompression" ) < iTemp.size() )
+        {
+            fRunPara->fdstcompression = iTemp1.substr( iTemp1.rfind( "=" ) + 1, iTemp1.size() );
+        }
+        // DST source files: hit channels only
+        else if( iTemp.find( "dstsparse" ) < iTemp.size() )
+        {
+            fRunPara->fdstsparse = true;
+        }
         // minimal number of tubes for dst event
         else if( iTemp.find( "dstntubes" ) < iTemp.size() )
         {
@@ -698,6 +730,37 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
         {
             fRunPara->fTimeCutsMin_max = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
         }
+        // number of threads for image analysis
+        else if( iTemp.find( "nthreads" ) < iTemp.size() )
+        {
+            int iNThreads = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+            if( iNThreads > 1 )
+            {
+                fRunPara->fNThreads = ( unsigned int )iNThreads;
+            }
+            else
+            {
+                fRunPara->fNThreads = 1;
+            }
+        }
+        // profiling of analysis stages
+        else if( iTemp == "-profile" )
+        {
+            fRunPara->fProfile = true;
+        }
+        // number of events to read ahead (VBF and DST sources)
+        else if( iTemp.find( "readahead" ) < iTemp.size() )
+        {
+            int iNEvents = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+            if( iNEvents > 0 )
+            {
+                fRunPara->fReadAheadEvents = ( unsigned int )iNEvents;
+            }
+            else
+            {
+                fRunPara->fReadAheadEvents = 0;
+            }
+        }
 
         // check if the user wants to print the list of dead pixels for this run
         else if( iTemp.rfind( "printdeadpixelinfo" ) < iTemp.size() ) // DEADCHAN
@@ -710,7 +773,7 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
         else if( iTemp.find( "type" ) < iTemp.size() )
         {
             fRunPara->fsourcetype = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
-            if( fRunPara->fsourcetype < 0 || fRunPara->fsourcetype > 7 )
+            if( fRunPara->fsourcetype < 0 || fRunPara->fsourcetype > 8 )
             {
                 cout << "unknown sourcetype " << fRunPara->fsourcetype << endl;
                 return false;
@@ -718,7 +781,7 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
             // MC grisu file
             if( fRunPara->fsourcetype == 1 || fRunPara->fsourcetype == 2
                     || fRunPara->fsourcetype == 5 || fRunPara->fsourcetype == 6
-                    || fRunPara->fsourcetype == 7 )
+                    || fRunPara->fsourcetype == 7 || fRunPara->fsourcetype == 8 )
             {
                 fRunPara->fIsMC = 1;
             }
@@ -802,6 +865,10 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
         {
             fRunPara->fsampleoffset = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
         }
+        else if( iTemp.find( "loglfitter" ) < iTemp.size() )
+        {
+            fRunPara->fImageLLFitter = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
         else if( iTemp.find( "logl" ) < iTemp.size() && !( iTemp.find( "loglminloss" ) < iTemp.size() ) )
         {
             fRunPara->fImageLL = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
@@ -939,6 +1006,23 @@ bool VReadRunParameter::readCommandline( int argc, char* argv[] )
         {
             fRunPara->fMCScale = atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
         }
+        // synthetic events (source type 8)
+        else if( iTemp.find( "synthnpixel" ) < iTemp.size() )
+        {
+            fRunPara->fSynthNPixel = ( unsigned int )atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
+        else if( iTemp.find( "synthnsamples" ) < iTemp.size() )
+        {
+            fRunPara->fSynthNSamples = ( unsigned int )atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
+        else if( iTemp.find( "synthimagesize" ) < iTemp.size() )
+        {
+            fRunPara->fSynthImageSize = atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
+        else if( iTemp.find( "synthnsb" ) < iTemp.size() )
+        {
+            fRunPara->fSynthNSBRate = atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
         else if( iTemp.find( "pedestalseed" ) < iTemp.size() )
         {
             fRunPara->fgrisuseed = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
@@ -1207,6 +1291,12 @@ void VReadRunParameter::test_and_adjustParams()
         exit( EXIT_FAILURE );
     }
 
+    // synthetic events: no source file needed
+    if( fRunPara->fsourcetype == 8 && fRunPara->fsourcefile.size() < 1 )
+    {
+        fRunPara->fsourcefile = "synthetic";
+    }
+
     /////////////////////////////////////////////////////////////////
     // check if sourcefile is given
     if( fRunPara->fsourcefile.size() < 1 )
@@ -1244,12 +1334,39 @@ void VReadRunParameter::test_and_adjustParams()
         fRunPara->fWriteTriggerOnly = false;
     }
 
+    // telescope-parallel image analysis: only for the standard
+    // analysis of VBF or DST files without display, trace fitting,
+    // noise injection, or hough transforms
+    // (calibration runs: threads are used for the calibration passes
+    //  after the event loop, event loop is single threaded)
+    bool iCalibrationRun = ( fRunPara->frunmode == 1 || fRunPara->frunmode == 2 || fRunPara->frunmode == 5
+                             || fRunPara->frunmode == 6 || fRunPara->frunmode == 7 || fRunPara->frunmode == 8 );
+    if( fRunPara->fNThreads > 1 && !iCalibrationRun )
+    {
+        if( fRunPara->fdisplaymode || fRunPara->frunmode != 0
+                || fRunPara->ftracefit >= 0. || fRunPara->fhoughmuonmode
+                || fRunPara->finjectGaussianNoise > 0. || fRunPara->fsimu_pedestalfile.size() > 0
+                || ( fRunPara->fsourcetype != 2 && fRunPara->fsourcetype != 3
+                     && fRunPara->fsourcetype != 4 && fRunPara->fsourcetype != 7
+                     && fRunPara->fsourcetype != 8 ) )
+        {
+            cout << "warning: multi-threaded image analysis not possible for this configuration, ";
+            cout << "setting number of threads to 1" << endl;
+            fRunPara->fNThreads = 1;
+        }
+    }
+
     // fRunPara->fImageLL: values between 0-2
     if( fRunPara->fImageLL < 0 || fRunPara->fImageLL > 2 )
     {
         cout << "warning: logl parameter out of range, setting it to 1" << endl;
         fRunPara->fImageLL = 1;
     }
+    if( fRunPara->fImageLLFitter < 0 || fRunPara->fImageLLFitter > 1 )
+    {
+        cout << "warning: loglfitter parameter out of range, setting it to 0" << endl;
+        fRunPara->fImageLLFitter = 0;
+    }
     // check fadc trace scaling
     if( fRunPara->fMCScale <= 0. )
     {
@@ -1324,6 +1441,14 @@ void VReadRunParameter::test_and_adjustParams()
             fRunPara->fcamera[t] = "dstfile";
         }
     }
+    // synthetic camera for synthetic events
+    else if( fRunPara->fsourcetype == 8 )
+    {
+        for( unsigned int t = 0; t < fRunPara->fcamera.size(); t++ )
+        {
+            fRunPara->fcamera[t] = "synthetic";
+        }
+    }
 
     setDirectories();
 
@@ -57,6 +57,154 @@ void VSkyCoordinates::reset()
     fTime = 0.;
 
     fSupressStdoutText = false ;
+
+    setPointingTable( false );
+}
+
+/*
+
+    per-run pointing tables
+
+    telescope and target elevation/azimuth and the camera derotation angle are
+    tabulated on a fine time grid and interpolated with cubic splines (O(1) per call)
+
+    tables are filled at the first call of updatePointing() / derotateCoords(),
+    refilled when the time is outside of the table and whenever one of the
+    coordinates (telescope / target / observatory) changes
+
+    azimuth and derotation angle change quickly close to zenith; coordinates are
+    calculated directly above iMaxElevation_deg (telescope or target elevation)
+
+    (iUse = false: calculate all coordinates for each call; default, as the
+     tables pay off only for many calls with the same coordinates, e.g. the
+     per-event pointing in evndisp, see VPointing and VArrayPointing)
+
+*/
+void VSkyCoordinates::setPointingTable( bool iUse, double iStep_s, double iLength_s, double iMaxElevation_deg )
+{
+    fUsePointingTable = iUse;
+    fPointingTableStep = iStep_s;
+    fPointingTableLength = iLength_s;
+    fPointingTableMaxElevation = iMaxElevation_deg;
+    fPointingTableMJD = 0;
+    for( unsigned int i = 0; i < 6; i++ )
+    {
+        fPointingTableCoord[i] = 0.;
+    }
+    fTableTelAzimuth.reset();
+    fTableTelElevation.reset();
+    fTableTargetAzimuth.reset();
+    fTableTargetElevation.reset();
+    fTableDerotationAngle.reset();
+}
+
+/*
+
+    fill pointing tables starting shortly before the given time
+
+*/
+bool VSkyCoordinates::fillPointingTable( int MJD, double time )
+{
+    if( !fUsePointingTable || !fSet || fPointingTableStep <= 0. || fPointingTableLength < fPointingTableStep )
+    {
+        return false;
+    }
+
+    fPointingTableMJD = MJD;
+    // allow for events slightly earlier than the first one
+    double t0 = time - 60. * fPointingTableStep;
+    unsigned int n = ( unsigned int )( fPointingTableLength / fPointingTableStep ) + 62;
+
+    vector< double > iTelAz( n, 0. );
+    vector< double > iTelEl( n, 0. );
+    vector< double > iTargetAz( n, 0. );
+    vector< double > iTargetEl( n, 0. );
+    vector< double > iDerot( n, 0. );
+    double az = 0.;
+    double ze = 0.;
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        double t = t0 + ( double )i * fPointingTableStep;
+        double iDay = floor( t / 86400. );
+        int    iMJD = fPointingTableMJD + ( int )iDay;
+        double iTime = t - iDay * 86400.;
+
+        VSkyCoordinatesUtilities::getHorizontalCoordinates( iMJD, iTime, fTelDec * TMath::RadToDeg(), fTelRA * TMath::RadToDeg(), az, ze );
+        iTelAz[i] = az;
+        iTelEl[i] = 90. - ze;
+        VSkyCoordinatesUtilities::getHorizontalCoordinates( iMJD, iTime, fTargetDec * TMath::RadToDeg(), fTargetRA * TMath::RadToDeg(), az, ze );
+        iTargetAz[i] = az;
+        iTargetEl[i] = 90. - ze;
+        iDerot[i] = VSkyCoordinatesUtilities::getDerotationAngle( VSkyCoordinatesUtilities::getUTC( iMJD, iTime ),
+                    fTelRA, fTelDec, fObsLongitude, fObsLatitude );
+    }
+    fTableTelAzimuth.set( t0, fPointingTableStep, iTelAz, 360., 0. );
+    fTableTelElevation.set( t0, fPointingTableStep, iTelEl );
+    fTableTargetAzimuth.set( t0, fPointingTableStep, iTargetAz, 360., 0. );
+    fTableTargetElevation.set( t0, fPointingTableStep, iTargetEl );
+    fTableDerotationAngle.set( t0, fPointingTableStep, iDerot, 2. * TMath::Pi(), -1. * TMath::Pi() );
+
+    fPointingTableCoord[0] = fTelRA;
+    fPointingTableCoord[1] = fTelDec;
+    fPointingTableCoord[2] = fTargetRA;
+    fPointingTableCoord[3] = fTargetDec;
+    fPointingTableCoord[4] = fObsLongitude;
+    fPointingTableCoord[5] = fObsLatitude;
+
+    return true;
+}
+
+/*
+
+    check that the tables are filled for the current coordinates and
+    that the given time [s since fPointingTableMJD] is inside the table
+
+*/
+bool VSkyCoordinates::isPointingTableValid( double iTableTime )
+{
+    if( !fUsePointingTable || !fTableTelAzimuth.isInside( iTableTime ) )
+    {
+        return false;
+    }
+    return ( fPointingTableCoord[0] == fTelRA && fPointingTableCoord[1] == fTelDec
+             && fPointingTableCoord[2] == fTargetRA && fPointingTableCoord[3] == fTargetDec
+             && fPointingTableCoord[4] == fObsLongitude && fPointingTableCoord[5] == fObsLatitude );
+}
+
+/*
+
+    interpolation is used only below the maximum elevation
+    (time in [s] since fPointingTableMJD; tables must be valid)
+
+*/
+bool VSkyCoordinates::isPointingTableAccurate( double iTableTime )
+{
+    return ( fTableTelElevation.eval( iTableTime ) < fPointingTableMaxElevation
+             && fTableTargetElevation.eval( iTableTime ) < fPointingTableMaxElevation );
+}
+
+/*
+
+    camera derotation angle [rad] from pointing table
+    (calculated directly if tables are not available)
+
+*/
+double VSkyCoordinates::getDerotationAngle_fromTable( double i_UTC )
+{
+    if( fUsePointingTable && fSet )
+    {
+        int iMJD = ( int )floor( i_UTC );
+        if( isPointingTableValid( ( i_UTC - ( double )fPointingTableMJD ) * 86400. )
+                || fillPointingTable( iMJD, ( i_UTC - ( double )iMJD ) * 86400. ) )
+        {
+            double t = ( i_UTC - ( double )fPointingTableMJD ) * 86400.;
+            if( isPointingTableAccurate( t ) )
+            {
+                return fTableDerotationAngle.eval( t );
+            }
+        }
+    }
+    return VSkyCoordinatesUtilities::getDerotationAngle( i_UTC, fTelRA, fTelDec, fObsLongitude, fObsLatitude );
 }
 
 void VSkyCoordinates::precessTarget( int iMJD, int iTelID )
@@ -138,6 +286,25 @@ void VSkyCoordinates::updatePointing( int MJD, double time )
     fMJD = ( unsigned int )MJD;
     fTime = time;
 
+    // interpolate from pointing tables
+    if( fUsePointingTable && fSet )
+    {
+        if( isPointingTableValid( ( double )( MJD - fPointingTableMJD ) * 86400. + time ) || fillPointingTable( MJD, time ) )
+        {
+            double t = ( double )( MJD - fPointingTableMJD ) * 86400. + time;
+            if( isPointingTableAccurate( t ) )
+            {
+                fTelAzimuthCalculated   = ( float )fTableTelAzimuth.eval( t );
+                fTelElevationCalculated = ( float )fTableTelElevation.eval( t );
+                fTelElevation = fTelElevationCalculated;
+                fTelAzimuth   = fTelAzimuthCalculated;
+                fTargetAzimuth   = fTableTargetAzimuth.eval( t );
+                fTargetElevation = fTableTargetElevation.eval( t );
+                return;
+            }
+        }
+    }
+
     double az = 0.;
     double el = 0.;
 
@@ -218,7 +385,7 @@ void VSkyCoordinates::getDerotatedShowerDirection( double ze, double az, float&
 
 double VSkyCoordinates::derotateCoords( double i_UTC, double i_xin, double i_yin, double& i_xout, double& i_yout )
 {
-    double i_theta = VSkyCoordinatesUtilities::getDerotationAngle( i_UTC, fTelRA, fTelDec, fObsLongitude, fObsLatitude );
+    double i_theta = getDerotationAngle_fromTable( i_UTC );
     i_xout = i_xin * cos( i_theta ) + i_yin * sin( i_theta );
     i_yout = i_yin * cos( i_theta ) - i_xin * sin( i_theta );
     return i_theta;
@@ -226,14 +393,12 @@ double VSkyCoordinates::derotateCoords( double i_UTC, double i_xin, double i_yin
 
 double VSkyCoordinates::getDerotationAngle( int i_mjd, double i_seconds )
 {
-    return VSkyCoordinatesUtilities::getDerotationAngle( VSkyCoordinatesUtilities::getUTC( i_mjd, i_seconds ),
-            fTelRA, fTelDec, fObsLongitude, fObsLatitude );
+    return getDerotationAngle_fromTable( VSkyCoordinatesUtilities::getUTC( i_mjd, i_seconds ) );
 }
 
 double VSkyCoordinates::derotateCoords( int i_mjd, double i_seconds, double i_xin, double i_yin, double& i_xout, double& i_yout )
 {
-    double i_UTC = VSkyCoordinatesUtilities::getUTC( i_mjd, i_seconds );
-    double i_theta = VSkyCoordinatesUtilities::getDerotationAngle( i_UTC, fTelRA, fTelDec, fObsLongitude, fObsLatitude );
+    double i_theta = getDerotationAngle_fromTable( VSkyCoordinatesUtilities::getUTC( i_mjd, i_seconds ) );
     i_xout = i_xin * cos( i_theta ) + i_yin * sin( i_theta );
     i_yout = i_yin * cos( i_theta ) - i_xin * sin( i_theta );
     return i_theta;
@@ -241,8 +406,7 @@ double VSkyCoordinates::derotateCoords( int i_mjd, double i_seconds, double i_xi
 
 double VSkyCoordinates::rotateCoords( int i_mjd, double i_seconds, double i_xin, double i_yin, double& i_xout, double& i_yout )
 {
-    double i_UTC = VSkyCoordinatesUtilities::getUTC( i_mjd, i_seconds );
-    double i_theta = -1. * VSkyCoordinatesUtilities::getDerotationAngle( i_UTC, fTelRA, fTelDec, fObsLongitude, fObsLatitude );
+    double i_theta = -1. * getDerotationAngle_fromTable( VSkyCoordinatesUtilities::getUTC( i_mjd, i_seconds ) );
     i_xout = i_xin * cos( i_theta ) + i_yin * sin( i_theta );
     i_yout = i_yin * cos( i_theta ) - i_xin * sin( i_theta );
     return i_theta;
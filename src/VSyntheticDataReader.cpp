@@ -0,0 +1,612 @@
+/*! \class VSyntheticDataReader
+    \brief generator of synthetic VERITAS-like events (benchmarking without data files)
+
+    Events are generated on the fly and are fully reproducible for a given seed:
+
+    - camera: hexagonal grid of identical pixels (0.15 deg spacing),
+      built by fillDetectorGeometry() (source type 8, no camera configuration file needed)
+    - traces: pedestal + electronic noise + night sky background (Poisson distributed
+      single photo electron pulses) + Cherenkov pulse (2D Gaussian image with a time gradient
+      along the major axis)
+    - showers: power-law energy spectrum, random core positions and source offsets;
+      images of all telescopes point back to the source position
+
+    Pedestals and pedestal variations (all summation windows) are calculated from
+    noise-only traces at initialisation and are used as calibration data
+    (as for GrIsu 'P' lines). Gains are 1 and time offsets 0 (MC default).
+
+    This is not a simulation of the detector response, but produces traces with
+    realistic occupancy and signal distributions for performance measurements
+    (see bench_evndisp).
+
+*/
+
+#include "VSyntheticDataReader.h"
+
+thread_local unsigned int VSyntheticDataReader::fTelID = 0;
+thread_local unsigned int VSyntheticDataReader::fSelectedHitChannel = 0;
+
+/*!
+    \param iDetGeo     detector geometry (filled by fillDetectorGeometry())
+    \param iNEvents    number of events to generate
+    \param iImageSize  image size [pe] of a shower at the threshold energy and small impact distances
+    \param iNSBRate    mean NSB rate [pe/ns]
+    \param iSumWindow  summation windows (for pedestal variations)
+*/
+VSyntheticDataReader::VSyntheticDataReader( VDetectorGeometry* iDetGeo, unsigned int iNTel, unsigned int iNEvents,
+        double iImageSize, double iNSBRate, vector< int > iSumWindow,
+        int iSeed, bool iDebug )
+{
+    fDebug = iDebug;
+    if( fDebug )
+    {
+        cout << "VSyntheticDataReader::VSyntheticDataReader" << endl;
+    }
+    fNTel = iNTel;
+    fNEvents = iNEvents;
+    fEventNumber = 0;
+    // fixed default seed: events are reproducible
+    fRandomGen = new TRandom3( iSeed > 0 ? iSeed : 4357 );
+
+    fImageSize = iImageSize;
+    fNSBRate = iNSBRate;
+    fSumWindow = iSumWindow;
+    fSumWindow.resize( fNTel, fSumWindow.size() > 0 ? fSumWindow[0] : 6 );
+
+    fSampleWidth = 2.;
+    fPedestal = 16.;
+    fElectronicNoise = 1.;
+    fDCperPE = 5.3;
+
+    fNSamples = 0;
+    fPixelArea = 0.;
+    for( unsigned int i = 0; i < fNTel; i++ )
+    {
+        iDetGeo->setTelID( i );
+        fNChannels.push_back( iDetGeo->getNumChannels() );
+        if( i == 0 )
+        {
+            fNSamples = iDetGeo->getNSamples( i );
+            if( iDetGeo->getTubeRadius( i ).size() > 0 )
+            {
+                fPixelArea = TMath::Pi() * iDetGeo->getTubeRadius( i )[0] * iDetGeo->getTubeRadius( i )[0];
+            }
+        }
+        vector< double > iX;
+        vector< double > iY;
+        for( unsigned int p = 0; p < iDetGeo->getX( i ).size(); p++ )
+        {
+            iX.push_back( iDetGeo->getX( i )[p] );
+            iY.push_back( iDetGeo->getY( i )[p] );
+        }
+        fPixelX.push_back( iX );
+        fPixelY.push_back( iY );
+        fTelX.push_back( iDetGeo->getTelXpos()[i] );
+        fTelY.push_back( iDetGeo->getTelYpos()[i] );
+
+        // NSB rates vary from pixel to pixel
+        vector< double > iNSB( fNChannels.back(), 0. );
+        for( unsigned int p = 0; p < iNSB.size(); p++ )
+        {
+            iNSB[p] = fNSBRate * fRandomGen->Gaus( 1., 0.1 );
+            if( iNSB[p] < 0. )
+            {
+                iNSB[p] = 0.;
+            }
+        }
+        fNSBRatePixel.push_back( iNSB );
+
+        fSamples.push_back( vector< uint8_t >( fNChannels.back() * fNSamples, 0 ) );
+    }
+    fTraceTemp.assign( fNSamples, 0. );
+    for( unsigned int i = 0; i < fSumWindow.size(); i++ )
+    {
+        if( fSumWindow[i] < 0 || fSumWindow[i] > ( int )fNSamples )
+        {
+            fSumWindow[i] = fNSamples;
+        }
+    }
+    fLocalTrigger.assign( fNTel, false );
+    fLocalTriggerTime.assign( fNTel, -999. );
+    fTelElevation.assign( fNTel, 70. );
+    fTelAzimuth.assign( fNTel, 0. );
+
+    fMC_energy = 0.;
+    fMC_X = 0.;
+    fMC_Y = 0.;
+    fMC_Xoffset = 0.;
+    fMC_Yoffset = 0.;
+
+    fillPulseShape();
+    generatePedestals( 200 );
+
+    cout << "synthetic event generator: " << fNEvents << " events, " << fNTel << " telescopes, ";
+    cout << ( fNChannels.size() > 0 ? fNChannels[0] : 0 ) << " pixels, " << fNSamples << " samples, ";
+    cout << "image size " << fImageSize << " pe, NSB rate " << fNSBRate << " pe/ns" << endl;
+}
+
+
+VSyntheticDataReader::~VSyntheticDataReader()
+{
+    delete fRandomGen;
+}
+
+
+/*!
+    minimal set of parameter files for the analysis of synthetic events
+
+    writes into iDirectory/ParameterFiles/
+
+    - EVNDISP.global.runparameter (VERITAS site)
+    - reconstruction parameters (default file name, one array reconstruction method)
+    - dead channel definition (default file name, empty: default dead channel thresholds)
+
+    and sets $VERITAS_EVNDISP_AUX_DIR to iDirectory (and $VERITAS_USER_DATA_DIR,
+    if not set), i.e. no auxiliary data files are needed for synthetic events.
+    Must be called before any run parameters are read.
+*/
+bool VSyntheticDataReader::setParameterFiles( string iDirectory )
+{
+    if( iDirectory.size() == 0 || iDirectory[0] != '/' )
+    {
+        iDirectory = string( gSystem->WorkingDirectory() ) + "/" + iDirectory;
+    }
+    string iParDir = iDirectory + "/ParameterFiles/";
+    gSystem->mkdir( iParDir.c_str(), true );
+
+    ofstream os( ( iParDir + "EVNDISP.global.runparameter" ).c_str() );
+    os << "global run parameters for synthetic events (see VSyntheticDataReader)" << endl;
+    os << "* OBSERVATORY VERITAS" << endl;
+    os << "* OBSERVATORY_COORDINATES 31.675 -110.952 1270." << endl;
+    os.close();
+
+    os.open( ( iParDir + "EVNDISP.reconstruction.runparameter.AP.v4x" ).c_str() );
+    os << "reconstruction parameters for synthetic events (see VSyntheticDataReader)" << endl;
+    os << "* -1 RECMETHOD 0" << endl;
+    os << "* -1 MINTUBES 5" << endl;
+    os << "* -1 MINSIZE 100." << endl;
+    os.close();
+
+    os.open( ( iParDir + "EVNDISP.validchannels.dat" ).c_str() );
+    os << "dead channel definition for synthetic events: default thresholds" << endl;
+    os.close();
+    if( !os )
+    {
+        cout << "VSyntheticDataReader::setParameterFiles error writing parameter files to " << iParDir << endl;
+        return false;
+    }
+
+    gSystem->Setenv( "VERITAS_EVNDISP_AUX_DIR", iDirectory.c_str() );
+    if( !gSystem->Getenv( "VERITAS_USER_DATA_DIR" ) )
+    {
+        gSystem->Setenv( "VERITAS_USER_DATA_DIR", iDirectory.c_str() );
+    }
+    return true;
+}
+
+
+/*!
+    synthetic camera: hexagonal grid of pixels (ordered in rings around the camera centre)
+
+    telescope positions are the default positions for a four telescope array
+    (other array sizes: telescopes on a ring of 80 m radius)
+*/
+void VSyntheticDataReader::fillDetectorGeometry( VDetectorGeometry* iDetGeo, unsigned int iNTel,
+        unsigned int iNPixel, unsigned int iNSamples )
+{
+    if( !iDetGeo || iNTel == 0 || iNPixel == 0 )
+    {
+        cout << "VSyntheticDataReader::fillDetectorGeometry error: invalid detector definition ";
+        cout << "(ntel " << iNTel << ", npixel " << iNPixel << ")" << endl;
+        exit( EXIT_FAILURE );
+    }
+    const double iPixelSpacing = 0.15;            // [deg]
+    const double iTubeRadius = 0.5 * iPixelSpacing;
+    const double iFocalLength = 12.;              // [m]
+    const double iMMperDeg = 1.e3 * iFocalLength * TMath::DegToRad();
+
+    // hexagonal grid: rings around the camera centre
+    vector< double > iX;
+    vector< double > iY;
+    iX.push_back( 0. );
+    iY.push_back( 0. );
+    // axial directions of the six sides of a ring
+    const int iDQ[6] = { 1,  1,  0, -1, -1, 0 };
+    const int iDR[6] = { 0, -1, -1,  0,  1, 1 };
+    for( int r = 1; iX.size() < iNPixel; r++ )
+    {
+        // start at corner (q,r) = (-r,r) and walk along the six sides
+        int q = -r;
+        int s = r;
+        for( unsigned int side = 0; side < 6; side++ )
+        {
+            for( int k = 0; k < r; k++ )
+            {
+                iX.push_back( iPixelSpacing * ( q + 0.5 * s ) );
+                iY.push_back( iPixelSpacing * s * 0.5 * sqrt( 3. ) );
+                q += iDQ[side];
+                s += iDR[side];
+            }
+        }
+    }
+    iX.resize( iNPixel );
+    iY.resize( iNPixel );
+    double iRMax = 0.;
+    for( unsigned int p = 0; p < iNPixel; p++ )
+    {
+        iRMax = TMath::Max( iRMax, sqrt( iX[p] * iX[p] + iY[p] * iY[p] ) );
+    }
+
+    vector< unsigned int > i_npix( iNTel, iNPixel );
+    iDetGeo->addDataVector( iNTel, i_npix );
+
+    map< unsigned int, unsigned int > i_telID_matrix;
+    for( unsigned int i = 0; i < iNTel; i++ )
+    {
+        i_telID_matrix[i] = i;
+
+        if( iNTel != 4 )
+        {
+            iDetGeo->getTelXpos()[i] = 80. * cos( 2. * TMath::Pi() * ( double )i / ( double )iNTel );
+            iDetGeo->getTelYpos()[i] = 80. * sin( 2. * TMath::Pi() * ( double )i / ( double )iNTel );
+            iDetGeo->getTelZpos()[i] = 0.;
+        }
+        iDetGeo->getFocalLength()[i] = iFocalLength;
+        iDetGeo->getFieldofView()[i] = 2. * ( iRMax + iTubeRadius );
+        iDetGeo->getNMirrors()[i] = 345;
+        iDetGeo->getMirrorArea()[i] = 110.;
+
+        iDetGeo->setNSamples( i, iNSamples, true );
+        iDetGeo->setLengthOfSampleTimeSlice( i, 2. );
+
+        for( unsigned int p = 0; p < iNPixel; p++ )
+        {
+            iDetGeo->getX( i )[p] = iX[p];
+            iDetGeo->getY( i )[p] = iY[p];
+            iDetGeo->getXUnrotated( i )[p] = iX[p];
+            iDetGeo->getYUnrotated( i )[p] = iY[p];
+            iDetGeo->getTubeRadius( i )[p] = iTubeRadius;
+            iDetGeo->getX_MM( i )[p] = iX[p] * iMMperDeg;
+            iDetGeo->getY_MM( i )[p] = iY[p] * iMMperDeg;
+            iDetGeo->getTubeRadius_MM( i )[p] = iTubeRadius * iMMperDeg;
+            iDetGeo->getAnaPixel( i )[p] = 1;
+        }
+    }
+    iDetGeo->setTelID_matrix( i_telID_matrix );
+    iDetGeo->setCameraCentreTubeIndex();
+    iDetGeo->makeNeighbourList();
+}
+
+
+/*!
+    single photo electron pulse shape (normalised to unit integral)
+
+    f(t) ~ t^2 exp( -t/tau ), tau = 1.5 ns (rise time ~3 ns, FWHM ~7 ns)
+*/
+void VSyntheticDataReader::fillPulseShape()
+{
+    const double tau = 1.5;
+    fPulseTimeBinWidth = 0.1;
+    fPulseShapeTMin = 0.;
+    unsigned int iNBins = ( unsigned int )( 30. / fPulseTimeBinWidth );
+    fPulseShape.assign( iNBins, 0. );
+    double iSum = 0.;
+    for( unsigned int i = 0; i < iNBins; i++ )
+    {
+        double t = ( i + 0.5 ) * fPulseTimeBinWidth;
+        fPulseShape[i] = t * t * exp( -t / tau );
+        iSum += fPulseShape[i] * fPulseTimeBinWidth;
+    }
+    for( unsigned int i = 0; i < iNBins; i++ )
+    {
+        fPulseShape[i] /= iSum;
+    }
+}
+
+
+/*
+    add a pulse with charge iCharge [dc] arriving at time iTime [ns] to a trace
+*/
+void VSyntheticDataReader::addPulse( float* iTrace, double iTime, double iCharge )
+{
+    for( unsigned int s = 0; s < fNSamples; s++ )
+    {
+        double t = ( double )s * fSampleWidth - iTime - fPulseShapeTMin;
+        if( t < 0. )
+        {
+            continue;
+        }
+        unsigned int iBin = ( unsigned int )( t / fPulseTimeBinWidth );
+        if( iBin >= fPulseShape.size() )
+        {
+            break;
+        }
+        iTrace[s] += ( float )( iCharge * fSampleWidth * fPulseShape[iBin] );
+    }
+}
+
+
+/*
+    pedestal + electronic noise + NSB photo electrons
+*/
+void VSyntheticDataReader::fillNoiseTrace( unsigned int iTel, unsigned int iChannel )
+{
+    for( unsigned int s = 0; s < fNSamples; s++ )
+    {
+        fTraceTemp[s] = ( float )fRandomGen->Gaus( fPedestal, fElectronicNoise );
+    }
+    // NSB pulses (including pulses starting before the readout window)
+    double iTMin = -( double )fPulseShape.size() * fPulseTimeBinWidth;
+    double iTMax = ( double )fNSamples * fSampleWidth;
+    int iNPE = fRandomGen->Poisson( fNSBRatePixel[iTel][iChannel] * ( iTMax - iTMin ) );
+    for( int i = 0; i < iNPE; i++ )
+    {
+        double iCharge = fDCperPE * fRandomGen->Gaus( 1., 0.35 );
+        if( iCharge > 0. )
+        {
+            addPulse( &fTraceTemp[0], fRandomGen->Uniform( iTMin, iTMax ), iCharge );
+        }
+    }
+}
+
+
+/*
+    digitize temporary trace (8 bit)
+*/
+void VSyntheticDataReader::fillSamples( unsigned int iTel, unsigned int iChannel )
+{
+    uint8_t* iS = &fSamples[iTel][iChannel * fNSamples];
+    for( unsigned int s = 0; s < fNSamples; s++ )
+    {
+        int iV = ( int )( fTraceTemp[s] + 0.5 );
+        if( iV < 0 )
+        {
+            iV = 0;
+        }
+        else if( iV > 255 )
+        {
+            iV = 255;
+        }
+        iS[s] = ( uint8_t )iV;
+    }
+}
+
+
+/*
+    pedestals, pedestal RMS, and pedestal variations for all summation windows
+    from iNTraces noise-only traces per channel
+*/
+void VSyntheticDataReader::generatePedestals( unsigned int iNTraces )
+{
+    fPeds.clear();
+    fPedRMS.clear();
+    fVPedvars.clear();
+    for( unsigned int i = 0; i < fNTel; i++ )
+    {
+        fPeds.push_back( valarray< double >( 0., fNChannels[i] ) );
+        fPedRMS.push_back( valarray< double >( 0., fNChannels[i] ) );
+        fVPedvars.push_back( vector< valarray< double > >( fNSamples + 1, valarray< double >( 0., fNChannels[i] ) ) );
+
+        vector< double > iSum( fNSamples + 1, 0. );
+        vector< double > iSum2( fNSamples + 1, 0. );
+        for( unsigned int c = 0; c < fNChannels[i]; c++ )
+        {
+            double iS = 0.;
+            double iS2 = 0.;
+            iSum.assign( fNSamples + 1, 0. );
+            iSum2.assign( fNSamples + 1, 0. );
+            for( unsigned int n = 0; n < iNTraces; n++ )
+            {
+                fillNoiseTrace( i, c );
+                fillSamples( i, c );
+                const uint8_t* iTrace = &fSamples[i][c * fNSamples];
+                double iW = 0.;
+                for( unsigned int s = 0; s < fNSamples; s++ )
+                {
+                    iS  += iTrace[s];
+                    iS2 += ( double )iTrace[s] * ( double )iTrace[s];
+                    iW  += iTrace[s];
+                    iSum[s + 1]  += iW;
+                    iSum2[s + 1] += iW * iW;
+                }
+            }
+            double iN = ( double )iNTraces * ( double )fNSamples;
+            if( iN > 0. )
+            {
+                fPeds[i][c] = iS / iN;
+                fPedRMS[i][c] = sqrt( TMath::Max( 0., iS2 / iN - fPeds[i][c] * fPeds[i][c] ) );
+            }
+            for( unsigned int w = 1; w <= fNSamples && iNTraces > 0; w++ )
+            {
+                double iMean = iSum[w] / ( double )iNTraces;
+                fVPedvars[i][w][c] = sqrt( TMath::Max( 0., iSum2[w] / ( double )iNTraces - iMean * iMean ) );
+            }
+        }
+    }
+}
+
+
+/*
+    generate next shower and fill traces of all telescopes
+*/
+void VSyntheticDataReader::generateShower()
+{
+    const double iEmin = 0.1;                     // [TeV]
+    const double iEmax = 30.;                     // [TeV]
+    const double iTrigger = 0.25;                 // trigger threshold (fraction of fImageSize)
+
+    vector< double > iSize( fNTel, 0. );
+    vector< double > iDist( fNTel, 0. );
+    vector< double > iPhi( fNTel, 0. );
+    vector< double > iR( fNTel, 0. );
+    // require at least two telescopes with images (up to 100 trials)
+    for( unsigned int n = 0; n < 100; n++ )
+    {
+        // E^-2 spectrum
+        fMC_energy = ( float )( 1. / ( 1. / iEmin - fRandomGen->Uniform() * ( 1. / iEmin - 1. / iEmax ) ) );
+        double iR_core = 250. * sqrt( fRandomGen->Uniform() );
+        double iPhi_core = fRandomGen->Uniform( 2. * TMath::Pi() );
+        fMC_X = ( float )( iR_core * cos( iPhi_core ) );
+        fMC_Y = ( float )( iR_core * sin( iPhi_core ) );
+        double iR_src = 1.0 * sqrt( fRandomGen->Uniform() );
+        double iPhi_src = fRandomGen->Uniform( 2. * TMath::Pi() );
+        fMC_Xoffset = ( float )( iR_src * cos( iPhi_src ) );
+        fMC_Yoffset = ( float )( iR_src * sin( iPhi_src ) );
+
+        unsigned int iNTrig = 0;
+        for( unsigned int i = 0; i < fNTel; i++ )
+        {
+            double dx = fMC_X - fTelX[i];
+            double dy = fMC_Y - fTelY[i];
+            iR[i] = sqrt( dx * dx + dy * dy );
+            iPhi[i] = atan2( dy, dx );
+            iDist[i] = TMath::Min( 0.01 * iR[i], 1.6 );
+            iSize[i] = fImageSize * fMC_energy / iEmin;
+            if( iR[i] > 120. )
+            {
+                iSize[i] *= exp( -( iR[i] - 120. ) / 100. );
+            }
+            fLocalTrigger[i] = ( iSize[i] > iTrigger * fImageSize );
+            if( fLocalTrigger[i] )
+            {
+                iNTrig++;
+            }
+        }
+        if( iNTrig > 1 || fNTel < 2 )
+        {
+            break;
+        }
+    }
+
+    // pulse arrival time at the image centroid [ns]
+    double iT0 = 0.35 * ( double )fNSamples * fSampleWidth;
+    for( unsigned int i = 0; i < fNTel; i++ )
+    {
+        fLocalTriggerTime[i] = ( fLocalTrigger[i] ? ( float )iT0 : -999. );
+
+        double iCosPhi = cos( iPhi[i] );
+        double iSinPhi = sin( iPhi[i] );
+        double iXc = fMC_Xoffset + iDist[i] * iCosPhi;
+        double iYc = fMC_Yoffset + iDist[i] * iSinPhi;
+        double iLog = log10( TMath::Max( iSize[i], 10. ) / 100. );
+        double iLength = TMath::Max( 0.08 + 0.06 * iLog, 0.05 );
+        double iWidth = TMath::Max( 0.04 + 0.02 * iLog, 0.03 );
+        double iNorm = iSize[i] * fPixelArea / ( 2. * TMath::Pi() * iLength * iWidth );
+        // time gradient along the major axis changes sign with impact distance [ns/deg]
+        double iTimeGradient = -2. + 0.04 * iR[i];
+
+        for( unsigned int c = 0; c < fNChannels[i]; c++ )
+        {
+            fillNoiseTrace( i, c );
+            // Cherenkov light
+            double u = ( fPixelX[i][c] - iXc ) * iCosPhi + ( fPixelY[i][c] - iYc ) * iSinPhi;
+            double v = -( fPixelX[i][c] - iXc ) * iSinPhi + ( fPixelY[i][c] - iYc ) * iCosPhi;
+            if( fabs( u ) < 5. * iLength && fabs( v ) < 5. * iWidth )
+            {
+                double iMean = iNorm * exp( -0.5 * ( u * u / iLength / iLength + v * v / iWidth / iWidth ) );
+                int iNPE = fRandomGen->Poisson( iMean );
+                if( iNPE > 0 )
+                {
+                    double iCharge = fDCperPE * ( double )iNPE * fRandomGen->Gaus( 1., 0.35 / sqrt( ( double )iNPE ) );
+                    if( iCharge > 0. )
+                    {
+                        addPulse( &fTraceTemp[0], iT0 + iTimeGradient * u + fRandomGen->Gaus( 0., 0.5 ), iCharge );
+                    }
+                }
+            }
+            fillSamples( i, c );
+        }
+    }
+}
+
+
+bool VSyntheticDataReader::getNextEvent()
+{
+    if( fEventNumber >= fNEvents )
+    {
+        setEventStatus( 999 );
+        return false;
+    }
+    fEventNumber++;
+    generateShower();
+    setEventStatus( 1 );
+
+    return true;
+}
+
+
+unsigned int VSyntheticDataReader::getNTelLocalTrigger()
+{
+    unsigned int iN = 0;
+    for( unsigned int i = 0; i < fLocalTrigger.size(); i++ )
+    {
+        if( fLocalTrigger[i] )
+        {
+            iN++;
+        }
+    }
+    return iN;
+}
+
+
+uint8_t VSyntheticDataReader::getSample( unsigned channel, unsigned sample, bool iNewNoiseTrace )
+{
+    if( fTelID < fSamples.size() && channel < fNChannels[fTelID] && sample < fNSamples )
+    {
+        return fSamples[fTelID][channel * fNSamples + sample];
+    }
+    return 0;
+}
+
+
+const uint8_t* VSyntheticDataReader::getSamplePtr( unsigned channel, unsigned int& iNSamples )
+{
+    iNSamples = 0;
+    if( fTelID < fSamples.size() && channel < fNChannels[fTelID] && fNSamples > 0 )
+    {
+        iNSamples = fNSamples;
+        return &fSamples[fTelID][channel * fNSamples];
+    }
+    return 0;
+}
+
+
+vector< uint8_t > VSyntheticDataReader::getSamplesVec()
+{
+    unsigned int iNSamples = 0;
+    const uint8_t* iS = getSamplePtr( fSelectedHitChannel, iNSamples );
+    if( iS )
+    {
+        return vector< uint8_t >( iS, iS + iNSamples );
+    }
+    return vector< uint8_t >( fNSamples, 0 );
+}
+
+
+void VSyntheticDataReader::setSumWindow( vector< int > iSW )
+{
+    for( unsigned int i = 0; i < iSW.size() && i < fSumWindow.size(); i++ )
+    {
+        setSumWindow( i, iSW[i] );
+    }
+}
+
+
+void VSyntheticDataReader::setSumWindow( unsigned int iTelID, int iSW )
+{
+    if( iTelID < fSumWindow.size() && iSW >= 0 && iSW <= ( int )fNSamples )
+    {
+        fSumWindow[iTelID] = iSW;
+    }
+}
+
+
+bool VSyntheticDataReader::setTelescopeID( unsigned int iTel )
+{
+    if( iTel < fNTel )
+    {
+        fTelID = iTel;
+        return true;
+    }
+    return false;
+}
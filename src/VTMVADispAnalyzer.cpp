@@ -239,6 +239,14 @@ float VTMVADispAnalyzer::evaluate( float iWidth, float iLength, float iSize, flo
     return -99.;
 }
 
+VTMVADispAnalyzer::~VTMVADispAnalyzer()
+{
+    for( map< ULong64_t, TMVA::Reader* >::iterator iR = fTMVAReader.begin(); iR != fTMVAReader.end(); ++iR )
+    {
+        delete iR->second;
+    }
+}
+
 void VTMVADispAnalyzer::terminate()
 {
     return;
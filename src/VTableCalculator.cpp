@@ -26,6 +26,9 @@ VTableCalculator::VTableCalculator( int intel, bool iEnergy, bool iPE )
     }
     hMedian = 0;
     hMean = 0;
+    fGrid = 0;
+    fHistoGrid = 0;
+    fInputParentDir = 0;
 
     Omode = 'r';
     fwrite = false;
@@ -50,6 +53,46 @@ VTableCalculator::VTableCalculator( int intel, bool iEnergy, bool iPE )
 }
 
 
+/*
+ * read-only table from a binary table file (see VTableLookupBinaryFile)
+ *
+ * grid is not owned by this class
+ */
+VTableCalculator::VTableCalculator( VTableLookupGrid* iGrid, bool iEnergy, bool iPE )
+{
+    setDebug();
+
+    setConstants( iPE );
+
+    fEnergy = iEnergy;
+    fUseMedianEnergy = 1;
+    fGrid = iGrid;
+    fHistoGrid = 0;
+    hMedian = 0;
+    hMean = 0;
+    fOutDir = 0;
+    fInputParentDir = 0;
+    fWrite1DHistograms = false;
+    fFillMedianApproximations = false;
+
+    Omode = 'r';
+    fwrite = false;
+
+    fInterPolWidth = 1;
+    fInterPolIter = 3;
+
+    fBinning1DXlow = 1.e-5;
+    fBinning1DXhigh = 1. + 1.e-5;
+    if( fEnergy )
+    {
+        fBinning1DXlow =  1.;
+        fBinning1DXhigh = 5.;
+    }
+
+    fReadHistogramsFromFile = true;
+}
+
+
 VTableCalculator::VTableCalculator( string fpara, string hname_add, char m, TDirectory* iDir, bool iEnergy, bool iPE, int iUseMedianEnergy )
 {
     setDebug();
@@ -64,6 +107,9 @@ VTableCalculator::VTableCalculator( string fpara, string hname_add, char m, TDir
     fEnergy = iEnergy;
     fUseMedianEnergy = iUseMedianEnergy;
     fReadHistogramsFromFile = false;
+    fGrid = 0;
+    fHistoGrid = 0;
+    fInputParentDir = 0;
 
     fHName_Add = hname_add;
 
@@ -159,28 +205,78 @@ VTableCalculator::VTableCalculator( string fpara, string hname_add, char m, TDir
     {
         fReadHistogramsFromFile = false;
 
-        if( fUseMedianEnergy == 1 )
-        {
-            sprintf( hname, "%s_median_%s", fpara.c_str(), fHName_Add.c_str() );
-        }
-        else if( fUseMedianEnergy == 2 )
+        setMedianHistogramName( fpara );
+    }
+
+}
+
+
+/*
+ * table reading: table directory iParentDir/iDirName is read on first access
+ * of the table histograms (see getHistoMedian())
+ */
+VTableCalculator::VTableCalculator( string fpara, string hname_add, TDirectory* iParentDir, string iDirName, bool iEnergy, bool iPE, int iUseMedianEnergy )
+{
+    setDebug();
+
+    fWrite1DHistograms = false;
+    fFillMedianApproximations = false;
+
+    setConstants( iPE );
+    fEnergy = iEnergy;
+    fUseMedianEnergy = iUseMedianEnergy;
+    fReadHistogramsFromFile = false;
+    fGrid = 0;
+    fHistoGrid = 0;
+    hMedian = 0;
+    hMean = 0;
+
+    fHName_Add = hname_add;
+    fName = fpara;
+
+    fInterPolWidth = 1;
+    fInterPolIter = 3;
+
+    setBinning();
+
+    fOutDir = 0;
+    fInputParentDir = iParentDir;
+    fInputDirName = iDirName;
+    if( !fInputParentDir )
+    {
+        cout << "VTableCalculator: error data directory in root file does not exist " << iDirName << "\t" << fpara << endl;
+        exit( -1 );
+    }
+    Omode  = 'r';
+    fwrite = false;
+
+    setMedianHistogramName( fpara );
+}
+
+
+void VTableCalculator::setMedianHistogramName( string fpara )
+{
+    char hname[1000];
+    if( fUseMedianEnergy == 1 )
+    {
+        sprintf( hname, "%s_median_%s", fpara.c_str(), fHName_Add.c_str() );
+    }
+    else if( fUseMedianEnergy == 2 )
+    {
+        if( fEnergy )
         {
-            if( fEnergy )
-            {
-                sprintf( hname, "%s_mpv_%s", fpara.c_str(), fHName_Add.c_str() );
-            }
-            else
-            {
-                sprintf( hname, "%s_median_%s", fpara.c_str(), fHName_Add.c_str() );
-            }
+            sprintf( hname, "%s_mpv_%s", fpara.c_str(), fHName_Add.c_str() );
         }
         else
         {
-            sprintf( hname, "%s_mean_%s", fpara.c_str(), fHName_Add.c_str() );
+            sprintf( hname, "%s_median_%s", fpara.c_str(), fHName_Add.c_str() );
         }
-        hMedianName = hname;
     }
-
+    else
+    {
+        sprintf( hname, "%s_mean_%s", fpara.c_str(), fHName_Add.c_str() );
+    }
+    hMedianName = hname;
 }
 
 void VTableCalculator::setBinning()
@@ -679,6 +775,30 @@ double VTableCalculator::calc( int ntel, float* r, float* s, float* w, double* m
             }
         }
 
+        // expected values and sigmas for all telescopes
+        // (batched; see VTableLookupGrid::interpolate)
+        bool bGrids = ( !hMedian && ntel > 0 && gVMedian.size() == ( unsigned int )ntel );
+        if( bGrids )
+        {
+            fBatchGrid.resize( ntel );
+            fBatchX.resize( ntel );
+            fBatchY.resize( ntel );
+            fBatchMed.resize( ntel );
+            fBatchSigma.resize( ntel );
+            for( tel = 0; tel < ntel; tel++ )
+            {
+                fBatchGrid[tel] = 0;
+                fBatchX[tel] = 0.;
+                fBatchY[tel] = r[tel];
+                if( r[tel] >= 0. && s[tel] > 0 )
+                {
+                    fBatchGrid[tel] = gVMedian[tel];
+                    fBatchX[tel] = log10( s[tel] );
+                }
+            }
+            VTableLookupGrid::interpolate( ntel, &fBatchGrid[0], &fBatchX[0], &fBatchY[0], &fBatchMed[0], &fBatchSigma[0] );
+        }
+
         ////////////////////////////////////////////////////
         // loop over all telescopes
         ////////////////////////////////////////////////////
@@ -692,6 +812,11 @@ double VTableCalculator::calc( int ntel, float* r, float* s, float* w, double* m
                     med   = interpolate( hMedian, log10( s[tel] ), r[tel], false );
                     sigma = interpolate( hMedian, log10( s[tel] ), r[tel], true );
                 }
+                else if( bGrids && gVMedian[tel] )
+                {
+                    med   = fBatchMed[tel];
+                    sigma = fBatchSigma[tel];
+                }
                 else if( hVMedian.size() == ( unsigned int )ntel && hVMedian[tel] )
                 {
                     med   = interpolate( hVMedian[tel], log10( s[tel] ), r[tel], false );
@@ -980,6 +1105,17 @@ double VTableCalculator::getWeightMeanBinContent( TH2F* h, int ix0, int iy0, dou
 }
 
 
+/*
+ * tables from a binary table file (see VTableLookupBinaryFile)
+ */
+void VTableCalculator::setVGrids( vector< VTableLookupGrid* >& gM )
+{
+    gVMedian = gM;
+
+    fReadHistogramsFromFile = true;
+}
+
+
 void VTableCalculator::setVHistograms( vector< TH2F* >& hM )
 {
     hVMedian = hM;
@@ -999,14 +1135,72 @@ TH2F* VTableCalculator::getHistoMedian()
 }
 
 
+/*
+ * memory used by the table histograms (approximate)
+ */
+unsigned long VTableCalculator::getMemorySize()
+{
+    if( !hMedian )
+    {
+        return 0;
+    }
+    unsigned long iSize = sizeof( TH2F ) + ( unsigned long )hMedian->GetSize() * sizeof( float )
+                          + ( unsigned long )hMedian->GetSumw2N() * sizeof( double );
+    if( fHistoGrid )
+    {
+        iSize += sizeof( VTableLookupGrid ) + 2 * ( unsigned long )fHistoGrid->getSize() * sizeof( float );
+    }
+    return iSize;
+}
+
+
+/*
+ * remove table histograms from memory (read again on next access)
+ */
+void VTableCalculator::releaseHistograms()
+{
+    if( fwrite || fGrid || !hMedian )
+    {
+        return;
+    }
+    delete hMedian;
+    hMedian = 0;
+    if( fHistoGrid )
+    {
+        delete fHistoGrid;
+        fHistoGrid = 0;
+    }
+    fReadHistogramsFromFile = false;
+}
+
+
 bool VTableCalculator::readHistograms()
 {
+    if( !fOutDir && fInputParentDir )
+    {
+        fOutDir = ( TDirectory* )fInputParentDir->Get( fInputDirName.c_str() );
+        if( !fOutDir )
+        {
+            cout << "VTableCalculator: error data directory in root file does not exist ";
+            cout << fInputParentDir->GetPath() << "/" << fInputDirName << endl;
+            exit( -1 );
+        }
+    }
     if( fOutDir )
     {
         hMedian = ( TH2F* )fOutDir->Get( hMedianName.c_str() );
 
         if( hMedian )
         {
+            // plain arrays for interpolation (see VTableLookupGrid)
+            if( !fwrite )
+            {
+                if( fHistoGrid )
+                {
+                    delete fHistoGrid;
+                }
+                fHistoGrid = new VTableLookupGrid( hMedian );
+            }
             return true;
         }
         else
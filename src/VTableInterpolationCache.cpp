@@ -0,0 +1,196 @@
+/*! \class VTableInterpolationCache
+    \brief lookup tables interpolated in wobble offset and zenith angle (cached per run)
+
+    Zenith angle, wobble offset and noise level change slowly during a run.
+    Instead of reading four tables per telescope and interpolating the results
+    of each event, the tables of the four corners are interpolated bin by bin
+    (same interpolation as for the results in VTableLookup::interpolate()) and
+    kept for the quantized zenith angle and wobble offset. Each telescope lookup
+    is then a single bilinear evaluation of the interpolated table.
+
+    Empty bins (contents <= 0) are treated as invalid values in the interpolation.
+
+    Quantization: the tables are interpolated for the zenith angle and wobble
+    offset rounded to the step sizes (default 0.1 deg and 0.01 deg), i.e. for
+    zenith angles up to 0.05 deg and wobble offsets up to 0.005 deg different
+    from the event values (see testTableInterpolationCache).
+
+    Memory: the cache is cleared when the interpolated tables exceed the memory
+    budget (-tableinterpolationcachesize).
+
+*/
+
+#include "VTableInterpolationCache.h"
+
+const unsigned int VTableInterpolationCache::fNTableTypes;
+
+VTableInterpolationCache::VTableInterpolationCache( double iZeStep, double iWoffStep, double iMemoryBudget_MB )
+{
+    fZeStep = iZeStep;
+    fWoffStep = iWoffStep;
+    fMemoryBudget = iMemoryBudget_MB * 1024. * 1024.;
+    fMemory = 0.;
+    fMemoryMax = 0.;
+
+    fNHits = 0;
+    fNMisses = 0;
+    fNFailed = 0;
+    fNCleared = 0;
+}
+
+
+VTableInterpolationCache::~VTableInterpolationCache()
+{
+    clear();
+}
+
+
+void VTableInterpolationCache::clear()
+{
+    map< sTableInterpolationKey, vector< VTableLookupGrid* > >::iterator iT;
+    for( iT = fTables.begin(); iT != fTables.end(); ++iT )
+    {
+        for( unsigned int i = 0; i < iT->second.size(); i++ )
+        {
+            delete iT->second[i];
+        }
+    }
+    fTables.clear();
+    fMemory = 0.;
+}
+
+
+/*
+ * cache is cleared if the memory budget is exceeded
+ * (called before the first table lookup of an event; tables of the
+ *  current event are therefore never deleted)
+ */
+void VTableInterpolationCache::nextEvent()
+{
+    if( fMemoryBudget > 0. && fMemory > fMemoryBudget )
+    {
+        clear();
+        fNCleared++;
+    }
+}
+
+
+/*
+ * interpolated tables (0 if not in cache)
+ */
+vector< VTableLookupGrid* >* VTableInterpolationCache::get( const sTableInterpolationKey& k )
+{
+    map< sTableInterpolationKey, vector< VTableLookupGrid* > >::iterator iT = fTables.find( k );
+    if( iT == fTables.end() )
+    {
+        return 0;
+    }
+    fNHits++;
+    return &iT->second;
+}
+
+
+/*
+ * interpolate tables of the four corners and add them to the cache
+ *
+ * g[table type][corner]
+ *
+ * returns interpolated tables (0 for tables which can't be interpolated)
+ */
+vector< VTableLookupGrid* >* VTableInterpolationCache::add( const sTableInterpolationKey& k, vector< vector< VTableLookupGrid* > >& g,
+        double* woff_corner, double ze_low, double ze_up, double woff, double ze )
+{
+    fNMisses++;
+    vector< VTableLookupGrid* > iG( fNTableTypes, ( VTableLookupGrid* )0 );
+    for( unsigned int i = 0; i < fNTableTypes && i < g.size(); i++ )
+    {
+        iG[i] = interpolate( g[i], woff_corner, ze_low, ze_up, woff, ze );
+        if( !iG[i] )
+        {
+            fNFailed++;
+        }
+        else
+        {
+            fMemory += iG[i]->getMemorySize();
+        }
+    }
+    if( fMemory > fMemoryMax )
+    {
+        fMemoryMax = fMemory;
+    }
+    fTables[k] = iG;
+
+    return &fTables[k];
+}
+
+
+/*
+ * bin-by-bin interpolation of the tables of the four corners
+ * (first in wobble offset, then in zenith angle; as in VTableLookup::readLookupTable)
+ *
+ * returns 0 for tables with different binning
+ */
+VTableLookupGrid* VTableInterpolationCache::interpolate( vector< VTableLookupGrid* >& g,
+        double* woff_corner, double ze_low, double ze_up, double woff, double ze )
+{
+    if( g.size() != 4 )
+    {
+        return 0;
+    }
+    for( unsigned int c = 0; c < g.size(); c++ )
+    {
+        if( !g[c] || !g[c]->isValid() || !g[0]->hasSameBinning( g[c] ) )
+        {
+            return 0;
+        }
+    }
+    unsigned int n = g[0]->getSize();
+    vector< float > iContent( n, 0. );
+    vector< float > iError( n, 0. );
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        // empty bins are invalid
+        double v[4];
+        double e[4];
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            v[c] = g[c]->fContent[i];
+            e[c] = g[c]->fError[i];
+            if( v[c] <= 0. )
+            {
+                v[c] = -99.;
+                e[c] = -99.;
+            }
+        }
+        double v_low = VStatistics::interpolate( v[0], woff_corner[0], v[1], woff_corner[1], woff, false );
+        double v_up  = VStatistics::interpolate( v[2], woff_corner[2], v[3], woff_corner[3], woff, false );
+        double v_n   = VStatistics::interpolate( v_low, ze_low, v_up, ze_up, ze, true );
+        double e_low = VStatistics::interpolate( e[0], woff_corner[0], e[1], woff_corner[1], woff, false );
+        double e_up  = VStatistics::interpolate( e[2], woff_corner[2], e[3], woff_corner[3], woff, false );
+        double e_n   = VStatistics::interpolate( e_low, ze_low, e_up, ze_up, ze, true );
+        if( v_n > 0. )
+        {
+            iContent[i] = ( float )v_n;
+            iError[i] = ( float )( e_n > 0. ? e_n : 0. );
+        }
+    }
+
+    return new VTableLookupGrid( g[0], iContent, iError );
+}
+
+
+void VTableInterpolationCache::printSummary()
+{
+    cout << "lookup table interpolation cache: ";
+    cout << fNHits << " hits, " << fNMisses << " misses";
+    cout << " (zenith step " << fZeStep << " deg, wobble offset step " << fWoffStep << " deg";
+    cout << ", max memory " << fMemoryMax / 1024. / 1024. << " MB)" << endl;
+    if( fNFailed > 0 )
+    {
+        cout << "\t " << fNFailed << " tables not interpolated (different binning)" << endl;
+    }
+    if( fNCleared > 0 )
+    {
+        cout << "\t cache cleared " << fNCleared << " times (memory budget: " << fMemoryBudget / 1024. / 1024. << " MB)" << endl;
+    }
+}
@@ -0,0 +1,117 @@
+/*! \class VTableLRUCache
+    \brief lookup tables in memory (least recently used tables are removed first)
+
+    Table histograms are read from the table file on first use. If the
+    memory used by all tables exceeds the memory budget, the least recently
+    used tables are removed from memory (and read again if needed).
+
+    Tables used in the current event are never removed (pointers to these
+    tables are kept in VTablesToRead); the budget might therefore be exceeded
+    temporarily.
+
+    Tables from binary table files are memory mapped and not handled by this
+    cache (see VTableLookupBinaryFile).
+
+*/
+
+#include "VTableLRUCache.h"
+
+VTableLRUCache::VTableLRUCache( double iMemoryBudget_MB )
+{
+    fMemoryBudget = iMemoryBudget_MB * 1024. * 1024.;
+    if( fMemoryBudget < 0. )
+    {
+        fMemoryBudget = 0.;
+    }
+    fMemory = 0.;
+    fMemoryMax = 0.;
+
+    fEvent = 0;
+    fNHits = 0;
+    fNMisses = 0;
+    fNEvicted = 0;
+}
+
+
+/*
+ * get table histogram (read from file if not in memory)
+ */
+TH2F* VTableLRUCache::getHistoMedian( VTableCalculator* t )
+{
+    if( !t || t->isBinaryTable() )
+    {
+        return 0;
+    }
+    map< VTableCalculator*, sTableLRUCacheEntry >::iterator iE = fEntries.find( t );
+    if( iE != fEntries.end() )
+    {
+        fNHits++;
+        fLRU.splice( fLRU.begin(), fLRU, iE->second.fLRUPosition );
+        iE->second.fLastEvent = fEvent;
+        return t->getHistoMedian();
+    }
+
+    fNMisses++;
+    TH2F* h = t->getHistoMedian();
+    if( !h )
+    {
+        return 0;
+    }
+    fLRU.push_front( t );
+    sTableLRUCacheEntry iEntry;
+    iEntry.fLRUPosition = fLRU.begin();
+    iEntry.fLastEvent = fEvent;
+    iEntry.fMemorySize = t->getMemorySize();
+    fEntries[t] = iEntry;
+
+    fMemory += iEntry.fMemorySize;
+    if( fMemory > fMemoryMax )
+    {
+        fMemoryMax = fMemory;
+    }
+    evict();
+
+    return h;
+}
+
+
+/*
+ * remove least recently used tables until memory is below budget
+ */
+void VTableLRUCache::evict()
+{
+    if( fMemoryBudget <= 0. )
+    {
+        return;
+    }
+    while( fMemory > fMemoryBudget && !fLRU.empty() )
+    {
+        VTableCalculator* t = fLRU.back();
+        map< VTableCalculator*, sTableLRUCacheEntry >::iterator iE = fEntries.find( t );
+        // all remaining tables are used in this event
+        if( iE == fEntries.end() || iE->second.fLastEvent == fEvent )
+        {
+            break;
+        }
+        fMemory -= iE->second.fMemorySize;
+        t->releaseHistograms();
+        fEntries.erase( iE );
+        fLRU.pop_back();
+        fNEvicted++;
+    }
+}
+
+
+void VTableLRUCache::printSummary()
+{
+    cout << "lookup table cache: ";
+    cout << fNHits << " hits, " << fNMisses << " misses (tables read from file), ";
+    cout << fNEvicted << " tables removed from memory" << endl;
+    cout << "\t tables in memory: " << fEntries.size();
+    cout << ", memory " << fMemory / 1024. / 1024. << " MB (max " << fMemoryMax / 1024. / 1024. << " MB";
+    if( fMemoryBudget > 0. )
+    {
+        cout << ", budget " << fMemoryBudget / 1024. / 1024. << " MB";
+    }
+    cout << ")" << endl;
+}
@@ -18,12 +18,26 @@ VTableLookup::VTableLookup( char ireadwrite, unsigned int iDebug )
     fDirMSCW = 0;
     fDirMSCL = 0;
     fDirEnergySR = 0;
+    fLookupTableBinaryFile = 0;
+    fTableCache = 0;
+    fTableInterpolationCache = 0;
+    fTableMutex = 0;
+    f_calc_msc = 0;
+    f_calc_energySR = 0;
+    fTables_ZupWup = 0;
+    fTables_ZupWlow = 0;
+    fTables_Zup = 0;
+    fTables_ZlowWup = 0;
+    fTables_ZlowWlow = 0;
+    fTables_Zlow = 0;
+    fTables_N = 0;
 
     // run parameters
     fTLRunParameter = 0;
 
     fNumberOfIgnoredEvents = 0;
     fNNoiseLevelWarnings = 0;
+    fNNoiseLevelWarningsCounter = &fNNoiseLevelWarnings;
 
     // use median size for energy determination
     fUseMedianSizeforEnergyDetermination = true;
@@ -74,6 +88,23 @@ VTableLookup::VTableLookup( char ireadwrite, unsigned int iDebug )
     fTableAzBins = fTableAzLowEdge.size();
 }
 
+/*
+ * tables, table caches and the data handler are shared with copies
+ * of this class (see clone()) and are not deleted here
+ */
+VTableLookup::~VTableLookup()
+{
+    delete f_calc_msc;
+    delete f_calc_energySR;
+    delete fTables_ZupWup;
+    delete fTables_ZupWlow;
+    delete fTables_Zup;
+    delete fTables_ZlowWup;
+    delete fTables_ZlowWlow;
+    delete fTables_Zlow;
+    delete fTables_N;
+}
+
 
 /*!
       \param ifile output file name
@@ -293,6 +324,23 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
         cout << "void VTableLookup::setMCTableFiles( string itablefile, string isuff )" << endl;
     }
 
+    // flat binary table file (see VTableLookupBinaryFile)
+    // (local file or file in $VERITAS_EVNDISP_AUX_DIR/Tables)
+    if( VTableLookupBinaryFile::isBinaryTableFile( itablefile ) )
+    {
+        setMCTableFilesFromBinaryFile( itablefile );
+        return;
+    }
+    if( gSystem->Getenv( "VERITAS_EVNDISP_AUX_DIR" ) && itablefile.find( "/" ) == string::npos )
+    {
+        string iAuxTableFile = string( gSystem->Getenv( "VERITAS_EVNDISP_AUX_DIR" ) ) + "/Tables/" + itablefile;
+        if( VTableLookupBinaryFile::isBinaryTableFile( iAuxTableFile ) )
+        {
+            setMCTableFilesFromBinaryFile( iAuxTableFile );
+            return;
+        }
+    }
+
     // open table file
     gErrorIgnoreLevel = 20001;
     fLookupTableFile = new TFile( itablefile.c_str() );
@@ -321,7 +369,9 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
         }
     }
     gErrorIgnoreLevel = 0;
-    cout << "reading table file ( may take a while ): " << itablefile << endl;
+    cout << "reading table file: " << itablefile << endl;
+    // tables are read on first use
+    fTableCache = new VTableLRUCache( fTLRunParameter->fTableCacheSize );
 
     vector< VTableCalculator* > i_mscw;
     vector< VTableCalculator* > i_mscl;
@@ -354,7 +404,7 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
 
     // ZENITH ANGLE
     TDirectory* iDirZe = gDirectory;
-    vector< string > iDNameZE = getSortedListOfDirectories( iDirZe );
+    vector< string > iDNameZE = VTableLookupBinaryFile::getSortedListOfDirectories( iDirZe );
     for( unsigned z = 0; z < iDNameZE.size(); z++ )
     {
         fTableZe.push_back( atof( iDNameZE[z].substr( 3, 3 ).c_str() ) / 10. );
@@ -368,7 +418,7 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
 
         // DIRECTION OFFSET
         TDirectory* iDirWoff = gDirectory;
-        vector< string > iDNameWoff  = getSortedListOfDirectories( iDirWoff );
+        vector< string > iDNameWoff  = VTableLookupBinaryFile::getSortedListOfDirectories( iDirWoff );
         i_DirectionOffset.clear();
         for( unsigned int w = 0; w < iDNameWoff.size(); w++ )
         {
@@ -383,7 +433,7 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
 
             // AZIMUTH ANGLE
             TDirectory* iDirAz = gDirectory;
-            vector< string > iDNameAz  = getSortedListOfDirectories( iDirAz );
+            vector< string > iDNameAz  = VTableLookupBinaryFile::getSortedListOfDirectories( iDirAz );
             for( unsigned int a = 0; a < iDNameAz.size(); a++ )
             {
                 ii_mscw.clear();
@@ -396,7 +446,7 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
 
                 // TELESCOPE
                 TDirectory* iDirTel = gDirectory;
-                vector< string > iDNameTel = getSortedListOfDirectories( iDirTel );
+                vector< string > iDNameTel = VTableLookupBinaryFile::getSortedListOfDirectories( iDirTel );
                 for( unsigned int t = 0; t < iDNameTel.size(); t++ )
                 {
                     i_mscw.clear();
@@ -411,28 +461,21 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
 
                     // NOISE LEVEL
                     TDirectory* iDirNoise = gDirectory;
-                    vector< string > iDNameNoise = getSortedListOfDirectories( iDirNoise );
+                    vector< string > iDNameNoise = VTableLookupBinaryFile::getSortedListOfDirectories( iDirNoise );
                     for( unsigned int n = 0; n < iDNameNoise.size(); n++ )
                     {
-                        iDirNoise->cd( iDNameNoise[n].c_str() );
                         if( fDebug == 2 )
                         {
-                            cout << "DEBUG  DIR " << " " << gDirectory->GetPath() << endl;
+                            cout << "DEBUG  DIR " << " " << iDirNoise->GetPath() << "/" << iDNameNoise[n] << endl;
                         }
                         i_TableZeOffsetAzTelNoise.push_back( stof( iDNameNoise[n].substr( iDNameNoise[n].find( "_" ) + 1 ) ) / 100. );
 
-                        // READ IN ALL TABLES
-                        TDirectory* iDir = ( TDirectory* )gDirectory->Get( "mscw" );
-                        // get mscw directory
-                        i_mscw.push_back( new VTableCalculator( "width", isuff.c_str(), freadwrite, iDir, false ) );
-                        // get mscl directory
-                        iDirNoise->cd( iDNameNoise[n].c_str() );
-                        iDir = ( TDirectory* )gDirectory->Get( "mscl" );
-                        i_mscl.push_back( new VTableCalculator( "length", isuff.c_str(), freadwrite, iDir, false ) );
-                        // get energy directory (size vs radius method)
-                        iDirNoise->cd( iDNameNoise[n].c_str() );
-                        iDir = ( TDirectory* )gDirectory->Get( "energySR" );
-                        i_energySR.push_back( new VTableCalculator( "energySR", isuff.c_str(), freadwrite, iDir, true, fTLRunParameter->fPE, fTLRunParameter->fUseMedianEnergy ) );
+                        // tables (directories and histograms are read on first use)
+                        i_mscw.push_back( new VTableCalculator( "width", isuff.c_str(), iDirNoise, iDNameNoise[n] + "/mscw", false ) );
+                        i_mscl.push_back( new VTableCalculator( "length", isuff.c_str(), iDirNoise, iDNameNoise[n] + "/mscl", false ) );
+                        // energy (size vs radius method)
+                        i_energySR.push_back( new VTableCalculator( "energySR", isuff.c_str(), iDirNoise, iDNameNoise[n] + "/energySR", true,
+                                              fTLRunParameter->fPE, fTLRunParameter->fUseMedianEnergy ) );
                     }                             // noise levels
                     ii_TableZeOffsetAzTelNoise.push_back( i_TableZeOffsetAzTelNoise );
                     ii_mscw.push_back( i_mscw );
@@ -479,6 +522,179 @@ void VTableLookup::setMCTableFiles( string itablefile, string isuff, string iInt
     }
 }
 
+/*
+    read tables from a flat binary table file (see VTableLookupBinaryFile)
+
+    tables are not copied: all grids point into the memory mapped file
+
+    table index is ordered in ze/woff/az/tel/noise (as the ROOT table file)
+*/
+void VTableLookup::setMCTableFilesFromBinaryFile( string itablefile )
+{
+    fLookupTableBinaryFile = new VTableLookupBinaryFile();
+    if( !fLookupTableBinaryFile->open( itablefile ) )
+    {
+        cout << "VTableLookup::setMCTableFiles error (reading): unable to open binary table file: " << itablefile << endl;
+        exit( EXIT_FAILURE );
+    }
+    cout << "reading binary table file: " << itablefile;
+    cout << " (" << fLookupTableBinaryFile->getNTables() << " tables)" << endl;
+
+    // energy tables (mean tables are not available in binary table files)
+    uint32_t iEnergyType = VTableLookupBinaryFile::fType_energySR;
+    if( fTLRunParameter->fUseMedianEnergy == 2 )
+    {
+        iEnergyType = VTableLookupBinaryFile::fType_energySR_mpv;
+    }
+    else if( fTLRunParameter->fUseMedianEnergy != 1 )
+    {
+        cout << "VTableLookup::setMCTableFiles error: energy tables of type mean not available in binary table files" << endl;
+        exit( EXIT_FAILURE );
+    }
+
+    fTableZe.clear();
+    fTableZeOffset.clear();
+    fTableZeOffsetAzTelNoise.clear();
+    fTelType_tables.clear();
+    fmscw.clear();
+    fmscl.clear();
+    fenergySizevsRadius.clear();
+
+    for( unsigned int i = 0; i < fLookupTableBinaryFile->getNTables(); i++ )
+    {
+        const sTableEntry* e = fLookupTableBinaryFile->getTableEntry( i );
+        if( !e || ( e->iType != VTableLookupBinaryFile::fType_mscw
+                    && e->iType != VTableLookupBinaryFile::fType_mscl
+                    && e->iType != iEnergyType ) )
+        {
+            continue;
+        }
+        // zenith angle
+        if( e->ize >= fTableZe.size() )
+        {
+            fTableZe.resize( e->ize + 1, 0. );
+            fTableZeOffset.resize( e->ize + 1 );
+            fTableZeOffsetAzTelNoise.resize( e->ize + 1 );
+            fTelType_tables.resize( e->ize + 1 );
+            fmscw.resize( e->ize + 1 );
+            fmscl.resize( e->ize + 1 );
+            fenergySizevsRadius.resize( e->ize + 1 );
+        }
+        fTableZe[e->ize] = e->ze;
+        // wobble offset
+        if( e->iwoff >= fTableZeOffset[e->ize].size() )
+        {
+            fTableZeOffset[e->ize].resize( e->iwoff + 1, 0. );
+            fTableZeOffsetAzTelNoise[e->ize].resize( e->iwoff + 1 );
+            fTelType_tables[e->ize].resize( e->iwoff + 1 );
+            fmscw[e->ize].resize( e->iwoff + 1 );
+            fmscl[e->ize].resize( e->iwoff + 1 );
+            fenergySizevsRadius[e->ize].resize( e->iwoff + 1 );
+        }
+        fTableZeOffset[e->ize][e->iwoff] = e->woff;
+        // azimuth
+        if( e->iaz >= fTelType_tables[e->ize][e->iwoff].size() )
+        {
+            fTableZeOffsetAzTelNoise[e->ize][e->iwoff].resize( e->iaz + 1 );
+            fTelType_tables[e->ize][e->iwoff].resize( e->iaz + 1 );
+            fmscw[e->ize][e->iwoff].resize( e->iaz + 1 );
+            fmscl[e->ize][e->iwoff].resize( e->iaz + 1 );
+            fenergySizevsRadius[e->ize][e->iwoff].resize( e->iaz + 1 );
+        }
+        // telescope type
+        if( e->itel >= fTelType_tables[e->ize][e->iwoff][e->iaz].size() )
+        {
+            fTableZeOffsetAzTelNoise[e->ize][e->iwoff][e->iaz].resize( e->itel + 1 );
+            fTelType_tables[e->ize][e->iwoff][e->iaz].resize( e->itel + 1, 0 );
+            fmscw[e->ize][e->iwoff][e->iaz].resize( e->itel + 1 );
+            fmscl[e->ize][e->iwoff][e->iaz].resize( e->itel + 1 );
+            fenergySizevsRadius[e->ize][e->iwoff][e->iaz].resize( e->itel + 1 );
+        }
+        fTelType_tables[e->ize][e->iwoff][e->iaz][e->itel] = ( ULong64_t )e->telType;
+        // noise level
+        if( e->inoise >= fTableZeOffsetAzTelNoise[e->ize][e->iwoff][e->iaz][e->itel].size() )
+        {
+            fTableZeOffsetAzTelNoise[e->ize][e->iwoff][e->iaz][e->itel].resize( e->inoise + 1, 0. );
+            fmscw[e->ize][e->iwoff][e->iaz][e->itel].resize( e->inoise + 1, 0 );
+            fmscl[e->ize][e->iwoff][e->iaz][e->itel].resize( e->inoise + 1, 0 );
+            fenergySizevsRadius[e->ize][e->iwoff][e->iaz][e->itel].resize( e->inoise + 1, 0 );
+        }
+        fTableZeOffsetAzTelNoise[e->ize][e->iwoff][e->iaz][e->itel][e->inoise] = e->noise;
+
+        VTableLookupGrid* iGrid = fLookupTableBinaryFile->getGrid( i );
+        if( !iGrid )
+        {
+            exit( EXIT_FAILURE );
+        }
+        fLookupTableGrids.push_back( iGrid );
+        if( e->iType == VTableLookupBinaryFile::fType_mscw )
+        {
+            fmscw[e->ize][e->iwoff][e->iaz][e->itel][e->inoise] = new VTableCalculator( iGrid, false );
+        }
+        else if( e->iType == VTableLookupBinaryFile::fType_mscl )
+        {
+            fmscl[e->ize][e->iwoff][e->iaz][e->itel][e->inoise] = new VTableCalculator( iGrid, false );
+        }
+        else
+        {
+            fenergySizevsRadius[e->ize][e->iwoff][e->iaz][e->itel][e->inoise] = new VTableCalculator( iGrid, true, fTLRunParameter->fPE );
+        }
+    }
+
+    // missing tables are empty (no expected values; as for missing histograms in ROOT table files)
+    unsigned int iNMissing = 0;
+    for( unsigned int z = 0; z < fmscw.size(); z++ )
+    {
+        for( unsigned int w = 0; w < fmscw[z].size(); w++ )
+        {
+            for( unsigned int a = 0; a < fmscw[z][w].size(); a++ )
+            {
+                for( unsigned int t = 0; t < fmscw[z][w][a].size(); t++ )
+                {
+                    for( unsigned int n = 0; n < fmscw[z][w][a][t].size(); n++ )
+                    {
+                        if( fmscw[z][w][a][t][n] && fmscl[z][w][a][t][n] && fenergySizevsRadius[z][w][a][t][n] )
+                        {
+                            continue;
+                        }
+                        cout << "VTableLookup::setMCTableFiles warning: missing table for ze " << fTableZe[z];
+                        cout << ", woff " << fTableZeOffset[z][w] << ", az bin " << a;
+                        cout << ", tel type " << fTelType_tables[z][w][a][t];
+                        cout << ", noise " << fTableZeOffsetAzTelNoise[z][w][a][t][n] << endl;
+                        iNMissing++;
+                        if( !fmscw[z][w][a][t][n] )
+                        {
+                            fmscw[z][w][a][t][n] = new VTableCalculator( ( VTableLookupGrid* )0, false );
+                        }
+                        if( !fmscl[z][w][a][t][n] )
+                        {
+                            fmscl[z][w][a][t][n] = new VTableCalculator( ( VTableLookupGrid* )0, false );
+                        }
+                        if( !fenergySizevsRadius[z][w][a][t][n] )
+                        {
+                            fenergySizevsRadius[z][w][a][t][n] = new VTableCalculator( ( VTableLookupGrid* )0, true, fTLRunParameter->fPE );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if( fTableZe.size() == 0 )
+    {
+        cout << "     ...Error: did not survive test of table file !";
+        cout << " There are no tables in your table file: " << itablefile << endl;
+        exit( EXIT_FAILURE );
+    }
+    if( iNMissing > 0 )
+    {
+        cout << "VTableLookup::setMCTableFiles warning: " << iNMissing << " missing tables in " << itablefile << endl;
+    }
+    if( sanityCheckLookupTableFile() )
+    {
+        cout << "    ...survived test of table file! " << endl;
+    }
+}
+
 /*
 
      sanity checks for lookup tables (not fully implemented)
@@ -612,26 +828,20 @@ void VTableLookup::fillLookupTable()
 */
 void VTableLookup::readLookupTable()
 {
-    unsigned int i_az_bin = 0;
-
-    double esys = 0.;
-    double ze = 0.;
-    double woff = 0.;
-    int fevent = 0;
-
-    // lookup table index for interpolation
-    unsigned int ize_up = 0;
-    unsigned int ize_low = 0;
-    unsigned int iwoff_up = 0;
-    unsigned int iwoff_low = 0;
+    if( fTLRunParameter->fNThreads > 1 )
+    {
+        if( fTLRunParameter->fSelectRandom > 0. )
+        {
+            cout << "VTableLookup::readLookupTable(): random event selection requires single-threaded event loop (ignoring number of threads)" << endl;
+        }
+        else
+        {
+            readLookupTableParallel();
+            return;
+        }
+    }
 
-    VTablesToRead* s_ZupWup    = new VTablesToRead( fNTel );
-    VTablesToRead* s_ZupWlow   = new VTablesToRead( fNTel );
-    VTablesToRead* s_Zup       = new VTablesToRead( fNTel );
-    VTablesToRead* s_ZlowWup   = new VTablesToRead( fNTel );
-    VTablesToRead* s_ZlowWlow  = new VTablesToRead( fNTel );
-    VTablesToRead* s_Zlow      = new VTablesToRead( fNTel );
-    VTablesToRead* s_N         = new VTablesToRead( fNTel );
+    initializeTablesToRead();
 
     // first event
     bool bFirst = true;
@@ -644,181 +854,434 @@ void VTableLookup::readLookupTable()
     // start event loop
     while( fData->getNextEvent( false ) )
     {
-        // print progress
-        fevent = fData->getEventCounter();
-        if( ( fevent % 1000000 ) == 0 )
+        if( !prepareEvent( fData, bFirst ) )
         {
-            cout << "\t now at event " << fevent << endl;
+            continue;
         }
-
-        // eventdisplay is saying that his event should be ignored
-        if( fData->getEventNumber() == 99999999 )
+        // tables used in this event are kept in memory
+        if( fTableCache )
         {
-            fNumberOfIgnoredEvents++;
-            continue;
+            fTableCache->nextEvent();
         }
-
-        // get zenith angle for first valid MC event from MC files
-        if( bFirst && fData->getMCEnergy() > 0.001
-                && fTLRunParameter->ze < 0. )
+        if( fTableInterpolationCache )
         {
-            cout << "\t\t setting IRF ze from first event" << endl;
-            if( fNTel > 0 )
-            {
-                fTLRunParameter->ze = TMath::Floor( ( 90. - fData->getTelElevation() ) + 0.5 );
-            }
-            else
-            {
-                fTLRunParameter->ze = TMath::Floor( fData->getMCZe() + 0.5 );
-            }
-            if( fTLRunParameter->ze < 1.5 )
-            {
-                fTLRunParameter->ze = 0.;
-            }
-            fTLRunParameter->fWobbleOffset = ( int )( fData->getMCWobbleOffset() * 100. );
-            bFirst = false;
-        }
-        // reset image counter
-        fnmscw = 0;
-        unsigned int i_noise_bin = 0;
-        // fill MC energy spectra
-        fData->fillMChistograms();
-        // if data fails basic cuts, write default values directly to tree
-        if( !fData->cut() )
-        {
-            if( fWriteNoTriggerEvent )
-            {
-                fData->reset();
-                fData->fill();
-            }
-            // goto next event
+            fTableInterpolationCache->nextEvent();
         }
-        else
+        if( analyzeEvent() )
         {
-            //////////////////////////////////////
-            // here we should have good data only
-            // (ze, az, and wobble offset have been
-            //  tested)
-            //////////////////////////////////////
+            fData->fill();
+        }
+    }
+}
 
-            // get direction angles for this event
-            ze = fData->getZe();
-            woff = fData->getWobbleOffset();
-            i_az_bin = getAzBin( fData->getAz() );
-            // get noise level for this event
-            readNoiseLevel( false );
+/*
+ * read the tables with several threads
+ *
+ * events are read in chunks by a reader thread (into a copy of the data handler
+ * without disp analyzers), reconstructed and analyzed by the thread pool
+ * (each thread with its own copy of this class and of the data handler), and
+ * filled into the output tree by a writer thread in the order of the input tree
+ *
+ * access to the tables and to the table caches is serialized; tables used in a
+ * chunk are kept in memory until the chunk is finished
+ */
+void VTableLookup::readLookupTableParallel()
+{
+    unsigned int iNThreads = fTLRunParameter->fNThreads;
+    const unsigned int iChunkSize = 500;
+    const unsigned int iNChunks = 4;
+    unsigned int iNTasks = 4 * iNThreads;
 
-            if( fDebug == 2 )
-            {
-                cout << endl << endl << "DEBUG  NEW EVENT " << fData->getEventCounter() << endl;
-            }
-            /////////////////////////////
-            // ZENITH (low)
-            if( fDebug == 2 )
+    cout << "reading lookup tables with " << iNThreads << " threads" << endl;
+
+    ROOT::EnableThreadSafety();
+
+    fTableMutex = new mutex();
+
+    // workers: copy of lookup and data handler (incl. disp analyzers) per thread
+    // (taken by the tasks from the list of free workers)
+    vector< VTableLookup* > iWorker;
+    for( unsigned int i = 0; i < iNThreads; i++ )
+    {
+        iWorker.push_back( clone( fData->clone( true ) ) );
+    }
+    vector< VTableLookup* > iFreeWorker = iWorker;
+    mutex iWorkerMutex;
+
+    VTableLookupEventQueue iFreeQueue;
+    VTableLookupEventQueue iReadQueue;
+    VTableLookupEventQueue iWriteQueue;
+    vector< sTableLookupEventChunk* > iChunks;
+    for( unsigned int i = 0; i < iNChunks; i++ )
+    {
+        iChunks.push_back( new sTableLookupEventChunk() );
+        iChunks.back()->fN = 0;
+        iChunks.back()->fEvent.resize( iChunkSize );
+        iChunks.back()->fReadStatus.assign( iChunkSize, 0 );
+        iChunks.back()->fFill.assign( iChunkSize, 0 );
+        iFreeQueue.push( iChunks.back() );
+    }
+
+    ////////////////////////////////////////////////
+    // reader thread
+    VTableLookupDataHandler* iReader = fData->clone( false );
+    thread iReaderThread( [&]()
+    {
+        // first event
+        bool bFirst = fTLRunParameter->isMC;
+        bool bEnd = false;
+        while( !bEnd )
+        {
+            sTableLookupEventChunk* iChunk = iFreeQueue.pop();
+            if( !iChunk )
             {
-                cout << "DEBUG ZENITH LOW" << endl;
+                break;
             }
-            for( int t = 0; t < fNTel; t++ )
+            iChunk->fN = 0;
+            while( iChunk->fN < iChunkSize )
             {
-                if( fDebug == 2 )
+                int i_NE = iReader->readNextEvent( false );
+                if( i_NE < 0 )
                 {
-                    cout << "DEBUG  TELESCOPE " << t << " (T" << t + 1 << ")" << endl;
-                    cout << "DEBUG      zenith " << ze << ", noise " << fNoiseLevel[t] << ", woff " << woff << ", az " << fData->getAz() << ", az bin " << i_az_bin << endl;
+                    bEnd = true;
+                    break;
                 }
-                // get zenith angle (low)
-                getIndexBoundary( &ize_up, &ize_low, fTableZe, ze );
-                // get direction offset index
-                getIndexBoundary( &iwoff_up, &iwoff_low, fTableZeOffset[ize_low], woff );
-                // get noise bin (not interpolated; closest value)
-                i_noise_bin = getNoiseBin( ize_low, iwoff_up, i_az_bin, t, fNoiseLevel[t] );
-                getTables( i_noise_bin, ize_low, iwoff_up, i_az_bin, t, s_ZlowWup );
-                i_noise_bin = getNoiseBin( ize_low, iwoff_low, i_az_bin, t, fNoiseLevel[t] );
-                getTables( i_noise_bin, ize_low, iwoff_low, i_az_bin, t, s_ZlowWlow );
-            }
-            calculateMSFromTables( s_ZlowWup, esys );
-            calculateMSFromTables( s_ZlowWlow, esys );
-            // results in estimation of s_Zlow
-            interpolate( s_ZlowWlow, fTableZeOffset[ize_low][iwoff_low], s_ZlowWup, fTableZeOffset[ize_low][iwoff_up], s_Zlow, woff );
-            if( fDebug == 2 )
-            {
-                cout << "DEBUG WOFF INTER 1 ";
-                cout << woff << " " << fTableZeOffset[ize_low][iwoff_low] << " " << fTableZeOffset[ize_low][iwoff_up];
-                cout << " " << ize_low << " " << s_ZlowWlow->mscl << " " << s_ZlowWup->mscl << " " << s_Zlow->mscl << endl;
+                if( !prepareEvent( iReader, bFirst ) )
+                {
+                    continue;
+                }
+                iChunk->fEvent[iChunk->fN] = iReader->getEventData();
+                iChunk->fReadStatus[iChunk->fN] = i_NE;
+                iChunk->fN++;
             }
+            iReadQueue.push( iChunk );
+        }
+        iReadQueue.close();
+    } );
 
-            ///////////////////////////
-            // ZENITH (up)
-            for( int t = 0; t < fNTel; t++ )
-            {
-                // get zenith angle (up)
-                getIndexBoundary( &ize_up, &ize_low, fTableZe, ze );
-                // get direction offset index
-                getIndexBoundary( &iwoff_up, &iwoff_low, fTableZeOffset[ize_up], woff );
-                // noise (not interpolated; closest value)
-                i_noise_bin = getNoiseBin( ize_up, iwoff_up, i_az_bin, t, fNoiseLevel[t] );
-                getTables( i_noise_bin, ize_up, iwoff_up, i_az_bin, t, s_ZupWup );
-                i_noise_bin = getNoiseBin( ize_up, iwoff_low, i_az_bin, t, fNoiseLevel[t] );
-                getTables( i_noise_bin, ize_up, iwoff_low, i_az_bin, t, s_ZupWlow );
-            }
-            calculateMSFromTables( s_ZupWup, esys );
-            calculateMSFromTables( s_ZupWlow, esys );
-            // results in estimation of s_Zup
-            interpolate( s_ZupWlow, fTableZeOffset[ize_up][iwoff_low], s_ZupWup, fTableZeOffset[ize_up][iwoff_up], s_Zup, woff );
-            if( fDebug == 2 )
+    ////////////////////////////////////////////////
+    // writer thread
+    thread iWriterThread( [&]()
+    {
+        sTableLookupEventChunk* iChunk = 0;
+        while( ( iChunk = iWriteQueue.pop() ) )
+        {
+            for( unsigned int i = 0; i < iChunk->fN; i++ )
             {
-                cout << "DEBUG  WOFF INTER 2 ";
-                cout << woff << " " << fTableZeOffset[ize_up][iwoff_low] << " ";
-                cout << fTableZeOffset[ize_up][iwoff_up] << " " << ize_up;
-                cout << " " << s_ZupWlow->mscl << " " << s_ZupWup->mscl << " " << s_Zup->mscl << endl;
+                if( iChunk->fFill[i] )
+                {
+                    fData->setEventData( iChunk->fEvent[i] );
+                    fData->fill();
+                }
             }
-            // interpolate zenith angles
-            interpolate( s_Zlow, fTableZe[ize_low], s_Zup, fTableZe[ize_up], s_N, ze, true );
-            if( fDebug == 2 )
+            iFreeQueue.push( iChunk );
+        }
+        iFreeQueue.close();
+    } );
+
+    ////////////////////////////////////////////////
+    // reconstruction and table lookup
+    VThreadPool iPool( iNThreads );
+    sTableLookupEventChunk* iChunk = 0;
+    while( ( iChunk = iReadQueue.pop() ) )
+    {
+        // tables used in this chunk are kept in memory
+        if( fTableCache )
+        {
+            fTableCache->nextEvent();
+        }
+        if( fTableInterpolationCache )
+        {
+            fTableInterpolationCache->nextEvent();
+        }
+        unsigned int iStep = ( iChunk->fN + iNTasks - 1 ) / iNTasks;
+        iPool.run( iNTasks, [&]( unsigned int iTask )
+        {
+            VTableLookup* iW = 0;
             {
-                cout << "DEBUG  ZE INTER 1 " << ze << " " << fTableZe[ize_low] << " ";
-                cout << fTableZe[ize_up] << " ";
-                cout << " " << s_Zlow->mscl << " " << s_Zup->mscl << endl;
+                unique_lock< mutex > iLock( iWorkerMutex );
+                iW = iFreeWorker.back();
+                iFreeWorker.pop_back();
             }
-
-            // determine number of telescopes with MSCW values
-            for( unsigned int j = 0; j < s_N->fNTel; j++ )
+            for( unsigned int i = iTask * iStep; i < ( iTask + 1 ) * iStep && i < iChunk->fN; i++ )
             {
-                if( s_N->mscw_T[j] > -90. )
+                iW->fData->setEventData( iChunk->fEvent[i] );
+                if( iChunk->fReadStatus[i] > 0 )
                 {
-                    fnmscw++;
+                    iW->fData->reconstructEvent();
                 }
+                iChunk->fFill[i] = iW->analyzeEvent();
+                iChunk->fEvent[i] = iW->fData->getEventData();
             }
-            fData->setNMSCW( fnmscw );
-            // set msc value (mean reduced scaled variables)
-            // Note change of interpolation approach with v492.0
-            // fData->setMSCW( s_N->mscw );
-            fData->setMSCW( VMeanScaledVariables::mean_reduced_scaled_variable( s_N->fNTel, fData->getWidth(), s_N->mscw_T, s_N->mscw_Tsigma ) );
-            // fData->setMSCL( s_N->mscl );
-            fData->setMSCL( VMeanScaledVariables::mean_reduced_scaled_variable( s_N->fNTel, fData->getLength(), s_N->mscl_T, s_N->mscl_Tsigma ) );
-
-            fData->setMWR( VMeanScaledVariables::mean_scaled_variable(
-                               s_N->fNTel, fData->getSize( fTLRunParameter->fUseEvndispSelectedImagesOnly ),
-                               fData->getWidth(), s_N->mscw_T ) );
-            fData->setMLR( VMeanScaledVariables::mean_scaled_variable(
-                               s_N->fNTel, fData->getSize( fTLRunParameter->fUseEvndispSelectedImagesOnly ),
-                               fData->getLength(), s_N->mscl_T ) );
-
-            // set energy values
-            fData->setEnergy( s_N->energySR, true );
-            fData->setChi2( s_N->energySR_Chi2, true );
-            fData->setdE( s_N->energySR_dE, true );
-            // set mean reduced scaled widths and energies per telescope
-            for( unsigned int j = 0; j < s_N->fNTel; j++ )
+            unique_lock< mutex > iLock( iWorkerMutex );
+            iFreeWorker.push_back( iW );
+        } );
+        iWriteQueue.push( iChunk );
+    }
+    iWriteQueue.close();
+
+    iReaderThread.join();
+    iWriterThread.join();
+
+    // cut statistics
+    fData->addCutStatistics( iReader );
+    for( unsigned int i = 0; i < iWorker.size(); i++ )
+    {
+        fData->addCutStatistics( iWorker[i]->fData );
+        delete iWorker[i]->fData;
+        delete iWorker[i];
+    }
+    delete iReader;
+    for( unsigned int i = 0; i < iChunks.size(); i++ )
+    {
+        delete iChunks[i];
+    }
+    delete fTableMutex;
+    fTableMutex = 0;
+}
+
+/*
+ * copy of this class for table lookup in a worker thread
+ *
+ * tables and table caches are shared; iData is the data handler used
+ * by the copy
+ */
+VTableLookup* VTableLookup::clone( VTableLookupDataHandler* iData )
+{
+    VTableLookup* iT = new VTableLookup( *this );
+    iT->fData = iData;
+    iT->f_calc_msc = new VTableCalculator( fNTel );
+    iT->f_calc_msc->setMinRequiredShowerPerBin( fTLRunParameter->fMinRequiredShowerPerBin );
+    iT->f_calc_energySR = new VTableCalculator( fNTel, true );
+    iT->f_calc_energySR->setMinRequiredShowerPerBin( fTLRunParameter->fMinRequiredShowerPerBin );
+    iT->initializeTablesToRead();
+    return iT;
+}
+
+/*
+ * tables for interpolation in zenith angle and wobble offset
+ */
+void VTableLookup::initializeTablesToRead()
+{
+    fTables_ZupWup    = new VTablesToRead( fNTel );
+    fTables_ZupWlow   = new VTablesToRead( fNTel );
+    fTables_Zup       = new VTablesToRead( fNTel );
+    fTables_ZlowWup   = new VTablesToRead( fNTel );
+    fTables_ZlowWlow  = new VTablesToRead( fNTel );
+    fTables_Zlow      = new VTablesToRead( fNTel );
+    fTables_N         = new VTablesToRead( fNTel );
+}
+
+/*
+ * progress printout, ignored events, MC histograms
+ *
+ * returns false if event should be ignored
+ */
+bool VTableLookup::prepareEvent( VTableLookupDataHandler* iData, bool& bFirst )
+{
+    // print progress
+    int fevent = iData->getEventCounter();
+    if( ( fevent % 1000000 ) == 0 )
+    {
+        cout << "\t now at event " << fevent << endl;
+    }
+
+    // eventdisplay is saying that his event should be ignored
+    if( iData->getEventNumber() == 99999999 )
+    {
+        fNumberOfIgnoredEvents++;
+        return false;
+    }
+
+    // get zenith angle for first valid MC event from MC files
+    if( bFirst && iData->getMCEnergy() > 0.001
+            && fTLRunParameter->ze < 0. )
+    {
+        cout << "\t\t setting IRF ze from first event" << endl;
+        if( fNTel > 0 )
+        {
+            fTLRunParameter->ze = TMath::Floor( ( 90. - iData->getTelElevation() ) + 0.5 );
+        }
+        else
+        {
+            fTLRunParameter->ze = TMath::Floor( iData->getMCZe() + 0.5 );
+        }
+        if( fTLRunParameter->ze < 1.5 )
+        {
+            fTLRunParameter->ze = 0.;
+        }
+        fTLRunParameter->fWobbleOffset = ( int )( iData->getMCWobbleOffset() * 100. );
+        bFirst = false;
+    }
+    // fill MC energy spectra
+    iData->fillMChistograms();
+
+    return true;
+}
+
+/*
+ * table lookup for the current event: mean scaled variables and energies
+ *
+ * returns true if event should be filled into the output tree
+ */
+bool VTableLookup::analyzeEvent()
+{
+    unsigned int i_az_bin = 0;
+
+    double esys = 0.;
+    double ze = 0.;
+    double woff = 0.;
+
+    // lookup table index for interpolation
+    unsigned int ize_up = 0;
+    unsigned int ize_low = 0;
+    unsigned int iwoff_up = 0;
+    unsigned int iwoff_low = 0;
+
+    // reset image counter
+    fnmscw = 0;
+    unsigned int i_noise_bin = 0;
+    // if data fails basic cuts, write default values directly to tree
+    if( !fData->cut() )
+    {
+        if( fWriteNoTriggerEvent )
+        {
+            fData->reset();
+            return true;
+        }
+        return false;
+    }
+    //////////////////////////////////////
+    // here we should have good data only
+    // (ze, az, and wobble offset have been
+    //  tested)
+    //////////////////////////////////////
+
+    // get direction angles for this event
+    ze = fData->getZe();
+    woff = fData->getWobbleOffset();
+    i_az_bin = getAzBin( fData->getAz() );
+    // get noise level for this event
+    readNoiseLevel( false );
+
+    if( fDebug == 2 )
+    {
+        cout << endl << endl << "DEBUG  NEW EVENT " << fData->getEventCounter() << endl;
+    }
+    /////////////////////////////
+    // interpolated tables from cache
+    // (one lookup per telescope)
+    if( fTableInterpolationCache && getInterpolatedTables( ze, woff, i_az_bin, fTables_N ) )
+    {
+        calculateMSFromTables( fTables_N, esys );
+    }
+    else
+    {
+        /////////////////////////////
+        // ZENITH (low)
+        if( fDebug == 2 )
+        {
+            cout << "DEBUG ZENITH LOW" << endl;
+        }
+        for( int t = 0; t < fNTel; t++ )
+        {
+            if( fDebug == 2 )
             {
-                fData->setMSCWT( j, ( float )s_N->mscw_T[j], ( float )s_N->mscw_Tsigma[j] );
-                fData->setMSCLT( j, ( float )s_N->mscl_T[j], ( float )s_N->mscl_Tsigma[j] );
-                fData->setEnergyT( j, ( float )s_N->energySR_T[j], true );
+                cout << "DEBUG  TELESCOPE " << t << " (T" << t + 1 << ")" << endl;
+                cout << "DEBUG      zenith " << ze << ", noise " << fNoiseLevel[t] << ", woff " << woff << ", az " << fData->getAz() << ", az bin " << i_az_bin << endl;
             }
+            // get zenith angle (low)
+            getIndexBoundary( &ize_up, &ize_low, fTableZe, ze );
+            // get direction offset index
+            getIndexBoundary( &iwoff_up, &iwoff_low, fTableZeOffset[ize_low], woff );
+            // get noise bin (not interpolated; closest value)
+            i_noise_bin = getNoiseBin( ize_low, iwoff_up, i_az_bin, t, fNoiseLevel[t] );
+            getTables( i_noise_bin, ize_low, iwoff_up, i_az_bin, t, fTables_ZlowWup );
+            i_noise_bin = getNoiseBin( ize_low, iwoff_low, i_az_bin, t, fNoiseLevel[t] );
+            getTables( i_noise_bin, ize_low, iwoff_low, i_az_bin, t, fTables_ZlowWlow );
+        }
+        calculateMSFromTables( fTables_ZlowWup, esys );
+        calculateMSFromTables( fTables_ZlowWlow, esys );
+        // results in estimation of fTables_Zlow
+        interpolate( fTables_ZlowWlow, fTableZeOffset[ize_low][iwoff_low], fTables_ZlowWup, fTableZeOffset[ize_low][iwoff_up], fTables_Zlow, woff );
+        if( fDebug == 2 )
+        {
+            cout << "DEBUG WOFF INTER 1 ";
+            cout << woff << " " << fTableZeOffset[ize_low][iwoff_low] << " " << fTableZeOffset[ize_low][iwoff_up];
+            cout << " " << ize_low << " " << fTables_ZlowWlow->mscl << " " << fTables_ZlowWup->mscl << " " << fTables_Zlow->mscl << endl;
+        }
 
-            fData->fill();
+        ///////////////////////////
+        // ZENITH (up)
+        for( int t = 0; t < fNTel; t++ )
+        {
+            // get zenith angle (up)
+            getIndexBoundary( &ize_up, &ize_low, fTableZe, ze );
+            // get direction offset index
+            getIndexBoundary( &iwoff_up, &iwoff_low, fTableZeOffset[ize_up], woff );
+            // noise (not interpolated; closest value)
+            i_noise_bin = getNoiseBin( ize_up, iwoff_up, i_az_bin, t, fNoiseLevel[t] );
+            getTables( i_noise_bin, ize_up, iwoff_up, i_az_bin, t, fTables_ZupWup );
+            i_noise_bin = getNoiseBin( ize_up, iwoff_low, i_az_bin, t, fNoiseLevel[t] );
+            getTables( i_noise_bin, ize_up, iwoff_low, i_az_bin, t, fTables_ZupWlow );
+        }
+        calculateMSFromTables( fTables_ZupWup, esys );
+        calculateMSFromTables( fTables_ZupWlow, esys );
+        // results in estimation of fTables_Zup
+        interpolate( fTables_ZupWlow, fTableZeOffset[ize_up][iwoff_low], fTables_ZupWup, fTableZeOffset[ize_up][iwoff_up], fTables_Zup, woff );
+        if( fDebug == 2 )
+        {
+            cout << "DEBUG  WOFF INTER 2 ";
+            cout << woff << " " << fTableZeOffset[ize_up][iwoff_low] << " ";
+            cout << fTableZeOffset[ize_up][iwoff_up] << " " << ize_up;
+            cout << " " << fTables_ZupWlow->mscl << " " << fTables_ZupWup->mscl << " " << fTables_Zup->mscl << endl;
+        }
+        // interpolate zenith angles
+        interpolate( fTables_Zlow, fTableZe[ize_low], fTables_Zup, fTableZe[ize_up], fTables_N, ze, true );
+        if( fDebug == 2 )
+        {
+            cout << "DEBUG  ZE INTER 1 " << ze << " " << fTableZe[ize_low] << " ";
+            cout << fTableZe[ize_up] << " ";
+            cout << " " << fTables_Zlow->mscl << " " << fTables_Zup->mscl << endl;
+        }
+    }
+
+    // determine number of telescopes with MSCW values
+    for( unsigned int j = 0; j < fTables_N->fNTel; j++ )
+    {
+        if( fTables_N->mscw_T[j] > -90. )
+        {
+            fnmscw++;
         }
-        fevent++;
     }
+    fData->setNMSCW( fnmscw );
+    // set msc value (mean reduced scaled variables)
+    // Note change of interpolation approach with v492.0
+    // fData->setMSCW( fTables_N->mscw );
+    fData->setMSCW( VMeanScaledVariables::mean_reduced_scaled_variable( fTables_N->fNTel, fData->getWidth(), fTables_N->mscw_T, fTables_N->mscw_Tsigma ) );
+    // fData->setMSCL( fTables_N->mscl );
+    fData->setMSCL( VMeanScaledVariables::mean_reduced_scaled_variable( fTables_N->fNTel, fData->getLength(), fTables_N->mscl_T, fTables_N->mscl_Tsigma ) );
+
+    fData->setMWR( VMeanScaledVariables::mean_scaled_variable(
+                       fTables_N->fNTel, fData->getSize( fTLRunParameter->fUseEvndispSelectedImagesOnly ),
+                       fData->getWidth(), fTables_N->mscw_T ) );
+    fData->setMLR( VMeanScaledVariables::mean_scaled_variable(
+                       fTables_N->fNTel, fData->getSize( fTLRunParameter->fUseEvndispSelectedImagesOnly ),
+                       fData->getLength(), fTables_N->mscl_T ) );
+
+    // set energy values
+    fData->setEnergy( fTables_N->energySR, true );
+    fData->setChi2( fTables_N->energySR_Chi2, true );
+    fData->setdE( fTables_N->energySR_dE, true );
+    // set mean reduced scaled widths and energies per telescope
+    for( unsigned int j = 0; j < fTables_N->fNTel; j++ )
+    {
+        fData->setMSCWT( j, ( float )fTables_N->mscw_T[j], ( float )fTables_N->mscw_Tsigma[j] );
+        fData->setMSCLT( j, ( float )fTables_N->mscl_T[j], ( float )fTables_N->mscl_Tsigma[j] );
+        fData->setEnergyT( j, ( float )fTables_N->energySR_T[j], true );
+    }
+
+    return true;
 }
 
 
@@ -881,6 +1344,14 @@ void VTableLookup::terminate()
         {
             cout << endl << "\t total number of ignored events: " << fNumberOfIgnoredEvents << endl;
         }
+        if( fTableCache )
+        {
+            fTableCache->printSummary();
+        }
+        if( fTableInterpolationCache )
+        {
+            fTableInterpolationCache->printSummary();
+        }
     }
 
     ////////////////////////////////////////////////////////////////////
@@ -892,10 +1363,14 @@ void VTableLookup::terminate()
         cout << "closing file..." << endl;
         fLookupTableFile->Close();
     }
-    else
+    else if( fLookupTableFile )
     {
         gROOT->GetListOfFiles()->Remove( fLookupTableFile );
     }
+    if( fLookupTableBinaryFile )
+    {
+        fLookupTableBinaryFile->close();
+    }
 
     cout << "exiting..." << endl;
 }
@@ -992,62 +1467,6 @@ bool VTableLookup::setInputFiles( vector< string > iInputFiles )
     return bMC;
 }
 
-/*
-      read list of directories from table file
-
-      sort them to make sure that they are always in the same sequence
-
-*/
-vector< string > VTableLookup::getSortedListOfDirectories( TDirectory* iDir )
-{
-    vector< string > iDName;
-
-    if( !iDir )
-    {
-        return iDName;
-    }
-
-    bool bWoffAltered = false;
-
-    TList* iKeyList = iDir->GetListOfKeys();
-    if( iKeyList )
-    {
-        TIter next( iKeyList );
-        while( TNamed* iK = ( TNamed* )next() )
-        {
-            string i_dir_name = iK->GetName();
-            if( i_dir_name.find( "log" ) != string::npos
-                    || i_dir_name.find( "Log" ) != string::npos
-                    || i_dir_name.find( "List" ) != string::npos )
-            {
-                continue;
-            }
-            iDName.push_back( i_dir_name );
-            if( iDName.back().substr( 0, 4 ) == "woff" && iDName.back().size() == 8 )
-            {
-                iDName.back() = "woff_0" + iDName.back().substr( 5, iDName.back().size() );
-                bWoffAltered = true;
-            }
-        }
-    }
-
-    sort( iDName.begin(), iDName.end() );
-
-    if( bWoffAltered )
-    {
-        for( unsigned int i = 0; i < iDName.size(); i++ )
-        {
-            if( iDName[i].substr( 0, 6 ) == "woff_0" )
-            {
-                iDName[i] = "woff_" + iDName[i].substr( 6, iDName[i].size() );
-            }
-        }
-    }
-
-    return iDName;
-}
-
-
 /*
 
      read pedvar values for this event
@@ -1100,15 +1519,21 @@ void VTableLookup::readNoiseLevel( bool bWriteToRunPara )
             if( TMath::Abs( fNoiseLevel[i] ) < 1.e-2 && fData->getNtubes()[i] > 0 )
             {
                 fTelToAnalyze[i] = false;
-                if( fNNoiseLevelWarnings < 30 )
+                // (multi-threaded event loop: one counter for all threads)
+                unique_lock< mutex > iLock;
+                if( fTableMutex )
+                {
+                    iLock = unique_lock< mutex >( *fTableMutex );
+                }
+                if( *fNNoiseLevelWarningsCounter < 30 )
                 {
                     cout << "WARNING: noise level for telescope " << i + 1 << " very low: " << fNoiseLevel[i] << " (" << !bWriteToRunPara << ")" << endl;
                 }
-                else if( fNNoiseLevelWarnings == 30 )
+                else if( *fNNoiseLevelWarningsCounter == 30 )
                 {
                     cout << "----------- more than 30 noise level warnings, stop printing...--------------" << endl;
                 }
-                fNNoiseLevelWarnings++;
+                ( *fNNoiseLevelWarningsCounter )++;
             }
             else if( TMath::Abs( fNoiseLevel[i] ) < 1.e-2 && fData->getNtubes()[i] < 1 )
             {
@@ -1177,16 +1602,14 @@ void VTableLookup::getTables( unsigned int inoise, unsigned int ize,
     {
         return;
     }
-
-    unsigned int telX = 0;
-    for( unsigned int i = 0; i < fTelType_tables[ize][iwoff][iaz].size(); i++ )
+    // tables might be read from file (multi-threaded event loop: one thread at a time)
+    unique_lock< mutex > iLock;
+    if( fTableMutex )
     {
-        if( fData->getTelType( tel ) == fTelType_tables[ize][iwoff][iaz][i] )
-        {
-            telX = i;
-            break;
-        }
+        iLock = unique_lock< mutex >( *fTableMutex );
     }
+
+    unsigned int telX = getTelTypeIndex( ize, iwoff, iaz, tel );
     if( telX == 999999 )
     {
         cout << "VTableLookup::getTables invalid telescope type: " << tel << "\t" << telX << endl;
@@ -1240,9 +1663,150 @@ void VTableLookup::getTables( unsigned int inoise, unsigned int ize,
         cout << "DEBUG  MEDIAN (MSCL,2) " << fmscl.size() << endl;
     }
 
-    s->hmscwMedian[tel] = fmscw[ize][iwoff][iaz][telX][inoise]->getHistoMedian();
-    s->hmsclMedian[tel] = fmscl[ize][iwoff][iaz][telX][inoise]->getHistoMedian();
-    s->henergySRMedian[tel] = fenergySizevsRadius[ize][iwoff][iaz][telX][inoise]->getHistoMedian();
+    if( fTableCache )
+    {
+        s->hmscwMedian[tel] = fTableCache->getHistoMedian( fmscw[ize][iwoff][iaz][telX][inoise] );
+        s->hmsclMedian[tel] = fTableCache->getHistoMedian( fmscl[ize][iwoff][iaz][telX][inoise] );
+        s->henergySRMedian[tel] = fTableCache->getHistoMedian( fenergySizevsRadius[ize][iwoff][iaz][telX][inoise] );
+    }
+    else
+    {
+        s->hmscwMedian[tel] = fmscw[ize][iwoff][iaz][telX][inoise]->getHistoMedian();
+        s->hmsclMedian[tel] = fmscl[ize][iwoff][iaz][telX][inoise]->getHistoMedian();
+        s->henergySRMedian[tel] = fenergySizevsRadius[ize][iwoff][iaz][telX][inoise]->getHistoMedian();
+    }
+    s->gmscwMedian[tel] = fmscw[ize][iwoff][iaz][telX][inoise]->getGrid();
+    s->gmsclMedian[tel] = fmscl[ize][iwoff][iaz][telX][inoise]->getGrid();
+    s->genergySRMedian[tel] = fenergySizevsRadius[ize][iwoff][iaz][telX][inoise]->getGrid();
+}
+
+
+/*
+    index of telescope type in table vectors
+*/
+unsigned int VTableLookup::getTelTypeIndex( unsigned int ize, unsigned int iwoff, unsigned int iaz, unsigned int tel )
+{
+    unsigned int telX = 0;
+    for( unsigned int i = 0; i < fTelType_tables[ize][iwoff][iaz].size(); i++ )
+    {
+        if( fData->getTelType( tel ) == fTelType_tables[ize][iwoff][iaz][i] )
+        {
+            telX = i;
+            break;
+        }
+    }
+    return telX;
+}
+
+
+/*
+    table as grid
+
+    tables read from ROOT files are read (through the table cache) if necessary
+*/
+VTableLookupGrid* VTableLookup::getGrid( VTableCalculator* t )
+{
+    if( !t )
+    {
+        return 0;
+    }
+    if( !t->isBinaryTable() )
+    {
+        if( fTableCache )
+        {
+            fTableCache->getHistoMedian( t );
+        }
+        else
+        {
+            t->getHistoMedian();
+        }
+    }
+    return t->getGrid();
+}
+
+
+/*
+    get tables interpolated in wobble offset and zenith angle for all telescopes
+    (see VTableInterpolationCache)
+
+    zenith angle and wobble offset are quantized; tables of the four corners
+    (zenith low/up, wobble offset low/up) are interpolated only once for each
+    set of quantized values, azimuth bin, telescope type and noise bins
+
+    returns false if tables can't be interpolated (e.g. different binning)
+*/
+bool VTableLookup::getInterpolatedTables( double ze, double woff, unsigned int iaz, VTablesToRead* s )
+{
+    if( !fTableInterpolationCache || !s )
+    {
+        return false;
+    }
+    unique_lock< mutex > iLock;
+    if( fTableMutex )
+    {
+        iLock = unique_lock< mutex >( *fTableMutex );
+    }
+    sTableInterpolationKey iKey;
+    iKey.ze = fTableInterpolationCache->getQuantizedZe( ze );
+    iKey.woff = fTableInterpolationCache->getQuantizedWoff( woff );
+    iKey.az = iaz;
+    double ze_q = fTableInterpolationCache->getZe( iKey.ze );
+    double woff_q = fTableInterpolationCache->getWoff( iKey.woff );
+
+    // corners: ze low/woff low, ze low/woff up, ze up/woff low, ze up/woff up
+    unsigned int ize_up = 0;
+    unsigned int ize_low = 0;
+    getIndexBoundary( &ize_up, &ize_low, fTableZe, ze_q );
+    unsigned int iwoff_up = 0;
+    unsigned int iwoff_low = 0;
+    unsigned int c_ze[4] = { ize_low, ize_low, ize_up, ize_up };
+    unsigned int c_woff[4];
+    getIndexBoundary( &iwoff_up, &iwoff_low, fTableZeOffset[ize_low], woff_q );
+    c_woff[0] = iwoff_low;
+    c_woff[1] = iwoff_up;
+    getIndexBoundary( &iwoff_up, &iwoff_low, fTableZeOffset[ize_up], woff_q );
+    c_woff[2] = iwoff_low;
+    c_woff[3] = iwoff_up;
+    double woff_corner[4];
+    for( unsigned int c = 0; c < 4; c++ )
+    {
+        woff_corner[c] = fTableZeOffset[c_ze[c]][c_woff[c]];
+    }
+
+    for( int t = 0; t < fNTel; t++ )
+    {
+        unsigned int telX[4];
+        iKey.telType = fData->getTelType( t );
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            telX[c] = getTelTypeIndex( c_ze[c], c_woff[c], iaz, t );
+            iKey.noise[c] = getNoiseBin( c_ze[c], c_woff[c], iaz, t, fNoiseLevel[t] );
+        }
+        vector< VTableLookupGrid* >* iG = fTableInterpolationCache->get( iKey );
+        if( !iG )
+        {
+            vector< vector< VTableLookupGrid* > > iCornerGrids( VTableInterpolationCache::fNTableTypes, vector< VTableLookupGrid* >( 4, ( VTableLookupGrid* )0 ) );
+            for( unsigned int c = 0; c < 4; c++ )
+            {
+                iCornerGrids[0][c] = getGrid( fmscw[c_ze[c]][c_woff[c]][iaz][telX[c]][iKey.noise[c]] );
+                iCornerGrids[1][c] = getGrid( fmscl[c_ze[c]][c_woff[c]][iaz][telX[c]][iKey.noise[c]] );
+                iCornerGrids[2][c] = getGrid( fenergySizevsRadius[c_ze[c]][c_woff[c]][iaz][telX[c]][iKey.noise[c]] );
+            }
+            iG = fTableInterpolationCache->add( iKey, iCornerGrids, woff_corner, fTableZe[ize_low], fTableZe[ize_up], woff_q, ze_q );
+        }
+        if( !iG || !( *iG )[0] || !( *iG )[1] || !( *iG )[2] )
+        {
+            return false;
+        }
+        s->hmscwMedian[t] = 0;
+        s->hmsclMedian[t] = 0;
+        s->henergySRMedian[t] = 0;
+        s->gmscwMedian[t] = ( *iG )[0];
+        s->gmsclMedian[t] = ( *iG )[1];
+        s->genergySRMedian[t] = ( *iG )[2];
+    }
+
+    return true;
 }
 
 
@@ -1268,12 +1832,14 @@ void VTableLookup::calculateMSFromTables( VTablesToRead* s, double esys )
     f_calc_msc->setCalculateEnergies( false );
     ///////////////////
     // calculate mscw
+    f_calc_msc->setVGrids( s->gmscwMedian );
     f_calc_msc->setVHistograms( s->hmscwMedian );
     s->mscw = f_calc_msc->calc( ( int )fData->getNTel(), fData->getDistanceToCore(),
                                 i_s, fData->getWidth(),
                                 s->mscw_T, i_dummy, i_dummy, s->mscw_Tsigma );
     ///////////////////
     // calculate mscl
+    f_calc_msc->setVGrids( s->gmsclMedian );
     f_calc_msc->setVHistograms( s->hmsclMedian );
     s->mscl = f_calc_msc->calc( ( int )fData->getNTel(), fData->getDistanceToCore(),
                                 i_s, fData->getLength(),
@@ -1281,6 +1847,7 @@ void VTableLookup::calculateMSFromTables( VTablesToRead* s, double esys )
     ///////////////////
     // calculate energy (method 1)
     f_calc_energySR->setCalculateEnergies( true );
+    f_calc_energySR->setVGrids( s->genergySRMedian );
     f_calc_energySR->setVHistograms( s->henergySRMedian );
     s->energySR = f_calc_energySR->calc( ( int )fData->getNTel(), fData->getDistanceToCore(),
                                          i_s, 0,
@@ -1352,6 +1919,11 @@ bool VTableLookup::initialize( VTableLookupRunParameter* iTLRunParameter )
         readNoiseLevel( true );
         // read tables from disk
         setMCTableFiles( fTLRunParameter->tablefile, "tb", fTLRunParameter->fInterpolateString );
+        // interpolated tables are cached per run
+        if( fTLRunParameter->fUseTableInterpolationCache )
+        {
+            fTableInterpolationCache = new VTableInterpolationCache( 0.1, 0.01, fTLRunParameter->fTableInterpolationCacheSize );
+        }
         // set output files
         setOutputFile( fTLRunParameter->outputfile, fTLRunParameter->writeoption, fTLRunParameter->tablefile );
     }
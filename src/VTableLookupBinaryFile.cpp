@@ -0,0 +1,420 @@
+/*! \class VTableLookupBinaryFile
+    \brief flat binary lookup table file
+
+    All lookup tables (median and sigma grids) of a ROOT table file are stored
+    as contiguous float arrays with an axis descriptor and a table index.
+    For reading, the file is memory mapped: no tables are copied, and all
+    mscw_energy jobs on a node share the same pages of the page cache.
+
+    Conversion of a ROOT table file:
+
+       VTableLookupBinaryFile::convert( TFile*, "tables.bin" );
+
+    (see also combineLookupTables)
+
+*/
+
+#include "VTableLookupBinaryFile.h"
+
+const uint32_t VTableLookupBinaryFile::fMagic;
+const uint32_t VTableLookupBinaryFile::fVersion;
+const uint32_t VTableLookupBinaryFile::fType_mscw;
+const uint32_t VTableLookupBinaryFile::fType_mscl;
+const uint32_t VTableLookupBinaryFile::fType_energySR;
+const uint32_t VTableLookupBinaryFile::fType_energySR_mpv;
+
+VTableLookupBinaryFile::VTableLookupBinaryFile()
+{
+    fFileDescriptor = -1;
+    fMap = 0;
+    fMapSize = 0;
+    fHeader = 0;
+    fIndex = 0;
+}
+
+
+VTableLookupBinaryFile::~VTableLookupBinaryFile()
+{
+    close();
+}
+
+
+void VTableLookupBinaryFile::close()
+{
+    if( fMap )
+    {
+        munmap( fMap, fMapSize );
+    }
+    if( fFileDescriptor >= 0 )
+    {
+        ::close( fFileDescriptor );
+    }
+    fFileDescriptor = -1;
+    fMap = 0;
+    fMapSize = 0;
+    fHeader = 0;
+    fIndex = 0;
+}
+
+
+/*
+ * check magic number of a file
+ */
+bool VTableLookupBinaryFile::isBinaryTableFile( string iFile )
+{
+    ifstream is( iFile.c_str(), ios::binary );
+    if( !is )
+    {
+        return false;
+    }
+    uint32_t iMagic = 0;
+    is.read( ( char* )&iMagic, sizeof( iMagic ) );
+    return ( is.good() && iMagic == fMagic );
+}
+
+
+/*
+ * open and memory map a binary table file
+ */
+bool VTableLookupBinaryFile::open( string iFile )
+{
+    close();
+    fFileName = iFile;
+
+    fFileDescriptor = ::open( iFile.c_str(), O_RDONLY );
+    if( fFileDescriptor < 0 )
+    {
+        cout << "VTableLookupBinaryFile::open error: unable to open table file " << iFile << endl;
+        return false;
+    }
+    struct stat iStat;
+    if( fstat( fFileDescriptor, &iStat ) != 0 || ( size_t )iStat.st_size < sizeof( sTableFileHeader ) )
+    {
+        cout << "VTableLookupBinaryFile::open error: invalid table file " << iFile << endl;
+        close();
+        return false;
+    }
+    fMapSize = ( size_t )iStat.st_size;
+    void* iMap = mmap( 0, fMapSize, PROT_READ, MAP_SHARED, fFileDescriptor, 0 );
+    if( iMap == MAP_FAILED )
+    {
+        cout << "VTableLookupBinaryFile::open error: unable to map table file " << iFile << endl;
+        fMapSize = 0;
+        close();
+        return false;
+    }
+    fMap = ( char* )iMap;
+    fHeader = ( const sTableFileHeader* )fMap;
+    if( fHeader->fMagic != fMagic || fHeader->fVersion != fVersion || fHeader->fFileSize != fMapSize
+            || fHeader->fIndexOffset + fHeader->fNTables * sizeof( sTableEntry ) > fMapSize )
+    {
+        cout << "VTableLookupBinaryFile::open error: invalid or incompatible table file " << iFile;
+        cout << " (version " << fHeader->fVersion << ", expected " << fVersion << ")" << endl;
+        close();
+        return false;
+    }
+    fIndex = ( const sTableEntry* )( fMap + fHeader->fIndexOffset );
+
+    return true;
+}
+
+
+/*
+ * grid pointing into the memory mapped file
+ * (owned by the caller; valid as long as the file is open)
+ */
+VTableLookupGrid* VTableLookupBinaryFile::getGrid( unsigned int iTable )
+{
+    const sTableEntry* e = getTableEntry( iTable );
+    if( !e )
+    {
+        return 0;
+    }
+    uint64_t n = ( uint64_t )( e->nx + 2 ) * ( e->ny + 2 );
+    uint64_t iSize = getAlignedSize( n * sizeof( float ) ) * 2;
+    if( e->bVariableX )
+    {
+        iSize += ( e->nx + 1 ) * sizeof( double );
+    }
+    if( e->bVariableY )
+    {
+        iSize += ( e->ny + 1 ) * sizeof( double );
+    }
+    if( e->fDataOffset + iSize > fMapSize )
+    {
+        cout << "VTableLookupBinaryFile::getGrid error: table " << iTable << " exceeds file size" << endl;
+        return 0;
+    }
+    VTableLookupGrid* g = new VTableLookupGrid();
+    g->fNBinsX = e->nx;
+    g->fNBinsY = e->ny;
+    g->fXmin = e->xmin;
+    g->fXmax = e->xmax;
+    g->fYmin = e->ymin;
+    g->fYmax = e->ymax;
+    const char* p = fMap + e->fDataOffset;
+    if( e->bVariableX )
+    {
+        g->fXbins = ( const double* )p;
+        p += ( e->nx + 1 ) * sizeof( double );
+    }
+    if( e->bVariableY )
+    {
+        g->fYbins = ( const double* )p;
+        p += ( e->ny + 1 ) * sizeof( double );
+    }
+    g->fContent = ( const float* )p;
+    p += getAlignedSize( n * sizeof( float ) );
+    g->fError = ( const float* )p;
+    g->initAxes();
+
+    return g;
+}
+
+
+/*
+ * write axis, contents and errors of one table
+ */
+bool VTableLookupBinaryFile::writeTable( ofstream& os, TH2F* h, sTableEntry& iEntry )
+{
+    if( !h )
+    {
+        return false;
+    }
+    iEntry.nx = h->GetNbinsX();
+    iEntry.ny = h->GetNbinsY();
+    iEntry.xmin = h->GetXaxis()->GetXmin();
+    iEntry.xmax = h->GetXaxis()->GetXmax();
+    iEntry.ymin = h->GetYaxis()->GetXmin();
+    iEntry.ymax = h->GetYaxis()->GetXmax();
+    iEntry.bVariableX = ( h->GetXaxis()->GetXbins()->GetSize() > 0 );
+    iEntry.bVariableY = ( h->GetYaxis()->GetXbins()->GetSize() > 0 );
+    iEntry.fDataOffset = ( uint64_t )os.tellp();
+
+    if( iEntry.bVariableX )
+    {
+        os.write( ( const char* )h->GetXaxis()->GetXbins()->GetArray(), ( iEntry.nx + 1 ) * sizeof( double ) );
+    }
+    if( iEntry.bVariableY )
+    {
+        os.write( ( const char* )h->GetYaxis()->GetXbins()->GetArray(), ( iEntry.ny + 1 ) * sizeof( double ) );
+    }
+    uint64_t n = ( uint64_t )( iEntry.nx + 2 ) * ( iEntry.ny + 2 );
+    vector< float > iContent( getAlignedSize( n * sizeof( float ) ) / sizeof( float ), 0. );
+    vector< float > iError( iContent.size(), 0. );
+    for( unsigned int j = 0; j < iEntry.ny + 2; j++ )
+    {
+        for( unsigned int i = 0; i < iEntry.nx + 2; i++ )
+        {
+            iContent[i + ( iEntry.nx + 2 ) * j] = h->GetBinContent( i, j );
+            iError[i + ( iEntry.nx + 2 ) * j] = h->GetBinError( i, j );
+        }
+    }
+    os.write( ( const char* )&iContent[0], iContent.size() * sizeof( float ) );
+    os.write( ( const char* )&iError[0], iError.size() * sizeof( float ) );
+
+    return os.good();
+}
+
+
+/*
+ * convert all tables of a ROOT table file
+ *
+ * expected directory structure: Ze/wobble/azimuth/telescope type/noise level
+ * (as in VTableLookup::setMCTableFiles)
+ *
+ * file is written to a temporary file and renamed at the end
+ */
+bool VTableLookupBinaryFile::convert( TDirectory* iDirZe, string iBinaryFile, string iSuffix )
+{
+    if( !iDirZe )
+    {
+        return false;
+    }
+    string iTempFile = iBinaryFile + ".tmp";
+    ofstream os( iTempFile.c_str(), ios::binary | ios::trunc );
+    if( !os )
+    {
+        cout << "VTableLookupBinaryFile::convert error: unable to open " << iTempFile << endl;
+        return false;
+    }
+    sTableFileHeader iHeader;
+    iHeader.fMagic = fMagic;
+    iHeader.fVersion = fVersion;
+    iHeader.fNTables = 0;
+    iHeader.fIndexOffset = 0;
+    iHeader.fFileSize = 0;
+    os.write( ( const char* )&iHeader, sizeof( iHeader ) );
+
+    // table types: directory and histogram name
+    vector< uint32_t > iType;
+    vector< string > iTypeDir;
+    vector< string > iTypeHisto;
+    iType.push_back( fType_mscw );
+    iTypeDir.push_back( "mscw" );
+    iTypeHisto.push_back( "width_median_" + iSuffix );
+    iType.push_back( fType_mscl );
+    iTypeDir.push_back( "mscl" );
+    iTypeHisto.push_back( "length_median_" + iSuffix );
+    iType.push_back( fType_energySR );
+    iTypeDir.push_back( "energySR" );
+    iTypeHisto.push_back( "energySR_median_" + iSuffix );
+    iType.push_back( fType_energySR_mpv );
+    iTypeDir.push_back( "energySR" );
+    iTypeHisto.push_back( "energySR_mpv_" + iSuffix );
+
+    vector< sTableEntry > iIndex;
+    unsigned int iNMissing = 0;
+
+    vector< string > iDNameZE = getSortedListOfDirectories( iDirZe );
+    for( unsigned int z = 0; z < iDNameZE.size(); z++ )
+    {
+        TDirectory* iDirWoff = ( TDirectory* )iDirZe->Get( iDNameZE[z].c_str() );
+        vector< string > iDNameWoff = getSortedListOfDirectories( iDirWoff );
+        for( unsigned int w = 0; w < iDNameWoff.size(); w++ )
+        {
+            TDirectory* iDirAz = ( TDirectory* )iDirWoff->Get( iDNameWoff[w].c_str() );
+            vector< string > iDNameAz = getSortedListOfDirectories( iDirAz );
+            for( unsigned int a = 0; a < iDNameAz.size(); a++ )
+            {
+                TDirectory* iDirTel = ( TDirectory* )iDirAz->Get( iDNameAz[a].c_str() );
+                vector< string > iDNameTel = getSortedListOfDirectories( iDirTel );
+                for( unsigned int t = 0; t < iDNameTel.size(); t++ )
+                {
+                    TDirectory* iDirNoise = ( TDirectory* )iDirTel->Get( iDNameTel[t].c_str() );
+                    vector< string > iDNameNoise = getSortedListOfDirectories( iDirNoise );
+                    for( unsigned int n = 0; n < iDNameNoise.size(); n++ )
+                    {
+                        TDirectory* iDir = ( TDirectory* )iDirNoise->Get( iDNameNoise[n].c_str() );
+                        if( !iDir )
+                        {
+                            continue;
+                        }
+                        for( unsigned int y = 0; y < iType.size(); y++ )
+                        {
+                            TDirectory* iDirType = ( TDirectory* )iDir->Get( iTypeDir[y].c_str() );
+                            TH2F* h = 0;
+                            if( iDirType )
+                            {
+                                h = ( TH2F* )iDirType->Get( iTypeHisto[y].c_str() );
+                            }
+                            if( !h )
+                            {
+                                // mpv tables are optional
+                                if( iType[y] != fType_energySR_mpv )
+                                {
+                                    iNMissing++;
+                                }
+                                continue;
+                            }
+                            sTableEntry e;
+                            e.ize = z;
+                            e.iwoff = w;
+                            e.iaz = a;
+                            e.itel = t;
+                            e.inoise = n;
+                            e.iType = iType[y];
+                            // directory names as in VTableLookup::setMCTableFiles
+                            e.ze = atof( iDNameZE[z].substr( 3, 3 ).c_str() ) / 10.;
+                            e.woff = atof( iDNameWoff[w].substr( 5, 4 ).c_str() ) / 1000.;
+                            e.noise = atof( iDNameNoise[n].substr( iDNameNoise[n].find( "_" ) + 1 ).c_str() ) / 100.;
+                            e.iPadding = 0;
+                            e.telType = ( uint64_t )atoi( iDNameTel[t].substr( 4, iDNameTel[t].size() ).c_str() );
+                            if( !writeTable( os, h, e ) )
+                            {
+                                cout << "VTableLookupBinaryFile::convert error writing table " << iDir->GetPath() << endl;
+                                os.close();
+                                remove( iTempFile.c_str() );
+                                return false;
+                            }
+                            iIndex.push_back( e );
+                            delete h;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    // table index
+    iHeader.fNTables = iIndex.size();
+    iHeader.fIndexOffset = ( uint64_t )os.tellp();
+    if( iIndex.size() > 0 )
+    {
+        os.write( ( const char* )&iIndex[0], iIndex.size() * sizeof( sTableEntry ) );
+    }
+    iHeader.fFileSize = ( uint64_t )os.tellp();
+    os.seekp( 0 );
+    os.write( ( const char* )&iHeader, sizeof( iHeader ) );
+    os.close();
+    if( !os.good() || rename( iTempFile.c_str(), iBinaryFile.c_str() ) != 0 )
+    {
+        cout << "VTableLookupBinaryFile::convert error writing " << iBinaryFile << endl;
+        remove( iTempFile.c_str() );
+        return false;
+    }
+    cout << "wrote " << iIndex.size() << " tables to " << iBinaryFile;
+    cout << " (" << iHeader.fFileSize / 1024 / 1024 << " MB)" << endl;
+    if( iNMissing > 0 )
+    {
+        cout << "VTableLookupBinaryFile::convert warning: " << iNMissing << " tables not found" << endl;
+    }
+
+    return true;
+}
+
+
+/*
+      read list of directories from table file
+
+      sort them to make sure that they are always in the same sequence
+      (used for ROOT and binary table files, see VTableLookup::setMCTableFiles)
+
+*/
+vector< string > VTableLookupBinaryFile::getSortedListOfDirectories( TDirectory* iDir )
+{
+    vector< string > iDName;
+
+    if( !iDir )
+    {
+        return iDName;
+    }
+
+    bool bWoffAltered = false;
+
+    TList* iKeyList = iDir->GetListOfKeys();
+    if( iKeyList )
+    {
+        TIter next( iKeyList );
+        while( TNamed* iK = ( TNamed* )next() )
+        {
+            string i_dir_name = iK->GetName();
+            if( i_dir_name.find( "log" ) != string::npos
+                    || i_dir_name.find( "Log" ) != string::npos
+                    || i_dir_name.find( "List" ) != string::npos )
+            {
+                continue;
+            }
+            iDName.push_back( i_dir_name );
+            if( iDName.back().substr( 0, 4 ) == "woff" && iDName.back().size() == 8 )
+            {
+                iDName.back() = "woff_0" + iDName.back().substr( 5, iDName.back().size() );
+                bWoffAltered = true;
+            }
+        }
+    }
+
+    sort( iDName.begin(), iDName.end() );
+
+    if( bWoffAltered )
+    {
+        for( unsigned int i = 0; i < iDName.size(); i++ )
+        {
+            if( iDName[i].substr( 0, 6 ) == "woff_0" )
+            {
+                iDName[i] = "woff_" + iDName[i].substr( 6, iDName[i].size() );
+            }
+        }
+    }
+
+    return iDName;
+}
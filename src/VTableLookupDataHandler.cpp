@@ -142,6 +142,19 @@ VTableLookupDataHandler::VTableLookupDataHandler( bool iwrite, VTableLookupRunPa
     fDispAnalyzerEnergy = 0;
 }
 
+/*
+ * input chains, output tree and histograms are shared with copies
+ * of this class (see clone()) and are not deleted here
+ */
+VTableLookupDataHandler::~VTableLookupDataHandler()
+{
+    delete fEmissionHeightCalculator;
+    delete fDispAnalyzerDirection;
+    delete fDispAnalyzerDirectionError;
+    delete fDispAnalyzerDirectionSign;
+    delete fDispAnalyzerEnergy;
+}
+
 /*
  * fill results of analysis into output tree
  * (called data in the mscw file)
@@ -211,13 +224,36 @@ bool VTableLookupDataHandler::getNextEvent()
     false:    end of data chain or time limit exceeded
 */
 bool VTableLookupDataHandler::getNextEvent( bool bShort )
+{
+    int i_NE = readNextEvent( bShort );
+    if( i_NE < 0 )
+    {
+        return false;
+    }
+    if( i_NE > 0 )
+    {
+        reconstructEvent();
+    }
+    return true;
+}
+
+/*!
+    read next event (without stereo and energy reconstruction)
+
+    return values:
+
+    -1:   end of data chain or time limit exceeded
+     0:   no reconstruction required (event not selected, or not valid)
+     1:   event read successfully (call reconstructEvent())
+*/
+int VTableLookupDataHandler::readNextEvent( bool bShort )
 {
     if( fEventCounter < fNEntries && fTotalTime < fMaxTotalTime )
     {
         if( !randomSelected() )
         {
             fEventCounter++;
-            return true;
+            return 0;
         }
         fEventWeight = 1.;
 
@@ -235,7 +271,7 @@ bool VTableLookupDataHandler::getNextEvent( bool bShort )
         }
         if( i_NE == -1 )
         {
-            return false;
+            return -1;
         }
         // dead time calculation
         if( !fIsMC && getEventNumber() != 999999 )
@@ -246,36 +282,128 @@ bool VTableLookupDataHandler::getNextEvent( bool bShort )
         // return false for non-valid (maybe not reconstructed?) event
         if( i_NE == 0 )
         {
-            return true;
+            resetReconstructionParameters();
+            return 0;
         }
+    }
+    else
+    {
+        return -1;
+    }
+    return 1;
+}
 
-        // calculate theta2
-        if( !fIsMC )
-        {
-            ftheta2 = ( fYoff_derot - fWobbleN ) * ( fYoff_derot - fWobbleN )
-                      + ( fXoff_derot - fWobbleE ) * ( fXoff_derot - fWobbleE );
-        }
-        else
+/*
+ * stereo reconstruction (optional), disp energy reconstruction (optional),
+ * distances and emission heights for the current event
+ *
+ * uses only event data and disp analyzers, i.e. can be called for
+ * copies of the data handler in parallel (see clone())
+ */
+void VTableLookupDataHandler::reconstructEvent()
+{
+    // no values from the previous event
+    // (multi-threaded event loop: events are reconstructed in any order)
+    resetReconstructionParameters();
+
+    //////////////////////////////////////////////////////////
+    // redo the stereo (direction and core) reconstruction
+    if( fTLRunParameter->fRerunStereoReconstruction )
+    {
+        fill_selected_images_before_redo_stereo_reconstruction();
+        fmeanPedvar_Image = calculateMeanNoiseLevel( true );
+        doStereoReconstruction( true );
+    }
+
+    // SizeSecondMax calculation
+    Double_t SizeFirstMax_temp = -1000.;
+    Double_t SizeSecondMax_temp = -100.;
+    for( int i = 0; i < fNImages; i++ )
+    {
+        unsigned int t = fImgSel_list_short[i];
+        if( fsize[t] > SizeSecondMax_temp )
         {
-            ftheta2 = ( fXoff - fMCxoff ) * ( fXoff - fMCxoff )
-                      + ( fYoff - fMCyoff ) * ( fYoff - fMCyoff );
+            if( fsize[t] > SizeFirstMax_temp )
+            {
+                SizeSecondMax_temp = SizeFirstMax_temp;
+                SizeFirstMax_temp = fsize[t];
+            }
+            else
+            {
+                SizeSecondMax_temp = fsize[t];
+            }
         }
+    }
+    if( SizeSecondMax_temp > 0. )
+    {
+        fSizeSecondMax = SizeSecondMax_temp;
+    }
 
-        // calculate distances
+    // dispEnergy - energy reconstruction using the disp MVA
+    if( fDispAnalyzerEnergy )
+    {
+        // calculate distances and emission height
         calcDistances();
-        // calculate emission height (not for writing of tables)
-        if( fNImages > 1 && !fwrite )
+        calcEmissionHeights();
+
+        fDispAnalyzerEnergy->setQualityCuts( fSSR_NImages_min, fSSR_AxesAngles_min,
+                                             fTLRunParameter->fmaxdist,
+                                             fTLRunParameter->fmaxloss,
+                                             fTLRunParameter->fminfui,
+                                             fTLRunParameter->fminwidth,
+                                             fTLRunParameter->fminfitstat,
+                                             fTLRunParameter->fminntubes );
+        fDispAnalyzerEnergy->calculateEnergies(
+            getNTel(),
+            fArrayPointing_Elevation, fArrayPointing_Azimuth,
+            fTel_type,
+            getSize( true ),
+            fcen_x, fcen_y,
+            fcosphi, fsinphi,
+            fwidth, flength,
+            fasym, ftgrad_x,
+            floss, fntubes,
+            getWeight(),
+            fXoff, fYoff,
+            getDistanceToCoreTel(),
+            fEmissionHeightMean,
+            fMCEnergy,
+            ffui, fmeanPedvar_ImageT, fFitstat );
+
+        // fill results
+        setEnergy( fDispAnalyzerEnergy->getEnergy(), false );
+        setChi2( fDispAnalyzerEnergy->getEnergyChi2(), false );
+        setdE( fDispAnalyzerEnergy->getEnergydES(), false );
+
+        for( unsigned int i = 0; i < getNTel(); i++ )
         {
-            calcEmissionHeights();
+            setEnergyT( i, fDispAnalyzerEnergy->getEnergyT( i ), false );
         }
+        setNEnergyT( fDispAnalyzerEnergy->getEnergyNT() );
+        setNEnergyQuality( fDispAnalyzerEnergy->getEnergyQualityLabel() );
+    }
 
-        setEventWeightfromMCSpectrum();
+    // calculate theta2
+    if( !fIsMC )
+    {
+        ftheta2 = ( fYoff_derot - fWobbleN ) * ( fYoff_derot - fWobbleN )
+                  + ( fXoff_derot - fWobbleE ) * ( fXoff_derot - fWobbleE );
     }
     else
     {
-        return false;
+        ftheta2 = ( fXoff - fMCxoff ) * ( fXoff - fMCxoff )
+                  + ( fYoff - fMCyoff ) * ( fYoff - fMCyoff );
     }
-    return true;
+
+    // calculate distances
+    calcDistances();
+    // calculate emission height (not for writing of tables)
+    if( fNImages > 1 && !fwrite )
+    {
+        calcEmissionHeights();
+    }
+
+    setEventWeightfromMCSpectrum();
 }
 
 /*
@@ -378,22 +506,6 @@ int VTableLookupDataHandler::fillNextEvent( bool bShort )
     fAz = fshowerpars->Az[fMethod];
     fXcore = fshowerpars->Xcore[fMethod];
     fYcore = fshowerpars->Ycore[fMethod];
-    // return if stereo reconstruction was not successful
-    // (don't do this if stereo reconstruction is
-    //  repeated)
-    if( !fTLRunParameter->fRerunStereoReconstruction
-            && ( TMath::IsNaN( fXcore ) || TMath::IsNaN( fYcore ) ) )
-    {
-        fXcore =  -999999.;
-        fYcore =  -999999.;
-        fEventCounter++;
-        fEventStatus = false;
-        if( fDebug > 1 )
-        {
-            cout << "\t RECONSTRUCTED CORE NAN" << endl;
-        }
-        return 0;
-    }
     // standard stereo reconstruction
     fXoff = fshowerpars->Xoff[fMethod];
     fYoff = fshowerpars->Yoff[fMethod];
@@ -440,6 +552,24 @@ int VTableLookupDataHandler::fillNextEvent( bool bShort )
         fYcore_SC = fshowerpars->Ycore_SC[fMethod];
         fstdP = fshowerpars->stdp[fMethod];
     }
+    // return if stereo reconstruction was not successful
+    // (don't do this if stereo reconstruction is
+    //  repeated; image parameters are not read)
+    if( !fTLRunParameter->fRerunStereoReconstruction
+            && ( TMath::IsNaN( fXcore ) || TMath::IsNaN( fYcore ) ) )
+    {
+        fXcore =  -999999.;
+        fYcore =  -999999.;
+        resetImageParameters();
+        fmeanPedvar_Image = 0.;
+        fEventCounter++;
+        fEventStatus = false;
+        if( fDebug > 1 )
+        {
+            cout << "\t RECONSTRUCTED CORE NAN" << endl;
+        }
+        return 0;
+    }
     // (ignore event status)
     fEventStatus = true;
     // (end of accessing showerpars tree)
@@ -557,83 +687,6 @@ int VTableLookupDataHandler::fillNextEvent( bool bShort )
         }
     }
     fmeanPedvar_Image = calculateMeanNoiseLevel( true );
-    //////////////////////////////////////////////////////////
-    // redo the stereo (direction and core) reconstruction
-    if( fTLRunParameter->fRerunStereoReconstruction )
-    {
-        fill_selected_images_before_redo_stereo_reconstruction();
-        fmeanPedvar_Image = calculateMeanNoiseLevel( true );
-        doStereoReconstruction( true );
-    }
-
-
-    // SizeSecondMax calculation
-    Double_t SizeFirstMax_temp = -1000.;
-    Double_t SizeSecondMax_temp = -100.;
-    for( int i = 0; i < fNImages; i++ )
-    {
-        unsigned int t = fImgSel_list_short[i];
-        if( fsize[t] > SizeSecondMax_temp )
-        {
-            if( fsize[t] > SizeFirstMax_temp )
-            {
-                SizeSecondMax_temp = SizeFirstMax_temp;
-                SizeFirstMax_temp = fsize[t];
-            }
-            else
-            {
-                SizeSecondMax_temp = fsize[t];
-            }
-        }
-    }
-    if( SizeSecondMax_temp > 0. )
-    {
-        fSizeSecondMax = SizeSecondMax_temp;
-    }
-
-    // dispEnergy - energy reconstruction using the disp MVA
-    if( fDispAnalyzerEnergy )
-    {
-        // calculate distances and emission height
-        calcDistances();
-        calcEmissionHeights();
-
-        fDispAnalyzerEnergy->setQualityCuts( fSSR_NImages_min, fSSR_AxesAngles_min,
-                                             fTLRunParameter->fmaxdist,
-                                             fTLRunParameter->fmaxloss,
-                                             fTLRunParameter->fminfui,
-                                             fTLRunParameter->fminwidth,
-                                             fTLRunParameter->fminfitstat,
-                                             fTLRunParameter->fminntubes );
-        fDispAnalyzerEnergy->calculateEnergies(
-            getNTel(),
-            fArrayPointing_Elevation, fArrayPointing_Azimuth,
-            fTel_type,
-            getSize( true ),
-            fcen_x, fcen_y,
-            fcosphi, fsinphi,
-            fwidth, flength,
-            fasym, ftgrad_x,
-            floss, fntubes,
-            getWeight(),
-            fXoff, fYoff,
-            getDistanceToCoreTel(),
-            fEmissionHeightMean,
-            fMCEnergy,
-            ffui, fmeanPedvar_ImageT, fFitstat );
-
-        // fill results
-        setEnergy( fDispAnalyzerEnergy->getEnergy(), false );
-        setChi2( fDispAnalyzerEnergy->getEnergyChi2(), false );
-        setdE( fDispAnalyzerEnergy->getEnergydES(), false );
-
-        for( unsigned int i = 0; i < getNTel(); i++ )
-        {
-            setEnergyT( i, fDispAnalyzerEnergy->getEnergyT( i ), false );
-        }
-        setNEnergyT( fDispAnalyzerEnergy->getEnergyNT() );
-        setNEnergyQuality( fDispAnalyzerEnergy->getEnergyQualityLabel() );
-    }
 
     fEventCounter++;
     return 1;
@@ -1206,6 +1259,23 @@ bool VTableLookupDataHandler::setInputFile( vector< string > iInput )
     }
 
 
+    initializeDispAnalyzers();
+
+    if( fDebug )
+    {
+        cout << "VTableLookupDataHandler::setInputFile() END" << endl;
+    }
+
+    return fIsMC;
+}
+
+
+/*
+ * initialize disp analyzers for direction and energy reconstruction
+ * (if required)
+ */
+void VTableLookupDataHandler::initializeDispAnalyzers()
+{
     // temporary list of telescopes required for disp analysers
     vector<ULong64_t> i_TelTypeList;
     for( fList_of_Tel_type_iterator = fList_of_Tel_type.begin();
@@ -1267,12 +1337,65 @@ bool VTableLookupDataHandler::setInputFile( vector< string > iInput )
         fDispAnalyzerEnergy->setTelescopeTypeList( i_TelTypeList );
         fDispAnalyzerEnergy->initialize( fTLRunParameter->fEnergyReconstruction_BDTFileName, "TMVABDT", "BDTDispEnergy" );
     }
-    if( fDebug )
+}
+
+/*
+ * copy of this data handler for parallel event reconstruction
+ *
+ * the copy shares the input chains and the output tree, but owns
+ * its emission height calculator and (if iReconstruction is true)
+ * its disp analyzers; cut statistics are reset
+ *
+ * never read from or fill into more than one copy at a time
+ */
+VTableLookupDataHandler* VTableLookupDataHandler::clone( bool iReconstruction )
+{
+    VTableLookupDataHandler* iData = new VTableLookupDataHandler( *this );
+
+    iData->fEmissionHeightCalculator = new VEmissionHeightCalculator();
+    iData->fEmissionHeightCalculator->setTelescopePositions( fNTel, fTelX, fTelY, fTelZ );
+
+    iData->fDispAnalyzerDirection = 0;
+    iData->fDispAnalyzerDirectionError = 0;
+    iData->fDispAnalyzerDirectionSign = 0;
+    iData->fDispAnalyzerEnergy = 0;
+    if( iReconstruction )
     {
-        cout << "VTableLookupDataHandler::setInputFile() END" << endl;
+        iData->initializeDispAnalyzers();
     }
 
-    return fIsMC;
+    iData->fOutFile = 0;
+    iData->fOTree = 0;
+
+    iData->fNStats_All = 0;
+    iData->fNStats_Rec = 0;
+    iData->fNStats_NImagesCut = 0;
+    iData->fNStats_Chi2Cut = 0;
+    iData->fNStats_CoreErrorCut = 0;
+    iData->fNStats_WobbleCut = 0;
+    iData->fNStats_WobbleMinCut = 0;
+    iData->fNStats_WobbleMaxCut = 0;
+
+    return iData;
+}
+
+/*
+ * add cut statistics of a cloned data handler
+ */
+void VTableLookupDataHandler::addCutStatistics( VTableLookupDataHandler* iData )
+{
+    if( !iData )
+    {
+        return;
+    }
+    fNStats_All += iData->fNStats_All;
+    fNStats_Rec += iData->fNStats_Rec;
+    fNStats_NImagesCut += iData->fNStats_NImagesCut;
+    fNStats_Chi2Cut += iData->fNStats_Chi2Cut;
+    fNStats_CoreErrorCut += iData->fNStats_CoreErrorCut;
+    fNStats_WobbleCut += iData->fNStats_WobbleCut;
+    fNStats_WobbleMinCut += iData->fNStats_WobbleMinCut;
+    fNStats_WobbleMaxCut += iData->fNStats_WobbleMaxCut;
 }
 
 
@@ -2118,6 +2241,38 @@ void VTableLookupDataHandler::resetImageParameters( unsigned int i )
     fFitstat[i] = 0;
 }
 
+/*
+ * reset values calculated in reconstructEvent()
+ *
+ * (some of these values are calculated for selected events or
+ *  telescopes only and must not be taken from the previous event)
+ */
+void VTableLookupDataHandler::resetReconstructionParameters()
+{
+    for( unsigned int i = 0; i < getMaxNbrTel(); i++ )
+    {
+        fR_core[i] = -99.;
+        fRTel[i] = -99.;
+        fE[i] = -99.;
+        fEmissionHeightT[i] = -99.;
+    }
+    fSizeSecondMax = 0.;
+    ftheta2 = -99.;
+    fenergy = -99.;
+    fechi2 = -99.;
+    fdE = -99.;
+    fnenergyT = 0;
+    fenergyQL = -1;
+    fnxyoff = 0;
+    fDispAbsSumWeigth = 0.;
+    fXoff_edisp = -99.;
+    fYoff_edisp = -99.;
+    fChi2_edisp = -999.;
+    fNTelPairs = 0;
+    fEmissionHeightMean = -99.;
+    fEmissionHeightChi2 = -99.;
+}
+
 /*
  *
  * quick test if an event has been successfully
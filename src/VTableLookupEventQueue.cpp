@@ -0,0 +1,59 @@
+/*! \class VTableLookupEventQueue
+    \brief queue of event chunks handed over between threads of the mscw_energy event loop
+
+    Chunks are taken out in the same order as they were added. pop() waits
+    until a chunk is available; it returns 0 if the queue is empty and closed.
+
+*/
+
+#include "VTableLookupEventQueue.h"
+
+VTableLookupEventQueue::VTableLookupEventQueue()
+{
+    fClosed = false;
+}
+
+
+/*
+ * no more chunks will be added
+ */
+void VTableLookupEventQueue::close()
+{
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fClosed = true;
+    }
+    fCondition.notify_all();
+}
+
+
+/*
+ * get next chunk (waits until a chunk is available)
+ *
+ * returns 0 if queue is empty and closed
+ */
+sTableLookupEventChunk* VTableLookupEventQueue::pop()
+{
+    unique_lock< mutex > iLock( fMutex );
+    while( fQueue.empty() && !fClosed )
+    {
+        fCondition.wait( iLock );
+    }
+    if( fQueue.empty() )
+    {
+        return 0;
+    }
+    sTableLookupEventChunk* iChunk = fQueue.front();
+    fQueue.pop_front();
+    return iChunk;
+}
+
+
+void VTableLookupEventQueue::push( sTableLookupEventChunk* iChunk )
+{
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fQueue.push_back( iChunk );
+    }
+    fCondition.notify_one();
+}
@@ -0,0 +1,289 @@
+/*! \class VTableLookupGrid
+    \brief lookup table (2D median/sigma grid) stored as plain arrays
+
+    Batched interpolation: for each point, bins, bin contents and bin centers
+    are gathered from its table (scalar code), the interpolation (first on the
+    distance axis, then on the size axis) and the final consistency check are
+    calculated for eight points at once (AVX2; scalar code on other CPUs).
+
+    Results are identical to VTableLookupGrid::interpolate() (and therefore
+    to VTableCalculator::interpolate() for TH2F tables).
+
+*/
+
+#include "VTableLookupGrid.h"
+
+#include <cmath>
+
+#if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define VTABLELOOKUPGRID_AVX2
+#include <immintrin.h>
+#endif
+
+/*
+ * AVX2 kernel is used by default if supported by the CPU
+ */
+static bool isAVX2Supported()
+{
+#ifdef VTABLELOOKUPGRID_AVX2
+    __builtin_cpu_init();
+    return __builtin_cpu_supports( "avx2" );
+#else
+    return false;
+#endif
+}
+
+bool VTableLookupGrid::fAVX2 = isAVX2Supported();
+
+// number of points interpolated at once
+static const unsigned int fSIMDWidth = 8;
+
+/*
+ * gathered values for the interpolation of fSIMDWidth points
+ * (v: bin contents or errors; 11 = (x1,y1), 12 = (x1,y2), ...)
+ */
+struct sTableLookupGather
+{
+    float x[fSIMDWidth];
+    float y[fSIMDWidth];
+    float x1[fSIMDWidth];
+    float x2[fSIMDWidth];
+    float y1[fSIMDWidth];
+    float y2[fSIMDWidth];
+    float v11[2][fSIMDWidth];
+    float v12[2][fSIMDWidth];
+    float v21[2][fSIMDWidth];
+    float v22[2][fSIMDWidth];
+    bool  bDirect[fSIMDWidth];               // under/overflows: bin content is returned directly
+    float vDirect[2][fSIMDWidth];
+};
+
+/*
+ * bins and bin contents for one point (as in VTableLookupGrid::interpolate())
+ */
+static void gather( const VTableLookupGrid* g, float x, float y, sTableLookupGather& d, unsigned int l )
+{
+    d.x[l] = x;
+    d.y[l] = y;
+    d.bDirect[l] = true;
+    d.vDirect[0][l] = 0.;
+    d.vDirect[1][l] = 0.;
+    // dummy values for lanes without interpolation
+    d.x1[l] = 0.;
+    d.x2[l] = 1.;
+    d.y1[l] = 0.;
+    d.y2[l] = 1.;
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        d.v11[i][l] = d.v12[i][l] = d.v21[i][l] = d.v22[i][l] = 0.;
+    }
+    if( !g || !g->isValid() )
+    {
+        return;
+    }
+    unsigned int i_x = g->findBinX( x );
+    unsigned int i_y = g->findBinY( y );
+    unsigned int n = g->fNBinsX + 2;
+    if( i_x == 0 || i_y == 0 || i_x == g->fNBinsX || i_y == g->fNBinsY )
+    {
+        d.vDirect[0][l] = g->fContent[i_x + n * i_y];
+        d.vDirect[1][l] = g->fError[i_x + n * i_y];
+        return;
+    }
+    if( x < g->getBinCenterX( i_x ) )
+    {
+        i_x--;
+    }
+    if( y < g->getBinCenterY( i_y ) )
+    {
+        i_y--;
+    }
+    unsigned int i_x1 = ( i_x < g->fNBinsX + 1 ? i_x : g->fNBinsX + 1 );
+    unsigned int i_x2 = ( i_x + 1 < g->fNBinsX + 1 ? i_x + 1 : g->fNBinsX + 1 );
+    unsigned int i_y1 = ( i_y < g->fNBinsY + 1 ? i_y : g->fNBinsY + 1 );
+    unsigned int i_y2 = ( i_y + 1 < g->fNBinsY + 1 ? i_y + 1 : g->fNBinsY + 1 );
+    d.bDirect[l] = false;
+    d.x1[l] = g->getBinCenterXf( i_x );
+    d.x2[l] = g->getBinCenterXf( i_x + 1 );
+    d.y1[l] = g->getBinCenterYf( i_y );
+    d.y2[l] = g->getBinCenterYf( i_y + 1 );
+    d.v11[0][l] = g->fContent[i_x1 + n * i_y1];
+    d.v12[0][l] = g->fContent[i_x1 + n * i_y2];
+    d.v21[0][l] = g->fContent[i_x2 + n * i_y1];
+    d.v22[0][l] = g->fContent[i_x2 + n * i_y2];
+    d.v11[1][l] = g->fError[i_x1 + n * i_y1];
+    d.v12[1][l] = g->fError[i_x1 + n * i_y2];
+    d.v21[1][l] = g->fError[i_x2 + n * i_y1];
+    d.v22[1][l] = g->fError[i_x2 + n * i_y2];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// scalar kernel
+
+static void interpolate_scalar( const sTableLookupGather& d, unsigned int iNLanes, float* med, float* sigma )
+{
+    for( unsigned int l = 0; l < iNLanes; l++ )
+    {
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            float* r = ( i == 0 ? med : sigma );
+            if( d.bDirect[l] )
+            {
+                r[l] = d.vDirect[i][l];
+                continue;
+            }
+            float e1 = VStatistics::interpolate( d.v11[i][l], d.y1[l], d.v12[i][l], d.y2[l], d.y[l], false );
+            float e2 = VStatistics::interpolate( d.v21[i][l], d.y1[l], d.v22[i][l], d.y2[l], d.y[l], false );
+            float v = VStatistics::interpolate( e1, d.x1[l], e2, d.x2[l], d.x[l], false );
+            if( e1 > 1.e-3 && e2 < 1.e-3 )
+            {
+                r[l] = e1;
+            }
+            else if( e1 < 1.e-3 && e2 > 1.e-3 )
+            {
+                r[l] = e2;
+            }
+            else
+            {
+                r[l] = v;
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// AVX2 kernel (eight points at once)
+
+#ifdef VTABLELOOKUPGRID_AVX2
+/*
+ * VStatistics::interpolate( w1, x1, w2, x2, x, false ) for eight values
+ */
+__attribute__( ( target( "avx2" ) ) )
+static inline __m256 interpolate_AVX2( __m256 w1, __m256 x1, __m256 w2, __m256 x2, __m256 x )
+{
+    const __m256 iMinValidValue = _mm256_set1_ps( -98.f );
+    const __m256 iLimitforInterpolation = _mm256_set1_ps( 0.05f );
+    const __m256 iInvalid = _mm256_set1_ps( -99.f );
+    const __m256 iOne = _mm256_set1_ps( 1.f );
+    const __m256 iAbsMask = _mm256_castsi256_ps( _mm256_set1_epi32( 0x7fffffff ) );
+
+    __m256 w1_inv = _mm256_cmp_ps( w1, iMinValidValue, _CMP_LT_OQ );
+    __m256 w2_inv = _mm256_cmp_ps( w2, iMinValidValue, _CMP_LT_OQ );
+    __m256 w1_val = _mm256_cmp_ps( w1, iMinValidValue, _CMP_GT_OQ );
+    __m256 w2_val = _mm256_cmp_ps( w2, iMinValidValue, _CMP_GT_OQ );
+
+    // normal interpolation
+    __m256 id = _mm256_sub_ps( x1, x2 );
+    __m256 f1 = _mm256_sub_ps( iOne, _mm256_div_ps( _mm256_sub_ps( x1, x ), id ) );
+    __m256 f2 = _mm256_sub_ps( iOne, _mm256_div_ps( _mm256_sub_ps( x, x2 ), id ) );
+    __m256 r = _mm256_add_ps( _mm256_mul_ps( w1, f1 ), _mm256_mul_ps( w2, f2 ) );
+
+    // one value invalid
+    __m256 r1 = _mm256_blendv_ps( iInvalid, w1, _mm256_cmp_ps( f1, iLimitforInterpolation, _CMP_GT_OQ ) );
+    r = _mm256_blendv_ps( r, r1, _mm256_and_ps( w1_val, w2_inv ) );
+    __m256 r2 = _mm256_blendv_ps( iInvalid, w2, _mm256_cmp_ps( f2, iLimitforInterpolation, _CMP_GT_OQ ) );
+    r = _mm256_blendv_ps( r, r2, _mm256_and_ps( w1_inv, w2_val ) );
+
+    // same x-value: average or valid value
+    __m256 r_same = _mm256_div_ps( _mm256_add_ps( w1, w2 ), _mm256_set1_ps( 2.f ) );
+    r_same = _mm256_blendv_ps( r_same, w1, w2_inv );
+    r_same = _mm256_blendv_ps( r_same, w2, w1_inv );
+    __m256 same = _mm256_cmp_ps( _mm256_and_ps( id, iAbsMask ), _mm256_set1_ps( 1.e-3f ), _CMP_LT_OQ );
+    r = _mm256_blendv_ps( r, r_same, same );
+
+    // both values invalid
+    return _mm256_blendv_ps( r, iInvalid, _mm256_and_ps( w1_inv, w2_inv ) );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static void interpolate_AVX2( const sTableLookupGather& d, float* med, float* sigma )
+{
+    // e > 1.e-3 (double) is equivalent to e >= 1.e-3f for floats (1.e-3f > 1.e-3)
+    const __m256 iLimit = _mm256_set1_ps( 1.e-3f );
+
+    __m256 x = _mm256_loadu_ps( d.x );
+    __m256 y = _mm256_loadu_ps( d.y );
+    __m256 x1 = _mm256_loadu_ps( d.x1 );
+    __m256 x2 = _mm256_loadu_ps( d.x2 );
+    __m256 y1 = _mm256_loadu_ps( d.y1 );
+    __m256 y2 = _mm256_loadu_ps( d.y2 );
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        __m256 e1 = interpolate_AVX2( _mm256_loadu_ps( d.v11[i] ), y1, _mm256_loadu_ps( d.v12[i] ), y2, y );
+        __m256 e2 = interpolate_AVX2( _mm256_loadu_ps( d.v21[i] ), y1, _mm256_loadu_ps( d.v22[i] ), y2, y );
+        __m256 v = interpolate_AVX2( e1, x1, e2, x2, x );
+
+        __m256 e1_gt = _mm256_cmp_ps( e1, iLimit, _CMP_GE_OQ );
+        __m256 e1_lt = _mm256_cmp_ps( e1, iLimit, _CMP_LT_OQ );
+        __m256 e2_gt = _mm256_cmp_ps( e2, iLimit, _CMP_GE_OQ );
+        __m256 e2_lt = _mm256_cmp_ps( e2, iLimit, _CMP_LT_OQ );
+        v = _mm256_blendv_ps( v, e2, _mm256_and_ps( e1_lt, e2_gt ) );
+        v = _mm256_blendv_ps( v, e1, _mm256_and_ps( e1_gt, e2_lt ) );
+
+        _mm256_storeu_ps( ( i == 0 ? med : sigma ), v );
+    }
+    for( unsigned int l = 0; l < fSIMDWidth; l++ )
+    {
+        if( d.bDirect[l] )
+        {
+            med[l] = d.vDirect[0][l];
+            sigma[l] = d.vDirect[1][l];
+        }
+    }
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+
+/*
+ * use AVX2 kernel (if supported by the CPU)
+ */
+void VTableLookupGrid::setAVX2( bool iAVX2 )
+{
+    fAVX2 = false;
+#ifdef VTABLELOOKUPGRID_AVX2
+    if( iAVX2 && __builtin_cpu_supports( "avx2" ) )
+    {
+        fAVX2 = true;
+    }
+#endif
+}
+
+
+void VTableLookupGrid::interpolate( unsigned int n, const VTableLookupGrid* const* g, const float* x, const float* y,
+                                    float* med, float* sigma )
+{
+    sTableLookupGather d;
+    float iMed[fSIMDWidth];
+    float iSigma[fSIMDWidth];
+    for( unsigned int i = 0; i < n; i += fSIMDWidth )
+    {
+        unsigned int iNLanes = ( n - i < fSIMDWidth ? n - i : fSIMDWidth );
+        for( unsigned int l = 0; l < fSIMDWidth; l++ )
+        {
+            if( l < iNLanes )
+            {
+                gather( g[i + l], x[i + l], y[i + l], d, l );
+            }
+            else
+            {
+                gather( 0, 0., 0., d, l );
+            }
+        }
+#ifdef VTABLELOOKUPGRID_AVX2
+        if( fAVX2 )
+        {
+            interpolate_AVX2( d, iMed, iSigma );
+        }
+        else
+#endif
+        {
+            interpolate_scalar( d, iNLanes, iMed, iSigma );
+        }
+        for( unsigned int l = 0; l < iNLanes; l++ )
+        {
+            med[i + l] = iMed[l];
+            sigma[i + l] = iSigma[l];
+        }
+    }
+}
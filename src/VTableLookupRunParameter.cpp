@@ -22,6 +22,10 @@ VTableLookupRunParameter::VTableLookupRunParameter()
     readwrite = 'R';
     writeoption = "recreate";
     fMinRequiredShowerPerBin = 5.;
+    fTableCacheSize = 0.;
+    fUseTableInterpolationCache = false;
+    fTableInterpolationCacheSize = 500.;
+    fNThreads = 1;
     bNoNoTrigger = true;
     fUseEvndispSelectedImagesOnly = true;
     bWriteReconstructedEventsOnly = 1;
@@ -151,6 +155,23 @@ bool VTableLookupRunParameter::fillParameters( int argc, char* argv[] )
                 fWobbleOffset = ( int )( atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() ) * 1000 + 0.5 );
             }
         }
+        else if( iTemp.find( "-tableinterpolationcachesize" ) < iTemp.size() )
+        {
+            fTableInterpolationCacheSize = atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
+        else if( iTemp.find( "-tableinterpolationcache" ) < iTemp.size() )
+        {
+            fUseTableInterpolationCache = ( bool )atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
+        else if( iTemp.find( "-nthreads" ) < iTemp.size() )
+        {
+            int iNThreads = atoi( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+            fNThreads = ( iNThreads > 0 ? ( unsigned int )iNThreads : 1 );
+        }
+        else if( iTemp.find( "-tablecachesize" ) < iTemp.size() )
+        {
+            fTableCacheSize = atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
         else if( iTemp.find( "-table" ) < iTemp.size() )
         {
             if( iTemp2.size() > 0 )
@@ -628,6 +649,26 @@ void VTableLookupRunParameter::print( int iP )
     {
         cout << "updating instrument epoch from default epoch file" << endl;
     }
+    if( readwrite != 'W' && fTableCacheSize > 0. )
+    {
+        cout << "memory budget for lookup tables: " << fTableCacheSize << " MB" << endl;
+    }
+    if( readwrite != 'W' && fUseTableInterpolationCache )
+    {
+        cout << "use cache of lookup tables interpolated in zenith angle and wobble offset";
+        cout << " (memory budget " << fTableInterpolationCacheSize << " MB)" << endl;
+    }
+    if( fNThreads > 1 )
+    {
+        if( readwrite != 'W' )
+        {
+            cout << "event loop with " << fNThreads << " threads" << endl;
+        }
+        else
+        {
+            cout << "table filling is single-threaded (ignoring number of threads " << fNThreads << ")" << endl;
+        }
+    }
 
     if( iP >= 1 )
     {
@@ -19,6 +19,9 @@ VTablesToRead::VTablesToRead( int iNTel )
         henergyERSigma.push_back( 0 );
         henergySRMedian.push_back( 0 );
         henergySRSigma.push_back( 0 );
+        gmscwMedian.push_back( 0 );
+        gmsclMedian.push_back( 0 );
+        genergySRMedian.push_back( 0 );
     }
 
     mscw_T = new double[fNTel];
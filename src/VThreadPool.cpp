@@ -0,0 +1,143 @@
+/*! \class VThreadPool
+    \brief simple fork-join thread pool
+
+    run( n, task ) executes task( 0 ) ... task( n - 1 ) on the worker threads
+    and on the calling thread, and returns after all tasks are finished.
+
+    Worker threads are started once and are kept alive (idle) between calls
+    of run(), so that thread_local data (e.g. trace handlers) is preserved.
+
+*/
+
+#include "VThreadPool.h"
+
+VThreadPool::VThreadPool( unsigned int iNThreads )
+{
+    fNTasks = 0;
+    fNextTask = 0;
+    fNTasksDone = 0;
+    fGeneration = 0;
+    fStop = false;
+
+    // calling thread is working as well
+    for( unsigned int i = 1; i < iNThreads; i++ )
+    {
+        fWorkers.push_back( thread( &VThreadPool::work, this ) );
+    }
+}
+
+
+VThreadPool::~VThreadPool()
+{
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fStop = true;
+    }
+    fCondition_start.notify_all();
+    for( unsigned int i = 0; i < fWorkers.size(); i++ )
+    {
+        if( fWorkers[i].joinable() )
+        {
+            fWorkers[i].join();
+        }
+    }
+}
+
+
+/*
+ * get index of next task to execute
+ *
+ * return false if there are no tasks left
+*/
+bool VThreadPool::nextTask( unsigned int& iTask )
+{
+    unique_lock< mutex > iLock( fMutex );
+    if( fNextTask < fNTasks )
+    {
+        iTask = fNextTask;
+        fNextTask++;
+        return true;
+    }
+    return false;
+}
+
+
+/*
+ * worker thread loop
+*/
+void VThreadPool::work()
+{
+    unsigned long int iGeneration = 0;
+    for( ;; )
+    {
+        {
+            unique_lock< mutex > iLock( fMutex );
+            while( !fStop && fGeneration == iGeneration )
+            {
+                fCondition_start.wait( iLock );
+            }
+            if( fStop )
+            {
+                return;
+            }
+            iGeneration = fGeneration;
+        }
+        unsigned int iTask = 0;
+        while( nextTask( iTask ) )
+        {
+            fTask( iTask );
+            unique_lock< mutex > iLock( fMutex );
+            fNTasksDone++;
+            if( fNTasksDone == fNTasks )
+            {
+                fCondition_done.notify_one();
+            }
+        }
+    }
+}
+
+
+/*
+ * execute iNTasks tasks and wait until all of them are finished
+*/
+void VThreadPool::run( unsigned int iNTasks, function< void( unsigned int ) > iTask )
+{
+    if( iNTasks == 0 )
+    {
+        return;
+    }
+    // no worker threads: run sequentially
+    if( fWorkers.size() == 0 )
+    {
+        for( unsigned int i = 0; i < iNTasks; i++ )
+        {
+            iTask( i );
+        }
+        return;
+    }
+    {
+        unique_lock< mutex > iLock( fMutex );
+        fTask = iTask;
+        fNTasks = iNTasks;
+        fNextTask = 0;
+        fNTasksDone = 0;
+        fGeneration++;
+    }
+    fCondition_start.notify_all();
+
+    // calling thread takes tasks, too
+    unsigned int i = 0;
+    while( nextTask( i ) )
+    {
+        fTask( i );
+        unique_lock< mutex > iLock( fMutex );
+        fNTasksDone++;
+    }
+
+    // wait for all workers to finish
+    unique_lock< mutex > iLock( fMutex );
+    while( fNTasksDone < fNTasks )
+    {
+        fCondition_done.wait( iLock );
+    }
+}
@@ -0,0 +1,589 @@
+/*! \class VTraceBatchHandler
+    \brief trace integration and timing for all channels of a camera
+
+    FADC samples of all channels are stored as [sample][channel], so that
+    the maximum search and the fixed and sliding window integration run
+    over eight channels at once (AVX2; scalar code on other CPUs).
+
+    Results are identical to the per-channel calculation in VTraceHandler
+    for high-gain channels (no hi-lo scaling, no trace fit).
+
+*/
+
+#include "VTraceBatchHandler.h"
+#include "VTraceHandler.h"
+#include "TMath.h"
+
+#include <climits>
+
+#if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define VTRACEBATCH_AVX2
+#include <immintrin.h>
+#endif
+
+// number of channels processed at once
+static const unsigned int fSIMDWidth = 8;
+
+/////////////////////////////////////////////////////////////////////////////
+// scalar kernels
+
+/*
+ * position of (first) maximum sample in [iFirst, iLast) for all channels
+ * (-100 for empty ranges)
+ */
+static void getMaximum_scalar( const int32_t* iSample, unsigned int iNLanes, unsigned int iNSamples,
+                               const int* iFirst, const int* iLast, int* iMaxPos )
+{
+    for( unsigned int c = 0; c < iNLanes; c++ )
+    {
+        iMaxPos[c] = -100;
+        int32_t iMax = INT_MIN;
+        for( unsigned int s = 0; s < iNSamples; s++ )
+        {
+            if( ( int )s >= iFirst[c] && ( int )s < iLast[c] && iSample[s * iNLanes + c] > iMax )
+            {
+                iMax = iSample[s * iNLanes + c];
+                iMaxPos[c] = s;
+            }
+        }
+    }
+}
+
+/*
+ * sums over pedestal subtracted samples > 0 in [iFirst, iLast) for all channels
+ * (pedestal is subtracted per sample, same summation order as in VTraceHandler)
+ */
+static void getSums_scalar( const int32_t* iSample, unsigned int iNLanes, unsigned int iNSamples,
+                            const int* iFirst, const int* iLast, const double* iPed,
+                            double* iSum, double* iTCharge )
+{
+    for( unsigned int c = 0; c < iNLanes; c++ )
+    {
+        iSum[c] = 0.;
+        iTCharge[c] = 0.;
+        for( unsigned int s = 0; s < iNSamples; s++ )
+        {
+            int32_t v = iSample[s * iNLanes + c];
+            if( ( int )s >= iFirst[c] && ( int )s < iLast[c] && v > 0 )
+            {
+                iSum[c]     += v - iPed[c];
+                iTCharge[c] += ( s + 0.5 ) * ( v - iPed[c] );
+            }
+        }
+    }
+}
+
+/*
+ * maximum sum in a sliding window of length iW for all channels
+ * (same order of floating point operations as VTraceHandler::calculateTraceSum_slidingWindow)
+ */
+static void getSlidingWindowMax_scalar( const float* iFADC, unsigned int iNLanes, unsigned int iNSamples,
+                                        const int* iW, float* iCharge, int* iFirst )
+{
+    int n = ( int )iNSamples;
+    for( unsigned int c = 0; c < iNLanes; c++ )
+    {
+        float xmax = 0.;
+        float charge = 0.;
+        iFirst[c] = 0;
+        for( int i = 0; i < iW[c]; i++ )
+        {
+            xmax += iFADC[i * iNLanes + c];
+        }
+        for( int i = 0; i < n - iW[c] + 1; i++ )
+        {
+            if( charge < xmax )
+            {
+                charge = xmax;
+                iFirst[c] = i;
+            }
+            if( i + iW[c] < n )
+            {
+                xmax = xmax - iFADC[i * iNLanes + c] + iFADC[( i + iW[c] ) * iNLanes + c];
+            }
+        }
+        iCharge[c] = charge;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels (eight channels at once)
+
+#ifdef VTRACEBATCH_AVX2
+__attribute__( ( target( "avx2" ) ) )
+static void getMaximum_AVX2( const int32_t* iSample, unsigned int iNLanes, unsigned int iNSamples,
+                             const int* iFirst, const int* iLast, int* iMaxPos )
+{
+    for( unsigned int c = 0; c < iNLanes; c += fSIMDWidth )
+    {
+        __m256i vFirst = _mm256_loadu_si256( ( const __m256i* )( iFirst + c ) );
+        __m256i vLast  = _mm256_loadu_si256( ( const __m256i* )( iLast + c ) );
+        __m256i vMax   = _mm256_set1_epi32( INT_MIN );
+        __m256i vPos   = _mm256_set1_epi32( -100 );
+        for( unsigned int s = 0; s < iNSamples; s++ )
+        {
+            __m256i vS = _mm256_set1_epi32( ( int )s );
+            __m256i vIn = _mm256_andnot_si256( _mm256_cmpgt_epi32( vFirst, vS ), _mm256_cmpgt_epi32( vLast, vS ) );
+            __m256i vV = _mm256_loadu_si256( ( const __m256i* )( iSample + s * iNLanes + c ) );
+            __m256i vGT = _mm256_and_si256( vIn, _mm256_cmpgt_epi32( vV, vMax ) );
+            vMax = _mm256_blendv_epi8( vMax, vV, vGT );
+            vPos = _mm256_blendv_epi8( vPos, vS, vGT );
+        }
+        _mm256_storeu_si256( ( __m256i* )( iMaxPos + c ), vPos );
+    }
+}
+
+/*
+ * (four channels at once in double precision; samples outside of the
+ *  window add zero, which leaves the sums unchanged)
+ */
+__attribute__( ( target( "avx2" ) ) )
+static void getSums_AVX2( const int32_t* iSample, unsigned int iNLanes, unsigned int iNSamples,
+                          const int* iFirst, const int* iLast, const double* iPed,
+                          double* iSum, double* iTCharge )
+{
+    __m128i vZero = _mm_setzero_si128();
+    for( unsigned int c = 0; c < iNLanes; c += 4 )
+    {
+        __m128i vFirst = _mm_loadu_si128( ( const __m128i* )( iFirst + c ) );
+        __m128i vLast  = _mm_loadu_si128( ( const __m128i* )( iLast + c ) );
+        __m256d vPed = _mm256_loadu_pd( iPed + c );
+        __m256d vSum = _mm256_setzero_pd();
+        __m256d vTCharge = _mm256_setzero_pd();
+        for( unsigned int s = 0; s < iNSamples; s++ )
+        {
+            __m128i vS = _mm_set1_epi32( ( int )s );
+            __m128i vV = _mm_loadu_si128( ( const __m128i* )( iSample + s * iNLanes + c ) );
+            __m128i vIn = _mm_andnot_si128( _mm_cmpgt_epi32( vFirst, vS ), _mm_cmpgt_epi32( vLast, vS ) );
+            vIn = _mm_and_si128( vIn, _mm_cmpgt_epi32( vV, vZero ) );
+            __m256d vD = _mm256_sub_pd( _mm256_cvtepi32_pd( vV ), vPed );
+            vD = _mm256_and_pd( _mm256_castsi256_pd( _mm256_cvtepi32_epi64( vIn ) ), vD );
+            vSum = _mm256_add_pd( vSum, vD );
+            vTCharge = _mm256_add_pd( vTCharge, _mm256_mul_pd( _mm256_set1_pd( s + 0.5 ), vD ) );
+        }
+        _mm256_storeu_pd( iSum + c, vSum );
+        _mm256_storeu_pd( iTCharge + c, vTCharge );
+    }
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static void getSlidingWindowMax_AVX2( const float* iFADC, unsigned int iNLanes, unsigned int iNSamples,
+                                      const int* iW, float* iCharge, int* iFirst )
+{
+    int n = ( int )iNSamples;
+    __m256i vN = _mm256_set1_epi32( n );
+    __m256i vLane = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+    __m256i vNLanes = _mm256_set1_epi32( ( int )iNLanes );
+    for( unsigned int c = 0; c < iNLanes; c += fSIMDWidth )
+    {
+        __m256i vW = _mm256_loadu_si256( ( const __m256i* )( iW + c ) );
+        __m256i vLaneC = _mm256_add_epi32( vLane, _mm256_set1_epi32( ( int )c ) );
+        // last start position of window (exclusive)
+        __m256i vEnd = _mm256_add_epi32( _mm256_sub_epi32( vN, vW ), _mm256_set1_epi32( 1 ) );
+        int iWMax = 0;
+        int iEndMax = 0;
+        for( unsigned int l = 0; l < fSIMDWidth; l++ )
+        {
+            iWMax = ( iW[c + l] > iWMax ? iW[c + l] : iWMax );
+            iEndMax = ( n - iW[c + l] + 1 > iEndMax ? n - iW[c + l] + 1 : iEndMax );
+        }
+        // first window
+        __m256 vXMax = _mm256_setzero_ps();
+        for( int i = 0; i < iWMax; i++ )
+        {
+            __m256i vI = _mm256_set1_epi32( i );
+            __m256 vIn = _mm256_castsi256_ps( _mm256_cmpgt_epi32( vW, vI ) );
+            __m256 vF = _mm256_loadu_ps( iFADC + i * iNLanes + c );
+            vXMax = _mm256_blendv_ps( vXMax, _mm256_add_ps( vXMax, vF ), vIn );
+        }
+        // slide to the right
+        __m256 vCharge = _mm256_setzero_ps();
+        __m256i vFirst = _mm256_setzero_si256();
+        for( int i = 0; i < iEndMax; i++ )
+        {
+            __m256i vI = _mm256_set1_epi32( i );
+            __m256 vActive = _mm256_castsi256_ps( _mm256_cmpgt_epi32( vEnd, vI ) );
+            __m256 vUpd = _mm256_and_ps( vActive, _mm256_cmp_ps( vCharge, vXMax, _CMP_LT_OQ ) );
+            vCharge = _mm256_blendv_ps( vCharge, vXMax, vUpd );
+            vFirst = _mm256_castps_si256( _mm256_blendv_ps( _mm256_castsi256_ps( vFirst ), _mm256_castsi256_ps( vI ), vUpd ) );
+            if( i < n )
+            {
+                __m256i vIW = _mm256_add_epi32( vI, vW );
+                __m256 vSlide = _mm256_and_ps( vActive, _mm256_castsi256_ps( _mm256_cmpgt_epi32( vN, vIW ) ) );
+                __m256 vF = _mm256_loadu_ps( iFADC + i * iNLanes + c );
+                __m256i vIndex = _mm256_add_epi32( _mm256_mullo_epi32( vIW, vNLanes ), vLaneC );
+                __m256 vFW = _mm256_mask_i32gather_ps( _mm256_setzero_ps(), iFADC, vIndex, vSlide, 4 );
+                vXMax = _mm256_blendv_ps( vXMax, _mm256_add_ps( _mm256_sub_ps( vXMax, vF ), vFW ), vSlide );
+            }
+        }
+        _mm256_storeu_ps( iCharge + c, vCharge );
+        _mm256_storeu_si256( ( __m256i* )( iFirst + c ), vFirst );
+    }
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+
+VTraceBatchHandler::VTraceBatchHandler()
+{
+    fNSamples = 0;
+    fNChannels = 0;
+    fNLanes = 0;
+    fpulsetiming_maxPV = 0;
+    setAVX2();
+}
+
+/*
+ * use AVX2 kernels (if supported by the CPU)
+ */
+void VTraceBatchHandler::setAVX2( bool iAVX2 )
+{
+    fAVX2 = false;
+#ifdef VTRACEBATCH_AVX2
+    if( iAVX2 && __builtin_cpu_supports( "avx2" ) )
+    {
+        fAVX2 = true;
+    }
+#endif
+}
+
+/*
+ * prepare batch for up to iMaxChannels channels
+ */
+void VTraceBatchHandler::reset( unsigned int iNSamples, unsigned int iMaxChannels )
+{
+    fNSamples = iNSamples;
+    fNChannels = 0;
+    fNLanes = ( ( iMaxChannels + fSIMDWidth - 1 ) / fSIMDWidth ) * fSIMDWidth;
+    fSample.assign( fNSamples * fNLanes, 0 );
+    fFADC.assign( fNSamples * fNLanes, 0. );
+    fPed.assign( fNLanes, 0. );
+    fChannelID.assign( fNLanes, 0 );
+    fHitID.assign( fNLanes, 0 );
+    fTraceSum.assign( fNLanes, 0. );
+    fTraceAverageTime.assign( fNLanes, 0. );
+    fSumWindowFirst.assign( fNLanes, 0 );
+    fSumWindowLast.assign( fNLanes, 0 );
+}
+
+/*
+ * add samples of this channel from the reader buffer
+ *
+ * return false if samples are not available from the reader buffer
+ */
+bool VTraceBatchHandler::addChannel( VVirtualDataReader* iReader, unsigned int iChannelID, unsigned int iHitID,
+                                     double iPed, unsigned int iTraceStart )
+{
+    if( !iReader || fNChannels >= fNLanes )
+    {
+        return false;
+    }
+    unsigned int iNReaderSamples = 0;
+    unsigned int c = fNChannels;
+    float ped = iPed;
+    if( iReader->has16Bit() )
+    {
+        const uint16_t* iT = iReader->getSamplePtr16Bit( iHitID, iNReaderSamples );
+        if( !iT || iNReaderSamples < fNSamples + iTraceStart )
+        {
+            return false;
+        }
+        for( unsigned int s = 0; s < fNSamples; s++ )
+        {
+            fSample[s * fNLanes + c] = iT[s + iTraceStart];
+            fFADC[s * fNLanes + c] = ( float )iT[s + iTraceStart] - ped;
+        }
+    }
+    else
+    {
+        const uint8_t* iT = iReader->getSamplePtr( iHitID, iNReaderSamples );
+        if( !iT || iNReaderSamples < fNSamples + iTraceStart )
+        {
+            return false;
+        }
+        for( unsigned int s = 0; s < fNSamples; s++ )
+        {
+            fSample[s * fNLanes + c] = iT[s + iTraceStart];
+            fFADC[s * fNLanes + c] = ( float )iT[s + iTraceStart] - ped;
+        }
+    }
+    fPed[c] = iPed;
+    fChannelID[c] = iChannelID;
+    fHitID[c] = iHitID;
+    fNChannels++;
+
+    return true;
+}
+
+/*
+ * position of trace maximum in [iFirst, iLast) for all channels
+ *
+ * (empty or invalid ranges: -100; vectors are of length getNLanes())
+ */
+void VTraceBatchHandler::calculateMaximum( vector< int >& iFirst, vector< int >& iLast, vector< int >& iMaxPos )
+{
+    iMaxPos.assign( fNLanes, -100 );
+    if( iFirst.size() < fNLanes || iLast.size() < fNLanes || fNLanes == 0 )
+    {
+        return;
+    }
+#ifdef VTRACEBATCH_AVX2
+    if( fAVX2 )
+    {
+        getMaximum_AVX2( &fSample[0], fNLanes, fNSamples, &iFirst[0], &iLast[0], &iMaxPos[0] );
+    }
+    else
+#endif
+    {
+        getMaximum_scalar( &fSample[0], fNLanes, fNSamples, &iFirst[0], &iLast[0], &iMaxPos[0] );
+    }
+    // invalid search ranges
+    for( unsigned int c = 0; c < fNLanes; c++ )
+    {
+        if( iFirst[c] < 0 || iFirst[c] >= iLast[c] || iLast[c] > ( int )fNSamples )
+        {
+            iMaxPos[c] = -100;
+        }
+    }
+}
+
+/*
+ * trace maximum (pedestal subtracted) at position iMaxPos
+ *
+ * (as VTraceHandler::getQuickMax() for high-gain channels)
+ */
+double VTraceBatchHandler::getTraceMax( unsigned int i, int iMaxPos )
+{
+    if( iMaxPos < 0 )
+    {
+        return -10000.;
+    }
+    return getSample( i, iMaxPos ) - fPed[i];
+}
+
+/*
+ * sum up FADC traces in [iFirst, iLast) for all channels
+ * (see VTraceHandler::calculateTraceSum_fixedWindow)
+ */
+void VTraceBatchHandler::calculateTraceSum_fixedWindow( vector< int >& iFirst, vector< int >& iLast, bool iRaw )
+{
+    if( iFirst.size() < fNLanes || iLast.size() < fNLanes || fNLanes == 0 )
+    {
+        return;
+    }
+    vector< double > iSum( fNLanes, 0. );
+    vector< double > iTCharge( fNLanes, 0. );
+    vector< double > iPed( fNLanes, 0. );
+    if( !iRaw )
+    {
+        iPed = fPed;
+    }
+#ifdef VTRACEBATCH_AVX2
+    if( fAVX2 )
+    {
+        getSums_AVX2( &fSample[0], fNLanes, fNSamples, &iFirst[0], &iLast[0], &iPed[0], &iSum[0], &iTCharge[0] );
+    }
+    else
+#endif
+    {
+        getSums_scalar( &fSample[0], fNLanes, fNSamples, &iFirst[0], &iLast[0], &iPed[0], &iSum[0], &iTCharge[0] );
+    }
+
+    for( unsigned int c = 0; c < fNChannels; c++ )
+    {
+        fSumWindowFirst[c] = ( unsigned int )iFirst[c];
+        fSumWindowLast[c]  = ( unsigned int )iLast[c];
+        double sum = iSum[c];
+        double tcharge = iTCharge[c];
+        if( TMath::IsNaN( sum ) )
+        {
+            sum = 0.;
+        }
+        if( TMath::Abs( sum ) < 1.e-10 )
+        {
+            sum = 0.;
+            fTraceAverageTime[c] = 0.;
+        }
+        else
+        {
+            fTraceAverageTime[c] = tcharge / sum;
+        }
+        fTraceSum[c] = sum;
+    }
+}
+
+/*
+ * get maximum trace sum for all channels
+ * (sliding window, search along full trace for maximum sum;
+ *  see VTraceHandler::calculateTraceSum_slidingWindow)
+ *
+ * iIntegrationWindow must be in [0, number of samples]
+ */
+void VTraceBatchHandler::calculateTraceSum_slidingWindow( vector< int >& iIntegrationWindow )
+{
+    if( iIntegrationWindow.size() < fNLanes || fNLanes == 0 )
+    {
+        return;
+    }
+    vector< float > iCharge( fNLanes, 0. );
+    vector< int > iFirst( fNLanes, 0 );
+#ifdef VTRACEBATCH_AVX2
+    if( fAVX2 )
+    {
+        getSlidingWindowMax_AVX2( &fFADC[0], fNLanes, fNSamples, &iIntegrationWindow[0], &iCharge[0], &iFirst[0] );
+    }
+    else
+#endif
+    {
+        getSlidingWindowMax_scalar( &fFADC[0], fNLanes, fNSamples, &iIntegrationWindow[0], &iCharge[0], &iFirst[0] );
+    }
+
+    for( unsigned int c = 0; c < fNChannels; c++ )
+    {
+        double charge = iCharge[c];
+        fTraceAverageTime[c] = 0.;
+        fSumWindowFirst[c] = 0;
+        fSumWindowLast[c] = 0;
+        if( charge > 0. )
+        {
+            fSumWindowFirst[c] = iFirst[c];
+            fSumWindowLast[c] = iFirst[c] + iIntegrationWindow[c];
+            if( fSumWindowLast[c] > fNSamples )
+            {
+                fSumWindowLast[c] = fNSamples;
+            }
+        }
+        // arrival times (weighted average)
+        float tcharge = 0.;
+        for( unsigned int k = fSumWindowFirst[c]; k < fSumWindowLast[c]; k++ )
+        {
+            tcharge += ( float )( k + 0.5 ) * fFADC[k * fNLanes + c];
+        }
+        if( charge != 0. )
+        {
+            fTraceAverageTime[c] = tcharge / charge;
+        }
+        if( fTraceAverageTime[c] < 0. )
+        {
+            fTraceAverageTime[c] = 0.;
+        }
+        if( fTraceAverageTime[c] > ( int )fNSamples )
+        {
+            fTraceAverageTime[c] = ( int )fNSamples;
+        }
+        fTraceSum[c] = charge;
+    }
+}
+
+/*
+ * calculate pulse timing for channel i
+ * (see VTraceHandler::getPulseTiming; maximum search is done by calculateMaximum())
+ */
+vector< float >& VTraceBatchHandler::getPulseTiming( unsigned int i, int iMaxPos, int fTFirst, int fTLast )
+{
+    int nTrace = ( int )fNSamples;
+    if( nTrace < 2 )
+    {
+        return fpulsetiming;
+    }
+    if( fTFirst < 0 )
+    {
+        fTFirst = 0;
+    }
+    if( fTLast > nTrace - 1 )
+    {
+        fTLast = nTrace - 1;
+    }
+    for( unsigned int m = 0; m < fpulsetiming.size(); m++ )
+    {
+        fpulsetiming[m] = 0.;
+    }
+    unsigned int fpulsetiminglevels_size = fpulsetiminglevels.size();
+    unsigned int m_pos = 0;
+    double i_trace = 0.;
+    double trace_max = getTraceMax( i, iMaxPos );
+    int maxpos = iMaxPos;
+    fpulsetiming[fpulsetiming_maxPV] = ( float )maxpos + 0.5;
+
+    // first half of the pulse
+    // (loop backwards over pulse)
+    bool bBreak = false;
+    int i_start = maxpos;
+    if( i_start > nTrace - 2 )
+    {
+        i_start = nTrace - 2;
+    }
+    for( int s = i_start; s >= fTFirst ; s-- )
+    {
+        i_trace = getSample( i, s ) - fPed[i];
+        for( unsigned int m = 0; m < fpulsetiming_maxPV; m++ )
+        {
+            m_pos = fpulsetiming_maxPV - 1 - m;
+            if( m_pos < fpulsetiminglevels_size && fpulsetiming[m_pos] < 1.e-5 )
+            {
+                if( i_trace < fpulsetiminglevels[m_pos] * trace_max )
+                {
+                    fpulsetiming[m_pos] = VTraceHandler::getLinInterpol( fpulsetiminglevels[m_pos] * trace_max, s, i_trace,
+                                          s + 1, getSample( i, s + 1 ) - fPed[i] );
+                    if( m_pos == 0 )
+                    {
+                        bBreak = true;
+                    }
+                }
+            }
+        }
+        if( bBreak )
+        {
+            break;
+        }
+    }
+    // second half of the pulse
+    // (loop forwards over pulse)
+    bBreak = false;
+    if( maxpos > 0 )
+    {
+        for( int s = maxpos; s < fTLast; s++ )
+        {
+            i_trace = getSample( i, s ) - fPed[i];
+            for( m_pos = fpulsetiming_maxPV + 1; m_pos < fpulsetiminglevels_size; m_pos++ )
+            {
+                if( fpulsetiming[m_pos] < 1.e-5 )
+                {
+                    if( i_trace < fpulsetiminglevels[m_pos] * trace_max )
+                    {
+                        fpulsetiming[m_pos] = VTraceHandler::getLinInterpol( fpulsetiminglevels[m_pos] * trace_max, s, i_trace,
+                                              s - 1, getSample( i, s - 1 ) - fPed[i] );
+                        fpulsetiming[m_pos] -= fpulsetiming[fpulsetiminglevels_size - m_pos - 1];
+                        if( m_pos == fpulsetiminglevels_size - 1 )
+                        {
+                            bBreak = true;
+                        }
+                    }
+                }
+            }
+            if( bBreak )
+            {
+                break;
+            }
+        }
+    }
+
+    return fpulsetiming;
+}
+
+vector< double > VTraceBatchHandler::getTrace( unsigned int i )
+{
+    vector< double > iT( fNSamples, 0. );
+    for( unsigned int s = 0; s < fNSamples; s++ )
+    {
+        iT[s] = getSample( i, s );
+    }
+    return iT;
+}
+
+void VTraceBatchHandler::setPulseTimingLevels( vector< float > iP )
+{
+    fpulsetiminglevels = iP;
+    fpulsetiming.assign( fpulsetiminglevels.size(), 0. );
+    fpulsetiming_maxPV = ( fpulsetiminglevels.size() - 1 ) / 2;
+}
@@ -7,9 +7,64 @@
 #include "VTraceHandler.h"
 #include "TMath.h"
 
+/*
+ * sums over FADC trace samples > 0 in [iFirst, iLast)
+ *
+ * iSum:     sum of pedestal subtracted samples
+ * iTCharge: sum of (sample index + 0.5) times pedestal subtracted sample
+ *
+ * (pedestal is subtracted per sample, same summation order as for fpTrace)
+ */
+template< typename T > static void sumTraceSamples( const T* iTrace, int iFirst, int iLast, double iPed,
+        double& iSum, double& iTCharge )
+{
+    for( int i = iFirst; i < iLast; i++ )
+    {
+        if( iTrace[i] > 0 )
+        {
+            iSum     += iTrace[i] - iPed;
+            iTCharge += ( i + 0.5 ) * ( iTrace[i] - iPed );
+        }
+    }
+}
+
+/*
+ * position of the (first) maximum sample in [iFirst, iLast)
+ */
+template< typename T > static int getMaxSample( const T* iTrace, int iFirst, int iLast )
+{
+    int iMaxPos = iFirst;
+    for( int i = iFirst + 1; i < iLast; i++ )
+    {
+        if( iTrace[i] > iTrace[iMaxPos] )
+        {
+            iMaxPos = i;
+        }
+    }
+    return iMaxPos;
+}
+
+/*
+ * copy integer trace into fpTrace
+ */
+template< typename T > static void copyTraceSamples( const T* iTrace, unsigned int iNSamples, vector< double >& iT )
+{
+    if( iNSamples != iT.size() )
+    {
+        iT.resize( iNSamples );
+    }
+    for( unsigned int i = 0; i < iNSamples; i++ )
+    {
+        iT[i] = ( double )iTrace[i];
+    }
+}
+
 VTraceHandler::VTraceHandler()
 {
     fpTrace.assign( 64, 0. );
+    fpTraceView8 = 0;
+    fpTraceView16 = 0;
+    fpTraceFilled = true;
     fPed = 0.;
     fPedrms = 0.;
     fTraceAverageTime = 0.;
@@ -31,6 +86,9 @@ VTraceHandler::VTraceHandler()
 
 void VTraceHandler::reset()
 {
+    fpTraceView8 = 0;
+    fpTraceView16 = 0;
+    fpTraceFilled = true;
     fTraceAverageTime = 0.;
     fSumWindowFirst = 0;
     fSumWindowLast  = 0;
@@ -58,52 +116,112 @@ void VTraceHandler::setTrace( VVirtualDataReader* iReader, unsigned int iNSample
 
     ///////////////////////////////////////
     // copy trace from raw data reader
-    if( iNSamples != fpTrace.size() )
+    fillTrace( iReader, iNSamples, iHitID );
+
+    ////////////////////////////
+    // apply hi-lo gain ratio
+    fHiLo = apply_lowgain( iHiLo );
+}
+
+/*
+ * fill trace from data reader
+ *
+ * samples are read directly from the reader buffer if possible
+ * (the integer samples are then used for integration and maximum search;
+ *  fpTrace is filled only when needed, see fillTraceFromView());
+ * otherwise sample by sample
+ */
+void VTraceHandler::fillTrace( VVirtualDataReader* iReader, unsigned int iNSamples, unsigned int iHitID )
+{
+    fpTraceView8 = 0;
+    fpTraceView16 = 0;
+    fpTraceFilled = true;
+
+    unsigned int iNReaderSamples = 0;
+    if( iReader->has16Bit() )
     {
-        fpTrace.clear();
-        for( unsigned int i = 0; i < iNSamples; i++ )
+        const uint16_t* iT = iReader->getSamplePtr16Bit( iHitID, iNReaderSamples );
+        if( iT && iNReaderSamples >= iNSamples + fMC_FADCTraceStart )
         {
-            fpTrace.push_back( iReader->getSample_double( iHitID, i + fMC_FADCTraceStart, ( i == 0 ) ) );
+            fpTraceView16 = iT + fMC_FADCTraceStart;
+            fpTrazeSize = int( iNSamples );
+            fpTraceFilled = false;
+            return;
         }
     }
-    else for( unsigned int i = 0; i < iNSamples; i++ )
+    else
+    {
+        const uint8_t* iT = iReader->getSamplePtr( iHitID, iNReaderSamples );
+        if( iT && iNReaderSamples >= iNSamples + fMC_FADCTraceStart )
         {
-            fpTrace[i] = iReader->getSample_double( iHitID, i + fMC_FADCTraceStart, ( i == 0 ) );
+            fpTraceView8 = iT + fMC_FADCTraceStart;
+            fpTrazeSize = int( iNSamples );
+            fpTraceFilled = false;
+            return;
         }
+    }
+
+    // sample by sample
+    if( iNSamples != fpTrace.size() )
+    {
+        fpTrace.resize( iNSamples );
+    }
+    for( unsigned int i = 0; i < iNSamples; i++ )
+    {
+        fpTrace[i] = iReader->getSample_double( iHitID, i + fMC_FADCTraceStart, ( i == 0 ) );
+    }
+    fpTrazeSize = int( fpTrace.size() );
+}
 
+void VTraceHandler::fillTrace( const uint8_t* iTrace, unsigned int iNSamples )
+{
+    copyTraceSamples( iTrace, iNSamples, fpTrace );
     fpTrazeSize = int( fpTrace.size() );
+    fpTraceFilled = true;
+}
 
-    ////////////////////////////
-    // apply hi-lo gain ratio
-    fHiLo = apply_lowgain( iHiLo );
+void VTraceHandler::fillTrace( const uint16_t* iTrace, unsigned int iNSamples )
+{
+    copyTraceSamples( iTrace, iNSamples, fpTrace );
+    fpTrazeSize = int( fpTrace.size() );
+    fpTraceFilled = true;
+}
+
+/*
+ * copy samples from reader buffer into fpTrace
+ *
+ * (called by all functions working on the double trace; sums and
+ *  maximum search of high-gain traces use the reader buffer directly)
+ */
+void VTraceHandler::fillTraceFromView()
+{
+    if( fpTraceFilled )
+    {
+        return;
+    }
+    if( fpTraceView8 )
+    {
+        copyTraceSamples( fpTraceView8, ( unsigned int )fpTrazeSize, fpTrace );
+    }
+    else if( fpTraceView16 )
+    {
+        copyTraceSamples( fpTraceView16, ( unsigned int )fpTrazeSize, fpTrace );
+    }
+    fpTraceFilled = true;
 }
 
 /*
  *  used only for time jitter calibration
  *
  */
-void VTraceHandler::setTrace( vector<uint16_t> pTrace, double ped, double pedrms, unsigned int iChanID, double iHiLo )
+void VTraceHandler::setTrace( const vector<uint16_t>& pTrace, double ped, double pedrms, unsigned int iChanID, double iHiLo )
 {
     fPed = ped;
     fPedrms = pedrms;
     fChanID = iChanID;
     reset();
     // copy trace
-    unsigned int i_tsize = pTrace.size();
-    if( i_tsize != fpTrace.size() )
-    {
-        fpTrace.clear();
-        for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace.push_back( ( double )pTrace[i] );
-        }
-    }
-    else for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace[i] = ( double )pTrace[i];
-        }
-
-    fpTrazeSize = int( fpTrace.size() );
+    fillTrace( pTrace.size() > 0 ? &pTrace[0] : 0, pTrace.size() );
     fHiLo = apply_lowgain( iHiLo );
 }
 
@@ -111,31 +229,14 @@ void VTraceHandler::setTrace( vector<uint16_t> pTrace, double ped, double pedrms
  *  used only for time jitter calibration
  *
  */
-void VTraceHandler::setTrace( vector<uint8_t> pTrace, double ped, double pedrms, unsigned int iChanID, double iHiLo )
+void VTraceHandler::setTrace( const vector<uint8_t>& pTrace, double ped, double pedrms, unsigned int iChanID, double iHiLo )
 {
     fPed = ped;
     fPedrms = pedrms;
     fChanID = iChanID;
     reset();
     // copy trace
-    unsigned int i_tsize = pTrace.size();
-    if( i_tsize != fpTrace.size() )
-    {
-        fpTrace.clear();
-        for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace.push_back( ( double )pTrace[i] );
-        }
-    }
-    else
-    {
-        for( unsigned int i = 0; i < i_tsize; i++ )
-        {
-            fpTrace[i] = ( double )pTrace[i];
-        }
-    }
-
-    fpTrazeSize = int( fpTrace.size() );
+    fillTrace( pTrace.size() > 0 ? &pTrace[0] : 0, pTrace.size() );
     fHiLo = apply_lowgain( iHiLo );
 }
 
@@ -145,6 +246,10 @@ bool VTraceHandler::apply_lowgain( double iHiLo )
     // hilo switch is set
     if( iHiLo > 0. )
     {
+        // trace differs from reader samples
+        fillTraceFromView();
+        fpTraceView8 = 0;
+        fpTraceView16 = 0;
         for( int i = 0; i < fpTrazeSize; i++ )
         {
             fpTrace[i]  = ( fpTrace[i] - fPed ) * iHiLo;
@@ -164,22 +269,40 @@ double VTraceHandler::calculateTraceSum_fixedWindow( int fFirst, int fLast, bool
     double sum = 0.;
     double tcharge = 0.;
     fTraceAverageTime = 0.;
-    for( int i = fFirst; i < fLast; i++ )
+    // integer samples from reader (no copy into fpTrace)
+    if( ( fpTraceView8 || fpTraceView16 ) && fFirst >= 0 )
     {
-        // require that trace is > 0.
-        // (this might introduce a positive-charge bias
-        //  for pedestal subtracted traces)
-        if( i < fpTrazeSize && fpTrace[i] > 0. )
+        int iLast = ( fLast < fpTrazeSize ? fLast : fpTrazeSize );
+        double iPed = ( iRaw ? 0. : fPed );
+        if( fpTraceView8 )
         {
-            if( !iRaw )
-            {
-                sum += fpTrace[i] - fPed;
-                tcharge += ( i + 0.5 ) * ( fpTrace[i] - fPed );
-            }
-            else
+            sumTraceSamples( fpTraceView8, fFirst, iLast, iPed, sum, tcharge );
+        }
+        else
+        {
+            sumTraceSamples( fpTraceView16, fFirst, iLast, iPed, sum, tcharge );
+        }
+    }
+    else
+    {
+        fillTraceFromView();
+        for( int i = fFirst; i < fLast; i++ )
+        {
+            // require that trace is > 0.
+            // (this might introduce a positive-charge bias
+            //  for pedestal subtracted traces)
+            if( i < fpTrazeSize && fpTrace[i] > 0. )
             {
-                sum += fpTrace[i];
-                tcharge += ( i + 0.5 ) * fpTrace[i];
+                if( !iRaw )
+                {
+                    sum += fpTrace[i] - fPed;
+                    tcharge += ( i + 0.5 ) * ( fpTrace[i] - fPed );
+                }
+                else
+                {
+                    sum += fpTrace[i];
+                    tcharge += ( i + 0.5 ) * fpTrace[i];
+                }
             }
         }
     }
@@ -209,6 +332,7 @@ double VTraceHandler::getQuickTZero( int fFirst, int fLast )
 double VTraceHandler::getQuickTZero( int fFirst, int fLast, int fTFirst )
 {
     cout << "VTraceHandler::getQuickTZero: WARNING DO NOT USE; FUNCTION OBSOLETE; USE VTraceHandler::getPulseTiming" << endl;
+    fillTraceFromView();
     if( fFirst < 0 )
     {
         fFirst = 0;
@@ -251,6 +375,7 @@ double VTraceHandler::getQuickTZero( int fFirst, int fLast, int fTFirst )
 */
 vector<float> VTraceHandler::getFADCTiming( int fFirst, int fLast, bool debug )
 {
+    fillTraceFromView();
 
     if( fLast - fFirst <= 20 ) // small readout window -> don't bother with extra step
     {
@@ -320,6 +445,7 @@ vector<float> VTraceHandler::getFADCTiming( int fFirst, int fLast, bool debug )
 
 vector< float >& VTraceHandler::getPulseTiming( int fFirst, int fLast, int fTFirst, int fTLast )
 {
+    fillTraceFromView();
     if( fFirst < 0 )
     {
         fFirst = 0;
@@ -452,13 +578,30 @@ void VTraceHandler::getQuickMax( int fFirst, int fLast, double& tmax, int& maxpo
     {
         if( fFirst >= 0 && fFirst < fLast && fLast <= fpTrazeSize )
         {
-            for( int i = fFirst; i < fLast; i++ )
+            // integer samples from reader
+            if( fpTraceView8 || fpTraceView16 )
             {
-                it = fpTrace[i];
-                if( it > tmax )
+                if( fpTraceView8 )
                 {
-                    tmax = it;
-                    maxpos = i;
+                    maxpos = getMaxSample( fpTraceView8, fFirst, fLast );
+                    tmax = fpTraceView8[maxpos];
+                }
+                else
+                {
+                    maxpos = getMaxSample( fpTraceView16, fFirst, fLast );
+                    tmax = fpTraceView16[maxpos];
+                }
+            }
+            else
+            {
+                for( int i = fFirst; i < fLast; i++ )
+                {
+                    it = fpTrace[i];
+                    if( it > tmax )
+                    {
+                        tmax = it;
+                        maxpos = i;
+                    }
                 }
             }
             tmax -= fPed;
@@ -472,6 +615,7 @@ void VTraceHandler::getQuickMax( int fFirst, int fLast, double& tmax, int& maxpo
     {
         if( fFirst >= 0 && fFirst < fLast && fLast <= fpTrazeSize )
         {
+            fillTraceFromView();
             // start search at end of the integration window
             for( int i = fLast - 1; i >= fFirst; i-- )
             {
@@ -537,6 +681,7 @@ void VTraceHandler::getTraceMax( double& tmax, double& maxpos )
 double VTraceHandler::getQuickPulseWidth( int fFirst, int fLast, double fPed )
 {
     cout << "VTraceHandler::getQuickPulseWidth: WARNING DO NOT USE; FUNCTION OBSOLETE; USE VTraceHandler::getPulseTiming" << endl;
+    fillTraceFromView();
     double it = 0.;
     double imax = 0.;
     int maxpos = 0;
@@ -671,6 +816,7 @@ double VTraceHandler::getTraceSum( int iSumWindowFirst, int iSumWindowLast, bool
     // find maximum integral
     else if( fTraceIntegrationMethod == 2 )
     {
+        fillTraceFromView();
         if( !kIPRmeasure )
         {
             // special case: search over restricted window
@@ -733,6 +879,7 @@ double VTraceHandler::calculateTraceSum_slidingWindow( unsigned int iSearchStart
         int iIntegrationWindow,
         bool fRaw )
 {
+    fillTraceFromView();
     unsigned int n = fpTrace.size();
 
     // zero length trace
@@ -0,0 +1,672 @@
+/*! \class VTracePulseFitter
+    \brief fixed-function pulse fit to FADC samples
+
+    Fits the trace functions of VFitTraceHandler ("ev": asymmetric Gaussian,
+    "grisu": grisudet single pe pulse shape) to the raw samples of one channel:
+
+    - closed-form start values from the peak sample (parabolic interpolation)
+      and the half-maximum crossings of the rising and falling edges
+    - damped Gauss-Newton (Levenberg-Marquardt) iterations with analytic derivatives
+    - parameter limits as in the TMinuit fit (parameters are clamped to the limits)
+
+    Binning, errors and chi2 are identical to the TH1D/TF1 fit used before
+    (bin centres at sample + 0.5, errors sqrt(|trace-ped| + pedrms^2)/2, pedestal fixed).
+
+    No heap allocation during the fit (all temporary arrays are on the stack).
+
+*/
+
+#include "VTracePulseFitter.h"
+
+// 5-point Gauss-Legendre quadrature
+static const double fGLX[5] = { -0.906179845938664, -0.538469310105683, 0., 0.538469310105683, 0.906179845938664 };
+static const double fGLW[5] = { 0.236926885056189, 0.478628670499366, 0.568888888888889, 0.478628670499366, 0.236926885056189 };
+
+VTracePulseFitter::VTracePulseFitter( string iFunction )
+{
+    fNMaxIterations = 20;
+    fChi2 = 0.;
+    fNDF = 0;
+    fStatus = 0;
+    fNIterations = 0;
+    fPeakX = 0.;
+    if( !setFunction( iFunction ) )
+    {
+        setFunction( "ev" );
+    }
+}
+
+/*
+    set fit function, parameter limits and fixed parameters
+
+    (see VFitTraceHandler_tracefunction() and VFitTraceHandler_tracefunction_Grisu())
+*/
+bool VTracePulseFitter::setFunction( string iFunction )
+{
+    if( iFunction != "ev" && iFunction != "grisu" )
+    {
+        return false;
+    }
+    for( unsigned int i = 0; i < fMaxPar; i++ )
+    {
+        fPar[i] = 0.;
+        fFixed[i] = false;
+        fParMin[i] = -1.e30;
+        fParMax[i] = 1.e30;
+    }
+    // parameters: constant, mean, sigma, alpha, pedestal
+    if( iFunction == "ev" )
+    {
+        fFunction = 0;
+        fNPar = 5;
+        // constant always negative
+        fParMin[0] = -5.e5;
+        fParMax[0] = 0.;
+        fParMin[2] = 0.01;
+        fParMax[2] = 20.;
+        fParMin[3] = 0.;
+        fParMax[3] = 20.;
+        fFixed[4] = true;
+    }
+    // parameters: rise time, fall time, RC, start time, constant, pedestal
+    else
+    {
+        fFunction = 1;
+        fNPar = 6;
+        // (rise time of zero is not defined)
+        fParMin[0] = 0.01;
+        fParMax[0] = 20.;
+        fParMin[1] = 0.;
+        fParMax[1] = 2000.;
+        fFixed[2] = true;
+        fFixed[5] = true;
+    }
+    return true;
+}
+
+/*
+    trace function "ev" (negative pulse)
+
+    see VFitTraceHandler_tracefunction()
+*/
+double VTracePulseFitter::evalEV( double x, const double* p )
+{
+    double xd = x - p[1];
+    if( x < p[1] )
+    {
+        return p[0] * exp( -0.5 * xd * xd / p[2] / p[2] ) + p[4];
+    }
+    return p[0] * exp( -0.5 * xd * xd / ( p[2] * p[2] + ( p[3] * xd ) ) ) + p[4];
+}
+
+/*
+    trace function "grisu" (negative pulse)
+
+    see VFitTraceHandler_tracefunction_Grisu()
+*/
+double VTracePulseFitter::evalGrisu( double x, const double* p )
+{
+    double t = x - p[3];
+    if( t < 0. )
+    {
+        return p[5];
+    }
+    double wid = p[0] + p[1];
+    if( t < wid )
+    {
+        double alpha = wid / p[0] - 1.0;
+        double renorm = pow( wid, alpha + 2 ) / ( ( alpha + 1 ) * ( alpha + 2 ) );
+        return p[4] * t * pow( wid - t, alpha ) / renorm + p[5];
+    }
+    // AC coupling over-shoot
+    if( p[2] > 0. )
+    {
+        return -p[4] * exp( -( t - wid ) / p[2] ) / p[2] + p[5];
+    }
+    return p[5];
+}
+
+/*
+    derivatives of the trace function with respect to all parameters at x
+*/
+void VTracePulseFitter::getDerivatives( double x, const double* p, double* iDf )
+{
+    for( unsigned int i = 0; i < fMaxPar; i++ )
+    {
+        iDf[i] = 0.;
+    }
+    ///////////////////////////////////
+    // ev
+    if( fFunction == 0 )
+    {
+        double xd = x - p[1];
+        iDf[4] = 1.;
+        if( x < p[1] )
+        {
+            double is2 = 1. / ( p[2] * p[2] );
+            double e = exp( -0.5 * xd * xd * is2 );
+            iDf[0] = e;
+            iDf[1] = p[0] * e * xd * is2;
+            iDf[2] = p[0] * e * xd * xd * is2 / p[2];
+        }
+        else
+        {
+            double D = p[2] * p[2] + p[3] * xd;
+            if( D <= 0. )
+            {
+                return;
+            }
+            double iD2 = 1. / ( D * D );
+            double e = exp( -0.5 * xd * xd / D );
+            iDf[0] = e;
+            iDf[1] = p[0] * e * xd * ( 2. * D - xd * p[3] ) * 0.5 * iD2;
+            iDf[2] = p[0] * e * xd * xd * p[2] * iD2;
+            iDf[3] = p[0] * e * 0.5 * xd * xd * xd * iD2;
+        }
+        return;
+    }
+    ///////////////////////////////////
+    // grisu (AC coupling over-shoot is not fitted)
+    iDf[5] = 1.;
+    double t = x - p[3];
+    double wid = p[0] + p[1];
+    if( t <= 0. || wid - t < 1.e-9 )
+    {
+        return;
+    }
+    double alpha = p[1] / p[0];
+    double renorm = pow( wid, alpha + 2 ) / ( ( alpha + 1 ) * ( alpha + 2 ) );
+    double pw = pow( wid - t, alpha );
+    double g = t * pw / renorm;
+    // d ln(g) / d wid and d ln(g) / d alpha
+    double dw = alpha / ( wid - t ) - ( alpha + 2. ) / wid;
+    double da = log( ( wid - t ) / wid ) + 1. / ( alpha + 1. ) + 1. / ( alpha + 2. );
+    iDf[0] = p[4] * g * ( dw - da * p[1] / ( p[0] * p[0] ) );
+    iDf[1] = p[4] * g * ( dw + da / p[0] );
+    iDf[3] = -1. * p[4] * pw * ( wid - t - alpha * t ) / ( ( wid - t ) * renorm );
+    iDf[4] = g;
+}
+
+/*
+    chi2 for parameters p
+
+    if iJTJ is given, fill normal equations (J^T W J and J^T W r) for the free parameters
+*/
+double VTracePulseFitter::getChi2( const double* iTrace, const double* iWeight, unsigned int iNSamples, const double* p,
+                                   double* iJTJ, double* iJTr, const unsigned int* iFree, unsigned int iNFree )
+{
+    double chi2 = 0.;
+    double df[fMaxPar];
+    if( iJTJ )
+    {
+        for( unsigned int k = 0; k < iNFree * iNFree; k++ )
+        {
+            iJTJ[k] = 0.;
+        }
+        for( unsigned int k = 0; k < iNFree; k++ )
+        {
+            iJTr[k] = 0.;
+        }
+    }
+    for( unsigned int i = 0; i < iNSamples; i++ )
+    {
+        if( iWeight[i] <= 0. )
+        {
+            continue;
+        }
+        double x = ( double )i + 0.5;
+        double r = -1. * iTrace[i] - ( fFunction == 0 ? evalEV( x, p ) : evalGrisu( x, p ) );
+        chi2 += r * r * iWeight[i];
+        if( iJTJ )
+        {
+            getDerivatives( x, p, df );
+            for( unsigned int k = 0; k < iNFree; k++ )
+            {
+                double wk = iWeight[i] * df[iFree[k]];
+                iJTr[k] += wk * r;
+                for( unsigned int l = 0; l <= k; l++ )
+                {
+                    iJTJ[k * iNFree + l] += wk * df[iFree[l]];
+                }
+            }
+        }
+    }
+    if( iJTJ )
+    {
+        for( unsigned int k = 0; k < iNFree; k++ )
+        {
+            for( unsigned int l = 0; l < k; l++ )
+            {
+                iJTJ[l * iNFree + k] = iJTJ[k * iNFree + l];
+            }
+        }
+    }
+    return chi2;
+}
+
+/*
+    solve A x = b (A symmetric positive definite, Cholesky decomposition)
+
+    solution is returned in b
+*/
+bool VTracePulseFitter::solve( double* iA, double* b, unsigned int n )
+{
+    for( unsigned int j = 0; j < n; j++ )
+    {
+        double d = iA[j * n + j];
+        for( unsigned int k = 0; k < j; k++ )
+        {
+            d -= iA[j * n + k] * iA[j * n + k];
+        }
+        if( d <= 0. || !std::isfinite( d ) )
+        {
+            return false;
+        }
+        d = sqrt( d );
+        iA[j * n + j] = d;
+        for( unsigned int i = j + 1; i < n; i++ )
+        {
+            double s = iA[i * n + j];
+            for( unsigned int k = 0; k < j; k++ )
+            {
+                s -= iA[i * n + k] * iA[j * n + k];
+            }
+            iA[i * n + j] = s / d;
+        }
+    }
+    // forward and backward substitution
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        for( unsigned int k = 0; k < i; k++ )
+        {
+            b[i] -= iA[i * n + k] * b[k];
+        }
+        b[i] /= iA[i * n + i];
+    }
+    for( int i = ( int )n - 1; i >= 0; i-- )
+    {
+        for( unsigned int k = i + 1; k < n; k++ )
+        {
+            b[i] -= iA[k * n + i] * b[k];
+        }
+        b[i] /= iA[i * n + i];
+    }
+    return true;
+}
+
+/*
+    closed-form start values
+
+    peak position from parabolic interpolation around the maximum sample,
+    widths from the half-maximum crossings of the rising and falling edges
+*/
+void VTracePulseFitter::setInitialParameters( const double* iTrace, unsigned int iNSamples, double iPed )
+{
+    unsigned int imax = 0;
+    for( unsigned int i = 1; i < iNSamples; i++ )
+    {
+        if( iTrace[i] > iTrace[imax] )
+        {
+            imax = i;
+        }
+    }
+    double hmax = iTrace[imax] - iPed;
+    double xm = ( double )imax + 0.5;
+    if( imax > 0 && imax + 1 < iNSamples )
+    {
+        double d = iTrace[imax - 1] - 2. * iTrace[imax] + iTrace[imax + 1];
+        if( d < 0. )
+        {
+            xm += 0.5 * ( iTrace[imax - 1] - iTrace[imax + 1] ) / d;
+        }
+    }
+    // half-maximum crossings
+    double half = iPed + 0.5 * hmax;
+    double xl = -1.;
+    for( unsigned int i = imax; i > 0; i-- )
+    {
+        if( iTrace[i - 1] < half )
+        {
+            xl = ( double )i - 0.5 + ( half - iTrace[i - 1] ) / ( iTrace[i] - iTrace[i - 1] );
+            break;
+        }
+    }
+    double xr = -1.;
+    for( unsigned int i = imax; i + 1 < iNSamples; i++ )
+    {
+        if( iTrace[i + 1] < half )
+        {
+            xr = ( double )i + 0.5 + ( iTrace[i] - half ) / ( iTrace[i] - iTrace[i + 1] );
+            break;
+        }
+    }
+    const double i2ln2 = 2. * log( 2. );
+
+    if( fFunction == 0 )
+    {
+        fPar[0] = -1. * hmax;
+        fPar[1] = xm;
+        fPar[2] = 0.6;
+        if( xl >= 0. && xl < xm )
+        {
+            fPar[2] = ( xm - xl ) / sqrt( i2ln2 );
+        }
+        fPar[3] = 1.6;
+        if( xr > xm )
+        {
+            fPar[3] = ( ( xr - xm ) * ( xr - xm ) / i2ln2 - fPar[2] * fPar[2] ) / ( xr - xm );
+        }
+        fPar[4] = -1. * iPed;
+    }
+    else
+    {
+        fPar[0] = 2.4;
+        if( xl >= 0. && xl < xm )
+        {
+            fPar[0] = 2. * ( xm - xl );
+        }
+        fPar[1] = 8.0;
+        if( xr > xm )
+        {
+            fPar[1] = 2. * ( xr - xm );
+        }
+        fPar[2] = 0.;
+        fPar[5] = -1. * iPed;
+    }
+    for( unsigned int i = 0; i < fNPar; i++ )
+    {
+        if( !fFixed[i] )
+        {
+            fPar[i] = ( fPar[i] < fParMin[i] ? fParMin[i] : ( fPar[i] > fParMax[i] ? fParMax[i] : fPar[i] ) );
+        }
+    }
+    // grisu: pulse starts one rise time before the maximum; normalisation from pulse height
+    if( fFunction == 1 )
+    {
+        fPar[3] = xm - fPar[0];
+        double wid = fPar[0] + fPar[1];
+        double alpha = fPar[1] / fPar[0];
+        double renorm = pow( wid, alpha + 2 ) / ( ( alpha + 1 ) * ( alpha + 2 ) );
+        double gmax = fPar[0] * pow( fPar[1], alpha ) / renorm;
+        fPar[4] = ( gmax > 0. && std::isfinite( gmax ) ? -1. * hmax / gmax : -1. * hmax );
+    }
+}
+
+/*
+    fit trace function to the samples iTrace (not pedestal subtracted)
+
+    returns true for successful fits (fit status > 0)
+*/
+bool VTracePulseFitter::fit( const double* iTrace, unsigned int iNSamples, double iPed, double iPedRMS )
+{
+    fChi2 = 0.;
+    fNDF = 0;
+    fStatus = 0;
+    fNIterations = 0;
+    if( !iTrace || iNSamples < 2 )
+    {
+        return false;
+    }
+    setInitialParameters( iTrace, iNSamples, iPed );
+
+    // free parameters
+    unsigned int iFree[fMaxPar];
+    unsigned int nfree = 0;
+    for( unsigned int i = 0; i < fNPar; i++ )
+    {
+        if( !fFixed[i] )
+        {
+            iFree[nfree++] = i;
+        }
+    }
+    fNDF = ( int )iNSamples - ( int )nfree;
+
+    // weights (1/error^2 as in the histogram fit: signal + pedestal rms)
+    const unsigned int i_maxSamples = 512;
+    if( iNSamples > i_maxSamples )
+    {
+        return false;
+    }
+    double iWeight[i_maxSamples];
+    for( unsigned int i = 0; i < iNSamples; i++ )
+    {
+        double e2 = 0.25 * ( fabs( iTrace[i] - iPed ) + iPedRMS * iPedRMS );
+        iWeight[i] = ( e2 > 0. ? 1. / e2 : 0. );
+    }
+
+    double iJTJ[fMaxPar * fMaxPar];
+    double iJTr[fMaxPar];
+    double iJTJ_t[fMaxPar * fMaxPar];
+    double iJTr_t[fMaxPar];
+    double iA[fMaxPar * fMaxPar];
+    double b[fMaxPar];
+    double p_t[fMaxPar];
+
+    double chi2 = getChi2( iTrace, iWeight, iNSamples, fPar, iJTJ, iJTr, iFree, nfree );
+    if( !std::isfinite( chi2 ) )
+    {
+        return false;
+    }
+    double lambda = 1.e-3;
+    bool bConverged = false;
+    for( unsigned int n = 0; n < fNMaxIterations; n++ )
+    {
+        fNIterations++;
+        // damped normal equations
+        for( unsigned int k = 0; k < nfree * nfree; k++ )
+        {
+            iA[k] = iJTJ[k];
+        }
+        for( unsigned int k = 0; k < nfree; k++ )
+        {
+            iA[k * nfree + k] = ( iJTJ[k * nfree + k] > 0. ? iJTJ[k * nfree + k] * ( 1. + lambda ) : 1. );
+            b[k] = iJTr[k];
+        }
+        if( !solve( iA, b, nfree ) )
+        {
+            lambda *= 10.;
+            continue;
+        }
+        for( unsigned int i = 0; i < fMaxPar; i++ )
+        {
+            p_t[i] = fPar[i];
+        }
+        for( unsigned int k = 0; k < nfree; k++ )
+        {
+            unsigned int i = iFree[k];
+            p_t[i] += b[k];
+            p_t[i] = ( p_t[i] < fParMin[i] ? fParMin[i] : ( p_t[i] > fParMax[i] ? fParMax[i] : p_t[i] ) );
+        }
+        double chi2_t = getChi2( iTrace, iWeight, iNSamples, p_t, iJTJ_t, iJTr_t, iFree, nfree );
+        if( std::isfinite( chi2_t ) && chi2_t <= chi2 )
+        {
+            double dchi2 = chi2 - chi2_t;
+            chi2 = chi2_t;
+            for( unsigned int i = 0; i < fMaxPar; i++ )
+            {
+                fPar[i] = p_t[i];
+            }
+            for( unsigned int k = 0; k < nfree * nfree; k++ )
+            {
+                iJTJ[k] = iJTJ_t[k];
+            }
+            for( unsigned int k = 0; k < nfree; k++ )
+            {
+                iJTr[k] = iJTr_t[k];
+            }
+            lambda = ( lambda > 1.e-7 ? lambda * 0.1 : lambda );
+            if( dchi2 < 1.e-4 * chi2 + 1.e-6 )
+            {
+                bConverged = true;
+                break;
+            }
+        }
+        else
+        {
+            lambda *= 10.;
+            // no improvement possible
+            if( lambda > 1.e8 )
+            {
+                bConverged = true;
+                break;
+            }
+        }
+    }
+    fChi2 = chi2;
+    fStatus = ( bConverged ? 3 : 1 );
+    setPeakPosition();
+
+    return true;
+}
+
+int VTracePulseFitter::getNumberFreeParameters()
+{
+    int n = 0;
+    for( unsigned int i = 0; i < fNPar; i++ )
+    {
+        if( !fFixed[i] )
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+/*
+    position of pulse maximum (minimum of the negative trace function)
+*/
+void VTracePulseFitter::setPeakPosition()
+{
+    if( fFunction == 0 )
+    {
+        fPeakX = fPar[1];
+    }
+    else
+    {
+        fPeakX = fPar[3] + fPar[0];
+    }
+}
+
+/*
+    position of the minimum of the trace function in [xmin, xmax]
+
+    (pulse functions are unimodal, maximum is at mean (ev) or at start + rise time (grisu))
+*/
+double VTracePulseFitter::getMinimumX( double xmin, double xmax ) const
+{
+    // positive pulse (not expected)
+    if( ( fFunction == 0 && fPar[0] > 0. ) || ( fFunction == 1 && fPar[4] > 0. ) )
+    {
+        return ( eval( xmin ) < eval( xmax ) ? xmin : xmax );
+    }
+    if( fPeakX < xmin )
+    {
+        return xmin;
+    }
+    if( fPeakX > xmax )
+    {
+        return xmax;
+    }
+    return fPeakX;
+}
+
+/*
+    x in [xmin, xmax] with f(x) = y (bisection; the trace function is monotonic on
+    both sides of the maximum)
+*/
+double VTracePulseFitter::getX( double y, double xmin, double xmax ) const
+{
+    double fmin = eval( xmin ) - y;
+    double fmax = eval( xmax ) - y;
+    if( fmin * fmax > 0. )
+    {
+        return ( fabs( fmin ) < fabs( fmax ) ? xmin : xmax );
+    }
+    for( unsigned int n = 0; n < 50; n++ )
+    {
+        double xm = 0.5 * ( xmin + xmax );
+        double fm = eval( xm ) - y;
+        if( fm * fmin > 0. )
+        {
+            xmin = xm;
+            fmin = fm;
+        }
+        else
+        {
+            xmax = xm;
+        }
+    }
+    return 0.5 * ( xmin + xmax );
+}
+
+/*
+    integral of the trace function from a to b
+
+    Gauss-Legendre quadrature per sample; intervals are split at the kinks of the trace function
+*/
+double VTracePulseFitter::getIntegral( double a, double b ) const
+{
+    if( b < a )
+    {
+        return -1. * getIntegral( b, a );
+    }
+    double x[4];
+    unsigned int nx = 0;
+    x[nx++] = a;
+    if( fFunction == 0 )
+    {
+        if( fPar[1] > a && fPar[1] < b )
+        {
+            x[nx++] = fPar[1];
+        }
+    }
+    else
+    {
+        if( fPar[3] > a && fPar[3] < b )
+        {
+            x[nx++] = fPar[3];
+        }
+        double xe = fPar[3] + fPar[0] + fPar[1];
+        if( xe > a && xe < b && xe > x[nx - 1] )
+        {
+            x[nx++] = xe;
+        }
+    }
+    x[nx++] = b;
+
+    double sum = 0.;
+    for( unsigned int s = 0; s + 1 < nx; s++ )
+    {
+        unsigned int n = ( unsigned int )ceil( x[s + 1] - x[s] );
+        if( n == 0 )
+        {
+            continue;
+        }
+        double h = ( x[s + 1] - x[s] ) / ( double )n;
+        for( unsigned int i = 0; i < n; i++ )
+        {
+            double xc = x[s] + ( i + 0.5 ) * h;
+            for( unsigned int g = 0; g < 5; g++ )
+            {
+                sum += 0.5 * h * fGLW[g] * eval( xc + 0.5 * h * fGLX[g] );
+            }
+        }
+    }
+    return sum;
+}
+
+void VTracePulseFitter::print()
+{
+    cout << "VTracePulseFitter (" << ( fFunction == 0 ? "ev" : "grisu" ) << "): ";
+    cout << "status " << fStatus << ", iterations " << fNIterations;
+    cout << ", chi2/ndf " << fChi2 << "/" << fNDF << endl;
+    for( unsigned int i = 0; i < fNPar; i++ )
+    {
+        cout << "\t parameter " << i << ": " << fPar[i];
+        if( fFixed[i] )
+        {
+            cout << " (fixed)";
+        }
+        cout << endl;
+    }
+}
@@ -0,0 +1,164 @@
+/*! \file bench_evndisp.cpp
+    \brief evndisp benchmark with synthetic events
+
+    runs the full event analysis (calibration, trace integration, image cleaning,
+    image parameterisation, array reconstruction, tree filling) on synthetic
+    VERITAS-like events (source type 8) without data files or database access.
+    Per-stage timings are printed and can be written to or compared with
+    a baseline file.
+
+    usage:
+
+    bench_evndisp [-baseline FILE] [-writebaseline FILE] [-tolerance=FLOAT] [evndisp options]
+
+    -baseline FILE        compare wall time per event of all stages with this baseline file
+                          (return value is 1 if at least one stage is slower than the baseline;
+                          reference baseline for the default settings: docs/bench_evndisp.baseline)
+    -writebaseline FILE   write wall time per event of all stages to this file
+    -tolerance=FLOAT      allowed fractional slowdown per stage (default=0.2)
+
+    all other options are passed to evndisp, e.g.
+
+    -nevents=INT          number of synthetic events (default=1000)
+    -synthnpixel=INT, -synthnsamples=INT, -synthimagesize=FLOAT, -synthnsb=FLOAT
+    -nthreads=INT, -imagecleaningmethod, -loglminloss, ...
+
+    no auxiliary data files are needed: a minimal set of parameter files is written
+    to ./bench_evndisp.aux/ (see VSyntheticDataReader::setParameterFiles())
+
+*/
+
+#include <TMinuit.h>
+#include <TStopwatch.h>
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "VEventLoop.h"
+#include "VReadRunParameter.h"
+#include "VSyntheticDataReader.h"
+
+using namespace std;
+
+// fitter for log likelihood, has to be global
+TMinuit* fLLFitter;
+
+/*
+ * option name of a command line argument (-option=value -> -option)
+ */
+string getOptionName( string iArg )
+{
+    return iArg.substr( 0, iArg.find( "=" ) );
+}
+
+int main( int argc, char* argv[] )
+{
+    TStopwatch fStopWatch;
+    fStopWatch.Start();
+
+    string fBaselineFile = "";
+    string fWriteBaselineFile = "";
+    double fTolerance = 0.2;
+    bool bNEvents = false;
+    bool bOutput = false;
+
+    // parameter files for synthetic events (independent of $VERITAS_EVNDISP_AUX_DIR)
+    if( !VSyntheticDataReader::setParameterFiles( "bench_evndisp.aux" ) )
+    {
+        exit( EXIT_FAILURE );
+    }
+
+    // benchmark options (all other options are passed to evndisp)
+    vector< string > iArgs;
+    iArgs.push_back( argv[0] );
+    iArgs.push_back( "-sourcetype=8" );
+    iArgs.push_back( "-profile" );
+    iArgs.push_back( "-lowgaincalibrationfile" );
+    iArgs.push_back( "NOFILE" );
+    iArgs.push_back( "-l2setspecialchannels" );
+    iArgs.push_back( "nofile" );
+    for( int i = 1; i < argc; i++ )
+    {
+        string iTemp = argv[i];
+        if( iTemp == "-baseline" && i + 1 < argc )
+        {
+            fBaselineFile = argv[++i];
+        }
+        else if( iTemp == "-writebaseline" && i + 1 < argc )
+        {
+            fWriteBaselineFile = argv[++i];
+        }
+        else if( getOptionName( iTemp ) == "-tolerance" )
+        {
+            fTolerance = atof( iTemp.substr( iTemp.rfind( "=" ) + 1, iTemp.size() ).c_str() );
+        }
+        else
+        {
+            if( getOptionName( iTemp ) == "-nevents" )
+            {
+                bNEvents = true;
+            }
+            else if( iTemp == "-output" || iTemp == "-outputfile" )
+            {
+                bOutput = true;
+            }
+            iArgs.push_back( iTemp );
+        }
+    }
+    if( !bNEvents )
+    {
+        iArgs.push_back( "-nevents=1000" );
+    }
+    if( !bOutput )
+    {
+        iArgs.push_back( "-output" );
+        iArgs.push_back( "bench_evndisp.root" );
+    }
+    vector< char* > iArgv;
+    for( unsigned int i = 0; i < iArgs.size(); i++ )
+    {
+        iArgv.push_back( const_cast< char* >( iArgs[i].c_str() ) );
+    }
+
+    // read the command line parameters
+    VReadRunParameter* fReadRunParameter = new VReadRunParameter();
+    if( !fReadRunParameter->readCommandline( ( int )iArgv.size(), &iArgv[0] ) )
+    {
+        exit( EXIT_FAILURE );
+    }
+    fReadRunParameter->getRunParameter()->fdisplaymode = false;
+    fReadRunParameter->getRunParameter()->print();
+
+    // analysis of synthetic events
+    VEventLoop mainEventLoop( fReadRunParameter->getRunParameter() );
+    if( !mainEventLoop.initEventLoop() )
+    {
+        exit( EXIT_FAILURE );
+    }
+    mainEventLoop.loop( fReadRunParameter->getRunParameter()->fnevents );
+    fStopWatch.Stop();
+    fStopWatch.Print();
+    mainEventLoop.shutdown();
+
+    // compare with baseline
+    int iReturn = 0;
+    if( mainEventLoop.getProfiler() )
+    {
+        unsigned int iNEvents = mainEventLoop.getNumberofGoodEvents();
+        if( fWriteBaselineFile.size() > 0 )
+        {
+            mainEventLoop.getProfiler()->writeBaseline( fWriteBaselineFile, iNEvents );
+        }
+        if( fBaselineFile.size() > 0 )
+        {
+            if( mainEventLoop.getProfiler()->compareWithBaseline( fBaselineFile, iNEvents, fTolerance ) > 0 )
+            {
+                iReturn = 1;
+            }
+        }
+    }
+    delete fReadRunParameter;
+
+    return iReturn;
+}
@@ -15,6 +15,7 @@
 
 #include "VGlobalRunParameter.h"
 #include "VHistogramUtilities.h"
+#include "VTableLookupBinaryFile.h"
 
 #include <fstream>
 #include <iostream>
@@ -74,10 +75,11 @@ int main( int argc, char* argv[] )
     if( argc < 2 )
     {
         cout << "combine several tables from different files into one single table file" << endl << endl;
-        cout << "combineLookupTables <file with list of tables> <output file name> [histogram types to copy] [noise tolerance]" << endl;
+        cout << "combineLookupTables <file with list of tables> <output file name> [histogram types to copy] [noise tolerance] [binary table file]" << endl;
         cout << endl;
         cout << "[histogram types]:    all, mpv, median (default)" << endl;
         cout << "[noise tolerance]:    tolerance for combining NSB bins (default==20)" << endl;
+        cout << "[binary table file]:  write in addition a flat binary table file (memory mapped by mscw_energy)" << endl;
         cout << endl;
         exit( EXIT_FAILURE );
     }
@@ -89,10 +91,15 @@ int main( int argc, char* argv[] )
         histogram_types = argv[3];
     }
     float noise_tolerance = 20.;
-    if( argc == 5 )
+    if( argc >= 5 )
     {
         noise_tolerance = atof( argv[4] );
     }
+    string fBinaryFile = "";
+    if( argc >= 6 )
+    {
+        fBinaryFile = argv[5];
+    }
 
     vector< string > hist_to_copy;
     if( histogram_types == "all" )
@@ -178,6 +185,20 @@ int main( int argc, char* argv[] )
     }
 
     fROFile->Close();
+
+    // flat binary table file
+    if( fBinaryFile.size() > 0 )
+    {
+        cout << endl;
+        cout << "converting " << fOFile << " into binary table file " << fBinaryFile << endl;
+        fROFile = new TFile( fOFile.c_str() );
+        if( fROFile->IsZombie() || !VTableLookupBinaryFile::convert( fROFile, fBinaryFile ) )
+        {
+            cout << "error while writing binary table file: " << fBinaryFile << endl;
+            exit( EXIT_FAILURE );
+        }
+        fROFile->Close();
+    }
     cout << endl;
     cout << "finished..." << endl;
 }
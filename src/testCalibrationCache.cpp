@@ -0,0 +1,213 @@
+/*! \file testCalibrationCache
+ *  \brief test binary calibration cache files (VCalibrationCache)
+ *
+ *  - calibration arrays written into a cache file are read back unchanged
+ *  - files written with a different key are not accepted
+ *  - array lengths above the expected number of channels / summation
+ *    windows are rejected
+ *
+ */
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdlib.h>
+#include <string>
+#include <valarray>
+#include <vector>
+
+#include "VCalibrationCache.h"
+
+using namespace std;
+
+const unsigned int fNChannels = 499;
+const unsigned int fNSumWindows = 25;
+
+/*
+ * cache key as used by VCalibrator::getCalibrationCacheFileName()
+ */
+void fillKey( VCalibrationCache& iCache, double iGainCorrection, int iRun )
+{
+    iCache.addParameter( "tel", 0 );
+    iCache.addParameter( "run", iRun );
+    iCache.addParameter( "isMC", 0 );
+    iCache.addParameter( "gainCorrection", iGainCorrection );
+    iCache.addParameter( "nchannels", fNChannels );
+    iCache.addFile( "ped", "testCalibrationCache_nonexisting_pedestal_file" );
+}
+
+/*
+ * write cache file; the length of the second array is iNChannels_written
+ */
+bool writeCache( VCalibrationCache& iCache, string iFile, unsigned int iNChannels_written,
+                 const valarray< double >& iPeds, const vector< valarray< double > >& iPedvars,
+                 const valarray< valarray< valarray< double > > >& iTS_Pedvars,
+                 const map< pair< int, int >, double >& iMult, const string& iName )
+{
+    ofstream os( iFile.c_str(), ios::out | ios::binary );
+    if( !os )
+    {
+        return false;
+    }
+    iCache.writeHeader( os );
+    VCalibrationCache::write( os, iPeds );
+    // gains (length prefix only for inconsistent lengths)
+    if( iNChannels_written == iPeds.size() )
+    {
+        valarray< double > iGains( 1.1, iNChannels_written );
+        VCalibrationCache::write( os, iGains );
+    }
+    else
+    {
+        VCalibrationCache::write( os, iNChannels_written );
+    }
+    VCalibrationCache::write( os, iPedvars );
+    VCalibrationCache::write( os, iTS_Pedvars );
+    VCalibrationCache::write( os, iMult );
+    VCalibrationCache::write( os, iName );
+    os.close();
+    return !os.fail();
+}
+
+int main( int argc, char* argv[] )
+{
+    unsigned int nFailed = 0;
+
+    // calibration arrays
+    valarray< double > iPeds( fNChannels );
+    for( unsigned int i = 0; i < fNChannels; i++ )
+    {
+        iPeds[i] = 15. + 0.01 * i;
+    }
+    valarray< double > iPedvar( 0.1 * iPeds );
+    valarray< double > iTS_Pedvar( 0.2 * iPeds );
+    vector< valarray< double > > iPedvars( fNSumWindows, iPedvar );
+    valarray< valarray< double > > iTS_Pedvars_w( iTS_Pedvar, fNSumWindows );
+    valarray< valarray< valarray< double > > > iTS_Pedvars( iTS_Pedvars_w, 3 );
+    map< pair< int, int >, double > iMult;
+    iMult[make_pair( 0, 6 )] = 5.8;
+    iMult[make_pair( 1, 12 )] = 6.1;
+    string iName = "lowgain_pedestals.root";
+
+    VCalibrationCache iCacheW;
+    fillKey( iCacheW, 1.0, 64080 );
+    string iFile = iCacheW.getFileName( ".", 0, 64080, 6, 12 );
+
+    //////////////////////////////////////
+    // round trip
+    if( !writeCache( iCacheW, iFile, fNChannels, iPeds, iPedvars, iTS_Pedvars, iMult, iName ) )
+    {
+        cout << "testCalibrationCache: error writing " << iFile << endl;
+        exit( EXIT_FAILURE );
+    }
+    {
+        VCalibrationCache iCacheR;
+        fillKey( iCacheR, 1.0, 64080 );
+        ifstream is( iFile.c_str(), ios::in | ios::binary );
+        valarray< double > rPeds;
+        valarray< double > rGains;
+        vector< valarray< double > > rPedvars;
+        valarray< valarray< valarray< double > > > rTS_Pedvars;
+        map< pair< int, int >, double > rMult;
+        string rName;
+        if( iCacheR.getFileName( ".", 0, 64080, 6, 12 ) != iFile || !iCacheR.readHeader( is ) )
+        {
+            cout << "round trip: cache key not accepted" << endl;
+            nFailed++;
+        }
+        else
+        {
+            VCalibrationCache::read( is, rPeds, fNChannels );
+            VCalibrationCache::read( is, rGains, fNChannels );
+            VCalibrationCache::read( is, rPedvars, fNSumWindows, fNChannels );
+            VCalibrationCache::read( is, rTS_Pedvars, VCalibrationCache::fMaxTimeSlices, fNSumWindows, fNChannels );
+            VCalibrationCache::read( is, rMult, 2 * fNSumWindows * fNSumWindows );
+            VCalibrationCache::read( is, rName, 10000 );
+            bool bOK = is.good();
+            bOK = bOK && rPeds.size() == iPeds.size() && rGains.size() == fNChannels;
+            bOK = bOK && rPedvars.size() == iPedvars.size() && rTS_Pedvars.size() == iTS_Pedvars.size();
+            bOK = bOK && rMult == iMult && rName == iName;
+            for( unsigned int i = 0; bOK && i < iPeds.size(); i++ )
+            {
+                bOK = ( rPeds[i] == iPeds[i] && rGains[i] == 1.1 );
+            }
+            for( unsigned int w = 0; bOK && w < iPedvars.size(); w++ )
+            {
+                bOK = ( rPedvars[w].size() == fNChannels );
+                for( unsigned int i = 0; bOK && i < fNChannels; i++ )
+                {
+                    bOK = ( rPedvars[w][i] == iPedvars[w][i] );
+                }
+            }
+            for( unsigned int t = 0; bOK && t < iTS_Pedvars.size(); t++ )
+            {
+                bOK = ( rTS_Pedvars[t].size() == fNSumWindows );
+                for( unsigned int w = 0; bOK && w < fNSumWindows; w++ )
+                {
+                    bOK = ( rTS_Pedvars[t][w].size() == fNChannels );
+                    for( unsigned int i = 0; bOK && i < fNChannels; i++ )
+                    {
+                        bOK = ( rTS_Pedvars[t][w][i] == iTS_Pedvars[t][w][i] );
+                    }
+                }
+            }
+            if( !bOK )
+            {
+                cout << "round trip: calibration data differ" << endl;
+                nFailed++;
+            }
+        }
+    }
+
+    //////////////////////////////////////
+    // key mismatch (different gain correction or run number)
+    for( unsigned int k = 0; k < 2; k++ )
+    {
+        VCalibrationCache iCacheR;
+        fillKey( iCacheR, ( k == 0 ? 0.9 : 1.0 ), ( k == 1 ? 64081 : 64080 ) );
+        ifstream is( iFile.c_str(), ios::in | ios::binary );
+        if( iCacheR.readHeader( is ) )
+        {
+            cout << "key mismatch: cache file accepted for " << ( k == 0 ? "different gain correction" : "different run" ) << endl;
+            nFailed++;
+        }
+    }
+
+    //////////////////////////////////////
+    // array length above expected number of channels
+    if( !writeCache( iCacheW, iFile, 1000000000, iPeds, iPedvars, iTS_Pedvars, iMult, iName ) )
+    {
+        cout << "testCalibrationCache: error writing " << iFile << endl;
+        exit( EXIT_FAILURE );
+    }
+    {
+        VCalibrationCache iCacheR;
+        fillKey( iCacheR, 1.0, 64080 );
+        ifstream is( iFile.c_str(), ios::in | ios::binary );
+        valarray< double > rPeds;
+        valarray< double > rGains;
+        if( !iCacheR.readHeader( is ) )
+        {
+            cout << "inconsistent length: cache key not accepted" << endl;
+            nFailed++;
+        }
+        else
+        {
+            VCalibrationCache::read( is, rPeds, fNChannels );
+            VCalibrationCache::read( is, rGains, fNChannels );
+            if( is.good() || rGains.size() != 0 )
+            {
+                cout << "inconsistent length: array with " << rGains.size() << " channels accepted" << endl;
+                nFailed++;
+            }
+        }
+    }
+    remove( iFile.c_str() );
+
+    if( nFailed > 0 )
+    {
+        cout << "testCalibrationCache: " << nFailed << " tests failed" << endl;
+        exit( EXIT_FAILURE );
+    }
+    cout << "testCalibrationCache: all tests passed" << endl;
+}
@@ -0,0 +1,210 @@
+/*! \file testImageAnalysisThreads
+ *  \brief compare evndisp output of the single- and multi-threaded image analysis
+ *
+ *  synthetic events are analysed with bench_evndisp (same directory as this
+ *  program; no data or auxiliary files needed) with -nthreads=1 and -nthreads=N;
+ *  all trees of both output files (except the profile of analysis stages) are
+ *  compared entry by entry and must be identical (NaNs are equal)
+ *
+ *  usage: testImageAnalysisThreads [nthreads (default=4)] [nevents (default=200)]
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+using namespace std;
+
+/*
+ * analyse synthetic events with bench_evndisp
+ */
+string runEvndisp( string iBench, unsigned int iNThreads, unsigned int iNEvents )
+{
+    ostringstream iFile;
+    iFile << "testImageAnalysisThreads.t" << iNThreads << ".root";
+    ostringstream iCommand;
+    iCommand << iBench << " -nevents=" << iNEvents << " -nthreads=" << iNThreads;
+    iCommand << " -output " << iFile.str() << " > " << iFile.str() << ".log 2>&1";
+    cout << "testImageAnalysisThreads: " << iCommand.str() << endl;
+    if( gSystem->Exec( iCommand.str().c_str() ) != 0 )
+    {
+        cout << "testImageAnalysisThreads: error running evndisp (see " << iFile.str() << ".log)" << endl;
+        exit( EXIT_FAILURE );
+    }
+    return iFile.str();
+}
+
+/*
+ * compare two trees entry by entry
+ *
+ * returns number of entries with differences
+ */
+Long64_t compareTrees( string iName, TTree* t1, TTree* t2 )
+{
+    if( !t2 )
+    {
+        cout << iName << ": tree not found in second file" << endl;
+        return 1;
+    }
+    if( t1->GetEntries() != t2->GetEntries() )
+    {
+        cout << iName << ": different number of entries: ";
+        cout << t1->GetEntries() << ", " << t2->GetEntries() << endl;
+        return 1;
+    }
+    vector< TLeaf* > iL1;
+    vector< TLeaf* > iL2;
+    TObjArray* iLeaves = t1->GetListOfLeaves();
+    for( int i = 0; i < iLeaves->GetEntries(); i++ )
+    {
+        TLeaf* l = ( TLeaf* )iLeaves->At( i );
+        TLeaf* l2 = t2->GetLeaf( l->GetName() );
+        if( !l2 )
+        {
+            cout << iName << ": leaf " << l->GetName() << " not found in second file" << endl;
+            return 1;
+        }
+        iL1.push_back( l );
+        iL2.push_back( l2 );
+    }
+
+    unsigned int nDiff = 0;
+    Long64_t nEntriesDiff = 0;
+    for( Long64_t n = 0; n < t1->GetEntries(); n++ )
+    {
+        t1->GetEntry( n );
+        t2->GetEntry( n );
+        bool bDiff = false;
+        for( unsigned int i = 0; i < iL1.size(); i++ )
+        {
+            if( iL1[i]->GetLen() != iL2[i]->GetLen() )
+            {
+                if( nDiff < 20 )
+                {
+                    cout << iName << ", entry " << n << ", " << iL1[i]->GetName() << ": different length ";
+                    cout << iL1[i]->GetLen() << ", " << iL2[i]->GetLen() << endl;
+                }
+                nDiff++;
+                bDiff = true;
+                continue;
+            }
+            for( int j = 0; j < iL1[i]->GetLen(); j++ )
+            {
+                double v1 = iL1[i]->GetValue( j );
+                double v2 = iL2[i]->GetValue( j );
+                if( v1 != v2 && !( std::isnan( v1 ) && std::isnan( v2 ) ) )
+                {
+                    if( nDiff < 20 )
+                    {
+                        cout << iName << ", entry " << n << ", " << iL1[i]->GetName() << "[" << j << "]: ";
+                        cout << v1 << ", " << v2 << endl;
+                    }
+                    nDiff++;
+                    bDiff = true;
+                }
+            }
+        }
+        if( bDiff )
+        {
+            nEntriesDiff++;
+        }
+    }
+    cout << iName << ": " << t1->GetEntries() << " entries and " << iL1.size() << " leaves compared, ";
+    cout << nEntriesDiff << " entries with differences" << endl;
+    return nEntriesDiff;
+}
+
+/*
+ * compare all trees in directory d1 (and its subdirectories) with those in d2
+ */
+Long64_t compareDirectories( TDirectory* d1, TDirectory* d2, unsigned int& iNTrees )
+{
+    Long64_t nEntriesDiff = 0;
+    TIter next( d1->GetListOfKeys() );
+    TKey* iKey = 0;
+    while( ( iKey = ( TKey* )next() ) )
+    {
+        string iName = iKey->GetName();
+        string iClass = iKey->GetClassName();
+        if( iClass == "TDirectoryFile" )
+        {
+            TDirectory* iSub2 = ( TDirectory* )d2->Get( iName.c_str() );
+            if( !iSub2 )
+            {
+                cout << d1->GetPath() << ": directory " << iName << " not found in second file" << endl;
+                nEntriesDiff++;
+                continue;
+            }
+            nEntriesDiff += compareDirectories( ( TDirectory* )d1->Get( iName.c_str() ), iSub2, iNTrees );
+        }
+        // profile contains run times
+        else if( iClass == "TTree" && iName != "profile" )
+        {
+            TTree* t1 = ( TTree* )d1->Get( iName.c_str() );
+            TTree* t2 = ( TTree* )d2->Get( iName.c_str() );
+            nEntriesDiff += compareTrees( string( d1->GetPath() ) + "/" + iName, t1, t2 );
+            iNTrees++;
+        }
+    }
+    return nEntriesDiff;
+}
+
+int main( int argc, char* argv[] )
+{
+    unsigned int iNThreads = 4;
+    unsigned int iNEvents = 200;
+    if( argc > 1 )
+    {
+        iNThreads = atoi( argv[1] );
+    }
+    if( argc > 2 )
+    {
+        iNEvents = atoi( argv[2] );
+    }
+    if( iNThreads < 2 )
+    {
+        cout << "testImageAnalysisThreads: number of threads should be >1" << endl;
+        exit( EXIT_FAILURE );
+    }
+    string iBench = string( gSystem->DirName( argv[0] ) ) + "/bench_evndisp";
+    if( gSystem->AccessPathName( iBench.c_str() ) )
+    {
+        cout << "testImageAnalysisThreads: " << iBench << " not found (make bench_evndisp)" << endl;
+        exit( EXIT_FAILURE );
+    }
+
+    string iFile1 = runEvndisp( iBench, 1, iNEvents );
+    string iFileN = runEvndisp( iBench, iNThreads, iNEvents );
+
+    TFile iF1( iFile1.c_str() );
+    TFile iFN( iFileN.c_str() );
+    if( iF1.IsZombie() || iFN.IsZombie() )
+    {
+        cout << "testImageAnalysisThreads: error opening " << iFile1 << " or " << iFileN << endl;
+        exit( EXIT_FAILURE );
+    }
+    unsigned int iNTrees = 0;
+    Long64_t nEntriesDiff = compareDirectories( &iF1, &iFN, iNTrees );
+    cout << "testImageAnalysisThreads: " << iNTrees << " trees compared (-nthreads=1 vs -nthreads=" << iNThreads << "), ";
+    cout << nEntriesDiff << " entries with differences" << endl;
+
+    iF1.Close();
+    iFN.Close();
+
+    if( nEntriesDiff > 0 || iNTrees == 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
@@ -0,0 +1,231 @@
+/*! \file testImageLLFitter
+ *  \brief test gradient based loglikelihood fitter (VImageLLFitter vs TMinuit)
+ *
+ *  random 2D-Gaussian images with Poisson fluctuations are fitted with
+ *  both fitters (same start values and limits as in
+ *  VImageParameterCalculation::calcLL()); the test fails if
+ *
+ *  - the likelihood functions differ
+ *  - for images with converged minuit fits, the gradient based fit
+ *    does not converge, ends at a larger -LL, or finds parameters
+ *    deviating from the minuit results
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "TMath.h"
+#include "TMinuit.h"
+#include "TRandom3.h"
+
+#include "VImageLLFitter.h"
+
+using namespace std;
+
+// image used by the minuit fit function
+vector< double > fX;
+vector< double > fY;
+vector< double > fSums;
+
+/*
+ * 2D-Gaussian (parameters rho, meanX, sigmaX, meanY, sigmaY, signal)
+ */
+double get2DGauss( const double* par, double x, double y )
+{
+    double rho_1 = -1. / 2. / ( 1. - par[0] * par[0] );
+    double rho_s =  1. / 2. / M_PI / par[2] / par[4] / sqrt( 1. - par[0] * par[0] ) * par[5];
+    double sum  = ( x - par[1] ) * ( x - par[1] ) / par[2] / par[2];
+    sum += ( y - par[3] ) * ( y - par[3] ) / par[4] / par[4];
+    sum += -2. * par[0] * ( x - par[1] ) / par[2] * ( y - par[3] ) / par[4];
+    return rho_s * exp( sum * rho_1 );
+}
+
+/*
+ * -LL for a 2D-Gaussian with Poisson fluctuations
+ * (same as get_LL_imageParameter_2DGauss in VImageParameterCalculation)
+ */
+void get_LL_test( Int_t& npar, Double_t* gin, Double_t& f, Double_t* par, Int_t iflag )
+{
+    double LL = 0.;
+    if( par[0] * par[0] < 1. && par[2] > 0. && par[4] > 0. )
+    {
+        for( unsigned int i = 0; i < fSums.size(); i++ )
+        {
+            double n = fSums[i];
+            if( n > -999. )
+            {
+                double sum = get2DGauss( par, fX[i], fY[i] );
+                if( n > 0. && sum > 0. )
+                {
+                    LL += n * log( sum ) - sum - n * log( n ) + n;
+                }
+                else
+                {
+                    LL += -1. * sum;
+                }
+            }
+        }
+    }
+    f = -1. * LL;
+}
+
+int main( int argc, char* argv[] )
+{
+    const unsigned int nImages = 500;
+    const double iPixelSpacing = 0.15;
+    const double iFOV = 3.5;
+    const double iPixelArea = iPixelSpacing * iPixelSpacing;
+    // allowed differences between the fitters
+    const double iMaxDeltaLL = 0.01;               // -LL (UP = 0.5)
+    const double iMaxDeviation = 0.1;              // in units of the minuit errors
+
+    // square camera
+    vector< double > iPixelX;
+    vector< double > iPixelY;
+    for( double x = -0.5 * iFOV; x <= 0.5 * iFOV; x += iPixelSpacing )
+    {
+        for( double y = -0.5 * iFOV; y <= 0.5 * iFOV; y += iPixelSpacing )
+        {
+            if( x * x + y * y < 0.25 * iFOV * iFOV )
+            {
+                iPixelX.push_back( x );
+                iPixelY.push_back( y );
+            }
+        }
+    }
+    fX = iPixelX;
+    fY = iPixelY;
+
+    TRandom3 iRandom( 42 );
+    TMinuit iMinuit( 6 );
+    iMinuit.SetPrintLevel( -1 );
+    iMinuit.Command( "SET NOWA" );
+    iMinuit.Command( "SET ERR 0.5" );
+    iMinuit.SetFCN( get_LL_test );
+    VImageLLFitter iFitter;
+
+    unsigned int nConverged = 0;
+    unsigned int nFailed = 0;
+    for( unsigned int n = 0; n < nImages; n++ )
+    {
+        // random image
+        double iTrue[6];
+        iTrue[0] = iRandom.Uniform( -0.8, 0.8 );
+        iTrue[1] = iRandom.Uniform( -1., 1. );
+        iTrue[2] = iRandom.Uniform( 0.05, 0.4 );
+        iTrue[3] = iRandom.Uniform( -1., 1. );
+        iTrue[4] = iRandom.Uniform( 0.05, 0.4 );
+        iTrue[5] = iRandom.Uniform( 100., 3000. ) * iPixelArea;
+        fSums.assign( iPixelX.size(), 0. );
+        for( unsigned int i = 0; i < iPixelX.size(); i++ )
+        {
+            fSums[i] = iRandom.Poisson( get2DGauss( iTrue, fX[i], fY[i] ) );
+        }
+
+        // start values (moments of the image) and limits
+        double s = 0., sx = 0., sy = 0., sxx = 0., syy = 0., sxy = 0.;
+        for( unsigned int i = 0; i < fSums.size(); i++ )
+        {
+            s   += fSums[i];
+            sx  += fSums[i] * fX[i];
+            sy  += fSums[i] * fY[i];
+            sxx += fSums[i] * fX[i] * fX[i];
+            syy += fSums[i] * fY[i] * fY[i];
+            sxy += fSums[i] * fX[i] * fY[i];
+        }
+        if( s <= 0. )
+        {
+            continue;
+        }
+        double iStart[6];
+        iStart[1] = sx / s;
+        iStart[3] = sy / s;
+        iStart[2] = sqrt( TMath::Max( sxx / s - iStart[1] * iStart[1], 1.e-4 ) );
+        iStart[4] = sqrt( TMath::Max( syy / s - iStart[3] * iStart[3], 1.e-4 ) );
+        iStart[0] = ( sxy / s - iStart[1] * iStart[3] ) / iStart[2] / iStart[4];
+        iStart[0] = TMath::Max( TMath::Min( iStart[0], 0.95 ), -0.95 );
+        iStart[5] = s * iPixelArea;
+        double iMin[6] = { 0., -0.55 * iFOV, 0., -0.55 * iFOV, 0., 0. };
+        double iMax[6] = { 0., 0.55 * iFOV, 2. * iStart[2] + 1., 0.55 * iFOV, 2. * iStart[4] + 1., 1.e6 };
+        const char* iName[6] = { "rho", "meanX", "sigmaX", "meanY", "sigmaY", "signal" };
+
+        // minuit fit
+        for( unsigned int p = 0; p < 6; p++ )
+        {
+            iMinuit.DefineParameter( p, iName[p], iStart[p], 1.e-3, iMin[p], iMax[p] );
+        }
+        iMinuit.Command( "MIGRAD" );
+        double amin = 0., edm = 0., errdef = 0.;
+        int nvpar = 0, nparx = 0, nstat = 0;
+        iMinuit.mnstat( amin, edm, errdef, nvpar, nparx, nstat );
+        double iParMinuit[6];
+        double iParMinuitError[6];
+        for( unsigned int p = 0; p < 6; p++ )
+        {
+            iMinuit.GetParameter( p, iParMinuit[p], iParMinuitError[p] );
+        }
+
+        // gradient based fit
+        for( unsigned int p = 0; p < 6; p++ )
+        {
+            iFitter.defineParameter( p, iStart[p], iMin[p], iMax[p] );
+        }
+        iFitter.fit( fX, fY, fSums );
+        double iParGrad[6];
+        double iParGradError[6];
+        for( unsigned int p = 0; p < 6; p++ )
+        {
+            iFitter.getParameter( p, iParGrad[p], iParGradError[p] );
+        }
+
+        // same likelihood function
+        double iLLMinuit = 0.;
+        Int_t npar = 6;
+        get_LL_test( npar, 0, iLLMinuit, iParMinuit, 0 );
+        if( fabs( iLLMinuit - iFitter.getFunctionValue( iParMinuit ) ) > 1.e-9 * TMath::Max( 1., fabs( iLLMinuit ) ) )
+        {
+            cout << "image " << n << ": likelihood functions differ: ";
+            cout << iLLMinuit << " (minuit), " << iFitter.getFunctionValue( iParMinuit ) << " (gradient)" << endl;
+            nFailed++;
+            continue;
+        }
+        // compare fits for images with converged minuit fit
+        if( nstat != 3 )
+        {
+            continue;
+        }
+        nConverged++;
+        bool bFailed = ( iFitter.getStatus() < 2 || iFitter.getFmin() > amin + iMaxDeltaLL );
+        // same minimum: parameters must agree
+        if( !bFailed && fabs( iFitter.getFmin() - amin ) < iMaxDeltaLL )
+        {
+            for( unsigned int p = 0; p < 6; p++ )
+            {
+                if( iParMinuitError[p] > 0. && fabs( iParGrad[p] - iParMinuit[p] ) > iMaxDeviation * iParMinuitError[p] )
+                {
+                    bFailed = true;
+                }
+            }
+        }
+        if( bFailed )
+        {
+            cout << "image " << n << ": status " << nstat << "/" << iFitter.getStatus();
+            cout << ", -LL " << amin << "/" << iFitter.getFmin() << ", parameters:";
+            for( unsigned int p = 0; p < 6; p++ )
+            {
+                cout << " " << iParMinuit[p] << "/" << iParGrad[p];
+            }
+            cout << endl;
+            nFailed++;
+        }
+    }
+    cout << "testImageLLFitter: " << nConverged << " images with converged minuit fit, ";
+    cout << nFailed << " differences" << endl;
+    if( nFailed > 0 || nConverged == 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
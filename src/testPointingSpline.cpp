@@ -0,0 +1,109 @@
+/*! \file testPointingSpline
+ *  \brief test pointing tables (spline interpolation vs direct calculation)
+ *
+ *  telescope/target elevation and azimuth and the camera derotation angle
+ *  from VSkyCoordinates pointing tables are compared with the direct
+ *  calculation over one day for targets at different declinations
+ *  (including zenith passages with elevations above 89 deg)
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+
+#include "TMath.h"
+
+#include "VSkyCoordinates.h"
+
+using namespace std;
+
+/*
+ * absolute difference of two angles (periodic with iPeriod)
+ */
+double getAngleDifference( double a, double b, double iPeriod )
+{
+    double d = fabs( a - b );
+    d -= iPeriod * floor( d / iPeriod );
+    return ( d > 0.5 * iPeriod ? iPeriod - d : d );
+}
+
+int main( int argc, char* argv[] )
+{
+    // observatory (same as the default global observatory used for horizontal coordinates)
+    const double iObsLongitude = 0.;
+    const double iObsLatitude = 0.;
+    const int iMJD = 58000;
+    const double iTimeStep = 7.;                   // [s]
+    // allowed differences
+    const double iMaxDiff_deg = 1.e-6;             // target elevation/azimuth (double)
+    const double iMaxDiffFloat_deg = 1.e-4;        // telescope elevation/azimuth (float)
+    const double iMaxDiffDerot_deg = 1.e-6;        // derotation angle
+
+    // target declinations (culmination at 90 deg - |dec| elevation)
+    const unsigned int nTargets = 7;
+    double iDec[nTargets] = { 0.02, 0.3, 0.9, 1.5, 30., -45., 70. };
+
+    unsigned int nFailed = 0;
+    unsigned int nAbove89 = 0;
+    for( unsigned int s = 0; s < nTargets; s++ )
+    {
+        VSkyCoordinates iTable;
+        VSkyCoordinates iDirect;
+        iTable.setObservatory( iObsLongitude, iObsLatitude );
+        iDirect.setObservatory( iObsLongitude, iObsLatitude );
+        iTable.setPointingTable( true );
+        // telescope with 0.5 deg wobble offset in RA
+        iTable.setTargetJ2000( iDec[s], 120. );
+        iDirect.setTargetJ2000( iDec[s], 120. );
+        iTable.setTelRA_deg( 120.5 );
+        iDirect.setTelRA_deg( 120.5 );
+
+        double iMax[5] = { 0., 0., 0., 0., 0. };
+        for( double t = 0.; t < 86400.; t += iTimeStep )
+        {
+            iTable.updatePointing( iMJD, t );
+            iDirect.updatePointing( iMJD, t );
+            if( iDirect.getTelElevation() > 89. || iDirect.getTargetElevation() > 89. )
+            {
+                nAbove89++;
+            }
+            double iDiff[5];
+            iDiff[0] = fabs( iTable.getTelElevation() - iDirect.getTelElevation() );
+            iDiff[1] = getAngleDifference( iTable.getTelAzimuth(), iDirect.getTelAzimuth(), 360. );
+            iDiff[2] = fabs( iTable.getTargetElevation() - iDirect.getTargetElevation() );
+            iDiff[3] = getAngleDifference( iTable.getTargetAzimuth(), iDirect.getTargetAzimuth(), 360. );
+            iDiff[4] = getAngleDifference( iTable.getDerotationAngle( iMJD, t ), iDirect.getDerotationAngle( iMJD, t ),
+                                           2. * TMath::Pi() ) * TMath::RadToDeg();
+            for( unsigned int i = 0; i < 5; i++ )
+            {
+                if( iDiff[i] > iMax[i] )
+                {
+                    iMax[i] = iDiff[i];
+                }
+            }
+        }
+        bool bFailed = ( iMax[0] > iMaxDiffFloat_deg || iMax[1] > iMaxDiffFloat_deg );
+        bFailed = bFailed || ( iMax[2] > iMaxDiff_deg || iMax[3] > iMaxDiff_deg || iMax[4] > iMaxDiffDerot_deg );
+        cout << "dec " << iDec[s] << " deg: max differences [deg]";
+        cout << " tel el " << iMax[0] << ", tel az " << iMax[1];
+        cout << ", target el " << iMax[2] << ", target az " << iMax[3];
+        cout << ", derotation " << iMax[4] << ( bFailed ? " FAILED" : "" ) << endl;
+        if( bFailed )
+        {
+            nFailed++;
+        }
+    }
+    if( nAbove89 == 0 )
+    {
+        cout << "testPointingSpline: no pointings above 89 deg elevation tested" << endl;
+        exit( EXIT_FAILURE );
+    }
+    if( nFailed > 0 )
+    {
+        cout << "testPointingSpline: pointing tables and direct calculation differ" << endl;
+        exit( EXIT_FAILURE );
+    }
+    cout << "testPointingSpline: pointing tables and direct calculation agree";
+    cout << " (" << nAbove89 << " pointings above 89 deg elevation)" << endl;
+}
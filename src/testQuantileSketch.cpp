@@ -0,0 +1,169 @@
+/*! \file testQuantileSketch
+ *  \brief test quantiles of VQuantileSketchPool against TH1::GetQuantiles
+ *
+ *  sketches and TH1F histograms with identical binning are filled with
+ *  the same values; number of entries and quantiles must be identical for
+ *
+ *  - random (gaussian) pedestal-like sums, including values outside of the range
+ *  - tied cumulative contents (runs of empty bins at the requested probability)
+ *  - sparse sketches (few entries, mostly empty bins)
+ *  - all entries in one bin
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TH1F.h"
+#include "TRandom3.h"
+
+#include "VQuantileSketchPool.h"
+
+using namespace std;
+
+/*
+ * compare entries and quantiles of sketch s with a TH1F filled with the same values
+ */
+unsigned int compare( string iName, VQuantileSketchPool& iPool, unsigned int s, TH1F* h,
+                      const vector< double >& iProb, unsigned int& iNTested )
+{
+    unsigned int iNFailed = 0;
+    vector< double > q_sketch( iProb.size(), 0. );
+    vector< double > q_histo( iProb.size(), 0. );
+    iPool.getQuantiles( s, iProb.size(), &iProb[0], &q_sketch[0] );
+    h->GetQuantiles( iProb.size(), &q_histo[0], &iProb[0] );
+
+    if( iPool.getEntries( s ) != ( unsigned int )h->GetEntries() )
+    {
+        cout << iName << ": different number of entries: " << iPool.getEntries( s ) << ", " << h->GetEntries() << endl;
+        iNFailed++;
+    }
+    for( unsigned int i = 0; i < iProb.size(); i++ )
+    {
+        iNTested++;
+        if( q_sketch[i] != q_histo[i] )
+        {
+            if( iNFailed < 20 )
+            {
+                cout << iName << ": difference at p=" << iProb[i] << ": ";
+                cout << "sketch " << q_sketch[i] << ", TH1F " << q_histo[i] << endl;
+            }
+            iNFailed++;
+        }
+    }
+    return iNFailed;
+}
+
+/*
+ * sketch and histogram filled with iValues
+ */
+unsigned int compare( string iName, unsigned int iNBins, double iXmin, double iXmax,
+                      const vector< double >& iValues, const vector< double >& iProb, unsigned int& iNTested )
+{
+    VQuantileSketchPool iPool;
+    // first sketch is not used (test offsets in flat array)
+    iPool.addSketch( 7, 0., 7. );
+    unsigned int s = iPool.addSketch( iNBins, iXmin, iXmax );
+    TH1F h( "hTest", "", iNBins, iXmin, iXmax );
+    h.SetDirectory( 0 );
+    for( unsigned int i = 0; i < iValues.size(); i++ )
+    {
+        iPool.fill( s, iValues[i] );
+        h.Fill( iValues[i] );
+    }
+    return compare( iName, iPool, s, &h, iProb, iNTested );
+}
+
+int main( int argc, char* argv[] )
+{
+    TRandom3 iRandom( 11 );
+    unsigned int iNTested = 0;
+    unsigned int iNFailed = 0;
+
+    // probabilities as used in VPedestalCalculator and on bin boundaries
+    vector< double > iProb;
+    iProb.push_back( 0.1587 );
+    iProb.push_back( 0.5 );
+    iProb.push_back( 0.8413 );
+    iProb.push_back( 0. );
+    iProb.push_back( 0.25 );
+    iProb.push_back( 0.75 );
+    iProb.push_back( 1. );
+    for( unsigned int i = 1; i < 20; i++ )
+    {
+        iProb.push_back( iRandom.Uniform() );
+    }
+
+    vector< double > v;
+    ///////////////////////////////////
+    // random pedestal-like sums (integer and non-integer values, values out of range)
+    for( unsigned int t = 0; t < 200; t++ )
+    {
+        unsigned int w = 1 + t % 24;
+        unsigned int n = ( t % 5 == 0 ? 5 : 500 );
+        v.clear();
+        for( unsigned int i = 0; i < n; i++ )
+        {
+            double x = iRandom.Gaus( 16. * w, 4. * sqrt( ( double )w ) );
+            if( t % 2 == 0 )
+            {
+                x = ( double )( int )x;
+            }
+            v.push_back( x );
+        }
+        v.push_back( -1. );
+        v.push_back( 50. * w );
+        iNFailed += compare( "random", 50 * w, 0., 50. * w, v, iProb, iNTested );
+    }
+
+    ///////////////////////////////////
+    // tied cumulative contents: counts {1,0,1} and {1,0,0,0,1}
+    v.clear();
+    v.push_back( 0.5 );
+    v.push_back( 2.5 );
+    iNFailed += compare( "tied_101", 3, 0., 3., v, iProb, iNTested );
+    v.clear();
+    v.push_back( 0.5 );
+    v.push_back( 4.5 );
+    iNFailed += compare( "tied_10001", 5, 0., 5., v, iProb, iNTested );
+    // counts {2,0,0,2,0,2}
+    v.clear();
+    v.push_back( 0.2 );
+    v.push_back( 0.7 );
+    v.push_back( 3.1 );
+    v.push_back( 3.9 );
+    v.push_back( 5.5 );
+    v.push_back( 5.5 );
+    iNFailed += compare( "tied_200202", 6, 0., 6., v, iProb, iNTested );
+
+    ///////////////////////////////////
+    // sparse sketches
+    for( unsigned int t = 0; t < 100; t++ )
+    {
+        v.clear();
+        unsigned int n = 1 + t % 4;
+        for( unsigned int i = 0; i < n; i++ )
+        {
+            v.push_back( ( double )( int )( iRandom.Uniform() * 1200. ) );
+        }
+        iNFailed += compare( "sparse", 1200, 0., 1200., v, iProb, iNTested );
+    }
+
+    ///////////////////////////////////
+    // all entries in one bin (first, central and last bin)
+    double iBin[] = { 0.5, 333.5, 599.5 };
+    for( unsigned int b = 0; b < 3; b++ )
+    {
+        v.assign( 100, iBin[b] );
+        iNFailed += compare( "single_bin", 600, 0., 600., v, iProb, iNTested );
+    }
+
+    cout << "testQuantileSketch: " << iNTested << " quantiles tested, " << iNFailed << " differences" << endl;
+    if( iNFailed > 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
@@ -0,0 +1,217 @@
+/*! \file testSlimDST
+ *  \brief test slim DST trees (write and read back)
+ *
+ *  random image/border pixel lists are written into a slim DST tree
+ *  (sparse pixel list) and read back with the DST reader; the per-channel
+ *  arrays filled after reading must agree with the written values for all
+ *  channels (zero for pixels not in the list, including pixels of the
+ *  previous event)
+ *
+ */
+
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+#include "VDSTTree.h"
+
+using namespace std;
+
+/*
+ * values of one pixel
+ */
+struct VTestPixel
+{
+    float sum;
+    float sum2;
+    unsigned short int dead;
+    unsigned short int sumwindow;
+    unsigned short int sumfirst;
+    float width;
+    float pulsetiming[VDST_MAXTIMINGLEVELS];
+    short max;
+    short rawmax;
+    unsigned short int hilo;
+    unsigned short int n255;
+};
+
+int main( int argc, char* argv[] )
+{
+    const unsigned int nEvents = 50;
+    const unsigned int nTel = 4;
+    const unsigned int nChannels = 499;
+    const string iFileName = "testSlimDST.root";
+
+    TRandom3 iRandom( 42 );
+    // written pixels per event: [event][(tel,channel)]
+    vector< map< pair< unsigned int, unsigned int >, VTestPixel > > iWritten( nEvents );
+
+    //////////////////////////////////////
+    // write slim DST
+    TFile* iFile = new TFile( iFileName.c_str(), "RECREATE" );
+    if( iFile->IsZombie() )
+    {
+        cout << "testSlimDST: error opening " << iFileName << endl;
+        exit( EXIT_FAILURE );
+    }
+    // (DST trees are too large for the stack)
+    VDSTTree* iWriter = new VDSTTree();
+    iWriter->setMC( false );
+    iWriter->initDSTTree( true, false, false, true );
+    for( unsigned int e = 0; e < nEvents; e++ )
+    {
+        iWriter->resetDataVectors( 0, nTel, nTel, nChannels );
+        iWriter->fDSTrunnumber = 64080;
+        iWriter->fDSTeventnumber = e + 1;
+        iWriter->fDSTntel = nTel;
+        iWriter->fDSTntel_data = nTel;
+        for( unsigned int t = 0; t < nTel; t++ )
+        {
+            iWriter->fDSTtel_data[t] = t;
+        }
+        // random image pixels (some events without pixels)
+        unsigned int nPix = ( e % 7 == 3 ? 0 : iRandom.Integer( 120 ) );
+        for( unsigned int p = 0; p < nPix; p++ )
+        {
+            unsigned int t = iRandom.Integer( nTel );
+            unsigned int c = iRandom.Integer( nChannels );
+            if( iWritten[e].find( make_pair( t, c ) ) != iWritten[e].end() )
+            {
+                continue;
+            }
+            VTestPixel iP;
+            iP.sum = iRandom.Exp( 50. );
+            iP.sum2 = iP.sum * iRandom.Uniform( 1., 1.5 );
+            iP.dead = ( iRandom.Uniform() < 0.05 ? 1 : 0 );
+            iP.sumwindow = 6 + iRandom.Integer( 6 );
+            iP.sumfirst = iRandom.Integer( 10 );
+            iP.width = iRandom.Uniform( 1., 6. );
+            for( unsigned int l = 0; l < VDST_MAXTIMINGLEVELS; l++ )
+            {
+                iP.pulsetiming[l] = iRandom.Uniform( 0., 24. );
+            }
+            iP.max = ( short )iRandom.Integer( 250 );
+            iP.rawmax = iP.max + 16;
+            iP.hilo = ( iP.max > 240 ? 1 : 0 );
+            iP.n255 = ( iP.hilo ? 1 + iRandom.Integer( 3 ) : 0 );
+
+            iWriter->fDSTsums[t][c] = iP.sum;
+            iWriter->fDSTsums2[t][c] = iP.sum2;
+            iWriter->fDSTdead[t][c] = iP.dead;
+            iWriter->fDSTsumwindow[t][c] = iP.sumwindow;
+            iWriter->fDSTsumfirst[t][c] = iP.sumfirst;
+            iWriter->fDSTTraceWidth[t][c] = iP.width;
+            for( unsigned int l = 0; l < VDST_MAXTIMINGLEVELS; l++ )
+            {
+                iWriter->fDSTpulsetiming[t][l][c] = iP.pulsetiming[l];
+            }
+            iWriter->fDSTMax[t][c] = iP.max;
+            iWriter->fDSTRawMax[t][c] = iP.rawmax;
+            iWriter->fDSTHiLo[t][c] = iP.hilo;
+            iWriter->fDSTN255[t][c] = iP.n255;
+            iWriter->addSlimPixel( t, c );
+            iWritten[e][make_pair( t, c )] = iP;
+        }
+        iWriter->getDSTTree()->Fill();
+    }
+    iWriter->getDSTTree()->Write();
+    // telescope configuration
+    TTree* iConfig = new TTree( "telconfig", "detector configuration" );
+    int iTelID = 0;
+    unsigned int iNPixel = nChannels;
+    iConfig->Branch( "TelID", &iTelID, "TelID/I" );
+    iConfig->Branch( "NPixel", &iNPixel, "NPixel/i" );
+    for( unsigned int t = 0; t < nTel; t++ )
+    {
+        iTelID = t + 1;
+        iConfig->Fill();
+    }
+    iConfig->Write();
+    iFile->Close();
+    delete iFile;
+    delete iWriter;
+
+    //////////////////////////////////////
+    // read slim DST
+    iFile = new TFile( iFileName.c_str() );
+    TTree* iDST = ( TTree* )iFile->Get( "dst" );
+    TTree* iConf = ( TTree* )iFile->Get( "telconfig" );
+    if( !iDST || !iConf || iDST->GetEntries() != ( Long64_t )nEvents )
+    {
+        cout << "testSlimDST: error reading DST trees from " << iFileName << endl;
+        exit( EXIT_FAILURE );
+    }
+    VDSTTree* iReader = new VDSTTree();
+    iReader->setMC( false );
+    iReader->initDSTTree( iDST, iConf );
+    unsigned int nFailed = 0;
+    unsigned int nPixelsRead = 0;
+    for( unsigned int e = 0; e < nEvents; e++ )
+    {
+        if( iReader->getDSTEntry( e ) <= 0 || iReader->fDSTeventnumber != e + 1 )
+        {
+            cout << "event " << e << ": error reading event" << endl;
+            nFailed++;
+            continue;
+        }
+        if( iReader->fDSTnpix != iWritten[e].size() )
+        {
+            cout << "event " << e << ": " << iReader->fDSTnpix << " pixels read, " << iWritten[e].size() << " written" << endl;
+            nFailed++;
+        }
+        unsigned int nDiff = 0;
+        for( unsigned int t = 0; t < nTel; t++ )
+        {
+            for( unsigned int c = 0; c < nChannels; c++ )
+            {
+                VTestPixel iP;
+                memset( &iP, 0, sizeof( iP ) );
+                map< pair< unsigned int, unsigned int >, VTestPixel >::iterator it = iWritten[e].find( make_pair( t, c ) );
+                if( it != iWritten[e].end() )
+                {
+                    iP = it->second;
+                    nPixelsRead++;
+                }
+                bool bDiff = ( iReader->fDSTsums[t][c] != iP.sum || iReader->fDSTsums2[t][c] != iP.sum2 );
+                bDiff = bDiff || ( iReader->fDSTdead[t][c] != iP.dead );
+                bDiff = bDiff || ( iReader->fDSTsumwindow[t][c] != iP.sumwindow || iReader->fDSTsumfirst[t][c] != iP.sumfirst );
+                bDiff = bDiff || ( iReader->fDSTTraceWidth[t][c] != iP.width );
+                for( unsigned int l = 0; l < VDST_MAXTIMINGLEVELS; l++ )
+                {
+                    bDiff = bDiff || ( iReader->fDSTpulsetiming[t][l][c] != iP.pulsetiming[l] );
+                }
+                bDiff = bDiff || ( iReader->fDSTMax[t][c] != iP.max || iReader->fDSTRawMax[t][c] != iP.rawmax );
+                bDiff = bDiff || ( iReader->fDSTHiLo[t][c] != iP.hilo || iReader->fDSTN255[t][c] != iP.n255 );
+                if( bDiff )
+                {
+                    if( nDiff < 5 )
+                    {
+                        cout << "event " << e << ", telescope " << t + 1 << ", channel " << c << ": ";
+                        cout << "sum " << iReader->fDSTsums[t][c] << " (written " << iP.sum << ")" << endl;
+                    }
+                    nDiff++;
+                }
+            }
+        }
+        if( nDiff > 0 )
+        {
+            nFailed++;
+        }
+    }
+    iFile->Close();
+    remove( iFileName.c_str() );
+
+    cout << "testSlimDST: " << nEvents << " events, " << nPixelsRead << " pixels, ";
+    cout << nFailed << " events with differences" << endl;
+    if( nFailed > 0 || nPixelsRead == 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
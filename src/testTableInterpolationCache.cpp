@@ -0,0 +1,202 @@
+/*! \file testTableInterpolationCache
+ *  \brief test lookup tables interpolated in zenith angle and wobble offset (VTableInterpolationCache)
+ *
+ *  expected values and sigmas from the interpolated tables are compared with
+ *  the default path (tables of the four corners are evaluated, and the results
+ *  interpolated in wobble offset and zenith angle; see VTableLookup::readLookupTable):
+ *
+ *  - for the quantized zenith angle and wobble offset, both agree (float precision)
+ *  - for the event zenith angle and wobble offset, the difference is bounded by the
+ *    change of the interpolation weights due to the quantization (0.1 deg in zenith,
+ *    0.01 deg in wobble offset) times the differences between the corner values
+ *
+ *  the cache is cleared when the memory budget is exceeded
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "TH2F.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include "VStatistics.h"
+#include "VTableInterpolationCache.h"
+#include "VTableLookupGrid.h"
+
+using namespace std;
+
+/*
+ * table with random (non-zero) contents
+ */
+VTableLookupGrid* getRandomGrid( unsigned int nx, unsigned int ny, TRandom3& iRandom )
+{
+    TH2F h( "hTest", "", nx, 1., 1. + 0.125 * nx, ny, 0., 20. * ny );
+    h.SetDirectory( 0 );
+    h.Sumw2();
+    for( unsigned int i = 0; i <= nx + 1; i++ )
+    {
+        for( unsigned int j = 0; j <= ny + 1; j++ )
+        {
+            h.SetBinContent( i, j, 0.5 + 2.5 * iRandom.Uniform() );
+            h.SetBinError( i, j, 0.05 + 0.25 * iRandom.Uniform() );
+        }
+    }
+    return new VTableLookupGrid( &h );
+}
+
+/*
+ * default path: results of the four corners interpolated in wobble offset and zenith angle
+ */
+double getInterpolatedValue( double* v, double* woff_corner, double ze_low, double ze_up, double woff, double ze )
+{
+    double v_low = VStatistics::interpolate( v[0], woff_corner[0], v[1], woff_corner[1], woff, false, 1.e-2 );
+    double v_up  = VStatistics::interpolate( v[2], woff_corner[2], v[3], woff_corner[3], woff, false, 1.e-2 );
+    return VStatistics::interpolate( v_low, ze_low, v_up, ze_up, ze, true, 1.e-2 );
+}
+
+int main( int argc, char* argv[] )
+{
+    const unsigned int nTrials = 200;
+    const unsigned int nPoints = 500;
+    const double iZeStep = 0.1;
+    const double iWoffStep = 0.01;
+    double iTableZe[] = { 0., 20., 30., 35., 40., 45., 50., 55., 60., 65. };
+    const unsigned int nTableZe = 10;
+
+    TRandom3 iRandom( 31 );
+    VTableInterpolationCache iCache( iZeStep, iWoffStep );
+
+    unsigned int nFailed = 0;
+    unsigned int nTested = 0;
+    double iMaxDiff_q = 0.;
+    double iMaxDiff = 0.;
+    double iMaxBound = 0.;
+    for( unsigned int t = 0; t < nTrials; t++ )
+    {
+        unsigned int iZeBin = iRandom.Integer( nTableZe - 1 );
+        double ze_low = iTableZe[iZeBin];
+        double ze_up = iTableZe[iZeBin + 1];
+        double woff_corner[4] = { 0.5, 1.0, 0.5, 1.0 };
+        double ze = ze_low + iRandom.Uniform() * ( ze_up - ze_low );
+        double woff = 0.5 + 0.5 * iRandom.Uniform();
+        double ze_q = iCache.getZe( iCache.getQuantizedZe( ze ) );
+        double woff_q = iCache.getWoff( iCache.getQuantizedWoff( woff ) );
+
+        unsigned int nx = 40 + t % 7;
+        unsigned int ny = 30 + t % 5;
+        vector< VTableLookupGrid* > g( 4, ( VTableLookupGrid* )0 );
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            g[c] = getRandomGrid( nx, ny, iRandom );
+        }
+        VTableLookupGrid* iG = VTableInterpolationCache::interpolate( g, woff_corner, ze_low, ze_up, woff_q, ze_q );
+        if( !iG )
+        {
+            cout << "trial " << t << ": tables not interpolated" << endl;
+            nFailed++;
+            continue;
+        }
+        // change of interpolation weights (cos(ze) and wobble offset) due to quantization
+        double iDWeightZe = fabs( cos( ze * TMath::DegToRad() ) - cos( ze_q * TMath::DegToRad() ) )
+                            / fabs( cos( ze_low * TMath::DegToRad() ) - cos( ze_up * TMath::DegToRad() ) );
+        double iDWeightWoff = fabs( woff - woff_q ) / ( woff_corner[1] - woff_corner[0] );
+
+        unsigned int nDiff = 0;
+        for( unsigned int p = 0; p < nPoints; p++ )
+        {
+            float x = g[0]->fXmin + iRandom.Uniform() * ( g[0]->fXmax - g[0]->fXmin );
+            float y = g[0]->fYmin + iRandom.Uniform() * ( g[0]->fYmax - g[0]->fYmin );
+            for( unsigned int e = 0; e < 2; e++ )
+            {
+                double v[4];
+                double vmin = 1.e10;
+                double vmax = -1.e10;
+                for( unsigned int c = 0; c < 4; c++ )
+                {
+                    v[c] = g[c]->interpolate( x, y, ( e == 1 ) );
+                    vmin = TMath::Min( vmin, v[c] );
+                    vmax = TMath::Max( vmax, v[c] );
+                }
+                double iCached = iG->interpolate( x, y, ( e == 1 ) );
+                double iDefault_q = getInterpolatedValue( v, woff_corner, ze_low, ze_up, woff_q, ze_q );
+                double iDefault = getInterpolatedValue( v, woff_corner, ze_low, ze_up, woff, ze );
+                double iBound = iDWeightZe * ( vmax - vmin )
+                                + iDWeightWoff * TMath::Max( fabs( v[1] - v[0] ), fabs( v[3] - v[2] ) );
+                double iTolerance = 1.e-5 * fabs( iDefault_q ) + 1.e-6;
+                nTested++;
+                iMaxDiff_q = TMath::Max( iMaxDiff_q, fabs( iCached - iDefault_q ) );
+                iMaxDiff = TMath::Max( iMaxDiff, fabs( iCached - iDefault ) );
+                iMaxBound = TMath::Max( iMaxBound, iBound );
+                if( fabs( iCached - iDefault_q ) > iTolerance || fabs( iCached - iDefault ) > iBound + iTolerance )
+                {
+                    if( nDiff < 5 )
+                    {
+                        cout << "trial " << t << " (ze " << ze << ", woff " << woff << ")";
+                        cout << ( e == 1 ? " sigma" : " value" ) << " at x=" << x << ", y=" << y << ": ";
+                        cout << "cached " << iCached << ", default " << iDefault << " (quantized " << iDefault_q << ")";
+                        cout << ", bound " << iBound << endl;
+                    }
+                    nDiff++;
+                }
+            }
+        }
+        if( nDiff > 0 )
+        {
+            nFailed++;
+        }
+        delete iG;
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            delete g[c];
+        }
+    }
+    cout << "testTableInterpolationCache: " << nTested << " values tested, max difference ";
+    cout << iMaxDiff_q << " (quantized direction), " << iMaxDiff << " (event direction, max bound " << iMaxBound << ")" << endl;
+
+    //////////////////////////////////////
+    // memory budget
+    for( unsigned int b = 0; b < 2; b++ )
+    {
+        // 0: no limit; 1: budget smaller than one set of tables
+        VTableInterpolationCache iCacheB( iZeStep, iWoffStep, ( b == 0 ? 0. : 0.01 ) );
+        vector< VTableLookupGrid* > g( 4, ( VTableLookupGrid* )0 );
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            g[c] = getRandomGrid( 40, 30, iRandom );
+        }
+        vector< vector< VTableLookupGrid* > > iCornerGrids( VTableInterpolationCache::fNTableTypes, g );
+        double woff_corner[4] = { 0.5, 1.0, 0.5, 1.0 };
+        sTableInterpolationKey k;
+        k.ze = iCacheB.getQuantizedZe( 23.4 );
+        k.woff = iCacheB.getQuantizedWoff( 0.73 );
+        k.az = 0;
+        k.telType = 1;
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            k.noise[c] = 0;
+        }
+        iCacheB.nextEvent();
+        iCacheB.add( k, iCornerGrids, woff_corner, 20., 30., 0.73, 23.4 );
+        iCacheB.nextEvent();
+        if( ( b == 0 && !iCacheB.get( k ) ) || ( b == 1 && iCacheB.get( k ) ) )
+        {
+            cout << "memory budget: cache " << ( b == 0 ? "cleared without memory limit" : "not cleared" ) << endl;
+            nFailed++;
+        }
+        for( unsigned int c = 0; c < 4; c++ )
+        {
+            delete g[c];
+        }
+    }
+
+    if( nFailed > 0 || nTested == 0 )
+    {
+        cout << "testTableInterpolationCache: " << nFailed << " tests failed" << endl;
+        exit( EXIT_FAILURE );
+    }
+    cout << "testTableInterpolationCache: all tests passed" << endl;
+}
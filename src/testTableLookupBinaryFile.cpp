@@ -0,0 +1,219 @@
+/*! \file testTableLookupBinaryFile
+ *  \brief test binary lookup table files (VTableLookupBinaryFile)
+ *
+ *  random tables are written into a ROOT table file (ze/woff/az/tel/noise
+ *  directory structure, one table missing) and converted into a binary
+ *  table file; expected values and sigmas from the memory mapped grids
+ *  must agree with the interpolation of the TH2F tables
+ *
+ */
+
+#include <cmath>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TH2F.h"
+#include "TRandom3.h"
+
+#include "VTableCalculator.h"
+#include "VTableLookupBinaryFile.h"
+
+using namespace std;
+
+/*
+ * table with random contents (variable x binning for every second table)
+ */
+TH2F* getRandomTable( string iName, unsigned int iTable, TRandom3& iRandom )
+{
+    int nx = 40 + iTable % 7;
+    int ny = 30 + iTable % 5;
+    TH2F* h = 0;
+    if( iTable % 2 == 0 )
+    {
+        vector< double > xbins( 1, 1. );
+        for( int i = 0; i < nx; i++ )
+        {
+            xbins.push_back( xbins.back() + 0.05 + 0.2 * iRandom.Uniform() );
+        }
+        h = new TH2F( iName.c_str(), "", nx, &xbins[0], ny, 0., 20. * ny );
+    }
+    else
+    {
+        h = new TH2F( iName.c_str(), "", nx, 1., 1. + 0.125 * nx, ny, 0., 20. * ny );
+    }
+    h->Sumw2();
+    for( int i = 0; i <= nx + 1; i++ )
+    {
+        for( int j = 0; j <= ny + 1; j++ )
+        {
+            if( iRandom.Uniform() > 0.2 )
+            {
+                h->SetBinContent( i, j, 3. * iRandom.Uniform() );
+                h->SetBinError( i, j, 0.3 * iRandom.Uniform() );
+            }
+        }
+    }
+    return h;
+}
+
+int main( int argc, char* argv[] )
+{
+    const string iRootFile = "testTableLookupBinaryFile.root";
+    const string iBinaryFile = "testTableLookupBinaryFile.bin";
+    const unsigned int nPoints = 5000;
+    const unsigned int nZe = 2;
+    const unsigned int nNoise = 2;
+    const unsigned int nTypes = 3;
+    const char* iTypeDir[nTypes] = { "mscw", "mscl", "energySR" };
+    const char* iTypeHisto[nTypes] = { "width_median_tb", "length_median_tb", "energySR_median_tb" };
+    // table not written (ze 1, noise 0, mscl)
+    const unsigned int iMissing = 1 * nNoise * nTypes + 0 * nTypes + 1;
+
+    TRandom3 iRandom( 23 );
+
+    //////////////////////////////////////
+    // ROOT table file
+    TFile* iFile = new TFile( iRootFile.c_str(), "RECREATE" );
+    if( iFile->IsZombie() )
+    {
+        cout << "testTableLookupBinaryFile: error opening " << iRootFile << endl;
+        exit( EXIT_FAILURE );
+    }
+    // histogram paths: [ze][noise][type]
+    map< unsigned int, string > iTablePath;
+    char hname[200];
+    for( unsigned int z = 0; z < nZe; z++ )
+    {
+        sprintf( hname, "ze_%03d", 200 + 200 * z );
+        TDirectory* iDirZe = iFile->mkdir( hname );
+        TDirectory* iDirTel = iDirZe->mkdir( "woff_0500" )->mkdir( "az_0" )->mkdir( "tel_1" );
+        for( unsigned int n = 0; n < nNoise; n++ )
+        {
+            sprintf( hname, "NOISE_%05d", 250 + 250 * n );
+            TDirectory* iDirNoise = iDirTel->mkdir( hname );
+            for( unsigned int y = 0; y < nTypes; y++ )
+            {
+                unsigned int iTable = ( z * nNoise + n ) * nTypes + y;
+                if( iTable == iMissing )
+                {
+                    continue;
+                }
+                iDirNoise->mkdir( iTypeDir[y] )->cd();
+                TH2F* h = getRandomTable( iTypeHisto[y], iTable, iRandom );
+                h->Write();
+                iTablePath[iTable] = string( gDirectory->GetPath() ) + "/" + iTypeHisto[y];
+                iTablePath[iTable] = iTablePath[iTable].substr( iTablePath[iTable].find( ":/" ) + 2 );
+                delete h;
+            }
+        }
+    }
+    iFile->Close();
+    delete iFile;
+
+    //////////////////////////////////////
+    // conversion
+    iFile = new TFile( iRootFile.c_str() );
+    if( iFile->IsZombie() || !VTableLookupBinaryFile::convert( iFile, iBinaryFile ) )
+    {
+        cout << "testTableLookupBinaryFile: error converting " << iRootFile << endl;
+        exit( EXIT_FAILURE );
+    }
+    VTableLookupBinaryFile iBinary;
+    if( !iBinary.open( iBinaryFile ) )
+    {
+        exit( EXIT_FAILURE );
+    }
+
+    //////////////////////////////////////
+    // grids vs TH2F
+    unsigned int nFailed = 0;
+    unsigned int nTested = 0;
+    if( iBinary.getNTables() != iTablePath.size() )
+    {
+        cout << "testTableLookupBinaryFile: " << iBinary.getNTables() << " tables in binary file, ";
+        cout << iTablePath.size() << " expected" << endl;
+        nFailed++;
+    }
+    for( unsigned int i = 0; i < iBinary.getNTables(); i++ )
+    {
+        const sTableEntry* e = iBinary.getTableEntry( i );
+        unsigned int iTable = ( e->ize * nNoise + e->inoise ) * nTypes + e->iType;
+        if( e->iType >= nTypes || iTablePath.find( iTable ) == iTablePath.end() )
+        {
+            cout << "table " << i << ": unexpected table type " << e->iType << endl;
+            nFailed++;
+            continue;
+        }
+        if( fabs( e->ze - ( 20. + 20. * e->ize ) ) > 1.e-4 || fabs( e->noise - ( 2.5 + 2.5 * e->inoise ) ) > 1.e-4
+                || fabs( e->woff - 0.5 ) > 1.e-4 || e->telType != 1 )
+        {
+            cout << "table " << iTablePath[iTable] << ": wrong table index (ze " << e->ze << ", woff " << e->woff;
+            cout << ", noise " << e->noise << ", tel type " << e->telType << ")" << endl;
+            nFailed++;
+        }
+        TH2F* h = ( TH2F* )iFile->Get( iTablePath[iTable].c_str() );
+        VTableLookupGrid* g = iBinary.getGrid( i );
+        if( !h || !g )
+        {
+            cout << "table " << iTablePath[iTable] << " not found" << endl;
+            nFailed++;
+            continue;
+        }
+        vector< TH2F* > iH( 1, h );
+        vector< VTableLookupGrid* > iG( 1, g );
+        VTableCalculator iCalcH( ( VTableLookupGrid* )0, false );
+        VTableCalculator iCalcG( ( VTableLookupGrid* )0, false );
+        iCalcH.setVHistograms( iH );
+        iCalcG.setVGrids( iG );
+        double xmin = h->GetXaxis()->GetXmin();
+        double xmax = h->GetXaxis()->GetXmax();
+        double ymax = h->GetYaxis()->GetXmax();
+        unsigned int nDiff = 0;
+        for( unsigned int p = 0; p < nPoints; p++ )
+        {
+            float r = -30. + iRandom.Uniform() * ( ymax + 60. );
+            float s = pow( 10., xmin - 0.3 + iRandom.Uniform() * ( xmax - xmin + 0.6 ) );
+            float w = 1.;
+            double mt_h = 0.;
+            double st_h = 0.;
+            double mt_g = 0.;
+            double st_g = 0.;
+            double chi2 = 0.;
+            double dE = 0.;
+            iCalcH.calc( 1, &r, &s, &w, &mt_h, chi2, dE, &st_h );
+            iCalcG.calc( 1, &r, &s, &w, &mt_g, chi2, dE, &st_g );
+            nTested++;
+            if( fabs( mt_h - mt_g ) > 1.e-6 * fabs( mt_h ) || fabs( st_h - st_g ) > 1.e-6 * fabs( st_h ) )
+            {
+                if( nDiff < 5 )
+                {
+                    cout << "table " << iTablePath[iTable] << ": difference at size " << s << ", distance " << r << ": ";
+                    cout << "TH2F " << mt_h << " (" << st_h << "), grid " << mt_g << " (" << st_g << ")" << endl;
+                }
+                nDiff++;
+            }
+        }
+        if( nDiff > 0 )
+        {
+            nFailed++;
+        }
+        delete g;
+        delete h;
+    }
+    iBinary.close();
+    iFile->Close();
+    remove( iRootFile.c_str() );
+    remove( iBinaryFile.c_str() );
+
+    cout << "testTableLookupBinaryFile: " << nTested << " points tested, " << nFailed << " tables with differences" << endl;
+    if( nFailed > 0 || nTested == 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
@@ -0,0 +1,205 @@
+/*! \file testTableLookupGrid
+ *  \brief test lookup table interpolation (grids vs TH2F)
+ *
+ *  random tables (fixed and variable binning, empty bins) and random points
+ *  (including under- and overflows); grids are evaluated point-by-point and
+ *  batched (scalar and AVX2 kernels) and must be identical to the TH2F
+ *  interpolation (VTableCalculator::interpolate)
+ *
+ *  the run time of the scalar and AVX2 kernels is measured for batches of
+ *  four telescopes (one event, as in VTableCalculator::calc)
+ *
+ */
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "TH2F.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "VTableCalculator.h"
+#include "VTableLookupGrid.h"
+
+using namespace std;
+
+/*
+ * table with random contents (about 20% empty bins)
+ */
+TH2F* getRandomTable( unsigned int t, TRandom3& iRandom )
+{
+    // table binning as for mscw/mscl/energy tables
+    int nx = 40 + t % 7;
+    int ny = 30 + t % 5;
+    TH2F* h = 0;
+    if( t % 3 == 0 )
+    {
+        vector< double > xbins( 1, 1. );
+        for( int i = 0; i < nx; i++ )
+        {
+            xbins.push_back( xbins.back() + 0.05 + 0.2 * iRandom.Uniform() );
+        }
+        h = new TH2F( "hTest", "", nx, &xbins[0], ny, 0., 20. * ny );
+    }
+    else
+    {
+        h = new TH2F( "hTest", "", nx, 1., 1. + 0.125 * nx, ny, 0., 20. * ny );
+    }
+    h->SetDirectory( 0 );
+    h->Sumw2();
+    for( int i = 0; i <= nx + 1; i++ )
+    {
+        for( int j = 0; j <= ny + 1; j++ )
+        {
+            if( iRandom.Uniform() > 0.2 )
+            {
+                h->SetBinContent( i, j, 3. * iRandom.Uniform() );
+                h->SetBinError( i, j, 0.3 * iRandom.Uniform() );
+            }
+        }
+    }
+    return h;
+}
+
+/*
+ * compare grids (point-by-point, batched scalar and AVX2) with TH2F interpolation
+ */
+unsigned int compare( unsigned int iNTables, unsigned int iNPoints, unsigned int& iNTested, TRandom3& iRandom )
+{
+    bool iAVX2 = VTableLookupGrid::isAVX2();
+    unsigned int iNFailed = 0;
+    for( unsigned int t = 0; t < iNTables; t++ )
+    {
+        TH2F* h = getRandomTable( t, iRandom );
+        int nx = h->GetNbinsX();
+        VTableLookupGrid iGrid( h );
+        double xmin = h->GetXaxis()->GetXmin();
+        double xmax = h->GetXaxis()->GetXmax();
+        double ymax = h->GetYaxis()->GetXmax();
+
+        vector< const VTableLookupGrid* > g( iNPoints, &iGrid );
+        vector< float > x( iNPoints, 0. );
+        vector< float > y( iNPoints, 0. );
+        for( unsigned int i = 0; i < iNPoints; i++ )
+        {
+            x[i] = xmin - 0.3 + iRandom.Uniform() * ( xmax - xmin + 0.6 );
+            y[i] = -30. + iRandom.Uniform() * ( ymax + 60. );
+            // points at bin centers
+            if( i % 17 == 0 )
+            {
+                x[i] = h->GetXaxis()->GetBinCenter( 1 + i % nx );
+            }
+        }
+        vector< float > med_s( iNPoints, 0. );
+        vector< float > sigma_s( iNPoints, 0. );
+        vector< float > med_v( iNPoints, 0. );
+        vector< float > sigma_v( iNPoints, 0. );
+        VTableLookupGrid::setAVX2( false );
+        VTableLookupGrid::interpolate( iNPoints, &g[0], &x[0], &y[0], &med_s[0], &sigma_s[0] );
+        VTableLookupGrid::setAVX2( true );
+        VTableLookupGrid::interpolate( iNPoints, &g[0], &x[0], &y[0], &med_v[0], &sigma_v[0] );
+
+        for( unsigned int i = 0; i < iNPoints; i++ )
+        {
+            float med = ( float )VTableCalculator::interpolate( h, x[i], y[i], false );
+            float sigma = ( float )VTableCalculator::interpolate( h, x[i], y[i], true );
+            iNTested++;
+            if( med != ( float )iGrid.interpolate( x[i], y[i], false ) || sigma != ( float )iGrid.interpolate( x[i], y[i], true )
+                    || med != med_s[i] || sigma != sigma_s[i] || med != med_v[i] || sigma != sigma_v[i] )
+            {
+                if( iNFailed < 10 )
+                {
+                    cout << "difference at x=" << x[i] << ", y=" << y[i] << ": ";
+                    cout << "TH2F " << med << " (" << sigma << "), ";
+                    cout << "grid " << iGrid.interpolate( x[i], y[i], false ) << " (" << iGrid.interpolate( x[i], y[i], true ) << "), ";
+                    cout << "batched " << med_s[i] << " (" << sigma_s[i] << "), ";
+                    cout << "batched SIMD " << med_v[i] << " (" << sigma_v[i] << ")" << endl;
+                }
+                iNFailed++;
+            }
+        }
+        delete h;
+    }
+    VTableLookupGrid::setAVX2( iAVX2 );
+    return iNFailed;
+}
+
+/*
+ * run time [ns] per telescope of the batched interpolation
+ * (one batch per event with iNTel telescopes)
+ */
+double getRunTime( bool iAVX2, unsigned int iNTel, unsigned int iNEvents, TRandom3& iRandom )
+{
+    vector< TH2F* > h( iNTel, ( TH2F* )0 );
+    vector< VTableLookupGrid* > iGrid( iNTel, ( VTableLookupGrid* )0 );
+    vector< const VTableLookupGrid* > g( iNTel, ( VTableLookupGrid* )0 );
+    for( unsigned int t = 0; t < iNTel; t++ )
+    {
+        h[t] = getRandomTable( t + 1, iRandom );
+        iGrid[t] = new VTableLookupGrid( h[t] );
+        g[t] = iGrid[t];
+    }
+    vector< float > x( iNTel * iNEvents, 0. );
+    vector< float > y( iNTel * iNEvents, 0. );
+    for( unsigned int i = 0; i < x.size(); i++ )
+    {
+        x[i] = 1.5 + 3. * iRandom.Uniform();
+        y[i] = 500. * iRandom.Uniform();
+    }
+    vector< float > med( iNTel, 0. );
+    vector< float > sigma( iNTel, 0. );
+
+    bool iAVX2_default = VTableLookupGrid::isAVX2();
+    VTableLookupGrid::setAVX2( iAVX2 );
+    TStopwatch iStopWatch;
+    iStopWatch.Start();
+    double iSum = 0.;
+    for( unsigned int e = 0; e < iNEvents; e++ )
+    {
+        VTableLookupGrid::interpolate( iNTel, &g[0], &x[e * iNTel], &y[e * iNTel], &med[0], &sigma[0] );
+        iSum += med[0];
+    }
+    iStopWatch.Stop();
+    VTableLookupGrid::setAVX2( iAVX2_default );
+
+    for( unsigned int t = 0; t < iNTel; t++ )
+    {
+        delete iGrid[t];
+        delete h[t];
+    }
+    // (avoid that the loop is optimised away)
+    if( iSum < 0. )
+    {
+        cout << iSum << endl;
+    }
+    return iStopWatch.RealTime() / ( double )( iNTel * iNEvents ) * 1.e9;
+}
+
+int main( int argc, char* argv[] )
+{
+    TRandom3 iRandom( 17 );
+
+    unsigned int iNTested = 0;
+    unsigned int iNFailed = compare( 100, 10000, iNTested, iRandom );
+    cout << "testTableLookupGrid: " << iNTested << " points tested, " << iNFailed << " differences";
+    cout << " (SIMD kernel: " << ( VTableLookupGrid::isAVX2() ? "AVX2" : "not available" ) << ")" << endl;
+
+    // run time (batches of four telescopes)
+    const unsigned int iNTel = 4;
+    const unsigned int iNEvents = 1000000;
+    double iTime_scalar = getRunTime( false, iNTel, iNEvents, iRandom );
+    cout << "testTableLookupGrid: run time per telescope (" << iNTel << " telescopes per batch): ";
+    cout << iTime_scalar << " ns (scalar)";
+    if( VTableLookupGrid::isAVX2() )
+    {
+        double iTime_AVX2 = getRunTime( true, iNTel, iNEvents, iRandom );
+        cout << ", " << iTime_AVX2 << " ns (AVX2)";
+    }
+    cout << endl;
+
+    if( iNFailed > 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
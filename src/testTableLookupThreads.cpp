@@ -0,0 +1,218 @@
+/*! \file testTableLookupThreads
+ *  \brief compare mscw_energy output of the single- and multi-threaded event loop
+ *
+ *  synthetic events are analysed with bench_evndisp; lookup tables are filled
+ *  from these events and the events are then analysed with mscw_energy with
+ *  -nthreads=1 and -nthreads=N (bench_evndisp and mscw_energy are expected in
+ *  the same directory as this program; no data or auxiliary files needed)
+ *
+ *  all leaves of the data trees of both output files are compared entry by
+ *  entry and must be identical (NaNs are equal)
+ *
+ *  usage: testTableLookupThreads [nthreads (default=4)] [nevents (default=2000)]
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+using namespace std;
+
+/*
+ * run a command (output written to iLog)
+ */
+void runCommand( string iCommand, string iLog )
+{
+    cout << "testTableLookupThreads: " << iCommand << endl;
+    iCommand += " > " + iLog + " 2>&1";
+    if( gSystem->Exec( iCommand.c_str() ) != 0 )
+    {
+        cout << "testTableLookupThreads: error running command (see " << iLog << ")" << endl;
+        exit( EXIT_FAILURE );
+    }
+}
+
+/*
+ * analyse evndisp file with mscw_energy
+ */
+string runMSCW( string iMSCW, string iTableFile, string iInputFile, unsigned int iNThreads )
+{
+    ostringstream iFile;
+    iFile << "testTableLookupThreads.t" << iNThreads << ".mscw.root";
+    ostringstream iCommand;
+    iCommand << iMSCW << " -tablefile " << iTableFile << " -inputfile " << iInputFile;
+    iCommand << " -outputfile " << iFile.str() << " -nthreads=" << iNThreads;
+    runCommand( iCommand.str(), iFile.str() + ".log" );
+    return iFile.str();
+}
+
+TTree* getDataTree( string iFile, TFile*& iF )
+{
+    iF = new TFile( iFile.c_str() );
+    if( iF->IsZombie() )
+    {
+        cout << "testTableLookupThreads: error opening " << iFile << endl;
+        exit( EXIT_FAILURE );
+    }
+    TTree* t = ( TTree* )iF->Get( "data" );
+    if( !t )
+    {
+        cout << "testTableLookupThreads: data tree not found in " << iFile << endl;
+        exit( EXIT_FAILURE );
+    }
+    return t;
+}
+
+/*
+ * compare two trees entry by entry
+ *
+ * returns number of entries with differences
+ */
+Long64_t compareTrees( TTree* t1, TTree* t2 )
+{
+    if( t1->GetEntries() != t2->GetEntries() )
+    {
+        cout << "testTableLookupThreads: different number of entries: ";
+        cout << t1->GetEntries() << ", " << t2->GetEntries() << endl;
+        return 1;
+    }
+    // leaves of both trees
+    vector< TLeaf* > iL1;
+    vector< TLeaf* > iL2;
+    TObjArray* iLeaves = t1->GetListOfLeaves();
+    for( int i = 0; i < iLeaves->GetEntries(); i++ )
+    {
+        TLeaf* l = ( TLeaf* )iLeaves->At( i );
+        TLeaf* l2 = t2->GetLeaf( l->GetName() );
+        if( !l2 )
+        {
+            cout << "testTableLookupThreads: leaf " << l->GetName() << " not found in second file" << endl;
+            return 1;
+        }
+        iL1.push_back( l );
+        iL2.push_back( l2 );
+    }
+    if( t2->GetListOfLeaves()->GetEntries() != iLeaves->GetEntries() )
+    {
+        cout << "testTableLookupThreads: different number of leaves: ";
+        cout << iLeaves->GetEntries() << ", " << t2->GetListOfLeaves()->GetEntries() << endl;
+        return 1;
+    }
+
+    unsigned int nDiff = 0;
+    Long64_t nEntriesDiff = 0;
+    for( Long64_t n = 0; n < t1->GetEntries(); n++ )
+    {
+        t1->GetEntry( n );
+        t2->GetEntry( n );
+        bool bDiff = false;
+        for( unsigned int i = 0; i < iL1.size(); i++ )
+        {
+            if( iL1[i]->GetLen() != iL2[i]->GetLen() )
+            {
+                if( nDiff < 20 )
+                {
+                    cout << "entry " << n << ", " << iL1[i]->GetName() << ": different length ";
+                    cout << iL1[i]->GetLen() << ", " << iL2[i]->GetLen() << endl;
+                }
+                nDiff++;
+                bDiff = true;
+                continue;
+            }
+            for( int j = 0; j < iL1[i]->GetLen(); j++ )
+            {
+                double v1 = iL1[i]->GetValue( j );
+                double v2 = iL2[i]->GetValue( j );
+                if( v1 != v2 && !( std::isnan( v1 ) && std::isnan( v2 ) ) )
+                {
+                    if( nDiff < 20 )
+                    {
+                        cout << "entry " << n << ", " << iL1[i]->GetName() << "[" << j << "]: ";
+                        cout << v1 << ", " << v2 << endl;
+                    }
+                    nDiff++;
+                    bDiff = true;
+                }
+            }
+        }
+        if( bDiff )
+        {
+            nEntriesDiff++;
+        }
+    }
+    cout << "testTableLookupThreads: " << t1->GetEntries() << " entries and " << iL1.size() << " leaves compared, ";
+    cout << nEntriesDiff << " entries with differences" << endl;
+    return nEntriesDiff;
+}
+
+int main( int argc, char* argv[] )
+{
+    unsigned int iNThreads = 4;
+    unsigned int iNEvents = 2000;
+    if( argc > 1 )
+    {
+        iNThreads = atoi( argv[1] );
+    }
+    if( argc > 2 )
+    {
+        iNEvents = atoi( argv[2] );
+    }
+    if( iNThreads < 2 )
+    {
+        cout << "testTableLookupThreads: number of threads should be >1" << endl;
+        exit( EXIT_FAILURE );
+    }
+    string iBinDir = gSystem->DirName( argv[0] );
+    string iBench = iBinDir + "/bench_evndisp";
+    string iMSCW = iBinDir + "/mscw_energy";
+    if( gSystem->AccessPathName( iBench.c_str() ) || gSystem->AccessPathName( iMSCW.c_str() ) )
+    {
+        cout << "testTableLookupThreads: " << iBench << " or " << iMSCW << " not found (make bench_evndisp mscw_energy)" << endl;
+        exit( EXIT_FAILURE );
+    }
+
+    // synthetic events (Monte Carlo type)
+    string iEvndispFile = "testTableLookupThreads.root";
+    ostringstream iCommand;
+    iCommand << iBench << " -nevents=" << iNEvents << " -nthreads=1 -output " << iEvndispFile;
+    runCommand( iCommand.str(), iEvndispFile + ".log" );
+
+    // fill lookup tables (existing table files are updated by mscw_energy)
+    string iTableFile = "testTableLookupThreads.tables.root";
+    gSystem->Unlink( iTableFile.c_str() );
+    iCommand.str( "" );
+    iCommand << iMSCW << " -filltables=1 -tablefile " << iTableFile << " -ze=20 -woff=0.5 -noise=200";
+    iCommand << " -minshowerperbin=1 -inputfile " << iEvndispFile;
+    runCommand( iCommand.str(), iTableFile + ".log" );
+
+    // read lookup tables with one and with several threads
+    string iFile1 = runMSCW( iMSCW, iTableFile, iEvndispFile, 1 );
+    string iFileN = runMSCW( iMSCW, iTableFile, iEvndispFile, iNThreads );
+
+    TFile* iF1 = 0;
+    TFile* iFN = 0;
+    TTree* t1 = getDataTree( iFile1, iF1 );
+    TTree* tN = getDataTree( iFileN, iFN );
+    Long64_t nEntries = t1->GetEntries();
+    Long64_t nEntriesDiff = compareTrees( t1, tN );
+    cout << "testTableLookupThreads: -nthreads=1 vs -nthreads=" << iNThreads << ", ";
+    cout << nEntriesDiff << " entries with differences" << endl;
+
+    iF1->Close();
+    iFN->Close();
+
+    if( nEntriesDiff > 0 || nEntries == 0 )
+    {
+        exit( EXIT_FAILURE );
+    }
+}
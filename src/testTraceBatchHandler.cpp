@@ -0,0 +1,301 @@
+/*! \file testTraceBatchHandler
+ *  \brief test batched trace integration (VTraceBatchHandler vs VTraceHandler)
+ *
+ *  results of the batched calculation (scalar and AVX2 kernels) must be
+ *  bit-for-bit identical to the per-channel calculation
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "TRandom3.h"
+
+#include "VTraceBatchHandler.h"
+#include "VTraceHandler.h"
+#include "VVirtualDataReader.h"
+
+using namespace std;
+
+/*
+ * reader with random traces (pulse on top of pedestal with noise)
+ */
+class VTestTraceReader : public VVirtualDataReader
+{
+    private:
+        bool f16Bit;
+        unsigned int fNSamples;
+        vector< vector< uint8_t > > fTrace8;
+        vector< vector< uint16_t > > fTrace16;
+        vector< bool > fFullVec;
+        vector< uint8_t > fSamplesVec;
+
+    public:
+        VTestTraceReader( bool i16Bit, unsigned int iNChannels, unsigned int iNSamples, double iPed, TRandom3* iRandom )
+        {
+            f16Bit = i16Bit;
+            fNSamples = iNSamples;
+            fFullVec.assign( iNChannels, true );
+            fTrace8.assign( iNChannels, vector< uint8_t >( iNSamples, 0 ) );
+            fTrace16.assign( iNChannels, vector< uint16_t >( iNSamples, 0 ) );
+            double iMax = ( f16Bit ? 4095. : 255. );
+            for( unsigned int c = 0; c < iNChannels; c++ )
+            {
+                double iAmplitude = iRandom->Exp( ( f16Bit ? 400. : 40. ) );
+                double iT0 = iRandom->Uniform( 0., ( double )iNSamples );
+                for( unsigned int s = 0; s < iNSamples; s++ )
+                {
+                    double x = ( s - iT0 ) / 1.5;
+                    double v = iPed + iRandom->Gaus( 0., 2. ) + iAmplitude * exp( -0.5 * x * x );
+                    v = ( v < 0. ? 0. : ( v > iMax ? iMax : v ) );
+                    fTrace8[c][s] = ( uint8_t )( v > 255. ? 255. : v );
+                    fTrace16[c][s] = ( uint16_t )v;
+                }
+            }
+        }
+        ~VTestTraceReader() {}
+
+        std::pair< bool, uint32_t > getChannelHitIndex( uint32_t i )
+        {
+            return std::make_pair( true, i );
+        }
+        uint32_t getEventNumber()
+        {
+            return 0;
+        }
+        uint8_t getEventType()
+        {
+            return 0;
+        }
+        uint8_t getATEventType()
+        {
+            return 0;
+        }
+        uint32_t getRunNumber()
+        {
+            return 0;
+        }
+        std::vector< bool > getFullHitVec()
+        {
+            return fFullVec;
+        }
+        std::vector< bool > getFullTrigVec()
+        {
+            return fFullVec;
+        }
+        int getNumberofFullTrigger()
+        {
+            return ( int )fFullVec.size();
+        }
+        uint32_t getGPS0()
+        {
+            return 0;
+        }
+        uint32_t getGPS1()
+        {
+            return 0;
+        }
+        uint32_t getGPS2()
+        {
+            return 0;
+        }
+        uint32_t getGPS3()
+        {
+            return 0;
+        }
+        uint32_t getGPS4()
+        {
+            return 0;
+        }
+        uint16_t getGPSYear()
+        {
+            return 0;
+        }
+        uint16_t getATGPSYear()
+        {
+            return 0;
+        }
+        uint32_t getHitID( uint32_t i )
+        {
+            return i;
+        }
+        uint16_t getMaxChannels()
+        {
+            return ( uint16_t )fTrace8.size();
+        }
+        VMonteCarloRunHeader* getMonteCarloHeader()
+        {
+            return 0;
+        }
+        uint16_t getNumChannelsHit()
+        {
+            return ( uint16_t )fTrace8.size();
+        }
+        uint16_t getNumSamples()
+        {
+            return ( uint16_t )fNSamples;
+        }
+        unsigned int getNTel()
+        {
+            return 1;
+        }
+        bool getHiLo( uint32_t i )
+        {
+            return false;
+        }
+        std::vector< uint8_t > getSamplesVec()
+        {
+            return fSamplesVec;
+        }
+        const uint8_t* getSamplePtr( unsigned channel, unsigned int& iNSamples )
+        {
+            iNSamples = fNSamples;
+            return &fTrace8[channel][0];
+        }
+        const uint16_t* getSamplePtr16Bit( unsigned channel, unsigned int& iNSamples )
+        {
+            iNSamples = fNSamples;
+            return &fTrace16[channel][0];
+        }
+        bool has16Bit()
+        {
+            return f16Bit;
+        }
+        void selectHitChan( uint32_t ) {}
+        bool wasLossyCompressed()
+        {
+            return false;
+        }
+        bool getNextEvent()
+        {
+            return false;
+        }
+};
+
+/*
+ * compare batched and per-channel results for all channels of one reader
+ *
+ * (same sequence of calls as in VImageBaseAnalyzer::calcTZerosSums()
+ *  and VImageBaseAnalyzer::calcTZerosSums_batch())
+ */
+unsigned int compare( VTestTraceReader* iReader, double iPed, unsigned int iMethod, int iFirst, int iLast, bool iAVX2 )
+{
+    vector< float > iLevels;
+    iLevels.push_back( 0.2 );
+    iLevels.push_back( 0.5 );
+    iLevels.push_back( 1.0 );
+    iLevels.push_back( 0.5 );
+    iLevels.push_back( 0.2 );
+
+    unsigned int nc = iReader->getNumChannelsHit();
+    int ns = ( int )iReader->getNumSamples();
+
+    VTraceHandler iTraceHandler;
+    iTraceHandler.setPulseTimingLevels( iLevels );
+
+    VTraceBatchHandler iBatch;
+    iBatch.setAVX2( iAVX2 );
+    iBatch.reset( ns, nc );
+    iBatch.setPulseTimingLevels( iLevels );
+    for( unsigned int i = 0; i < nc; i++ )
+    {
+        if( !iBatch.addChannel( iReader, i, i, iPed ) )
+        {
+            cout << "\t error adding channel " << i << endl;
+            return 1;
+        }
+    }
+    unsigned int nl = iBatch.getNLanes();
+    vector< int > iBFirst( nl, iFirst );
+    vector< int > iBLast( nl, iLast );
+    vector< int > iMaxPos;
+    iBatch.calculateMaximum( iBFirst, iBLast, iMaxPos );
+    vector< vector< float > > iBTiming( nc );
+    for( unsigned int c = 0; c < nc; c++ )
+    {
+        iBTiming[c] = iBatch.getPulseTiming( c, iMaxPos[c], 0, ns );
+    }
+    if( iMethod == 1 )
+    {
+        iBatch.calculateTraceSum_fixedWindow( iBFirst, iBLast, false );
+    }
+    else
+    {
+        vector< int > iWindow( nl, iLast - iFirst );
+        iBatch.calculateTraceSum_slidingWindow( iWindow );
+    }
+    vector< int > iTraceFirst( nl, 0 );
+    vector< int > iTraceLast( nl, ns );
+    iBatch.calculateMaximum( iTraceFirst, iTraceLast, iMaxPos );
+
+    unsigned int nDiff = 0;
+    for( unsigned int c = 0; c < nc; c++ )
+    {
+        iTraceHandler.setTrace( iReader, ns, iPed, 2., c, c, 0. );
+        iTraceHandler.setTraceIntegrationmethod( iMethod );
+        vector< float > iTiming = iTraceHandler.getPulseTiming( iFirst, iLast, 0, ns );
+        double iSum = iTraceHandler.getTraceSum( iFirst, iLast, false );
+        unsigned int n255 = 0;
+        double iMax = iTraceHandler.getTraceMax( n255, 6. );
+
+        bool bDiff = ( iTiming != iBTiming[c] );
+        bDiff = bDiff || ( iSum != iBatch.getTraceSum( c ) );
+        bDiff = bDiff || ( iTraceHandler.getTraceAverageTime() != iBatch.getTraceAverageTime( c ) );
+        bDiff = bDiff || ( iTraceHandler.getTraceIntegrationFirst() != iBatch.getTraceIntegrationFirst( c ) );
+        bDiff = bDiff || ( iTraceHandler.getTraceIntegrationLast() != iBatch.getTraceIntegrationLast( c ) );
+        bDiff = bDiff || ( iMax != iBatch.getTraceMax( c, iMaxPos[c] ) );
+        if( bDiff )
+        {
+            if( nDiff < 10 )
+            {
+                cout << "\t channel " << c << ": sum " << iSum << " (batch " << iBatch.getTraceSum( c ) << ")";
+                cout << ", time " << iTraceHandler.getTraceAverageTime() << " (batch " << iBatch.getTraceAverageTime( c ) << ")";
+                cout << ", max " << iMax << " (batch " << iBatch.getTraceMax( c, iMaxPos[c] ) << ")" << endl;
+            }
+            nDiff++;
+        }
+    }
+    return nDiff;
+}
+
+int main( int argc, char* argv[] )
+{
+    TRandom3 iRandom( 42 );
+    const unsigned int nChannels = 499;
+    const double iPed = 16.;
+
+    unsigned int nFailed = 0;
+    for( unsigned int b = 0; b < 2; b++ )
+    {
+        bool i16Bit = ( b == 1 );
+        for( unsigned int s = 0; s < 3; s++ )
+        {
+            unsigned int iNSamples = ( s == 0 ? 16 : ( s == 1 ? 24 : 64 ) );
+            VTestTraceReader iReader( i16Bit, nChannels, iNSamples, iPed, &iRandom );
+            for( unsigned int m = 1; m <= 2; m++ )
+            {
+                for( unsigned int a = 0; a < 2; a++ )
+                {
+                    int iFirst = ( int )iRandom.Integer( iNSamples / 2 );
+                    int iLast = iFirst + 6;
+                    unsigned int nDiff = compare( &iReader, iPed, m, iFirst, iLast, ( a == 1 ) );
+                    cout << ( i16Bit ? "16 bit" : "8 bit" ) << ", " << iNSamples << " samples, method " << m;
+                    cout << ", window [" << iFirst << "," << iLast << "), " << ( a == 1 ? "AVX2" : "scalar" );
+                    cout << ": " << nDiff << " channels differ" << endl;
+                    if( nDiff > 0 )
+                    {
+                        nFailed++;
+                    }
+                }
+            }
+        }
+    }
+    if( nFailed > 0 )
+    {
+        cout << "testTraceBatchHandler: batched and per-channel results differ" << endl;
+        exit( EXIT_FAILURE );
+    }
+    cout << "testTraceBatchHandler: batched and per-channel results are identical" << endl;
+}
@@ -0,0 +1,200 @@
+/*! \file testTracePulseFitter
+ *  \brief test trace fits (VTracePulseFitter vs TF1 fit)
+ *
+ *  random FADC traces are fitted with VTracePulseFitter and with the
+ *  histogram/TF1 fit used before (same trace functions, start values,
+ *  limits and errors); the test fails if
+ *
+ *  - a converged TF1 fit ends at a smaller chi2 than the pulse fitter
+ *  - parameters of fits with the same chi2 deviate
+ *  - maximum, integral or level crossings of the fitted function
+ *    differ from the TF1 calculation (same parameters)
+ *
+ */
+
+#include <cmath>
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TF1.h"
+#include "TFitResult.h"
+#include "TH1D.h"
+#include "TRandom3.h"
+#include "TVirtualFitter.h"
+
+#include "VTracePulseFitter.h"
+
+using namespace std;
+
+double trace_ev( double* x, double* p )
+{
+    return VTracePulseFitter::evalEV( x[0], p );
+}
+
+double trace_grisu( double* x, double* p )
+{
+    return VTracePulseFitter::evalGrisu( x[0], p );
+}
+
+/*
+ * fit iNTraces random traces with both fitters
+ *
+ * returns number of differences
+ */
+unsigned int compare( string iFunction, unsigned int iNTraces, TRandom3* iRandom )
+{
+    const unsigned int nSamples = 24;
+    const double iPed = 16.;
+    const double iPedRMS = 2.5;
+    // allowed differences
+    const double iMaxDeltaChi2 = 1.e-3;            // relative
+    const double iMaxDeviation = 0.1;              // in units of the TF1 fit errors
+
+    TH1D iH( ( "hTrace_" + iFunction ).c_str(), "", nSamples, 0., ( double )nSamples );
+    TF1 iF( ( "fTrace_" + iFunction ).c_str(), ( iFunction == "ev" ? trace_ev : trace_grisu ), 0., ( double )nSamples,
+            ( iFunction == "ev" ? 5 : 6 ) );
+    VTracePulseFitter iFitter( iFunction );
+    unsigned int nPar = iFitter.getNPar();
+
+    unsigned int nConverged = 0;
+    unsigned int nFailed = 0;
+    vector< double > iTrace( nSamples, 0. );
+    for( unsigned int n = 0; n < iNTraces; n++ )
+    {
+        // random trace
+        double iTrue[6];
+        if( iFunction == "ev" )
+        {
+            iTrue[0] = -1. * iRandom->Uniform( 20., 200. );
+            iTrue[1] = iRandom->Uniform( 6., 14. );
+            iTrue[2] = iRandom->Uniform( 0.8, 2. );
+            iTrue[3] = iRandom->Uniform( 0.5, 2.5 );
+            iTrue[4] = -1. * iPed;
+        }
+        else
+        {
+            iTrue[0] = iRandom->Uniform( 1.5, 4. );
+            iTrue[1] = iRandom->Uniform( 4., 10. );
+            iTrue[2] = 0.;
+            iTrue[3] = iRandom->Uniform( 4., 10. );
+            iTrue[4] = -1. * iRandom->Uniform( 200., 2000. );
+            iTrue[5] = -1. * iPed;
+        }
+        for( unsigned int i = 0; i < nSamples; i++ )
+        {
+            double v = -1. * ( iFunction == "ev" ? VTracePulseFitter::evalEV( i + 0.5, iTrue ) : VTracePulseFitter::evalGrisu( i + 0.5, iTrue ) );
+            v += iRandom->Gaus( 0., iPedRMS );
+            iTrace[i] = ( double )( int )( v > 0. ? v + 0.5 : 0. );
+        }
+
+        // pulse fitter
+        iFitter.fit( &iTrace[0], nSamples, iPed, iPedRMS );
+
+        // TF1 fit (as in VFitTraceHandler before the pulse fitter was introduced)
+        double ipeak = -1.e10;
+        int ipeakpos = 0;
+        for( unsigned int i = 0; i < nSamples; i++ )
+        {
+            if( iTrace[i] > ipeak )
+            {
+                ipeak = iTrace[i];
+                ipeakpos = i;
+            }
+            iH.SetBinContent( i + 1, -1. * iTrace[i] );
+            iH.SetBinError( i + 1, sqrt( fabs( iTrace[i] - iPed ) + iPedRMS * iPedRMS ) / 2. );
+        }
+        ipeak -= iPed;
+        if( iFunction == "ev" )
+        {
+            iF.SetParameters( -1.*ipeak, ipeakpos, 0.6, 1.6, -1.*iPed );
+            iF.FixParameter( 4, -1.*iPed );
+            iF.SetParLimits( 0, -5.e5, 0. );
+            iF.SetParLimits( 2, 0.01, 20. );
+            iF.SetParLimits( 3, 0., 20. );
+        }
+        else
+        {
+            iF.SetParameters( 2.4, 8.0, 0., ipeakpos, -1.*ipeak, -1.*iPed );
+            iF.FixParameter( 2, 0. );
+            iF.FixParameter( 5, -1.*iPed );
+            iF.SetParLimits( 0, 0.01, 20. );
+            iF.SetParLimits( 1, 0., 2000. );
+        }
+        TFitResultPtr iFitResult = iH.Fit( &iF, "Q0ES" );
+        if( ( int )iFitResult != 0 || iFitResult->CovMatrixStatus() != 3 )
+        {
+            continue;
+        }
+        nConverged++;
+        double iChi2_TF1 = iF.GetChisquare();
+
+        bool bFailed = ( iFitter.getStatus() != 3 );
+        bFailed = bFailed || ( iFitter.getChi2() > iChi2_TF1 * ( 1. + iMaxDeltaChi2 ) + 1.e-6 );
+        // same minimum: parameters must agree
+        if( !bFailed && fabs( iFitter.getChi2() - iChi2_TF1 ) < iMaxDeltaChi2 * iChi2_TF1 + 1.e-6 )
+        {
+            for( unsigned int p = 0; p < nPar; p++ )
+            {
+                if( iF.GetParError( p ) > 0. && fabs( iFitter.getParameter( p ) - iF.GetParameter( p ) ) > iMaxDeviation * iF.GetParError( p ) )
+                {
+                    bFailed = true;
+                }
+            }
+        }
+        // analytic maximum, integral and level crossings vs TF1 (same parameters)
+        if( !bFailed )
+        {
+            iF.SetParameters( iFitter.getParameters() );
+            double iMin = iFitter.getMinimum( 0., ( double )nSamples );
+            double iMinX = iFitter.getMinimumX( 0., ( double )nSamples );
+            if( fabs( iMin - iF.GetMinimum( 0., ( double )nSamples ) ) > 1.e-4 * fabs( iMin ) + 1.e-6 )
+            {
+                bFailed = true;
+            }
+            if( fabs( iFitter.getIntegral( 4., 12. ) - iF.Integral( 4., 12. ) ) > 1.e-6 * fabs( iF.Integral( 4., 12. ) ) + 1.e-6 )
+            {
+                bFailed = true;
+            }
+            double iHalfMax = 0.5 * ( iMin + iFitter.getParameter( nPar - 1 ) );
+            if( fabs( iFitter.getX( iHalfMax, 0., iMinX ) - iF.GetX( iHalfMax, 0., iMinX ) ) > 1.e-3 )
+            {
+                bFailed = true;
+            }
+        }
+        if( bFailed )
+        {
+            cout << iFunction << " trace " << n << ": status " << iFitter.getStatus() << "/" << iFitResult->CovMatrixStatus();
+            cout << ", chi2 " << iFitter.getChi2() << "/" << iChi2_TF1 << ", parameters:";
+            for( unsigned int p = 0; p < nPar; p++ )
+            {
+                cout << " " << iFitter.getParameter( p ) << "/" << iF.GetParameter( p );
+            }
+            cout << endl;
+            nFailed++;
+        }
+    }
+    cout << iFunction << ": " << nConverged << " traces with converged TF1 fit, " << nFailed << " differences" << endl;
+    if( nConverged == 0 )
+    {
+        return 1;
+    }
+    return nFailed;
+}
+
+int main( int argc, char* argv[] )
+{
+    // TF1 fits with TMinuit (as in VFitTraceHandler before the pulse fitter)
+    TVirtualFitter::SetDefaultFitter( "Minuit" );
+    TRandom3 iRandom( 42 );
+
+    unsigned int nFailed = compare( "ev", 1000, &iRandom );
+    nFailed += compare( "grisu", 1000, &iRandom );
+    if( nFailed > 0 )
+    {
+        cout << "testTracePulseFitter: pulse fitter and TF1 fit differ" << endl;
+        exit( EXIT_FAILURE );
+    }
+    cout << "testTracePulseFitter: pulse fitter and TF1 fit agree" << endl;
+}